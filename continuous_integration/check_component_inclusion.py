@@ -19,7 +19,7 @@ header_files = modemHeaderFiles + sensorHeaderFiles + publisherHeaderFiles
 def find_subclasses(class_name):
     subclass_pattern = r"class[\s\n]+(\w+)[\s\n]+:[\s\n]+public[\s\n]+" + re.escape(
         class_name
-    )
+    ) + r"\b"
 
     subclass_list = []
     num_subclasses = 0
@@ -709,6 +709,73 @@ for pio_env in ["mayfly"]:
     )
 
 
+# %%
+# Build the menu example with the library's optional build flags
+# Each flag, or group of flags that go together, has an environment for each
+# board in the extra configuration file, named "flags_...".  Any modem,
+# sensors, or publisher it must be built with are listed in its
+# custom_menu_defines, in place of the defaults of the other menu builds.
+for pio_env in ["mayfly", "zeroUSB"]:
+    pio_flag_commands = [
+        start_job_commands,
+    ]
+
+    for flag_env in pio_extra_config.envs():
+        if not flag_env.startswith("flags_"):
+            continue
+        flag_env_key = "env:{}".format(flag_env)
+        flag_env_extends = pio_extra_config.get(flag_env_key, "extends")
+        if isinstance(flag_env_extends, str):
+            flag_env_extends = flag_env_extends.split(",")
+        if "env:{}".format(pio_env) not in [
+            extended.strip() for extended in flag_env_extends
+        ]:
+            continue
+
+        default_defines = [
+            all_modem_flags[0],
+            all_sensor_flags[0],
+            all_publisher_flags[0],
+        ]
+        menu_defines = copy.deepcopy(default_defines)
+        if "custom_menu_defines" in pio_extra_config.options(flag_env_key):
+            custom_defines = pio_extra_config.get(
+                flag_env_key, "custom_menu_defines"
+            )
+            if isinstance(custom_defines, str):
+                custom_defines = custom_defines.split()
+            for custom_define in custom_defines:
+                for prefix, default_define in zip(
+                    ["BUILD_MODEM_", "BUILD_SENSOR_", "BUILD_PUB_"],
+                    default_defines,
+                ):
+                    if (
+                        custom_define.startswith(prefix)
+                        and default_define in menu_defines
+                    ):
+                        menu_defines.remove(default_define)
+                menu_defines.append(custom_define)
+
+        prepped_ex_folder, _ = prepare_example(menu_example_name, menu_defines)
+        pio_build_config = extend_pio_config([flag_env])
+        pio_flag_commands.extend(
+            create_logged_command(
+                compiler="PlatformIO",
+                group_title=flag_env,
+                code_subfolder=prepped_ex_folder,
+                pio_env=flag_env,
+                pio_env_file=pio_build_config,
+            )
+        )
+
+    pio_job_matrix.append(
+        {
+            "job_name": "{} - PlatformIO - Flags".format(pio_env),
+            "command": "\n".join(pio_flag_commands + [end_job_commands]),
+        }
+    )
+
+
 # %%
 # Convert commands in the matrix into bash scripts
 for matrix_job in arduino_job_matrix + pio_job_matrix:
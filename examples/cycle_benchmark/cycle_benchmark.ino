@@ -0,0 +1,525 @@
+/** =========================================================================
+ * @example{lineno} cycle_benchmark.ino
+ * @copyright Stroud Water Research Center
+ * @license This example is published under the BSD-3 license.
+ *
+ * @brief Example timing every phase of a whole logging cycle of a
+ * representative station, to compare one build of the library to the next.
+ *
+ * See [the walkthrough page](@ref example_cycle_benchmark) for detailed
+ * instructions.
+ *
+ * @m_examplenavigation{example_cycle_benchmark,}
+ * ======================================================================= */
+
+// ==========================================================================
+//  Defines for TinyGSM
+// ==========================================================================
+/** Start [defines] */
+#ifndef TINY_GSM_RX_BUFFER
+#define TINY_GSM_RX_BUFFER 64
+#endif
+#ifndef TINY_GSM_YIELD_MS
+#define TINY_GSM_YIELD_MS 2
+#endif
+/** End [defines] */
+
+// ==========================================================================
+//  Include the libraries required for any data logger
+// ==========================================================================
+/** Start [includes] */
+// The Arduino library is needed for every Arduino program.
+#include <Arduino.h>
+
+// Include the main header for ModularSensors
+#include <ModularSensors.h>
+/** End [includes] */
+
+
+// ==========================================================================
+//  Data Logging Options
+// ==========================================================================
+/** Start [logging_options] */
+// The name of this program file
+const char* sketchName = "cycle_benchmark.ino";
+// Logger ID, also becomes the prefix for the name of the data file on SD card
+const char* LoggerID = "XXXXX";
+// How frequently (in minutes) to log data
+const uint8_t loggingInterval = 1;
+// Your logger's timezone.
+const int8_t timeZone = -5;  // Eastern Standard Time
+// NOTE:  Daylight savings time will not be applied!  Please use standard time!
+
+// Set the input and output pins for the logger
+// NOTE:  Use -1 for pins that do not apply
+const int32_t serialBaud = 115200;  // Baud rate for debugging
+const int8_t  greenLED   = 8;       // Pin for the green LED
+const int8_t  redLED     = 9;       // Pin for the red LED
+const int8_t  buttonPin  = 21;      // Pin for debugging mode (ie, button pin)
+const int8_t  wakePin    = 31;  // MCU interrupt/alarm pin to wake from sleep
+// Mayfly 0.x D31 = A7
+const int8_t sdCardPwrPin   = -1;  // MCU SD card power pin
+const int8_t sdCardSSPin    = 12;  // SD card chip select/slave select pin
+const int8_t sensorPowerPin = 22;  // MCU pin controlling main sensor power
+/** End [logging_options] */
+
+
+// ==========================================================================
+//  Benchmark Options
+// ==========================================================================
+/** Start [benchmark_options] */
+// The number of logging cycles in each summary; the first cycle after a
+// restart isn't counted, since it has no sleep before it
+const uint8_t benchCycles = 20;
+// The current the whole station draws while asleep, in mA, read from a meter
+// on the battery; the processor can't measure it while it's asleep
+const float sleepCurrent_mA = 0.5;
+/** End [benchmark_options] */
+
+
+// ==========================================================================
+//  Wifi/Cellular Modem Options
+// ==========================================================================
+/** Start [sim_com_sim7080] */
+// For almost anything based on the SIMCom SIM7080G
+#include <modems/SIMComSIM7080.h>
+
+// Create a reference to the serial port for the modem
+HardwareSerial& modemSerial = Serial1;  // Use hardware serial if possible
+const int32_t   modemBaud   = 9600;  //  SIM7080 does auto-bauding by default
+
+// Modem Pins - Describe the physical pin connection of your modem to your board
+// NOTE:  Use -1 for pins that do not apply
+const int8_t modemVccPin     = 18;  // MCU pin controlling modem power
+const int8_t modemStatusPin  = 19;  // MCU pin used to read modem status
+const int8_t modemSleepRqPin = 23;  // MCU pin for modem sleep/wake request
+const int8_t modemLEDPin = redLED;  // MCU pin connected an LED to show modem
+                                    // status
+
+// Network connection information
+const char* apn = "hologram";  // APN connection name
+
+// Create the modem object
+SIMComSIM7080 modem7080(&modemSerial, modemVccPin, modemStatusPin,
+                        modemSleepRqPin, apn);
+// Create an extra reference to the modem by a generic name
+SIMComSIM7080 modem = modem7080;
+/** End [sim_com_sim7080] */
+
+
+// ==========================================================================
+//  Using the Processor as a Sensor
+// ==========================================================================
+/** Start [processor_sensor] */
+#include <sensors/ProcessorStats.h>
+
+// Create the main processor chip "sensor" - for general metadata
+const char*    mcuBoardVersion = "v1.1";
+ProcessorStats mcuBoard(mcuBoardVersion);
+/** End [processor_sensor] */
+
+
+// ==========================================================================
+//  Maxim DS3231 RTC (Real Time Clock)
+// ==========================================================================
+/** Start [ds3231] */
+#include <sensors/MaximDS3231.h>
+
+// Create a DS3231 sensor object
+MaximDS3231 ds3231(1);
+/** End [ds3231] */
+
+
+// ==========================================================================
+//  TI INA219 High Side Current/Voltage Sensor, for the energy of each phase
+// ==========================================================================
+/** Start [ina219] */
+#include <sensors/TIINA219.h>
+
+// The INA219 measures the current of the whole station on the battery
+// supply, so it's left powered (-1) to be read between the steps of any
+// sensor
+TIINA219 ina219(-1);
+
+// Reads the current for the LoggerProfiler
+float readStationCurrent(void) {
+    return ina219.readCurrent();
+}
+/** End [ina219] */
+
+
+// ==========================================================================
+//  Replayed Sensors
+// ==========================================================================
+/** Start [replay_sensors] */
+#include <sensors/ReplaySensor.h>
+
+// The bus sensors are replayed so every build is timed against the same
+// measurements; the times are those of a Meter Hydros 21 on SDI-12 and a
+// Yosemitech Y504 on Modbus, with one timed out Hydros reading
+const replayStep ctdSteps[] = {
+    {500, 0, 1200, true},
+    {500, 0, 1350, true},
+    {500, 0, 1250, true},
+    {500, 0, 3000, false},  // timed out
+};
+const float ctdValues[] = {
+    12.4,  18.9,  312,    // depth, temperature, conductivity
+    12.5,  18.9,  311,    //
+    12.5,  19.0,  311,    //
+    -9999, -9999, -9999,  //
+};
+ReplaySensor ctd("Hydros21", 3, ctdSteps, 4, ctdValues, sensorPowerPin, 6);
+
+const replayStep doSteps[] = {
+    {1275, 8000, 1700, true},
+    {1275, 8000, 1700, true},
+};
+const float doValues[] = {
+    9.12, 18.7,  // dissolved oxygen, temperature
+    9.10, 18.7,  //
+};
+ReplaySensor y504("Y504", 2, doSteps, 2, doValues, sensorPowerPin, 5);
+/** End [replay_sensors] */
+
+
+// ==========================================================================
+//  Creating the Variable Array[s] and Filling with Variable Objects
+// ==========================================================================
+/** Start [variable_arrays] */
+Variable* variableList[] = {
+    new ReplaySensor_Value(&ctd, 0, 1, "waterDepth", "millimeter", "CTDdepth"),
+    new ReplaySensor_Value(&ctd, 1, 1, "temperature", "degreeCelsius",
+                           "CTDtemp"),
+    new ReplaySensor_Value(&ctd, 2, 0, "specificConductance",
+                           "microsiemenPerCentimeter", "CTDcond"),
+    new ReplaySensor_Value(&y504, 0, 2, "oxygenDissolved",
+                           "milligramPerLiter", "Y504DOmgL"),
+    new ReplaySensor_Value(&y504, 1, 1, "temperature", "degreeCelsius",
+                           "Y504Temp"),
+    new ProcessorStats_Battery(&mcuBoard),
+    new MaximDS3231_Temp(&ds3231),
+    new TIINA219_Current(&ina219),
+    new Modem_SignalPercent(&modem),
+};
+
+/* clang-format off */
+const char* UUIDs[] =  // UUID array for device sensors
+    {
+        "12345678-abcd-1234-ef00-1234567890ab",  // Water depth (CTDdepth)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Temperature (CTDtemp)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Specific conductance (CTDcond)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Dissolved oxygen (Y504DOmgL)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Temperature (Y504Temp)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Battery voltage (EnviroDIY_Mayfly_Batt)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Temperature (EnviroDIY_Mayfly_Temp)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Current (TI_INA219_Current)
+        "12345678-abcd-1234-ef00-1234567890ab",  // Percent full scale (EnviroDIY_LTEB_SignalPercent)
+};
+const char* registrationToken = "12345678-abcd-1234-ef00-1234567890ab";  // Device registration token
+const char* samplingFeature = "12345678-abcd-1234-ef00-1234567890ab";  // Sampling feature UUID
+/* clang-format on */
+
+// Count up the number of pointers in the array
+int variableCount = sizeof(variableList) / sizeof(variableList[0]);
+
+// Create the VariableArray object
+VariableArray varArray(variableCount, variableList, UUIDs);
+/** End [variable_arrays] */
+
+
+// ==========================================================================
+//  The Logger Object[s]
+// ==========================================================================
+/** Start [loggers] */
+// Create a new logger instance
+Logger dataLogger(LoggerID, loggingInterval, &varArray);
+/** End [loggers] */
+
+
+// ==========================================================================
+//  Creating Data Publisher[s]
+// ==========================================================================
+/** Start [publishers] */
+// Create a data publisher for the Monitor My Watershed/EnviroDIY POST endpoint
+#include <publishers/EnviroDIYPublisher.h>
+EnviroDIYPublisher EnviroDIYPOST(dataLogger, &modem.gsmClient,
+                                 registrationToken, samplingFeature);
+
+// Create a data publisher for ThingSpeak
+const char* thingSpeakMQTTKey    = "XXXXXXXXXXXXXXXX";  // Your MQTT API Key
+const char* thingSpeakChannelID  = "######";  // The numeric channel id
+const char* thingSpeakChannelKey = "XXXXXXXXXXXXXXXX";  // The Write API Key
+#include <publishers/ThingSpeakPublisher.h>
+ThingSpeakPublisher TsMqtt(dataLogger, &modem.gsmClient, thingSpeakMQTTKey,
+                           thingSpeakChannelID, thingSpeakChannelKey);
+
+// The publishers, in the order they were created, for the summary
+const char* const publisherNames[] = {"EnviroDIY", "ThingSpeak"};
+const uint8_t     benchPublishers  = sizeof(publisherNames) /
+    sizeof(publisherNames[0]);
+/** End [publishers] */
+
+
+// ==========================================================================
+//  Collecting the Phase Times and Charges
+// ==========================================================================
+/** Start [benchmark_functions] */
+// The phases of a cycle in the summary; each publisher follows them
+enum benchPhase : uint8_t {
+    PHASE_SENSORS = 0,
+    PHASE_SD,
+    PHASE_MODEM_WAKE,
+    PHASE_ATTACH,
+    PHASE_TIME_SYNC,
+    PHASE_MODEM_SLEEP,
+    PHASE_SLEEP,
+    PHASE_CYCLE,
+    PHASE_COUNT
+};
+const char* const phaseNames[] = {"sensors",     "SD card",   "modem wake",
+                                  "attach",      "time sync", "modem sleep",
+                                  "sleep",       "awake cycle"};
+
+#ifdef MS_LOGGER_PROFILE
+uint32_t phaseTimes[PHASE_COUNT + benchPublishers][benchCycles];
+#ifdef MS_LOGGER_ENERGY
+float phaseCharges[PHASE_COUNT][benchCycles];
+#endif
+uint8_t  cyclesDone     = 0;
+uint32_t lastCycleMark  = 0;  // the UTC time of the last cycle
+uint32_t lastCycleAwake = 0;  // how long the last cycle was awake, in ms
+
+// The value at a percentile of the cycles so far, by nearest rank
+template <typename T>
+T percentile(const T* values, uint8_t pct) {
+    T sorted[benchCycles];
+    for (uint8_t i = 0; i < cyclesDone; i++) {
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > values[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = values[i];
+    }
+    uint8_t rank = (static_cast<uint16_t>(pct) * cyclesDone + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void printSummary() {
+    Serial.print(F("\nSummary of "));
+    Serial.print(cyclesDone);
+    Serial.println(F(" cycles"));
+#ifdef MS_LOGGER_ENERGY
+    Serial.println(F("phase\tmedian ms\tp95 ms\tmedian uAh\tp95 uAh"));
+#else
+    Serial.println(F("phase\tmedian ms\tp95 ms"));
+#endif
+    for (uint8_t p = 0; p < PHASE_COUNT + benchPublishers; p++) {
+        if (p < PHASE_COUNT) {
+            Serial.print(phaseNames[p]);
+        } else {
+            Serial.print(F("publish "));
+            Serial.print(publisherNames[p - PHASE_COUNT]);
+        }
+        Serial.print('\t');
+        Serial.print(percentile(phaseTimes[p], 50));
+        Serial.print('\t');
+        Serial.print(percentile(phaseTimes[p], 95));
+#ifdef MS_LOGGER_ENERGY
+        // The charge is only kept for each kind of span, not each publisher
+        if (p < PHASE_COUNT) {
+            Serial.print('\t');
+            Serial.print(percentile(phaseCharges[p], 50) * 1000, 1);
+            Serial.print('\t');
+            Serial.print(percentile(phaseCharges[p], 95) * 1000, 1);
+        }
+#endif
+        Serial.println();
+    }
+    Serial.println();
+}
+
+// Adds the spans of the cycle that just finished to the summary
+void collectCycle() {
+    uint32_t     cycle[PHASE_COUNT + benchPublishers] = {0};
+    profileEntry entry;
+    for (uint8_t i = 0; LoggerProfiler::getEntry(i, entry); i++) {
+        switch (entry.span) {
+            case SPAN_SENSORS: cycle[PHASE_SENSORS] += entry.duration_ms; break;
+            case SPAN_SD_OPEN:
+            case SPAN_SD_WRITE:
+            case SPAN_SD_CLOSE: cycle[PHASE_SD] += entry.duration_ms; break;
+            case SPAN_MODEM_WAKE:
+                cycle[PHASE_MODEM_WAKE] += entry.duration_ms;
+                break;
+            case SPAN_CONNECT: cycle[PHASE_ATTACH] += entry.duration_ms; break;
+            case SPAN_TIME_SYNC:
+                cycle[PHASE_TIME_SYNC] += entry.duration_ms;
+                break;
+            case SPAN_MODEM_SLEEP:
+                cycle[PHASE_MODEM_SLEEP] += entry.duration_ms;
+                break;
+            case SPAN_PUBLISH:
+                if (entry.detail < benchPublishers) {
+                    cycle[PHASE_COUNT + entry.detail] += entry.duration_ms;
+                }
+                break;
+            case SPAN_CYCLE: cycle[PHASE_CYCLE] += entry.duration_ms; break;
+            default: break;
+        }
+    }
+    // The totals of a cycle only move to the last cycle's when the next one
+    // starts, so start and end an empty one to read them now
+    LoggerProfiler::startCycle();
+    LoggerProfiler::endCycle();
+    LoggerProfiler::clearTrace();
+
+    // The sleep before this cycle is the time since the last one started
+    // less the time it was awake
+    uint32_t mark    = Logger::markedUTCEpochTime;
+    bool     counted = lastCycleMark != 0 &&
+        (mark - lastCycleMark) * 1000UL > lastCycleAwake;
+    if (counted) {
+        cycle[PHASE_SLEEP] = (mark - lastCycleMark) * 1000UL - lastCycleAwake;
+        for (uint8_t p = 0; p < PHASE_COUNT + benchPublishers; p++) {
+            phaseTimes[p][cyclesDone] = cycle[p];
+        }
+#ifdef MS_LOGGER_ENERGY
+        phaseCharges[PHASE_SENSORS][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_SENSORS);
+        phaseCharges[PHASE_SD][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_SD_OPEN) +
+            LoggerProfiler::getLastCycleCharge(SPAN_SD_WRITE) +
+            LoggerProfiler::getLastCycleCharge(SPAN_SD_CLOSE);
+        phaseCharges[PHASE_MODEM_WAKE][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_MODEM_WAKE);
+        phaseCharges[PHASE_ATTACH][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_CONNECT);
+        phaseCharges[PHASE_TIME_SYNC][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_TIME_SYNC);
+        phaseCharges[PHASE_MODEM_SLEEP][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_MODEM_SLEEP);
+        phaseCharges[PHASE_SLEEP][cyclesDone] = sleepCurrent_mA *
+            cycle[PHASE_SLEEP] / 3600000.0f;
+        phaseCharges[PHASE_CYCLE][cyclesDone] =
+            LoggerProfiler::getLastCycleCharge(SPAN_CYCLE);
+#endif
+        cyclesDone++;
+    }
+    lastCycleMark  = mark;
+    lastCycleAwake = cycle[PHASE_CYCLE];
+
+    if (cyclesDone == benchCycles) {
+        printSummary();
+        cyclesDone = 0;
+    }
+}
+#endif
+/** End [benchmark_functions] */
+
+
+// ==========================================================================
+//  Arduino Setup Function
+// ==========================================================================
+/** Start [setup] */
+void setup() {
+    // Start the primary serial connection
+    Serial.begin(serialBaud);
+
+    // Print a start-up note to the first serial port
+    Serial.print(F("Now running "));
+    Serial.print(sketchName);
+    Serial.print(F(" on Logger "));
+    Serial.println(LoggerID);
+    Serial.println();
+
+    Serial.print(F("Using ModularSensors Library version "));
+    Serial.println(MODULAR_SENSORS_VERSION);
+    Serial.print(F("TinyGSM Library version "));
+    Serial.println(TINYGSM_VERSION);
+    Serial.println();
+#ifndef MS_LOGGER_PROFILE
+    Serial.println(F("Build with MS_LOGGER_PROFILE or MS_LOGGER_ENERGY to "
+                     "time the phases of each cycle; only logging now."));
+#endif
+
+    // Start the serial connection with the modem
+    modemSerial.begin(modemBaud);
+
+    // Set up pins for the LED's
+    pinMode(greenLED, OUTPUT);
+    digitalWrite(greenLED, LOW);
+    pinMode(redLED, OUTPUT);
+    digitalWrite(redLED, LOW);
+
+    pinMode(20, OUTPUT);  // for proper operation of the onboard flash memory
+                          // chip's ChipSelect (Mayfly v1.0 and later)
+
+    // Set the timezones for the logger/data and the RTC
+    Logger::setLoggerTimeZone(timeZone);
+    Logger::setRTCTimeZone(0);
+
+    // Attach the modem and information pins to the logger
+    dataLogger.attachModem(modem);
+    modem.setModemLED(modemLEDPin);
+    dataLogger.setLoggerPins(wakePin, sdCardSSPin, sdCardPwrPin, buttonPin,
+                             greenLED);
+
+    // Begin the logger
+    dataLogger.begin();
+
+    // Set up the sensors
+    Serial.println(F("Setting up sensors..."));
+    varArray.setupSensors();
+#ifdef MS_LOGGER_ENERGY
+    // The INA219 was set up with the other sensors
+    LoggerProfiler::setCurrentSource(readStationCurrent);
+#endif
+
+    modem.setModemWakeLevel(HIGH);   // ModuleFun Bee inverts the signal
+    modem.setModemResetLevel(HIGH);  // ModuleFun Bee inverts the signal
+    modem.modemWake();               // NOTE:  This will also set up the modem
+    modem.gsmModem.setBaud(modemBaud);   // Make sure we're *NOT* auto-bauding!
+    modem.gsmModem.setNetworkMode(38);   // set to LTE only
+    modem.gsmModem.setPreferredMode(1);  // set to CAT-M
+
+    // Synchronize the RTC with NIST
+    dataLogger.syncRTC();
+
+    // Create the log file, adding the default header to it
+    dataLogger.turnOnSDcard(true);
+    dataLogger.createLogFile(true);
+    dataLogger.turnOffSDcard(true);
+
+#ifdef MS_LOGGER_PROFILE
+    // Only time the logging cycles
+    LoggerProfiler::clearTrace();
+    Serial.print(F("Printing a summary every "));
+    Serial.print(benchCycles);
+    Serial.println(F(" cycles"));
+#endif
+
+    // Call the processor sleep
+    Serial.println(F("Putting processor to sleep\n"));
+    dataLogger.systemSleep();
+}
+/** End [setup] */
+
+
+// ==========================================================================
+//  Arduino Loop Function
+// ==========================================================================
+/** Start [loop] */
+void loop() {
+#ifdef MS_LOGGER_PROFILE
+    uint32_t markBefore = Logger::markedUTCEpochTime;
+#endif
+    // Log, publish, and sleep until the next interval
+    dataLogger.logDataAndPublish();
+#ifdef MS_LOGGER_PROFILE
+    // Only a wake that logged marks a new time
+    if (Logger::markedUTCEpochTime != markBefore) { collectCycle(); }
+#endif
+}
+/** End [loop] */
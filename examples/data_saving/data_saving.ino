@@ -525,6 +525,10 @@ void loop() {
         // Power up the SD Card, but skip any waits after power up
         loggerAllVars.turnOnSDcard(false);
         loggerAllVars.watchDogTimer.resetWatchDog();
+#ifdef MS_LOGGER_SHARED_SD
+        // Keep the card mounted for both loggers until it's turned off below
+        Logger::openSDSession();
+#endif
 
         // Start the stream for the modbus sensors
         // Because RS485 adapters tend to "steal" current from the data pins
@@ -593,6 +597,9 @@ void loop() {
         }
 
         // Cut power from the SD card - without additional housekeeping wait
+#ifdef MS_LOGGER_SHARED_SD
+        Logger::closeSDSession();
+#endif
         loggerAllVars.turnOffSDcard(false);
         loggerAllVars.watchDogTimer.resetWatchDog();
         // Turn off the LED
@@ -303,6 +303,12 @@ void setup() {
 // The "if" statements in the loop determine what will happen - whether the
 // sensors update, testing mode starts, or it goes back to sleep.
 void loop() {
+#ifdef MS_LOGGER_SHARED_SD
+    // Write the files of both loggers with one mount of the SD card; each
+    // turnOffSDcard() leaves the card on until the session is closed
+    Logger::openSDSession();
+    bool wroteSD = false;
+#endif
     // Check if the current time is an even interval of the logging interval
     // For whichever logger we call first, use the checkInterval() function.
     if (logger1min.checkInterval()) {
@@ -339,6 +345,9 @@ void loop() {
         logger1min.logToSD();
         logger1min.turnOffSDcard(true);
         logger1min.watchDogTimer.resetWatchDog();
+#ifdef MS_LOGGER_SHARED_SD
+        wroteSD = true;
+#endif
 
         // Turn off the LED
         digitalWrite(greenLED, LOW);
@@ -382,12 +391,20 @@ void loop() {
         logger5min.logToSD();
         logger5min.turnOffSDcard(true);
         logger1min.watchDogTimer.resetWatchDog();
+#ifdef MS_LOGGER_SHARED_SD
+        wroteSD = true;
+#endif
 
         // Turn off the LED
         digitalWrite(redLED, LOW);
         // Print a line to show reading ended
         Serial.println(F("--------------------<555>---------------------\n"));
     }
+#ifdef MS_LOGGER_SHARED_SD
+    // Now turn the card off, once for both loggers
+    Logger::closeSDSession();
+    if (wroteSD) { logger1min.turnOffSDcard(true); }
+#endif
     // Once a day, at noon, sync the clock
     if (Logger::markedLocalEpochTime % 86400 == 43200) {
         // Turn on the modem
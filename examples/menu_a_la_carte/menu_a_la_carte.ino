@@ -795,6 +795,16 @@ Variable* mcuBoardAvailableRAM = new ProcessorStats_FreeRam(
     &mcuBoard, "12345678-abcd-1234-ef00-1234567890ab");
 Variable* mcuBoardSampNo = new ProcessorStats_SampleNumber(
     &mcuBoard, "12345678-abcd-1234-ef00-1234567890ab");
+#ifdef MS_PROCESSOR_MEMORY_STATS
+// Create the lowest free RAM, largest free heap block, and heap fragmentation
+// variable pointers for the processor
+Variable* mcuBoardMinRAM = new ProcessorStats_MinFreeRam(
+    &mcuBoard, "12345678-abcd-1234-ef00-1234567890ab");
+Variable* mcuBoardFreeBlock = new ProcessorStats_LargestFreeBlock(
+    &mcuBoard, "12345678-abcd-1234-ef00-1234567890ab");
+Variable* mcuBoardHeapFrag = new ProcessorStats_HeapFragmentation(
+    &mcuBoard, "12345678-abcd-1234-ef00-1234567890ab");
+#endif
 /** End [processor_stats] */
 
 
@@ -1819,10 +1829,55 @@ Variable* tbi2cTips =
     new RainCounterI2C_Tips(&tbi2c, "12345678-abcd-1234-ef00-1234567890ab");
 Variable* tbi2cDepth =
     new RainCounterI2C_Depth(&tbi2c, "12345678-abcd-1234-ef00-1234567890ab");
+#ifdef MS_RAIN_EVENT_TIMES
+// Create peak 1- and 5-minute intensity variable pointers from the tip times
+Variable* tbi2cPeak1 = new RainCounterI2C_Peak1Min(
+    &tbi2c, "12345678-abcd-1234-ef00-1234567890ab");
+Variable* tbi2cPeak5 = new RainCounterI2C_Peak5Min(
+    &tbi2c, "12345678-abcd-1234-ef00-1234567890ab");
+#endif
 /** End [rain_counter_i2c] */
 #endif
 
 
+#if defined BUILD_SENSOR_REPLAY_SENSOR
+// ==========================================================================
+//  A Replayed Sensor Trace
+// ==========================================================================
+/** Start [replay_sensor] */
+#include <sensors/ReplaySensor.h>
+
+// The warm-up, stabilization, and measurement times in ms of each recorded
+// measurement, and whether it succeeded
+const replayStep replaySteps[] = {
+    {500, 0, 1200, true},
+    {500, 0, 1350, true},
+    {500, 0, 3000, false},  // timed out
+};
+// The values recorded for each measurement, in the order of the variables
+const float replayValues[] = {
+    12.4,  18.9,   // depth and temperature of the first step
+    12.5,  19.0,   // the second step
+    -9999, -9999,  // the third step, which failed
+};
+// NOTE: Use -1 for any pins that don't apply or aren't being used.
+const int8_t replayPower = sensorPowerPin;  // Power pin
+
+// Create a sensor object replaying the trace in place of a real sensor
+ReplaySensor replay("ReplayedCTD", 2, replaySteps, 3, replayValues,
+                    replayPower);
+
+// Create depth and temperature variable pointers for the replayed values
+Variable* replayDepth =
+    new ReplaySensor_Value(&replay, 0, 1, "waterDepth", "millimeter",
+                           "CTDdepth", "12345678-abcd-1234-ef00-1234567890ab");
+Variable* replayTemp =
+    new ReplaySensor_Value(&replay, 1, 1, "temperature", "degreeCelsius",
+                           "CTDtemp", "12345678-abcd-1234-ef00-1234567890ab");
+/** End [replay_sensor] */
+#endif
+
+
 #if defined BUILD_SENSOR_SENSIRION_SHT4X
 // ==========================================================================
 //  Sensirion SHT4X Digital Humidity and Temperature Sensor
@@ -2581,6 +2636,11 @@ Variable* variableList[] = {
     mcuBoardSampNo,
     mcuBoardAvailableRAM,
     mcuBoardBatt,
+#ifdef MS_PROCESSOR_MEMORY_STATS
+    mcuBoardMinRAM,
+    mcuBoardFreeBlock,
+    mcuBoardHeapFrag,
+#endif
     calculatedVar,
 #if defined(ARDUINO_ARCH_AVR) || defined(MS_SAMD_DS3231)
     ds3231Temp,
@@ -2747,6 +2807,14 @@ Variable* variableList[] = {
 #if defined BUILD_SENSOR_RAIN_COUNTER_I2C
     tbi2cTips,
     tbi2cDepth,
+#ifdef MS_RAIN_EVENT_TIMES
+    tbi2cPeak1,
+    tbi2cPeak5,
+#endif
+#endif
+#if defined BUILD_SENSOR_REPLAY_SENSOR
+    replayDepth,
+    replayTemp,
 #endif
 #if defined BUILD_SENSOR_SENSIRION_SHT4X
     sht4xHumid,
@@ -2958,6 +3026,66 @@ UbidotsPublisher ubidots(dataLogger, &modem.gsmClient, ubidotsToken,
 #endif
 
 
+#if defined BUILD_PUB_CBOR_PUBLISHER
+// ==========================================================================
+//  CBOR Data Publisher
+// ==========================================================================
+/** Start [cbor_publisher] */
+// The host name, path, and port of your own receiver for the CBOR posts
+const char*    cborHost = "data.example.com";
+const char*    cborPath = "/cbor";
+const uint16_t cborPort = 80;
+
+// Create a data publisher posting CBOR to a receiver of your own
+#include <publishers/CBORPublisher.h>
+CBORPublisher cborPost(dataLogger, &modem.gsmClient, cborHost, cborPath,
+                       cborPort);
+/** End [cbor_publisher] */
+#endif
+
+
+#if defined BUILD_PUB_MQTT_PUBLISHER
+// ==========================================================================
+//  MQTT Data Publisher
+// ==========================================================================
+/** Start [mqtt_publisher] */
+// The host name and port of your MQTT broker
+const char*    mqttBroker = "broker.example.com";
+const uint16_t mqttPort   = 1883;
+// The topic to publish to; "{id}" is replaced with the logger ID and "{uuid}"
+// with the sampling feature UUID
+const char* mqttTopic = "loggers/{id}/data";
+
+// Create a data publisher for an MQTT broker of your own
+#include <publishers/MQTTPublisher.h>
+MQTTPublisher mqttPub(dataLogger, &modem.gsmClient, mqttBroker, mqttTopic,
+                      mqttPort);
+/** End [mqtt_publisher] */
+#endif
+
+
+#if defined BUILD_PUB_CO_AP_PUBLISHER
+// ==========================================================================
+//  CoAP Data Publisher
+// ==========================================================================
+/** Start [co_ap_publisher] */
+// The host name, path, and UDP port of your own receiver for the CoAP messages
+const char*    coapHost = "data.example.com";
+const char*    coapPath = "/cbor";
+const uint16_t coapPort = 5683;
+// The UDP instance to send the messages with.  The TinyGSM clients of the
+// modems are TCP only, so point this at the UDP of your network library (like
+// a WiFiUDP or an EthernetUDP) and call begin() on it with a local port in the
+// setup.  Nothing is sent while there isn't one.
+UDP* coapUDP = nullptr;
+
+// Create a data publisher sending CoAP messages to a receiver of your own
+#include <publishers/CoAPPublisher.h>
+CoAPPublisher coapPub(dataLogger, coapUDP, coapHost, coapPath, coapPort);
+/** End [co_ap_publisher] */
+#endif
+
+
 // ==========================================================================
 //  Working Functions
 // ==========================================================================
@@ -0,0 +1,208 @@
+/**
+ * @file binary_to_csv.ino
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Converts a binary log file written with the MS_LOGGER_BINARY_FORMAT
+ * build flag back into the csv file the logger would have written without it.
+ * Files with delta encoded records (MS_LOGGER_DELTA_ENCODING) are read too.
+ *
+ * Put the SD card with the binary file into any logger, set the card pins and
+ * the file name below, and upload this sketch.  The csv is written next to
+ * the binary file with the same name and a ".csv" extension.
+ */
+
+#include <Arduino.h>
+#include <SdFat.h>
+#include <Sodaq_DS3231.h>
+
+// These must match the values in LoggerBase.h
+#define MS_BINARY_LOG_MAGIC "MSLB"
+#define MS_BINARY_LOG_VERSION 1
+#define MS_BINARY_LOG_DELTA_VERSION 2
+#define EPOCH_TIME_OFF 946684800
+
+// The SD card slave select and power pins; these are for a Mayfly
+const int8_t sdCardSSPin  = 12;
+const int8_t sdCardPwrPin = -1;
+
+// The binary file to convert
+const char* binaryFileName = "MyLogger_2024-01-01.bin";
+
+SdFat sd;
+File  binaryFile;
+File  csvFile;
+
+
+// Reads a fixed number of bytes from the binary file
+bool readBytes(void* buffer, size_t length) {
+    return binaryFile.read(buffer, length) == static_cast<int>(length);
+}
+
+
+// Reads a zigzag varint from the binary file
+bool readZigzag(int32_t& value) {
+    uint32_t raw   = 0;
+    uint8_t  shift = 0;
+    int      c;
+    do {
+        c = binaryFile.read();
+        if (c < 0 || shift > 28) { return false; }
+        raw |= static_cast<uint32_t>(c & 0x7F) << shift;
+        shift += 7;
+    } while (c & 0x80);
+    value = static_cast<int32_t>((raw >> 1) ^ (~(raw & 1) + 1));
+    return true;
+}
+
+
+// Turns a whole number of units of the resolution back into a value
+float fromWhole(int32_t whole, uint8_t resolution) {
+    float value = whole;
+    for (uint8_t r = 0; r < resolution; r++) { value /= 10; }
+    return value;
+}
+
+
+// Writes one value the same way Variable::getValueChars() does
+void printValue(float value, uint8_t resolution) {
+    char buffer[33];
+    if (resolution == 0) {
+        itoa(static_cast<int16_t>(value), buffer, 10);
+    } else {
+        dtostrf(value, resolution + 2, resolution, buffer);
+    }
+    csvFile.print(buffer);
+}
+
+
+bool convertFile() {
+    if (!binaryFile.open(binaryFileName, O_RDONLY)) {
+        Serial.println(F("Unable to open the binary file"));
+        return false;
+    }
+
+    // Check the magic and version
+    char    magic[4];
+    uint8_t version;
+    uint8_t varCount;
+    if (!readBytes(magic, 4) || strncmp(magic, MS_BINARY_LOG_MAGIC, 4) != 0 ||
+        !readBytes(&version, 1) ||
+        (version != MS_BINARY_LOG_VERSION &&
+         version != MS_BINARY_LOG_DELTA_VERSION) ||
+        !readBytes(&varCount, 1)) {
+        Serial.println(F("This is not a binary log file this sketch can read"));
+        return false;
+    }
+
+    // Make the csv file name from the binary one
+    char csvFileName[64];
+    strncpy(csvFileName, binaryFileName, sizeof(csvFileName) - 5);
+    csvFileName[sizeof(csvFileName) - 5] = '\0';
+    char* extension                      = strrchr(csvFileName, '.');
+    if (extension != nullptr) { *extension = '\0'; }
+    strcat(csvFileName, ".csv");
+    if (!csvFile.open(csvFileName, O_CREAT | O_WRITE | O_TRUNC)) {
+        Serial.println(F("Unable to create the csv file"));
+        return false;
+    }
+
+    // The text header is copied as is
+    int c;
+    while ((c = binaryFile.read()) > 0) {
+        csvFile.write(static_cast<uint8_t>(c));
+    }
+    if (c < 0) {
+        Serial.println(F("The file header is incomplete"));
+        return false;
+    }
+
+    uint8_t resolutions[256];
+    uint8_t keyframeInterval = 0;
+    if (!readBytes(resolutions, varCount) ||
+        (version == MS_BINARY_LOG_DELTA_VERSION &&
+         !readBytes(&keyframeInterval, 1))) {
+        Serial.println(F("The file header is incomplete"));
+        return false;
+    }
+
+    // Convert every complete record
+    uint32_t nRecords     = 0;
+    uint32_t recordTime   = 0;
+    float    values[256];
+    int32_t  wholeValues[256];
+    bool     haveKeyframe = false;
+    int      valueBytes   = static_cast<int>(sizeof(float)) * varCount;
+    while (true) {
+        if (version == MS_BINARY_LOG_VERSION) {
+            if (!readBytes(&recordTime, sizeof(recordTime))) { break; }
+            // Stop at a record cut short by a reset or power loss
+            if (binaryFile.available() < valueBytes) { break; }
+            readBytes(values, valueBytes);
+        } else {
+            // Stop at a record cut short by a reset or power loss, or at
+            // deltas with no keyframe before them
+            int tag = binaryFile.read();
+            if (tag == 'K') {
+                if (!readBytes(&recordTime, sizeof(recordTime))) { break; }
+                haveKeyframe = true;
+            } else if (tag == 'D' && haveKeyframe) {
+                int32_t timeChange;
+                if (!readZigzag(timeChange)) { break; }
+                recordTime += timeChange;
+            } else {
+                break;
+            }
+            bool complete = true;
+            for (uint8_t i = 0; i < varCount && complete; i++) {
+                int32_t change;
+                complete = readZigzag(change);
+                // Wrap around the same way the logger did
+                wholeValues[i] = tag == 'K'
+                    ? change
+                    : static_cast<int32_t>(
+                          static_cast<uint32_t>(wholeValues[i]) +
+                          static_cast<uint32_t>(change));
+                values[i] = fromWhole(wholeValues[i], resolutions[i]);
+            }
+            if (!complete) { break; }
+        }
+        String timeString = "";
+        DateTime(recordTime - EPOCH_TIME_OFF).addToString(timeString);
+        csvFile.print(timeString);
+        csvFile.print(',');
+        for (uint8_t i = 0; i < varCount; i++) {
+            printValue(values[i], resolutions[i]);
+            if (i + 1 != varCount) { csvFile.print(','); }
+        }
+        csvFile.println();
+        nRecords++;
+    }
+
+    csvFile.close();
+    binaryFile.close();
+    Serial.print(F("Wrote "));
+    Serial.print(nRecords);
+    Serial.print(F(" records to "));
+    Serial.println(csvFileName);
+    return true;
+}
+
+
+void setup() {
+    Serial.begin(115200);
+
+    if (sdCardPwrPin >= 0) {
+        pinMode(sdCardPwrPin, OUTPUT);
+        digitalWrite(sdCardPwrPin, HIGH);
+        delay(6);
+    }
+    if (!sd.begin(sdCardSSPin, SPI_FULL_SPEED)) {
+        Serial.println(F("Error: SD card failed to initialize or is missing."));
+        return;
+    }
+    convertFile();
+}
+
+void loop() {}
@@ -0,0 +1,148 @@
+#!/usr/bin/env python
+"""Turn the tokenized debugging records of MS_DEBUG_TOKENIZED back into text.
+
+The logger writes the raw records to the debugging port each time it goes to
+sleep.  Save them from the port to a file, then run:
+
+    python decode_debug_tokens.py firmware.elf capture.bin
+
+with the ELF file of the same build the records came from; with PlatformIO it
+is .pio/build/<env>/firmware.elf.  Each text marked with F() is only written
+as its address in flash, so it's looked up in the ELF.  Each record is printed
+as MS_DBG would have printed it, after the processor millis it was taken at.
+Bytes that aren't part of a good record, like the start of one that was
+written over in the ring buffer, are skipped.
+
+Needs pyelftools (pip install pyelftools).
+"""
+
+import argparse
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+FRAME_MARKER = 0xD5
+# The struct formats of the numbers, by their type and size
+NUMBER_FORMATS = {
+    "i": {1: "b", 2: "h", 4: "i", 8: "q"},
+    "u": {1: "B", 2: "H", 4: "I", 8: "Q"},
+    "f": {4: "f"},
+}
+
+
+class StringTable:
+    """The text of the program's flash, by address."""
+
+    def __init__(self, elf_path):
+        self.sections = []
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                # Only sections loaded into the program, with contents
+                if not section["sh_flags"] & 0x2 or section["sh_type"] == "SHT_NOBITS":
+                    continue
+                self.sections.append((section["sh_addr"], section.data()))
+        self.cache = {}
+
+    def lookup(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        text = "<0x{:x}>".format(address)
+        for start, data in self.sections:
+            if start <= address < start + len(data):
+                end = data.find(b"\0", address - start)
+                if end < 0:
+                    end = len(data)
+                text = data[address - start : end].decode("latin-1")
+                break
+        self.cache[address] = text
+        return text
+
+
+def read_record(data, pos, strings):
+    """Read the record starting after the marker at pos.
+
+    Returns the millis, the module, the arguments as text and the position
+    after the record, or None if it isn't a good record.
+    """
+    if pos + 5 > len(data):
+        return None
+    (millis,) = struct.unpack_from("<I", data, pos + 1)
+    pos += 5
+    items = []
+    while pos < len(data):
+        kind = chr(data[pos])
+        pos += 1
+        if data[pos - 1] == 0:
+            if not items:
+                return None
+            return millis, items[0], items[1:], pos
+        if kind == "F":
+            if pos + 4 > len(data):
+                return None
+            (address,) = struct.unpack_from("<I", data, pos)
+            items.append(strings.lookup(address))
+            pos += 4
+        elif kind == "T":
+            end = data.find(b"\0", pos)
+            if end < 0:
+                return None
+            items.append(data[pos:end].decode("latin-1"))
+            pos = end + 1
+        elif kind == "c":
+            if pos + 1 > len(data):
+                return None
+            items.append(chr(data[pos]))
+            pos += 1
+        elif kind in "iuf":
+            if pos + 1 > len(data):
+                return None
+            size = data[pos]
+            if size not in NUMBER_FORMATS[kind] or pos + 1 + size > len(data):
+                return None
+            (value,) = struct.unpack_from("<" + NUMBER_FORMATS[kind][size], data, pos + 1)
+            # Print floats with two decimals, like the Arduino Print class
+            items.append("{:.2f}".format(value) if kind == "f" else str(value))
+            pos += 1 + size
+        else:
+            return None
+    return None
+
+
+def decode(data, strings, out):
+    pos = 0
+    skipped = 0
+    while pos < len(data):
+        if data[pos] != FRAME_MARKER:
+            pos += 1
+            skipped += 1
+            continue
+        record = read_record(data, pos, strings)
+        if record is None:
+            pos += 1
+            skipped += 1
+            continue
+        millis, module, args, pos = record
+        out.write("{:>10} {} <--{}\n".format(millis, " ".join(args), module))
+    if skipped:
+        sys.stderr.write("Skipped {} bytes that weren't in a good record\n".format(skipped))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("elf", help="the ELF file of the build")
+    parser.add_argument("capture", help="the raw bytes from the debugging port; - for stdin")
+    args = parser.parse_args()
+
+    strings = StringTable(args.elf)
+    if args.capture == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    decode(data, strings, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,75 @@
+/**
+ * @file Arduino.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the minimal stand-in for the Arduino core.
+ */
+
+#include "Arduino.h"
+
+MockSerial       Serial;
+volatile uint8_t mockPortInput = 0;
+
+static uint32_t mockMillis = 0;
+
+uint32_t millis(void) {
+    return mockMillis++;
+}
+uint32_t micros(void) {
+    return mockMillis * 1000;
+}
+void delay(uint32_t ms) {
+    mockMillis += ms;
+}
+void delayMicroseconds(uint32_t) {}
+void yield(void) {}
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int  digitalRead(uint8_t) {
+    return LOW;
+}
+int analogRead(uint8_t) {
+    return 0;
+}
+
+void mockAdvanceMillis(uint32_t ms) {
+    mockMillis += ms;
+}
+void mockSetMillis(uint32_t ms) {
+    mockMillis = ms;
+}
+
+
+char* dtostrf(double value, signed char width, unsigned char precision,
+              char* buffer) {
+    sprintf(buffer, "%*.*f", width, precision, value);
+    return buffer;
+}
+
+
+char* ultoa(unsigned long value, char* buffer, int base) {
+    char  digits[34];
+    char* d = digits;
+    do {
+        unsigned long digit = value % base;
+        *d++  = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+    char* out = buffer;
+    while (d > digits) *out++ = *--d;
+    *out = '\0';
+    return buffer;
+}
+char* ltoa(long value, char* buffer, int base) {
+    if (value < 0 && base == 10) {
+        buffer[0] = '-';
+        ultoa(-static_cast<unsigned long>(value), buffer + 1, base);
+        return buffer;
+    }
+    return ultoa(static_cast<unsigned long>(value), buffer, base);
+}
+char* itoa(int value, char* buffer, int base) {
+    return ltoa(value, buffer, base);
+}
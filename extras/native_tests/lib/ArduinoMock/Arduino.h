@@ -0,0 +1,350 @@
+/**
+ * @file Arduino.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief A minimal stand-in for the Arduino core, for building the parts of
+ * the library without any hardware dependency on a computer.
+ *
+ * Only what those parts use is here.  Pins do nothing and read low, and
+ * Serial writes to the standard output.  The processor time is a counter that
+ * moves on a millisecond at each call to millis(), so anything waiting on it
+ * finishes without the tests taking real time; delay() and
+ * mockAdvanceMillis() move it on further.
+ */
+
+// Header Guards
+#ifndef MOCK_ARDUINO_H_
+#define MOCK_ARDUINO_H_
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+#define pgm_read_float(addr) (*reinterpret_cast<const float*>(addr))
+#define pgm_read_ptr(addr) (*reinterpret_cast<void* const*>(addr))
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define memcpy_P memcpy
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) \
+    ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+
+template <typename T, typename U>
+auto min(T a, U b) -> decltype(a < b ? a : b) {
+    return a < b ? a : b;
+}
+template <typename T, typename U>
+auto max(T a, U b) -> decltype(a > b ? a : b) {
+    return a > b ? a : b;
+}
+#define constrain(amt, low, high) \
+    ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class __FlashStringHelper;
+#define F(string_literal) \
+    (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+
+uint32_t millis(void);
+uint32_t micros(void);
+void     delay(uint32_t ms);
+void     delayMicroseconds(uint32_t us);
+void     yield(void);
+void     pinMode(uint8_t pin, uint8_t mode);
+void     digitalWrite(uint8_t pin, uint8_t value);
+int      digitalRead(uint8_t pin);
+int      analogRead(uint8_t pin);
+char*    dtostrf(double value, signed char width, unsigned char precision,
+                 char* buffer);
+char*    itoa(int value, char* buffer, int base);
+char*    ltoa(long value, char* buffer, int base);
+char*    ultoa(unsigned long value, char* buffer, int base);
+
+// Every pin is bit 0 of a port that always reads low
+extern volatile uint8_t mockPortInput;
+#define digitalPinToBitMask(pin) (1)
+#define digitalPinToPort(pin) (0)
+#define portInputRegister(port) (&mockPortInput)
+
+/**
+ * @brief Move the processor time on.
+ *
+ * @param ms The number of milliseconds to move it on
+ */
+void mockAdvanceMillis(uint32_t ms);
+/**
+ * @brief Set the processor time, ie, to just before millis() rolls over.
+ *
+ * @param ms The new processor time
+ */
+void mockSetMillis(uint32_t ms);
+
+
+/**
+ * @brief Text, kept in a std::string.
+ */
+class String {
+ public:
+    String(const char* text = "") : _text(text == nullptr ? "" : text) {}
+    String(const __FlashStringHelper* text)
+        : _text(reinterpret_cast<const char*>(text)) {}
+    String(const std::string& text) : _text(text) {}
+    explicit String(char c) : _text(1, c) {}
+    explicit String(int value, int base = DEC) : _text(number(value, base)) {}
+    explicit String(unsigned int value, int base = DEC)
+        : _text(number(value, base)) {}
+    explicit String(long value, int base = DEC) : _text(number(value, base)) {}
+    explicit String(unsigned long value, int base = DEC)
+        : _text(number(value, base)) {}
+    explicit String(float value, unsigned char decimals = 2)
+        : _text(fixed(value, decimals)) {}
+    explicit String(double value, unsigned char decimals = 2)
+        : _text(fixed(value, decimals)) {}
+
+    const char* c_str(void) const {
+        return _text.c_str();
+    }
+    unsigned int length(void) const {
+        return _text.length();
+    }
+    bool equals(const String& other) const {
+        return _text == other._text;
+    }
+    bool operator==(const String& other) const {
+        return _text == other._text;
+    }
+    bool operator!=(const String& other) const {
+        return _text != other._text;
+    }
+    char operator[](unsigned int index) const {
+        return index < _text.length() ? _text[index] : '\0';
+    }
+    int indexOf(char c) const {
+        size_t at = _text.find(c);
+        return at == std::string::npos ? -1 : static_cast<int>(at);
+    }
+    String substring(unsigned int from) const {
+        return from < _text.length() ? String(_text.substr(from)) : String();
+    }
+    String substring(unsigned int from, unsigned int to) const {
+        return from < to && from < _text.length()
+            ? String(_text.substr(from, to - from))
+            : String();
+    }
+    void toCharArray(char* buffer, unsigned int size) const {
+        if (size == 0) return;
+        strncpy(buffer, _text.c_str(), size - 1);
+        buffer[size - 1] = '\0';
+    }
+    void reserve(unsigned int size) {
+        _text.reserve(size);
+    }
+    String& operator+=(const String& other) {
+        _text += other._text;
+        return *this;
+    }
+    String& operator+=(const char* other) {
+        _text += other;
+        return *this;
+    }
+    String& operator+=(char c) {
+        _text += c;
+        return *this;
+    }
+    bool concat(const String& other) {
+        _text += other._text;
+        return true;
+    }
+    friend String operator+(const String& a, const String& b) {
+        return String(a._text + b._text);
+    }
+    friend String operator+(const String& a, const char* b) {
+        return String(a._text + b);
+    }
+    friend String operator+(const char* a, const String& b) {
+        return String(a + b._text);
+    }
+    friend String operator+(const String& a, char b) {
+        return String(a._text + b);
+    }
+
+ private:
+    static std::string number(long value, int base) {
+        char buffer[34];
+        ltoa(value, buffer, base);
+        return buffer;
+    }
+    static std::string number(unsigned long value, int base) {
+        char buffer[34];
+        ultoa(value, buffer, base);
+        return buffer;
+    }
+    static std::string number(int value, int base) {
+        return number(static_cast<long>(value), base);
+    }
+    static std::string number(unsigned int value, int base) {
+        return number(static_cast<unsigned long>(value), base);
+    }
+    static std::string fixed(double value, unsigned char decimals) {
+        char buffer[40];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        return buffer;
+    }
+    std::string _text;
+};
+
+
+/**
+ * @brief The Arduino Print class, writing a byte at a time.
+ */
+class Print {
+ public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) n += write(*buffer++);
+        return n;
+    }
+    size_t write(const char* text) {
+        return text == nullptr
+            ? 0
+            : write(reinterpret_cast<const uint8_t*>(text), strlen(text));
+    }
+    size_t write(const char* buffer, size_t size) {
+        return write(reinterpret_cast<const uint8_t*>(buffer), size);
+    }
+    virtual int availableForWrite(void) {
+        return 0;
+    }
+    virtual void flush(void) {}
+
+    size_t print(const __FlashStringHelper* text) {
+        return write(reinterpret_cast<const char*>(text));
+    }
+    size_t print(const String& text) {
+        return write(text.c_str());
+    }
+    size_t print(const char* text) {
+        return write(text);
+    }
+    size_t print(char c) {
+        return write(static_cast<uint8_t>(c));
+    }
+    size_t print(unsigned char value, int base = DEC) {
+        return print(static_cast<unsigned long>(value), base);
+    }
+    size_t print(int value, int base = DEC) {
+        return print(static_cast<long>(value), base);
+    }
+    size_t print(unsigned int value, int base = DEC) {
+        return print(static_cast<unsigned long>(value), base);
+    }
+    size_t print(long value, int base = DEC) {
+        char buffer[34];
+        return write(ltoa(value, buffer, base));
+    }
+    size_t print(unsigned long value, int base = DEC) {
+        char buffer[34];
+        return write(ultoa(value, buffer, base));
+    }
+    size_t print(double value, int decimals = 2) {
+        char buffer[40];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        return write(buffer);
+    }
+    template <typename T>
+    size_t println(T value) {
+        return print(value) + println();
+    }
+    template <typename T>
+    size_t println(T value, int format) {
+        return print(value, format) + println();
+    }
+    size_t println(void) {
+        return write("\r\n");
+    }
+};
+
+
+/**
+ * @brief The Arduino Stream class; nothing is ever there to read.
+ */
+class Stream : public Print {
+ public:
+    virtual int available(void) {
+        return 0;
+    }
+    virtual int read(void) {
+        return -1;
+    }
+    virtual int peek(void) {
+        return -1;
+    }
+    void setTimeout(uint32_t timeout) {
+        _timeout = timeout;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        size_t n = 0;
+        while (n < length && available() > 0) buffer[n++] = read();
+        return n;
+    }
+    size_t readBytes(char* buffer, size_t length) {
+        return readBytes(reinterpret_cast<uint8_t*>(buffer), length);
+    }
+
+ protected:
+    uint32_t _timeout = 1000;
+};
+
+
+/**
+ * @brief A serial port that writes to the standard output.
+ */
+class MockSerial : public Stream {
+ public:
+    void begin(uint32_t) {}
+    void end(void) {}
+    size_t write(uint8_t c) override {
+        return fputc(c, stdout) == EOF ? 0 : 1;
+    }
+    using Print::write;
+    int availableForWrite(void) override {
+        return 64;
+    }
+    operator bool() {
+        return true;
+    }
+};
+extern MockSerial Serial;
+
+#endif  // MOCK_ARDUINO_H_
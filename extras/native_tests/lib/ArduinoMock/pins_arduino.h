@@ -0,0 +1,8 @@
+/**
+ * @file pins_arduino.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief An empty stand-in for the board pin definitions.
+ */
@@ -0,0 +1,91 @@
+/**
+ * @file FakeSensor.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the FakeSensor class, a sensor with set timing that gives a
+ * list of values, for the native tests.
+ */
+
+// Header Guards
+#ifndef FAKESENSOR_H_
+#define FAKESENSOR_H_
+
+#include "SensorBase.h"
+#include "VariableBase.h"
+
+/**
+ * @brief A sensor with no hardware that takes the given times to warm up and
+ * measure and gives the values it's handed, one per measurement, and then
+ * -9999.
+ *
+ * Each sensor notes the processor time of each of its results, and all of
+ * them together note the order they finished their measurements in.
+ */
+class FakeSensor : public Sensor {
+ public:
+    FakeSensor(const char* sensorName, uint32_t measurementTime_ms,
+               uint8_t measurementsToAverage = 1, uint32_t warmUpTime_ms = 0)
+        : Sensor(sensorName, 1, warmUpTime_ms, 0, measurementTime_ms, -1, -1,
+                 measurementsToAverage) {}
+
+    /**
+     * @brief Set the values to give, in order.
+     *
+     * @param values The values; the array must outlast the sensor's use
+     * @param count The number of values
+     */
+    void setValues(const float* values, uint8_t count) {
+        _values     = values;
+        _valueCount = count;
+        _nextValue  = 0;
+    }
+
+    bool addSingleMeasurementResult(void) override {
+        float value = _nextValue < _valueCount ? _values[_nextValue++] : -9999;
+        verifyAndAddMeasurementResult(0, value);
+        lastResultAt = millis();
+        if (finishedCount < sizeof(finished) / sizeof(finished[0])) {
+            finished[finishedCount++] = this;
+        }
+        // Unset the time stamp for the beginning of this measurement
+        _millisMeasurementRequested = 0;
+        // Unset the status bits for a measurement request (bits 5 & 6)
+        _sensorStatus &= 0b10011111;
+        return true;
+    }
+
+    /// The processor time of the last result
+    uint32_t lastResultAt = 0;
+
+    /// The sensors in the order they finished measurements
+    static FakeSensor* finished[32];
+    /// The number of measurements finished
+    static uint8_t finishedCount;
+
+ private:
+    const float* _values     = nullptr;
+    uint8_t      _valueCount = 0;
+    uint8_t      _nextValue  = 0;
+};
+
+/**
+ * @brief Start over the order the sensors finished in; define the storage
+ * for it once in each test program with FAKE_SENSOR_STORAGE.
+ */
+#define FAKE_SENSOR_STORAGE                    \
+    FakeSensor* FakeSensor::finished[32] = {}; \
+    uint8_t     FakeSensor::finishedCount = 0;
+
+/**
+ * @brief The one result of a FakeSensor.
+ */
+class FakeVariable : public Variable {
+ public:
+    explicit FakeVariable(FakeSensor* parentSense,
+                          const char* uuid = "", const char* varCode = "Fake")
+        : Variable(parentSense, 0, 2, "fake", "unit", varCode, uuid) {}
+};
+
+#endif  // FAKESENSOR_H_
@@ -0,0 +1,125 @@
+/**
+ * @file test_main.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Tests that an update with the deadline scheduler
+ * (#MS_USE_DEADLINE_SCHEDULER) reads each sensor in the order its
+ * measurements finish, even across the rollover of millis().
+ */
+
+#include <unity.h>
+#include "VariableArray.h"
+#include "FakeSensor.h"
+
+FAKE_SENSOR_STORAGE
+
+void setUp(void) {
+    FakeSensor::finishedCount = 0;
+    mockSetMillis(1000);
+}
+void tearDown(void) {}
+
+
+void test_sensors_read_in_deadline_order(void) {
+    FakeSensor   slow("Slow", 300);
+    FakeSensor   fast("Fast", 100);
+    FakeSensor   middle("Middle", 200);
+    FakeVariable slowVar(&slow);
+    FakeVariable fastVar(&fast);
+    FakeVariable middleVar(&middle);
+    Variable*    variables[] = {&slowVar, &fastVar, &middleVar};
+    VariableArray array(3, variables);
+    array.setupSensors();
+
+    TEST_ASSERT_TRUE(array.completeUpdate());
+    TEST_ASSERT_EQUAL_UINT8(3, FakeSensor::finishedCount);
+    TEST_ASSERT_EQUAL_PTR(&fast, FakeSensor::finished[0]);
+    TEST_ASSERT_EQUAL_PTR(&middle, FakeSensor::finished[1]);
+    TEST_ASSERT_EQUAL_PTR(&slow, FakeSensor::finished[2]);
+}
+
+
+void test_many_sensors_read_in_deadline_order(void) {
+    // Enough sensors for the heap to sift through a few levels
+    const uint32_t times[] = {500, 100, 400, 200, 700, 300, 50, 600};
+    const uint8_t  order[] = {6, 1, 3, 5, 2, 0, 7, 4};
+    // The array tells sensors apart by their names and locations
+    const char*    names[] = {"A", "B", "C", "D", "E", "F", "G", "H"};
+    const uint8_t  count   = sizeof(times) / sizeof(times[0]);
+    FakeSensor*    sensors[count];
+    FakeVariable*  fakeVars[count];
+    Variable*      variables[count];
+    for (uint8_t i = 0; i < count; i++) {
+        sensors[i]   = new FakeSensor(names[i], times[i]);
+        fakeVars[i]  = new FakeVariable(sensors[i]);
+        variables[i] = fakeVars[i];
+    }
+    VariableArray array(count, variables);
+    array.setupSensors();
+
+    TEST_ASSERT_TRUE(array.completeUpdate());
+    TEST_ASSERT_EQUAL_UINT8(count, FakeSensor::finishedCount);
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_PTR(sensors[order[i]], FakeSensor::finished[i]);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        delete fakeVars[i];
+        delete sensors[i];
+    }
+}
+
+
+void test_repeated_measurements_interleave(void) {
+    // Three readings 100ms apart finish before one of 250ms
+    FakeSensor   often("Often", 100, 3);
+    FakeSensor   once("Once", 250);
+    FakeVariable oftenVar(&often);
+    FakeVariable onceVar(&once);
+    Variable*    variables[] = {&onceVar, &oftenVar};
+    VariableArray array(2, variables);
+    array.setupSensors();
+    const float values[] = {1, 2, 3};
+    often.setValues(values, 3);
+
+    TEST_ASSERT_TRUE(array.completeUpdate());
+    TEST_ASSERT_EQUAL_UINT8(4, FakeSensor::finishedCount);
+    TEST_ASSERT_EQUAL_PTR(&often, FakeSensor::finished[0]);
+    TEST_ASSERT_EQUAL_PTR(&often, FakeSensor::finished[1]);
+    TEST_ASSERT_EQUAL_PTR(&once, FakeSensor::finished[2]);
+    TEST_ASSERT_EQUAL_PTR(&often, FakeSensor::finished[3]);
+    TEST_ASSERT_EQUAL_FLOAT(2, often.sensorValues[0]);
+}
+
+
+void test_order_kept_across_rollover(void) {
+    // The later deadlines are past the rollover of millis()
+    mockSetMillis(0xFFFFFFFF - 150);
+    FakeSensor   slow("Slow", 300);
+    FakeSensor   fast("Fast", 100);
+    FakeSensor   middle("Middle", 200);
+    FakeVariable slowVar(&slow);
+    FakeVariable fastVar(&fast);
+    FakeVariable middleVar(&middle);
+    Variable*    variables[] = {&middleVar, &slowVar, &fastVar};
+    VariableArray array(3, variables);
+    array.setupSensors();
+
+    TEST_ASSERT_TRUE(array.completeUpdate());
+    TEST_ASSERT_EQUAL_UINT8(3, FakeSensor::finishedCount);
+    TEST_ASSERT_EQUAL_PTR(&fast, FakeSensor::finished[0]);
+    TEST_ASSERT_EQUAL_PTR(&middle, FakeSensor::finished[1]);
+    TEST_ASSERT_EQUAL_PTR(&slow, FakeSensor::finished[2]);
+    TEST_ASSERT_TRUE(slow.lastResultAt < 1000);
+}
+
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_sensors_read_in_deadline_order);
+    RUN_TEST(test_many_sensors_read_in_deadline_order);
+    RUN_TEST(test_repeated_measurements_interleave);
+    RUN_TEST(test_order_kept_across_rollover);
+    return UNITY_END();
+}
@@ -0,0 +1,83 @@
+/**
+ * @file test_main.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Tests of the zigzag varints of the delta encoded binary records.
+ */
+
+#include <unity.h>
+#include "DeltaEncoding.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+
+// Reads the varint back, the way extras/binary_to_csv does
+static uint32_t getVarint(const uint8_t* in, uint8_t& length) {
+    uint32_t value = 0;
+    length         = 0;
+    do {
+        value |= static_cast<uint32_t>(in[length] & 0x7F) << (7 * length);
+    } while (in[length++] & 0x80);
+    return value;
+}
+
+
+void test_zigzag(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, DeltaEncoding::zigzag(0));
+    TEST_ASSERT_EQUAL_UINT32(1, DeltaEncoding::zigzag(-1));
+    TEST_ASSERT_EQUAL_UINT32(2, DeltaEncoding::zigzag(1));
+    TEST_ASSERT_EQUAL_UINT32(3, DeltaEncoding::zigzag(-2));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFE, DeltaEncoding::zigzag(INT32_MAX));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, DeltaEncoding::zigzag(INT32_MIN));
+}
+
+
+void test_varint_lengths(void) {
+    uint8_t buffer[5];
+    TEST_ASSERT_EQUAL_UINT8(1, DeltaEncoding::putVarint(buffer, 0));
+    TEST_ASSERT_EQUAL_UINT8(1, DeltaEncoding::putVarint(buffer, 127));
+    TEST_ASSERT_EQUAL_UINT8(2, DeltaEncoding::putVarint(buffer, 128));
+    TEST_ASSERT_EQUAL_HEX8(0x80, buffer[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(5, DeltaEncoding::putVarint(buffer, 0xFFFFFFFF));
+}
+
+
+void test_varint_round_trip(void) {
+    const int32_t values[] = {0, 1, -1, 63, -64, 64, 300, -300, 123456,
+                              INT32_MAX, INT32_MIN};
+    for (int32_t value : values) {
+        uint8_t buffer[5];
+        uint8_t written = DeltaEncoding::putVarint(
+            buffer, DeltaEncoding::zigzag(value));
+        uint8_t  read    = 0;
+        uint32_t encoded = getVarint(buffer, read);
+        TEST_ASSERT_EQUAL_UINT8(written, read);
+        int32_t decoded = static_cast<int32_t>(encoded >> 1) ^
+            -static_cast<int32_t>(encoded & 1);
+        TEST_ASSERT_EQUAL_INT32(value, decoded);
+    }
+}
+
+
+void test_whole_value(void) {
+    TEST_ASSERT_EQUAL_INT32(1235, DeltaEncoding::wholeValue(12.345f, 2));
+    TEST_ASSERT_EQUAL_INT32(-1235, DeltaEncoding::wholeValue(-12.345f, 2));
+    // A resolution of 0 is truncated, as the text would be
+    TEST_ASSERT_EQUAL_INT32(12, DeltaEncoding::wholeValue(12.9f, 0));
+    TEST_ASSERT_EQUAL_INT32(INT32_MAX, DeltaEncoding::wholeValue(1e12f, 1));
+    TEST_ASSERT_EQUAL_INT32(-INT32_MAX, DeltaEncoding::wholeValue(-1e12f, 1));
+}
+
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_zigzag);
+    RUN_TEST(test_varint_lengths);
+    RUN_TEST(test_varint_round_trip);
+    RUN_TEST(test_whole_value);
+    return UNITY_END();
+}
@@ -0,0 +1,67 @@
+/**
+ * @file test_main.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Tests of the power saving mode timer strings for `AT+CPSMS`.
+ */
+
+#include <unity.h>
+#include "LoggerModem.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+
+static const char* periodic(uint32_t seconds) {
+    static char bits[9];
+    loggerModem::encodePSMTimer(seconds, true, bits);
+    return bits;
+}
+static const char* active(uint32_t seconds) {
+    static char bits[9];
+    loggerModem::encodePSMTimer(seconds, false, bits);
+    return bits;
+}
+
+
+void test_periodic_timer_units(void) {
+    // 2 second units
+    TEST_ASSERT_EQUAL_STRING("01100101", periodic(10));
+    // 30 second units, rounded up from 31 steps of 2s
+    TEST_ASSERT_EQUAL_STRING("10000011", periodic(63));
+    // 1 minute units
+    TEST_ASSERT_EQUAL_STRING("10111110", periodic(30 * 60));
+    // 1 hour units
+    TEST_ASSERT_EQUAL_STRING("00100110", periodic(6 * 3600));
+    // 320 hour units
+    TEST_ASSERT_EQUAL_STRING("11000010", periodic(400 * 3600L));
+}
+
+
+void test_periodic_timer_too_long(void) {
+    // Past 31 units of 320 hours the longest time is used
+    TEST_ASSERT_EQUAL_STRING("11011111", periodic(40000000L));
+}
+
+
+void test_active_timer_units(void) {
+    // 2 second units
+    TEST_ASSERT_EQUAL_STRING("00001111", active(30));
+    // 1 minute units, rounded up
+    TEST_ASSERT_EQUAL_STRING("00100010", active(90));
+    // 6 minute units
+    TEST_ASSERT_EQUAL_STRING("01001010", active(3600));
+    // Past 31 units of 6 minutes the longest time is used
+    TEST_ASSERT_EQUAL_STRING("01011111", active(86400));
+}
+
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_periodic_timer_units);
+    RUN_TEST(test_periodic_timer_too_long);
+    RUN_TEST(test_active_timer_units);
+    return UNITY_END();
+}
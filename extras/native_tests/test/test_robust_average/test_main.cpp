@@ -0,0 +1,98 @@
+/**
+ * @file test_main.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Tests of combining a sensor's measurements with a median, trimmed
+ * mean, or Hampel filter (#MS_SENSOR_ROBUST_AVERAGE).
+ */
+
+#include <unity.h>
+#include "FakeSensor.h"
+
+FAKE_SENSOR_STORAGE
+
+void setUp(void) {}
+void tearDown(void) {}
+
+
+// Adds the values as the measurements of one update and averages them
+static float combine(sensorAverageMode mode, const float* values,
+                     uint8_t count) {
+    FakeSensor sensor("Fake", 0, count);
+    sensor.setRobustAveraging(mode);
+    sensor.clearValues();
+    for (uint8_t i = 0; i < count; i++) {
+        sensor.verifyAndAddMeasurementResult(0, values[i]);
+    }
+    sensor.averageMeasurements();
+    return sensor.sensorValues[0];
+}
+
+
+void test_mean_keeps_spike(void) {
+    const float values[] = {10, 11, 9, 10, 60};
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 20, combine(SENSOR_AVERAGE_MEAN, values, 5));
+}
+
+
+void test_median(void) {
+    const float odd[] = {10, 11, 9, 10, 60};
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 10, combine(SENSOR_AVERAGE_MEDIAN, odd, 5));
+    const float even[] = {4, 1, 3, 2};
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 2.5,
+                             combine(SENSOR_AVERAGE_MEDIAN, even, 4));
+}
+
+
+void test_trimmed_mean(void) {
+    // A quarter is dropped from each end: 1 and 100
+    const float values[] = {100, 4, 1, 5, 3, 6, 2, 7};
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 4.5,
+                             combine(SENSOR_AVERAGE_TRIMMED, values, 8));
+}
+
+
+void test_hampel_drops_outlier(void) {
+    const float values[] = {10, 10.2, 9.8, 10.1, 9.9, 50};
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 10,
+                             combine(SENSOR_AVERAGE_HAMPEL, values, 6));
+}
+
+
+void test_bad_values_skipped(void) {
+    const float values[] = {-9999, 3, -9999, 1, 2};
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 2,
+                             combine(SENSOR_AVERAGE_MEDIAN, values, 5));
+    const float none[] = {-9999, -9999};
+    TEST_ASSERT_EQUAL_FLOAT(-9999, combine(SENSOR_AVERAGE_MEDIAN, none, 2));
+}
+
+
+void test_full_windows_are_combined(void) {
+    // A full window of 7s, one of 1s, and part of a window of 4s
+    float values[2 * MS_ROBUST_WINDOW_SIZE + 3];
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < MS_ROBUST_WINDOW_SIZE; i++) values[n++] = 7;
+    for (uint8_t i = 0; i < MS_ROBUST_WINDOW_SIZE; i++) values[n++] = 1;
+    for (uint8_t i = 0; i < 3; i++) values[n++] = 4;
+    // Each estimate counts for the number of measurements it was made from
+    float expected = (7.0f * MS_ROBUST_WINDOW_SIZE +
+                      1.0f * MS_ROBUST_WINDOW_SIZE + 4.0f * 3) /
+        n;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, expected,
+                             combine(SENSOR_AVERAGE_MEDIAN, values, n));
+}
+
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_mean_keeps_spike);
+    RUN_TEST(test_median);
+    RUN_TEST(test_trimmed_mean);
+    RUN_TEST(test_hampel_drops_outlier);
+    RUN_TEST(test_bad_values_skipped);
+    RUN_TEST(test_full_windows_are_combined);
+    return UNITY_END();
+}
@@ -0,0 +1,99 @@
+/**
+ * @file test_main.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Tests of the statistics kept by VariableHistory.
+ */
+
+#include <unity.h>
+#include "VariableHistory.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+
+void test_empty_history(void) {
+    VariableHistory history;
+    TEST_ASSERT_EQUAL_UINT16(0, history.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(-9999, history.getLatest());
+    TEST_ASSERT_EQUAL_FLOAT(-9999, history.getMean());
+    TEST_ASSERT_EQUAL_FLOAT(-9999, history.getMin());
+    TEST_ASSERT_EQUAL_FLOAT(-9999, history.getMax());
+    TEST_ASSERT_EQUAL_FLOAT(-9999, history.getSlope());
+}
+
+
+void test_statistics(void) {
+    VariableHistory history;
+    history.add(2, 100);
+    history.add(6, 110);
+    history.add(4, 120);
+    TEST_ASSERT_EQUAL_UINT16(3, history.getCount());
+    TEST_ASSERT_EQUAL_UINT32(20, history.getSpan());
+    TEST_ASSERT_EQUAL_FLOAT(4, history.getLatest());
+    TEST_ASSERT_EQUAL_FLOAT(12, history.getSum());
+    TEST_ASSERT_EQUAL_FLOAT(4, history.getMean());
+    TEST_ASSERT_EQUAL_FLOAT(2, history.getMin());
+    TEST_ASSERT_EQUAL_FLOAT(6, history.getMax());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 0.1, history.getSlope());
+}
+
+
+void test_bad_and_repeated_values_ignored(void) {
+    VariableHistory history;
+    history.add(1, 100);
+    history.add(-9999, 110);
+    history.add(5, 100);
+    TEST_ASSERT_EQUAL_UINT16(1, history.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(1, history.getLatest());
+}
+
+
+void test_clock_set_back_restarts(void) {
+    VariableHistory history;
+    history.add(1, 100);
+    history.add(2, 110);
+    history.add(3, 50);
+    TEST_ASSERT_EQUAL_UINT16(1, history.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(3, history.getMin());
+}
+
+
+void test_full_ring_drops_oldest(void) {
+    VariableHistory history;
+    // The smallest value is the first to go
+    for (uint16_t i = 0; i < MS_VARIABLE_HISTORY_SIZE + 3; i++) {
+        history.add(i, 10 * i);
+    }
+    TEST_ASSERT_EQUAL_UINT16(MS_VARIABLE_HISTORY_SIZE, history.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(3, history.getMin());
+    TEST_ASSERT_EQUAL_FLOAT(MS_VARIABLE_HISTORY_SIZE + 2, history.getMax());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.1, history.getSlope());
+}
+
+
+void test_max_age_drops_old_values(void) {
+    VariableHistory history(60);
+    history.add(9, 0);
+    history.add(1, 30);
+    history.add(2, 60);
+    history.add(3, 90);
+    // The value at 0 is now 90s old; the maximum goes with it
+    TEST_ASSERT_EQUAL_UINT16(3, history.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(3, history.getMax());
+    TEST_ASSERT_EQUAL_FLOAT(2, history.getMean());
+}
+
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_history);
+    RUN_TEST(test_statistics);
+    RUN_TEST(test_bad_and_repeated_values_ignored);
+    RUN_TEST(test_clock_set_back_restarts);
+    RUN_TEST(test_full_ring_drops_oldest);
+    RUN_TEST(test_max_age_drops_old_values);
+    return UNITY_END();
+}
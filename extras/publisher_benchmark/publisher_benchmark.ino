@@ -0,0 +1,310 @@
+/**
+ * @file publisher_benchmark.ino
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Measures what each publisher costs to send a record, without a modem
+ * or a network.
+ *
+ * Every publisher is given a mock client that answers right away and counts
+ * what is written to it.  Each publisher sends a record of 5, 20, and 40
+ * calculated variables, and the bytes sent, the number of write() and
+ * flush() calls, the time to send, and the free memory are printed as a
+ * table.  Build it with the same flags as the loggers in the field to catch
+ * changes in publisher cost before flashing them.
+ */
+
+#include <Arduino.h>
+#include <Client.h>
+#include <LoggerBase.h>
+#include <publishers/CBORPublisher.h>
+#include <publishers/DreamHostPublisher.h>
+#include <publishers/EnviroDIYPublisher.h>
+#include <publishers/MQTTPublisher.h>
+#include <publishers/ThingSpeakPublisher.h>
+#include <publishers/UbidotsPublisher.h>
+
+#if defined(__AVR__)
+extern char* __brkval;
+extern char  __heap_start;
+#endif
+
+
+// ==========================================================================
+//  A client that counts what is written and answers every request at once
+// ==========================================================================
+class MockClient : public Client {
+ public:
+    uint32_t bytesWritten = 0;
+    uint16_t writeCalls   = 0;
+    uint16_t flushCalls   = 0;
+    uint32_t lastWrite    = 0;  // when the last byte was written
+    bool     mqtt         = false;
+
+    void reset(bool isMqtt) {
+        bytesWritten = 0;
+        writeCalls   = 0;
+        flushCalls   = 0;
+        lastWrite    = micros();
+        mqtt         = isMqtt;
+        _state       = 0;
+        _responseLen = 0;
+        _readPos     = 0;
+        if (!mqtt) { addResponse("HTTP/1.1 201 Created\r\n\r\n"); }
+    }
+
+    int connect(IPAddress, uint16_t) override {
+        _connected = true;
+        return 1;
+    }
+    int connect(const char*, uint16_t) override {
+        _connected = true;
+        return 1;
+    }
+    size_t write(uint8_t b) override {
+        return write(&b, 1);
+    }
+    size_t write(const uint8_t* buf, size_t size) override {
+        bytesWritten += size;
+        writeCalls++;
+        lastWrite = micros();
+        if (mqtt) {
+            for (size_t i = 0; i < size; i++) { trackMQTT(buf[i]); }
+        }
+        return size;
+    }
+    int available() override {
+        return _responseLen - _readPos;
+    }
+    int read() override {
+        return _readPos < _responseLen ? _response[_readPos++] : -1;
+    }
+    int read(uint8_t* buf, size_t size) override {
+        size_t n = 0;
+        while (n < size && _readPos < _responseLen) {
+            buf[n++] = _response[_readPos++];
+        }
+        return n;
+    }
+    int peek() override {
+        return _readPos < _responseLen ? _response[_readPos] : -1;
+    }
+    void flush() override {
+        flushCalls++;
+    }
+    void stop() override {
+        _connected = false;
+    }
+    uint8_t connected() override {
+        return _connected;
+    }
+    operator bool() override {
+        return _connected;
+    }
+
+ private:
+    void addResponse(const char* text) {
+        while (*text != '\0') { addResponseByte(*text++); }
+    }
+    void addResponseByte(uint8_t b) {
+        if (_responseLen < sizeof(_response)) { _response[_responseLen++] = b; }
+    }
+
+    // This follows the MQTT packets being written to acknowledge the CONNECT
+    // and each QoS 1 PUBLISH
+    void trackMQTT(uint8_t b) {
+        switch (_state) {
+            case 0:  // fixed header
+                _type      = b;
+                _remaining = 0;
+                _shift     = 0;
+                _state     = 1;
+                break;
+            case 1:  // remaining length
+                _remaining |= static_cast<uint32_t>(b & 0x7F) << _shift;
+                _shift += 7;
+                if (!(b & 0x80)) {
+                    _pos   = 0;
+                    _state = _remaining == 0 ? 0 : 2;
+                }
+                break;
+            case 2:  // the rest of the packet
+                if (_type == 0x10 && _pos == 0) {
+                    addResponseByte(0x20);
+                    addResponseByte(0x02);
+                    addResponseByte(0x00);
+                    addResponseByte(0x00);
+                } else if (_type == 0x32) {
+                    if (_pos == 0) {
+                        _topicLen = b << 8;
+                    } else if (_pos == 1) {
+                        _topicLen |= b;
+                    } else if (_pos == 2u + _topicLen) {
+                        _idHigh = b;
+                    } else if (_pos == 3u + _topicLen) {
+                        addResponseByte(0x40);
+                        addResponseByte(0x02);
+                        addResponseByte(_idHigh);
+                        addResponseByte(b);
+                    }
+                }
+                if (++_pos == _remaining) { _state = 0; }
+                break;
+        }
+    }
+
+    bool     _connected = false;
+    uint8_t  _response[64];
+    uint8_t  _responseLen = 0;
+    uint8_t  _readPos     = 0;
+    uint8_t  _state       = 0;
+    uint8_t  _type        = 0;
+    uint8_t  _shift       = 0;
+    uint8_t  _idHigh      = 0;
+    uint16_t _topicLen    = 0;
+    uint32_t _remaining   = 0;
+    uint32_t _pos         = 0;
+};
+
+
+// ==========================================================================
+//  Synthetic variables
+// ==========================================================================
+const uint8_t maxVariables = 40;
+
+float fakeReading() {
+    return random(-100000L, 100000L) / 100.0;
+}
+
+Variable* variableList[maxVariables];
+char      uuids[maxVariables][37];
+
+VariableArray* arrays[3];
+const uint8_t  arraySizes[3] = {5, 20, 40};
+
+// Publishers are split between two loggers; each can hold four
+Logger     loggerA("bench", 5, nullptr);
+Logger     loggerB("bench", 5, nullptr);
+MockClient mockClient;
+
+EnviroDIYPublisher envirodiy(loggerA, &mockClient, "token",
+                             "12345678-abcd-1234-ef00-1234567890ab");
+UbidotsPublisher   ubidots(loggerA, &mockClient, "token",
+                           "12345678-abcd-1234-ef00-1234567890ab");
+DreamHostPublisher dreamhost(loggerA, &mockClient,
+                             "http://example.com/receiver.php");
+ThingSpeakPublisher thingspeak(loggerA, &mockClient, "mqttKey", "123456",
+                               "channelKey");
+CBORPublisher       cbor(loggerB, &mockClient, "example.com", "/ingest");
+MQTTPublisher       mqtt(loggerB, &mockClient, "example.com", "{id}/data");
+
+struct Benchmark {
+    const char*    name;
+    dataPublisher* publisher;
+    bool           isMqtt;
+};
+Benchmark benchmarks[] = {
+    {"EnviroDIY", &envirodiy, false},
+    {"Ubidots", &ubidots, false},
+    {"DreamHost", &dreamhost, false},
+    {"ThingSpeak", &thingspeak, true},
+    {"CBOR", &cbor, false},
+    {"MQTT", &mqtt, true},
+};
+
+
+// ==========================================================================
+//  Memory use
+// ==========================================================================
+#if defined(__AVR__)
+const uint8_t stackPaint = 0xA5;
+
+// Fills the free memory between the heap and the stack with a pattern
+void paintFreeMemory() {
+    char  top;
+    char* p = __brkval != nullptr ? __brkval : &__heap_start;
+    while (p < &top - 32) { *p++ = stackPaint; }
+}
+
+// Counts how much of the pattern is left; the lowest the stack has reached
+int freeMemoryLeft() {
+    char  top;
+    char* p = __brkval != nullptr ? __brkval : &__heap_start;
+    int   n = 0;
+    while (p < &top && *p++ == stackPaint) { n++; }
+    return n;
+}
+#endif
+
+
+void printRow(const char* name, uint8_t nVars, int16_t result,
+              uint32_t elapsed, int freeLeft) {
+    Serial.print(name);
+    Serial.print('\t');
+    Serial.print(nVars);
+    Serial.print('\t');
+    Serial.print(mockClient.bytesWritten);
+    Serial.print('\t');
+    Serial.print(mockClient.writeCalls);
+    Serial.print('\t');
+    Serial.print(mockClient.flushCalls);
+    Serial.print('\t');
+    Serial.print(elapsed);
+    Serial.print('\t');
+    if (freeLeft >= 0) {
+        Serial.print(freeLeft);
+    } else {
+        Serial.print(F("n/a"));
+    }
+    Serial.print('\t');
+    Serial.println(result);
+}
+
+
+void setup() {
+    Serial.begin(115200);
+    while (!Serial && millis() < 5000) {}
+
+    for (uint8_t i = 0; i < maxVariables; i++) {
+        snprintf(uuids[i], sizeof(uuids[i]),
+                 "12345678-abcd-1234-ef00-%012u", i);
+        variableList[i] = new Variable(fakeReading, 2, "fake", "unit", "fake",
+                                       uuids[i]);
+    }
+    for (uint8_t a = 0; a < 3; a++) {
+        arrays[a] = new VariableArray(arraySizes[a], variableList);
+    }
+
+    // A fixed time stands in for the clock
+    Logger::markedUTCEpochTime   = 1704110400L;  // 2024-01-01 12:00 UTC
+    Logger::markedLocalEpochTime = Logger::markedUTCEpochTime;
+
+    Serial.println(F("\npublisher\tvars\tbytes\twrites\tflushes\tmicros\t"
+                     "min free RAM\tresult"));
+    for (uint8_t a = 0; a < 3; a++) {
+        loggerA.setVariableArray(arrays[a]);
+        loggerB.setVariableArray(arrays[a]);
+        arrays[a]->completeUpdate();
+        for (uint8_t b = 0; b < sizeof(benchmarks) / sizeof(benchmarks[0]);
+             b++) {
+            mockClient.reset(benchmarks[b].isMqtt);
+#if defined(__AVR__)
+            paintFreeMemory();
+#endif
+            uint32_t start  = micros();
+            int16_t  result = benchmarks[b].publisher->publishData();
+            uint32_t elapsed = mockClient.lastWrite - start;
+#if defined(__AVR__)
+            int freeLeft = freeMemoryLeft();
+#else
+            int freeLeft = -1;
+#endif
+            printRow(benchmarks[b].name, arraySizes[a], result, elapsed,
+                     freeLeft);
+        }
+    }
+    Serial.println(F("\nDone"));
+}
+
+void loop() {}
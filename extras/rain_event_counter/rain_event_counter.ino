@@ -0,0 +1,112 @@
+/**
+ * @file rain_event_counter.ino
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief An I2C tipping bucket counter that also keeps the time of each tip.
+ *
+ * This answers the logger like the Trinket tip counter, with a 4 byte count of
+ * the tips since the last reading, so it can be read by a RainCounterI2C.
+ * When the logger is built with MS_RAIN_EVENT_TIMES it then writes 'T' and
+ * reads back the age of each of those tips, so it can work out the peak
+ * rainfall intensities.
+ *
+ * The tipping bucket switch goes between tipPin and ground.  Tips are
+ * debounced in the interrupt.
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+
+const uint8_t  i2cAddress  = 0x08;
+const uint8_t  tipPin      = 2;
+const uint32_t debounce_ms = 50;
+
+// Keep this at least as big as MS_RAIN_MAX_EVENTS on the logger
+const uint8_t maxTimes      = 64;
+const uint8_t timesPerFrame = 15;
+
+volatile uint32_t tipCount    = 0;
+volatile uint32_t lastTipTime = 0;
+// A ring buffer of tip times, oldest at timesHead
+volatile uint32_t tipTimes[maxTimes];
+volatile uint8_t  timesHead  = 0;
+volatile uint8_t  timesCount = 0;
+
+// The tips reported with the last count, and when they were reported
+uint8_t  timesToSend  = 0;
+uint32_t countReadAt  = 0;
+bool     sendingTimes = false;
+
+
+void tipInterrupt() {
+    uint32_t now = millis();
+    if (now - lastTipTime < debounce_ms) return;
+    lastTipTime = now;
+    tipCount++;
+    tipTimes[(timesHead + timesCount) % maxTimes] = now;
+    if (timesCount < maxTimes) {
+        timesCount++;
+    } else {
+        // Full; drop the oldest time
+        timesHead = (timesHead + 1) % maxTimes;
+    }
+}
+
+
+void receiveEvent(int) {
+    while (Wire.available()) {
+        if (Wire.read() == 'T') sendingTimes = true;
+    }
+}
+
+
+void requestEvent() {
+    uint8_t frame[1 + 2 * timesPerFrame];
+    uint8_t frameLength;
+
+    if (!sendingTimes) {
+        // Send the count as 4 big-endian bytes and start over
+        uint32_t count = tipCount;
+        tipCount       = 0;
+        frame[0]       = count >> 24;
+        frame[1]       = count >> 16;
+        frame[2]       = count >> 8;
+        frame[3]       = count;
+        frameLength    = 4;
+        // The times of those tips are what's in the buffer now
+        timesToSend = timesCount;
+        countReadAt = millis();
+    } else {
+        uint8_t inFrame = timesToSend < timesPerFrame ? timesToSend
+                                                      : timesPerFrame;
+        frame[0]        = inFrame;
+        for (uint8_t i = 0; i < inFrame; i++) {
+            uint32_t age_s = (countReadAt - tipTimes[timesHead]) / 1000;
+            if (age_s > 65535) age_s = 65535;
+            frame[1 + 2 * i] = age_s >> 8;
+            frame[2 + 2 * i] = age_s;
+            timesHead        = (timesHead + 1) % maxTimes;
+            timesCount--;
+        }
+        timesToSend -= inFrame;
+        frameLength = 1 + 2 * inFrame;
+        // A short frame is the last
+        if (inFrame < timesPerFrame) sendingTimes = false;
+    }
+    Wire.write(frame, frameLength);
+}
+
+
+void setup() {
+    pinMode(tipPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(tipPin), tipInterrupt, FALLING);
+    Wire.begin(i2cAddress);
+    Wire.onReceive(receiveEvent);
+    Wire.onRequest(requestEvent);
+}
+
+void loop() {
+    // Everything happens in the interrupts
+}
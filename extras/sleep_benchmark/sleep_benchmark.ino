@@ -0,0 +1,297 @@
+/**
+ * @file sleep_benchmark.ino
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Measures how long a board takes to wake up and get its buses back
+ * in each sleep mode, and marks each sleep for a meter measuring the sleep
+ * current.
+ *
+ * The sketch steps through each sleep mode of the processor and then
+ * Logger::systemSleep() itself, sleeping until the next minute alarm of the
+ * RTC in each.  Every mode is run twice: a full wake, where I2C, the SD card
+ * and the modem serial port are shut down before sleeping and started again
+ * after, and a fast wake, where they're left running and only checked.  The
+ * time from the wake interrupt to the end of each step is printed as a table,
+ * in microseconds; -1 is a step that failed.  After Logger::systemSleep() the
+ * time is counted from its return, since it attaches its own interrupt and
+ * restarts I2C itself.
+ *
+ * Software can't see the current while the processor is asleep, so line the
+ * rows up with the trace of a meter on the battery: every sleep starts right
+ * after its "sleeping" line is printed and ends at the next minute.  Define
+ * BENCH_USE_INA219 to also print the current an INA219 on the supply reads
+ * once the board is awake again, to compare the sleep current against.
+ *
+ * Only AVR and SAMD boards are supported, like the rest of the library; an
+ * ESP32 can only be used as a modem.
+ */
+
+#include <Arduino.h>
+#include <ModularSensors.h>
+#include <SdFat.h>
+#include <Wire.h>
+#ifdef BENCH_USE_INA219
+#include <sensors/TIINA219.h>
+#endif
+#if defined(ARDUINO_ARCH_AVR)
+#include <avr/sleep.h>
+#endif
+
+
+// ==========================================================================
+//  Board settings - these are for a Mayfly
+// ==========================================================================
+const int32_t serialBaud    = 115200;  // Baud rate for the results
+const int8_t  wakePin       = 31;      // RTC alarm pin; 1 for a SAMD RTC
+const int8_t  sdCardSSPin   = 12;      // SD card chip select
+const int32_t modemBaud     = 9600;    // Baud rate of the modem serial port
+const uint8_t cyclesPerMode = 2;       // Sleeps in each mode and wake
+#define modemSerial Serial1
+
+
+// ==========================================================================
+//  Sleep modes
+// ==========================================================================
+// Logger::systemSleep() instead of a bare processor sleep
+const uint8_t loggerSleep = 0xFF;
+
+struct SleepMode {
+    const char* name;
+    uint8_t     mode;
+};
+
+#if defined(ARDUINO_ARCH_AVR)
+const SleepMode sleepModes[] = {
+    {"idle", SLEEP_MODE_IDLE},
+    {"power-save", SLEEP_MODE_PWR_SAVE},
+    {"standby", SLEEP_MODE_STANDBY},
+    {"power-down", SLEEP_MODE_PWR_DOWN},
+    {"systemSleep", loggerSleep},
+};
+#elif defined(__SAMD51__)
+// The values of PM->SLEEPCFG; the deeper modes reset the board on wake
+const SleepMode sleepModes[] = {
+    {"idle", 0x2},
+    {"standby", 0x4},
+    {"systemSleep", loggerSleep},
+};
+#elif defined(ARDUINO_ARCH_SAMD)
+// The values of PM->SLEEP for idle; standby is the deep sleep
+const uint8_t   samdStandby  = 0x10;
+const SleepMode sleepModes[] = {
+    {"idle 0", 0x0},
+    {"idle 2", 0x2},
+    {"standby", samdStandby},
+    {"systemSleep", loggerSleep},
+};
+#else
+#error The sleep benchmark only runs on AVR and SAMD boards
+#endif
+
+
+// ==========================================================================
+//  The logger, for its RTC and Logger::systemSleep()
+// ==========================================================================
+float benchCycle() {
+    static uint16_t n = 0;
+    return n++;
+}
+Variable cycleVar(benchCycle, 0, "cycle", "count", "benchCycle");
+
+#ifdef BENCH_USE_INA219
+TIINA219         ina219(-1);
+TIINA219_Current inaCurrent(&ina219);
+Variable*        variableList[] = {&cycleVar, &inaCurrent};
+#else
+Variable* variableList[] = {&cycleVar};
+#endif
+VariableArray varArray(sizeof(variableList) / sizeof(variableList[0]),
+                       variableList);
+Logger        dataLogger("bench", 1, &varArray);
+SdFat         sd;
+
+
+// ==========================================================================
+//  Waking
+// ==========================================================================
+volatile bool     woke   = false;
+volatile uint32_t wokeAt = 0;
+
+void benchISR() {
+    if (!woke) { wokeAt = micros(); }
+    woke = true;
+}
+
+// Sets the RTC to interrupt at the start of the next minute
+void armAlarm() {
+    woke = false;
+#if defined(MS_SAMD_DS3231) || not defined(ARDUINO_ARCH_SAMD)
+    rtc.enableInterrupts(EveryMinute);
+    rtc.clearINTStatus();
+    pinMode(wakePin, INPUT_PULLUP);
+    enableInterrupt(wakePin, benchISR, CHANGE);
+#else
+    Logger::zero_sleep_rtc.attachInterrupt(benchISR);
+    Logger::zero_sleep_rtc.setAlarmSeconds(0);
+    Logger::zero_sleep_rtc.enableAlarm(Logger::zero_sleep_rtc.MATCH_SS);
+#endif
+}
+
+void disarmAlarm() {
+#if defined(MS_SAMD_DS3231) || not defined(ARDUINO_ARCH_SAMD)
+    rtc.disableInterrupts();
+    disableInterrupt(wakePin);
+#else
+    Logger::zero_sleep_rtc.disableAlarm();
+    Logger::zero_sleep_rtc.detachInterrupt();
+#endif
+}
+
+// Sleeps in one mode until the alarm; the other interrupts, like the system
+// tick in idle, put it straight back to sleep
+void sleepIn(uint8_t mode) {
+    armAlarm();
+#if defined(ARDUINO_ARCH_AVR)
+    set_sleep_mode(mode);
+    while (!woke) {
+        sleep_enable();
+        sleep_cpu();
+        sleep_disable();
+    }
+#elif defined(__SAMD51__)
+    PM->SLEEPCFG.bit.SLEEPMODE = mode;
+    while (PM->SLEEPCFG.bit.SLEEPMODE != mode) {}
+    while (!woke) {
+        __DSB();
+        __WFI();
+    }
+#else
+    if (mode == samdStandby) {
+        // The system tick can fault the SAMD21 before the flash is awake
+        SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+        SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    } else {
+        SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+        PM->SLEEP.reg = mode;
+    }
+    while (!woke) {
+        __DSB();
+        __WFI();
+    }
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+#endif
+    disarmAlarm();
+}
+
+
+// ==========================================================================
+//  Shutting down and starting the buses
+// ==========================================================================
+void shutDown() {
+    Wire.end();
+    sd.end();
+    modemSerial.end();
+}
+
+// The time since the wake to the end of a step, or -1 if it failed
+int32_t stepTime(bool ok, uint32_t since) {
+    return ok ? static_cast<int32_t>(micros() - since) : -1;
+}
+
+// Checks the RTC answers on I2C, restarting the bus first for a full wake
+bool startI2C(bool full) {
+    if (full) {
+        Wire.begin();
+        Wire.setTimeout(0);
+    }
+    Wire.beginTransmission(0x68);
+    return Wire.endTransmission() == 0;
+}
+
+// Mounts the SD card for a full wake; checks the card answers for a fast one
+bool startSD(bool full) {
+    if (full) { return sd.begin(sdCardSSPin, SPI_FULL_SPEED); }
+    return sd.card()->sectorCount() > 0;
+}
+
+// Waits for the modem to answer AT
+bool startModem(bool full) {
+    if (full) { modemSerial.begin(modemBaud); }
+    while (modemSerial.available()) { modemSerial.read(); }
+    modemSerial.print(F("AT\r"));
+    modemSerial.setTimeout(1000);
+    return modemSerial.find(const_cast<char*>("OK"));
+}
+
+
+void printRow(const char* name, bool full, int32_t i2c, int32_t sdCard,
+              int32_t modem) {
+    Serial.print(name);
+    Serial.print('\t');
+    Serial.print(full ? F("full") : F("fast"));
+    Serial.print('\t');
+    Serial.print(i2c);
+    Serial.print('\t');
+    Serial.print(sdCard);
+    Serial.print('\t');
+    Serial.print(modem);
+#ifdef BENCH_USE_INA219
+    ina219.update();
+    Serial.print('\t');
+    Serial.print(inaCurrent.getValue());
+#endif
+    Serial.println();
+}
+
+
+void setup() {
+    Serial.begin(serialBaud);
+    while (!Serial && millis() < 5000) {}
+
+    dataLogger.setLoggerPins(wakePin, sdCardSSPin, -1, -1, -1);
+    dataLogger.begin();
+    Wire.begin();
+    Wire.setTimeout(0);
+    sd.begin(sdCardSSPin, SPI_FULL_SPEED);
+    modemSerial.begin(modemBaud);
+
+#ifdef BENCH_USE_INA219
+    Serial.println(F("\nmode\twake\tI2C us\tSD us\tmodem us\tawake mA"));
+#else
+    Serial.println(F("\nmode\twake\tI2C us\tSD us\tmodem us"));
+#endif
+}
+
+void loop() {
+    for (uint8_t m = 0; m < sizeof(sleepModes) / sizeof(sleepModes[0]); m++) {
+        for (uint8_t w = 0; w < 2; w++) {
+            bool full = w == 0;
+            for (uint8_t c = 0; c < cyclesPerMode; c++) {
+                dataLogger.watchDogTimer.resetWatchDog();
+                Serial.print(F("sleeping: "));
+                Serial.print(sleepModes[m].name);
+                Serial.println(full ? F(" full") : F(" fast"));
+                Serial.flush();
+                if (full) { shutDown(); }
+
+                uint32_t since;
+                if (sleepModes[m].mode == loggerSleep) {
+                    dataLogger.systemSleep();
+                    since = micros();
+                } else {
+                    sleepIn(sleepModes[m].mode);
+                    since = wokeAt;
+                }
+                int32_t i2c    = stepTime(startI2C(full), since);
+                int32_t sdCard = stepTime(startSD(full), since);
+                int32_t modem  = stepTime(startModem(full), since);
+                printRow(sleepModes[m].name, full, i2c, sdCard, modem);
+            }
+        }
+    }
+    Serial.println(F("\nDone"));
+    while (true) { dataLogger.watchDogTimer.resetWatchDog(); }
+}
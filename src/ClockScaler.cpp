@@ -0,0 +1,58 @@
+/**
+ * @file ClockScaler.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the ClockScaler class.
+ */
+
+#include "ClockScaler.h"
+
+#if defined(MS_SAMD_CLOCK_SCALING) && \
+    (defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO))
+
+bool ClockScaler::_slow = false;
+
+
+void ClockScaler::slow(void) {
+    if (_slow) { return; }
+    setDivider(MS_SLOW_CLOCK_DIVIDER);
+    _slow = true;
+}
+
+
+void ClockScaler::fast(void) {
+    if (!_slow) { return; }
+    setDivider(1);
+    _slow = false;
+}
+
+
+void ClockScaler::setDivider(uint8_t divider) {
+    // Printed at full speed, or the USB may not keep up
+    if (divider > 1) { MS_DBG(F("Processor clock divided by"), divider); }
+    // SystemCoreClock is left at full speed, since the Arduino core and the
+    // libraries take it as the speed of the generic clock
+    noInterrupts();
+#if defined(__SAMD51__)
+    // The peripheral buses run from the processor clock
+    MCLK->CPUDIV.reg = MCLK_CPUDIV_DIV(divider);
+#else
+    // The prescalers take the power of two; the peripheral buses can't be
+    // faster than the processor
+    uint8_t shift = 0;
+    while ((1 << shift) < divider) { shift++; }
+    PM->CPUSEL.reg  = shift;
+    PM->APBASEL.reg = shift;
+    PM->APBBSEL.reg = shift;
+    PM->APBCSEL.reg = shift;
+#endif
+    // Keep the tick at 1 ms
+    SysTick->LOAD = SystemCoreClock / 1000 / divider - 1;
+    SysTick->VAL  = 0;
+    interrupts();
+    if (divider == 1) { MS_DBG(F("Processor clock back to full speed")); }
+}
+
+#endif  // MS_SAMD_CLOCK_SCALING
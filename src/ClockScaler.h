@@ -0,0 +1,116 @@
+/**
+ * @file ClockScaler.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the ClockScaler class, which slows the processor clock of
+ * SAMD boards while the logger is only waiting, and the MS_CLOCK_ macros used
+ * to mark those waits.
+ */
+
+// Header Guards
+#ifndef SRC_CLOCKSCALER_H_
+#define SRC_CLOCKSCALER_H_
+
+// Debugging Statement
+// #define MS_CLOCKSCALER_DEBUG
+
+#ifdef MS_CLOCKSCALER_DEBUG
+#define MS_DEBUGGING_STD "ClockScaler"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+
+/**
+ * @def MS_SAMD_CLOCK_SCALING
+ * @brief Define this build flag to divide down the processor clock of a SAMD
+ * board while the logger is only waiting for time to pass - the sensor warm
+ * up and stabilization times and the gaps between sensor deadlines - and run
+ * it at full speed for everything else.
+ *
+ * Only the processor clock is divided; the 48 MHz generic clock that drives
+ * the serial ports, I2C, SPI and the timers is left alone, so their baud
+ * rates don't change.  The peripheral buses can't be faster than the
+ * processor, so their register access slows with it, which is why nothing
+ * talks to a sensor, the modem, or the USB while the clock is slow.  The
+ * system tick is reloaded for the slower clock so millis() still counts
+ * milliseconds, but micros() is only good to the millisecond and
+ * delayMicroseconds() runs long while the clock is slow.  On other boards
+ * this does nothing.
+ */
+// #define MS_SAMD_CLOCK_SCALING
+
+#if defined(MS_SAMD_CLOCK_SCALING) && \
+    (defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO))
+#ifndef MS_SLOW_CLOCK_DIVIDER
+/**
+ * @brief How much the processor clock is divided while waiting; a power of
+ * two from 2 to 128 (#MS_SAMD_CLOCK_SCALING).
+ *
+ * The default takes a 48 MHz SAMD21 to 6 MHz.
+ */
+#define MS_SLOW_CLOCK_DIVIDER 8
+#endif
+
+/**
+ * @brief Slow the processor clock for a wait.
+ */
+#define MS_CLOCK_SLOW() ClockScaler::slow()
+/**
+ * @brief Put the processor clock back to full speed.
+ */
+#define MS_CLOCK_FAST() ClockScaler::fast()
+
+/**
+ * @brief The ClockScaler class switches the processor clock of a SAMD board
+ * between full speed and #MS_SLOW_CLOCK_DIVIDER (#MS_SAMD_CLOCK_SCALING).
+ *
+ * @ingroup base_classes
+ */
+class ClockScaler {
+ public:
+    /**
+     * @brief Divide the processor clock by #MS_SLOW_CLOCK_DIVIDER and reload
+     * the system tick to match; nothing is done if it's already slow.
+     */
+    static void slow(void);
+    /**
+     * @brief Put the processor clock and the system tick back to full speed;
+     * nothing is done if it's already fast.
+     */
+    static void fast(void);
+    /**
+     * @brief Check if the processor clock is slowed.
+     *
+     * @return **bool** True if it's divided down.
+     */
+    static bool isSlow(void) {
+        return _slow;
+    }
+
+ private:
+    /**
+     * @brief Set the clock division and the system tick.
+     *
+     * @param divider The clock division, a power of two
+     */
+    static void setDivider(uint8_t divider);
+
+    static bool _slow;
+};
+#else
+/**
+ * @brief Slow the processor clock for a wait - does nothing.
+ */
+#define MS_CLOCK_SLOW()
+/**
+ * @brief Put the processor clock back to full speed - does nothing.
+ */
+#define MS_CLOCK_FAST()
+#endif
+
+#endif  // SRC_CLOCKSCALER_H_
@@ -0,0 +1,39 @@
+/**
+ * @file DeltaEncoding.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the DeltaEncoding class.
+ */
+
+#include "DeltaEncoding.h"
+
+#ifdef MS_LOGGER_DELTA_ENCODING
+
+uint32_t DeltaEncoding::zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^
+        static_cast<uint32_t>(value >> 31);
+}
+
+
+uint8_t DeltaEncoding::putVarint(uint8_t* out, uint32_t value) {
+    uint8_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[length++] = static_cast<uint8_t>(value);
+    return length;
+}
+
+
+int32_t DeltaEncoding::wholeValue(float value, uint8_t resolution) {
+    for (uint8_t r = 0; r < resolution; r++) { value *= 10; }
+    if (value >= 2147483647.0f) return INT32_MAX;
+    if (value <= -2147483647.0f) return -INT32_MAX;
+    if (resolution > 0) { value += value < 0 ? -0.5f : 0.5f; }
+    return static_cast<int32_t>(value);
+}
+
+#endif
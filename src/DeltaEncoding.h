@@ -0,0 +1,62 @@
+/**
+ * @file DeltaEncoding.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the DeltaEncoding class, which turns the values of a delta
+ * encoded binary record into zigzag varints (#MS_LOGGER_DELTA_ENCODING).
+ */
+
+// Header Guards
+#ifndef SRC_DELTAENCODING_H_
+#define SRC_DELTAENCODING_H_
+
+// Included Dependencies
+#include <Arduino.h>
+
+#ifdef MS_LOGGER_DELTA_ENCODING
+/**
+ * @brief The DeltaEncoding class holds the pieces of the delta encoded binary
+ * records written by Logger::encodeDeltaRecord() (#MS_LOGGER_DELTA_ENCODING).
+ *
+ * They don't touch the logger or any hardware, so they're kept apart where
+ * they can be checked on their own.
+ *
+ * @ingroup base_classes
+ */
+class DeltaEncoding {
+ public:
+    /**
+     * @brief Zigzag encode a number, so small negative numbers are small
+     * too: 0, -1, 1, -2, 2 ... become 0, 1, 2, 3, 4 ...
+     *
+     * @param value The number to encode
+     * @return **uint32_t** The encoded number.
+     */
+    static uint32_t zigzag(int32_t value);
+    /**
+     * @brief Write a number as a varint, seven bits at a time, least
+     * significant first, with the top bit set on every byte but the last.
+     *
+     * @param out The buffer to write to; must have room for 5 bytes.
+     * @param value The number to write
+     * @return **uint8_t** The number of bytes written.
+     */
+    static uint8_t putVarint(uint8_t* out, uint32_t value);
+    /**
+     * @brief Turn a value into a whole number of units of its resolution,
+     * the same way Variable::getValueChars() would write it.
+     *
+     * A resolution of 0 is truncated rather than rounded, as by itoa(), and
+     * values too big for 32 bits are clamped.
+     *
+     * @param value The value
+     * @param resolution The number of decimal places
+     * @return **int32_t** The value in units of its resolution.
+     */
+    static int32_t wholeValue(float value, uint8_t resolution);
+};
+#endif
+
+#endif  // SRC_DELTAENCODING_H_
@@ -0,0 +1,161 @@
+/**
+ * @file DiscoveryCache.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the DiscoveryCache class.
+ */
+
+#include "DiscoveryCache.h"
+
+#ifdef MS_DISCOVERY_CACHE
+
+#if defined(E2END)
+#include <EEPROM.h>
+#endif
+
+// The first byte of every entry in use
+#define DISCOVERY_ENTRY_MARKER 0xA5
+// The positions in each entry
+#define DISCOVERY_POS_MARKER 0
+#define DISCOVERY_POS_KIND 1
+#define DISCOVERY_POS_PIN 2
+#define DISCOVERY_POS_ADDRESS 3
+#define DISCOVERY_POS_LENGTH 4
+#define DISCOVERY_POS_DATA 5
+#define DISCOVERY_POS_CHECK (MS_DISCOVERY_CACHE_ENTRY_SIZE - 1)
+#define DISCOVERY_MAX_DATA (DISCOVERY_POS_CHECK - DISCOVERY_POS_DATA)
+
+#if defined(E2END)
+// The EEPROM address of a byte of an entry
+static int entryAddress(uint8_t slot, uint8_t position) {
+    return MS_DISCOVERY_CACHE_ADDRESS +
+        static_cast<int>(slot) * MS_DISCOVERY_CACHE_ENTRY_SIZE + position;
+}
+#endif
+
+
+uint8_t DiscoveryCache::checkOf(uint8_t slot) {
+    uint8_t check = 0;
+#if defined(E2END)
+    for (uint8_t i = 0; i < DISCOVERY_POS_CHECK; i++) {
+        // Rotate as we go so swapped bytes don't give the same check
+        check = (check << 1 | check >> 7) ^ EEPROM.read(entryAddress(slot, i));
+    }
+#else
+    (void)slot;
+#endif
+    return check;
+}
+
+
+bool DiscoveryCache::isValid(uint8_t slot) {
+#if defined(E2END)
+    if (EEPROM.read(entryAddress(slot, DISCOVERY_POS_MARKER)) !=
+        DISCOVERY_ENTRY_MARKER) {
+        return false;
+    }
+    if (EEPROM.read(entryAddress(slot, DISCOVERY_POS_LENGTH)) >
+        DISCOVERY_MAX_DATA) {
+        return false;
+    }
+    return EEPROM.read(entryAddress(slot, DISCOVERY_POS_CHECK)) ==
+        checkOf(slot);
+#else
+    (void)slot;
+    return false;
+#endif
+}
+
+
+int8_t DiscoveryCache::find(discoveryKind kind, int8_t pin, char address) {
+#if defined(E2END)
+    for (uint8_t slot = 0; slot < MS_DISCOVERY_CACHE_ENTRIES; slot++) {
+        if (EEPROM.read(entryAddress(slot, DISCOVERY_POS_KIND)) == kind &&
+            static_cast<int8_t>(EEPROM.read(
+                entryAddress(slot, DISCOVERY_POS_PIN))) == pin &&
+            static_cast<char>(EEPROM.read(
+                entryAddress(slot, DISCOVERY_POS_ADDRESS))) == address &&
+            isValid(slot)) {
+            return slot;
+        }
+    }
+#else
+    (void)kind;
+    (void)pin;
+    (void)address;
+#endif
+    return -1;
+}
+
+
+uint8_t DiscoveryCache::load(discoveryKind kind, int8_t pin, char address,
+                             uint8_t* data, uint8_t maxLength) {
+    int8_t slot = find(kind, pin, address);
+    if (slot < 0) {
+        MS_DBG(F("Nothing cached for pin"), pin, F("address"), address);
+        return 0;
+    }
+#if defined(E2END)
+    uint8_t length = EEPROM.read(entryAddress(slot, DISCOVERY_POS_LENGTH));
+    if (length > maxLength) { length = maxLength; }
+    for (uint8_t i = 0; i < length; i++) {
+        data[i] = EEPROM.read(entryAddress(slot, DISCOVERY_POS_DATA + i));
+    }
+    MS_DBG(F("Found"), length, F("cached bytes for pin"), pin, F("address"),
+           address);
+    return length;
+#else
+    (void)data;
+    (void)maxLength;
+    return 0;
+#endif
+}
+
+
+void DiscoveryCache::save(discoveryKind kind, int8_t pin, char address,
+                          const uint8_t* data, uint8_t length) {
+#if defined(E2END)
+    if (length > DISCOVERY_MAX_DATA) { length = DISCOVERY_MAX_DATA; }
+    int8_t slot = find(kind, pin, address);
+    // Otherwise take the first free entry, or the first one if it's full
+    for (uint8_t i = 0; slot < 0 && i < MS_DISCOVERY_CACHE_ENTRIES; i++) {
+        if (!isValid(i)) { slot = i; }
+    }
+    if (slot < 0) { slot = 0; }
+    MS_DBG(F("Caching"), length, F("bytes for pin"), pin, F("address"),
+           address);
+
+    // update() only writes the bytes that changed
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_MARKER),
+                  DISCOVERY_ENTRY_MARKER);
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_KIND), kind);
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_PIN), pin);
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_ADDRESS), address);
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_LENGTH), length);
+    for (uint8_t i = 0; i < DISCOVERY_MAX_DATA; i++) {
+        EEPROM.update(entryAddress(slot, DISCOVERY_POS_DATA + i),
+                      i < length ? data[i] : 0);
+    }
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_CHECK), checkOf(slot));
+#else
+    (void)kind;
+    (void)pin;
+    (void)address;
+    (void)data;
+    (void)length;
+#endif
+}
+
+
+void DiscoveryCache::forget(discoveryKind kind, int8_t pin, char address) {
+    int8_t slot = find(kind, pin, address);
+    if (slot < 0) { return; }
+    MS_DBG(F("Forgetting the cache for pin"), pin, F("address"), address);
+#if defined(E2END)
+    EEPROM.update(entryAddress(slot, DISCOVERY_POS_MARKER), 0xFF);
+#endif
+}
+
+#endif  // MS_DISCOVERY_CACHE
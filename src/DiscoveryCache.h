@@ -0,0 +1,139 @@
+/**
+ * @file DiscoveryCache.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the DiscoveryCache class, which keeps what the sensors found
+ * on their buses at setup in EEPROM so it doesn't have to be found again after
+ * every reset.
+ */
+
+// Header Guards
+#ifndef SRC_DISCOVERYCACHE_H_
+#define SRC_DISCOVERYCACHE_H_
+
+// Debugging Statement
+// #define MS_DISCOVERYCACHE_DEBUG
+
+#ifdef MS_DISCOVERYCACHE_DEBUG
+#define MS_DEBUGGING_STD "DiscoveryCache"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+
+#ifdef MS_DISCOVERY_CACHE
+#ifndef MS_DISCOVERY_CACHE_ADDRESS
+/**
+ * @brief The EEPROM address the discovery cache starts at.
+ *
+ * Move it if your program keeps anything else in EEPROM.
+ */
+#define MS_DISCOVERY_CACHE_ADDRESS 0
+#endif
+
+#ifndef MS_DISCOVERY_CACHE_ENTRIES
+/**
+ * @brief The number of sensors the discovery cache has room for.
+ *
+ * Each takes #MS_DISCOVERY_CACHE_ENTRY_SIZE bytes of EEPROM.
+ */
+#define MS_DISCOVERY_CACHE_ENTRIES 12
+#endif
+
+/**
+ * @brief The bytes of EEPROM taken by each entry of the discovery cache; 6
+ * of them are the key, the length and the check.
+ */
+#define MS_DISCOVERY_CACHE_ENTRY_SIZE 40
+
+/**
+ * @brief The kinds of bus searches kept in the discovery cache.
+ */
+typedef enum discoveryKind : uint8_t {
+    DISCOVERY_ONEWIRE_ROM = 1,  ///< The ROM of a OneWire sensor on a pin
+    DISCOVERY_SDI12_INFO,       ///< The identification of an SDI-12 sensor
+} discoveryKind;
+
+
+/**
+ * @brief The DiscoveryCache class keeps what was found by the bus searches at
+ * sensor setup in EEPROM (#MS_DISCOVERY_CACHE).
+ *
+ * Each entry is keyed by the kind of search, the data pin of the bus, and the
+ * address on the bus, if there is one; together these are the fingerprint of
+ * where the sensor was found.  EEPROM is only written when an entry changes.
+ *
+ * @note Only boards with EEPROM, like the AVR boards, keep the cache.  On
+ * other boards nothing is ever found in it, so the searches always run.
+ *
+ * @ingroup base_classes
+ */
+class DiscoveryCache {
+ public:
+    /**
+     * @brief Look for an entry in the cache.
+     *
+     * @param kind The discoveryKind of the search
+     * @param pin The data pin of the bus
+     * @param address The address of the sensor on the bus, or 0
+     * @param data The buffer to copy the entry into
+     * @param maxLength The size of the buffer
+     * @return **uint8_t** The number of bytes copied, or 0 if there's no
+     * entry.
+     */
+    static uint8_t load(discoveryKind kind, int8_t pin, char address,
+                        uint8_t* data, uint8_t maxLength);
+    /**
+     * @brief Keep an entry in the cache, replacing any with the same key.
+     *
+     * @param kind The discoveryKind of the search
+     * @param pin The data pin of the bus
+     * @param address The address of the sensor on the bus, or 0
+     * @param data The bytes to keep; only the first
+     * #MS_DISCOVERY_CACHE_ENTRY_SIZE - 6 are kept
+     * @param length The number of bytes to keep
+     */
+    static void save(discoveryKind kind, int8_t pin, char address,
+                     const uint8_t* data, uint8_t length);
+    /**
+     * @brief Remove an entry from the cache, so the search runs again at the
+     * next setup.
+     *
+     * @param kind The discoveryKind of the search
+     * @param pin The data pin of the bus
+     * @param address The address of the sensor on the bus, or 0
+     */
+    static void forget(discoveryKind kind, int8_t pin, char address);
+
+ private:
+    /**
+     * @brief Find the entry with a key.
+     *
+     * @param kind The discoveryKind of the search
+     * @param pin The data pin of the bus
+     * @param address The address of the sensor on the bus, or 0
+     * @return **int8_t** The position of the entry, or -1 if there's none.
+     */
+    static int8_t find(discoveryKind kind, int8_t pin, char address);
+    /**
+     * @brief Check that an entry is whole.
+     *
+     * @param slot The position of the entry
+     * @return **bool** True if the entry is in use and its check matches.
+     */
+    static bool isValid(uint8_t slot);
+    /**
+     * @brief Calculate the check of an entry.
+     *
+     * @param slot The position of the entry
+     * @return **uint8_t** The check of all of the bytes before it.
+     */
+    static uint8_t checkOf(uint8_t slot);
+};
+#endif  // MS_DISCOVERY_CACHE
+
+#endif  // SRC_DISCOVERYCACHE_H_
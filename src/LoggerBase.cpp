@@ -10,6 +10,7 @@
 
 #include "LoggerBase.h"
 #include "dataPublisherBase.h"
+#include "DeltaEncoding.h"
 
 /**
  * @brief To prevent compiler/linker crashes with enable interrupt library, we
@@ -30,6 +31,106 @@ int8_t Logger::_loggerRTCOffset = 0;
 // Initialize the static timestamps
 uint32_t Logger::markedLocalEpochTime = 0;
 uint32_t Logger::markedUTCEpochTime   = 0;
+#ifdef MS_LOGGER_RESULT_TIMES
+uint32_t Logger::_markedMillis = 0;
+#endif
+// Initialize the shared timestamp texts; they're made when the time is marked
+char     Logger::_markedTimeISO8601[26] = "";
+char     Logger::_markedTimeCSV[20]     = "";
+uint32_t Logger::_markedTimeFormatted   = 0;
+#ifdef MS_LOGGER_WARM_BOOT
+// The set up kept through a reset
+#define MS_BOOT_RECORD_MAGIC 0x4D534254UL
+typedef struct {
+    uint32_t magic;
+    uint32_t fingerprint;
+    bool     clockSet;
+    bool     autoFileName;
+    char     fileName[MS_WARM_BOOT_NAME_LENGTH];
+    uint32_t check;
+} loggerBootRecord;
+#ifdef MS_WARM_BOOT_SECTION
+static loggerBootRecord bootRecord
+    __attribute__((section(MS_WARM_BOOT_SECTION)));
+#else
+static loggerBootRecord bootRecord;
+#endif
+#endif
+#if defined(MS_LOGGER_WARM_BOOT) || defined(MS_LOGGER_RETAINED_BUFFER) || \
+    defined(MS_LOGGER_JOURNAL)
+// A 32-bit FNV-1a hash, continued from the hash of the bytes before
+static uint32_t bootHash(const void* data, size_t length, uint32_t hash) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+#endif
+#ifdef MS_LOGGER_WARM_BOOT
+// The check of everything in the record before the check itself, so random
+// RAM at power up isn't taken for a record
+static uint32_t bootRecordCheck(void) {
+    return bootHash(&bootRecord, offsetof(loggerBootRecord, check),
+                    2166136261UL);
+}
+#endif
+#ifdef MS_LOGGER_RETAINED_BUFFER
+// The record buffer and its header, kept through a reset
+#define MS_RETAINED_BUFFER_MAGIC 0x4D535242UL
+typedef struct {
+    uint32_t magic;
+    uint8_t  varCount;
+    uint16_t records;
+    uint16_t used;
+    uint32_t firstTime;
+    uint32_t lastTime;
+    uint32_t dataHash;
+    uint32_t check;
+} retainedBufferHeader;
+static retainedBufferHeader retainedHeader
+    __attribute__((section(MS_RETAINED_SECTION)));
+char Logger::_recordBuffer[MS_LOGGER_RECORD_BUFFER_SIZE]
+    __attribute__((section(MS_RETAINED_SECTION)));
+// The check of the header before the check itself
+static uint32_t retainedHeaderCheck(void) {
+    return bootHash(&retainedHeader, offsetof(retainedBufferHeader, check),
+                    2166136261UL);
+}
+#endif
+#ifdef MS_LOGGER_JOURNAL
+// One of the two entries of the journal
+typedef struct {
+    uint32_t sequence;
+    uint32_t nameHash;
+    uint32_t fileSize;
+    uint32_t check;
+} loggerJournalEntry;
+// The check of an entry before the check itself
+static uint32_t journalEntryCheck(const loggerJournalEntry& entry) {
+    return bootHash(&entry, offsetof(loggerJournalEntry, check),
+                    2166136261UL);
+}
+#endif
+#ifdef MS_LOGGER_SHARED_SD
+// Initialize the file system and session shared by every logger
+SdFat Logger::sd;
+#if defined(MS_LOGGER_SD_DMA) && defined(ARDUINO_ARCH_SAMD)
+LoggerSdSpiDMA Logger::_sdSpiDriver;
+#endif
+bool Logger::_sdMounted     = false;
+bool Logger::_sdSessionOpen = false;
+#ifdef MS_LOGGER_PERSISTENT_SD
+Logger* Logger::_sdLoggers = nullptr;
+#endif
+#endif
+#ifdef MS_LOGGER_CACHE_RTC
+// Initialize the cached clock time; the clock is read the first time it's used
+uint32_t Logger::_rtcCacheEpoch  = 0;
+uint32_t Logger::_rtcCacheMillis = 0;
+bool     Logger::_rtcCacheValid  = false;
+#endif
 // Initialize the testing/logging flags
 volatile bool Logger::isLoggingNow = false;
 volatile bool Logger::isTestingNow = false;
@@ -106,6 +207,27 @@ void Logger::setLoggerID(const char* loggerID) {
 // Sets/Gets the logging interval
 void Logger::setLoggingInterval(uint16_t loggingIntervalMinutes) {
     _loggingIntervalMinutes = loggingIntervalMinutes;
+#ifdef MS_LOGGER_SECONDS_INTERVAL
+    _loggingIntervalSeconds = 0;
+#endif
+}
+#ifdef MS_LOGGER_SECONDS_INTERVAL
+void Logger::setLoggingIntervalSeconds(uint16_t loggingIntervalSeconds) {
+    _loggingIntervalSeconds = loggingIntervalSeconds;
+}
+#endif
+uint32_t Logger::getLoggingIntervalSeconds(void) {
+    uint32_t interval = static_cast<uint32_t>(_loggingIntervalMinutes) * 60;
+#ifdef MS_LOGGER_SECONDS_INTERVAL
+    if (_loggingIntervalSeconds > 0) { interval = _loggingIntervalSeconds; }
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+    // A low battery profile stretches the interval
+    if (_powerLevel >= 0 && _powerProfiles[_powerLevel].intervalFactor > 1) {
+        interval *= _powerProfiles[_powerLevel].intervalFactor;
+    }
+#endif
+    return interval;
 }
 
 
@@ -133,6 +255,22 @@ void Logger::turnOnSDcard(bool waitToSettle) {
     }
 }
 void Logger::turnOffSDcard(bool waitForHousekeeping) {
+#ifdef MS_LOGGER_SHARED_SD
+    // The other loggers may still write in this session
+    if (_sdSessionOpen) {
+        MS_DBG(F("Leaving the SD card on for the rest of the session"));
+        return;
+    }
+#ifdef MS_LOGGER_PERSISTENT_SD
+    // Close the files of every logger on the card before it can lose power
+    for (Logger* l = _sdLoggers; l != nullptr; l = l->_nextSDLogger) {
+        l->endSDSession();
+    }
+#endif
+#elif defined(MS_LOGGER_PERSISTENT_SD)
+    // Close the file before the card can lose power
+    endSDSession();
+#endif
     if (_SDCardPowerPin >= 0) {
         // TODO(SRGDamia1): set All SPI pins to INPUT?
         // TODO(SRGDamia1): set ALL SPI pins HIGH (~30k pull-up)
@@ -147,6 +285,20 @@ void Logger::turnOffSDcard(bool waitForHousekeeping) {
 }
 
 
+#ifdef MS_LOGGER_SHARED_SD
+void Logger::openSDSession(void) {
+    _sdSessionOpen = true;
+}
+void Logger::closeSDSession(void) {
+    _sdSessionOpen = false;
+#ifndef MS_LOGGER_PERSISTENT_SD
+    // Mount the card again next time, it may lose power before then
+    _sdMounted = false;
+#endif
+}
+#endif
+
+
 // Sets up a pin for the slave select (chip select) of the SD card
 void Logger::setSDCardSS(int8_t SDCardSSPin) {
     _SDCardSSPin = SDCardSSPin;
@@ -233,6 +385,54 @@ void Logger::setVariableArray(VariableArray* inputArray) {
 }
 
 
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+// This adds a variable array to log at its own interval
+bool Logger::addSamplingGroup(VariableArray* groupArray,
+                              uint16_t intervalMinutes,
+                              uint8_t measurementsToAverage,
+                              const char* fileName) {
+    if (_groupCount >= MS_LOGGER_MAX_SAMPLING_GROUPS) {
+        PRINTOUT(F("No room for another sampling group!"));
+        return false;
+    }
+    if (intervalMinutes == 0) {
+        PRINTOUT(F("A sampling group needs an interval of at least a minute!"));
+        return false;
+    }
+    if (measurementsToAverage > 0) {
+        for (uint8_t i = 0; i < groupArray->getVariableCount(); i++) {
+            Sensor* sensor = groupArray->arrayOfVars[i]->parentSensor;
+            if (sensor != nullptr) {
+                sensor->setNumberMeasurementsToAverage(measurementsToAverage);
+            }
+        }
+    }
+    _groupArrays[_groupCount]    = groupArray;
+    _groupIntervals[_groupCount] = intervalMinutes;
+    if (fileName != nullptr) { _groupFileNames[_groupCount] = fileName; }
+    _groupCount++;
+    return true;
+}
+#endif
+
+
+#ifdef MS_LOGGER_EVENT_TRIGGER
+// This sets the variable and conditions that start an event
+void Logger::setEventTrigger(Variable* trigger, float threshold,
+                             float risePerMinute, uint16_t eventIntervalMinutes,
+                             uint8_t quietRecords) {
+    _eventTrigger       = trigger;
+    _eventThreshold     = threshold;
+    _eventRisePerMinute = risePerMinute;
+    _eventInterval      = eventIntervalMinutes > 0 ? eventIntervalMinutes : 1;
+    _eventQuietRecords  = quietRecords > 0 ? quietRecords : 1;
+    _eventQuietLeft     = 0;
+    _eventLastValue     = -9999;
+    _eventRingCount     = 0;
+}
+#endif
+
+
 // Returns the number of variables in the internal array
 uint8_t Logger::getArrayVarCount() {
     return _internalArray->getVariableCount();
@@ -240,35 +440,149 @@ uint8_t Logger::getArrayVarCount() {
 
 
 // This gets the name of the parent sensor, if applicable
+#ifndef MS_NO_STRING_GETTERS
 String Logger::getParentSensorNameAtI(uint8_t position_i) {
     return _internalArray->arrayOfVars[position_i]->getParentSensorName();
 }
+#endif
+const char* Logger::getParentSensorNameCharsAtI(uint8_t position_i) {
+    return _internalArray->arrayOfVars[position_i]->getParentSensorNameChars();
+}
 // This gets the name and location of the parent sensor, if applicable
 String Logger::getParentSensorNameAndLocationAtI(uint8_t position_i) {
     return _internalArray->arrayOfVars[position_i]
         ->getParentSensorNameAndLocation();
 }
 // This gets the variable's name using http://vocabulary.odm2.org/variablename/
+#ifndef MS_NO_STRING_GETTERS
 String Logger::getVarNameAtI(uint8_t position_i) {
     return _internalArray->arrayOfVars[position_i]->getVarName();
 }
+#endif
+const char* Logger::getVarNameCharsAtI(uint8_t position_i) {
+    return _internalArray->arrayOfVars[position_i]->getVarNameChars();
+}
 // This gets the variable's unit using http://vocabulary.odm2.org/units/
+#ifndef MS_NO_STRING_GETTERS
 String Logger::getVarUnitAtI(uint8_t position_i) {
     return _internalArray->arrayOfVars[position_i]->getVarUnit();
 }
+#endif
+const char* Logger::getVarUnitCharsAtI(uint8_t position_i) {
+    return _internalArray->arrayOfVars[position_i]->getVarUnitChars();
+}
 // This returns a customized code for the variable, if one is given, and a
 // default if not
+#ifndef MS_NO_STRING_GETTERS
 String Logger::getVarCodeAtI(uint8_t position_i) {
     return _internalArray->arrayOfVars[position_i]->getVarCode();
 }
+#endif
+const char* Logger::getVarCodeCharsAtI(uint8_t position_i) {
+    return _internalArray->arrayOfVars[position_i]->getVarCodeChars();
+}
 // This returns the variable UUID, if one has been assigned
+#ifndef MS_NO_STRING_GETTERS
 String Logger::getVarUUIDAtI(uint8_t position_i) {
     return _internalArray->arrayOfVars[position_i]->getVarUUID();
 }
+#endif
+const char* Logger::getVarUUIDCharsAtI(uint8_t position_i) {
+    return _internalArray->arrayOfVars[position_i]->getVarUUIDChars();
+}
 // This returns the current value of the variable as a string with the
 // correct number of significant figures
+#ifndef MS_NO_STRING_GETTERS
 String Logger::getValueStringAtI(uint8_t position_i) {
-    return _internalArray->arrayOfVars[position_i]->getValueString();
+    return String(getValueCharsAtI(position_i));
+}
+#endif
+const char* Logger::getValueCharsAtI(uint8_t position_i) {
+    if (_record != nullptr) {
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+        // The cached text of the array was made from the same values
+        if (!(_record->status &
+              (RECORD_FROM_OUTBOX | RECORD_FROM_RING | RECORD_FROM_NODE))) {
+            return _internalArray->getValueChars(position_i);
+        }
+#endif
+        return formatValueAtI(position_i, _record->values[position_i]);
+    }
+    return _internalArray->getValueChars(position_i);
+}
+// This formats a value the same way Variable::getValueChars() does
+const char* Logger::formatValueAtI(uint8_t position_i, float value) {
+    static char recordBuffer[VALUE_STRING_BUFFER_SIZE];
+    Variable::formatValue(
+        value, _internalArray->arrayOfVars[position_i]->getResolution(),
+        recordBuffer);
+    return recordBuffer;
+}
+// This returns the value of the variable in the record being saved
+float Logger::getRecordValueAtI(uint8_t position_i) {
+    if (_record != nullptr) { return _record->values[position_i]; }
+    return _internalArray->arrayOfVars[position_i]->getValue();
+}
+#ifdef MS_PUBLISH_ON_CHANGE
+bool Logger::isChangedAtI(uint8_t position_i) {
+    // A queued record is sent whole
+    if (_record != nullptr &&
+        (_record->status &
+         (RECORD_FROM_OUTBOX | RECORD_FROM_RING | RECORD_FROM_NODE))) {
+        return true;
+    }
+    return _internalArray->arrayOfVars[position_i]->hasChanged();
+}
+#endif
+
+// Protected helper function - This copies the current values into a record
+// that's read in place of the variables until the cycle is over
+void Logger::takeRecord(loggerRecord& record, float* values,
+                        int32_t* offsets) {
+    record.utcEpoch   = Logger::markedUTCEpochTime;
+    record.status     = isRTCSane(Logger::markedLocalEpochTime)
+            ? 0
+            : RECORD_CLOCK_UNSET;
+    record.valueCount = getArrayVarCount();
+    record.values     = values;
+#ifdef MS_VARIABLE_HISTORY
+    _internalArray->recordHistory(record.utcEpoch);
+#endif
+    for (uint8_t i = 0; i < record.valueCount; i++) {
+        values[i] = _internalArray->arrayOfVars[i]->getValue();
+    }
+#ifdef MS_LOGGER_RESULT_TIMES
+    record.resultOffsets = offsets;
+    uint8_t sensorCount = offsets == nullptr
+        ? 0
+        : _internalArray->getSensorListCount();
+    for (uint8_t s = 0; s < sensorCount; s++) {
+        Sensor*  sensor = _internalArray->getListedSensor(s);
+        uint32_t taken  = sensor->getLastResultTime();
+        offsets[s]      = taken == 0
+                 ? -9999
+                 : static_cast<int32_t>(taken - _markedMillis);
+    }
+#endif
+    _record = &record;
+}
+
+#ifdef MS_LOGGER_RESULT_TIMES
+int32_t Logger::getResultOffsetAtS(uint8_t sensorNumber) {
+    if (_record == nullptr || _record->resultOffsets == nullptr) {
+        return -9999;
+    }
+    return _record->resultOffsets[sensorNumber];
+}
+#endif
+
+// Protected helper function - This switches to another record
+void Logger::useRecord(loggerRecord* record) {
+    _record = record;
+    if (record == nullptr) { return; }
+    Logger::markedUTCEpochTime   = record->utcEpoch;
+    Logger::markedLocalEpochTime = record->utcEpoch +
+        ((uint32_t)_loggerRTCOffset) * 3600;
 }
 
 
@@ -284,8 +598,267 @@ void Logger::attachModem(loggerModem& modem) {
 }
 
 
+#ifdef MS_LOGGER_FAILOVER
+void Logger::attachLinks(LoggerLinks& links) {
+    _links = &links;
+    if (links.getLinkCount() > 0) { useLink(0); }
+}
+
+
+// Protected helper function - This moves the publishers with the client of
+// the old link to the client of the new one
+void Logger::useLink(uint8_t link) {
+    Client* oldClient = _links->getClient(_link);
+    Client* newClient = _links->getClient(link);
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] != nullptr &&
+            dataPublishers[i]->getClient() == oldClient) {
+            dataPublishers[i]->setClient(newClient);
+        }
+    }
+    _link     = link;
+    _logModem = _links->getModem(link);
+}
+#endif
+
+
+#ifdef MS_MODEM_PSM_SCHEDULE
+// Protected helper function - This gives the modem the time between publishes
+// for its power saving timers
+void Logger::scheduleModemPSM(void) {
+    uint32_t interval = getLoggingIntervalSeconds();
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+    // The modem is woken for the publisher that's sent to most often
+    int sendEveryX = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] == nullptr) { continue; }
+        int x = dataPublishers[i]->getSendInterval();
+        if (sendEveryX == 0 || x < sendEveryX) { sendEveryX = x; }
+    }
+    if (sendEveryX > 1) { interval *= sendEveryX; }
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+    // On a low battery the records are published together
+    if (_powerLevel >= 0 && _powerProfiles[_powerLevel].publishEvery > 1) {
+        interval *= _powerProfiles[_powerLevel].publishEvery;
+    }
+#endif
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+    if (_publishIntervalMinutes != 0) {
+        interval = static_cast<uint32_t>(_publishIntervalMinutes) * 60;
+    }
+#endif
+    _logModem->setPSMSchedule(interval);
+}
+#endif
+
+
+// Protected helper function - This wakes the modem, or the best of the links
+bool Logger::wakeModem(void) {
+#ifdef MS_MODEM_PSM_SCHEDULE
+    // An interval stretched on a low battery changes the timers
+    scheduleModemPSM();
+#endif
+#ifdef MS_LOGGER_FAILOVER
+    if (_links != nullptr && _links->getLinkCount() > 1) {
+        _links->rank();
+        _linkStart = millis();
+        for (_linkRank = 0; _linkRank < _links->getLinkCount(); _linkRank++) {
+            useLink(_links->getRanked(_linkRank));
+#ifdef MS_MODEM_PSM_SCHEDULE
+            scheduleModemPSM();
+#endif
+            if (_logModem->modemWake()) { return true; }
+            _links->recordAttempt(_link, false, 0);
+            _logModem->modemSleepPowerDown();
+            watchDogTimer.resetWatchDog();
+        }
+        return false;
+    }
+#endif
+    return _logModem->modemWake();
+}
+
+
+// Protected helper function - This connects the awake modem, or fails over to
+// the next links until one connects or the time is up
+bool Logger::connectModem(void) {
+#ifdef MS_LOGGER_OVERLAP_MODEM
+    // Finish the connection started before the sensor update
+    bool begun     = _connectBegun;
+    bool connected = false;
+    if (begun) {
+        _connectBegun           = false;
+        modemConnectState state = _logModem->pollConnect();
+        while (state != MODEM_CONNECT_CONNECTED &&
+               state != MODEM_CONNECT_FAILED) {
+            watchDogTimer.resetWatchDog();
+            state = _logModem->pollConnect();
+        }
+        connected = state == MODEM_CONNECT_CONNECTED;
+    }
+#endif
+#ifdef MS_LOGGER_FAILOVER
+    if (_links != nullptr && _links->getLinkCount() > 1) {
+        bool awake = true;
+#ifdef MS_LOGGER_OVERLAP_MODEM
+        if (begun) {
+            _links->recordAttempt(_link, connected, millis() - _linkStart);
+            if (connected) { return true; }
+        }
+#endif
+        while (millis() - _linkStart < MS_FAILOVER_BUDGET_MS) {
+#ifdef MS_LOGGER_OVERLAP_MODEM
+            if (begun) {
+                // The first link has already had its try
+                begun = false;
+            } else if (awake) {
+#else
+            if (awake) {
+#endif
+                uint32_t spent = millis() - _linkStart;
+                uint32_t limit = _links->getMaxConnectTime(_link);
+                if (limit > MS_FAILOVER_BUDGET_MS - spent) {
+                    limit = MS_FAILOVER_BUDGET_MS - spent;
+                }
+                uint32_t start = millis();
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+                bool connected = checkModemSignal() &&
+                    _logModem->connectInternet(limit);
+#else
+                bool connected = _logModem->connectInternet(limit);
+#endif
+                _links->recordAttempt(_link, connected, millis() - start);
+                if (connected) { return true; }
+            } else {
+                _links->recordAttempt(_link, false, 0);
+            }
+            if (_linkRank + 1 >= _links->getLinkCount()) { break; }
+            PRINTOUT(F("Failing over from"), _logModem->getModemName());
+            _logModem->modemSleepPowerDown();
+            watchDogTimer.resetWatchDog();
+            useLink(_links->getRanked(++_linkRank));
+            MS_DBG(F("Waking up"), _logModem->getModemName(), F("..."));
+            awake = _logModem->modemWake();
+            watchDogTimer.resetWatchDog();
+        }
+        return false;
+    }
+#endif
+#ifdef MS_LOGGER_OVERLAP_MODEM
+    if (begun) { return connected; }
+#endif
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+    // Don't wait out the whole connection time with no signal
+    if (!checkModemSignal()) { return false; }
+#endif
+    return _logModem->connectInternet();
+}
+
+
+#ifdef MS_LOGGER_OVERLAP_MODEM
+// Protected helper function - This starts connecting the modem, or the best of
+// the links, for connectModem() to finish
+void Logger::beginModemConnect(void) {
+#ifdef MS_MODEM_PSM_SCHEDULE
+    scheduleModemPSM();
+#endif
+    _connectBegun = true;
+#ifdef MS_LOGGER_FAILOVER
+    if (_links != nullptr && _links->getLinkCount() > 1) {
+        _links->rank();
+        _linkStart = millis();
+        _linkRank  = 0;
+        useLink(_links->getRanked(_linkRank));
+#ifdef MS_MODEM_PSM_SCHEDULE
+        scheduleModemPSM();
+#endif
+        uint32_t limit = _links->getMaxConnectTime(_link);
+        if (limit > MS_FAILOVER_BUDGET_MS) { limit = MS_FAILOVER_BUDGET_MS; }
+        _logModem->beginConnect(limit);
+        return;
+    }
+#endif
+    _logModem->beginConnect();
+}
+
+
+// Protected helper function - This takes the next step of the connection
+void Logger::pollModemConnect(void* logger) {
+    static_cast<Logger*>(logger)->_logModem->pollConnect();
+}
+#endif
+
+
+#ifdef MS_LOGGER_GATEWAY
+void Logger::attachGateway(LoggerGateway& gateway) {
+    _gateway = &gateway;
+}
+
+
+// Protected helper function - This sends the nodes' records the same way as
+// the logger's own, with the node's variables switched in
+void Logger::publishNodeRecords(void) {
+    uint8_t registered = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] != nullptr) { registered |= 1 << i; }
+    }
+
+    VariableArray* ownArray    = _internalArray;
+    const char*    ownFeature  = _samplingFeatureUUID;
+    loggerRecord*  cycleRecord = _record;
+    uint32_t       markedUTC   = Logger::markedUTCEpochTime;
+    uint32_t       markedLocal = Logger::markedLocalEpochTime;
+    uint8_t        skip        = 0;
+    uint8_t        sent        = 0;
+
+    LoggerGateway::queuedRecord* queued = _gateway->nextQueued();
+    while (queued != nullptr) {
+        queued->pending &= registered & _gateway->getNodePublishers(queued);
+        _internalArray       = _gateway->getNodeArray(queued);
+        _samplingFeatureUUID = _gateway->getNodeSamplingFeature(queued);
+        loggerRecord nodeRecord = {queued->utcEpoch, RECORD_FROM_NODE,
+                                   _internalArray->getVariableCount(),
+                                   queued->values};
+        useRecord(&nodeRecord);
+        for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+            uint8_t bit = 1 << i;
+            if (!(queued->pending & bit) || (skip & bit)) { continue; }
+            PRINTOUT(F("Sending a record from a node to ["), i, F("]"),
+                     dataPublishers[i]->getEndpoint());
+            int16_t result = dataPublishers[i]->publishData();
+            if (dataPublishers[i]->publishSucceeded(result)) {
+                queued->pending &= ~bit;
+            } else {
+                // Don't try this publisher again until the next connection
+                skip |= bit;
+            }
+            watchDogTimer.resetWatchDog();
+        }
+        if (queued->pending == 0) { sent++; }
+        queued = _gateway->nextQueued(queued);
+    }
+
+    _internalArray               = ownArray;
+    _samplingFeatureUUID         = ownFeature;
+    _record                      = cycleRecord;
+    Logger::markedUTCEpochTime   = markedUTC;
+    Logger::markedLocalEpochTime = markedLocal;
+    PRINTOUT(sent, F("records from the nodes were sent"));
+}
+#endif
+
+
 // Takes advantage of the modem to synchronize the clock
 bool Logger::syncRTC() {
+#ifdef MS_LOGGER_WARM_BOOT
+    // The clock was already set before a warm boot
+    if (_warmBootSyncPending) {
+        _warmBootSyncPending = false;
+        PRINTOUT(F("Clock was set before the reset; skipping the sync."));
+        return true;
+    }
+#endif
     bool success = false;
     if (_logModem != nullptr) {
         // Synchronize the RTC with NIST
@@ -294,7 +867,13 @@ bool Logger::syncRTC() {
         PRINTOUT(F("This may take up to two minutes!"));
         if (_logModem->modemWake()) {
             if (_logModem->connectInternet(120000L)) {
+#ifdef MS_WATCHDOG_PHASES
+                startPhase(PHASE_TIME_SYNC);
+#endif
                 setRTClock(_logModem->getNISTTime());
+#ifdef MS_WATCHDOG_PHASES
+                endPhase();
+#endif
                 success = true;
                 _logModem->updateModemMetadata();
             } else {
@@ -333,39 +912,1030 @@ void Logger::registerDataPublisher(dataPublisher* publisher) {
 
 void Logger::publishDataToRemotes(void) {
     MS_DBG(F("Sending out remote data."));
+#if defined(MS_MODEM_STATS) || defined(MS_PUBLISHER_BUDGET)
+    uint32_t publishingStart = millis();
+#endif
+
+#ifdef MS_PUBLISH_ON_CHANGE
+    // Decide once which variables are worth sending, for all the publishers
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        _internalArray->arrayOfVars[i]->checkForChange(markedUTCEpochTime);
+    }
+#endif
 
+#ifdef MS_PUBLISHER_OUTBOX
+    _publishFailures = 0;
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    // Send the requests of the publishers with a client of their own first
+    // and read the responses after, so the receivers answer at the same time
+    uint8_t started = 0;
+    uint8_t sent    = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] == nullptr ||
+            !dataPublishers[i]->sendsRequestsAhead() ||
+            dataPublishers[i]->getClient() == nullptr) {
+            continue;
+        }
+#ifdef MS_PUBLISHER_RETRY
+        // Publishers skipping this wake are left for the loop below
+        if (dataPublishers[i]->isBackingOff()) { continue; }
+#endif
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+        if (!(_sendDue & (1 << i))) { continue; }
+#endif
+        bool sharedClient = false;
+        for (uint8_t j = 0; j < MAX_NUMBER_SENDERS; j++) {
+            if (j != i && dataPublishers[j] != nullptr &&
+                dataPublishers[j]->getClient() ==
+                    dataPublishers[i]->getClient()) {
+                sharedClient = true;
+            }
+        }
+        if (sharedClient) { continue; }
+        PRINTOUT(F("\nSending data to ["), i, F("]"),
+                 dataPublishers[i]->getEndpoint());
+        started |= 1 << i;
+#ifdef MS_PUBLISHER_STATS
+        dataPublishers[i]->startPublishStats();
+#endif
+        if (dataPublishers[i]->startPublish()) { sent |= 1 << i; }
+        watchDogTimer.resetWatchDog();
+    }
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (!(started & (1 << i))) { continue; }
+        PRINTOUT(F("\nResponse from ["), i, F("]"),
+                 dataPublishers[i]->getEndpoint());
+        int16_t result = dataPublishers[i]->finishPublish(sent & (1 << i));
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+        // Only a send that worked uses up the interval
+        if (dataPublishers[i]->publishSucceeded(result)) {
+            dataPublishers[i]->restartSendInterval();
+        }
+#endif
+#ifdef MS_PUBLISHER_STATS
+        dataPublishers[i]->recordPublishStats(result);
+#endif
+#ifdef MS_PUBLISHER_RETRY
+        dataPublishers[i]->recordWakeResult(result);
+#endif
+#ifdef MS_PUBLISHER_OUTBOX
+        if (!dataPublishers[i]->publishSucceeded(result)) {
+            _publishFailures |= 1 << i;
+        }
+#else
+        (void)result;
+#endif
+        watchDogTimer.resetWatchDog();
+    }
+#endif
+#if defined(MS_PUBLISHER_KEEP_ALIVE) || defined(MS_PUBLISHER_BUDGET)
+    uint8_t order[MAX_NUMBER_SENDERS];
+    uint8_t nOrdered = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] == nullptr) { continue; }
+        uint8_t k = nOrdered++;
+#ifdef MS_PUBLISHER_BUDGET
+        // Send to the most important publishers first, and of those the
+        // quickest first
+        while (k > 0 &&
+               dataPublishers[i]->sendsBefore(dataPublishers[order[k - 1]])) {
+            order[k] = order[k - 1];
+            k--;
+        }
+#endif
+        order[k] = i;
+    }
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+    // Send to publishers with the same endpoint one after another, so they
+    // can share a connection
+    uint8_t grouped = 0;
+    while (grouped < nOrdered) {
+        String endpoint = dataPublishers[order[grouped++]]->getEndpoint();
+        for (uint8_t j = grouped; j < nOrdered; j++) {
+            if (dataPublishers[order[j]]->getEndpoint() != endpoint) {
+                continue;
+            }
+            // Move it up behind the others, keeping the order of the rest
+            uint8_t moved = order[j];
+            for (uint8_t m = j; m > grouped; m--) { order[m] = order[m - 1]; }
+            order[grouped++] = moved;
+        }
+    }
+#endif
+    for (uint8_t k = 0; k < nOrdered; k++) {
+        uint8_t i = order[k];
+        if (dataPublishers[i] != nullptr) {
+#else
     for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
         if (dataPublishers[i] != nullptr) {
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+            if (started & (1 << i)) { continue; }
+#endif
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+            // Leave the publishers whose send interval isn't up in the outbox
+            if (!(_sendDue & (1 << i))) {
+                MS_DBG(F("Not due to send; holding the record for ["), i,
+                       F("]"));
+                _publishFailures |= 1 << i;
+                continue;
+            }
+#endif
+#ifdef MS_PUBLISHER_RETRY
+            // Leave the publishers still backing off after failures for later
+            if (dataPublishers[i]->skipsThisWake()) {
+                MS_DBG(F("Backing off after failures; skipping ["), i,
+                       F("]"));
+#ifdef MS_PUBLISHER_OUTBOX
+                _publishFailures |= 1 << i;
+#endif
+                continue;
+            }
+#endif
+#ifdef MS_WATCHDOG_PHASES
+            // Leave the remotes not reached yet in time for the outbox
+            if (watchDogTimer.phaseExpired()) {
+                MS_DBG(F("Out of time to publish; skipping ["), i, F("]"));
+#ifdef MS_PUBLISHER_OUTBOX
+                _publishFailures |= 1 << i;
+#endif
+                continue;
+            }
+#endif
+#ifdef MS_PUBLISHER_BUDGET
+            // Leave the publishers that won't fit in the budget for later
+            if (_publishBudget != 0 &&
+                millis() - publishingStart +
+                        dataPublishers[i]->getPublishTime() >
+                    _publishBudget * 1000UL) {
+                MS_DBG(F("Not enough time left to publish; skipping ["), i,
+                       F("]"));
+#ifdef MS_PUBLISHER_OUTBOX
+                _publishFailures |= 1 << i;
+#endif
+                continue;
+            }
+#endif
             PRINTOUT(F("\nSending data to ["), i, F("]"),
                      dataPublishers[i]->getEndpoint());
-            dataPublishers[i]->publishData();
+            MS_PROFILE_START(SPAN_PUBLISH);
+#ifdef MS_PUBLISHER_BUDGET
+            uint32_t publishStart = millis();
+#endif
+#ifdef MS_PUBLISHER_STATS
+            dataPublishers[i]->startPublishStats();
+#endif
+#ifdef MS_PUBLISHER_RETRY
+            int16_t result = dataPublishers[i]->publishWithRetries();
+#else
+            int16_t result = dataPublishers[i]->publishData();
+#endif
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+            // Only a send that worked uses up the interval
+            if (dataPublishers[i]->publishSucceeded(result)) {
+                dataPublishers[i]->restartSendInterval();
+            }
+#endif
+#ifdef MS_PUBLISHER_STATS
+            dataPublishers[i]->recordPublishStats(result);
+#endif
+#ifdef MS_PUBLISHER_OUTBOX
+            if (!dataPublishers[i]->publishSucceeded(result)) {
+                _publishFailures |= 1 << i;
+            }
+#else
+            (void)result;
+#endif
+#ifdef MS_PUBLISHER_BUDGET
+            dataPublishers[i]->recordPublishTime(millis() - publishStart);
+#endif
+            MS_PROFILE_END_FOR(SPAN_PUBLISH, i);
             watchDogTimer.resetWatchDog();
         }
     }
+#ifdef MS_MODEM_STATS
+    // The time for all of the publishers together, not just the last one
+    loggerModem::recordPublish(millis() - publishingStart);
+#endif
 }
 void Logger::sendDataToRemotes(void) {
     publishDataToRemotes();
 }
 
 
-// ===================================================================== //
-// Public functions to access the clock in proper format and time zone
-// ===================================================================== //
-
-// Sets the static timezone that the data will be logged in - this must be set
-void Logger::setLoggerTimeZone(int8_t timeZone) {
-    _loggerTimeZone = timeZone;
-// Some helpful prints for debugging
-#ifdef STANDARD_SERIAL_OUTPUT
-    const char* prtout1 = "Logger timezone is set to UTC";
-    if (_loggerTimeZone == 0) {
-        PRINTOUT(prtout1);
-    } else if (_loggerTimeZone > 0) {
-        PRINTOUT(prtout1, '+', _loggerTimeZone);
-    } else {
-        PRINTOUT(prtout1, _loggerTimeZone);
-    }
-#endif
+#ifdef MS_PUBLISHER_BUDGET
+void Logger::setPublishBudget(uint16_t budgetSeconds) {
+    _publishBudget = budgetSeconds;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_OUTBOX
+// The outbox starts with the position of the oldest record that may still be
+// waiting and the number of variables in each record
+static const uint8_t outboxHeaderSize = sizeof(uint32_t) + 1;
+
+void Logger::setOutboxBudget(uint16_t budgetSeconds) {
+    _outboxBudget = budgetSeconds;
+}
+
+// Protected helper function - This is a bit for each registered publisher
+uint8_t Logger::getPublisherBits(void) {
+    uint8_t bits = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] != nullptr) { bits |= 1 << i; }
+    }
+    return bits;
+}
+
+// Protected helper function - This opens the outbox, starting a new one if
+// there isn't one for this variable array
+bool Logger::openOutbox(void) {
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+    // The card may have been left off after writing the record buffer
+    turnOnSDcard(true);
+#endif
+    if (!initializeSDCard()) return false;
+
+    char outboxName[strlen(_loggerID) + sizeof(MS_OUTBOX_SUFFIX)];
+    strcpy(outboxName, _loggerID);
+    strcat(outboxName, MS_OUTBOX_SUFFIX);
+    uint8_t varCount = getArrayVarCount();
+    if (outboxFile.open(outboxName, O_RDWR)) {
+        uint32_t head;
+        uint8_t  outboxVarCount = 0;
+        if (outboxFile.read(&head, sizeof(head)) == sizeof(head) &&
+            outboxFile.read(&outboxVarCount, 1) == 1 &&
+            outboxVarCount == varCount) {
+#ifdef MS_LOGGER_JOURNAL
+            // Drop a record that was only partly written before a restart
+            uint32_t recordSize = sizeof(uint32_t) + 1 + 4 * varCount;
+            uint32_t size       = outboxFile.fileSize();
+            uint32_t partial    = 0;
+            if (size > outboxHeaderSize) {
+                partial = (size - outboxHeaderSize) % recordSize;
+            }
+            if (partial != 0) {
+                PRINTOUT(F("Dropping a partial record from the outbox"));
+                outboxFile.truncate(size - partial);
+            }
+#endif
+            return true;
+        }
+        PRINTOUT(F("Starting over with an outbox for"), varCount,
+                 F("variables"));
+        outboxFile.close();
+    }
+    if (!outboxFile.open(outboxName, O_RDWR | O_CREAT | O_TRUNC)) {
+        MS_DBG(F("Unable to create the outbox"), outboxName);
+        return false;
+    }
+    uint32_t head = outboxHeaderSize;
+    outboxFile.write(reinterpret_cast<const uint8_t*>(&head), sizeof(head));
+    outboxFile.write(varCount);
+    return true;
+}
+
+// This adds the current record to the outbox
+bool Logger::queueOutboxRecord(uint8_t pending) {
+    if (pending == 0) { return true; }
+    if (!openOutbox()) {
+        PRINTOUT(F("Unable to queue data for the remotes!"));
+        return false;
+    }
+    outboxFile.seekEnd();
+    outboxFile.write(
+        reinterpret_cast<const uint8_t*>(&Logger::markedUTCEpochTime),
+        sizeof(uint32_t));
+    outboxFile.write(pending);
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        float value = getRecordValueAtI(i);
+        outboxFile.write(reinterpret_cast<const uint8_t*>(&value),
+                         sizeof(value));
+    }
+    MS_DBG(F("Queued the record in the outbox for publishers"), pending);
+    return outboxFile.close();
+}
+
+// This switches the marked time and values to a record from the outbox
+bool Logger::loadReplayRecord(uint8_t recordNumber) {
+    if (recordNumber >= _replayCount) { return false; }
+    uint32_t recordTime;
+    outboxFile.seekSet(_replayPositions[recordNumber]);
+    if (outboxFile.read(&recordTime, sizeof(recordTime)) !=
+            sizeof(recordTime) ||
+        !outboxFile.seekSet(_replayPositions[recordNumber] +
+                            sizeof(recordTime) + 1)) {
+        return false;
+    }
+    int valueBytes = sizeof(float) * getArrayVarCount();
+    if (outboxFile.read(_record->values, valueBytes) != valueBytes) {
+        return false;
+    }
+    _record->utcEpoch = recordTime;
+    useRecord(_record);
+    return true;
+}
+
+#ifdef MS_LOGGER_BACKFILL
+bool Logger::requestBackfill(dataPublisher* publisher, uint32_t fromUTC,
+                             uint32_t toUTC) {
+    uint8_t bit = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (publisher != nullptr && dataPublishers[i] == publisher) {
+            bit = 1 << i;
+        }
+    }
+    if (bit == 0 || toUTC < fromUTC) { return false; }
+    if (_backfillPublishers == 0) {
+        _backfillFrom = fromUTC;
+        _backfillTo   = toUTC;
+    } else {
+        if (fromUTC < _backfillFrom) { _backfillFrom = fromUTC; }
+        if (toUTC > _backfillTo) { _backfillTo = toUTC; }
+    }
+    _backfillPublishers |= bit;
+    PRINTOUT(F("Backfill of the records from"), fromUTC, F("to"), toUTC,
+             F("requested by"), publisher->getEndpoint());
+    return true;
+}
+
+// Reads the time and values of a line written by printSensorDataCSV(); the
+// header lines don't start with a date, so they're passed over
+static bool parseCSVRecord(char* line, uint32_t& localTime, float* values,
+                           uint8_t count) {
+    int year, month, day, hour, minute, second;
+    if (sscanf(line, "%4d-%2d-%2d %2d:%2d:%2d", &year, &month, &day, &hour,
+               &minute, &second) != 6 ||
+        year < 2000) {
+        return false;
+    }
+    DateTime dt(year, month, day, hour, minute, second);
+    localTime = dt.get() + EPOCH_TIME_OFF;
+    char* c   = strchr(line, ',');
+    for (uint8_t i = 0; i < count; i++) {
+        if (c == nullptr || *c != ',') { return false; }
+        values[i] = strtod(c + 1, &c);
+    }
+    return true;
+}
+
+// Protected helper function - This copies the next part of the backfill into
+// the outbox once the last part has all been sent, so the outbox doesn't grow
+uint16_t Logger::queueBackfill(void) {
+    uint8_t pending = _backfillPublishers & getPublisherBits();
+    if (pending == 0 || !openOutbox()) { return 0; }
+    uint32_t head;
+    outboxFile.seekSet(0);
+    outboxFile.read(&head, sizeof(head));
+    if (head < outboxFile.fileSize()) {
+        outboxFile.close();
+        return 0;
+    }
+
+    char indexName[strlen(_loggerID) + sizeof(MS_LOG_INDEX_SUFFIX)];
+    strcpy(indexName, _loggerID);
+    strcat(indexName, MS_LOG_INDEX_SUFFIX);
+    File indexFile;
+    if (!indexFile.open(indexName, O_RDONLY)) {
+        MS_DBG(F("Unable to open the index file"), indexName);
+        outboxFile.close();
+        _backfillPublishers = 0;
+        return 0;
+    }
+
+    // The index has the local times of the first and last record of each
+    // file, in the order the files were started
+    const uint8_t nameStart = 33;
+    char          line[nameStart + 64];
+    uint32_t      offset   = ((uint32_t)_loggerRTCOffset) * 3600;
+    uint16_t      queued   = 0;
+    bool          finished = true;
+    indexFile.fgets(line, sizeof(line));
+    while (finished && indexFile.fgets(line, sizeof(line)) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (strlen(line) <= nameStart) { continue; }
+        uint32_t first = strtoul(line, nullptr, 10) - offset;
+        uint32_t last  = strtoul(line + 11, nullptr, 10) - offset;
+        if (last < _backfillFrom || first > _backfillTo) { continue; }
+        finished = queueBackfillFile(line + nameStart, pending, queued);
+        watchDogTimer.resetWatchDog();
+    }
+    indexFile.close();
+    outboxFile.close();
+
+    PRINTOUT(queued, F("records of the backfill were put in the outbox"));
+    if (finished) {
+        PRINTOUT(F("The backfill is finished"));
+        _backfillPublishers = 0;
+    }
+    return queued;
+}
+
+// Protected helper function - This copies the records in the range from one
+// log file, csv or binary, to the end of the outbox
+bool Logger::queueBackfillFile(const char* fileName, uint8_t pending,
+                               uint16_t& queued) {
+    File file;
+    if (!file.open(fileName, O_RDONLY)) {
+        MS_DBG(F("Unable to open"), fileName, F("for the backfill"));
+        return true;
+    }
+    uint8_t  varCount = getArrayVarCount();
+    float    values[varCount];
+    uint32_t offset = ((uint32_t)_loggerRTCOffset) * 3600;
+
+    // A binary file has the version and variable count after its magic, then
+    // the header text and the resolutions before the records
+    char magic[sizeof(MS_BINARY_LOG_MAGIC)] = "";
+    file.read(magic, sizeof(magic) - 1);
+    bool binary = strcmp(magic, MS_BINARY_LOG_MAGIC) == 0;
+    if (binary) {
+        uint8_t version  = file.read();
+        uint8_t binCount = file.read();
+        if (version != 1 || binCount != varCount) {
+            MS_DBG(F("Can't read the records of"), fileName);
+            file.close();
+            return true;
+        }
+        while (file.available() && file.read() != 0) {}
+        file.seekSet(file.curPosition() + varCount);
+    } else {
+        file.seekSet(0);
+    }
+
+    char     line[MS_BACKFILL_LINE_SIZE];
+    uint32_t localTime;
+    bool     finished = true;
+    while (true) {
+        if (binary) {
+            if (file.read(&localTime, sizeof(localTime)) != sizeof(localTime) ||
+                file.read(values, sizeof(values)) !=
+                    static_cast<int>(sizeof(values))) {
+                break;
+            }
+        } else {
+            if (file.fgets(line, sizeof(line)) <= 0) { break; }
+            if (!parseCSVRecord(line, localTime, values, varCount)) {
+                continue;
+            }
+        }
+        uint32_t utcTime = localTime - offset;
+        if (utcTime < _backfillFrom || utcTime > _backfillTo) { continue; }
+        if (queued >= MS_BACKFILL_RECORDS) {
+            finished = false;
+            break;
+        }
+        // The same layout as queueOutboxRecord()
+        outboxFile.seekEnd();
+        outboxFile.write(reinterpret_cast<const uint8_t*>(&utcTime),
+                         sizeof(utcTime));
+        outboxFile.write(pending);
+        outboxFile.write(reinterpret_cast<const uint8_t*>(values),
+                         sizeof(values));
+        _backfillFrom = utcTime + 1;
+        queued++;
+    }
+    file.close();
+    return finished;
+}
+#endif
+
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+void Logger::setPublishPolicy(uint16_t maxLatencyMinutes, int16_t goodRSSI,
+                              uint16_t slowConnectSeconds) {
+    _maxPublishLatency = maxLatencyMinutes;
+    _goodRSSI          = goodRSSI;
+    _slowConnect       = slowConnectSeconds;
+}
+
+// Protected helper function - After marginal connections this waits twice as
+// long after each one, but not so long the oldest record is late
+bool Logger::checkPublishDue(void) {
+    if (_maxPublishLatency == 0 || _marginalCount == 0) { return true; }
+    uint32_t now      = Logger::markedUTCEpochTime;
+    uint32_t interval = getLoggingIntervalSeconds();
+    if (_oldestUnpublished != 0 &&
+        now - _oldestUnpublished + interval >=
+            static_cast<uint32_t>(_maxPublishLatency) * 60) {
+        MS_DBG(F("Publishing before the oldest record is late"));
+        return true;
+    }
+    uint32_t wait = interval << min(_marginalCount, 6);
+    return now - _lastPublishAttempt >= wait;
+}
+
+// Protected helper function - This notes whether the connection was marginal
+void Logger::updatePublishHistory(bool connected, uint32_t connectTime) {
+    bool  unpublished = !connected || _publishFailures != 0;
+    float rssi        = loggerModem::getModemRSSI();
+    bool  marginal    = unpublished ||
+        connectTime > static_cast<uint32_t>(_slowConnect) * 1000 ||
+        (rssi != -9999 && rssi < _goodRSSI);
+    MS_DBG(F("Connection took"), connectTime, F("ms with RSSI"), rssi,
+           marginal ? F("- marginal") : F("- good"));
+
+    _lastPublishAttempt = Logger::markedUTCEpochTime;
+    if (!marginal) {
+        _marginalCount = 0;
+    } else if (_marginalCount < 255) {
+        _marginalCount++;
+    }
+    if (!unpublished) {
+        _oldestUnpublished = 0;
+    } else if (_oldestUnpublished == 0) {
+        _oldestUnpublished = Logger::markedUTCEpochTime;
+    }
+}
+#endif
+
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+void Logger::setConnectBackoff(uint16_t maxBackoffMinutes) {
+    _maxConnectBackoff = maxBackoffMinutes;
+}
+
+// Protected helper function - This reads the saved failure history
+void Logger::loadConnectBackoff(void) {
+    if (_connectBackoffLoaded) { return; }
+    _connectBackoffLoaded = true;
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+    turnOnSDcard(true);
+#endif
+    if (!initializeSDCard()) { return; }
+    char backoffName[strlen(_loggerID) + sizeof(MS_BACKOFF_SUFFIX)];
+    strcpy(backoffName, _loggerID);
+    strcat(backoffName, MS_BACKOFF_SUFFIX);
+    File backoffFile;
+    if (backoffFile.open(backoffName, O_READ)) {
+        uint8_t  failures;
+        uint32_t nextAttempt;
+        if (backoffFile.read(&failures, 1) == 1 &&
+            backoffFile.read(&nextAttempt, sizeof(nextAttempt)) ==
+                sizeof(nextAttempt)) {
+            _connectFailures    = failures;
+            _nextConnectAttempt = nextAttempt;
+            MS_DBG(F("Restored"), failures, F("failed connections in a row"));
+        }
+        backoffFile.close();
+    }
+}
+
+// Protected helper function - After failed connections this waits twice as
+// long after each one, up to the set maximum
+bool Logger::checkConnectDue(void) {
+    loadConnectBackoff();
+    if (_connectFailures == 0) { return true; }
+    uint32_t now = Logger::markedUTCEpochTime;
+    // If the clock was set back, don't wait longer than the maximum
+    if (now >= _nextConnectAttempt ||
+        _nextConnectAttempt - now >
+            static_cast<uint32_t>(_maxConnectBackoff) * 60) {
+        return true;
+    }
+    MS_DBG(F("Not connecting for another"), _nextConnectAttempt - now,
+           F("seconds after"), _connectFailures, F("failed connections"));
+    return false;
+}
+
+// Protected helper function - This gives the modem a little while to find
+// any signal at all
+bool Logger::checkModemSignal(void) {
+    // After a check that found nothing, give the modem the whole connection
+    // time, in case it's only slow to find the network, ie, an LTE-M attach
+    if (_signalCheckTimedOut) {
+        _signalCheckTimedOut = false;
+        return true;
+    }
+    uint32_t start = millis();
+    do {
+        int16_t rssi    = 0;
+        int16_t percent = 0;
+        // No signal reads as 0 until the modem has found a network
+        if (_logModem->getModemSignalQuality(rssi, percent) && rssi != 0 &&
+            rssi != -9999) {
+            MS_DBG(F("Signal before connecting:"), rssi, F("dBm"));
+            return true;
+        }
+        delay(500);
+        watchDogTimer.resetWatchDog();
+    } while (millis() - start < MS_LOGGER_SIGNAL_CHECK_MS);
+    PRINTOUT(F("No signal found, not trying to connect"));
+    _signalCheckTimedOut = true;
+    return false;
+}
+
+// Protected helper function - This counts failed connections and saves them
+void Logger::updateConnectBackoff(bool connected) {
+    if (connected) {
+        _signalCheckTimedOut = false;
+        if (_connectFailures == 0) { return; }
+        _connectFailures = 0;
+    } else if (_signalCheckTimedOut) {
+        // Only full connection attempts are counted
+        MS_DBG(F("Trying the whole connection at the next interval"));
+        return;
+    } else {
+        if (_connectFailures < 255) { _connectFailures++; }
+        uint32_t wait = getLoggingIntervalSeconds()
+            << min(_connectFailures - 1, 10);
+        uint32_t maxWait = static_cast<uint32_t>(_maxConnectBackoff) * 60;
+        if (wait > maxWait) { wait = maxWait; }
+        _nextConnectAttempt = Logger::markedUTCEpochTime + wait;
+        PRINTOUT(_connectFailures,
+                 F("failed connections in a row, next try in"), wait / 60,
+                 F("minutes"));
+    }
+
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+    turnOnSDcard(true);
+#endif
+    if (!initializeSDCard()) { return; }
+    char backoffName[strlen(_loggerID) + sizeof(MS_BACKOFF_SUFFIX)];
+    strcpy(backoffName, _loggerID);
+    strcat(backoffName, MS_BACKOFF_SUFFIX);
+    File backoffFile;
+    if (backoffFile.open(backoffName, O_WRITE | O_CREAT)) {
+        backoffFile.write(_connectFailures);
+        backoffFile.write(
+            reinterpret_cast<const uint8_t*>(&_nextConnectAttempt),
+            sizeof(_nextConnectAttempt));
+        backoffFile.close();
+    }
+}
+#endif
+
+#ifdef MS_LOGGER_POWER_POLICY
+void Logger::setPowerPolicy(Variable* battery, const powerProfile* profiles,
+                            uint8_t profileCount, float hysteresis_V,
+                            bool needCharging) {
+    _battery           = battery;
+    _powerProfiles     = profiles;
+    _powerProfileCount = profileCount;
+    _powerHysteresis   = hysteresis_V;
+    _powerNeedCharging = needCharging;
+}
+
+// Protected helper function - This drops straight to the profile for the
+// voltage, but only climbs back one profile at a time past the hysteresis
+void Logger::applyPowerPolicy(void) {
+    if (_battery == nullptr || _powerProfileCount == 0) { return; }
+    float voltage = _battery->getValue();
+    if (voltage == -9999) { return; }
+    if (_lastBattery != -9999) {
+        _batteryTrend += (voltage - _lastBattery - _batteryTrend) / 8;
+    }
+    _lastBattery = voltage;
+
+    int8_t level = _powerLevel;
+    while (level + 1 < _powerProfileCount &&
+           voltage < _powerProfiles[level + 1].enterBelow_V) {
+        level++;
+    }
+    if (level == _powerLevel && level >= 0 &&
+        voltage > _powerProfiles[level].enterBelow_V + _powerHysteresis &&
+        (!_powerNeedCharging || _batteryTrend > 0)) {
+        level--;
+    }
+    if (level == _powerLevel) { return; }
+
+    _powerLevel = level;
+    _powerHeld  = 0;
+    PRINTOUT(F("Battery at"), voltage, F("V; moving to power profile"),
+             level);
+    Sensor::setAveragingLimit(level >= 0 ? _powerProfiles[level].maxAverages
+                                         : 0);
+#ifdef MS_SENSOR_DECIMATION
+    Sensor::setDecimationFactor(
+        level >= 0 ? _powerProfiles[level].decimateFactor : 1);
+#endif
+}
+
+// Protected helper function - This holds all but every few records in the
+// outbox
+bool Logger::checkPowerPublishDue(void) {
+    if (_powerLevel < 0 || _powerProfiles[_powerLevel].publishEvery <= 1) {
+        _powerHeld = 0;
+        return true;
+    }
+    if (++_powerHeld >= _powerProfiles[_powerLevel].publishEvery) {
+        _powerHeld = 0;
+        return true;
+    }
+    return false;
+}
+#endif
+
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+// Protected helper function - This counts the record toward every send
+// interval
+uint8_t Logger::countPublisherRecords(void) {
+    uint8_t due = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] != nullptr && dataPublishers[i]->countRecord()) {
+            due |= 1 << i;
+        }
+    }
+    MS_DBG(F("Publishers due to be sent to:"), due);
+    return due;
+}
+#endif
+
+#ifdef MS_LOGGER_PREWAKE
+void Logger::setPrewakeLead(uint16_t leadSeconds) {
+    _prewakeLead = leadSeconds;
+}
+
+uint32_t Logger::getPrewakeLead(void) {
+    // Until the clock is set the logger wakes every minute, and a lead would
+    // never land on one of those wakes
+    if (!isRTCSane()) { return 0; }
+    uint32_t lead = _prewakeLead;
+    if (_prewakeLead == 0xFFFF) {
+        lead = 0;
+        if (_internalArray != nullptr) {
+            lead = (_internalArray->getExpectedUpdateTime() + 999) / 1000 +
+                MS_PREWAKE_MARGIN_S;
+        }
+    }
+    uint32_t most = getLoggingIntervalSeconds() / 2;
+    return lead < most ? lead : most;
+}
+#endif
+
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+void Logger::setPublishSchedule(uint16_t intervalMinutes,
+                                uint16_t offsetSeconds) {
+    _publishIntervalMinutes = intervalMinutes;
+    _publishOffsetSeconds   = 0;
+    if (intervalMinutes != 0) {
+        _publishOffsetSeconds = offsetSeconds %
+            (static_cast<uint32_t>(intervalMinutes) * 60);
+    }
+}
+
+// Protected helper function - This checks if it's a publish time
+bool Logger::checkPublishSchedule(void) {
+    if (_publishIntervalMinutes == 0) { return false; }
+    uint32_t interval = static_cast<uint32_t>(_publishIntervalMinutes) * 60;
+    bool     due = (getNowLocalEpoch() - _publishOffsetSeconds) % interval == 0;
+    if (due) { MS_DBG(F("Time to publish!")); }
+    return due;
+}
+
+// Protected helper function - This finds the next publish time
+uint32_t Logger::getNextPublishTime(uint32_t localTime) {
+    uint32_t interval = static_cast<uint32_t>(_publishIntervalMinutes) * 60;
+    return ((localTime - _publishOffsetSeconds) / interval + 1) * interval +
+        _publishOffsetSeconds;
+}
+
+// Protected helper function - This makes a connection just to send the
+// records waiting in the outbox
+void Logger::publishScheduled(void) {
+    if (_logModem == nullptr) { return; }
+    watchDogTimer.resetWatchDog();
+    // The records carry their own times; this is the time of the connection
+    markTime();
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+    // After failed connections, wait longer before trying again
+    if (!checkConnectDue()) { return; }
+#endif
+    Logger::isLoggingNow = true;
+    PRINTOUT(F("------------------------------------------"));
+    PRINTOUT(F("Publishing the records in the outbox"));
+    alertOn();
+#ifndef MS_LOGGER_RECORD_BUFFER_SIZE
+    turnOnSDcard(false);
+#endif
+
+    bool connected = false;
+    MS_DBG(F("Waking up"), _logModem->getModemName(), F("..."));
+    MS_PROFILE_START(SPAN_MODEM_WAKE);
+    bool modemAwake = wakeModem();
+    MS_PROFILE_END(SPAN_MODEM_WAKE);
+    if (modemAwake) {
+        watchDogTimer.resetWatchDog();
+        MS_DBG(F("Connecting to the Internet..."));
+        MS_PROFILE_START(SPAN_CONNECT);
+        connected = connectModem();
+        MS_PROFILE_END(SPAN_CONNECT);
+        watchDogTimer.resetWatchDog();
+    }
+    if (connected) {
+#ifdef MS_LOGGER_BACKFILL
+        if (_backfillPublishers != 0) { queueBackfill(); }
+#endif
+        replayOutbox();
+        watchDogTimer.resetWatchDog();
+
+        // Sync the clock at the first publication after noon
+        uint32_t interval = static_cast<uint32_t>(_publishIntervalMinutes) *
+            60;
+        bool noonSync = (Logger::markedLocalEpochTime + 43200) % 86400 <
+            interval;
+#ifdef MS_LOGGER_DRIFT_SYNC
+        noonSync = noonSync && checkClockSyncDue();
+#endif
+#ifdef MS_PUBLISHER_DATE_SYNC
+        // Skip the sync while the receivers give their time
+        noonSync = noonSync &&
+            (_lastServerTime == 0 ||
+             Logger::markedUTCEpochTime - _lastServerTime > 86400L);
+#endif
+        if (noonSync || !isRTCSane(Logger::markedLocalEpochTime)) {
+            MS_DBG(F("Running a daily clock sync..."));
+            MS_PROFILE_START(SPAN_TIME_SYNC);
+            setRTClock(_logModem->getNISTTime());
+            MS_PROFILE_END(SPAN_TIME_SYNC);
+            watchDogTimer.resetWatchDog();
+        }
+
+        MS_DBG(F("Updating modem metadata..."));
+        _logModem->updateModemMetadata();
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+        dataPublisher::closeKeptConnection();
+#endif
+#ifndef MS_MODEM_WARM_STANDBY
+        // In warm standby, the modem is only disconnected if it's powered down
+        MS_DBG(F("Disconnecting from the Internet..."));
+        _logModem->disconnectInternet();
+#endif
+    } else {
+        MS_DBG(F("Could not connect to the internet!"));
+    }
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+    updateConnectBackoff(connected);
+#endif
+
+    // Turn the modem off
+    MS_PROFILE_START(SPAN_MODEM_SLEEP);
+#ifdef MS_MODEM_WARM_STANDBY
+    // or leave it registered if the next publish is soon enough
+    uint32_t nowLocal = getNowLocalEpoch();
+    _logModem->modemStandby((getNextPublishTime(nowLocal) - nowLocal) * 1000UL,
+                            connected);
+#else
+    _logModem->modemSleepPowerDown();
+#endif
+    MS_PROFILE_END(SPAN_MODEM_SLEEP);
+#ifndef MS_LOGGER_PERSISTENT_SD
+    turnOffSDcard(false);
+#endif
+
+    alertOff();
+    PRINTOUT(F("------------------------------------------\n"));
+    Logger::isLoggingNow = false;
+}
+#endif
+
+// This sends the waiting records in the outbox, oldest first
+uint16_t Logger::replayOutbox(uint8_t skip) {
+    if (!openOutbox()) { return 0; }
+
+    uint32_t head;
+    outboxFile.seekSet(0);
+    outboxFile.read(&head, sizeof(head));
+    if (head >= outboxFile.fileSize()) {
+        outboxFile.close();
+        return 0;
+    }
+
+    // Publishers can't be sent anything that isn't registered
+    uint8_t registered = 0;
+    for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+        if (dataPublishers[i] != nullptr) { registered |= 1 << i; }
+    }
+
+    // The marked time is replaced by each record's time while it's sent
+    uint32_t      markedUTC   = Logger::markedUTCEpochTime;
+    uint32_t      markedLocal = Logger::markedLocalEpochTime;
+    loggerRecord* cycleRecord = _record;
+    float         values[getArrayVarCount()];
+    loggerRecord  replayRecord = {0, RECORD_FROM_OUTBOX, getArrayVarCount(),
+                                  values};
+    uint16_t      recordSize   = sizeof(uint32_t) + 1 + sizeof(values);
+    uint32_t      positions[MS_OUTBOX_BATCH_SIZE];
+    uint8_t       pending[MS_OUTBOX_BATCH_SIZE];
+    uint32_t      sendPositions[MS_OUTBOX_BATCH_SIZE];
+    uint32_t      pos        = head;
+    bool          headMoving = true;
+    uint16_t      sent       = 0;
+    uint32_t      start      = millis();
+    _record                  = &replayRecord;
+    _replayPositions         = sendPositions;
+
+    PRINTOUT(F("\nSending queued data from the outbox"));
+    while ((registered & ~skip) != 0 &&
+           millis() - start < _outboxBudget * 1000UL) {
+        // Collect the next batch of records that are still waiting
+        uint8_t batchCount = 0;
+        while (batchCount < MS_OUTBOX_BATCH_SIZE && outboxFile.seekSet(pos) &&
+               outboxFile.fileSize() >= pos + recordSize) {
+            outboxFile.seekSet(pos + sizeof(uint32_t));
+            uint8_t waiting = outboxFile.read();
+            // Forget publishers that have since been removed
+            if ((waiting & registered) != 0) {
+                positions[batchCount] = pos;
+                pending[batchCount]   = waiting & registered;
+                batchCount++;
+            }
+            pos += recordSize;
+        }
+        if (batchCount == 0) { break; }
+
+        for (uint8_t i = 0; i < MAX_NUMBER_SENDERS; i++) {
+            uint8_t bit = 1 << i;
+            if (skip & bit) { continue; }
+            // Publishers that take batches get all of their waiting records
+            // at once, the others get one at a time
+            uint8_t perRequest = dataPublishers[i] != nullptr &&
+                    dataPublishers[i]->publishesBatches()
+                ? MS_OUTBOX_BATCH_SIZE
+                : 1;
+            uint8_t j = 0;
+            while (j < batchCount && !(skip & bit) &&
+                   millis() - start < _outboxBudget * 1000UL) {
+                // Gather the records for one request
+                uint8_t first = j;
+                _replayCount  = 0;
+                for (; j < batchCount && _replayCount < perRequest; j++) {
+                    if (pending[j] & bit) {
+                        sendPositions[_replayCount++] = positions[j];
+                    }
+                }
+                if (_replayCount == 0 || !loadReplayRecord(0)) { continue; }
+                PRINTOUT(F("Sending"), _replayCount,
+                         F("queued records to ["), i, F("]"),
+                         dataPublishers[i]->getEndpoint());
+                int16_t result = dataPublishers[i]->publishData();
+                if (dataPublishers[i]->publishSucceeded(result)) {
+                    for (uint8_t k = first; k < j; k++) { pending[k] &= ~bit; }
+                } else {
+                    // Don't try this publisher again until the next connection
+                    skip |= bit;
+                }
+                watchDogTimer.resetWatchDog();
+            }
+        }
+        _replayCount = 0;
+
+        // Save what was sent
+        for (uint8_t j = 0; j < batchCount; j++) {
+            outboxFile.seekSet(positions[j] + sizeof(uint32_t));
+            outboxFile.write(pending[j]);
+            if (pending[j] == 0) { sent++; }
+            // The oldest waiting record only moves past records nobody needs
+            if (headMoving && pending[j] != 0) {
+                head       = positions[j];
+                headMoving = false;
+            }
+        }
+        if (headMoving) { head = pos; }
+        outboxFile.seekSet(0);
+        outboxFile.write(reinterpret_cast<const uint8_t*>(&head), sizeof(head));
+        outboxFile.sync();
+    }
+    _record                      = cycleRecord;
+    _replayPositions             = nullptr;
+    Logger::markedUTCEpochTime   = markedUTC;
+    Logger::markedLocalEpochTime = markedLocal;
+
+    if (head >= outboxFile.fileSize()) {
+        // Everything has been sent, start the outbox over
+        head = outboxHeaderSize;
+        outboxFile.truncate(outboxHeaderSize);
+        outboxFile.seekSet(0);
+        outboxFile.write(reinterpret_cast<const uint8_t*>(&head),
+                         sizeof(head));
+    }
+    outboxFile.close();
+    PRINTOUT(sent, F("queued records were sent"));
+    return sent;
+}
+#endif
+
+
+// ===================================================================== //
+// Public functions to access the clock in proper format and time zone
+// ===================================================================== //
+
+// Sets the static timezone that the data will be logged in - this must be set
+void Logger::setLoggerTimeZone(int8_t timeZone) {
+    _loggerTimeZone = timeZone;
+    // The ISO8601 text of the marked time has the old time zone
+    _markedTimeCSV[0] = '\0';
+// Some helpful prints for debugging
+#ifdef STANDARD_SERIAL_OUTPUT
+    const char* prtout1 = "Logger timezone is set to UTC";
+    if (_loggerTimeZone == 0) {
+        PRINTOUT(prtout1);
+    } else if (_loggerTimeZone > 0) {
+        PRINTOUT(prtout1, '+', _loggerTimeZone);
+    } else {
+        PRINTOUT(prtout1, _loggerTimeZone);
+    }
+#endif
 }
 int8_t Logger::getLoggerTimeZone(void) {
     return Logger::_loggerTimeZone;
@@ -438,22 +2008,54 @@ uint32_t Logger::getNowLocalEpoch(void) {
     return currentEpochTime;
 }
 
+#ifdef MS_LOGGER_CACHE_RTC
+// Count on from the last read of the clock, reading it again when the count
+// can't be trusted anymore
+uint32_t Logger::getNowUTCEpoch(void) {
+    uint32_t sinceRead = millis() - _rtcCacheMillis;
+    if (!_rtcCacheValid || sinceRead >= MS_RTC_CACHE_MAX_AGE_MS) {
+        _rtcCacheEpoch  = readRTCUTCEpoch();
+        _rtcCacheMillis = millis();
+        _rtcCacheValid  = true;
+        return _rtcCacheEpoch;
+    }
+    return _rtcCacheEpoch + sinceRead / 1000;
+}
+void Logger::resyncRTCCache(void) {
+    _rtcCacheValid = false;
+}
+#endif
+
 #if defined(MS_SAMD_DS3231) || not defined(ARDUINO_ARCH_SAMD)
 
+#ifdef MS_LOGGER_CACHE_RTC
+uint32_t Logger::readRTCUTCEpoch(void) {
+#else
 uint32_t Logger::getNowUTCEpoch(void) {
+#endif
     return rtc.now().getEpoch();
 }
 void Logger::setNowUTCEpoch(uint32_t ts) {
     rtc.setEpoch(ts);
+#ifdef MS_LOGGER_CACHE_RTC
+    resyncRTCCache();
+#endif
 }
 
 #elif defined ARDUINO_ARCH_SAMD
 
+#ifdef MS_LOGGER_CACHE_RTC
+uint32_t Logger::readRTCUTCEpoch(void) {
+#else
 uint32_t Logger::getNowUTCEpoch(void) {
+#endif
     return zero_sleep_rtc.getEpoch();
 }
 void Logger::setNowUTCEpoch(uint32_t ts) {
     zero_sleep_rtc.setEpoch(ts);
+#ifdef MS_LOGGER_CACHE_RTC
+    resyncRTCCache();
+#endif
 }
 
 #endif
@@ -503,6 +2105,17 @@ String Logger::formatDateTime_ISO8601(uint32_t epochTime) {
 }
 
 
+#ifdef MS_PUBLISHER_DATE_SYNC
+// This sets the clock from a receiver's time if it's too far off
+void Logger::syncFromServerTime(uint32_t UTCEpochSeconds) {
+    _lastServerTime = UTCEpochSeconds;
+    int32_t offset  = static_cast<int32_t>(UTCEpochSeconds - getNowUTCEpoch());
+    MS_DBG(F("The receiver's time is"), offset, F("s from the RTC"));
+    if (abs(offset) > MS_DATE_SYNC_TOLERANCE) { setRTClock(UTCEpochSeconds); }
+}
+#endif
+
+
 // This sets the real time clock to the given time
 bool Logger::setRTClock(uint32_t UTCEpochSeconds) {
     // If the timestamp is zero, just exit
@@ -535,7 +2148,19 @@ bool Logger::setRTClock(uint32_t UTCEpochSeconds) {
     // seconds (not milliseconds or less), I don't think this is a problem.
 
     // If the RTC and NIST disagree by more than 5 seconds, set the clock
-    if (abs(set_logTZ - cur_logTZ) > 5) {
+    bool clockSet = abs(set_logTZ - cur_logTZ) > 5;
+#ifdef MS_LOGGER_DRIFT_SYNC
+    // A clock that wasn't sane hasn't been running on the last time it was
+    // given
+    if (isRTCSane(cur_logTZ)) {
+        updateClockDrift(UTCEpochSeconds,
+                         static_cast<int32_t>(set_logTZ - cur_logTZ),
+                         clockSet);
+    } else {
+        _driftReference = UTCEpochSeconds;
+    }
+#endif
+    if (clockSet) {
         setNowUTCEpoch(set_rtcTZ);
         PRINTOUT(F("Clock set!"));
         return true;
@@ -545,6 +2170,54 @@ bool Logger::setRTClock(uint32_t UTCEpochSeconds) {
     }
 }
 
+#ifdef MS_LOGGER_DRIFT_SYNC
+void Logger::setClockSyncTolerance(uint16_t toleranceSeconds,
+                                   uint16_t maxDays) {
+    _syncTolerance = toleranceSeconds;
+    _maxSyncDays   = maxDays;
+}
+
+// Protected helper function - This checks if the clock should be synced yet
+bool Logger::checkClockSyncDue(void) {
+    uint32_t now = Logger::markedUTCEpochTime;
+    // If the clock was set back, don't wait longer than the maximum
+    if (_nextClockSync == 0 || now >= _nextClockSync ||
+        _nextClockSync - now > static_cast<uint32_t>(_maxSyncDays) * 86400) {
+        return true;
+    }
+    MS_DBG(F("Not syncing the clock for another"),
+           (_nextClockSync - now) / 3600, F("hours"));
+    return false;
+}
+
+// Protected helper function - This estimates the drift of the clock and puts
+// off the next sync until it's expected to be off by the tolerance
+void Logger::updateClockDrift(uint32_t UTCEpochSeconds, int32_t offset,
+                              bool clockSet) {
+    if (_driftReference != 0 && UTCEpochSeconds > _driftReference) {
+        uint32_t elapsed = UTCEpochSeconds - _driftReference;
+        MS_DBG(F("Clock drifted"), offset, F("seconds in"), elapsed,
+               F("seconds, or"), 1000000.0 * offset / elapsed, F("ppm"));
+        // Add a second for the resolution of the clock
+        _driftRate = (abs(offset) + 1.0) / elapsed;
+    }
+    // The drift is measured from the last time the clock was set
+    if (clockSet || _driftReference == 0) { _driftReference = UTCEpochSeconds; }
+
+    uint32_t maxWait = static_cast<uint32_t>(_maxSyncDays) * 86400;
+    uint32_t wait    = 86400;
+    if (_driftRate > 0) {
+        float untilTolerance = _syncTolerance / _driftRate;
+        wait = untilTolerance < maxWait ? untilTolerance : maxWait;
+        // Count from the reference, but always wait at least a day
+        wait -= min(wait, UTCEpochSeconds - _driftReference);
+        if (wait < 86400) { wait = 86400; }
+    }
+    _nextClockSync = UTCEpochSeconds + wait;
+    PRINTOUT(F("Next clock sync in"), wait / 86400, F("days"));
+}
+#endif
+
 // This checks that the logger time is within a "sane" range
 bool Logger::isRTCSane(void) {
     uint32_t curRTC = getNowLocalEpoch();
@@ -568,26 +2241,79 @@ bool Logger::isRTCSane(uint32_t epochTime) {
 // sensor was updated, just a single marked time.  By custom, this should be
 // called before updating the sensors, not after.
 void Logger::markTime(void) {
+#ifdef MS_LOGGER_RESULT_TIMES
+    _markedMillis = millis();
+#endif
     Logger::markedUTCEpochTime   = getNowUTCEpoch();
     Logger::markedLocalEpochTime = markedUTCEpochTime +
         ((uint32_t)_loggerRTCOffset) * 3600;
+    formatMarkedTime();
 }
 
 
-// This checks to see if the CURRENT time is an even interval of the logging
+// This writes the marked time as text for all of the data outputs to share,
+// so it isn't made again with Strings by every one of them
+void Logger::formatMarkedTime(void) {
+    DateTime dt = dtFromEpoch(Logger::markedLocalEpochTime);
+    snprintf(_markedTimeCSV, sizeof(_markedTimeCSV),
+             "%04u-%02u-%02u %02u:%02u:%02u", dt.year(), dt.month(),
+             dt.date(), dt.hour(), dt.minute(), dt.second());
+    memcpy(_markedTimeISO8601, _markedTimeCSV, 19);
+    _markedTimeISO8601[10] = 'T';
+    if (_loggerTimeZone == 0) {
+        strcpy(_markedTimeISO8601 + 19, "Z");
+    } else {
+        snprintf(_markedTimeISO8601 + 19, sizeof(_markedTimeISO8601) - 19,
+                 "%+03d:00", _loggerTimeZone);
+    }
+    _markedTimeFormatted = Logger::markedLocalEpochTime;
+}
+// These return the shared text, making it again if the marked time was
+// changed without markTime()
+const char* Logger::getMarkedTimeISO8601(void) {
+    if (_markedTimeCSV[0] == '\0' ||
+        _markedTimeFormatted != Logger::markedLocalEpochTime) {
+        formatMarkedTime();
+    }
+    return _markedTimeISO8601;
+}
+const char* Logger::getMarkedTimeCSV(void) {
+    if (_markedTimeCSV[0] == '\0' ||
+        _markedTimeFormatted != Logger::markedLocalEpochTime) {
+        formatMarkedTime();
+    }
+    return _markedTimeCSV;
+}
+
+
+// This checks to see if the CURRENT time is an even interval of the logging
 // rate
 bool Logger::checkInterval(void) {
     bool     retval;
     uint32_t checkTime = getNowLocalEpoch();
+#ifdef MS_LOGGER_PREWAKE
+    // A pre-wake counts as the start of the interval it's ahead of, by the
+    // lead the alarm was set with
+    uint32_t lead = _alarmLead != 0xFFFFFFFF ? _alarmLead : getPrewakeLead();
+    checkTime += lead;
+#endif
     MS_DBG(F("Current Unix Timestamp:"), checkTime, F("->"),
            formatDateTime_ISO8601(checkTime));
-    MS_DBG(F("Logging interval in seconds:"), (_loggingIntervalMinutes * 60));
+    MS_DBG(F("Logging interval in seconds:"), getLoggingIntervalSeconds());
     MS_DBG(F("Mod of Logging Interval:"),
-           checkTime % (_loggingIntervalMinutes * 60));
+           checkTime % getLoggingIntervalSeconds());
 
-    if (checkTime % (_loggingIntervalMinutes * 60) == 0) {
+    if (checkTime % getLoggingIntervalSeconds() == 0) {
         // Update the time variables with the current time
         markTime();
+#ifdef MS_LOGGER_PREWAKE
+        // Mark the record with the start of the interval
+        if (lead != 0) {
+            Logger::markedUTCEpochTime += lead;
+            Logger::markedLocalEpochTime += lead;
+            formatMarkedTime();
+        }
+#endif
         MS_DBG(F("Time marked at (unix):"), Logger::markedLocalEpochTime);
         MS_DBG(F("Time to log!"));
         retval = true;
@@ -647,15 +2373,55 @@ bool Logger::checkInterval(void) {
 
 
 // This checks to see if the MARKED time is an even interval of the logging rate
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+// This checks which sampling groups are due at the current or marked time
+uint8_t Logger::checkGroupIntervals(bool timeMarked) {
+    uint32_t checkTime = timeMarked ? Logger::markedLocalEpochTime
+                                    : getNowLocalEpoch();
+    uint8_t  due       = 0;
+    for (uint8_t g = 0; g < _groupCount; g++) {
+        if (checkTime % (static_cast<uint32_t>(_groupIntervals[g]) * 60) ==
+            0) {
+            due |= 1 << g;
+        }
+    }
+    if (due != 0 && !timeMarked) {
+        // Update the time variables with the current time
+        markTime();
+        MS_DBG(F("Time marked at (unix):"), Logger::markedLocalEpochTime);
+    }
+    MS_DBG(F("Sampling groups due:"), due);
+    return due;
+}
+#endif
+
+
+#ifdef MS_LOGGER_EVENT_TRIGGER
+// This checks if the current time is an even interval of the event interval
+bool Logger::checkEventInterval(void) {
+    if (_eventTrigger == nullptr) { return false; }
+    uint32_t checkTime = getNowLocalEpoch();
+    if (checkTime % (static_cast<uint32_t>(_eventInterval) * 60) != 0) {
+        return false;
+    }
+    // Update the time variables with the current time
+    markTime();
+    MS_DBG(F("Time marked at (unix):"), Logger::markedLocalEpochTime);
+    MS_DBG(F("Time to check the event trigger!"));
+    return true;
+}
+#endif
+
+
 bool Logger::checkMarkedInterval(void) {
     bool retval;
     MS_DBG(F("Marked Time:"), Logger::markedLocalEpochTime,
-           F("Logging interval in seconds:"), (_loggingIntervalMinutes * 60),
+           F("Logging interval in seconds:"), getLoggingIntervalSeconds(),
            F("Mod of Logging Interval:"),
-           Logger::markedLocalEpochTime % (_loggingIntervalMinutes * 60));
+           Logger::markedLocalEpochTime % getLoggingIntervalSeconds());
 
     if (Logger::markedLocalEpochTime != 0 &&
-        (Logger::markedLocalEpochTime % (_loggingIntervalMinutes * 60) == 0)) {
+        (Logger::markedLocalEpochTime % getLoggingIntervalSeconds() == 0)) {
         MS_DBG(F("Time to log!"));
         retval = true;
     } else {
@@ -679,6 +2445,19 @@ void Logger::wakeISR(void) {
 }
 
 
+#if defined(MS_LOGGER_SAMPLING_GROUPS) || defined(MS_LOGGER_EVENT_TRIGGER)
+// The longest interval that evenly divides both intervals
+static uint32_t greatestCommonDivisor(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        uint32_t r = a % b;
+        a          = b;
+        b          = r;
+    }
+    return a;
+}
+#endif
+
+
 // Puts the system to sleep to conserve battery life.
 // This DOES NOT sleep or wake the sensors!!
 void Logger::systemSleep(void) {
@@ -690,6 +2469,84 @@ void Logger::systemSleep(void) {
 
     // Send a message that we're getting ready
     MS_DBG(F("Preparing processor for  sleep.  ZZzzz..."));
+#if defined(MS_DEBUG_TOKENIZED) && defined(DEBUGGING_SERIAL_OUTPUT)
+    // Write out the debugging records of this wake now that nothing is
+    // waiting on the timing
+    msTokenLog().dump(DEBUGGING_SERIAL_OUTPUT);
+    DEBUGGING_SERIAL_OUTPUT.flush();
+#endif
+
+#if defined(MS_LOGGER_SECONDS_INTERVAL) || defined(MS_LOGGER_LIGHT_SLEEP)
+    bool shortSleep = false;
+#endif
+#ifdef MS_LOGGER_SECONDS_INTERVAL
+    // Keep the I2C bus up if the logger will wake again within a minute
+    shortSleep = getLoggingIntervalSeconds() < 60;
+#endif
+
+#if defined(MS_LOGGER_INTERVAL_ALARM) || defined(MS_LOGGER_SECONDS_INTERVAL)
+    // Find the RTC time when the next logging interval starts; the intervals
+    // line up with the logger's time zone, not the RTC's.  If the clock isn't
+    // set, fall back to waking every minute.
+    uint32_t rtcNow      = getNowUTCEpoch();
+    uint32_t intervalSec = getLoggingIntervalSeconds();
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    // Wake at every start of an interval of any of the sampling groups, too
+    for (uint8_t g = 0; g < _groupCount; g++) {
+        intervalSec = greatestCommonDivisor(
+            intervalSec, static_cast<uint32_t>(_groupIntervals[g]) * 60);
+    }
+#endif
+#ifdef MS_LOGGER_EVENT_TRIGGER
+    // Wake at every event interval to check the trigger
+    if (_eventTrigger != nullptr) {
+        intervalSec = greatestCommonDivisor(
+            intervalSec, static_cast<uint32_t>(_eventInterval) * 60);
+    }
+#endif
+    uint32_t rtcOffset   = ((uint32_t)_loggerRTCOffset) * 3600;
+    uint32_t localNow    = rtcNow + rtcOffset;
+    uint32_t nextLocal   = (localNow / intervalSec + 1) * intervalSec;
+#ifdef MS_LOGGER_PREWAKE
+    // Wake ahead of the next logging interval by the lead if that comes first
+    uint32_t lead = getPrewakeLead();
+    _alarmLead    = lead;
+    if (lead != 0) {
+        uint32_t logSec  = getLoggingIntervalSeconds();
+        uint32_t prewake = ((localNow + lead) / logSec + 1) * logSec - lead;
+        if (prewake < nextLocal) { nextLocal = prewake; }
+    }
+#endif
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+    // Wake for the next publication if it comes first
+    if (_publishIntervalMinutes != 0 &&
+        getNextPublishTime(localNow) < nextLocal) {
+        nextLocal = getNextPublishTime(localNow);
+    }
+#endif
+    DateTime nextAlarm   = dtFromEpoch(nextLocal - rtcOffset);
+#ifdef MS_LOGGER_INTERVAL_ALARM
+    bool exactAlarm = isRTCSane(rtcNow);
+#else
+    // Intervals of a minute or more still use the every minute alarm
+    bool exactAlarm = isRTCSane(rtcNow) && intervalSec < 60;
+#endif
+#endif
+
+#ifdef MS_LOGGER_LIGHT_SLEEP
+    // Find how long until the alarm will wake the logger
+#if defined(MS_LOGGER_INTERVAL_ALARM) || defined(MS_LOGGER_SECONDS_INTERVAL)
+    uint32_t untilWake = exactAlarm ? nextLocal - localNow
+                                    : 60 - rtcNow % 60;
+#else
+    uint32_t untilWake = 60 - getNowUTCEpoch() % 60;
+#endif
+    bool lightSleep = untilWake <= MS_LIGHT_SLEEP_MAX_S;
+    if (lightSleep) {
+        MS_DBG(F("Waking in"), untilWake, F("s; taking a light sleep"));
+        shortSleep = true;
+    }
+#endif
 
 #if defined(MS_SAMD_DS3231) || not defined(ARDUINO_ARCH_SAMD)
 
@@ -699,13 +2556,31 @@ void Logger::systemSleep(void) {
     // the hour, but not every 5 minutes.  This is why we set the alarm for
     // every minute and use the checkInterval function.  This is a hardware
     // limitation of the DS3231; it is not due to the libraries or software.
+#if defined(MS_LOGGER_INTERVAL_ALARM) || defined(MS_LOGGER_SECONDS_INTERVAL)
+    if (exactAlarm) {
+        // Alarm 1 matches the hours, minutes, and seconds, which is enough for
+        // any interval up to a day
+        MS_DBG(F("Setting alarm on DS3231 RTC for"),
+               formatDateTime_ISO8601(nextLocal));
+        rtc.enableInterrupts(nextAlarm.hour(), nextAlarm.minute(),
+                             nextAlarm.second());
+    } else {
+        MS_DBG(F("Setting alarm on DS3231 RTC for every minute."));
+        rtc.enableInterrupts(EveryMinute);
+    }
+#else
     MS_DBG(F("Setting alarm on DS3231 RTC for every minute."));
     rtc.enableInterrupts(EveryMinute);
+#endif
 
     // Clear the last interrupt flag in the RTC status register
     // The next timed interrupt will not be sent until this is cleared
     rtc.clearINTStatus();
 
+#ifdef MS_LOGGER_LIGHT_SLEEP
+    // The interrupt is still attached from the last light sleep
+    if (!_wakeInterruptAttached) {
+#endif
     // Set up a pin to hear clock interrupt and attach the wake ISR to it
     MS_DBG(F("Enabling interrupts on pin"), _mcuWakePin);
     // Set the pin mode, although this shouldn't really need to be re-set here
@@ -732,6 +2607,9 @@ void Logger::systemSleep(void) {
     // Enable wakeup capability on pin in case being used during sleep
     EIC->WAKEUP.reg |= (1 << in);
 #endif  // defined ARDUINO_ARCH_SAMD && not defined(__SAMD51__)
+#ifdef MS_LOGGER_LIGHT_SLEEP
+    }
+#endif
 
 #elif defined ARDUINO_ARCH_SAMD
 
@@ -744,14 +2622,36 @@ void Logger::systemSleep(void) {
     // We're setting the alarm seconds to 59 and then seting it to go off
     // whenever the seconds match the 59.  I'm using 59 instead of 00
     // because there seems to be a bit of a wake-up delay
-    MS_DBG(F("Setting alarm on SAMD built-in RTC for every minute."));
     zero_sleep_rtc.attachInterrupt(wakeISR);
+#if defined(MS_LOGGER_INTERVAL_ALARM) || defined(MS_LOGGER_SECONDS_INTERVAL)
+    if (exactAlarm) {
+        // Match the full time of day, a second early for the same wake-up
+        // delay as the every minute alarm - unless the interval is so short
+        // that second may already have started
+        uint32_t early      = intervalSec < 60 ? 0 : 1;
+        DateTime earlyAlarm = dtFromEpoch(nextLocal - rtcOffset - early);
+        MS_DBG(F("Setting alarm on SAMD built-in RTC for"),
+               formatDateTime_ISO8601(nextLocal));
+        zero_sleep_rtc.setAlarmTime(earlyAlarm.hour(), earlyAlarm.minute(),
+                                    earlyAlarm.second());
+        zero_sleep_rtc.enableAlarm(zero_sleep_rtc.MATCH_HHMMSS);
+    } else {
+        MS_DBG(F("Setting alarm on SAMD built-in RTC for every minute."));
+        zero_sleep_rtc.setAlarmSeconds(59);
+        zero_sleep_rtc.enableAlarm(zero_sleep_rtc.MATCH_SS);
+    }
+#else
+    MS_DBG(F("Setting alarm on SAMD built-in RTC for every minute."));
     zero_sleep_rtc.setAlarmSeconds(59);
     zero_sleep_rtc.enableAlarm(zero_sleep_rtc.MATCH_SS);
+#endif
 
 #endif  // defined(MS_SAMD_DS3231) || not defined(ARDUINO_ARCH_SAMD)
 
 
+#if defined(MS_LOGGER_SECONDS_INTERVAL) || defined(MS_LOGGER_LIGHT_SLEEP)
+    if (!shortSleep) {
+#endif
     // Stop any I2C connections
     MS_DEEP_DBG(F("Ending I2C"));
     // This function actually disables the two-wire pin functionality and
@@ -768,6 +2668,9 @@ void Logger::systemSleep(void) {
     pinMode(SCL, OUTPUT);
     digitalWrite(SCL, LOW);
 #endif
+#if defined(MS_LOGGER_SECONDS_INTERVAL) || defined(MS_LOGGER_LIGHT_SLEEP)
+    }
+#endif
 
     // Disable the watch-dog timer
     MS_DEEP_DBG(F("Disabling the watchdog"));
@@ -926,11 +2829,18 @@ void Logger::systemSleep(void) {
 
     // Wake-up message
     MS_DBG(F("\n\n\n... zzzZZ Processor is now awake!"));
+#ifdef MS_LOGGER_CACHE_RTC
+    // The processor clock may have stopped while asleep
+    resyncRTCCache();
+#endif
 
     // Re-enable the watch-dog timer
     MS_DEEP_DBG(F("Re-enabling the watchdog"));
     watchDogTimer.enableWatchDog();
 
+#if defined(MS_LOGGER_SECONDS_INTERVAL) || defined(MS_LOGGER_LIGHT_SLEEP)
+    if (!shortSleep) {
+#endif
     // Re-start the I2C interface
     MS_DEEP_DBG(F("Restarting I2C"));
 #ifdef SDA
@@ -940,6 +2850,10 @@ void Logger::systemSleep(void) {
     pinMode(SCL, INPUT_PULLUP);
 #endif
     Wire.begin();
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+    // Starting the Wire library again put the clock back to its default
+    Sensor::forgetI2CClock();
+#endif
     // Eliminate any potential extra waits in the wire library
     // These waits would be caused by a readBytes or parseX being called
     // on wire after the Wire buffer has emptied.  The default stream
@@ -948,6 +2862,9 @@ void Logger::systemSleep(void) {
     // buffer.  In the case of the Wire library, that will never happen and
     // the timeout period is a useless delay.
     Wire.setTimeout(0);
+#if defined(MS_LOGGER_SECONDS_INTERVAL) || defined(MS_LOGGER_LIGHT_SLEEP)
+    }
+#endif
 
 #if defined(MS_SAMD_DS3231) || not defined(ARDUINO_ARCH_SAMD)
     // Stop the clock from sending out any interrupts while we're awake.
@@ -955,8 +2872,17 @@ void Logger::systemSleep(void) {
     // happens while the processor is awake and doing other things.
     MS_DEEP_DBG(F("Unsetting the alarm on the DS2321"));
     rtc.disableInterrupts();
+#ifdef MS_LOGGER_LIGHT_SLEEP
+    // After a light sleep, leave the pin interrupt attached for the next sleep;
+    // with the alarm off it won't fire in the meantime
+    _wakeInterruptAttached = lightSleep;
+    if (!lightSleep) {
+#endif
     // Detach the from the pin
     disableInterrupt(_mcuWakePin);
+#ifdef MS_LOGGER_LIGHT_SLEEP
+    }
+#endif
 
 #elif defined ARDUINO_ARCH_SAMD
     MS_DEEP_DBG(F("Unsetting the alarm on the built in RTC"));
@@ -975,6 +2901,14 @@ void Logger::systemSleep(void) {
 // This sets a file name, if you want to decide on it in advance
 void Logger::setFileName(String& fileName) {
     _fileName = fileName;
+#ifdef MS_LOGGER_FILE_ROTATION
+    _autoFileName  = false;
+    _indexEntryPos = -1;
+#endif
+#ifdef MS_LOGGER_WARM_BOOT
+    // Keep logging to the new file after a reset
+    saveBootRecord();
+#endif
 }
 // Same as above, with a character array (overload function)
 void Logger::setFileName(const char* fileName) {
@@ -986,23 +2920,177 @@ void Logger::setFileName(const char* fileName) {
 // This generates a file name from the logger id and the current date
 // This will be used if the setFileName function is not called before
 // the begin() function is called.
-void Logger::generateAutoFileName(void) {
+void Logger::generateAutoFileName(uint8_t sequence) {
     // Generate the file name from logger ID and date
     auto fileName = String(_loggerID);
     fileName += "_";
     fileName += formatDateTime_ISO8601(getNowLocalEpoch()).substring(0, 10);
+    if (sequence > 0) {
+        fileName += "_";
+        fileName += sequence;
+    }
+#ifdef MS_LOGGER_BINARY_FORMAT
+    fileName += ".bin";
+#else
     fileName += ".csv";
+#endif
     setFileName(fileName);
     _fileName = fileName;
+#ifdef MS_LOGGER_FILE_ROTATION
+    _autoFileName = true;
+#ifdef MS_LOGGER_WARM_BOOT
+    saveBootRecord();
+#endif
+#endif
+}
+
+
+#ifdef MS_LOGGER_FILE_ROTATION
+void Logger::setLogRotation(uint32_t maxFileSize, bool daily) {
+    _rotateFileSize = maxFileSize;
+    _rotateDaily    = daily;
+}
+
+// Checks if a file on the SD card has reached the largest log file size
+static bool logFileIsFull(String& fileName, uint32_t maxFileSize,
+                          File& openFile) {
+    if (maxFileSize == 0) { return false; }
+#ifdef MS_LOGGER_PERSISTENT_SD
+    // The open file is preallocated, so its data ends at the write position
+    if (openFile.isOpen()) {
+        char openFileName[fileName.length() + 2];
+        openFile.getName(openFileName, sizeof(openFileName));
+        if (strcmp(openFileName, fileName.c_str()) == 0) {
+            return openFile.curPosition() >= maxFileSize;
+        }
+    }
+#else
+    (void)openFile;
+#endif
+    File file;
+    if (!file.open(fileName.c_str(), O_RDONLY)) { return false; }
+    bool full = file.fileSize() >= maxFileSize;
+    file.close();
+    return full;
+}
+
+// Protected helper function - This moves on to a new log file when the current
+// one is from an earlier day or is full
+void Logger::rotateLogFile(void) {
+    // File names set by the user are never changed
+    if (!_autoFileName || !initializeSDCard()) { return; }
+
+    // The date in an auto-generated name follows the logger id
+    uint16_t dateStart = strlen(_loggerID) + 1;
+    DateTime now       = dtFromEpoch(getNowLocalEpoch());
+    char     today[11];
+    snprintf(today, sizeof(today), "%04d-%02d-%02d", now.year(), now.month(),
+             now.date());
+    bool newDay = _fileName.length() < dateStart + 10U ||
+        strncmp(_fileName.c_str() + dateStart, today, 10) != 0;
+    if (!(_rotateDaily && newDay) &&
+        !logFileIsFull(_fileName, _rotateFileSize, logFile)) {
+        return;
+    }
+
+#ifdef MS_LOGGER_PERSISTENT_SD
+    // Give back the space reserved past the end of the old file
+    if (logFile.isOpen()) {
+#ifdef MS_LOGGER_SECTOR_WRITER
+        _sectorWriter.writeAll();
+#endif
+        logFile.truncate(logFile.curPosition());
+        logFile.close();
+    }
+#endif
+
+    // Use the first of today's names that isn't full yet
+    uint8_t sequence = 0;
+    do {
+        generateAutoFileName(sequence);
+    } while (logFileIsFull(_fileName, _rotateFileSize, logFile) &&
+             ++sequence != 0);
+    PRINTOUT(F("Data will now be saved as"), _fileName);
+}
+
+// Protected helper function - This updates the current file's line in the
+// index file
+bool Logger::updateLogIndex(uint32_t firstTime, uint32_t lastTime,
+                            uint16_t records) {
+    char indexName[strlen(_loggerID) + sizeof(MS_LOG_INDEX_SUFFIX)];
+    strcpy(indexName, _loggerID);
+    strcat(indexName, MS_LOG_INDEX_SUFFIX);
+    File indexFile;
+    if (!indexFile.open(indexName, O_RDWR | O_CREAT)) {
+        MS_DBG(F("Unable to open the index file"), indexName);
+        return false;
+    }
+
+    // Each line is the first time, last time, and record count as 10 digit
+    // numbers, and then the file name
+    const uint8_t nameStart = 33;
+    char          line[nameStart + 64];
+
+    if (_indexEntryPos < 0) {
+        // Look for a line left for this file before a restart
+        _fileRecordCount = 0;
+        if (indexFile.fileSize() == 0) {
+            indexFile.println(
+                F("first_record_time,last_record_time,record_count,file_name"));
+        }
+        uint32_t pos = indexFile.curPosition();
+        while (indexFile.fgets(line, sizeof(line)) > 0) {
+            line[strcspn(line, "\r\n")] = '\0';
+            if (strlen(line) > nameStart &&
+                strcmp(line + nameStart, _fileName.c_str()) == 0) {
+                _fileFirstTime   = strtoul(line, nullptr, 10);
+                _fileLastTime    = strtoul(line + 11, nullptr, 10);
+                _fileRecordCount = strtoul(line + 22, nullptr, 10);
+                break;
+            }
+            pos = indexFile.curPosition();
+        }
+        _indexEntryPos = pos;
+    }
+
+    if (_fileRecordCount == 0) { _fileFirstTime = firstTime; }
+    _fileLastTime = lastTime;
+    _fileRecordCount += records;
+    snprintf(line, sizeof(line), "%010lu,%010lu,%010lu,%s",
+             static_cast<unsigned long>(_fileFirstTime),
+             static_cast<unsigned long>(_fileLastTime),
+             static_cast<unsigned long>(_fileRecordCount), _fileName.c_str());
+
+    // The line is always the same length, so it can be written over
+    indexFile.seekSet(_indexEntryPos);
+    indexFile.println(line);
+    setFileTimestamp(indexFile, T_WRITE);
+    return indexFile.close();
 }
+#endif
+
 
+#if defined(MS_LOGGER_RESULT_TIMES) && !defined(MS_LOGGER_BINARY_FORMAT)
+/**
+ * @brief This is a PRE-PROCESSOR MACRO adding a header column for the result
+ * time of each unique sensor
+ */
+#define STREAM_CSV_SENSOR_COLUMNS(sensorFunction)                        \
+    for (uint8_t s = 0; s < _internalArray->getSensorListCount(); s++) { \
+        stream->print(",\"");                                            \
+        stream->print(sensorFunction);                                   \
+        stream->print("\"");                                             \
+    }
+#else
+#define STREAM_CSV_SENSOR_COLUMNS(sensorFunction)
+#endif
 
 /**
  * @brief This is a PRE-PROCESSOR MACRO to speed up generating header rows
  *
  * THIS IS NOT A FUNCTION, it is a pre-processor macro
  */
-#define STREAM_CSV_ROW(firstCol, function)                       \
+#define STREAM_CSV_ROW(firstCol, function, sensorFunction)       \
     stream->print("\"");                                         \
     stream->print(firstCol);                                     \
     stream->print("\",");                                        \
@@ -1012,6 +3100,7 @@ void Logger::generateAutoFileName(void) {
         stream->print("\"");                                     \
         if (i + 1 != getArrayVarCount()) { stream->print(","); } \
     }                                                            \
+    STREAM_CSV_SENSOR_COLUMNS(sensorFunction)                    \
     stream->println();
 
 // This sends a file header out over an Arduino stream
@@ -1031,45 +3120,248 @@ void Logger::printFileHeader(Stream* stream) {
         stream->println(',');
     }
 
+#ifdef MS_LOGGER_HEADER_CACHE
+    // The rest is the same for every file of the same variable array
+    if (_headerCacheLength > 0 && _internalArray == _headerCacheArray) {
+        stream->write(reinterpret_cast<const uint8_t*>(_headerCache),
+                      _headerCacheLength);
+        return;
+    }
+#endif
+    printFileHeaderRows(stream);
+}
+
+
+// This prints the rows of the header that are the same for every file
+void Logger::printFileHeaderRows(Print* stream) {
     // Next line will be the parent sensor names
-    STREAM_CSV_ROW(F("Sensor Name:"), getParentSensorNameAtI(i))
+    STREAM_CSV_ROW(F("Sensor Name:"), getParentSensorNameCharsAtI(i),
+                   _internalArray->getListedSensor(s)->getSensorNameChars())
     // Next comes the ODM2 variable name
-    STREAM_CSV_ROW(F("Variable Name:"), getVarNameAtI(i))
+    STREAM_CSV_ROW(F("Variable Name:"), getVarNameCharsAtI(i),
+                   F("resultTimeOffset"))
     // Next comes the ODM2 unit name
-    STREAM_CSV_ROW(F("Result Unit:"), getVarUnitAtI(i))
+    STREAM_CSV_ROW(F("Result Unit:"), getVarUnitCharsAtI(i), F("millisecond"))
     // Next comes the variable UUIDs
     // We'll only add UUID's if we see a UUID for the first variable
-    if (getVarUUIDAtI(0).length() > 1) {
-        STREAM_CSV_ROW(F("Result UUID:"), getVarUUIDAtI(i))
+    if (strlen(getVarUUIDCharsAtI(0)) > 1) {
+        STREAM_CSV_ROW(F("Result UUID:"), getVarUUIDCharsAtI(i), "")
     }
 
     // We'll finish up the the custom variable codes
-    String dtRowHeader = F("Date and Time in UTC");
-    if (_loggerTimeZone > 0) {
-        dtRowHeader += '+' + _loggerTimeZone;
-    } else if (_loggerTimeZone < 0) {
-        dtRowHeader += _loggerTimeZone;
+    char dtRowHeader[26] = "Date and Time in UTC";
+    if (_loggerTimeZone > 0) { strcat(dtRowHeader, "+"); }
+    if (_loggerTimeZone != 0) {
+        itoa(_loggerTimeZone, dtRowHeader + strlen(dtRowHeader), 10);
+    }
+    STREAM_CSV_ROW(dtRowHeader, getVarCodeCharsAtI(i), F("resultTimeMs"))
+}
+
+
+#ifdef MS_LOGGER_HEADER_CACHE
+// Prints into the header cache, noting if it overflows
+class headerCachePrinter : public Print {
+ public:
+    headerCachePrinter(char* buffer, uint16_t size)
+        : _buffer(buffer),
+          _size(size) {}
+    // Keeps counting past the end, so the size needed is known
+    size_t write(uint8_t c) override {
+        if (_length < _size) { _buffer[_length] = c; }
+        _length++;
+        return 1;
+    }
+    char*    _buffer;
+    uint16_t _size;
+    uint32_t _length = 0;
+};
+
+// Protected helper function - This makes the header rows once
+void Logger::buildHeaderCache(void) {
+    headerCachePrinter printer(_headerCache, MS_LOGGER_HEADER_CACHE_SIZE);
+    printFileHeaderRows(&printer);
+    _headerCacheArray = _internalArray;
+    if (printer._length > MS_LOGGER_HEADER_CACHE_SIZE) {
+        _headerCacheLength = 0;
+        PRINTOUT(F("The file header needs MS_LOGGER_HEADER_CACHE_SIZE of"),
+                 printer._length, F("bytes to be cached"));
+    } else {
+        _headerCacheLength = printer._length;
     }
-    STREAM_CSV_ROW(dtRowHeader, getVarCodeAtI(i))
 }
+#endif
 
 
 // This prints a comma separated list of volues of sensor data - including the
 // time -  out over an Arduino stream
 void Logger::printSensorDataCSV(Stream* stream) {
-    String csvString = "";
-    dtFromEpoch(Logger::markedLocalEpochTime).addToString(csvString);
-    csvString += ',';
-    stream->print(csvString);
+    stream->print(getMarkedTimeCSV());
+    stream->print(',');
     for (uint8_t i = 0; i < getArrayVarCount(); i++) {
-        stream->print(getValueStringAtI(i));
+        stream->print(getValueCharsAtI(i));
         if (i + 1 != getArrayVarCount()) { stream->print(','); }
     }
+#if defined(MS_LOGGER_RESULT_TIMES) && !defined(MS_LOGGER_BINARY_FORMAT)
+    for (uint8_t s = 0; s < _internalArray->getSensorListCount(); s++) {
+        stream->print(',');
+        stream->print(getResultOffsetAtS(s));
+    }
+#endif
     stream->println();
 }
 
+
+// Copies text into a record, returning false if it doesn't fit
+static bool appendRecordText(char* buffer, uint16_t size, uint16_t& pos,
+                             const char* text) {
+    size_t len = strlen(text);
+    if (pos + len > size) { return false; }
+    memcpy(buffer + pos, text, len);
+    pos += len;
+    return true;
+}
+
+// This writes the same comma separated record into a character buffer
+uint16_t Logger::formatSensorDataCSV(char* buffer, uint16_t size) {
+    uint16_t pos = 0;
+    if (!appendRecordText(buffer, size, pos, getMarkedTimeCSV()) ||
+        !appendRecordText(buffer, size, pos, ",")) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        if (!appendRecordText(buffer, size, pos, getValueCharsAtI(i))) {
+            return 0;
+        }
+        if (i + 1 != getArrayVarCount() &&
+            !appendRecordText(buffer, size, pos, ",")) {
+            return 0;
+        }
+    }
+#if defined(MS_LOGGER_RESULT_TIMES) && !defined(MS_LOGGER_BINARY_FORMAT)
+    for (uint8_t s = 0; s < _internalArray->getSensorListCount(); s++) {
+        char offset[13] = ",";
+        ltoa(getResultOffsetAtS(s), offset + 1, 10);
+        if (!appendRecordText(buffer, size, pos, offset)) { return 0; }
+    }
+#endif
+    // End the line the same way println does
+    if (!appendRecordText(buffer, size, pos, "\r\n")) { return 0; }
+    return pos;
+}
+
+
+#ifndef MS_LOGGER_BINARY_FORMAT
+// The buffer each csv record is made in once for all of the places it's
+// written to
+static char recordLine[MS_LOGGER_LINE_BUFFER_SIZE];
+
+// Protected helper function - This writes the record in the line buffer with
+// a single write, or prints it again if it didn't fit
+void Logger::printRecordLine(Stream* stream, uint16_t lineLength) {
+    if (lineLength > 0) {
+        stream->write(reinterpret_cast<const uint8_t*>(recordLine),
+                      lineLength);
+    } else {
+        printSensorDataCSV(stream);
+    }
+}
+#endif
+
+
+// This sends the header of a binary file out over an Arduino stream
+void Logger::printBinaryFileHeader(Stream* stream) {
+    stream->print(F(MS_BINARY_LOG_MAGIC));
+    stream->write(static_cast<uint8_t>(MS_BINARY_LOG_VERSION));
+    stream->write(getArrayVarCount());
+    // The metadata is the same text as the header of a csv file
+    printFileHeader(stream);
+    stream->write(static_cast<uint8_t>(0));
+    // The converter needs the resolutions to format the values
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        stream->write(_internalArray->arrayOfVars[i]->getResolution());
+    }
+#ifdef MS_LOGGER_DELTA_ENCODING
+    stream->write(static_cast<uint8_t>(MS_DELTA_KEYFRAME_INTERVAL));
+    // A new file has to start with a keyframe
+    _deltaArray = nullptr;
+#endif
+}
+
+
+// This writes the time and values of sensor data as binary out over an Arduino
+// stream
+void Logger::writeSensorDataBinary(Stream* stream) {
+#ifdef MS_LOGGER_DELTA_ENCODING
+    float   values[getArrayVarCount()];
+    uint8_t record[6 + 5 * getArrayVarCount()];
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        values[i] = getRecordValueAtI(i);
+    }
+    uint16_t recordLength = encodeDeltaRecord(
+        record, Logger::markedLocalEpochTime, values);
+    if (stream->write(record, recordLength) != recordLength) {
+        // The next record can't be a delta from one that isn't in the file
+        _deltaArray = nullptr;
+    }
+    return;
+#endif
+    uint32_t recordTime = Logger::markedLocalEpochTime;
+    stream->write(reinterpret_cast<const uint8_t*>(&recordTime),
+                  sizeof(recordTime));
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        float value = getRecordValueAtI(i);
+        stream->write(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+    }
+}
+
+#ifdef MS_LOGGER_DELTA_ENCODING
+// Protected helper function - This encodes a record as a keyframe or as deltas
+uint16_t Logger::encodeDeltaRecord(uint8_t* buffer, uint32_t recordTime,
+                                   const float* values) {
+    uint8_t  varCount = getArrayVarCount();
+    bool     keyframe = _deltaArray != _internalArray ||
+        _deltaSinceKeyframe + 1 >= MS_DELTA_KEYFRAME_INTERVAL ||
+        varCount > MS_DELTA_MAX_VARIABLES;
+    uint16_t length   = 0;
+    if (keyframe) {
+        buffer[length++] = 'K';
+        memcpy(buffer + length, &recordTime, sizeof(recordTime));
+        length += sizeof(recordTime);
+        _deltaSinceKeyframe = 0;
+    } else {
+        buffer[length++] = 'D';
+        length += DeltaEncoding::putVarint(
+            buffer + length,
+            DeltaEncoding::zigzag(
+                static_cast<int32_t>(recordTime - _deltaLastTime)));
+        _deltaSinceKeyframe++;
+    }
+    for (uint8_t i = 0; i < varCount; i++) {
+        int32_t whole = DeltaEncoding::wholeValue(
+            values[i], _internalArray->arrayOfVars[i]->getResolution());
+        int32_t change = whole;
+        if (!keyframe) {
+            // Wrap around rather than overflow
+            change = static_cast<int32_t>(
+                static_cast<uint32_t>(whole) -
+                static_cast<uint32_t>(_deltaLastValues[i]));
+        }
+        length += DeltaEncoding::putVarint(buffer + length,
+                                           DeltaEncoding::zigzag(change));
+        if (i < MS_DELTA_MAX_VARIABLES) { _deltaLastValues[i] = whole; }
+    }
+    _deltaArray    = _internalArray;
+    _deltaLastTime = recordTime;
+    return length;
+}
+#endif
+
 // Protected helper function - This checks if the SD card is available and ready
 bool Logger::initializeSDCard(void) {
+#if defined(MS_LOGGER_PERSISTENT_SD) || defined(MS_LOGGER_SHARED_SD)
+    // Don't mount the card again if it's still mounted
+    if (_sdMounted) { return true; }
+#endif
     // If we don't know the slave select of the sd card, we can't use it
     if (_SDCardSSPin < 0) {
         PRINTOUT(F("Slave/Chip select pin for SD card has not been set."));
@@ -1077,7 +3369,13 @@ bool Logger::initializeSDCard(void) {
         return false;
     }
     // Initialise the SD card
+#if defined(MS_LOGGER_SD_DMA) && defined(ARDUINO_ARCH_SAMD)
+    // The card shares the bus, so the driver takes it for each transaction
+    if (!sd.begin(SdSpiConfig(_SDCardSSPin, SHARED_SPI, SPI_FULL_SPEED,
+                              &_sdSpiDriver))) {
+#else
     if (!sd.begin(_SDCardSSPin, SPI_FULL_SPEED)) {
+#endif
         PRINTOUT(F("Error: SD card failed to initialize or is missing."));
         PRINTOUT(F("Data will not be saved!"));
         return false;
@@ -1086,6 +3384,12 @@ bool Logger::initializeSDCard(void) {
         MS_DBG(F("Successfully connected to SD Card with card/slave select on "
                  "pin"),
                _SDCardSSPin);
+#ifdef MS_LOGGER_PERSISTENT_SD
+        _sdMounted = true;
+#elif defined(MS_LOGGER_SHARED_SD)
+        // Only the rest of the session can count on the mount
+        _sdMounted = _sdSessionOpen;
+#endif
         return true;
     }
 }
@@ -1100,6 +3404,204 @@ void Logger::setFileTimestamp(File& fileToStamp, uint8_t stampFlag) {
 }
 
 
+// Protected helper function - This saves what's been written to the log file
+bool Logger::saveLogFile(void) {
+#ifdef MS_LOGGER_PERSISTENT_SD
+    // Leave the file open for the next record, only make sure everything
+    // written so far is on the card
+#ifdef MS_LOGGER_SECTOR_WRITER
+    // The records only reach the card a batch of sectors at a time, so
+    // there's only something to sync after a batch
+    bool written = !_sectorWriter.hasFailed();
+    if (written && !_sectorWriter.takeUnsynced()) { return true; }
+    if (!written || !logFile.sync()) {
+#else
+    if (!logFile.sync()) {
+#endif
+        PRINTOUT(F("Unable to save data to SD card!"));
+        // Start over with a fresh mount next time
+        endSDSession();
+        return false;
+    }
+#ifdef MS_LOGGER_JOURNAL
+    if (logFileIsMain()) { writeJournal(logFile.curPosition()); }
+#endif
+    return true;
+#else
+#ifdef MS_LOGGER_SD_STAMP_MINUTES
+    // Only touch the directory entry for the times every so often, or with 0
+    // only at the first record after a restart
+    uint32_t now = Logger::markedUTCEpochTime;
+    if (_lastFileStamp == 0 ||
+        (MS_LOGGER_SD_STAMP_MINUTES > 0 &&
+         now - _lastFileStamp >= MS_LOGGER_SD_STAMP_MINUTES * 60UL)) {
+        _lastFileStamp = now;
+#endif
+        // Set write/modification date time
+        setFileTimestamp(logFile, T_WRITE);
+        // Set access date time
+        setFileTimestamp(logFile, T_ACCESS);
+#ifdef MS_LOGGER_SD_STAMP_MINUTES
+    }
+#endif
+#ifdef MS_LOGGER_JOURNAL
+    bool     journal   = logFileIsMain();
+    uint32_t savedSize = logFile.curPosition();
+#endif
+    // Close the file to save it
+    logFile.close();
+#ifdef MS_LOGGER_JOURNAL
+    // Only once the records are on the card
+    if (journal) { writeJournal(savedSize); }
+#endif
+    return true;
+#endif
+}
+
+
+#ifdef MS_LOGGER_JOURNAL
+// Protected helper function - This checks if the open log file is the main
+// one, rather than the file of a sampling group
+bool Logger::logFileIsMain(void) {
+    char openFileName[_fileName.length() + 2];
+    logFile.getName(openFileName, sizeof(openFileName));
+    return strcmp(openFileName, _fileName.c_str()) == 0;
+}
+
+
+// Protected helper function - This writes the saved end of the main log file
+// to the older of the two journal entries
+void Logger::writeJournal(uint32_t fileSize) {
+    char journalName[strlen(_loggerID) + sizeof(MS_JOURNAL_SUFFIX)];
+    strcpy(journalName, _loggerID);
+    strcat(journalName, MS_JOURNAL_SUFFIX);
+    File journalFile;
+    if (!journalFile.open(journalName, O_RDWR | O_CREAT)) {
+        MS_DBG(F("Unable to open the journal"), journalName);
+        return;
+    }
+    loggerJournalEntry entry;
+    entry.sequence = ++_journalSequence;
+    entry.nameHash = bootHash(_fileName.c_str(), _fileName.length(),
+                              2166136261UL);
+    entry.fileSize = fileSize;
+    entry.check    = journalEntryCheck(entry);
+    journalFile.seekSet((entry.sequence & 1) * sizeof(entry));
+    journalFile.write(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry));
+    journalFile.close();
+}
+
+
+// Protected helper function - This cuts a partial record off the end of the
+// log file, reading only what came after the newest good journal entry
+void Logger::recoverFromJournal(const char* fileName) {
+    // Only the main log file is journaled
+    if (_journalChecked || strcmp(fileName, _fileName.c_str()) != 0) {
+        return;
+    }
+    _journalChecked = true;
+
+    char journalName[strlen(_loggerID) + sizeof(MS_JOURNAL_SUFFIX)];
+    strcpy(journalName, _loggerID);
+    strcat(journalName, MS_JOURNAL_SUFFIX);
+    File journalFile;
+    if (!journalFile.open(journalName, O_RDONLY)) { return; }
+    loggerJournalEntry entries[2];
+    int16_t            newest = -1;
+    for (uint8_t i = 0; i < 2; i++) {
+        if (journalFile.read(&entries[i], sizeof(entries[i])) ==
+                sizeof(entries[i]) &&
+            entries[i].check == journalEntryCheck(entries[i]) &&
+            (newest < 0 || entries[i].sequence > entries[newest].sequence)) {
+            newest = i;
+        }
+    }
+    journalFile.close();
+    if (newest < 0) { return; }
+    const loggerJournalEntry& entry = entries[newest];
+    _journalSequence                = entry.sequence;
+    if (entry.nameHash !=
+        bootHash(fileName, strlen(fileName), 2166136261UL)) {
+        return;
+    }
+
+    File tailFile;
+    if (!tailFile.open(fileName, O_RDWR)) { return; }
+    uint32_t fileSize = tailFile.fileSize();
+#ifdef MS_LOGGER_PERSISTENT_SD
+    // A file that was never closed still has all of its reserved space
+    bool reserved = fileSize == MS_LOGGER_PREALLOCATE_SIZE;
+#else
+    bool reserved = false;
+#endif
+    if (fileSize < entry.fileSize) {
+        PRINTOUT(F("The log file is shorter than it was last saved;"),
+                 entry.fileSize - fileSize, F("bytes were lost"));
+    } else if (fileSize > entry.fileSize &&
+               (reserved ||
+                fileSize - entry.fileSize <= MS_JOURNAL_MAX_TAIL)) {
+#ifdef MS_LOGGER_BINARY_FORMAT
+        // Records can't be told apart without the ones before them
+        uint32_t goodSize = entry.fileSize;
+#else
+        // Keep every whole line written after the journal entry, up to the
+        // first byte that can't be text - the unwritten reserved space
+        uint32_t goodSize = entry.fileSize;
+        uint32_t tailEnd  = fileSize;
+        if (tailEnd - entry.fileSize > MS_JOURNAL_MAX_TAIL) {
+            tailEnd = entry.fileSize + MS_JOURNAL_MAX_TAIL;
+        }
+        uint8_t chunk[64];
+        bool    text = true;
+        tailFile.seekSet(entry.fileSize);
+        for (uint32_t pos = entry.fileSize; text && pos < tailEnd;) {
+            int16_t n = tailFile.read(chunk, sizeof(chunk));
+            if (n <= 0) { break; }
+            for (int16_t i = 0; text && i < n && pos + i < tailEnd; i++) {
+                if (chunk[i] == 0x00 || chunk[i] == 0xFF) {
+                    text = false;
+                } else if (chunk[i] == '\n') {
+                    goodSize = pos + i + 1;
+                }
+            }
+            pos += n;
+        }
+#endif
+        if (goodSize < fileSize) {
+            PRINTOUT(F("Cutting"), fileSize - goodSize,
+                     F("bytes of a partial record off the end of"), fileName);
+            tailFile.truncate(goodSize);
+        }
+    }
+    tailFile.close();
+}
+#endif
+
+
+#ifdef MS_LOGGER_PERSISTENT_SD
+// Protected helper function - This closes the log file and forgets the mount
+void Logger::endSDSession(void) {
+#ifdef MS_LOGGER_SECTOR_WRITER
+    // Write the last part of a sector before the file is closed
+    if (logFile.isOpen()) { _sectorWriter.writeAll(); }
+#endif
+    // Give back the space reserved past the end of the data
+    if (logFile.isOpen()) { logFile.truncate(logFile.curPosition()); }
+#ifdef MS_LOGGER_JOURNAL
+    if (logFile.isOpen()) {
+        bool     journal   = logFileIsMain();
+        uint32_t savedSize = logFile.curPosition();
+        logFile.close();
+        if (journal) { writeJournal(savedSize); }
+    }
+#else
+    if (logFile.isOpen()) { logFile.close(); }
+#endif
+    _sdMounted = false;
+}
+#endif
+
+
 // Protected helper function - This opens or creates a file, converting a string
 // file name to a character file name
 bool Logger::openFile(String& filename, bool createFile,
@@ -1113,25 +3615,59 @@ bool Logger::openFile(String& filename, bool createFile,
     char         charFileName[fileNameLength];
     filename.toCharArray(charFileName, fileNameLength);
 
+#ifdef MS_LOGGER_PERSISTENT_SD
+    // Keep writing to the file that's already open, if it's the same one
+    if (logFile.isOpen()) {
+        char openFileName[fileNameLength + 1];
+        logFile.getName(openFileName, fileNameLength + 1);
+        if (strcmp(openFileName, charFileName) == 0) { return true; }
+#ifdef MS_LOGGER_SECTOR_WRITER
+        _sectorWriter.writeAll();
+#endif
+        logFile.truncate(logFile.curPosition());
+        logFile.close();
+    }
+#endif
+
+#ifdef MS_LOGGER_JOURNAL
+    // Before the first record after a restart goes on the end of the file
+    recoverFromJournal(charFileName);
+#endif
+
     // First attempt to open an already existing file (in write mode), so we
     // don't try to re-create something that's already there.
     // This should also prevent the header from being written over and over
     // in the file.
     if (logFile.open(charFileName, O_WRITE | O_AT_END)) {
         MS_DBG(F("Opened existing file:"), filename);
+#ifndef MS_LOGGER_SD_STAMP_MINUTES
         // Set access date time
         setFileTimestamp(logFile, T_ACCESS);
+#endif
+#ifdef MS_LOGGER_SECTOR_WRITER
+        _sectorWriter.begin(&logFile);
+#endif
         return true;
     } else if (createFile) {
         // Create and then open the file in write mode
         if (logFile.open(charFileName, O_CREAT | O_WRITE | O_AT_END)) {
             MS_DBG(F("Created new file:"), filename);
+#ifdef MS_LOGGER_PERSISTENT_SD
+            // Reserve contiguous space for the file while it's still empty
+            if (!logFile.preAllocate(MS_LOGGER_PREALLOCATE_SIZE)) {
+                MS_DBG(F("Unable to preallocate space for"), filename);
+            }
+#endif
             // Set creation date time
             setFileTimestamp(logFile, T_CREATE);
             // Write out a header, if requested
             if (writeDefaultHeader) {
                 // Add header information
+#ifdef MS_LOGGER_BINARY_FORMAT
+                printBinaryFileHeader(&logFile);
+#else
                 printFileHeader(&logFile);
+#endif
 // Print out the header for debugging
 #if defined(DEBUGGING_SERIAL_OUTPUT) && defined(MS_DEBUGGING_STD)
                 MS_DBG(F("\n \\/---- File Header ----\\/"));
@@ -1143,6 +3679,12 @@ bool Logger::openFile(String& filename, bool createFile,
             }
             // Set access date time
             setFileTimestamp(logFile, T_ACCESS);
+#ifdef MS_LOGGER_SD_STAMP_MINUTES
+            _lastFileStamp = Logger::markedUTCEpochTime;
+#endif
+#ifdef MS_LOGGER_SECTOR_WRITER
+            _sectorWriter.begin(&logFile);
+#endif
             return true;
         } else {
             // Return false if we couldn't create the file
@@ -1168,8 +3710,16 @@ bool Logger::openFile(String& filename, bool createFile,
 bool Logger::createLogFile(String& filename, bool writeDefaultHeader) {
     // Attempt to create and open a file
     if (openFile(filename, true, writeDefaultHeader)) {
+#ifdef MS_LOGGER_WARM_BOOT
+        saveBootRecord();
+#endif
+#ifdef MS_LOGGER_PERSISTENT_SD
+        // Keep the file open for the first record
+        logFile.sync();
+#else
         // Close the file to save it (only do this if we'd opened it)
         logFile.close();
+#endif
         PRINTOUT(F("Data will be saved as"), _fileName);
         return true;
     } else {
@@ -1178,11 +3728,204 @@ bool Logger::createLogFile(String& filename, bool writeDefaultHeader) {
     }
 }
 bool Logger::createLogFile(bool writeDefaultHeader) {
+#ifdef MS_LOGGER_WARM_BOOT
+    // The file was made before the reset; if it's gone since, the next record
+    // makes it again
+    if (_warmBoot) {
+        PRINTOUT(F("Data will be saved as"), _fileName);
+        return true;
+    }
+#endif
     if (_fileName == "") generateAutoFileName();
     return createLogFile(_fileName, writeDefaultHeader);
 }
 
 
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+// Protected helper function - This updates the sampling groups that are due
+// and saves each one's record to its own file
+void Logger::logSamplingGroups(uint8_t due) {
+    if (due == 0) { return; }
+    turnOnSDcard(true);
+
+    // The group's record and header are written by the same functions as the
+    // main array's, so the group stands in for the main array while it's
+    // logged
+    VariableArray* mainArray  = _internalArray;
+    loggerRecord*  mainRecord = _record;
+    for (uint8_t g = 0; g < _groupCount; g++) {
+        if (!(due & (1 << g))) { continue; }
+        MS_DBG(F("Running a complete update of sampling group"), g + 1);
+        watchDogTimer.resetWatchDog();
+        _groupArrays[g]->completeUpdate();
+        watchDogTimer.resetWatchDog();
+
+        if (_groupFileNames[g] == "") {
+            _groupFileNames[g] = String(_loggerID) + "_group" + (g + 1) + "_" +
+                formatDateTime_ISO8601(getNowLocalEpoch()).substring(0, 10);
+#ifdef MS_LOGGER_BINARY_FORMAT
+            _groupFileNames[g] += ".bin";
+#else
+            _groupFileNames[g] += ".csv";
+#endif
+        }
+
+        _internalArray = _groupArrays[g];
+        float        groupValues[getArrayVarCount()];
+        loggerRecord groupRecord;
+#ifdef MS_LOGGER_RESULT_TIMES
+        int32_t groupOffsets[_internalArray->getSensorListCount() + 1];
+        takeRecord(groupRecord, groupValues, groupOffsets);
+#else
+        takeRecord(groupRecord, groupValues);
+#endif
+        if (openFile(_groupFileNames[g], false, false) ||
+            openFile(_groupFileNames[g], true, true)) {
+#ifdef MS_LOGGER_BINARY_FORMAT
+            writeSensorDataBinary(logFileStream());
+#else
+            uint16_t lineLength = formatSensorDataCSV(recordLine,
+                                                      sizeof(recordLine));
+            printRecordLine(logFileStream(), lineLength);
+#endif
+#if defined(STANDARD_SERIAL_OUTPUT)
+            PRINTOUT(F("\n \\/---- Line Saved to"), _groupFileNames[g],
+                     F("----\\/"));
+#ifdef MS_LOGGER_BINARY_FORMAT
+            printSensorDataCSV(&STANDARD_SERIAL_OUTPUT);
+#else
+            printRecordLine(&STANDARD_SERIAL_OUTPUT, lineLength);
+#endif
+            PRINTOUT('\n');
+#endif
+            saveLogFile();
+        } else {
+            PRINTOUT(F("Unable to write to SD card!"));
+        }
+        _internalArray = mainArray;
+        _record        = mainRecord;
+    }
+
+#ifndef MS_LOGGER_PERSISTENT_SD
+    // Cut power from the SD card, waiting for housekeeping
+    turnOffSDcard(true);
+#endif
+}
+#endif
+
+
+#ifdef MS_LOGGER_EVENT_TRIGGER
+// Protected helper function - This checks the trigger with the newest values
+// and decides whether the record is saved
+bool Logger::checkEventTrigger(void) {
+    if (_eventTrigger == nullptr) { return true; }
+
+    float value     = _eventTrigger->getValue();
+    bool  triggered = false;
+    if (value != -9999) {
+        if (_eventThreshold != -9999 && value >= _eventThreshold) {
+            triggered = true;
+        }
+        if (_eventRisePerMinute != -9999 && _eventLastValue != -9999 &&
+            Logger::markedLocalEpochTime > _eventLastTime) {
+            float minutes = (Logger::markedLocalEpochTime - _eventLastTime) /
+                60.0f;
+            if ((value - _eventLastValue) / minutes >= _eventRisePerMinute) {
+                triggered = true;
+            }
+        }
+        _eventLastValue = value;
+        _eventLastTime  = Logger::markedLocalEpochTime;
+    }
+
+    if (triggered) {
+        if (_eventQuietLeft == 0) {
+            PRINTOUT(F("Event triggered by"), _eventTrigger->getVarCodeChars(),
+                     F("="), value);
+            saveEventRing();
+        }
+        _eventQuietLeft = _eventQuietRecords;
+        return true;
+    }
+    if (_eventQuietLeft > 0) {
+        // Keep logging fast until the trigger has been quiet long enough
+        _eventQuietLeft--;
+        if (_eventQuietLeft == 0) { PRINTOUT(F("Event over")); }
+        return true;
+    }
+    if (!_eventWake) {
+        // Records on the logging interval are always saved, so the ones kept
+        // from before it aren't needed
+        _eventRingCount = 0;
+        return true;
+    }
+    keepEventRecord();
+    return false;
+}
+
+
+// Protected helper function - This adds the current record to the ring
+void Logger::keepEventRecord(void) {
+    uint16_t recordSize = sizeof(uint32_t) + sizeof(float) * getArrayVarCount();
+    uint16_t capacity   = MS_LOGGER_EVENT_RING_BYTES / recordSize;
+    if (capacity == 0) { return; }
+    if (_eventRingCount == capacity) {
+        // Drop the oldest record
+        _eventRingHead = (_eventRingHead + 1) % capacity;
+        _eventRingCount--;
+    }
+    uint16_t slot = (_eventRingHead + _eventRingCount) % capacity;
+    uint8_t* out  = _eventRing + slot * recordSize;
+    memcpy(out, &Logger::markedLocalEpochTime, sizeof(uint32_t));
+    out += sizeof(uint32_t);
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        float value = getRecordValueAtI(i);
+        memcpy(out, &value, sizeof(float));
+        out += sizeof(float);
+    }
+    _eventRingCount++;
+    MS_DBG(_eventRingCount, F("records are kept from before any event"));
+}
+
+
+// Protected helper function - This saves the kept records, oldest first
+void Logger::saveEventRing(void) {
+    if (_eventRingCount == 0) { return; }
+    uint16_t recordSize = sizeof(uint32_t) + sizeof(float) * getArrayVarCount();
+    uint16_t capacity   = MS_LOGGER_EVENT_RING_BYTES / recordSize;
+
+    // The marked time is replaced by each record's time while it's saved
+    uint32_t      markedUTC   = Logger::markedUTCEpochTime;
+    uint32_t      markedLocal = Logger::markedLocalEpochTime;
+    loggerRecord* cycleRecord = _record;
+    float         values[getArrayVarCount()];
+    loggerRecord  ringRecord = {0, RECORD_FROM_RING, getArrayVarCount(),
+                                values};
+    PRINTOUT(F("Saving"), _eventRingCount, F("records from before the event"));
+    for (uint16_t j = 0; j < _eventRingCount; j++) {
+        const uint8_t* in = _eventRing +
+            ((_eventRingHead + j) % capacity) * recordSize;
+        uint32_t recordTime;
+        memcpy(&recordTime, in, sizeof(uint32_t));
+        memcpy(values, in + sizeof(uint32_t), sizeof(values));
+        ringRecord.utcEpoch = recordTime - ((uint32_t)_loggerRTCOffset) * 3600;
+        useRecord(&ringRecord);
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+        bufferRecord();
+#else
+        logToSD();
+#endif
+        watchDogTimer.resetWatchDog();
+    }
+    _record                      = cycleRecord;
+    Logger::markedUTCEpochTime   = markedUTC;
+    Logger::markedLocalEpochTime = markedLocal;
+    _eventRingHead               = 0;
+    _eventRingCount              = 0;
+}
+#endif
+
+
 // These functions write a file on the SD card with the given filename and
 // set the proper timestamps to the file.
 // The filename may either be the one set by
@@ -1203,18 +3946,13 @@ bool Logger::logToSD(String& filename, String& rec) {
     }
 
     // If we could successfully open or create the file, write the data to it
-    logFile.println(rec);
+    logFileStream()->println(rec);
     // Echo the line to the serial port
     PRINTOUT(F("\n \\/---- Line Saved to SD Card ----\\/"));
     PRINTOUT(rec);
 
-    // Set write/modification date time
-    setFileTimestamp(logFile, T_WRITE);
-    // Set access date time
-    setFileTimestamp(logFile, T_ACCESS);
-    // Close the file to save it
-    logFile.close();
-    return true;
+    // Save the file
+    return saveLogFile();
 }
 bool Logger::logToSD(String& rec) {
     // Get a new file name if the name is blank
@@ -1226,36 +3964,484 @@ bool Logger::logToSD(String& rec) {
 bool Logger::logToSD(void) {
     // Get a new file name if the name is blank
     if (_fileName == "") generateAutoFileName();
+#ifdef MS_LOGGER_FILE_ROTATION
+    rotateLogFile();
+#endif
 
     // First attempt to open the file without creating a new one
+    MS_PROFILE_START(SPAN_SD_OPEN);
     if (!openFile(_fileName, false, false)) {
         // Next try to create a new file, bail if we couldn't create it
         // Generate a filename with the current date, if the file name isn't set
         if (_fileName == "") generateAutoFileName();
         // Do add a default header to the new file!
         if (!openFile(_fileName, true, true)) {
+            MS_PROFILE_END(SPAN_SD_OPEN);
             PRINTOUT(F("Unable to write to SD card!"));
             return false;
         }
     }
+    MS_PROFILE_END(SPAN_SD_OPEN);
+
+    // Write the data
+    MS_PROFILE_START(SPAN_SD_WRITE);
+#ifdef MS_LOGGER_BINARY_FORMAT
+    writeSensorDataBinary(logFileStream());
+#else
+    // Make the csv record once for both the file and the serial echo
+    uint16_t lineLength = formatSensorDataCSV(recordLine, sizeof(recordLine));
+    printRecordLine(logFileStream(), lineLength);
+#endif
+    MS_PROFILE_END(SPAN_SD_WRITE);
+// Echo the line to the serial port
+#if defined(STANDARD_SERIAL_OUTPUT)
+    PRINTOUT(F("\n \\/---- Line Saved to SD Card ----\\/"));
+#ifdef MS_LOGGER_BINARY_FORMAT
+    printSensorDataCSV(&STANDARD_SERIAL_OUTPUT);
+#else
+    printRecordLine(&STANDARD_SERIAL_OUTPUT, lineLength);
+#endif
+    PRINTOUT('\n');
+#endif
+
+    // Save the file
+    MS_PROFILE_START(SPAN_SD_CLOSE);
+    bool saved = saveLogFile();
+    MS_PROFILE_END(SPAN_SD_CLOSE);
+#ifdef MS_LOGGER_FILE_ROTATION
+    if (!saved) { return false; }
+    updateLogIndex(Logger::markedLocalEpochTime, Logger::markedLocalEpochTime,
+                   1);
+    return true;
+#else
+    return saved;
+#endif
+}
+
+
+#ifdef MS_LOGGER_PROFILE
+// Append the profile trace to its own file
+bool Logger::writeProfileTrace(void) {
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+    turnOnSDcard(true);
+#endif
+    if (!initializeSDCard()) { return false; }
+    char traceName[strlen(_loggerID) + sizeof(MS_PROFILE_TRACE_SUFFIX)];
+    strcpy(traceName, _loggerID);
+    strcat(traceName, MS_PROFILE_TRACE_SUFFIX);
+    File traceFile;
+    bool success = traceFile.open(traceName, O_WRITE | O_CREAT | O_AT_END);
+    if (success) {
+        LoggerProfiler::printTrace(&traceFile);
+        setFileTimestamp(traceFile, T_WRITE);
+        traceFile.close();
+        LoggerProfiler::clearTrace();
+    } else {
+        MS_DBG(F("Unable to open"), traceName);
+    }
+#if defined(MS_LOGGER_RECORD_BUFFER_SIZE) && !defined(MS_LOGGER_PERSISTENT_SD)
+    turnOffSDcard(true);
+#endif
+    return success;
+}
+#endif
+
+
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+
+#ifdef MS_LOGGER_RECORD_STORE
+// The header at the start of the record store
+typedef struct {
+    uint16_t magic;
+    uint8_t  varCount;
+    uint16_t records;
+    uint32_t used;
+    uint32_t firstTime;
+    uint32_t lastTime;
+} recordStoreHeader;
+
+// Marks a record store header written by this library
+#define MS_RECORD_STORE_MAGIC 0x5352
+#endif
+
+// Protected helper function - This adds a record to the buffer
+bool Logger::appendRecord(void) {
+    char*    out  = _recordBuffer + _recordBufferUsed;
+    uint16_t room = MS_LOGGER_RECORD_BUFFER_SIZE - _recordBufferUsed;
+#ifdef MS_LOGGER_RECORD_STORE
+    // With a store, the buffer only carries the record on its way there
+    bool toStore = openRecordStore();
+    if (toStore) {
+        out  = _recordBuffer;
+        room = MS_LOGGER_RECORD_BUFFER_SIZE;
+    }
+#endif
+#ifdef MS_LOGGER_BINARY_FORMAT
+    uint16_t recordSize = sizeof(uint32_t) + sizeof(float) * getArrayVarCount();
+    if (recordSize > room) { return false; }
+    char* next = out;
+    memcpy(next, &Logger::markedLocalEpochTime, sizeof(uint32_t));
+    next += sizeof(uint32_t);
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        float value = getRecordValueAtI(i);
+        memcpy(next, &value, sizeof(float));
+        next += sizeof(float);
+    }
+#else
+    uint16_t recordSize = formatSensorDataCSV(out, room);
+    if (recordSize == 0) { return false; }
+#endif
+#ifdef MS_LOGGER_RECORD_STORE
+    if (toStore) {
+        uint32_t address = sizeof(recordStoreHeader) + _recordStoreUsed;
+        if (address + recordSize > _recordStore->capacity() ||
+            !_recordStore->write(address, out, recordSize)) {
+            return false;
+        }
+        _recordStoreUsed += recordSize;
+        return true;
+    }
+#endif
+    _recordBufferUsed += recordSize;
+    return true;
+}
+
+// Protected helper function - This writes records from the buffer to the file
+uint16_t Logger::writeRecordBuffer(uint16_t length) {
+#if defined(MS_LOGGER_BINARY_FORMAT) && defined(MS_LOGGER_DELTA_ENCODING)
+    // The buffer holds plain binary records, so they're only encoded once
+    // it's known which file and after which record they go
+    uint8_t  varCount   = getArrayVarCount();
+    uint16_t recordSize = sizeof(uint32_t) + sizeof(float) * varCount;
+    float    values[varCount];
+    uint8_t  record[6 + 5 * varCount];
+    uint16_t pos = 0;
+    for (; pos + recordSize <= length; pos += recordSize) {
+        uint32_t recordTime;
+        memcpy(&recordTime, _recordBuffer + pos, sizeof(recordTime));
+        memcpy(values, _recordBuffer + pos + sizeof(recordTime),
+               sizeof(float) * varCount);
+        uint16_t recordLength = encodeDeltaRecord(record, recordTime, values);
+        if (logFileStream()->write(record, recordLength) != recordLength) {
+            // The next record can't be a delta from one that isn't in the
+            // file
+            _deltaArray = nullptr;
+            break;
+        }
+    }
+    return pos;
+#else
+    return logFileStream()->write(
+        reinterpret_cast<const uint8_t*>(_recordBuffer), length);
+#endif
+}
+
+// Protected helper function - This counts the records at the start of the
+// buffer
+uint16_t Logger::countBufferRecords(uint16_t length) {
+#ifdef MS_LOGGER_BINARY_FORMAT
+    uint16_t recordSize = sizeof(uint32_t) + sizeof(float) * getArrayVarCount();
+    // A record that was cut short still counts
+    return (length + recordSize - 1) / recordSize;
+#else
+    uint16_t records = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        if (_recordBuffer[i] == '\n') { records++; }
+    }
+    return records;
+#endif
+}
+
+#ifdef MS_LOGGER_RECORD_STORE
+void Logger::setRecordStore(LoggerRecordStore* store) {
+    _recordStore     = store;
+    _recordStoreOpen = false;
+}
+
+// Protected helper function - This gets the store ready and reads its header
+bool Logger::openRecordStore(void) {
+    if (_recordStoreOpen) { return true; }
+    if (_recordStore == nullptr) { return false; }
+    if (!_recordStore->begin()) {
+        // Don't try again every record; buffer in RAM instead
+        PRINTOUT(F("The record store didn't answer, buffering in RAM"));
+        _recordStore = nullptr;
+        return false;
+    }
+    _recordStoreOpen = true;
+
+    recordStoreHeader header;
+    if (_recordStore->read(0, &header, sizeof(header)) &&
+        header.magic == MS_RECORD_STORE_MAGIC &&
+        header.varCount == getArrayVarCount() &&
+        sizeof(header) + header.used <= _recordStore->capacity()) {
+        _recordStoreUsed = header.used;
+        _recordsBuffered = header.records;
+#ifdef MS_LOGGER_FILE_ROTATION
+        _bufferFirstTime = header.firstTime;
+        _bufferLastTime  = header.lastTime;
+#endif
+        if (_recordsBuffered > 0) {
+            PRINTOUT(F("Found"), _recordsBuffered,
+                     F("records left in the record store"));
+        }
+    } else {
+        // A blank store, or one kept for different variables
+        _recordStoreUsed = 0;
+        _recordsBuffered = 0;
+        saveRecordStoreHeader();
+    }
+    return true;
+}
+
+// Protected helper function - This saves the record count in the store
+void Logger::saveRecordStoreHeader(void) {
+    if (!_recordStoreOpen) { return; }
+    recordStoreHeader header;
+    header.magic     = MS_RECORD_STORE_MAGIC;
+    header.varCount  = getArrayVarCount();
+    header.records   = _recordsBuffered;
+    header.used      = _recordStoreUsed;
+    header.firstTime = 0;
+    header.lastTime  = 0;
+#ifdef MS_LOGGER_FILE_ROTATION
+    header.firstTime = _bufferFirstTime;
+    header.lastTime  = _bufferLastTime;
+#endif
+    _recordStore->write(0, &header, sizeof(header));
+}
+
+// Protected helper function - This carries the records from the store to the
+// log file a buffer at a time
+bool Logger::writeRecordStore(void) {
+    uint16_t chunk = MS_LOGGER_RECORD_BUFFER_SIZE;
+#ifdef MS_LOGGER_BINARY_FORMAT
+    // Only whole binary records, so they can be encoded
+    chunk -= chunk % (sizeof(uint32_t) + sizeof(float) * getArrayVarCount());
+#endif
+    uint32_t written = 0;
+    while (written < _recordStoreUsed) {
+        uint16_t length = chunk;
+        if (_recordStoreUsed - written < chunk) {
+            length = _recordStoreUsed - written;
+        }
+        if (!_recordStore->read(sizeof(recordStoreHeader) + written,
+                                _recordBuffer, length)) {
+            break;
+        }
+        uint16_t wrote = writeRecordBuffer(length);
+        written += wrote;
+        if (wrote < length) { break; }
+    }
+    if (written == _recordStoreUsed) { return true; }
+    if (written == 0) { return false; }
+
+    // Move the records that didn't make it to the file to the start of the
+    // store, so only those are written next time
+    uint16_t records = 0;
+    for (uint32_t from = written; from < _recordStoreUsed; from += chunk) {
+        uint16_t length = chunk;
+        if (_recordStoreUsed - from < chunk) {
+            length = _recordStoreUsed - from;
+        }
+        if (!_recordStore->read(sizeof(recordStoreHeader) + from,
+                                _recordBuffer, length) ||
+            !_recordStore->write(sizeof(recordStoreHeader) + from - written,
+                                 _recordBuffer, length)) {
+            // Keep all of them rather than lose any
+            return false;
+        }
+        records += countBufferRecords(length);
+    }
+    _recordStoreUsed -= written;
+    _recordsBuffered = records;
+    saveRecordStoreHeader();
+    return false;
+}
+#endif
+
+void Logger::setRecordsPerFlush(uint8_t recordsPerFlush) {
+    _recordsPerFlush = recordsPerFlush;
+}
+void Logger::setFlushCheck(bool (*flushCheck)(void)) {
+    _flushCheck = flushCheck;
+}
+
+// This adds the current record to the buffer, writing the buffer to the SD
+// card when it's full
+bool Logger::bufferRecord(void) {
+    bool success = true;
+    if (!appendRecord()) {
+        // Make room by writing out the older records; if that fails, whatever
+        // couldn't be written is still in the buffer
+        success = flushRecordBuffer();
+        if (!appendRecord()) {
+            // The record is bigger than the whole buffer, or the buffer is
+            // still full of records that couldn't be written; write it
+            // directly
+            MS_DBG(F("Record doesn't fit in the buffer, writing it directly"));
+            turnOnSDcard(true);
+            success &= logToSD();
+#ifndef MS_LOGGER_PERSISTENT_SD
+            turnOffSDcard(true);
+#endif
+            return success;
+        }
+    }
+#ifdef MS_LOGGER_FILE_ROTATION
+    if (_recordsBuffered == 0) {
+        _bufferFirstTime = Logger::markedLocalEpochTime;
+    }
+    _bufferLastTime = Logger::markedLocalEpochTime;
+#endif
+    _recordsBuffered++;
+#ifdef MS_LOGGER_RECORD_STORE
+    saveRecordStoreHeader();
+#endif
+#ifdef MS_LOGGER_RETAINED_BUFFER
+    saveRetainedBuffer();
+#endif
+// Echo the line to the serial port
+#if defined(STANDARD_SERIAL_OUTPUT)
+    PRINTOUT(F("\n \\/---- Line Buffered ----\\/"));
+    printSensorDataCSV(&STANDARD_SERIAL_OUTPUT);
+    PRINTOUT('\n');
+#endif
+    MS_DBG(_recordsBuffered, F("records using"), _recordBufferUsed,
+           F("bytes are buffered"));
+
+    if ((_recordsPerFlush > 0 && _recordsBuffered >= _recordsPerFlush) ||
+        (_flushCheck != nullptr && _flushCheck())) {
+        success &= flushRecordBuffer();
+    }
+    return success;
+}
+
+// This writes all of the buffered records to the SD card in one go
+bool Logger::flushRecordBuffer(void) {
+    if (_recordsBuffered == 0) { return true; }
+
+    MS_DBG(F("Writing"), _recordsBuffered, F("buffered records to SD card"));
+    turnOnSDcard(true);
+    bool     success = true;
+    uint16_t written = 0;
+    // Get a new file name if the name is blank
+    if (_fileName == "") generateAutoFileName();
+#ifdef MS_LOGGER_FILE_ROTATION
+    rotateLogFile();
+#endif
+    // Attempt to open the file, and then to create it with a header
+    if (!openFile(_fileName, false, false) &&
+        !openFile(_fileName, true, true)) {
+        PRINTOUT(F("Unable to write to SD card!"));
+        success = false;
+    } else {
+#ifdef MS_LOGGER_RECORD_STORE
+        if (_recordStoreOpen) {
+            success = writeRecordStore();
+        } else {
+            written = writeRecordBuffer(_recordBufferUsed);
+            success = written == _recordBufferUsed;
+        }
+        success &= saveLogFile();
+#else
+#ifdef MS_LOGGER_RETAINED_BUFFER
+        // Once any of the records may be in the file, they mustn't be taken
+        // back after a reset
+        retainedHeader.magic = 0;
+#endif
+        written = writeRecordBuffer(_recordBufferUsed);
+        success = written == _recordBufferUsed;
+        success &= saveLogFile();
+#endif
+#ifdef MS_LOGGER_FILE_ROTATION
+        if (success) {
+            updateLogIndex(_bufferFirstTime, _bufferLastTime,
+                           _recordsBuffered);
+        }
+#endif
+    }
+#ifndef MS_LOGGER_PERSISTENT_SD
+    // Cut power from the SD card, waiting for housekeeping
+    turnOffSDcard(true);
+#endif
+
+#ifdef MS_LOGGER_RECORD_STORE
+    if (_recordStoreOpen) {
+        // Keep the records in the store to try again next time
+        if (!success) { return false; }
+        _recordStoreUsed = 0;
+        _recordsBuffered = 0;
+        saveRecordStoreHeader();
+        return true;
+    }
+#endif
+    // Keep the records that didn't make it to the file to try again
+    if (written < _recordBufferUsed) {
+        memmove(_recordBuffer, _recordBuffer + written,
+                _recordBufferUsed - written);
+    }
+    _recordBufferUsed -= written;
+    _recordsBuffered = countBufferRecords(_recordBufferUsed);
+    if (_recordsBuffered > 0) {
+        PRINTOUT(_recordsBuffered, F("records weren't written, keeping them"));
+    }
+#ifdef MS_LOGGER_RETAINED_BUFFER
+    saveRetainedBuffer();
+#endif
+    return success;
+}
 
-    // Write the data
-    printSensorDataCSV(&logFile);
-// Echo the line to the serial port
-#if defined(STANDARD_SERIAL_OUTPUT)
-    PRINTOUT(F("\n \\/---- Line Saved to SD Card ----\\/"));
-    printSensorDataCSV(&STANDARD_SERIAL_OUTPUT);
-    PRINTOUT('\n');
+#ifdef MS_LOGGER_RETAINED_BUFFER
+void Logger::saveRetainedBuffer(void) {
+    // Only the bytes added since the last save need to be hashed
+    uint32_t hash = 2166136261UL;
+    uint16_t from = 0;
+    if (retainedHeader.magic == MS_RETAINED_BUFFER_MAGIC &&
+        retainedHeader.used <= _recordBufferUsed) {
+        hash = retainedHeader.dataHash;
+        from = retainedHeader.used;
+    }
+    retainedHeader.dataHash = bootHash(_recordBuffer + from,
+                                       _recordBufferUsed - from, hash);
+    retainedHeader.magic     = MS_RETAINED_BUFFER_MAGIC;
+    retainedHeader.varCount  = getArrayVarCount();
+    retainedHeader.records   = _recordsBuffered;
+    retainedHeader.used      = _recordBufferUsed;
+    retainedHeader.firstTime = 0;
+    retainedHeader.lastTime  = 0;
+#ifdef MS_LOGGER_FILE_ROTATION
+    retainedHeader.firstTime = _bufferFirstTime;
+    retainedHeader.lastTime  = _bufferLastTime;
 #endif
+    retainedHeader.check = retainedHeaderCheck();
+}
 
-    // Set write/modification date time
-    setFileTimestamp(logFile, T_WRITE);
-    // Set access date time
-    setFileTimestamp(logFile, T_ACCESS);
-    // Close the file to save it
-    logFile.close();
-    return true;
+void Logger::recoverRetainedBuffer(void) {
+    // Random RAM at power up, or records for other variables, are thrown out
+    bool kept = retainedHeader.magic == MS_RETAINED_BUFFER_MAGIC &&
+        retainedHeader.check == retainedHeaderCheck() &&
+        retainedHeader.varCount == getArrayVarCount() &&
+        retainedHeader.used <= MS_LOGGER_RECORD_BUFFER_SIZE &&
+        retainedHeader.dataHash ==
+            bootHash(_recordBuffer, retainedHeader.used, 2166136261UL);
+    _recordBufferUsed = 0;
+    _recordsBuffered  = 0;
+    if (kept && retainedHeader.records > 0) {
+        _recordBufferUsed = retainedHeader.used;
+        _recordsBuffered  = retainedHeader.records;
+#ifdef MS_LOGGER_FILE_ROTATION
+        _bufferFirstTime = retainedHeader.firstTime;
+        _bufferLastTime  = retainedHeader.lastTime;
+#endif
+        PRINTOUT(F("Found"), _recordsBuffered,
+                 F("records kept in the buffer through the reset"));
+    }
+    if (!kept) { retainedHeader.magic = 0; }
+    saveRetainedBuffer();
 }
+#endif
+#endif
 
 
 // ===================================================================== //
@@ -1278,6 +4464,36 @@ void Logger::testingMode() {
     // Unset the startTesting flag
     Logger::startTesting = false;
 
+#if defined(MS_LOGGER_DOWNLOAD) && defined(STANDARD_SERIAL_OUTPUT)
+    PRINTOUT(F("Send 'D' to download the files on the SD card"));
+    bool     download    = false;
+    uint32_t promptStart = millis();
+    while (!download && millis() - promptStart < MS_DOWNLOAD_PROMPT_MS) {
+        download = STANDARD_SERIAL_OUTPUT.read() == 'D';
+    }
+    if (download) {
+#ifdef MS_DOWNLOAD_BAUD
+        STANDARD_SERIAL_OUTPUT.flush();
+        STANDARD_SERIAL_OUTPUT.begin(MS_DOWNLOAD_BAUD);
+#endif
+        downloadMode(&STANDARD_SERIAL_OUTPUT);
+#ifdef MS_DOWNLOAD_BAUD
+        STANDARD_SERIAL_OUTPUT.flush();
+        STANDARD_SERIAL_OUTPUT.begin(MS_SERIAL_BAUD);
+#endif
+        Logger::isTestingNow = false;
+        systemSleep();
+        return;
+    }
+#endif
+
+#if defined(MS_LOGGER_STREAMING) && defined(STANDARD_SERIAL_OUTPUT)
+    streamingMode(&STANDARD_SERIAL_OUTPUT);
+    Logger::isTestingNow = false;
+    systemSleep();
+    return;
+#endif
+
     PRINTOUT(F("------------------------------------------"));
     PRINTOUT(F("Entering sensor testing mode"));
     delay(100);  // This seems to prevent crashes, no clue why ....
@@ -1354,6 +4570,154 @@ void Logger::testingMode() {
 }
 
 
+#ifdef MS_LOGGER_STREAMING
+// This streams the values as fast as the sensors give them
+void Logger::streamingMode(Stream* stream) {
+    PRINTOUT(F("------------------------------------------"));
+    PRINTOUT(F("Streaming sensor values; send any character to stop"));
+
+    // Throw out anything already waiting so it doesn't stop the stream
+    while (stream->available()) { stream->read(); }
+
+    _internalArray->sensorsPowerUp();
+    _internalArray->sensorsWake();
+
+    stream->print(F("ms"));
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        stream->print(',');
+        stream->print(getVarCodeCharsAtI(i));
+    }
+    stream->println();
+
+    uint32_t start = millis();
+    while (!stream->available() &&
+           millis() - start < MS_STREAMING_TIMEOUT_S * 1000UL) {
+        watchDogTimer.resetWatchDog();
+        // Like the testing mode, the sensors are left on between updates
+        _internalArray->updateAllSensors();
+        stream->print(millis());
+        for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+            stream->print(',');
+            stream->print(_internalArray->getValueChars(i));
+        }
+        stream->println();
+    }
+    while (stream->available()) { stream->read(); }
+
+    _internalArray->sensorsSleep();
+    _internalArray->sensorsPowerDown();
+    watchDogTimer.resetWatchDog();
+
+    PRINTOUT(F("Stopped streaming"));
+    PRINTOUT(F("------------------------------------------"));
+}
+#endif
+
+
+#ifdef MS_LOGGER_DOWNLOAD
+// The CRC-16/CCITT of some bytes, continuing from an earlier CRC
+static uint16_t downloadCRC(uint16_t crc, const uint8_t* data,
+                            uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+// This answers the commands of a download; nothing else may be printed to the
+// stream until it's done, so there's no debugging output in here
+void Logger::downloadMode(Stream* stream) {
+    if (!initializeSDCard()) {
+        stream->println(F("ERR"));
+        return;
+    }
+    while (stream->available()) { stream->read(); }
+    stream->println(F("READY"));
+
+    char     command[80];
+    bool     done        = false;
+    uint32_t lastCommand = millis();
+    while (!done && millis() - lastCommand < MS_DOWNLOAD_TIMEOUT_S * 1000UL) {
+        watchDogTimer.resetWatchDog();
+        if (stream->available() == 0) {
+            delay(1);
+            continue;
+        }
+        stream->setTimeout(1000);
+        size_t length = stream->readBytesUntil('\n', command,
+                                               sizeof(command) - 1);
+        command[length]                 = '\0';
+        command[strcspn(command, "\r")] = '\0';
+        lastCommand                     = millis();
+
+        if (strcmp(command, "L") == 0) {
+            File root;
+            File entry;
+            char name[64];
+            if (root.open("/")) {
+                while (entry.openNext(&root, O_RDONLY)) {
+                    if (!entry.isDir()) {
+                        entry.getName(name, sizeof(name));
+                        stream->print(entry.fileSize());
+                        stream->print(',');
+                        stream->println(name);
+                    }
+                    entry.close();
+                }
+                root.close();
+            }
+            stream->println(F("END"));
+        } else if (command[0] == 'G' && command[1] == ' ') {
+            char*    fileName = nullptr;
+            uint32_t offset   = strtoul(command + 2, &fileName, 10);
+            while (*fileName == ' ') { fileName++; }
+            sendFileBlocks(stream, fileName, offset);
+        } else if (strcmp(command, "Q") == 0) {
+            done = true;
+        } else {
+            stream->println(F("ERR"));
+        }
+    }
+
+#ifndef MS_LOGGER_PERSISTENT_SD
+    turnOffSDcard(true);
+#endif
+    watchDogTimer.resetWatchDog();
+}
+
+// Protected helper function - This sends a file from an offset in CRC checked
+// blocks until the end or until the other end sends anything
+void Logger::sendFileBlocks(Stream* stream, const char* fileName,
+                            uint32_t offset) {
+    File file;
+    if (!file.open(fileName, O_RDONLY) || !file.seekSet(offset)) {
+        stream->println(F("ERR"));
+        return;
+    }
+    // The header of each block is the offset and the length
+    uint8_t block[6 + MS_DOWNLOAD_BLOCK_SIZE];
+    int     got;
+    do {
+        watchDogTimer.resetWatchDog();
+        got = file.read(block + 6, MS_DOWNLOAD_BLOCK_SIZE);
+        if (got < 0) { got = 0; }
+        uint16_t length = got;
+        memcpy(block, &offset, sizeof(offset));
+        memcpy(block + 4, &length, sizeof(length));
+        uint16_t crc = downloadCRC(0xFFFF, block, 6 + length);
+        stream->write('#');
+        stream->write(block, 6 + length);
+        stream->write(reinterpret_cast<const uint8_t*>(&crc), sizeof(crc));
+        offset += length;
+    } while (got > 0 && stream->available() == 0);
+    file.close();
+}
+#endif
+
+
 // ===================================================================== //
 // Convience functions to call several of the above functions
 // ===================================================================== //
@@ -1372,9 +4736,28 @@ void Logger::begin(VariableArray* inputArray) {
     begin();
 }
 void Logger::begin() {
+#if defined(MS_DEBUG_TOKENIZED) && defined(DEBUGGING_SERIAL_OUTPUT)
+    // Write out the debugging records before they're written over
+    msTokenLog().setOutput(&DEBUGGING_SERIAL_OUTPUT);
+#endif
     MS_DBG(F("Logger ID is:"), _loggerID);
-    MS_DBG(F("Logger is set to record at"), _loggingIntervalMinutes,
-           F("minute intervals."));
+#if defined(MS_LOGGER_SHARED_SD) && defined(MS_LOGGER_PERSISTENT_SD)
+    // Join the loggers sharing the card, once
+    bool listed = false;
+    for (Logger* l = _sdLoggers; l != nullptr; l = l->_nextSDLogger) {
+        if (l == this) { listed = true; }
+    }
+    if (!listed) {
+        _nextSDLogger = _sdLoggers;
+        _sdLoggers    = this;
+    }
+#endif
+    MS_DBG(F("Logger is set to record at"), getLoggingIntervalSeconds(),
+           F("second intervals."));
+#ifdef MS_MODEM_PSM_SCHEDULE
+    // Before the modem is first set up, which sends some modems' timers
+    if (_logModem != nullptr) { scheduleModemPSM(); }
+#endif
 
 #if defined(ARDUINO_ARCH_SAMD)
     MS_DBG(F("Disabling the USB on standby to lower sleep current"));
@@ -1390,6 +4773,13 @@ void Logger::begin() {
     MS_DBG(F(
         "Setting up a watch-dog timer to fire after 15 minutes of inactivity"));
     watchDogTimer.setupWatchDog((uint32_t)(5 * 60 * 3));
+#ifdef MS_WATCHDOG_PHASES
+    _lastOverrunPhase = watchDogTimer.getOverrunPhase();
+    if (_lastOverrunPhase != PHASE_NONE) {
+        PRINTOUT(F("The watchdog reset the logger in phase"),
+                 _lastOverrunPhase);
+    }
+#endif
     // Enable the watchdog
     watchDogTimer.enableWatchDog();
 
@@ -1409,6 +4799,9 @@ void Logger::begin() {
 #endif
     MS_DBG(F("Beginning wire (I2C)"));
     Wire.begin();
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+    Sensor::forgetI2CClock();
+#endif
     watchDogTimer.resetWatchDog();
 
     // Eliminate any potential extra waits in the wire library
@@ -1442,6 +4835,33 @@ void Logger::begin() {
 
     // Begin the internal array
     _internalArray->begin();
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    for (uint8_t g = 0; g < _groupCount; g++) { _groupArrays[g]->begin(); }
+#endif
+#ifdef MS_SENSOR_STANDBY
+    // Pick what happens to the sensors between logging intervals
+    uint32_t mainInterval_ms = getLoggingIntervalSeconds() * 1000UL;
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    // and between the intervals of the sampling groups.  A sensor in more
+    // than one array keeps the pick made last, so the groups slower than the
+    // main array go first.
+    for (uint8_t g = 0; g < _groupCount; g++) {
+        uint32_t groupInterval_ms = _groupIntervals[g] * 60000UL;
+        if (groupInterval_ms > mainInterval_ms) {
+            _groupArrays[g]->chooseStandby(groupInterval_ms);
+        }
+    }
+#endif
+    _internalArray->chooseStandby(mainInterval_ms);
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    for (uint8_t g = 0; g < _groupCount; g++) {
+        uint32_t groupInterval_ms = _groupIntervals[g] * 60000UL;
+        if (groupInterval_ms <= mainInterval_ms) {
+            _groupArrays[g]->chooseStandby(groupInterval_ms);
+        }
+    }
+#endif
+#endif
     PRINTOUT(F("This logger has a variable array with"), getArrayVarCount(),
              F("variables, of which"),
              getArrayVarCount() - _internalArray->getCalculatedVariableCount(),
@@ -1452,11 +4872,111 @@ void Logger::begin() {
     if (_samplingFeatureUUID != nullptr) {
         PRINTOUT(F("Sampling feature UUID is:"), _samplingFeatureUUID);
     }
+#ifdef MS_LOGGER_HEADER_CACHE
+    // The variables are ready, so the header rows won't change now
+    buildHeaderCache();
+#endif
+
+#ifdef MS_LOGGER_WARM_BOOT
+    // Compare the set up to the one kept through the reset
+    _setupFingerprint = getSetupFingerprint();
+    _warmBoot         = bootRecord.magic == MS_BOOT_RECORD_MAGIC &&
+        bootRecord.check == bootRecordCheck() &&
+        bootRecord.fingerprint == _setupFingerprint && bootRecord.clockSet &&
+        isRTCSane();
+    _warmBootSyncPending = _warmBoot;
+    if (_warmBoot) {
+        bootRecord.fileName[MS_WARM_BOOT_NAME_LENGTH - 1] = '\0';
+        _fileName = String(bootRecord.fileName);
+#ifdef MS_LOGGER_FILE_ROTATION
+        _autoFileName = bootRecord.autoFileName;
+#endif
+        PRINTOUT(F("Warm boot; logging will go on in"), _fileName);
+    }
+#endif
+#ifdef MS_LOGGER_RETAINED_BUFFER
+    // Take back the records buffered before the reset
+    recoverRetainedBuffer();
+#endif
 
     PRINTOUT(F("Logger portion of setup finished.\n"));
 }
 
 
+#ifdef MS_WATCHDOG_PHASES
+uint8_t Logger::getLastOverrunPhase(void) {
+    return _lastOverrunPhase;
+}
+
+
+void Logger::startPhase(loggerPhase phase) {
+    static const uint16_t budgets[] = {
+        0,
+        MS_PHASE_BUDGET_SENSORS_S,
+        MS_PHASE_BUDGET_SD_WRITE_S,
+        MS_PHASE_BUDGET_CONNECT_S,
+        MS_PHASE_BUDGET_PUBLISH_S,
+        MS_PHASE_BUDGET_TIME_SYNC_S,
+    };
+    watchDogTimer.startPhase(phase, budgets[phase]);
+}
+
+
+void Logger::endPhase(void) {
+    if (watchDogTimer.phaseExpired()) {
+        _lastOverrunPhase = watchDogTimer._phase;
+        PRINTOUT(F("Phase"), _lastOverrunPhase, F("went over its budget"));
+    }
+    watchDogTimer.endPhase();
+}
+#endif
+
+
+#ifdef MS_LOGGER_WARM_BOOT
+bool Logger::isWarmBoot(void) {
+    return _warmBoot;
+}
+
+
+uint32_t Logger::getSetupFingerprint(void) {
+    uint32_t hash = bootHash(_loggerID, strlen(_loggerID), 2166136261UL);
+    uint32_t interval = getLoggingIntervalSeconds();
+    hash              = bootHash(&interval, sizeof(interval), hash);
+    // A new build may have changed anything
+    hash = bootHash(__DATE__ __TIME__, sizeof(__DATE__ __TIME__), hash);
+    for (uint8_t i = 0; i < getArrayVarCount(); i++) {
+        Variable*   var  = _internalArray->arrayOfVars[i];
+        const char* code = var->getVarCodeChars();
+        hash             = bootHash(code, strlen(code), hash);
+        if (!var->isCalculated) {
+            String sensor = var->getParentSensorNameAndLocation();
+            hash          = bootHash(sensor.c_str(), sensor.length(), hash);
+        }
+    }
+    return hash;
+}
+
+
+void Logger::saveBootRecord(void) {
+    // Nothing is kept until begin() has made the fingerprint
+    if (_setupFingerprint == 0) return;
+    bootRecord.magic       = MS_BOOT_RECORD_MAGIC;
+    bootRecord.fingerprint = _setupFingerprint;
+    bootRecord.clockSet    = isRTCSane();
+#ifdef MS_LOGGER_FILE_ROTATION
+    bootRecord.autoFileName = _autoFileName;
+#endif
+    // A name too long to keep whole would log to the wrong file
+    if (_fileName.length() >= MS_WARM_BOOT_NAME_LENGTH) {
+        bootRecord.magic = 0;
+        return;
+    }
+    _fileName.toCharArray(bootRecord.fileName, MS_WARM_BOOT_NAME_LENGTH);
+    bootRecord.check = bootRecordCheck();
+}
+#endif
+
+
 // This is a one-and-done to log data
 void Logger::logData(void) {
     // Reset the watchdog
@@ -1464,9 +4984,37 @@ void Logger::logData(void) {
 
     // Assuming we were woken up by the clock, check if the current time is an
     // even interval of the logging interval
+#if defined(MS_LOGGER_SAMPLING_GROUPS) || defined(MS_LOGGER_EVENT_TRIGGER)
+    bool logNow = checkInterval();
+#endif
+#ifdef MS_LOGGER_EVENT_TRIGGER
+    // Between logging intervals, wake to sample for the event trigger too
+    _eventWake = !logNow && checkEventInterval();
+    logNow |= _eventWake;
+#endif
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    // A wake that's only due for some sampling groups logs just those groups
+    uint8_t groupsDue = checkGroupIntervals(logNow);
+    if (!logNow && groupsDue != 0) {
+        Logger::isLoggingNow = true;
+        PRINTOUT(F("------------------------------------------"));
+        alertOn();
+        logSamplingGroups(groupsDue);
+        alertOff();
+        PRINTOUT(F("------------------------------------------\n"));
+        Logger::isLoggingNow = false;
+    }
+#endif
+#if defined(MS_LOGGER_SAMPLING_GROUPS) || defined(MS_LOGGER_EVENT_TRIGGER)
+    if (logNow) {
+#else
     if (checkInterval()) {
+#endif
         // Flag to notify that we're in already awake and logging a point
         Logger::isLoggingNow = true;
+#ifdef MS_LOGGER_PROFILE
+        LoggerProfiler::startCycle();
+#endif
         // Reset the watchdog
         watchDogTimer.resetWatchDog();
 
@@ -1474,27 +5022,104 @@ void Logger::logData(void) {
         PRINTOUT(F("------------------------------------------"));
         // Turn on the LED to show we're taking a reading
         alertOn();
+#ifndef MS_LOGGER_RECORD_BUFFER_SIZE
         // Power up the SD Card
         // TODO(SRGDamia1):  Decide how much delay is needed between turning on
         // the card and writing to it.  Could we turn it on just before writing?
         turnOnSDcard(false);
+#endif
 
         // Do a complete sensor update
         MS_DBG(F("    Running a complete sensor update..."));
         watchDogTimer.resetWatchDog();
+#ifdef MS_WATCHDOG_PHASES
+        startPhase(PHASE_SENSORS);
+#endif
+        MS_PROFILE_START(SPAN_SENSORS);
         _internalArray->completeUpdate();
+        MS_PROFILE_END(SPAN_SENSORS);
+#ifdef MS_WATCHDOG_PHASES
+        endPhase();
+#endif
         watchDogTimer.resetWatchDog();
+        // Take the values once for the log file, the serial output and the
+        // publishers to share
+        float        recordValues[getArrayVarCount()];
+        loggerRecord record;
+#ifdef MS_LOGGER_RESULT_TIMES
+        int32_t recordOffsets[_internalArray->getSensorListCount() + 1];
+        takeRecord(record, recordValues, recordOffsets);
+#else
+        takeRecord(record, recordValues);
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+        // The profile for the battery just measured is used from the next
+        // interval
+        applyPowerPolicy();
+#endif
 
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        // Between logging intervals the record is only saved during an event,
+        // otherwise it's kept in the pre-trigger ring
+        bool saveRecord = checkEventTrigger();
+#endif
+#ifdef MS_WATCHDOG_PHASES
+        startPhase(PHASE_SD_WRITE);
+#endif
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+        // Buffer the csv data record, the SD card is only powered when the
+        // buffer is written to the log file
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        if (saveRecord)
+#endif
+            bufferRecord();
+#else
         // Create a csv data record and save it to the log file
-        logToSD();
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        if (saveRecord)
+#endif
+            logToSD();
+#ifndef MS_LOGGER_PERSISTENT_SD
         // Cut power from the SD card, waiting for housekeeping
         turnOffSDcard(true);
+#endif
+#endif
+#ifdef MS_WATCHDOG_PHASES
+        endPhase();
+#endif
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+        // Sampling groups due at the same time share this wake
+        logSamplingGroups(groupsDue);
+#endif
+#ifdef MS_LOGGER_GATEWAY
+        // Only the records on the logging interval go to the gateway
+        bool gatewayDue = _gateway != nullptr;
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        gatewayDue = gatewayDue && !_eventWake;
+#endif
+        if (gatewayDue && _gateway->isGateway()) {
+            // Gather the nodes' records of this interval to publish with
+            // this one
+            _gateway->listen(Logger::markedUTCEpochTime -
+                             getLoggingIntervalSeconds() / 2);
+            watchDogTimer.resetWatchDog();
+        } else if (gatewayDue) {
+            _gateway->sendRecord(_record->utcEpoch, _record->values,
+                                 _record->valueCount);
+            watchDogTimer.resetWatchDog();
+        }
+#endif
 
         // Turn off the LED
         alertOff();
         // Print a line to show reading ended
         PRINTOUT(F("------------------------------------------\n"));
 
+        // The record only lasts until the end of the cycle
+        useRecord(nullptr);
+#ifdef MS_LOGGER_PROFILE
+        LoggerProfiler::endCycle();
+#endif
         // Unset flag
         Logger::isLoggingNow = false;
     }
@@ -1509,12 +5134,44 @@ void Logger::logData(void) {
 void Logger::logDataAndPublish(void) {
     // Reset the watchdog
     watchDogTimer.resetWatchDog();
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+    // Check before the measurements take up the second
+    bool publishWake = checkPublishSchedule();
+#endif
 
     // Assuming we were woken up by the clock, check if the current time is an
     // even interval of the logging interval
+#if defined(MS_LOGGER_SAMPLING_GROUPS) || defined(MS_LOGGER_EVENT_TRIGGER)
+    bool logNow = checkInterval();
+#endif
+#ifdef MS_LOGGER_EVENT_TRIGGER
+    // Between logging intervals, wake to sample for the event trigger too
+    _eventWake = !logNow && checkEventInterval();
+    logNow |= _eventWake;
+#endif
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    // A wake that's only due for some sampling groups logs just those groups
+    uint8_t groupsDue = checkGroupIntervals(logNow);
+    if (!logNow && groupsDue != 0) {
+        Logger::isLoggingNow = true;
+        PRINTOUT(F("------------------------------------------"));
+        alertOn();
+        logSamplingGroups(groupsDue);
+        alertOff();
+        PRINTOUT(F("------------------------------------------\n"));
+        Logger::isLoggingNow = false;
+    }
+#endif
+#if defined(MS_LOGGER_SAMPLING_GROUPS) || defined(MS_LOGGER_EVENT_TRIGGER)
+    if (logNow) {
+#else
     if (checkInterval()) {
+#endif
         // Flag to notify that we're in already awake and logging a point
         Logger::isLoggingNow = true;
+#ifdef MS_LOGGER_PROFILE
+        LoggerProfiler::startCycle();
+#endif
         // Reset the watchdog
         watchDogTimer.resetWatchDog();
 
@@ -1522,10 +5179,61 @@ void Logger::logDataAndPublish(void) {
         PRINTOUT(F("------------------------------------------"));
         // Turn on the LED to show we're taking a reading
         alertOn();
+#ifndef MS_LOGGER_RECORD_BUFFER_SIZE
         // Power up the SD Card
         // TODO(SRGDamia1):  Decide how much delay is needed between turning on
         // the card and writing to it.  Could we turn it on just before writing?
         turnOnSDcard(false);
+#endif
+
+        // Only the records on the logging interval are published, and on a
+        // marginal link (#MS_LOGGER_ADAPTIVE_PUBLISH) they wait in the outbox
+        bool publishNow = _logModem != nullptr;
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        publishNow = publishNow && !_eventWake;
+#endif
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+        bool holdRecord = publishNow && !checkPublishDue();
+#elif defined(MS_LOGGER_CONNECT_BACKOFF) ||                             \
+    defined(MS_LOGGER_POWER_POLICY) || defined(MS_PUBLISHER_SEND_INTERVAL) || \
+    defined(MS_LOGGER_PUBLISH_SCHEDULE)
+        bool holdRecord = false;
+#endif
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+        // After failed connections, wait longer before trying again
+        holdRecord = holdRecord || (publishNow && !checkConnectDue());
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+        // On a low battery, records are saved up and published together
+        holdRecord = holdRecord || (publishNow && !checkPowerPublishDue());
+#endif
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+        // The modem is only woken when a publisher's send interval is up
+        _sendDue   = publishNow ? countPublisherRecords() : 0;
+        holdRecord = holdRecord || (publishNow && _sendDue == 0);
+#endif
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+        // With a publish schedule, the records wait for the publish times
+        holdRecord = holdRecord || (publishNow && _publishIntervalMinutes != 0);
+#endif
+#if defined(MS_LOGGER_ADAPTIVE_PUBLISH) ||                             \
+    defined(MS_LOGGER_CONNECT_BACKOFF) || defined(MS_LOGGER_POWER_POLICY) || \
+    defined(MS_PUBLISHER_SEND_INTERVAL) || defined(MS_LOGGER_PUBLISH_SCHEDULE)
+        publishNow = publishNow && !holdRecord;
+#endif
+
+#ifdef MS_LOGGER_OVERLAP_MODEM
+        // Start connecting first so the modem can register on the network
+        // while the sensors are updated
+        bool modemAwake = false;
+        if (publishNow) {
+            MS_DBG(F("Starting to connect"), _logModem->getModemName(),
+                   F("..."));
+            beginModemConnect();
+            modemAwake = true;
+            _internalArray->setUpdatePoll(pollModemConnect, this);
+        }
+#endif
 
         // Do a complete update on the variable array.
         // This this includes powering all of the sensors, getting updated
@@ -1534,8 +5242,34 @@ void Logger::logDataAndPublish(void) {
         // run if the sensor was not previously set up.
         MS_DBG(F("Running a complete sensor update..."));
         watchDogTimer.resetWatchDog();
+#ifdef MS_WATCHDOG_PHASES
+        startPhase(PHASE_SENSORS);
+#endif
+        MS_PROFILE_START(SPAN_SENSORS);
         _internalArray->completeUpdate();
+        MS_PROFILE_END(SPAN_SENSORS);
+#ifdef MS_LOGGER_OVERLAP_MODEM
+        _internalArray->setUpdatePoll(nullptr, nullptr);
+#endif
+#ifdef MS_WATCHDOG_PHASES
+        endPhase();
+#endif
         watchDogTimer.resetWatchDog();
+        // Take the values once for the log file, the serial output and the
+        // publishers to share
+        float        recordValues[getArrayVarCount()];
+        loggerRecord record;
+#ifdef MS_LOGGER_RESULT_TIMES
+        int32_t recordOffsets[_internalArray->getSensorListCount() + 1];
+        takeRecord(record, recordValues, recordOffsets);
+#else
+        takeRecord(record, recordValues);
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+        // The profile for the battery just measured is used from the next
+        // interval
+        applyPowerPolicy();
+#endif
 
 // Print out the sensor data
 #if defined(STANDARD_SERIAL_OUTPUT)
@@ -1544,27 +5278,168 @@ void Logger::logDataAndPublish(void) {
         MS_DBG('\n');
 #endif
 
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        // Between logging intervals the record is only saved during an event,
+        // otherwise it's kept in the pre-trigger ring
+        bool saveRecord = checkEventTrigger();
+#endif
+#ifdef MS_WATCHDOG_PHASES
+        startPhase(PHASE_SD_WRITE);
+#endif
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+        // Buffer the csv data record, the SD card is only powered when the
+        // buffer is written to the log file
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        if (saveRecord)
+#endif
+            bufferRecord();
+#else
         // Create a csv data record and save it to the log file
-        logToSD();
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        if (saveRecord)
+#endif
+            logToSD();
+#endif
+#ifdef MS_WATCHDOG_PHASES
+        endPhase();
+#endif
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+        // Sampling groups due at the same time share this wake
+        logSamplingGroups(groupsDue);
+#endif
+#ifdef MS_LOGGER_GATEWAY
+        // Only the records on the logging interval go to the gateway
+        bool gatewayDue = _gateway != nullptr;
+#ifdef MS_LOGGER_EVENT_TRIGGER
+        gatewayDue = gatewayDue && !_eventWake;
+#endif
+        if (gatewayDue && _gateway->isGateway()) {
+            // Gather the nodes' records of this interval to publish with
+            // this one
+            _gateway->listen(Logger::markedUTCEpochTime -
+                             getLoggingIntervalSeconds() / 2);
+            watchDogTimer.resetWatchDog();
+        } else if (gatewayDue) {
+            _gateway->sendRecord(_record->utcEpoch, _record->values,
+                                 _record->valueCount);
+            watchDogTimer.resetWatchDog();
+        }
+#endif
 
-        if (_logModem != nullptr) {
+#if defined(MS_LOGGER_ADAPTIVE_PUBLISH) ||                             \
+    defined(MS_LOGGER_CONNECT_BACKOFF) || defined(MS_LOGGER_POWER_POLICY) || \
+    defined(MS_PUBLISHER_SEND_INTERVAL) || defined(MS_LOGGER_PUBLISH_SCHEDULE)
+        if (holdRecord) {
+            MS_DBG(F("Holding the record in the outbox until the next "
+                     "publication"));
+            queueOutboxRecord(getPublisherBits());
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+            if (_oldestUnpublished == 0) {
+                _oldestUnpublished = Logger::markedUTCEpochTime;
+            }
+#endif
+        }
+#endif
+        if (publishNow) {
+#ifdef MS_PUBLISHER_OUTBOX
+            bool published = false;
+#endif
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+            uint32_t connectTime = 0;
+#endif
+#if defined(MS_LOGGER_ADAPTIVE_PUBLISH) || \
+    defined(MS_LOGGER_CONNECT_BACKOFF) || defined(MS_MODEM_WARM_STANDBY)
+            bool connected = false;
+#endif
+#ifdef MS_LOGGER_OVERLAP_MODEM
+            if (modemAwake) {
+#else
             MS_DBG(F("Waking up"), _logModem->getModemName(), F("..."));
-            if (_logModem->modemWake()) {
+            MS_PROFILE_START(SPAN_MODEM_WAKE);
+            bool modemAwake = wakeModem();
+            MS_PROFILE_END(SPAN_MODEM_WAKE);
+            if (modemAwake) {
+#endif
                 // Connect to the network
                 watchDogTimer.resetWatchDog();
+#ifdef MS_WATCHDOG_PHASES
+                startPhase(PHASE_CONNECT);
+#endif
                 MS_DBG(F("Connecting to the Internet..."));
-                if (_logModem->connectInternet()) {
+                MS_PROFILE_START(SPAN_CONNECT);
+#if defined(MS_LOGGER_ADAPTIVE_PUBLISH) || \
+    defined(MS_LOGGER_CONNECT_BACKOFF) || defined(MS_MODEM_WARM_STANDBY)
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+                uint32_t connectStart = millis();
+#endif
+                connected = connectModem();
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+                connectTime = millis() - connectStart;
+#endif
+                MS_PROFILE_END(SPAN_CONNECT);
+                if (connected) {
+#else
+                bool connected = connectModem();
+                MS_PROFILE_END(SPAN_CONNECT);
+                if (connected) {
+#endif
+#ifdef MS_WATCHDOG_PHASES
+                    endPhase();
+#endif
                     // Publish data to remotes
                     watchDogTimer.resetWatchDog();
+#ifdef MS_WATCHDOG_PHASES
+                    startPhase(PHASE_PUBLISH);
+#endif
                     publishDataToRemotes();
                     watchDogTimer.resetWatchDog();
+#ifdef MS_LOGGER_GATEWAY
+                    if (_gateway != nullptr && _gateway->isGateway()) {
+                        publishNodeRecords();
+                        watchDogTimer.resetWatchDog();
+                    }
+#endif
+#ifdef MS_PUBLISHER_OUTBOX
+                    published = true;
+                    // Keep this record for any remote that didn't take it,
+                    // then catch up on the older ones
+                    queueOutboxRecord(_publishFailures);
+#ifdef MS_LOGGER_BACKFILL
+                    if (_backfillPublishers != 0) { queueBackfill(); }
+#endif
+                    replayOutbox(_publishFailures);
+                    watchDogTimer.resetWatchDog();
+#endif
+#ifdef MS_WATCHDOG_PHASES
+                    endPhase();
+#endif
 
-                    if ((Logger::markedLocalEpochTime != 0 &&
-                         Logger::markedLocalEpochTime % 86400 == 43200) ||
-                        !isRTCSane(Logger::markedLocalEpochTime)) {
+                    // Sync at the first log at or after noon; a stretched
+                    // interval may not land on noon itself
+                    bool noonSync = Logger::markedLocalEpochTime != 0 &&
+                        (Logger::markedLocalEpochTime + 43200) % 86400 <
+                            getLoggingIntervalSeconds();
+#ifdef MS_LOGGER_DRIFT_SYNC
+                    noonSync = noonSync && checkClockSyncDue();
+#endif
+#ifdef MS_PUBLISHER_DATE_SYNC
+                    // Skip the sync while the receivers give their time
+                    noonSync = noonSync &&
+                        (_lastServerTime == 0 ||
+                         Logger::markedUTCEpochTime - _lastServerTime > 86400L);
+#endif
+                    if (noonSync || !isRTCSane(Logger::markedLocalEpochTime)) {
                         // Sync the clock at noon
                         MS_DBG(F("Running a daily clock sync..."));
+#ifdef MS_WATCHDOG_PHASES
+                        startPhase(PHASE_TIME_SYNC);
+#endif
+                        MS_PROFILE_START(SPAN_TIME_SYNC);
                         setRTClock(_logModem->getNISTTime());
+                        MS_PROFILE_END(SPAN_TIME_SYNC);
+#ifdef MS_WATCHDOG_PHASES
+                        endPhase();
+#endif
                         watchDogTimer.resetWatchDog();
                     }
 
@@ -1573,33 +5448,85 @@ void Logger::logDataAndPublish(void) {
                     _logModem->updateModemMetadata();
 
                     // Disconnect from the network
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+                    dataPublisher::closeKeptConnection();
+#endif
+                    MS_PROFILE_START(SPAN_MODEM_SLEEP);
+#ifndef MS_MODEM_WARM_STANDBY
+                    // In warm standby, the modem is only disconnected if it's
+                    // powered down
                     MS_DBG(F("Disconnecting from the Internet..."));
                     _logModem->disconnectInternet();
+#endif
                 } else {
+#ifdef MS_WATCHDOG_PHASES
+                    endPhase();
+#endif
                     MS_DBG(F("Could not connect to the internet!"));
                     watchDogTimer.resetWatchDog();
                 }
             }
+#ifdef MS_PUBLISHER_OUTBOX
+            if (!published) {
+                // None of the remotes got this record
+                queueOutboxRecord(getPublisherBits());
+            }
+#endif
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+            updatePublishHistory(published, connectTime);
+#endif
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+            updateConnectBackoff(connected);
+#endif
             // Turn the modem off
+            MS_PROFILE_START(SPAN_MODEM_SLEEP);
+#ifdef MS_MODEM_WARM_STANDBY
+            // or leave it registered if the next publish is soon enough
+            uint32_t nextPublish = Logger::markedUTCEpochTime +
+                getLoggingIntervalSeconds();
+            uint32_t nowUTC = getNowUTCEpoch();
+            _logModem->modemStandby(
+                nextPublish > nowUTC ? (nextPublish - nowUTC) * 1000UL : 0,
+                connected);
+#else
             _logModem->modemSleepPowerDown();
+#endif
+            MS_PROFILE_END(SPAN_MODEM_SLEEP);
         }
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+        // Anything else publishing sends to every publisher
+        _sendDue = 0xFF;
+#endif
 
 
+#if (!defined(MS_LOGGER_RECORD_BUFFER_SIZE) || \
+     defined(MS_PUBLISHER_OUTBOX)) &&          \
+    !defined(MS_LOGGER_PERSISTENT_SD)
         // Cut power from the SD card - without additional housekeeping wait
         // TODO(SRGDamia1):  Do some sort of verification that minimum 1 sec has
         // passed for internal SD card housekeeping before cutting power -
         // although it seems very unlikely based on my testing that less than
         // one second would be taken up in publishing data to remotes.
         turnOffSDcard(false);
+#endif
 
         // Turn off the LED
         alertOff();
         // Print a line to show reading ended
         PRINTOUT(F("------------------------------------------\n"));
 
+        // The record only lasts until the end of the cycle
+        useRecord(nullptr);
+#ifdef MS_LOGGER_PROFILE
+        LoggerProfiler::endCycle();
+#endif
         // Unset flag
         Logger::isLoggingNow = false;
     }
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+    // The publication gets its own part of the wake, after any measurements
+    if (publishWake) { publishScheduled(); }
+#endif
 
     // Check if it was instead the testing interrupt that woke us up
     if (Logger::startTesting) testingMode();
@@ -65,542 +65,2584 @@
 #endif
 
 #include <SdFat.h>  // To communicate with the SD card
+#ifdef MS_LOGGER_RECORD_STORE
+#include "LoggerRecordStore.h"
+#endif
+#if defined(MS_LOGGER_SD_DMA) && defined(ARDUINO_ARCH_SAMD)
+#include "LoggerSdSpiDMA.h"
+#endif
+#ifdef MS_LOGGER_SECTOR_WRITER
+#include "LoggerSectorWriter.h"
+#endif
+#include "LoggerProfiler.h"
+#ifdef MS_LOGGER_GATEWAY
+#include "LoggerGateway.h"
+#endif
+#ifdef MS_LOGGER_FAILOVER
+#include "LoggerLinks.h"
+#endif
 
 /**
  * @brief The largest number of variables from a single sensor
  */
 #define MAX_NUMBER_SENDERS 4
 
+/**
+ * @def MS_LOGGER_RECORD_BUFFER_SIZE
+ * @brief Define this build flag to collect this many bytes of data records in
+ * RAM and only power up and write to the SD card once the buffer is full.
+ *
+ * Each record is the same comma separated line that would otherwise be
+ * written straight to the card.  The buffer is also written out after a set
+ * number of records (Logger::setRecordsPerFlush()) or whenever a check given
+ * to Logger::setFlushCheck() - ie, for a low battery - says it should be.
+ *
+ * @note Records still in the buffer are lost if the logger resets or loses
+ * power, unless it's kept through resets (#MS_LOGGER_RETAINED_BUFFER).
+ */
+// #define MS_LOGGER_RECORD_BUFFER_SIZE 1024
+
+/**
+ * @def MS_LOGGER_RECORD_STORE
+ * @brief With #MS_LOGGER_RECORD_BUFFER_SIZE, define this build flag to keep
+ * the buffered records in non-volatile memory, like an FRAM chip, given to
+ * Logger::setRecordStore().
+ *
+ * Each record is written to the store as it's taken, so the store can hold
+ * many more records than RAM could and they survive a reset or a power loss;
+ * records left in the store are found again and written out with the next
+ * ones.  The records are written to the card when the store is full, and as
+ * set by Logger::setRecordsPerFlush() and Logger::setFlushCheck().  The RAM
+ * buffer only carries one record to the store, or a piece of the store to the
+ * card, so it can be small.  If the card can't be written, the records are
+ * kept in the store to try again.
+ */
+// #define MS_LOGGER_RECORD_STORE
+
+/**
+ * @def MS_LOGGER_RETAINED_BUFFER
+ * @brief With #MS_LOGGER_RECORD_BUFFER_SIZE, define this build flag to keep
+ * the record buffer in RAM that isn't cleared on reset
+ * (#MS_RETAINED_SECTION), so the records taken before a watchdog reset or a
+ * brown-out still reach the SD card.
+ *
+ * A header next to the buffer keeps the number of records and bytes in it,
+ * a hash of the records, and a check of the header itself; it's brought up to
+ * date as each record is buffered.  Logger::begin() only takes the records
+ * back if both match and they were made for the same number of variables;
+ * they're written out with the next ones.  Records are still lost if the
+ * board loses power altogether.
+ *
+ * This can't be used with a record store (#MS_LOGGER_RECORD_STORE), which
+ * already keeps the records through a reset.  The records are let go just
+ * before they're written to the card, so a reset during the write loses
+ * them rather than writing them twice.
+ */
+// #define MS_LOGGER_RETAINED_BUFFER
+#ifdef MS_LOGGER_RETAINED_BUFFER
+#ifdef MS_LOGGER_RECORD_STORE
+#error MS_LOGGER_RETAINED_BUFFER cannot be used with MS_LOGGER_RECORD_STORE
+#endif
+#ifndef MS_RETAINED_SECTION
+#if defined(ARDUINO_ARCH_AVR)
+/**
+ * @brief The linker section that holds the retained record buffer.
+ *
+ * It must not be cleared at start up, and the buffer must fit in it.  AVR
+ * boards keep `.noinit`.  The stock linker scripts of the SAMD cores have no
+ * such section, so on those boards this must be set to one added to the
+ * board's linker script, ie, the backup RAM of a SAMD51.
+ */
+#define MS_RETAINED_SECTION ".noinit"
+#else
+#error MS_LOGGER_RETAINED_BUFFER needs MS_RETAINED_SECTION on this board
+#endif
+#endif
+#endif
+
+#ifndef MS_LOGGER_LINE_BUFFER_SIZE
+/**
+ * @brief The size of the buffer a csv data record is made in before it's
+ * written to the log file and echoed to the serial port.
+ *
+ * A record that doesn't fit is printed straight to each of them instead.
+ */
+#define MS_LOGGER_LINE_BUFFER_SIZE 160
+#endif
+
+/**
+ * @def MS_LOGGER_HEADER_CACHE
+ * @brief Define this build flag to put together the rows of the file header
+ * once, in Logger::begin(), and write them to each new log file in one go.
+ *
+ * Everything after the file name line - the sensor names, variable names,
+ * units, UUIDs, and variable codes - is the same for every file, so it's kept
+ * in a buffer of #MS_LOGGER_HEADER_CACHE_SIZE bytes.  A header that doesn't
+ * fit is printed a piece at a time, as without the flag, and begin() prints
+ * the size it needs.  The cached rows are only used for the logger's own
+ * variable array, not for the files of sampling groups.  Set the time zone
+ * and the variable array before Logger::begin().
+ */
+// #define MS_LOGGER_HEADER_CACHE
+#if defined(MS_LOGGER_HEADER_CACHE) && !defined(MS_LOGGER_HEADER_CACHE_SIZE)
+#if defined(ARDUINO_ARCH_AVR)
+/**
+ * @brief The size of the buffer the file header rows are kept in
+ * (#MS_LOGGER_HEADER_CACHE).
+ *
+ * Each variable takes about 120 bytes of the rows, so the AVR default covers
+ * about 8 variables and the default for other boards about 16.
+ */
+#define MS_LOGGER_HEADER_CACHE_SIZE 1024
+#else
+#define MS_LOGGER_HEADER_CACHE_SIZE 2048
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_PERSISTENT_SD
+ * @brief Define this build flag to keep the SD card powered and mounted and
+ * the log file open between records.
+ *
+ * The card is only mounted once and the log file is only opened once; each
+ * record (or each write of the record buffer, with
+ * #MS_LOGGER_RECORD_BUFFER_SIZE) is followed by a sync of the file instead of
+ * a close.  A new log file is given a contiguous run of
+ * #MS_LOGGER_PREALLOCATE_SIZE bytes so the file system tables don't need to
+ * be updated as it grows; the unused end of that space is cut off again
+ * whenever the file is closed.  The file timestamps are only set when it is
+ * created.
+ *
+ * Any call to Logger::turnOffSDcard() closes the file and ends the session;
+ * the next write mounts the card again.
+ */
+// #define MS_LOGGER_PERSISTENT_SD
+
+/**
+ * @def MS_LOGGER_SECTOR_WRITER
+ * @brief Define this build flag to gather what's appended to the log file
+ * into whole 512 byte sectors and write them to the card together, through a
+ * LoggerSectorWriter.
+ *
+ * This also turns on #MS_LOGGER_PERSISTENT_SD.  Each batch of
+ * #MS_SECTOR_WRITER_SECTORS sectors goes to the preallocated file in one
+ * multi-block write, and the file is only synced after a batch has been
+ * written instead of after every record.  The last part of a sector is
+ * written when the file is closed, including by Logger::turnOffSDcard().
+ *
+ * @note Up to #MS_SECTOR_WRITER_SECTORS sectors of records are only in RAM
+ * and are lost if the logger resets or loses power before they're written.
+ */
+// #define MS_LOGGER_SECTOR_WRITER
+
+#if defined(MS_LOGGER_SECTOR_WRITER) && !defined(MS_LOGGER_PERSISTENT_SD)
+#define MS_LOGGER_PERSISTENT_SD
+#endif
+
+/**
+ * @def MS_LOGGER_SHARED_SD
+ * @brief Define this build flag to let several loggers that write to the same
+ * SD card, like those of the `double_logger` example, share one file system
+ * and one mount of the card.
+ *
+ * Every logger uses the same SdFat instance.  Between
+ * Logger::openSDSession() and Logger::closeSDSession() the card is mounted
+ * once for all of the loggers and Logger::turnOffSDcard() leaves it powered,
+ * so writing each logger's file - a record, a flush of its record buffer, or
+ * a move to a new file - costs one mount and one housekeeping wait in all.
+ * Turn the card off once the session is closed; the `double_logger` and
+ * `data_saving` examples show how.  With #MS_LOGGER_PERSISTENT_SD the mount
+ * is kept for all of the loggers, and turning the card off closes every
+ * logger's file.
+ */
+// #define MS_LOGGER_SHARED_SD
+
+/**
+ * @def MS_LOGGER_JOURNAL
+ * @brief Define this build flag to keep a small journal of the last good end
+ * of the log file, so a logger that lost power in the middle of a write goes
+ * back to appending whole records.
+ *
+ * Each time the main log file is saved - after every record, or every write
+ * of the record buffer - its name and the end of its data are written to the
+ * journal
+ * (#MS_JOURNAL_SUFFIX) with a sequence number and a check.  The journal
+ * holds two entries that are written in turn, so a write cut short always
+ * leaves the other one good.  The first time the log file is opened after a
+ * restart, only what was written after the newest good entry is looked at:
+ * a text file is cut back to its last whole line and a binary one to the
+ * size in the journal, so the next record doesn't run on from a partial one.
+ * With #MS_LOGGER_PERSISTENT_SD this also gives back the space preallocated
+ * for a file that was never closed.  A partial record at the end of the
+ * outbox is dropped the same way.  The files of sampling groups aren't
+ * journaled.
+ * Nothing is ever read from the start of the file, however large it is.
+ */
+// #define MS_LOGGER_JOURNAL
+#ifdef MS_LOGGER_JOURNAL
+/**
+ * @brief The end of the journal file name, which starts with the logger id.
+ */
+#define MS_JOURNAL_SUFFIX "_journal.bin"
+#ifndef MS_JOURNAL_MAX_TAIL
+/**
+ * @brief The most bytes after the journaled size of the log file that are
+ * looked at after a restart.
+ *
+ * A longer tail means the journal fell behind the file, and the file is
+ * left as it is - unless it is still exactly its preallocated size.
+ */
+#define MS_JOURNAL_MAX_TAIL 4096UL
+#endif
+#endif
+
+#if defined(MS_LOGGER_PERSISTENT_SD) && !defined(MS_LOGGER_PREALLOCATE_SIZE)
+/**
+ * @brief The number of bytes to reserve on the card for each new log file
+ * with #MS_LOGGER_PERSISTENT_SD.
+ */
+#define MS_LOGGER_PREALLOCATE_SIZE 1048576UL
+#endif
+
+/**
+ * @def MS_LOGGER_SD_STAMP_MINUTES
+ * @brief Define this build flag to a number of minutes to only set the
+ * modified and accessed times of the log file that often, instead of each
+ * time a record is saved.
+ *
+ * Each timestamp is written straight to the file's directory entry, so
+ * stamping every record rewrites that sector twice more than the record
+ * needs and reads the RTC again.  The file is still stamped when it's
+ * created, so also when #MS_LOGGER_FILE_ROTATION moves on to a new one, and
+ * at the first record saved after a restart.  Set it to 0 to only stamp it
+ * then.
+ */
+// #define MS_LOGGER_SD_STAMP_MINUTES 60
+
+/**
+ * @def MS_LOGGER_SD_DMA
+ * @brief Define this build flag to move the SD card's data blocks with DMA on
+ * SAMD boards, through the LoggerSdSpiDMA driver.
+ *
+ * SdFat has to be built with `SPI_DRIVER_SELECT=3` (as a build flag, so it
+ * reaches SdFat's own source) to take the driver.  Each sector then goes out
+ * at the full SPI clock instead of a byte at a time from the processor, which
+ * shortens the time the card is powered for a write, most of all when
+ * writing the buffered records of #MS_LOGGER_RECORD_BUFFER_SIZE.  AVR boards
+ * ignore this flag.
+ */
+// #define MS_LOGGER_SD_DMA
+
+/**
+ * @def MS_LOGGER_BINARY_FORMAT
+ * @brief Define this build flag to save data to the SD card as compact binary
+ * records instead of comma separated text.
+ *
+ * A binary log file starts with #MS_BINARY_LOG_MAGIC, a format version byte
+ * (#MS_BINARY_LOG_VERSION), and the number of variables.  That is followed by
+ * the same text header a csv file has, ended by a null, and then the decimal
+ * resolution of each variable, one byte each.  Every record after that is the
+ * logger's local epoch time as a uint32_t and the value of each variable as a
+ * float, all little-endian.  Auto-generated file names end in ".bin".
+ *
+ * The extras/binary_to_csv sketch turns a binary file back into exactly the
+ * csv that would have been written without this flag.
+ */
+// #define MS_LOGGER_BINARY_FORMAT
+
+/**
+ * @brief The first four bytes of a binary log file
+ */
+#define MS_BINARY_LOG_MAGIC "MSLB"
+/**
+ * @def MS_LOGGER_DELTA_ENCODING
+ * @brief With #MS_LOGGER_BINARY_FORMAT, define this build flag to store each
+ * binary record as the change from the record before it.
+ *
+ * Each value is stored as a whole number in units of the variable's
+ * resolution (so a resolution of 2 stores hundredths), and each record holds
+ * only the difference from the last record of each value, as a zigzag
+ * varint.  Values that barely change then take a single byte.  The file header
+ * is the same as without this flag, with version 2 and one more byte with
+ * #MS_DELTA_KEYFRAME_INTERVAL after the resolutions.
+ *
+ * Each record starts with a tag byte:
+ * - 'K' (a keyframe): the local epoch time as a uint32_t, then each value as a
+ * zigzag varint of the whole value.  A file starts with a keyframe, and so
+ * does every #MS_DELTA_KEYFRAME_INTERVAL'th record, any record after a
+ * restart, and any record whose file was last written by another variable
+ * array (ie, a sampling group).  Decoding can start at any keyframe.
+ * - 'D' (a delta): the change in time, then the change in each value, all as
+ * zigzag varints.
+ *
+ * The extras/binary_to_csv sketch reads both versions.
+ *
+ * @note Values are kept to the resolution of the variable, exactly as they
+ * would be written to a csv, but whole numbers past ±2147483647 units are
+ * cut off there.
+ */
+// #define MS_LOGGER_DELTA_ENCODING
+
+/**
+ * @brief The version of the binary log file layout; 2 with
+ * #MS_LOGGER_DELTA_ENCODING
+ */
+#ifdef MS_LOGGER_DELTA_ENCODING
+#define MS_BINARY_LOG_VERSION 2
+#else
+#define MS_BINARY_LOG_VERSION 1
+#endif
+
+#ifndef MS_DELTA_KEYFRAME_INTERVAL
+/**
+ * @brief With #MS_LOGGER_DELTA_ENCODING, the longest run of records between
+ * keyframes, up to 255.
+ */
+#define MS_DELTA_KEYFRAME_INTERVAL 60
+#endif
+
+#ifndef MS_DELTA_MAX_VARIABLES
+/**
+ * @brief With #MS_LOGGER_DELTA_ENCODING, the most variables the last record is
+ * kept for.  A record of more variables is always written as a keyframe.
+ */
+#define MS_DELTA_MAX_VARIABLES 32
+#endif
+
+/**
+ * @def MS_LOGGER_FILE_ROTATION
+ * @brief Define this build flag to start a new auto-named log file every day
+ * and/or whenever the current one reaches a set size, and keep an index of
+ * the files.
+ *
+ * Files are rotated daily by default; use Logger::setLogRotation() to change
+ * that or to set a largest file size.  Extra files for the same day are named
+ * with a sequence number, ie, "MyLogger_2024-01-01_1.csv".  File names set
+ * with Logger::setFileName() are never rotated.
+ *
+ * The index file (#MS_LOG_INDEX_SUFFIX) has one fixed-width line per log file
+ * with the local epoch time of the first and last record in it, the number of
+ * records, and the file name.  The line for the current file is rewritten in
+ * place each time records are saved, so the index never needs to be scanned
+ * to append to it.
+ *
+ * @note Buffered records (#MS_LOGGER_RECORD_BUFFER_SIZE) are all written to
+ * the file that is current when the buffer is written.
+ */
+// #define MS_LOGGER_FILE_ROTATION
+
+/**
+ * @brief The end of the index file name, which starts with the logger id
+ */
+#define MS_LOG_INDEX_SUFFIX "_index.csv"
+
+/**
+ * @def MS_PUBLISHER_OUTBOX
+ * @brief Define this build flag to keep records that couldn't be published in
+ * an outbox on the SD card and send them once the internet is back.
+ *
+ * When Logger::logDataAndPublish() can't connect to the internet, or a
+ * publisher's response isn't a success (dataPublisher::publishSucceeded()),
+ * the record is added to the outbox (#MS_OUTBOX_SUFFIX) with a bit set for
+ * each publisher still waiting for it.  After the next successful
+ * publication, the waiting records are sent oldest first until the outbox is
+ * empty or the time set with Logger::setOutboxBudget() is used up.  A
+ * publisher that fails while catching up isn't tried again until the next
+ * connection.  Publishers that take batches (dataPublisher::publishesBatches())
+ * are sent up to #MS_OUTBOX_BATCH_SIZE records in each request.
+ *
+ * Each outbox record is fixed size - the UTC epoch time, the waiting
+ * publisher bits, and a float per variable - so the bits are updated in place
+ * and the position of the oldest waiting record is kept at the start of the
+ * file.  The outbox is emptied once every record has been sent, and started
+ * over if the number of variables changes.
+ */
+// #define MS_PUBLISHER_OUTBOX
+
+/**
+ * @def MS_LOGGER_ADAPTIVE_PUBLISH
+ * @brief Define this build flag to hold records in the outbox instead of
+ * publishing them when the last connection was marginal, and send them in
+ * one later connection.
+ *
+ * Set the policy with Logger::setPublishPolicy().  A connection is marginal
+ * if it failed, a publisher failed, the internet connection took longer than
+ * the set time, or the modem's RSSI was below the set level.  After a good
+ * connection every record is published right away; after marginal ones the
+ * logger waits before trying again, twice as long after each marginal
+ * connection in a row (up to 64 logging intervals), but never so long that
+ * the oldest record waiting is later than the maximum data latency.
+ *
+ * This turns on #MS_PUBLISHER_OUTBOX.
+ */
+// #define MS_LOGGER_ADAPTIVE_PUBLISH
+
+#if defined(MS_LOGGER_ADAPTIVE_PUBLISH) && !defined(MS_PUBLISHER_OUTBOX)
+#define MS_PUBLISHER_OUTBOX
+#endif
+
+/**
+ * @def MS_LOGGER_CONNECT_BACKOFF
+ * @brief Define this build flag to try connecting less often while the modem
+ * can't connect, ie, at a site that has lost coverage.
+ *
+ * After each failed connection in a row the logger waits twice as long
+ * before trying again - one logging interval after the first failure, two
+ * after the second, and so on up to the time set with
+ * Logger::setConnectBackoff().  Before the full connection attempt the modem
+ * is given up to #MS_LOGGER_SIGNAL_CHECK_MS to report any signal at all; if
+ * it doesn't, the logger gives up without waiting out the whole connection
+ * time.  That isn't counted as a failure, and the next attempt skips the
+ * check, so a modem that's slow to attach still gets its whole connection
+ * time every other try.  The failure count and the time of the next try are
+ * saved on the SD card (#MS_BACKOFF_SUFFIX) so they survive a restart, and the
+ * records logged in the meantime wait in the outbox.
+ *
+ * This turns on #MS_PUBLISHER_OUTBOX.
+ */
+// #define MS_LOGGER_CONNECT_BACKOFF
+
+#ifdef MS_LOGGER_CONNECT_BACKOFF
+#ifndef MS_PUBLISHER_OUTBOX
+#define MS_PUBLISHER_OUTBOX
+#endif
+/**
+ * @brief The end of the file name for the connection failure history, which
+ * starts with the logger id
+ */
+#define MS_BACKOFF_SUFFIX "_backoff.bin"
+#ifndef MS_LOGGER_SIGNAL_CHECK_MS
+/**
+ * @brief The longest time in milliseconds to wait for the modem to report any
+ * signal before trying to connect.
+ */
+#define MS_LOGGER_SIGNAL_CHECK_MS 20000L
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_BACKFILL
+ * @brief Define this build flag to let a receiver ask for the records of a
+ * time range to be sent again from the log files, ie, to fill a gap after an
+ * outage.
+ *
+ * A receiver asks with an `X-Backfill: <from>,<to>` header on an http
+ * response, or with a `<from>,<to>` message on the command topic of an
+ * MQTTPublisher (MQTTPublisher::setCommandTopic()); both times are UTC Unix
+ * times and the range includes them.  Logger::requestBackfill() can also be
+ * called directly.  The records are only sent to the publisher that asked.
+ *
+ * The log files are found with the index of #MS_LOGGER_FILE_ROTATION.  Each
+ * time the outbox has been emptied, up to #MS_BACKFILL_RECORDS records of
+ * the range are copied from the log files into the outbox, where they're
+ * sent like any other waiting record: in batches to the publishers that take
+ * them and within the time set with Logger::setOutboxBudget().  The rest of
+ * the range is picked up on the next wakes until it's all been sent.  Binary
+ * log files are read too, except those with #MS_LOGGER_DELTA_ENCODING.
+ *
+ * @note The range is kept in memory, so a restart forgets it.
+ *
+ * This turns on #MS_PUBLISHER_OUTBOX and #MS_LOGGER_FILE_ROTATION.
+ */
+// #define MS_LOGGER_BACKFILL
+
+#ifdef MS_LOGGER_BACKFILL
+#ifndef MS_PUBLISHER_OUTBOX
+#define MS_PUBLISHER_OUTBOX
+#endif
+#ifndef MS_LOGGER_FILE_ROTATION
+#define MS_LOGGER_FILE_ROTATION
+#endif
+#ifndef MS_BACKFILL_RECORDS
+/**
+ * @brief The most records of a backfill copied into the outbox on each wake.
+ */
+#define MS_BACKFILL_RECORDS 96
+#endif
+#ifndef MS_BACKFILL_LINE_SIZE
+/**
+ * @brief The longest line of a csv log file read for a backfill; the buffer
+ * is on the stack.
+ */
+#define MS_BACKFILL_LINE_SIZE 192
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_POWER_POLICY
+ * @brief Define this build flag to save energy as the battery runs down by
+ * stepping through operating profiles, instead of logging the same way until
+ * the logger browns out.
+ *
+ * Give Logger::setPowerPolicy() the battery voltage variable (ie, from
+ * ProcessorStats) and a list of powerProfile with lower and lower voltages.
+ * After each update the logger drops to the lowest profile the voltage is
+ * under, and climbs back one profile at a time once the voltage is the
+ * hysteresis over the one it's in; optionally only while the voltage is
+ * rising, ie, while a solar panel is charging the battery.  A profile can:
+ * - stretch the logging interval (Logger::getLoggingIntervalSeconds())
+ * - limit the measurements every sensor averages
+ * - with #MS_SENSOR_DECIMATION, measure the sensors that are already
+ * decimated (Sensor::setMeasureEvery()) that many times less often
+ * - publish only every few records, keeping the rest in the outbox to be
+ * sent with it
+ *
+ * This turns on #MS_PUBLISHER_OUTBOX.
+ */
+// #define MS_LOGGER_POWER_POLICY
+
+#if defined(MS_LOGGER_POWER_POLICY) && !defined(MS_PUBLISHER_OUTBOX)
+#define MS_PUBLISHER_OUTBOX
+#endif
+
+/**
+ * @def MS_PUBLISHER_SEND_INTERVAL
+ * @brief Define this build flag to send to each publisher only every
+ * `sendEveryX` logging intervals (dataPublisher::setSendInterval()), keeping
+ * the records in between in the outbox, and to only wake the modem when at
+ * least one publisher is due.
+ *
+ * Each publisher counts the records logged since it was last sent to
+ * successfully.  On a logging interval where none is due, the record goes
+ * straight to the outbox and the modem is left asleep.  When any is due, the
+ * modem is woken, the publishers that are due are sent the new record and
+ * then everything waiting for them in the outbox, in batches where they take
+ * them; the others keep waiting.  A publisher whose send failed is due again
+ * on the next interval.  With a 5 minute logging interval and a send
+ * interval of 12, the modem is woken once an hour instead of 12 times.
+ *
+ * This turns on #MS_PUBLISHER_OUTBOX.
+ */
+// #define MS_PUBLISHER_SEND_INTERVAL
+
+#if defined(MS_PUBLISHER_SEND_INTERVAL) && !defined(MS_PUBLISHER_OUTBOX)
+#define MS_PUBLISHER_OUTBOX
+#endif
+
+/**
+ * @def MS_LOGGER_PUBLISH_SCHEDULE
+ * @brief Define this build flag to publish on a schedule of its own, set with
+ * Logger::setPublishSchedule(), instead of right after the sensors are
+ * measured.
+ *
+ * Every record is then held in the outbox, so the measurement wakes never
+ * wake the modem and stay short.  The logger also wakes at each publish time
+ * - a multiple of the publish interval, plus the offset - and only then
+ * wakes the modem, connects, and sends everything waiting in the
+ * outbox within the time set with Logger::setOutboxBudget().  Offsetting the
+ * publish times from the logging intervals keeps the modem off while the
+ * sensors are drawing power, and a slow network can't hold up the next
+ * measurement.  The daily clock sync is done at the first publication after
+ * noon.  Offsets that aren't whole minutes need #MS_LOGGER_INTERVAL_ALARM or
+ * #MS_LOGGER_SECONDS_INTERVAL for the logger to wake on them.
+ *
+ * This turns on #MS_PUBLISHER_OUTBOX.
+ */
+// #define MS_LOGGER_PUBLISH_SCHEDULE
+
+#if defined(MS_LOGGER_PUBLISH_SCHEDULE) && !defined(MS_PUBLISHER_OUTBOX)
+#define MS_PUBLISHER_OUTBOX
+#endif
+
+/**
+ * @def MS_LOGGER_DRIFT_SYNC
+ * @brief Define this build flag to only sync the clock at noon once it's
+ * expected to have drifted too far, instead of every day.
+ *
+ * Each sync measures how far the RTC has drifted since the clock was last
+ * set, and from that how fast it drifts.  The next sync is put off until the
+ * clock would be expected to be off by the tolerance set with
+ * Logger::setClockSyncTolerance(), up to a set number of days.  A second is
+ * added to each measured offset for the resolution of the clock, so a good
+ * RTC is checked after a day, then after 5 days, and so on.  Until the first
+ * measurement the clock is synced every day, and a clock that isn't sane is
+ * always synced.
+ */
+// #define MS_LOGGER_DRIFT_SYNC
+
+/**
+ * @def MS_LOGGER_CACHE_RTC
+ * @brief Define this build flag to read the RTC once per wake and count the
+ * time from there with `millis()`, instead of reading the clock every time
+ * the time is asked for.
+ *
+ * The clock is read again after every sleep, when it's set, when
+ * Logger::resyncRTCCache() is called, and after #MS_RTC_CACHE_MAX_AGE_MS
+ * awake.  This takes the I2C reads of a DS3231 out of file time stamping and
+ * the interval checks, and gives the same time to everything done within a
+ * second.  The counted time is never ahead of the clock and is at most a
+ * second behind it.
+ */
+// #define MS_LOGGER_CACHE_RTC
+#ifdef MS_LOGGER_CACHE_RTC
+#ifndef MS_RTC_CACHE_MAX_AGE_MS
+/**
+ * @brief The longest time in milliseconds the logger counts the time with
+ * `millis()` before reading the RTC again, so the processor clock can't
+ * drift far from the RTC while the logger stays awake, ie, to publish.
+ */
+#define MS_RTC_CACHE_MAX_AGE_MS 60000L
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_OVERLAP_MODEM
+ * @brief Define this build flag to wake the modem before the sensors are
+ * updated in Logger::logDataAndPublish() instead of after the data is saved.
+ *
+ * The connection is started with the non-blocking
+ * loggerModem::beginConnect() (this defines #MS_MODEM_NONBLOCKING_CONNECT)
+ * and loggerModem::pollConnect() is called over and over while the sensors
+ * warm up and measure, so the modem registers on the network in the meantime
+ * and the logger is awake for about the longer of the two instead of both one
+ * after the other.  The connection is finished once the data is saved.
+ * Modems without a step by step pollConnect() connect all at once on the
+ * first poll, which holds up the sensors for as long.
+ *
+ * @note The modem draws its full current while the measurements are made;
+ * don't use this if that disturbs your sensors, ie, analog sensors sharing
+ * the modem's power supply.
+ */
+// #define MS_LOGGER_OVERLAP_MODEM
+
+/**
+ * @def MS_LOGGER_INTERVAL_ALARM
+ * @brief Define this build flag to set the RTC alarm for the start of the
+ * next logging interval instead of for every minute.
+ *
+ * The logger then only wakes when it's time to log (or when the testing
+ * button is pressed), skipping the wakes that only check the time.  The alarm
+ * matches the hour, minute, and second, so intervals longer than a day still
+ * wake once a day.  Until the clock has been set the logger wakes every
+ * minute.
+ *
+ * @note Don't use this with more than one logger instance sharing the same
+ * RTC at different intervals; each one would replace the other's alarm.
+ */
+// #define MS_LOGGER_INTERVAL_ALARM
+
+/**
+ * @def MS_LOGGER_SECONDS_INTERVAL
+ * @brief Define this build flag to allow logging intervals shorter than a
+ * minute, set with Logger::setLoggingIntervalSeconds().
+ *
+ * With an interval under a minute the RTC alarm is set for the exact second
+ * the next interval starts, and the logger keeps the I2C bus running while it
+ * sleeps instead of shutting it down and re-starting it on every wake.  At
+ * those rates, also consider #MS_LOGGER_RECORD_BUFFER_SIZE and
+ * #MS_LOGGER_PERSISTENT_SD so the SD card isn't started for every record.
+ *
+ * @note The sensors must be able to warm up, stabilize, and measure within
+ * the interval.
+ */
+// #define MS_LOGGER_SECONDS_INTERVAL
+
+/**
+ * @def MS_LOGGER_PREWAKE
+ * @brief Define this build flag to wake the logger ahead of each logging
+ * interval by the time the sensors need, so the measurements are done at the
+ * start of the interval instead of some seconds after it.
+ *
+ * The lead is set with Logger::setPrewakeLead(), or is otherwise the longest
+ * time any sensor is expected to need to warm up, stabilize, and take all of
+ * its measurements (see VariableArray::getExpectedUpdateTime()), plus
+ * #MS_PREWAKE_MARGIN_S.  The record is still marked with the start of the
+ * interval.  The lead is capped at half of the logging interval, and there's
+ * no lead until the clock has been set.  Sampling groups and event checks
+ * still wake at the start of their own intervals.
+ *
+ * This turns on #MS_LOGGER_INTERVAL_ALARM.
+ */
+// #define MS_LOGGER_PREWAKE
+
+#ifdef MS_LOGGER_PREWAKE
+#ifndef MS_LOGGER_INTERVAL_ALARM
+#define MS_LOGGER_INTERVAL_ALARM
+#endif
+#ifndef MS_PREWAKE_MARGIN_S
+/**
+ * @brief The extra seconds added to the worked out pre-wake lead, for the
+ * time to wake up and start the sensors.
+ */
+#define MS_PREWAKE_MARGIN_S 2
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_LIGHT_SLEEP
+ * @brief Define this build flag to skip the peripheral teardown in
+ * Logger::systemSleep() when the logger will wake again within
+ * #MS_LIGHT_SLEEP_MAX_S seconds.
+ *
+ * For those naps the I2C bus is left running and the wake pin's interrupt is
+ * left attached, so a SAMD board doesn't have to move its interrupt controller
+ * back to the sleep clock.  The RTC alarm is still turned off on waking, so
+ * the interrupt can't fire while the logger is awake.  The processor still
+ * goes into its deepest sleep.
+ * Longer sleeps keep the full teardown, so I2C sensors can't draw power through
+ * the bus pins for long.
+ */
+// #define MS_LOGGER_LIGHT_SLEEP
+#ifdef MS_LOGGER_LIGHT_SLEEP
+#ifndef MS_LIGHT_SLEEP_MAX_S
+/**
+ * @brief The longest time in seconds until the next wake that still only gets
+ * a light sleep.
+ */
+#define MS_LIGHT_SLEEP_MAX_S 10
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_WARM_BOOT
+ * @brief Define this build flag to recognize a reset that didn't lose power,
+ * like a watchdog reset, and skip the slow parts of the start up after it.
+ *
+ * Once the log file has been created, a fingerprint of the logger's set up
+ * (the logger ID, logging interval, variables and sensors, and the build), the
+ * log file name, and whether the clock was set are kept in RAM that isn't
+ * cleared on reset (#MS_WARM_BOOT_SECTION).  If Logger::begin() finds the
+ * same fingerprint and the clock is still sane, it's a warm boot
+ * (Logger::isWarmBoot()): the log file name is taken back, the first
+ * Logger::syncRTC() doesn't wake the modem, and Logger::createLogFile(bool)
+ * doesn't start the SD card, so the logger is back to logging within seconds.
+ *
+ * The sensors still need VariableArray::setupSensors(); their set up is lost
+ * with the rest of the RAM on any reset.
+ */
+// #define MS_LOGGER_WARM_BOOT
+#ifdef MS_LOGGER_WARM_BOOT
+#ifndef MS_WARM_BOOT_SECTION
+#if defined(ARDUINO_ARCH_AVR)
+/**
+ * @brief The linker section that holds the warm boot record.
+ *
+ * It must not be cleared at start up; AVR boards keep `.noinit`.  Other boards
+ * need a section from their linker scripts, ie, the backup RAM of a SAMD51;
+ * without one the record is cleared on reset and every boot is cold.
+ */
+#define MS_WARM_BOOT_SECTION ".noinit"
+#endif
+#endif
+#ifndef MS_WARM_BOOT_NAME_LENGTH
+/**
+ * @brief The longest log file name in characters that can be taken back on a
+ * warm boot.
+ */
+#define MS_WARM_BOOT_NAME_LENGTH 48
+#endif
+#endif
+
+/**
+ * @def MS_WATCHDOG_PHASES
+ * @brief Define this build flag to give each phase of a logging cycle a
+ * watchdog budget of its own, instead of the 15 minutes between any two
+ * resets of the watchdog.
+ *
+ * The sensor update, SD card write, internet connection, publishing, and
+ * clock sync each get the number of seconds set by their MS_PHASE_BUDGET_
+ * define.  A phase that hangs resets the board about 8 s after its budget,
+ * not after 15 minutes, and the phase is kept through the reset where the
+ * board keeps RAM that isn't cleared (AVR, or #MS_WARM_BOOT_SECTION) for
+ * Logger::getLastOverrunPhase().  Publishing gives up on the remotes it
+ * hasn't reached once its budget is gone, leaving them to the outbox, and
+ * any phase that finishes late is logged and recorded the same way.
+ */
+// #define MS_WATCHDOG_PHASES
+
+/**
+ * @def MS_LOGGER_PROFILE
+ * @brief Define this build flag to time the parts of every logging cycle with
+ * the LoggerProfiler.
+ *
+ * The sensor update, opening, writing and closing the log file, waking the
+ * modem, connecting, sending to each publisher, the clock sync and putting
+ * the modem to sleep are each timed into a trace of the last
+ * #MS_PROFILE_TRACE_SIZE spans.  Append the trace to a file on the SD card
+ * (#MS_PROFILE_TRACE_SUFFIX) with Logger::writeProfileTrace(), or log the
+ * totals of the last cycle from LoggerProfiler::getLastCycleTime().
+ */
+// #define MS_LOGGER_PROFILE
+
+/**
+ * @def MS_LOGGER_ENERGY
+ * @brief Define this build flag to also add up the charge drawn during each
+ * span of #MS_LOGGER_PROFILE, from a current sensor like the TIINA219.
+ *
+ * Give LoggerProfiler::setCurrentSource() a function that reads the current;
+ * it's sampled at the start and end of every span and every
+ * #MS_ENERGY_SAMPLE_MS while the sensors are updated.
+ * LoggerProfiler::getLastCycleCharge() then gives the mAh of each part of the
+ * last cycle, for calculated variables.  The current sensor has to stay
+ * powered through the whole cycle.  This turns on #MS_LOGGER_PROFILE.
+ */
+// #define MS_LOGGER_ENERGY
+#ifdef MS_LOGGER_ENERGY
+#ifndef MS_LOGGER_PROFILE
+#define MS_LOGGER_PROFILE
+#endif
+#endif
+#ifdef MS_LOGGER_PROFILE
+/**
+ * @brief The end of the file name for the profile trace, which starts with the
+ * logger id
+ */
+#define MS_PROFILE_TRACE_SUFFIX "_trace.csv"
+#endif
+
+#ifdef MS_WATCHDOG_PHASES
+/**
+ * @brief The phases of a logging cycle with a watchdog budget
+ * (#MS_WATCHDOG_PHASES).
+ */
+typedef enum loggerPhase {
+    PHASE_NONE = 0,   ///< No phase
+    PHASE_SENSORS,    ///< Updating the sensors
+    PHASE_SD_WRITE,   ///< Writing to the SD card
+    PHASE_CONNECT,    ///< Connecting to the internet
+    PHASE_PUBLISH,    ///< Sending data to the publishers
+    PHASE_TIME_SYNC,  ///< Getting the time to set the clock
+} loggerPhase;
+#ifndef MS_PHASE_BUDGET_SENSORS_S
+/// @brief The seconds a complete sensor update may take.
+#define MS_PHASE_BUDGET_SENSORS_S 300
+#endif
+#ifndef MS_PHASE_BUDGET_SD_WRITE_S
+/// @brief The seconds writing a record to the SD card may take.
+#define MS_PHASE_BUDGET_SD_WRITE_S 60
+#endif
+#ifndef MS_PHASE_BUDGET_CONNECT_S
+/// @brief The seconds connecting to the internet may take.
+#define MS_PHASE_BUDGET_CONNECT_S 180
+#endif
+#ifndef MS_PHASE_BUDGET_PUBLISH_S
+/// @brief The seconds publishing to all of the remotes may take.
+#define MS_PHASE_BUDGET_PUBLISH_S 180
+#endif
+#ifndef MS_PHASE_BUDGET_TIME_SYNC_S
+/// @brief The seconds getting the time for a clock sync may take.
+#define MS_PHASE_BUDGET_TIME_SYNC_S 60
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_SAMPLING_GROUPS
+ * @brief Define this build flag to log extra variable arrays - sampling
+ * groups - from the same logger, each at its own interval and to its own
+ * file.
+ *
+ * Add groups with Logger::addSamplingGroup().  Logger::logData() and
+ * Logger::logDataAndPublish() update every group that is due whenever they
+ * wake, together with the main variable array if it is also due, so groups
+ * that fall due at the same time share one wake.  Only the main variable
+ * array is published.
+ *
+ * @note A sensor should only be in one group (or the main array), or it will
+ * be measured once for each.  Group records are written straight to the card,
+ * not through the record buffer (#MS_LOGGER_RECORD_BUFFER_SIZE).
+ */
+// #define MS_LOGGER_SAMPLING_GROUPS
+
+#if defined(MS_LOGGER_SAMPLING_GROUPS) && \
+    !defined(MS_LOGGER_MAX_SAMPLING_GROUPS)
+/**
+ * @brief The largest number of sampling groups in addition to the main
+ * variable array
+ */
+#define MS_LOGGER_MAX_SAMPLING_GROUPS 3
+#endif
+
+/**
+ * @def MS_LOGGER_EVENT_TRIGGER
+ * @brief Define this build flag to log faster during events - when a variable
+ * crosses a threshold or rises faster than a set rate - and to save the
+ * records from just before the event.
+ *
+ * Set the trigger with Logger::setEventTrigger().  Between logging intervals
+ * the logger wakes at the shorter event interval to update the sensors and
+ * check the trigger.  Those records are only kept in a RAM ring of
+ * #MS_LOGGER_EVENT_RING_BYTES bytes until the trigger fires; then the ring is
+ * written to the log file and every record is saved until the trigger has
+ * been quiet for a set number of records.  Only the records on the logging
+ * interval are published.
+ *
+ * @note The sensors are still powered at the event interval; what's saved is
+ * the SD card and modem time between events.
+ */
+// #define MS_LOGGER_EVENT_TRIGGER
+
+#if defined(MS_LOGGER_EVENT_TRIGGER) && !defined(MS_LOGGER_EVENT_RING_BYTES)
+/**
+ * @brief The size of the ring of pre-trigger records, in bytes.
+ *
+ * Each record takes 4 bytes for the time and 4 for each variable.
+ */
+#define MS_LOGGER_EVENT_RING_BYTES 256
+#endif
+
+/**
+ * @def MS_LOGGER_RESULT_TIMES
+ * @brief Define this build flag to keep, with each record, when each sensor
+ * finished measuring, as milliseconds after the time was marked.
+ *
+ * Every value of a record carries the marked time, from before the sensors
+ * were updated, so in a long cycle the last sensor's values can be a minute
+ * or more newer than their timestamp.  With this defined each record also
+ * keeps the time of the last result added for each of the array's unique
+ * sensors, in the order of VariableArray::getListedSensor(), or -9999 for a
+ * sensor that gave no results.  A csv log file gets a column for each sensor
+ * after the values, with the sensor name and "millisecond" in the header;
+ * binary log files keep their record layout and don't hold the times.
+ * Records read back from the outbox or the pre-trigger ring have no times
+ * and are written with -9999.
+ */
+// #define MS_LOGGER_RESULT_TIMES
+
+/**
+ * @def MS_LOGGER_STREAMING
+ * @brief Define this build flag to have the sensor testing mode stream the
+ * values over the serial port as fast as the sensors can give them, instead
+ * of printing 25 readings 5 seconds apart.
+ *
+ * The sensors are powered and woken once and then updated again as soon as
+ * each update finishes, so the rate is set by the slowest sensor (with
+ * #MS_USE_DEADLINE_SCHEDULER every sensor is serviced right at its
+ * deadline).  Each update is sent as one CSV line of the processor time in
+ * milliseconds and the values; the first line has the variable codes.  Any
+ * character received on the port ends the stream, as does
+ * #MS_STREAMING_TIMEOUT_S.  The modem isn't used.  Use a fast baud rate so
+ * the port keeps up.
+ */
+// #define MS_LOGGER_STREAMING
+
+/**
+ * @def MS_LOGGER_DOWNLOAD
+ * @brief Define this build flag to let the files on the SD card be copied off
+ * over the serial port in checked blocks, without taking the card out.
+ *
+ * When the sensor testing mode starts, it waits #MS_DOWNLOAD_PROMPT_MS for a
+ * 'D' on the main output and then runs Logger::downloadMode() instead of the
+ * sensor test.  Logging stops while the files are sent and starts again
+ * afterwards.  Define #MS_DOWNLOAD_BAUD to move the port to a faster rate
+ * for the download.
+ */
+// #define MS_LOGGER_DOWNLOAD
+
+#ifdef MS_LOGGER_DOWNLOAD
+#ifndef MS_DOWNLOAD_BLOCK_SIZE
+/**
+ * @brief The most bytes of a file sent in each block of a download; the
+ * buffer is on the stack.
+ */
+#define MS_DOWNLOAD_BLOCK_SIZE 512
+#endif
+#ifndef MS_DOWNLOAD_PROMPT_MS
+/**
+ * @brief The time the sensor testing mode waits for a 'D' to start a
+ * download, in milliseconds.
+ */
+#define MS_DOWNLOAD_PROMPT_MS 3000L
+#endif
+#ifndef MS_DOWNLOAD_TIMEOUT_S
+/**
+ * @brief The download ends when no command has come for this long, in
+ * seconds.
+ */
+#define MS_DOWNLOAD_TIMEOUT_S 120
+#endif
+#ifdef MS_DOWNLOAD_BAUD
+#ifndef MS_SERIAL_BAUD
+/**
+ * @brief With #MS_DOWNLOAD_BAUD, the rate the main output is put back to
+ * after a download; it must match the rate the program begins it at.
+ */
+#define MS_SERIAL_BAUD 115200
+#endif
+#endif
+#endif
+
+/**
+ * @def MS_LOGGER_GATEWAY
+ * @brief Define this build flag to send the records of loggers without a
+ * modem over a radio link to one logger with a modem, which publishes them
+ * all in its own connection.
+ *
+ * Attach a LoggerGateway to each logger with Logger::attachGateway().  After
+ * each record is logged, a node sends it to the gateway, and the gateway
+ * listens for the records of its nodes.  When the gateway publishes, the
+ * nodes' queued records are sent after its own, each to the publishers
+ * given for its node, as if they were the gateway's records: with the
+ * node's variables and sampling feature.  A node record is kept until every
+ * publisher it's for has taken it.
+ */
+// #define MS_LOGGER_GATEWAY
+
+/**
+ * @def MS_LOGGER_FAILOVER
+ * @brief Define this build flag to connect with whichever of several modems
+ * is cheapest and working, failing over to the next within a bounded time.
+ *
+ * Attach a LoggerLinks with each modem, its client, and its cost with
+ * Logger::attachLinks().  On each publish the links are ranked by cost and
+ * by how fast and how often they've connected recently, and each is woken
+ * and given its own connection time limit in turn until one connects or
+ * #MS_FAILOVER_BUDGET_MS has passed.  A dead WiFi is given up on after
+ * its limit instead of the full 50 seconds, and a metered cellular modem is
+ * only used while the cheaper links are failing.
+ */
+// #define MS_LOGGER_FAILOVER
+
+#if defined(MS_LOGGER_STREAMING) && !defined(MS_STREAMING_TIMEOUT_S)
+/**
+ * @brief The longest the sensors are streamed for, in seconds, so a stream
+ * that's never stopped doesn't run the battery down.
+ */
+#define MS_STREAMING_TIMEOUT_S 900
+#endif
+
+#ifdef MS_PUBLISHER_OUTBOX
+/**
+ * @brief The end of the outbox file name, which starts with the logger id
+ */
+#define MS_OUTBOX_SUFFIX "_outbox.bin"
+#ifndef MS_OUTBOX_BATCH_SIZE
+/**
+ * @brief The number of outbox records sent between each save of the outbox,
+ * and the most sent in one request to a publisher that takes batches
+ */
+#define MS_OUTBOX_BATCH_SIZE 8
+#endif
+#endif
+
+
+/**
+ * @brief The status bits of a loggerRecord.
+ */
+typedef enum loggerRecordStatus : uint8_t {
+    RECORD_CLOCK_UNSET = 0x01,  ///< The clock wasn't set when it was taken
+    RECORD_FROM_OUTBOX = 0x02,  ///< Read back from the outbox to be sent
+    RECORD_FROM_RING   = 0x04,  ///< Kept from before an event to be saved
+    RECORD_FROM_NODE   = 0x08,  ///< Sent to a gateway by another logger
+} loggerRecordStatus;
+
+/**
+ * @brief The values of all of the variables in one logging cycle and the time
+ * they were taken.
+ *
+ * The logger takes a record once, right after the sensors are updated, and
+ * the log file, the serial output and the publishers all read that record
+ * through Logger::getValueCharsAtI() and Logger::getRecordValueAtI() instead
+ * of the variables themselves.  Records read back from the outbox or the
+ * pre-trigger ring are switched in the same way while they're sent or saved.
+ */
+typedef struct loggerRecord {
+    uint32_t utcEpoch;    ///< The marked UTC epoch time of the record
+    uint8_t  status;      ///< The loggerRecordStatus bits of the record
+    uint8_t  valueCount;  ///< The number of values
+    float*   values;      ///< The values, in the order of the variable array
+#ifdef MS_LOGGER_RESULT_TIMES
+    /**
+     * @brief The milliseconds after the mark each unique sensor gave its last
+     * result, in the order of the sensor list; null if they weren't kept
+     */
+    int32_t* resultOffsets;
+#endif
+} loggerRecord;
+
+
+#ifdef MS_LOGGER_POWER_POLICY
+/**
+ * @brief An operating profile of the logger for a low battery
+ * (#MS_LOGGER_POWER_POLICY).
+ */
+typedef struct powerProfile {
+    float   enterBelow_V;    ///< The battery voltage the profile starts under
+    uint8_t intervalFactor;  ///< The logging interval is this many times longer
+    uint8_t maxAverages;     ///< The most measurements averaged; 0 for no limit
+    uint8_t decimateFactor;  ///< Decimated sensors are this much less often
+    uint8_t publishEvery;    ///< Publish once for this many records
+} powerProfile;
+#endif
+
+
+class dataPublisher;  // Forward declaration
+
+
+/**
+ * @brief The "Logger" Class handles low power sleep for the main processor,
+ * interfacing with the real-time clock and modem, writing to the SD card, and
+ * passing data on to the data publishers.
+ *
+ * A logger is a device that can control all functions of the modem sensors and
+ * that are attached to it and save the values of all variables measured by
+ * those sensors to an attached SD card.  It must also work with a real-time
+ * clock to give timestamps to values.  It may also work with a loggerModem for
+ * internet connection and send out data over the internet through one or more
+ * data publishers.
+ *
+ * In this library, all loggers are Arduino-style small processor circuit
+ * boards.
+ *
+ * @ingroup base_classes
+ */
+class Logger {
+    /**
+     * @brief The dataPublisher class contains endpoints for logged data and the
+     * proper formats for sending it.
+     */
+    friend class dataPublisher;
+
+ public:
+    /**
+     * @brief Construct a new Logger object.
+     *
+     * @param loggerID A name for the logger - unless otherwise specified, files
+     * saved to the SD card will be named with the logger id and the date the
+     * file was started.
+     * @param loggingIntervalMinutes The frequency in minutes at which data
+     * should be logged
+     * @param SDCardSSPin The pin of the chip select/slave select for the SPI
+     * connection to the SD card
+     * @param mcuWakePin The pin used to wake the logger from deep sleep -
+     * expected to be attached to an alarm pin of the real-time clock.  Use a
+     * value of -1 to prevent the board from sleeping.
+     * @param inputArray A variableArray object instance providing data to be
+     * logged.  This is NOT an array of variables, but an object of the variable
+     * array class.
+     */
+    Logger(const char* loggerID, uint16_t loggingIntervalMinutes,
+           int8_t SDCardSSPin, int8_t mcuWakePin, VariableArray* inputArray);
+    /**
+     * @brief Construct a new Logger object.
+     *
+     * @param loggerID A name for the logger - unless otherwise specified, files
+     * saved to the SD card will be named with the logger id and the date the
+     * file was started.
+     * @param loggingIntervalMinutes The frequency in minutes at which data
+     * should be logged
+     * @param inputArray A variableArray object instance providing data to be
+     * logged.  This is NOT an array of variables, but an object of the variable
+     * array class.
+     */
+    Logger(const char* loggerID, uint16_t loggingIntervalMinutes,
+           VariableArray* inputArray);
+    /**
+     * @brief Construct a new Logger object.
+     *
+     * @note The logger ID and logging interval must be specified before the
+     * logger object can be used.
+     */
+    Logger();
+    /**
+     * @brief Destroy the Logger object - takes no action.
+     */
+    virtual ~Logger();
+
+    // ===================================================================== //
+    /**
+     * @anchor logger_basic_parameters
+     * @name Basic Logging Parameters
+     * Public functions to get and set basic logging paramters
+     */
+    /**@{*/
+    // ===================================================================== //
+    /**
+     * @brief Set the Logger ID.
+     *
+     * Unless otherwise specified, files saved to the SD card will be named with
+     * the logger id and the date the file was started.
+     *
+     * @param loggerID A pointer to the logger ID
+     */
+    void setLoggerID(const char* loggerID);
+    /**
+     * @brief Get the Logger ID.
+     *
+     * @return **const char\*** A pointer to the logger ID
+     */
+    const char* getLoggerID() {
+        return _loggerID;
+    }
+
+    /**
+     * @brief Set the logging interval in minutes.
+     *
+     * @param loggingIntervalMinutes The frequency with which to update sensor
+     * values and write data to the SD card.
+     */
+    void setLoggingInterval(uint16_t loggingIntervalMinutes);
+    /**
+     * @brief Get the Logging Interval.
+     *
+     * @return **uint16_t** The logging interval in minutes
+     */
+    uint16_t getLoggingInterval() {
+        return _loggingIntervalMinutes;
+    }
+#ifdef MS_LOGGER_SECONDS_INTERVAL
+    /**
+     * @brief Set the logging interval in seconds.
+     *
+     * This replaces any interval set with setLoggingInterval(uint16_t) until
+     * that is called again.
+     *
+     * @param loggingIntervalSeconds The frequency with which to update sensor
+     * values and write data to the SD card.
+     */
+    void setLoggingIntervalSeconds(uint16_t loggingIntervalSeconds);
+#endif
+    /**
+     * @brief Get the logging interval in seconds.
+     *
+     * @return **uint32_t** The logging interval in seconds
+     */
+    uint32_t getLoggingIntervalSeconds(void);
+
+    /**
+     * @brief Set the universally unique identifier (UUID or GUID) of the
+     * sampling feature.
+     *
+     * @param samplingFeatureUUID A pointer to the sampling feature UUID
+     */
+    void setSamplingFeatureUUID(const char* samplingFeatureUUID);
+    /**
+     * @brief Get the Sampling Feature UUID.
+     *
+     * @return **const char\*** The sampling feature UUID
+     */
+    const char* getSamplingFeatureUUID() {
+        return _samplingFeatureUUID;
+    }
+
+    /**
+     * @brief Set a digital pin number (on the mcu) to use to control power to
+     * the SD card and activate it as an output pin.
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * @warning This functionality is not tested!
+     *
+     * @param SDCardPowerPin A digital pin number on the mcu controlling power
+     * to the SD card.
+     */
+    void setSDCardPwr(int8_t SDCardPowerPin);
+    /**
+     * @brief Send power to the SD card by setting the SDCardPowerPin `HIGH`.
+     *
+     * Optionally waits for the card to "settle."  Has no effect if a pin has
+     * not been set to control power to the SD card.
+     *
+     * @param waitToSettle True to add a short (6ms) delay between powering on
+     * the card and beginning initialization.  Defaults to true.
+     */
+    void turnOnSDcard(bool waitToSettle = true);
+    /**
+     * @brief Cut power to the SD card by setting the SDCardPowerPin `LOW`.
+     *
+     * Optionally waits for the card to do "housekeeping" before cutting the
+     * power.  Has o effect if a pin has not been set to control power to the SD
+     * card.
+     *
+     * @param waitForHousekeeping True to add a 1 second delay between to allow
+     * any on-chip writing to complete before cutting power.  Defaults to true.
+     */
+    void turnOffSDcard(bool waitForHousekeeping = true);
+#ifdef MS_LOGGER_SHARED_SD
+    /**
+     * @brief Start writing every logger's file to the SD card in one session
+     * (#MS_LOGGER_SHARED_SD).
+     *
+     * The card is mounted by the first logger that writes to it, and
+     * turnOffSDcard() leaves it powered until closeSDSession().
+     */
+    static void openSDSession(void);
+    /**
+     * @brief End the session started by openSDSession().
+     *
+     * The next write mounts the card again, unless the mount is kept
+     * (#MS_LOGGER_PERSISTENT_SD).
+     */
+    static void closeSDSession(void);
+#endif
+
+    /**
+     * @brief Set a digital pin number for the slave select (chip select) of the
+     * SD card and activate it as an output pin.
+     *
+     * This over-writes the value (if any) given in the constructor.  The pin
+     * mode of this pin will be set as `OUTPUT`.
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * @param SDCardSSPin The pin on the mcu connected to the slave select of
+     * the SD card.
+     */
+    void setSDCardSS(int8_t SDCardSSPin);
+
+    /**
+     * @brief Set both pin numbers related to the SD card and activate them as
+     * output pins.
+     *
+     * These over-write the values (if any) given in the constructor.  The pin
+     * mode of these pins will be set as `OUTPUT`.
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * @param SDCardSSPin The pin on the mcu connected to the slave select of
+     * the SD card.
+     * @param SDCardPowerPin A digital pin number on the mcu controlling power
+     * to the SD card.
+     */
+    void setSDCardPins(int8_t SDCardSSPin, int8_t SDCardPowerPin);
+
+    //
+    /**
+     * @brief Set digital pin number for the wake up pin used as an RTC
+     * interrupt and activate it in the given pin mode.
+     *
+     * This over-writes the value (if any) given in the constructor.  Use a
+     * value of -1 to prevent the board from attempting to sleep.  If using a
+     * SAMD board with the internal RTC, the value of the pin is irrelevant as
+     * long as it is positive.
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * @note  This sets the pin mode but does NOT enable the interrupt!
+     *
+     * @param mcuWakePin The pin on the mcu to be used to wake the mcu from deep
+     * sleep.
+     * @param wakePinMode The pin mode to be used for wake up on the clock alert
+     * pin.  Must be either `INPUT` OR `INPUT_PULLUP`.  Optional with a default
+     * value of `INPUT_PULLUP`.  The DS3231 has an active low interrupt, so the
+     * pull-up resistors should be enabled.
+     */
+    void setRTCWakePin(int8_t mcuWakePin, uint8_t wakePinMode = INPUT_PULLUP);
+
+    /**
+     * @brief Set the digital pin number to put out an alert that a measurement
+     * is being logged and activate it as an output pin.
+     *
+     * The pin mode of this pin will be set as `OUTPUT`.  This is intended to be
+     * a pin with a LED on it so you can see the light come on when a
+     * measurement is being taken.
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * @param ledPin The pin on the mcu to be held `HIGH` while sensor data is
+     * being collected and logged.
+     */
+    void setAlertPin(int8_t ledPin);
+    /**
+     * @brief Set the alert pin high.
+     */
+    void alertOn();
+    /**
+     * @brief Set the alert pin low.
+     */
+    void alertOff();
+#ifdef MS_WATCHDOG_PHASES
+    /**
+     * @brief Get the logging phase that last went over its watchdog budget
+     * (#MS_WATCHDOG_PHASES).
+     *
+     * @return **uint8_t** The loggerPhase, or PHASE_NONE if none has.
+     */
+    uint8_t getLastOverrunPhase(void);
+#endif
+
+    /**
+     * @brief Set the digital pin number for an interrupt pin used to enter
+     * testing mode, activate that pin as the given input type, **and** attach
+     * the testing interrupt to it.
+     *
+     * Intended to be used for a pin attached to a button or other manual
+     * interrupt source.
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * Once in testing mode, the logger will attempt to connect the the internet
+     * and take 25 measurements spaced at 5 second intervals writing the results
+     * to the main output destination (ie, Serial).  Testing mode cannot be
+     * entered while the logger is taking a scheduled measureemnt.  No data is
+     * written to the SD card in testing mode.
+     *
+     * @param buttonPin The pin on the mcu to listen to for a value-change
+     * interrupt.
+     * @param buttonPinMode The pin mode to be used for the button pin.  Must be
+     * either `INPUT` OR `INPUT_PULLUP`.  Optional with a default value of
+     * `INPUT`.  Using `INPUT_PULLUP` will enable processor input resistors,
+     * while using `INPUT` will explicitly disable them.  If your pin is
+     * externally pulled down or the button is a normally open (NO) switch with
+     * common (COM) connected to Vcc, like the EnviroDIY Mayfly), you should use
+     * the `INPUT` pin mode.  Coversely, if your button connect to ground when
+     * activated, you should enable the processor pull-up resistors using
+     * `INPUT_PULLUP`.
+     */
+    void setTestingModePin(int8_t buttonPin, uint8_t buttonPinMode = INPUT);
+
+    /**
+     * @brief Set the digital pin numbers and activate pin modes for the five
+     * pins of interest for the logger
+     *
+     * Because this sets the pin mode, this function should only be called
+     * during the `setup()` or `loop()` portion of an Arduino program.
+     *
+     * @param mcuWakePin The pin on the mcu to listen to for a value-change
+     * interrupt to wake from deep sleep.  The mode of this pin will be set to
+     * `wakePinMode`.
+     * @param SDCardSSPin The pin on the mcu connected to the slave select of
+     * the SD card.  The pin mode of this pin will be set as `OUTPUT`.
+     * @param SDCardPowerPin A digital pin number on the mcu controlling power
+     * to the SD card.  The pin mode of this pin will be set as `OUTPUT`.
+     * @param buttonPin The pin on the mcu to listen to for a value-change
+     * interrupt to enter testing mode.  The mode of this pin will be set to
+     * `buttonPinMode`.
+     * @param ledPin The pin on the mcu to be held `HIGH` while sensor data is
+     * being collected and logged.  The pin mode of this pin will be set as
+     * `OUTPUT`.
+     * @param wakePinMode The pin mode to be used for wake up on the
+     * `mcuWakePin` (clock alert) pin.  Must be either `INPUT` OR
+     * `INPUT_PULLUP`. Optional with a default value of `INPUT_PULLUP`.  The
+     * DS3231 has an active low interrupt, so the pull-up resistors should be
+     * enabled.
+     * @param buttonPinMode The pin mode to be used for the button pin.  Must be
+     * either `INPUT` OR `INPUT_PULLUP`.  Optional with a default value of
+     * `INPUT`.  Using `INPUT_PULLUP` will enable processor input resistors,
+     * while using `INPUT` will explicitly disable them.  If your pin is
+     * externally pulled down or the button is a normally open (NO) switch with
+     * common (COM) connected to Vcc, like the EnviroDIY Mayfly), you should use
+     * the `INPUT` pin mode.  Coversely, if your button is active when connected
+     * to ground, you should enable the processor pull-up resistors using
+     * `INPUT_PULLUP`.
+     */
+    void setLoggerPins(int8_t mcuWakePin, int8_t SDCardSSPin,
+                       int8_t SDCardPowerPin, int8_t buttonPin, int8_t ledPin,
+                       uint8_t wakePinMode   = INPUT_PULLUP,
+                       uint8_t buttonPinMode = INPUT);
+
+ protected:
+    // Initialization variables
+    /**
+     * @brief The logger id
+     */
+    const char* _loggerID = "MyLogger";
+    /**
+     * @brief The logging interval in minutes
+     */
+    uint16_t _loggingIntervalMinutes = 5;
+#ifdef MS_LOGGER_SECONDS_INTERVAL
+    /**
+     * @brief The logging interval in seconds; 0 to use
+     * #_loggingIntervalMinutes
+     */
+    uint16_t _loggingIntervalSeconds = 0;
+#endif
+    /**
+     * @brief Digital pin number on the mcu controlling the SD card slave
+     * select.
+     */
+    int8_t _SDCardSSPin = -1;
+    /**
+     * @brief Digital pin number on the mcu controlling SD card power
+     */
+    int8_t _SDCardPowerPin = -1;
+    /**
+     * @brief Digital pin number on the mcu receiving interrupts to wake from
+     * deep-sleep.
+     */
+    int8_t _mcuWakePin = -1;
+    /**
+     * @brief The pin mode used for wake up on the clock alert pin.
+     *
+     * Must be either `INPUT` OR `INPUT_PULLUP` with an AVR board.  On a SAM/D
+     * board `INPUT_PULLDOWN` is also an option.  Optional with a default value
+     * of `INPUT_PULLUP`.  The DS3231 has an active low interrupt, so the
+     * pull-up resistors should be enabled.
+     */
+    uint8_t _wakePinMode = INPUT_PULLUP;
+#ifdef MS_LOGGER_LIGHT_SLEEP
+    /**
+     * @brief True if the wake interrupt was left attached after a light sleep
+     * (#MS_LOGGER_LIGHT_SLEEP).
+     */
+    bool _wakeInterruptAttached = false;
+#endif
+#ifdef MS_LOGGER_WARM_BOOT
+    /**
+     * @brief Get a fingerprint of the logger's set up, to tell if a reset
+     * left it the same (#MS_LOGGER_WARM_BOOT).
+     *
+     * @return **uint32_t** A hash of the logger ID, logging interval,
+     * variables, sensors, and build time.
+     */
+    uint32_t getSetupFingerprint(void);
+    /**
+     * @brief Keep the set up fingerprint and log file name through the next
+     * reset.
+     */
+    void saveBootRecord(void);
+    /**
+     * @brief The fingerprint of the set up, made in begin()
+     */
+    uint32_t _setupFingerprint = 0;
+    /**
+     * @brief True if begin() found the same set up from before a reset
+     */
+    bool _warmBoot = false;
+    /**
+     * @brief True until the first clock sync after a warm boot, which is
+     * skipped
+     */
+    bool _warmBootSyncPending = false;
+#endif
+#ifdef MS_WATCHDOG_PHASES
+    /**
+     * @brief Start a logging phase with its watchdog budget.
+     *
+     * @param phase The loggerPhase to start
+     */
+    void startPhase(loggerPhase phase);
+    /**
+     * @brief End the running logging phase, recording it if it went over its
+     * budget.
+     */
+    void endPhase(void);
+    /**
+     * @brief The logging phase that last went over its budget
+     */
+    uint8_t _lastOverrunPhase = PHASE_NONE;
+#endif
+    /**
+     * @brief Digital pin number on the mcu used to output an alert that the
+     * logger is measuring.
+     *
+     * Expected to be connected to a LED.
+     */
+    int8_t _ledPin = -1;
+    /**
+     * @brief Digital pin number on the mcu receiving interrupts to enter
+     * testing mode.
+     *
+     * Expected to be connected to a user button.
+     */
+    int8_t _buttonPin = -1;
+
+    /**
+     * @brief The sampling feature UUID
+     */
+    const char* _samplingFeatureUUID = nullptr;
+    // ^^ Start with no feature UUID
+    /**@}*/
+
+    // ===================================================================== //
+    /**
+     * @anchor logger_internal_array
+     * @name Attached Variable Array Functions
+     * Public functions to get information about the attached variable array
+     */
+    /**@{*/
+    // ===================================================================== //
+
+ public:
+    /**
+     * @brief Set the variable array object.
+     *
+     * @param inputArray A variable array object instance.  This is NOT an array
+     * of variables, but an object of the variable array class.
+     */
+    void setVariableArray(VariableArray* inputArray);
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    /**
+     * @brief Add a sampling group - a variable array logged at its own
+     * interval to its own file.
+     *
+     * This must be called before begin().
+     *
+     * @param groupArray A variable array object instance for the group; its
+     * sensors must be set up along with those of the main array.
+     * @param intervalMinutes The logging interval of the group in minutes
+     * @param measurementsToAverage The number of measurements each sensor in
+     * the group should average; 0 (the default) to leave them as they are.
+     * @param fileName The file to save the group's data to; by default it's
+     * named with the logger id, the group number, and the date.
+     * @return **bool** True if the group was added; false if the interval is
+     * 0 or there are already #MS_LOGGER_MAX_SAMPLING_GROUPS groups.
+     */
+    bool addSamplingGroup(VariableArray* groupArray, uint16_t intervalMinutes,
+                          uint8_t     measurementsToAverage = 0,
+                          const char* fileName              = nullptr);
+#endif
+#ifdef MS_LOGGER_EVENT_TRIGGER
+    /**
+     * @brief Set the variable and the conditions that start an event.
+     *
+     * Either condition can be turned off by setting it to -9999.
+     *
+     * @param trigger The variable to watch; it must be in the logger's
+     * variable array.
+     * @param threshold The value at or above which there is an event.
+     * @param risePerMinute The rate of rise, in the variable's units per
+     * minute, at or above which there is an event.
+     * @param eventIntervalMinutes The interval to sample and check the
+     * trigger at, and to log at during an event.  It should evenly divide the
+     * logging interval.
+     * @param quietRecords The number of records without the trigger before an
+     * event ends; optional with a default of 3.
+     */
+    void setEventTrigger(Variable* trigger, float threshold,
+                         float risePerMinute, uint16_t eventIntervalMinutes,
+                         uint8_t quietRecords = 3);
+#endif
+
+    /**
+     * @brief Get the number of variables in the internal variable array object.
+     *
+     * @return **uint8_t** The number of variables in the internal variable
+     * array object
+     */
+    uint8_t getArrayVarCount();
 
-class dataPublisher;  // Forward declaration
+#ifndef MS_NO_STRING_GETTERS
+    /**
+     * @brief Get the name of the parent sensor of the variable at the given
+     * position in the internal variable array object.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The name of the parent sensor of that variable, if
+     * applicable.
+     */
+    String getParentSensorNameAtI(uint8_t position_i);
+#endif
+    /**
+     * @brief Get the name of the parent sensor of the variable at the given
+     * position without copying it into a String.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **const char\*** The name of the parent sensor
+     */
+    const char* getParentSensorNameCharsAtI(uint8_t position_i);
+    /**
+     * @brief Get the name and pin location of the parent sensor of the variable
+     * at the given position in the internal variable array object.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The concatenated name and pin location of the parent
+     * sensor of that variable, if applicable.
+     */
+    String getParentSensorNameAndLocationAtI(uint8_t position_i);
+#ifndef MS_NO_STRING_GETTERS
+    /**
+     * @brief Get the name of the variable at the given position in the
+     * internal variable array object.
+     *
+     * Variable names must follow the controlled vocabulary documented here:
+     * http://vocabulary.odm2.org/variablename/
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The variable name
+     */
+    String getVarNameAtI(uint8_t position_i);
+#endif
+    /**
+     * @brief Get the variable name at the given position without copying it
+     * into a String.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **const char\*** The variable name
+     */
+    const char* getVarNameCharsAtI(uint8_t position_i);
+#ifndef MS_NO_STRING_GETTERS
+    /**
+     * @brief Get the unit of the variable at the given position in the
+     * internal variable array object.
+     *
+     * Variable units must follow the  controlled vocabulary documented here:
+     * http://vocabulary.odm2.org/units/
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The variable unit
+     */
+    String getVarUnitAtI(uint8_t position_i);
+#endif
+    /**
+     * @brief Get the variable unit at the given position without copying it
+     * into a String.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **const char\*** The variable unit
+     */
+    const char* getVarUnitCharsAtI(uint8_t position_i);
+#ifndef MS_NO_STRING_GETTERS
+    /**
+     * @brief Get the customized code of the variable at the given position in
+     * the internal variable array object.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The variable code
+     */
+    String getVarCodeAtI(uint8_t position_i);
+#endif
+    /**
+     * @brief Get the variable code at the given position without copying it
+     * into a String.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **const char\*** The variable code
+     */
+    const char* getVarCodeCharsAtI(uint8_t position_i);
+#ifndef MS_NO_STRING_GETTERS
+    /**
+     * @brief Get the UUID of the variable at the given position in the internal
+     * variable array object.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The variable UUID
+     */
+    String getVarUUIDAtI(uint8_t position_i);
+#endif
+    /**
+     * @brief Get the variable UUID at the given position without copying it
+     * into a String.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **const char\*** The variable UUID
+     */
+    const char* getVarUUIDCharsAtI(uint8_t position_i);
+#ifndef MS_NO_STRING_GETTERS
+    /**
+     * @brief Get the most recent value of the variable at the given position in
+     * the internal variable array object.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **String** The value of the variable as a string with the correct
+     * number of significant figures.
+     */
+    String getValueStringAtI(uint8_t position_i);
+#endif
+    /**
+     * @brief Get the most recent value of the variable at the given position in
+     * the internal variable array object as text, without creating a String.
+     *
+     * See VariableArray::getValueChars() for how long the text is valid.
+     * While records are being sent from the outbox (#MS_PUBLISHER_OUTBOX),
+     * or saved from the pre-trigger ring (#MS_LOGGER_EVENT_TRIGGER), this
+     * returns the kept value instead.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **const char\*** The value of the variable as text with the
+     * correct number of significant figures.
+     */
+    const char* getValueCharsAtI(uint8_t position_i);
+    /**
+     * @brief Get the value of the variable at the given position in the
+     * record being saved.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **float** The replayed value while a queued or kept record is
+     * being written, otherwise the most recent value.
+     */
+    float getRecordValueAtI(uint8_t position_i);
+    /**
+     * @brief Format a value the way the variable at the given position in the
+     * internal variable array object would.
+     *
+     * The text is valid until the next call to this or getValueCharsAtI().
+     *
+     * @param position_i The position of the variable in the array.
+     * @param value The value to format
+     * @return **const char\*** The value as text with the correct number of
+     * significant figures.
+     */
+    const char* formatValueAtI(uint8_t position_i, float value);
+    /**
+     * @brief Get the record being saved or sent.
+     *
+     * @return **const loggerRecord\*** The record; null outside of a logging
+     * cycle, when the variables are read directly.
+     */
+    const loggerRecord* getRecord(void) {
+        return _record;
+    }
+#ifdef MS_PUBLISH_ON_CHANGE
+    /**
+     * @brief Check if a publisher that takes partial updates should include
+     * the variable at the given position in the record being published.
+     *
+     * @param position_i The position of the variable in the array.
+     * @return **bool** True if the variable changed beyond its deadband (see
+     * Variable::setDeadband()), or if records from the outbox are being sent.
+     */
+    bool isChangedAtI(uint8_t position_i);
+#endif
 
+ protected:
+    /**
+     * @brief A pointer to the internal variable array instance
+     */
+    VariableArray* _internalArray;
+    /**@}*/
 
-/**
- * @brief The "Logger" Class handles low power sleep for the main processor,
- * interfacing with the real-time clock and modem, writing to the SD card, and
- * passing data on to the data publishers.
- *
- * A logger is a device that can control all functions of the modem sensors and
- * that are attached to it and save the values of all variables measured by
- * those sensors to an attached SD card.  It must also work with a real-time
- * clock to give timestamps to values.  It may also work with a loggerModem for
- * internet connection and send out data over the internet through one or more
- * data publishers.
- *
- * In this library, all loggers are Arduino-style small processor circuit
- * boards.
- *
- * @ingroup base_classes
- */
-class Logger {
+    // ===================================================================== //
     /**
-     * @brief The dataPublisher class contains endpoints for logged data and the
-     * proper formats for sending it.
+     * @anchor logger_internet
+     * @name Internet and Publisher Functions
+     * Public functions for internet and dataPublishers
      */
-    friend class dataPublisher;
+    /**@{*/
+    // ===================================================================== //
 
  public:
     /**
-     * @brief Construct a new Logger object.
+     * @brief Attach a loggerModem to the logger to provide internet access.
      *
-     * @param loggerID A name for the logger - unless otherwise specified, files
-     * saved to the SD card will be named with the logger id and the date the
-     * file was started.
-     * @param loggingIntervalMinutes The frequency in minutes at which data
-     * should be logged
-     * @param SDCardSSPin The pin of the chip select/slave select for the SPI
-     * connection to the SD card
-     * @param mcuWakePin The pin used to wake the logger from deep sleep -
-     * expected to be attached to an alarm pin of the real-time clock.  Use a
-     * value of -1 to prevent the board from sleeping.
-     * @param inputArray A variableArray object instance providing data to be
-     * logged.  This is NOT an array of variables, but an object of the variable
-     * array class.
+     * See [Modem and Internet Functions](@ref the_modems)
+     * for more information on how the modem must be set up before it is
+     * attached to the logger.  You must include an ampersand to tie in the
+     * already created modem!  If you do not attach a modem, no action will be
+     * taken to publish data.
+     *
+     * @param modem An instance of the loggerModem class
      */
-    Logger(const char* loggerID, uint16_t loggingIntervalMinutes,
-           int8_t SDCardSSPin, int8_t mcuWakePin, VariableArray* inputArray);
+    void attachModem(loggerModem& modem);
+#ifdef MS_LOGGER_GATEWAY
     /**
-     * @brief Construct a new Logger object.
+     * @brief Attach the radio link to a gateway or to its nodes
+     * (#MS_LOGGER_GATEWAY).
      *
-     * @param loggerID A name for the logger - unless otherwise specified, files
-     * saved to the SD card will be named with the logger id and the date the
-     * file was started.
-     * @param loggingIntervalMinutes The frequency in minutes at which data
-     * should be logged
-     * @param inputArray A variableArray object instance providing data to be
-     * logged.  This is NOT an array of variables, but an object of the variable
-     * array class.
+     * @param gateway The LoggerGateway; its node number sets whether this
+     * logger is the gateway or a node.
      */
-    Logger(const char* loggerID, uint16_t loggingIntervalMinutes,
-           VariableArray* inputArray);
+    void attachGateway(LoggerGateway& gateway);
+#endif
+#ifdef MS_LOGGER_FAILOVER
     /**
-     * @brief Construct a new Logger object.
+     * @brief Attach several modems to connect with, failing over between
+     * them (#MS_LOGGER_FAILOVER).
      *
-     * @note The logger ID and logging interval must be specified before the
-     * logger object can be used.
+     * This is used in place of attachModem(); the first link is the modem
+     * for the clock sync at start up and for the testing mode.  Give each
+     * publisher the client of the first link.
+     *
+     * @param links The LoggerLinks with every link already added
      */
-    Logger();
+    void attachLinks(LoggerLinks& links);
+#endif
     /**
-     * @brief Destroy the Logger object - takes no action.
+     * @brief Use the attahed loggerModem to synchronize the real-time clock
+     * with NIST time servers.
+     *
+     * @return **bool** True if clock synchronization was successful
      */
-    virtual ~Logger();
+    bool syncRTC();
 
-    // ===================================================================== //
     /**
-     * @anchor logger_basic_parameters
-     * @name Basic Logging Parameters
-     * Public functions to get and set basic logging paramters
+     * @brief Register a data publisher object to receive data from the logger.
+     *
+     * @param publisher A dataPublisher object
      */
-    /**@{*/
-    // ===================================================================== //
+    void registerDataPublisher(dataPublisher* publisher);
     /**
-     * @brief Set the Logger ID.
+     * @brief Publish data to all registered data publishers.
+     */
+    void publishDataToRemotes(void);
+    /**
+     * @brief Retained for backwards compatibility, use publishDataToRemotes()
+     * in new code.
      *
-     * Unless otherwise specified, files saved to the SD card will be named with
-     * the logger id and the date the file was started.
+     * @m_deprecated_since{0,22,5}
+     */
+    void sendDataToRemotes(void);
+
+#ifdef MS_PUBLISHER_BUDGET
+    /**
+     * @brief Set the longest time to spend sending to the publishers in each
+     * publishDataToRemotes() (#MS_PUBLISHER_BUDGET).
      *
-     * @param loggerID A pointer to the logger ID
+     * @param budgetSeconds The time in seconds; 0, the default, for no limit.
      */
-    void setLoggerID(const char* loggerID);
+    void setPublishBudget(uint16_t budgetSeconds);
+#endif
+
+#ifdef MS_PUBLISHER_OUTBOX
     /**
-     * @brief Get the Logger ID.
+     * @brief Set the longest time to spend sending records from the outbox
+     * after each successful publication.
      *
-     * @return **const char\*** A pointer to the logger ID
+     * @param budgetSeconds The time in seconds; default is 60.
      */
-    const char* getLoggerID() {
-        return _loggerID;
+    void setOutboxBudget(uint16_t budgetSeconds);
+    /**
+     * @brief Add the most recent values of all variables to the outbox for
+     * the given publishers.
+     *
+     * @param pending A bit for each waiting publisher, by its position in
+     * #dataPublishers.
+     * @return **bool** True if the record was saved, or no publisher was
+     * waiting.
+     */
+    bool queueOutboxRecord(uint8_t pending);
+    /**
+     * @brief Send the records in the outbox, oldest first, to the publishers
+     * waiting for them.
+     *
+     * This depends on an internet connection already having been made.
+     *
+     * @param skip A bit for each publisher not to try, ie, because it just
+     * failed; default is none.
+     * @return **uint16_t** The number of records that no publisher is waiting
+     * for anymore.
+     */
+    uint16_t replayOutbox(uint8_t skip = 0);
+    /**
+     * @brief Get the number of outbox records to put in the request being
+     * made by a publisher.
+     *
+     * Publishers that take batches (dataPublisher::publishesBatches()) use
+     * this and loadReplayRecord() to send several records at once.
+     *
+     * @return **uint8_t** The number of records; 0 if the current record is
+     * being published instead of records from the outbox.
+     */
+    uint8_t getReplayRecordCount(void) {
+        return _replayCount;
     }
-
     /**
-     * @brief Set the logging interval in minutes.
+     * @brief Switch the marked time and the values returned by
+     * getValueCharsAtI() to one of the outbox records in the request being
+     * made.
+     *
+     * @param recordNumber The record's place in the request, from 0 to
+     * getReplayRecordCount() - 1.
+     * @return **bool** True if the record was read from the outbox.
+     */
+    bool loadReplayRecord(uint8_t recordNumber);
+#endif
+#ifdef MS_LOGGER_BACKFILL
+    /**
+     * @brief Ask for the logged records of a time range to be sent again to
+     * a publisher (#MS_LOGGER_BACKFILL).
      *
-     * @param loggingIntervalMinutes The frequency with which to update sensor
-     * values and write data to the SD card.
+     * A request during another backfill widens the range to cover both.
+     *
+     * @param publisher The publisher to send the records to
+     * @param fromUTC The UTC Unix time of the start of the range
+     * @param toUTC The UTC Unix time of the end of the range
+     * @return **bool** True if the publisher is registered and the range is
+     * in order.
      */
-    void setLoggingInterval(uint16_t loggingIntervalMinutes);
+    bool requestBackfill(dataPublisher* publisher, uint32_t fromUTC,
+                         uint32_t toUTC);
     /**
-     * @brief Get the Logging Interval.
+     * @brief Check if a backfill is still being sent.
      *
-     * @return **uint16_t** The logging interval in minutes
+     * @return **bool** True if part of a range is still to be sent.
      */
-    uint16_t getLoggingInterval() {
-        return _loggingIntervalMinutes;
+    bool isBackfilling(void) {
+        return _backfillPublishers != 0;
     }
-
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
     /**
-     * @brief Set the universally unique identifier (UUID or GUID) of the
-     * sampling feature.
+     * @brief Set the profiles to step through as the battery runs down
+     * (#MS_LOGGER_POWER_POLICY).
      *
-     * @param samplingFeatureUUID A pointer to the sampling feature UUID
+     * @param battery The battery voltage variable; it must be in the logger's
+     * variable array so it's updated with the rest
+     * @param profiles The profiles, from the highest enterBelow_V to the
+     * lowest; they must last as long as the logger
+     * @param profileCount The number of profiles
+     * @param hysteresis_V How far over a profile's voltage the battery has to
+     * be before it's left; default is 0.1 V.
+     * @param needCharging True to only leave a profile while the voltage is
+     * rising; default is false.
      */
-    void setSamplingFeatureUUID(const char* samplingFeatureUUID);
+    void setPowerPolicy(Variable* battery, const powerProfile* profiles,
+                        uint8_t profileCount, float hysteresis_V = 0.1,
+                        bool needCharging = false);
     /**
-     * @brief Get the Sampling Feature UUID.
+     * @brief Get the profile the logger is in.
      *
-     * @return **const char\*** The sampling feature UUID
+     * @return **int8_t** The position of the profile in the list given to
+     * setPowerPolicy(), or -1 if the battery is good.
      */
-    const char* getSamplingFeatureUUID() {
-        return _samplingFeatureUUID;
+    int8_t getPowerProfile(void) {
+        return _powerLevel;
     }
-
+#endif
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
     /**
-     * @brief Set a digital pin number (on the mcu) to use to control power to
-     * the SD card and activate it as an output pin.
-     *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @brief Set when records are held back on a marginal link
+     * (#MS_LOGGER_ADAPTIVE_PUBLISH).
      *
-     * @warning This functionality is not tested!
-     *
-     * @param SDCardPowerPin A digital pin number on the mcu controlling power
-     * to the SD card.
+     * @param maxLatencyMinutes The longest a record should wait to be
+     * published, in minutes; 0 to always publish right away.
+     * @param goodRSSI The lowest RSSI in dBm of a good connection; default is
+     * -95.
+     * @param slowConnectSeconds The longest time in seconds a good internet
+     * connection takes to make; default is 30.
      */
-    void setSDCardPwr(int8_t SDCardPowerPin);
+    void setPublishPolicy(uint16_t maxLatencyMinutes, int16_t goodRSSI = -95,
+                          uint16_t slowConnectSeconds = 30);
+#endif
+#ifdef MS_LOGGER_CONNECT_BACKOFF
     /**
-     * @brief Send power to the SD card by setting the SDCardPowerPin `HIGH`.
-     *
-     * Optionally waits for the card to "settle."  Has no effect if a pin has
-     * not been set to control power to the SD card.
+     * @brief Set the longest wait between connection attempts after failed
+     * connections (#MS_LOGGER_CONNECT_BACKOFF).
      *
-     * @param waitToSettle True to add a short (6ms) delay between powering on
-     * the card and beginning initialization.  Defaults to true.
+     * @param maxBackoffMinutes The longest time to wait between attempts, in
+     * minutes; default is 1440 (1 day).
      */
-    void turnOnSDcard(bool waitToSettle = true);
+    void setConnectBackoff(uint16_t maxBackoffMinutes = 1440);
+#endif
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
     /**
-     * @brief Cut power to the SD card by setting the SDCardPowerPin `LOW`.
-     *
-     * Optionally waits for the card to do "housekeeping" before cutting the
-     * power.  Has o effect if a pin has not been set to control power to the SD
-     * card.
+     * @brief Set the times to publish, apart from the logging intervals
+     * (#MS_LOGGER_PUBLISH_SCHEDULE).
      *
-     * @param waitForHousekeeping True to add a 1 second delay between to allow
-     * any on-chip writing to complete before cutting power.  Defaults to true.
+     * @param intervalMinutes The time between publications in minutes,
+     * counted from the Unix epoch in the logger's time zone; 0 to publish
+     * each record as it's logged.  The publish times only fall at the same
+     * time each day, from midnight, when the interval divides 24 hours;
+     * otherwise they shift from one day to the next.
+     * @param offsetSeconds How long after the start of each interval to
+     * publish; default is 0.
      */
-    void turnOffSDcard(bool waitForHousekeeping = true);
-
+    void setPublishSchedule(uint16_t intervalMinutes,
+                            uint16_t offsetSeconds = 0);
+#endif
+#ifdef MS_LOGGER_PREWAKE
     /**
-     * @brief Set a digital pin number for the slave select (chip select) of the
-     * SD card and activate it as an output pin.
+     * @brief Set how far ahead of each logging interval to wake the sensors
+     * (#MS_LOGGER_PREWAKE).
      *
-     * This over-writes the value (if any) given in the constructor.  The pin
-     * mode of this pin will be set as `OUTPUT`.
+     * @param leadSeconds The lead in seconds; 0 to wake at the start of the
+     * interval.  Without a call to this, the lead is worked out from the
+     * sensors.
+     */
+    void setPrewakeLead(uint16_t leadSeconds);
+    /**
+     * @brief Get how far ahead of each logging interval the sensors are woken
+     * (#MS_LOGGER_PREWAKE).
      *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @return **uint32_t** The lead in seconds; 0 when the clock isn't set.
+     */
+    uint32_t getPrewakeLead(void);
+#endif
+#ifdef MS_LOGGER_DRIFT_SYNC
+    /**
+     * @brief Set how far the clock may drift before it's synced again
+     * (#MS_LOGGER_DRIFT_SYNC).
      *
-     * @param SDCardSSPin The pin on the mcu connected to the slave select of
-     * the SD card.
+     * @param toleranceSeconds The largest expected error, in seconds; default
+     * is 5, the smallest offset Logger::setRTClock() will correct.
+     * @param maxDays The longest time between syncs, in days; default is 30.
      */
-    void setSDCardSS(int8_t SDCardSSPin);
+    void setClockSyncTolerance(uint16_t toleranceSeconds = 5,
+                               uint16_t maxDays          = 30);
+#endif
 
+ protected:
+#ifndef MS_LOGGER_BINARY_FORMAT
     /**
-     * @brief Set both pin numbers related to the SD card and activate them as
-     * output pins.
-     *
-     * These over-write the values (if any) given in the constructor.  The pin
-     * mode of these pins will be set as `OUTPUT`.
-     *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @brief Write the csv record made in the line buffer out over an Arduino
+     * stream, or print it straight to the stream if it didn't fit.
      *
-     * @param SDCardSSPin The pin on the mcu connected to the slave select of
-     * the SD card.
-     * @param SDCardPowerPin A digital pin number on the mcu controlling power
-     * to the SD card.
+     * @param stream An Arduino stream instance
+     * @param lineLength The length of the record in the line buffer, from
+     * formatSensorDataCSV(); 0 if it didn't fit.
      */
-    void setSDCardPins(int8_t SDCardSSPin, int8_t SDCardPowerPin);
-
-    //
+    void printRecordLine(Stream* stream, uint16_t lineLength);
+#endif
     /**
-     * @brief Set digital pin number for the wake up pin used as an RTC
-     * interrupt and activate it in the given pin mode.
+     * @brief The record being saved or sent, read by getValueCharsAtI() and
+     * getRecordValueAtI() in place of the variables; null otherwise
+     */
+    loggerRecord* _record = nullptr;
+    /**
+     * @brief Copy the current values of all variables and the marked time
+     * into a record and make it the one being saved or sent.
      *
-     * This over-writes the value (if any) given in the constructor.  Use a
-     * value of -1 to prevent the board from attempting to sleep.  If using a
-     * SAMD board with the internal RTC, the value of the pin is irrelevant as
-     * long as it is positive.
+     * @param record The record to fill, which must last until the record is
+     * done with
+     * @param values An array with a place for each variable
+     * @param offsets With #MS_LOGGER_RESULT_TIMES, an array with a place for
+     * each unique sensor of the array for the result times; optional, and
+     * with the default of null no times are kept.
+     */
+    void takeRecord(loggerRecord& record, float* values,
+                    int32_t* offsets = nullptr);
+#ifdef MS_LOGGER_RESULT_TIMES
+    /**
+     * @brief Get the result time of a unique sensor in the record being
+     * saved or sent.
      *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @param sensorNumber The position of the sensor in the array's sensor
+     * list
+     * @return **int32_t** The milliseconds after the mark the sensor gave its
+     * last result; -9999 if it isn't known.
+     */
+    int32_t getResultOffsetAtS(uint8_t sensorNumber);
+    /**
+     * @brief The processor time the time was last marked.
+     */
+    static uint32_t _markedMillis;
+#endif
+    /**
+     * @brief Make a record the one being saved or sent, moving the marked
+     * times to its time.
      *
-     * @note  This sets the pin mode but does NOT enable the interrupt!
+     * @param record The record; null to go back to reading the variables
+     * directly, leaving the marked times as they are.
+     */
+    void useRecord(loggerRecord* record);
+#ifdef MS_PUBLISHER_BUDGET
+    /**
+     * @brief The longest time to spend publishing, in seconds; 0 for no limit
+     */
+    uint16_t _publishBudget = 0;
+#endif
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @brief Open the outbox for reading and writing, starting a new one if
+     * there isn't one for the current variable array.
      *
-     * @param mcuWakePin The pin on the mcu to be used to wake the mcu from deep
-     * sleep.
-     * @param wakePinMode The pin mode to be used for wake up on the clock alert
-     * pin.  Must be either `INPUT` OR `INPUT_PULLUP`.  Optional with a default
-     * value of `INPUT_PULLUP`.  The DS3231 has an active low interrupt, so the
-     * pull-up resistors should be enabled.
+     * @return **bool** True if the outbox is open.
      */
-    void setRTCWakePin(int8_t mcuWakePin, uint8_t wakePinMode = INPUT_PULLUP);
-
+    bool openOutbox(void);
     /**
-     * @brief Set the digital pin number to put out an alert that a measurement
-     * is being logged and activate it as an output pin.
+     * @brief An internal reference to an SdFat file instance for the outbox
+     */
+    File outboxFile;
+    /**
+     * @brief A bit for each publisher that failed in the last
+     * publishDataToRemotes()
+     */
+    uint8_t _publishFailures = 0;
+    /**
+     * @brief The longest time to spend sending queued records, in seconds
+     */
+    uint16_t _outboxBudget = 60;
+    /**
+     * @brief The positions in the outbox of the records in the request being
+     * made by a publisher
+     */
+    uint32_t* _replayPositions = nullptr;
+    /**
+     * @brief The number of records in #_replayPositions
+     */
+    uint8_t _replayCount = 0;
+    /**
+     * @brief Get a bit for each registered publisher, by its position in
+     * #dataPublishers.
      *
-     * The pin mode of this pin will be set as `OUTPUT`.  This is intended to be
-     * a pin with a LED on it so you can see the light come on when a
-     * measurement is being taken.
+     * @return **uint8_t** The publisher bits
+     */
+    uint8_t getPublisherBits(void);
+#endif
+#ifdef MS_LOGGER_BACKFILL
+    /**
+     * @brief Copy the next records of the backfill from the log files into
+     * the outbox, if the outbox is empty.
      *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @return **uint16_t** The number of records copied.
+     */
+    uint16_t queueBackfill(void);
+    /**
+     * @brief Copy the records of the backfill in one log file into the open
+     * outbox.
      *
-     * @param ledPin The pin on the mcu to be held `HIGH` while sensor data is
-     * being collected and logged.
+     * @param fileName The name of the log file
+     * @param pending The publisher bits to queue the records for
+     * @param queued The number of records copied so far on this wake; added
+     * to
+     * @return **bool** False if #MS_BACKFILL_RECORDS was reached before the
+     * end of the file.
      */
-    void setAlertPin(int8_t ledPin);
+    bool queueBackfillFile(const char* fileName, uint8_t pending,
+                           uint16_t& queued);
     /**
-     * @brief Set the alert pin high.
+     * @brief The UTC Unix time of the next record of the backfill to send
      */
-    void alertOn();
+    uint32_t _backfillFrom = 0;
     /**
-     * @brief Set the alert pin low.
+     * @brief The UTC Unix time of the end of the backfill
      */
-    void alertOff();
-
+    uint32_t _backfillTo = 0;
     /**
-     * @brief Set the digital pin number for an interrupt pin used to enter
-     * testing mode, activate that pin as the given input type, **and** attach
-     * the testing interrupt to it.
+     * @brief A bit for each publisher the backfill is for; 0 when there's no
+     * backfill
+     */
+    uint8_t _backfillPublishers = 0;
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+    /**
+     * @brief Move to the profile for the battery voltage just measured and
+     * apply it.
+     */
+    void applyPowerPolicy(void);
+    /**
+     * @brief Check if the record should be published now or held in the
+     * outbox to be sent with the next ones, by the profile.
      *
-     * Intended to be used for a pin attached to a button or other manual
-     * interrupt source.
+     * @return **bool** True to publish now.
+     */
+    bool checkPowerPublishDue(void);
+    /**
+     * @brief The battery voltage variable
+     */
+    Variable* _battery = nullptr;
+    /**
+     * @brief The profiles, from the highest voltage to the lowest
+     */
+    const powerProfile* _powerProfiles = nullptr;
+    /**
+     * @brief The number of #_powerProfiles
+     */
+    uint8_t _powerProfileCount = 0;
+    /**
+     * @brief How far over a profile's voltage the battery has to be to leave
+     * it
+     */
+    float _powerHysteresis = 0.1;
+    /**
+     * @brief True to only leave a profile while the voltage is rising
+     */
+    bool _powerNeedCharging = false;
+    /**
+     * @brief The position of the profile in use; -1 for none
+     */
+    int8_t _powerLevel = -1;
+    /**
+     * @brief The last good battery voltage; -9999 before there is one
+     */
+    float _lastBattery = -9999;
+    /**
+     * @brief The running mean of the change in the battery voltage between
+     * updates
+     */
+    float _batteryTrend = 0;
+    /**
+     * @brief The number of records held since the last publication
+     */
+    uint8_t _powerHeld = 0;
+#endif
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+    /**
+     * @brief Count the new record toward the send interval of every
+     * publisher.
      *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @return **uint8_t** A bit for each publisher that's due to be sent to.
+     */
+    uint8_t countPublisherRecords(void);
+    /**
+     * @brief A bit for each publisher due to be sent to in this
+     * publishDataToRemotes(); all of them outside of logDataAndPublish()
+     */
+    uint8_t _sendDue = 0xFF;
+#endif
+#ifdef MS_LOGGER_PUBLISH_SCHEDULE
+    /**
+     * @brief Check if the current time is a publish time.
      *
-     * Once in testing mode, the logger will attempt to connect the the internet
-     * and take 25 measurements spaced at 5 second intervals writing the results
-     * to the main output destination (ie, Serial).  Testing mode cannot be
-     * entered while the logger is taking a scheduled measureemnt.  No data is
-     * written to the SD card in testing mode.
+     * @return **bool** True if there's a publish schedule and it's time.
+     */
+    bool checkPublishSchedule(void);
+    /**
+     * @brief Get the first publish time after a time.
      *
-     * @param buttonPin The pin on the mcu to listen to for a value-change
-     * interrupt.
-     * @param buttonPinMode The pin mode to be used for the button pin.  Must be
-     * either `INPUT` OR `INPUT_PULLUP`.  Optional with a default value of
-     * `INPUT`.  Using `INPUT_PULLUP` will enable processor input resistors,
-     * while using `INPUT` will explicitly disable them.  If your pin is
-     * externally pulled down or the button is a normally open (NO) switch with
-     * common (COM) connected to Vcc, like the EnviroDIY Mayfly), you should use
-     * the `INPUT` pin mode.  Coversely, if your button connect to ground when
-     * activated, you should enable the processor pull-up resistors using
-     * `INPUT_PULLUP`.
+     * @param localTime The time, as a local epoch time
+     * @return **uint32_t** The next publish time, as a local epoch time.
      */
-    void setTestingModePin(int8_t buttonPin, uint8_t buttonPinMode = INPUT);
-
+    uint32_t getNextPublishTime(uint32_t localTime);
     /**
-     * @brief Set the digital pin numbers and activate pin modes for the five
-     * pins of interest for the logger
+     * @brief Wake the modem, connect, and send everything waiting in the
+     * outbox.
+     */
+    void publishScheduled(void);
+    /**
+     * @brief The time between publications, in minutes; 0 for no schedule
+     */
+    uint16_t _publishIntervalMinutes = 0;
+    /**
+     * @brief The time after the start of each publish interval to publish,
+     * in seconds
+     */
+    uint16_t _publishOffsetSeconds = 0;
+#endif
+#ifdef MS_LOGGER_PREWAKE
+    /**
+     * @brief The pre-wake lead in seconds; 0xFFFF to work it out from the
+     * sensors
+     */
+    uint16_t _prewakeLead = 0xFFFF;
+    /**
+     * @brief The pre-wake lead the last alarm was set with, so the interval
+     * check on waking uses the same one; 0xFFFFFFFF before any alarm
+     */
+    uint32_t _alarmLead = 0xFFFFFFFF;
+#endif
+#ifdef MS_LOGGER_ADAPTIVE_PUBLISH
+    /**
+     * @brief Check if the record should be published now or held in the
+     * outbox because the link has been marginal.
      *
-     * Because this sets the pin mode, this function should only be called
-     * during the `setup()` or `loop()` portion of an Arduino program.
+     * @return **bool** True to publish now.
+     */
+    bool checkPublishDue(void);
+    /**
+     * @brief Record how the last connection went, for checkPublishDue().
      *
-     * @param mcuWakePin The pin on the mcu to listen to for a value-change
-     * interrupt to wake from deep sleep.  The mode of this pin will be set to
-     * `wakePinMode`.
-     * @param SDCardSSPin The pin on the mcu connected to the slave select of
-     * the SD card.  The pin mode of this pin will be set as `OUTPUT`.
-     * @param SDCardPowerPin A digital pin number on the mcu controlling power
-     * to the SD card.  The pin mode of this pin will be set as `OUTPUT`.
-     * @param buttonPin The pin on the mcu to listen to for a value-change
-     * interrupt to enter testing mode.  The mode of this pin will be set to
-     * `buttonPinMode`.
-     * @param ledPin The pin on the mcu to be held `HIGH` while sensor data is
-     * being collected and logged.  The pin mode of this pin will be set as
-     * `OUTPUT`.
-     * @param wakePinMode The pin mode to be used for wake up on the
-     * `mcuWakePin` (clock alert) pin.  Must be either `INPUT` OR
-     * `INPUT_PULLUP`. Optional with a default value of `INPUT_PULLUP`.  The
-     * DS3231 has an active low interrupt, so the pull-up resistors should be
-     * enabled.
-     * @param buttonPinMode The pin mode to be used for the button pin.  Must be
-     * either `INPUT` OR `INPUT_PULLUP`.  Optional with a default value of
-     * `INPUT`.  Using `INPUT_PULLUP` will enable processor input resistors,
-     * while using `INPUT` will explicitly disable them.  If your pin is
-     * externally pulled down or the button is a normally open (NO) switch with
-     * common (COM) connected to Vcc, like the EnviroDIY Mayfly), you should use
-     * the `INPUT` pin mode.  Coversely, if your button is active when connected
-     * to ground, you should enable the processor pull-up resistors using
-     * `INPUT_PULLUP`.
+     * @param connected True if the internet connection was made
+     * @param connectTime The time in milliseconds to make the connection
      */
-    void setLoggerPins(int8_t mcuWakePin, int8_t SDCardSSPin,
-                       int8_t SDCardPowerPin, int8_t buttonPin, int8_t ledPin,
-                       uint8_t wakePinMode   = INPUT_PULLUP,
-                       uint8_t buttonPinMode = INPUT);
-
- protected:
-    // Initialization variables
+    void updatePublishHistory(bool connected, uint32_t connectTime);
+    /**
+     * @brief The longest a record should wait to be published, in minutes;
+     * 0 to always publish right away
+     */
+    uint16_t _maxPublishLatency = 0;
     /**
-     * @brief The logger id
+     * @brief The lowest RSSI in dBm of a good connection
      */
-    const char* _loggerID = "MyLogger";
+    int16_t _goodRSSI = -95;
     /**
-     * @brief The logging interval in minutes
+     * @brief The longest time in seconds a good internet connection takes
      */
-    uint16_t _loggingIntervalMinutes = 5;
+    uint16_t _slowConnect = 30;
     /**
-     * @brief Digital pin number on the mcu controlling the SD card slave
-     * select.
+     * @brief The UTC epoch time of the last connection attempt
      */
-    int8_t _SDCardSSPin = -1;
+    uint32_t _lastPublishAttempt = 0;
     /**
-     * @brief Digital pin number on the mcu controlling SD card power
+     * @brief The UTC epoch time of the oldest record not yet published; 0 if
+     * there isn't one
      */
-    int8_t _SDCardPowerPin = -1;
+    uint32_t _oldestUnpublished = 0;
     /**
-     * @brief Digital pin number on the mcu receiving interrupts to wake from
-     * deep-sleep.
+     * @brief The number of marginal connections in a row
      */
-    int8_t _mcuWakePin = -1;
+    uint8_t _marginalCount = 0;
+#endif
+#ifdef MS_LOGGER_CONNECT_BACKOFF
     /**
-     * @brief The pin mode used for wake up on the clock alert pin.
+     * @brief Check if it's time to try connecting again after failed
+     * connections.
      *
-     * Must be either `INPUT` OR `INPUT_PULLUP` with an AVR board.  On a SAM/D
-     * board `INPUT_PULLDOWN` is also an option.  Optional with a default value
-     * of `INPUT_PULLUP`.  The DS3231 has an active low interrupt, so the
-     * pull-up resistors should be enabled.
+     * @return **bool** True to try connecting now.
      */
-    uint8_t _wakePinMode = INPUT_PULLUP;
+    bool checkConnectDue(void);
     /**
-     * @brief Digital pin number on the mcu used to output an alert that the
-     * logger is measuring.
+     * @brief Wait for the modem to report any signal before trying to connect.
      *
-     * Expected to be connected to a LED.
+     * The check is skipped, returning true, after one that timed out.
+     *
+     * @return **bool** True if the modem reported a signal within
+     * #MS_LOGGER_SIGNAL_CHECK_MS.
      */
-    int8_t _ledPin = -1;
+    bool checkModemSignal(void);
     /**
-     * @brief Digital pin number on the mcu receiving interrupts to enter
-     * testing mode.
+     * @brief Count a failed connection or clear the count after a good one,
+     * and save the count and the time of the next try to the SD card.
      *
-     * Expected to be connected to a user button.
+     * @param connected True if the internet connection was made
      */
-    int8_t _buttonPin = -1;
-
+    void updateConnectBackoff(bool connected);
     /**
-     * @brief The sampling feature UUID
+     * @brief Read the failure count and the time of the next try from the SD
+     * card, the first time they're needed.
      */
-    const char* _samplingFeatureUUID = nullptr;
-    // ^^ Start with no feature UUID
-    /**@}*/
-
-    // ===================================================================== //
+    void loadConnectBackoff(void);
     /**
-     * @anchor logger_internal_array
-     * @name Attached Variable Array Functions
-     * Public functions to get information about the attached variable array
+     * @brief The longest wait between connection attempts, in minutes
      */
-    /**@{*/
-    // ===================================================================== //
-
- public:
+    uint16_t _maxConnectBackoff = 1440;
     /**
-     * @brief Set the variable array object.
-     *
-     * @param inputArray A variable array object instance.  This is NOT an array
-     * of variables, but an object of the variable array class.
+     * @brief The number of failed connections in a row
      */
-    void setVariableArray(VariableArray* inputArray);
-
+    uint8_t _connectFailures = 0;
     /**
-     * @brief Get the number of variables in the internal variable array object.
-     *
-     * @return **uint8_t** The number of variables in the internal variable
-     * array object
+     * @brief The UTC epoch time of the next connection attempt after a failed
+     * one
      */
-    uint8_t getArrayVarCount();
-
+    uint32_t _nextConnectAttempt = 0;
     /**
-     * @brief Get the name of the parent sensor of the variable at the given
-     * position in the internal variable array object.
-     *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The name of the parent sensor of that variable, if
-     * applicable.
+     * @brief Flag.  True after the signal check timed out, until the next
+     * full connection attempt.
      */
-    String getParentSensorNameAtI(uint8_t position_i);
+    bool _signalCheckTimedOut = false;
     /**
-     * @brief Get the name and pin location of the parent sensor of the variable
-     * at the given position in the internal variable array object.
-     *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The concatenated name and pin location of the parent
-     * sensor of that variable, if applicable.
+     * @brief Flag.  True once the failure history has been read from the SD
+     * card
      */
-    String getParentSensorNameAndLocationAtI(uint8_t position_i);
+    bool _connectBackoffLoaded = false;
+#endif
+#ifdef MS_PUBLISHER_DATE_SYNC
     /**
-     * @brief Get the name of the variable at the given position in the
-     * internal variable array object.
+     * @brief Set the clock from the time given by a receiver if it's off by
+     * more than #MS_DATE_SYNC_TOLERANCE seconds (#MS_PUBLISHER_DATE_SYNC).
      *
-     * Variable names must follow the controlled vocabulary documented here:
-     * http://vocabulary.odm2.org/variablename/
+     * @param UTCEpochSeconds The time from the `Date` header of a response
+     */
+    void syncFromServerTime(uint32_t UTCEpochSeconds);
+    /**
+     * @brief The last time given by a receiver; 0 if none has been.
+     */
+    uint32_t _lastServerTime = 0;
+#endif
+#ifdef MS_LOGGER_DRIFT_SYNC
+    /**
+     * @brief Check if the clock is expected to have drifted far enough that
+     * it's time to sync it.
      *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The variable name
+     * @return **bool** True to sync the clock now.
      */
-    String getVarNameAtI(uint8_t position_i);
+    bool checkClockSyncDue(void);
     /**
-     * @brief Get the unit of the variable at the given position in the
-     * internal variable array object.
+     * @brief Work out how fast the clock drifts from the offset measured by a
+     * sync and schedule the next sync.
      *
-     * Variable units must follow the  controlled vocabulary documented here:
-     * http://vocabulary.odm2.org/units/
+     * @param UTCEpochSeconds The time the clock was synced to
+     * @param offset The difference between the given time and the RTC, in
+     * seconds
+     * @param clockSet True if the RTC was set to the given time
+     */
+    void updateClockDrift(uint32_t UTCEpochSeconds, int32_t offset,
+                          bool clockSet);
+    /**
+     * @brief The largest expected error of the clock, in seconds
+     */
+    uint16_t _syncTolerance = 5;
+    /**
+     * @brief The longest time between clock syncs, in days
+     */
+    uint16_t _maxSyncDays = 30;
+    /**
+     * @brief The UTC epoch time the clock was last set, or first checked;
+     * the drift is measured from here
+     */
+    uint32_t _driftReference = 0;
+    /**
+     * @brief The rate the clock is expected to drift, in seconds per second;
+     * 0 until it's been measured
+     */
+    float _driftRate = 0;
+    /**
+     * @brief The UTC epoch time the clock should next be synced
+     */
+    uint32_t _nextClockSync = 0;
+#endif
+    /**
+     * @brief The internal modem instance
      *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The variable unit
+     * @note The internal #_logModem must be a POINTER not a reference because
+     * it is possible for no modem to be attached (and thus the pointer could be
+     * null).  It is not possible to have a null reference.
      */
-    String getVarUnitAtI(uint8_t position_i);
+    loggerModem* _logModem = nullptr;
+    // ^^ Start with no modem attached
     /**
-     * @brief Get the customized code of the variable at the given position in
-     * the internal variable array object.
+     * @brief Wake the modem to publish, or with several links
+     * (#MS_LOGGER_FAILOVER) rank them and wake the first one that wakes.
      *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The variable code
+     * @return **bool** True if a modem woke.
      */
-    String getVarCodeAtI(uint8_t position_i);
+    bool wakeModem(void);
     /**
-     * @brief Get the UUID of the variable at the given position in the internal
-     * variable array object.
+     * @brief Connect the awake modem to the internet, or with several links
+     * (#MS_LOGGER_FAILOVER) fail over to the next ones in turn.
      *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The variable UUID
+     * With #MS_LOGGER_CONNECT_BACKOFF each modem must first report a signal.
+     * With #MS_LOGGER_OVERLAP_MODEM this first finishes the connection
+     * started by beginModemConnect(), if there is one.
+     *
+     * @return **bool** True if a modem connected; it's then the attached
+     * modem.
      */
-    String getVarUUIDAtI(uint8_t position_i);
+    bool connectModem(void);
+#ifdef MS_LOGGER_OVERLAP_MODEM
     /**
-     * @brief Get the most recent value of the variable at the given position in
-     * the internal variable array object.
+     * @brief Start connecting the modem, or with several links
+     * (#MS_LOGGER_FAILOVER) the best ranked one, without waiting for it
+     * (#MS_LOGGER_OVERLAP_MODEM).
      *
-     * @param position_i The position of the variable in the array.
-     * @return **String** The value of the variable as a string with the correct
-     * number of significant figures.
+     * The connection then takes a step each time pollModemConnect() is
+     * called and is finished by connectModem().
      */
-    String getValueStringAtI(uint8_t position_i);
-
- protected:
+    void beginModemConnect(void);
     /**
-     * @brief A pointer to the internal variable array instance
+     * @brief Take the next step of the connection started by
+     * beginModemConnect(); this is given to VariableArray::setUpdatePoll().
+     *
+     * @param logger The logger connecting.
      */
-    VariableArray* _internalArray;
-    /**@}*/
-
-    // ===================================================================== //
+    static void pollModemConnect(void* logger);
     /**
-     * @anchor logger_internet
-     * @name Internet and Publisher Functions
-     * Public functions for internet and dataPublishers
+     * @brief True if a connection was started by beginModemConnect() and
+     * not yet finished by connectModem().
      */
-    /**@{*/
-    // ===================================================================== //
-
- public:
+    bool _connectBegun = false;
+#endif
+#ifdef MS_MODEM_PSM_SCHEDULE
     /**
-     * @brief Attach a loggerModem to the logger to provide internet access.
-     *
-     * See [Modem and Internet Functions](@ref the_modems)
-     * for more information on how the modem must be set up before it is
-     * attached to the logger.  You must include an ampersand to tie in the
-     * already created modem!  If you do not attach a modem, no action will be
-     * taken to publish data.
+     * @brief Give the attached modem the time between publishes to work out
+     * its power saving timers (#MS_MODEM_PSM_SCHEDULE).
      *
-     * @param modem An instance of the loggerModem class
+     * This is the logging interval, times the shortest send interval of the
+     * publishers (#MS_PUBLISHER_SEND_INTERVAL) and the records published
+     * together on a low battery (#MS_LOGGER_POWER_POLICY), unless there's a
+     * publish schedule (#MS_LOGGER_PUBLISH_SCHEDULE).
      */
-    void attachModem(loggerModem& modem);
+    void scheduleModemPSM(void);
+#endif
+#ifdef MS_LOGGER_FAILOVER
     /**
-     * @brief Use the attahed loggerModem to synchronize the real-time clock
-     * with NIST time servers.
-     *
-     * @return **bool** True if clock synchronization was successful
+     * @brief The modems to fail over between; null if there's only an
+     * attached modem (#MS_LOGGER_FAILOVER)
      */
-    bool syncRTC();
-
+    LoggerLinks* _links = nullptr;
     /**
-     * @brief Register a data publisher object to receive data from the logger.
-     *
-     * @param publisher A dataPublisher object
+     * @brief The link in use, by the position it was added in
      */
-    void registerDataPublisher(dataPublisher* publisher);
+    uint8_t _link = 0;
     /**
-     * @brief Publish data to all registered data publishers.
+     * @brief The rank of the link in use on this publish
      */
-    void publishDataToRemotes(void);
+    uint8_t _linkRank = 0;
     /**
-     * @brief Retained for backwards compatibility, use publishDataToRemotes()
-     * in new code.
+     * @brief The processor time the links started being woken for this
+     * publish
+     */
+    uint32_t _linkStart = 0;
+    /**
+     * @brief Switch to another link: make its modem the attached one and move
+     * the publishers on the old link's client to its client.
      *
-     * @m_deprecated_since{0,22,5}
+     * @param link The position the link was added in
      */
-    void sendDataToRemotes(void);
-
- protected:
+    void useLink(uint8_t link);
+#endif
+#ifdef MS_LOGGER_GATEWAY
     /**
-     * @brief The internal modem instance
+     * @brief The radio link to the gateway or the nodes; null if there is
+     * none (#MS_LOGGER_GATEWAY)
+     */
+    LoggerGateway* _gateway = nullptr;
+    /**
+     * @brief Send the queued records of the nodes to the publishers, oldest
+     * first.
      *
-     * @note The internal #_logModem must be a POINTER not a reference because
-     * it is possible for no modem to be attached (and thus the pointer could be
-     * null).  It is not possible to have a null reference.
+     * This depends on an internet connection already having been made.  The
+     * records are sent with the node's variables and sampling feature in
+     * place of the logger's own.
      */
-    loggerModem* _logModem = nullptr;
-    // ^^ Start with no modem attached
+    void publishNodeRecords(void);
+#endif
 
     /**
      * @brief An array of all of the attached data publishers
@@ -743,6 +2785,16 @@ class Logger {
      * @param ts The number of seconds since 1970.
      */
     static void setNowUTCEpoch(uint32_t ts);
+#ifdef MS_LOGGER_CACHE_RTC
+    /**
+     * @brief Read the RTC again the next time the time is asked for, instead
+     * of counting on from the last read (#MS_LOGGER_CACHE_RTC).
+     *
+     * This is done after every sleep; call it if the RTC was changed some
+     * other way or `millis()` stopped without Logger::systemSleep().
+     */
+    static void resyncRTCCache(void);
+#endif
 
     /**
      * @brief Convert the number of seconds from January 1, 1970 to a DateTime
@@ -814,8 +2866,30 @@ class Logger {
      * seconds.  It is not currently possible to output the instantaneous time
      * an individual sensor was updated, just a single marked time.  By custom,
      * this should be called before updating the sensors, not after.
+     *
+     * The marked time is also formatted as text once, here, for all of the
+     * data outputs to share; see getMarkedTimeISO8601() and
+     * getMarkedTimeCSV().
      */
     static void markTime(void);
+    /**
+     * @brief Get the marked time as ISO8601 text with the logger's time zone,
+     * like "2024-01-01T12:00:00-05:00".
+     *
+     * The text is only made again when the marked time changes.
+     *
+     * @return **const char\*** The marked time as ISO8601 text.
+     */
+    static const char* getMarkedTimeISO8601(void);
+    /**
+     * @brief Get the marked time as the text used in a csv data record, like
+     * "2024-01-01 12:00:00".
+     *
+     * The text is only made again when the marked time changes.
+     *
+     * @return **const char\*** The marked time as csv text.
+     */
+    static const char* getMarkedTimeCSV(void);
 
     /**
      * @brief Check if the CURRENT time is an even interval of the logging rate
@@ -838,6 +2912,26 @@ class Logger {
      * logging rate.
      */
     bool checkMarkedInterval(void);
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    /**
+     * @brief Check which sampling groups are due, marking the time if any
+     * are and it hasn't been marked yet.
+     *
+     * @param timeMarked True if checkInterval() just marked the time for the
+     * main variable array.
+     * @return **uint8_t** A bit for each sampling group that is due.
+     */
+    uint8_t checkGroupIntervals(bool timeMarked);
+#endif
+#ifdef MS_LOGGER_EVENT_TRIGGER
+    /**
+     * @brief Check if the current time is an even interval of the event
+     * interval, marking the time if it is.
+     *
+     * @return **bool** True if the event trigger should be sampled now.
+     */
+    bool checkEventInterval(void);
+#endif
 
  protected:
     /**
@@ -857,6 +2951,43 @@ class Logger {
     static int8_t _loggerRTCOffset;
     /**@}*/
 
+    /**
+     * @brief Write the marked local time into the shared timestamp texts.
+     */
+    static void formatMarkedTime(void);
+    /**
+     * @brief The marked time as ISO8601 text
+     */
+    static char _markedTimeISO8601[26];
+    /**
+     * @brief The marked time as csv text
+     */
+    static char _markedTimeCSV[20];
+    /**
+     * @brief The marked local time the timestamp texts were made for
+     */
+    static uint32_t _markedTimeFormatted;
+#ifdef MS_LOGGER_CACHE_RTC
+    /**
+     * @brief Read the UTC epoch time from the RTC itself.
+     *
+     * @return **uint32_t** The number of seconds from 1970-01-01T00:00:00Z0000
+     */
+    static uint32_t readRTCUTCEpoch(void);
+    /**
+     * @brief The UTC epoch time last read from the RTC
+     */
+    static uint32_t _rtcCacheEpoch;
+    /**
+     * @brief The processor time in ms of the last read of the RTC
+     */
+    static uint32_t _rtcCacheMillis;
+    /**
+     * @brief True if the last read of the RTC can still be counted on from
+     */
+    static bool _rtcCacheValid;
+#endif
+
     // ===================================================================== //
     /**
      * @anchor logger_sleep
@@ -1009,6 +3140,16 @@ class Logger {
     String getFileName(void) {
         return _fileName;
     }
+#ifdef MS_LOGGER_FILE_ROTATION
+    /**
+     * @brief Set when a new auto-named log file is started.
+     *
+     * @param maxFileSize The largest size of a log file in bytes; 0 (the
+     * default) for no limit.
+     * @param daily True (the default) to start a new file each day.
+     */
+    void setLogRotation(uint32_t maxFileSize, bool daily = true);
+#endif
 
     /**
      * @brief Print a header out to a stream.
@@ -1019,16 +3160,78 @@ class Logger {
      * @param stream An Arduino stream instance - expected to be an SdFat file -
      * but could also be the "main" Serial port for debugging.
      */
-    virtual void printFileHeader(Stream* stream);
-
+    virtual void printFileHeader(Stream* stream);
+
+    /**
+     * @brief Print a comma separated list of volues of sensor data -
+     * including the time in the logging timezone -  out over an Arduino stream
+     *
+     * @param stream An Arduino stream instance - expected to be an SdFat file -
+     * but could also be the "main" Serial port for debugging.
+     */
+    void printSensorDataCSV(Stream* stream);
+    /**
+     * @brief Write the same comma separated record as printSensorDataCSV()
+     * into a character buffer, ending with a carriage return and new line.
+     *
+     * @param buffer The buffer to write the record into; it is not null
+     * terminated.
+     * @param size The size of the buffer.
+     * @return **uint16_t** The length of the record, or 0 if it didn't fit.
+     */
+    uint16_t formatSensorDataCSV(char* buffer, uint16_t size);
+
+    /**
+     * @brief Write the header of a binary log file out over an Arduino stream.
+     *
+     * See #MS_LOGGER_BINARY_FORMAT for the layout.
+     *
+     * @param stream An Arduino stream instance - expected to be an SdFat file.
+     */
+    void printBinaryFileHeader(Stream* stream);
+
+    /**
+     * @brief Write a binary record of the marked time and the values of all
+     * variables out over an Arduino stream.
+     *
+     * See #MS_LOGGER_BINARY_FORMAT for the layout.
+     *
+     * @param stream An Arduino stream instance - expected to be an SdFat file.
+     */
+    void writeSensorDataBinary(Stream* stream);
+#ifdef MS_LOGGER_DELTA_ENCODING
+    /**
+     * @brief Encode a record as a keyframe or as the change from the last
+     * record.
+     *
+     * See #MS_LOGGER_DELTA_ENCODING for the layout.
+     *
+     * @param buffer The buffer for the record, with room for at least 6 bytes
+     * and 5 more for each variable.
+     * @param recordTime The local epoch time of the record.
+     * @param values The value of each variable in the record.
+     * @return **uint16_t** The length of the encoded record.
+     */
+    uint16_t encodeDeltaRecord(uint8_t* buffer, uint32_t recordTime,
+                               const float* values);
+    /**
+     * @brief The variable array the last record was encoded for; a nullptr to
+     * make the next record a keyframe.
+     */
+    VariableArray* _deltaArray = nullptr;
+    /**
+     * @brief The number of records since the last keyframe
+     */
+    uint8_t _deltaSinceKeyframe = 0;
     /**
-     * @brief Print a comma separated list of volues of sensor data -
-     * including the time in the logging timezone -  out over an Arduino stream
-     *
-     * @param stream An Arduino stream instance - expected to be an SdFat file -
-     * but could also be the "main" Serial port for debugging.
+     * @brief The local epoch time of the last record
      */
-    void printSensorDataCSV(Stream* stream);
+    uint32_t _deltaLastTime = 0;
+    /**
+     * @brief The whole values of the last record
+     */
+    int32_t _deltaLastValues[MS_DELTA_MAX_VARIABLES];
+#endif
 
     /**
      * @brief Create a file on the SD card and set the created, modified, and
@@ -1100,23 +3303,254 @@ class Logger {
      * _and_ data appended to it.
      */
     bool logToSD(void);
+#ifdef MS_LOGGER_PROFILE
+    /**
+     * @brief Append the trace of the LoggerProfiler to its file on the SD card
+     * (#MS_PROFILE_TRACE_SUFFIX) and empty the trace.
+     *
+     * This powers up the SD card if the records are buffered, so call it
+     * where the card is being written anyway, like once a day.
+     *
+     * @return **bool** True if the trace was written.
+     */
+    bool writeProfileTrace(void);
+#endif
+
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+    /**
+     * @brief Set the largest number of records to hold in the record buffer
+     * before writing them to the SD card.
+     *
+     * @param recordsPerFlush The number of records; 0 (the default) to only
+     * write the buffer when it is full.
+     */
+    void setRecordsPerFlush(uint8_t recordsPerFlush);
+    /**
+     * @brief Set a function to check after each record is buffered; if it
+     * returns true all buffered records are written to the SD card at once.
+     *
+     * Use this to save the buffered data when the battery is low or power is
+     * about to be lost.
+     *
+     * @param flushCheck A function returning true if the buffer should be
+     * written now.
+     */
+    void setFlushCheck(bool (*flushCheck)(void));
+#ifdef MS_LOGGER_RECORD_STORE
+    /**
+     * @brief Keep the buffered records in non-volatile memory instead of
+     * RAM.
+     *
+     * See #MS_LOGGER_RECORD_STORE.  Call this in the setup, before any
+     * records are buffered.
+     *
+     * @param store The memory to keep the records in
+     */
+    void setRecordStore(LoggerRecordStore* store);
+#endif
+    /**
+     * @brief Add a line with the most recent values of all variables in the
+     * variable array to the record buffer.
+     *
+     * If the buffer is too full for the line, the buffered records are first
+     * written to the SD card.
+     *
+     * @return **bool** True if the line was buffered or written to the card
+     * and any buffered records written on the way made it to the card.
+     */
+    bool bufferRecord(void);
+    /**
+     * @brief Power the SD card and append all buffered records to the log
+     * file in a single session.
+     *
+     * Only the records that were written are dropped from the buffer or the
+     * record store (#MS_LOGGER_RECORD_STORE); the rest are kept to try
+     * again at the next flush.
+     *
+     * @return **bool** True if the records were written, or there were none.
+     */
+    bool flushRecordBuffer(void);
+    /**
+     * @brief Get the number of records waiting in the record buffer.
+     *
+     * @return **uint16_t** The number of buffered records
+     */
+    uint16_t getBufferedRecordCount(void) {
+        return _recordsBuffered;
+    }
+#endif
 
  protected:
     // The SD card and file
+#ifdef MS_LOGGER_SHARED_SD
+    /**
+     * @brief An internal reference to SdFat for SD card control, shared by
+     * every logger (#MS_LOGGER_SHARED_SD)
+     */
+    static SdFat sd;
+#if defined(MS_LOGGER_SD_DMA) && defined(ARDUINO_ARCH_SAMD)
+    /**
+     * @brief The SPI driver moving the SD card's data with DMA
+     */
+    static LoggerSdSpiDMA _sdSpiDriver;
+#endif
+    /**
+     * @brief True between openSDSession() and closeSDSession()
+     */
+    static bool _sdSessionOpen;
+#ifdef MS_LOGGER_PERSISTENT_SD
+    /**
+     * @brief The first of the loggers sharing the card, to close all of their
+     * files before it loses power
+     */
+    static Logger* _sdLoggers;
+    /**
+     * @brief The next logger sharing the card
+     */
+    Logger* _nextSDLogger = nullptr;
+#endif
+#else
     /**
      * @brief An internal reference to SdFat for SD card control
      */
     SdFat sd;
+#if defined(MS_LOGGER_SD_DMA) && defined(ARDUINO_ARCH_SAMD)
+    /**
+     * @brief The SPI driver moving the SD card's data with DMA
+     */
+    LoggerSdSpiDMA _sdSpiDriver;
+#endif
+#endif
     /**
      * @brief An internal reference to an SdFat file instance
      */
     File logFile;
+#ifdef MS_LOGGER_SECTOR_WRITER
+    /**
+     * @brief Gathers the records appended to #logFile into whole sectors
+     */
+    LoggerSectorWriter _sectorWriter;
+#endif
+    /**
+     * @brief Get the stream that records are appended to the log file
+     * through.
+     *
+     * @return **Stream\*** The log file, or with #MS_LOGGER_SECTOR_WRITER
+     * the sector writer in front of it.
+     */
+    Stream* logFileStream(void) {
+#ifdef MS_LOGGER_SECTOR_WRITER
+        return &_sectorWriter;
+#else
+        return &logFile;
+#endif
+    }
     /**
      * @brief An internal reference to the current filename
      */
     String _fileName = "";
     // ^^ Initialize with no file name
 
+#ifdef MS_LOGGER_SAMPLING_GROUPS
+    /**
+     * @brief Update each sampling group that is due and save its record to
+     * its file.
+     *
+     * @param due A bit for each sampling group to log, from
+     * checkGroupIntervals().
+     */
+    void logSamplingGroups(uint8_t due);
+
+    /**
+     * @brief The variable arrays of the sampling groups
+     */
+    VariableArray* _groupArrays[MS_LOGGER_MAX_SAMPLING_GROUPS];
+    /**
+     * @brief The logging interval of each sampling group in minutes
+     */
+    uint16_t _groupIntervals[MS_LOGGER_MAX_SAMPLING_GROUPS];
+    /**
+     * @brief The file each sampling group is saved to; blank until first used
+     * if it's generated
+     */
+    String _groupFileNames[MS_LOGGER_MAX_SAMPLING_GROUPS];
+    /**
+     * @brief The number of sampling groups
+     */
+    uint8_t _groupCount = 0;
+#endif
+
+#ifdef MS_LOGGER_EVENT_TRIGGER
+    /**
+     * @brief Check the trigger with the newest values, starting or ending an
+     * event, and keep the record in the pre-trigger ring if it isn't saved.
+     *
+     * @return **bool** True if the record should be saved to the log file.
+     */
+    bool checkEventTrigger(void);
+    /**
+     * @brief Add the current record to the pre-trigger ring, dropping the
+     * oldest record if it's full.
+     */
+    void keepEventRecord(void);
+    /**
+     * @brief Save the records in the pre-trigger ring to the log file, oldest
+     * first, and empty the ring.
+     */
+    void saveEventRing(void);
+
+    /**
+     * @brief The variable that triggers an event; null if there is none.
+     */
+    Variable* _eventTrigger = nullptr;
+    /**
+     * @brief The value at or above which there is an event
+     */
+    float _eventThreshold = -9999;
+    /**
+     * @brief The rate of rise per minute at or above which there is an event
+     */
+    float _eventRisePerMinute = -9999;
+    /**
+     * @brief The event interval in minutes
+     */
+    uint16_t _eventInterval = 1;
+    /**
+     * @brief The number of records without the trigger that end an event
+     */
+    uint8_t _eventQuietRecords = 3;
+    /**
+     * @brief The number of quiet records left before the current event ends;
+     * 0 if there is no event.
+     */
+    uint8_t _eventQuietLeft = 0;
+    /**
+     * @brief True if the logger woke only to sample for the event trigger
+     */
+    bool _eventWake = false;
+    /**
+     * @brief The last good value of the trigger variable
+     */
+    float _eventLastValue = -9999;
+    /**
+     * @brief The marked local time of the last good trigger value
+     */
+    uint32_t _eventLastTime = 0;
+    /**
+     * @brief The ring of pre-trigger records; each is the local time and
+     * then a float per variable.
+     */
+    uint8_t _eventRing[MS_LOGGER_EVENT_RING_BYTES];
+    /**
+     * @brief The position in the ring of the oldest record
+     */
+    uint16_t _eventRingHead = 0;
+    /**
+     * @brief The number of records in the ring
+     */
+    uint16_t _eventRingCount = 0;
+#endif
+
     /**
      * @brief Check if the SD card is available and ready to write to.
      *
@@ -1130,9 +3564,12 @@ class Logger {
     /**
      * @brief Generate a file name from the logger id and the current date.
      *
+     * @param sequence A number to add to the name to tell apart several files
+     * from the same day; 0 (the default) for none.
+     *
      * @note This cannot be called until *after* the RTC is started
      */
-    void generateAutoFileName(void);
+    void generateAutoFileName(uint8_t sequence = 0);
 
     /**
      * @brief Set a timestamp on a file.
@@ -1154,6 +3591,263 @@ class Logger {
      * @return **bool** True if a file was successfully opened or created.
      */
     bool openFile(String& filename, bool createFile, bool writeDefaultHeader);
+    /**
+     * @brief Save the records just written to the open log file.
+     *
+     * This sets the modified and accessed timestamps of the file (if
+     * #MS_LOGGER_SD_STAMP_MINUTES says it's time) and closes it, or with
+     * #MS_LOGGER_PERSISTENT_SD only syncs it.
+     *
+     * @return **bool** True if the file was saved.
+     */
+    bool saveLogFile(void);
+    /**
+     * @brief Print the rows of the file header after the file name - the
+     * sensor names, variable names, units, UUIDs, and codes.
+     *
+     * @param stream The stream or buffer to print to
+     */
+    void printFileHeaderRows(Print* stream);
+#ifdef MS_LOGGER_HEADER_CACHE
+    /**
+     * @brief Put the rows of the file header into #_headerCache
+     * (#MS_LOGGER_HEADER_CACHE).
+     */
+    void buildHeaderCache(void);
+    /**
+     * @brief The rows of the file header, made in begin()
+     */
+    char _headerCache[MS_LOGGER_HEADER_CACHE_SIZE];
+    /**
+     * @brief The length of #_headerCache; 0 if the header didn't fit
+     */
+    uint16_t _headerCacheLength = 0;
+    /**
+     * @brief The variable array #_headerCache was made from
+     */
+    VariableArray* _headerCacheArray = nullptr;
+#endif
+#ifdef MS_LOGGER_PERSISTENT_SD
+    /**
+     * @brief Close the log file, if it's open, and forget that the card was
+     * mounted.
+     */
+    void endSDSession(void);
+#endif
+#ifdef MS_LOGGER_JOURNAL
+    /**
+     * @brief Check if the open log file is the main one, rather than the
+     * file of a sampling group.
+     *
+     * @return True if the open log file has the name in #_fileName
+     */
+    bool logFileIsMain(void);
+    /**
+     * @brief Write the end of the data in the main log file that's just been
+     * saved to the journal (#MS_LOGGER_JOURNAL).
+     *
+     * @param fileSize The end of the data in the log file, in bytes
+     */
+    void writeJournal(uint32_t fileSize);
+    /**
+     * @brief Cut back anything written to a log file after the newest good
+     * journal entry that isn't a whole record.
+     *
+     * This only does anything the first time it's called after a restart
+     * for the main log file.
+     *
+     * @param fileName The name of the log file
+     */
+    void recoverFromJournal(const char* fileName);
+    /**
+     * @brief The sequence number of the last journal entry written
+     */
+    uint32_t _journalSequence = 0;
+    /**
+     * @brief True once the journal has been read since the restart
+     */
+    bool _journalChecked = false;
+#endif
+#ifdef MS_LOGGER_SHARED_SD
+    /**
+     * @brief True if the SD card has been mounted since it was last powered,
+     * by any of the loggers; without #MS_LOGGER_PERSISTENT_SD, only in the
+     * session.
+     */
+    static bool _sdMounted;
+#elif defined(MS_LOGGER_PERSISTENT_SD)
+    /**
+     * @brief True if the SD card has been mounted since it was last powered.
+     */
+    bool _sdMounted = false;
+#endif
+#ifdef MS_LOGGER_SD_STAMP_MINUTES
+    /**
+     * @brief The UTC epoch time the log file timestamps were last set; 0 if
+     * not since the restart
+     */
+    uint32_t _lastFileStamp = 0;
+#endif
+#ifdef MS_LOGGER_FILE_ROTATION
+    /**
+     * @brief Move on to a new auto-named file if the current one is from an
+     * earlier day or has reached the largest size.
+     */
+    void rotateLogFile(void);
+    /**
+     * @brief Add records just saved to the current file's line in the index.
+     *
+     * @param firstTime The local epoch time of the first of the records
+     * @param lastTime The local epoch time of the last of the records
+     * @param records The number of records
+     * @return **bool** True if the index was updated.
+     */
+    bool updateLogIndex(uint32_t firstTime, uint32_t lastTime,
+                        uint16_t records);
+
+    /**
+     * @brief True if #_fileName was generated rather than set by the user
+     */
+    bool _autoFileName = false;
+    /**
+     * @brief The largest size of a log file in bytes; 0 for no limit
+     */
+    uint32_t _rotateFileSize = 0;
+    /**
+     * @brief True to start a new log file each day
+     */
+    bool _rotateDaily = true;
+    /**
+     * @brief The position of the current file's line in the index; -1 if it
+     * hasn't been looked up yet
+     */
+    int32_t _indexEntryPos = -1;
+    /**
+     * @brief The local epoch time of the first record in the current file
+     */
+    uint32_t _fileFirstTime = 0;
+    /**
+     * @brief The local epoch time of the last record in the current file
+     */
+    uint32_t _fileLastTime = 0;
+    /**
+     * @brief The number of records in the current file
+     */
+    uint32_t _fileRecordCount = 0;
+#endif
+#ifdef MS_LOGGER_RECORD_BUFFER_SIZE
+    /**
+     * @brief Append a record with the most recent values of all variables to
+     * the record buffer - a csv line, or a binary record with
+     * #MS_LOGGER_BINARY_FORMAT.
+     *
+     * @return **bool** True if the whole record fit in the buffer; if not, the
+     * buffer is left as it was.
+     */
+    bool appendRecord(void);
+    /**
+     * @brief Write records from the record buffer to the log file.
+     *
+     * @param length The number of bytes of records at the start of the
+     * buffer.
+     * @return **uint16_t** The number of bytes of the buffer that were
+     * written.
+     */
+    uint16_t writeRecordBuffer(uint16_t length);
+    /**
+     * @brief Count the records at the start of the record buffer.
+     *
+     * @param length The number of bytes of records at the start of the
+     * buffer.
+     * @return **uint16_t** The number of records, counting one that's cut
+     * short.
+     */
+    uint16_t countBufferRecords(uint16_t length);
+#ifdef MS_LOGGER_RECORD_STORE
+    /**
+     * @brief Get the record store ready, picking up any records left in it.
+     *
+     * @return **bool** True if there is a record store to use.
+     */
+    bool openRecordStore(void);
+    /**
+     * @brief Save the number of records in the record store in its header.
+     */
+    void saveRecordStoreHeader(void);
+    /**
+     * @brief Write the records in the record store to the log file, a buffer
+     * at a time.
+     *
+     * If only some were written, the rest are moved to the start of the store.
+     *
+     * @return **bool** True if all of the records were written.
+     */
+    bool writeRecordStore(void);
+
+    /**
+     * @brief The non-volatile memory for the buffered records
+     */
+    LoggerRecordStore* _recordStore = nullptr;
+    /**
+     * @brief True once the record store is ready and its header read
+     */
+    bool _recordStoreOpen = false;
+    /**
+     * @brief The number of bytes of records in the record store
+     */
+    uint32_t _recordStoreUsed = 0;
+#endif
+
+#ifdef MS_LOGGER_RETAINED_BUFFER
+    /**
+     * @brief Bring the header of the retained record buffer up to date with
+     * the records in it (#MS_LOGGER_RETAINED_BUFFER).
+     */
+    void saveRetainedBuffer(void);
+    /**
+     * @brief Take back the records left in the retained record buffer by a
+     * reset, if its header and hash still match.
+     */
+    void recoverRetainedBuffer(void);
+
+    /**
+     * @brief The records waiting to be written to the card, kept through a
+     * reset
+     */
+    static char _recordBuffer[MS_LOGGER_RECORD_BUFFER_SIZE];
+#else
+    /**
+     * @brief The records waiting to be written to the card
+     */
+    char _recordBuffer[MS_LOGGER_RECORD_BUFFER_SIZE];
+#endif
+    /**
+     * @brief The number of characters used in #_recordBuffer
+     */
+    uint16_t _recordBufferUsed = 0;
+    /**
+     * @brief The number of records in #_recordBuffer
+     */
+    uint16_t _recordsBuffered = 0;
+    /**
+     * @brief The number of records to buffer before writing; 0 to fill it
+     */
+    uint8_t _recordsPerFlush = 0;
+    /**
+     * @brief The function checked to decide if the buffer must be written now
+     */
+    bool (*_flushCheck)(void) = nullptr;
+#ifdef MS_LOGGER_FILE_ROTATION
+    /**
+     * @brief The local epoch time of the oldest record in #_recordBuffer
+     */
+    uint32_t _bufferFirstTime = 0;
+    /**
+     * @brief The local epoch time of the newest record in #_recordBuffer
+     */
+    uint32_t _bufferLastTime = 0;
+#endif
+#endif
     /**@}*/
 
     // ===================================================================== //
@@ -1186,8 +3880,68 @@ class Logger {
      * to the "main" output - ie Serial - and NOT to the SD card.  After 25
      * measurements, the sensors are put to sleep, the modem is disconnected
      * from the internet, and the logger goes back to sleep.
+     *
+     * With #MS_LOGGER_STREAMING this runs streamingMode() on the main output
+     * instead.  With #MS_LOGGER_DOWNLOAD a 'D' received right at the start
+     * runs downloadMode() instead.
      */
     virtual void testingMode();
+#ifdef MS_LOGGER_STREAMING
+    /**
+     * @brief Stream the values of all of the variables until told to stop
+     * (#MS_LOGGER_STREAMING).
+     *
+     * All of the sensors are powered up and woken, then updated over and over
+     * with no wait between updates.  After each update a CSV line of the
+     * processor time in milliseconds and the value of each variable is
+     * printed; the first line has the variable codes.  The stream ends when
+     * any character is received on the stream or after
+     * #MS_STREAMING_TIMEOUT_S, and the sensors are then put to sleep and
+     * powered down.  Nothing is written to the SD card or published.
+     *
+     * @param stream An Arduino Stream instance to print to and to listen for
+     * the stop on; like Serial
+     */
+    void streamingMode(Stream* stream);
+#endif
+#ifdef MS_LOGGER_DOWNLOAD
+    /**
+     * @brief Answer commands to copy the files on the SD card over a stream
+     * (#MS_LOGGER_DOWNLOAD).
+     *
+     * "READY" is printed once the card is mounted.  Each command is one line:
+     * - `L` lists the files in the root of the card, one line each of the
+     * size in bytes and the name, then "END".
+     * - `G <offset> <name>` sends the file from the byte offset to its end.
+     * Each block is a '#', the offset of the block as a uint32_t, the number
+     * of bytes as a uint16_t, the bytes, and then a CRC-16/CCITT (polynomial
+     * 0x1021, starting at 0xFFFF) of everything after the '#'; all numbers
+     * are little-endian.  A block of no bytes ends the file.  Any byte
+     * received during a transfer stops it, so a block with a bad CRC can be
+     * sent again by asking for the file from that block's offset; the same
+     * command picks up an interrupted download.
+     * - `Q` ends the download.
+     *
+     * Anything else gets "ERR", as does a file that can't be opened.  The
+     * download also ends after #MS_DOWNLOAD_TIMEOUT_S without a command.
+     *
+     * @param stream An Arduino Stream instance to send the files over and to
+     * read the commands from; like Serial
+     */
+    void downloadMode(Stream* stream);
+
+ protected:
+    /**
+     * @brief Send part of a file in download blocks.
+     *
+     * @param stream The Stream to send the blocks over
+     * @param fileName The name of the file
+     * @param offset The position in the file to start from
+     */
+    void sendFileBlocks(Stream* stream, const char* fileName, uint32_t offset);
+
+ public:
+#endif
     /**@}*/
 
     // ===================================================================== //
@@ -1240,6 +3994,15 @@ class Logger {
      * - they must happen at run time, not at compile time.
      */
     virtual void begin();
+#ifdef MS_LOGGER_WARM_BOOT
+    /**
+     * @brief Check if begin() found the same set up as before the last reset,
+     * with the clock still set (#MS_LOGGER_WARM_BOOT).
+     *
+     * @return **bool** True if this is a warm boot.
+     */
+    bool isWarmBoot(void);
+#endif
 
     /**
      * @brief This is a one-and-done to log data
@@ -1249,6 +4012,9 @@ class Logger {
     /**
      * @brief This is a one-and-done to log data and publish the results to any
      * associated publishers.
+     *
+     * With #MS_LOGGER_OVERLAP_MODEM the modem starts connecting before the
+     * sensors are updated and registers on the network in the meantime.
      */
     void logDataAndPublish(void);
 
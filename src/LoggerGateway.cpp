@@ -0,0 +1,225 @@
+/**
+ * @file LoggerGateway.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the LoggerGateway class.
+ */
+
+#include "LoggerGateway.h"
+
+#ifdef MS_LOGGER_GATEWAY
+
+// The positions in each frame
+#define GATEWAY_POS_TYPE 1
+#define GATEWAY_POS_NODE 2
+#define GATEWAY_POS_COUNT 3
+#define GATEWAY_POS_TIME 4
+#define GATEWAY_POS_VALUES 8
+
+
+LoggerGateway::LoggerGateway(Stream* radio, uint8_t nodeNumber)
+    : _radio(radio),
+      _nodeNumber(nodeNumber) {
+    for (uint8_t i = 0; i < MS_GATEWAY_QUEUE_SIZE; i++) {
+        _queue[i].pending = 0;
+    }
+}
+LoggerGateway::~LoggerGateway() {}
+
+
+bool LoggerGateway::registerNode(uint8_t nodeNumber, VariableArray* nodeArray,
+                                 const char* samplingFeatureUUID,
+                                 uint8_t     publishers) {
+    if (_nodeCount >= MS_GATEWAY_MAX_NODES || nodeArray == nullptr) {
+        return false;
+    }
+    _nodes[_nodeCount].number              = nodeNumber;
+    _nodes[_nodeCount].variables           = nodeArray;
+    _nodes[_nodeCount].samplingFeatureUUID = samplingFeatureUUID;
+    _nodes[_nodeCount].publishers          = publishers;
+    _nodes[_nodeCount].lastHeard           = 0;
+    _nodeCount++;
+    return true;
+}
+
+
+uint8_t LoggerGateway::crc8(const uint8_t* data, uint16_t length) {
+    uint8_t crc = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+
+// The numbers are sent in the byte order of the processor; every board the
+// library supports is little-endian
+void LoggerGateway::sendFrame(gatewayFrameType type, uint8_t nodeNumber,
+                              uint32_t utcEpoch, const float* values,
+                              uint8_t count) {
+    uint8_t frame[MS_GATEWAY_FRAME_OVERHEAD + 4 * MS_GATEWAY_MAX_VALUES];
+    frame[0]                 = MS_GATEWAY_FRAME_MARKER;
+    frame[GATEWAY_POS_TYPE]  = type;
+    frame[GATEWAY_POS_NODE]  = nodeNumber;
+    frame[GATEWAY_POS_COUNT] = count;
+    memcpy(frame + GATEWAY_POS_TIME, &utcEpoch, sizeof(utcEpoch));
+    if (count > 0) { memcpy(frame + GATEWAY_POS_VALUES, values, 4 * count); }
+    uint16_t end = GATEWAY_POS_VALUES + 4 * count;
+    frame[end]   = crc8(frame + 1, end - 1);
+    _radio->write(frame, end + 1);
+    _radio->flush();
+}
+
+
+bool LoggerGateway::readFrame(uint32_t wait_ms) {
+    uint32_t start = millis();
+    while (millis() - start < wait_ms) {
+        if (_radio->available() == 0) {
+            delay(1);
+            continue;
+        }
+        if (_radio->read() != MS_GATEWAY_FRAME_MARKER) { continue; }
+        _frame[0] = MS_GATEWAY_FRAME_MARKER;
+        // The rest of the frame comes right after the marker
+        _radio->setTimeout(200);
+        if (_radio->readBytes(_frame + 1, GATEWAY_POS_VALUES - 1) !=
+            GATEWAY_POS_VALUES - 1) {
+            continue;
+        }
+        uint8_t count = _frame[GATEWAY_POS_COUNT];
+        if (count > MS_GATEWAY_MAX_VALUES) { continue; }
+        uint16_t end  = GATEWAY_POS_VALUES + 4 * count;
+        size_t   rest = end + 1 - GATEWAY_POS_VALUES;
+        if (_radio->readBytes(_frame + GATEWAY_POS_VALUES, rest) != rest) {
+            continue;
+        }
+        if (_frame[end] == crc8(_frame + 1, end - 1)) { return true; }
+        MS_DBG(F("Dropping a radio frame with a bad CRC"));
+    }
+    return false;
+}
+
+
+bool LoggerGateway::sendRecord(uint32_t utcEpoch, const float* values,
+                               uint8_t count) {
+    if (count > MS_GATEWAY_MAX_VALUES) {
+        MS_DBG(F("Only the first"), MS_GATEWAY_MAX_VALUES,
+               F("values can be sent to the gateway"));
+        count = MS_GATEWAY_MAX_VALUES;
+    }
+    uint32_t start = millis();
+    while (millis() - start < MS_GATEWAY_SEND_MS) {
+        MS_DBG(F("Sending the record to the gateway as node"), _nodeNumber);
+        sendFrame(GATEWAY_FRAME_RECORD, _nodeNumber, utcEpoch, values, count);
+        uint32_t sent = millis();
+        while (true) {
+            // Take the time once, so the wait can't wrap past the limit
+            uint32_t waited = millis() - sent;
+            if (waited >= MS_GATEWAY_ACK_WAIT_MS) { break; }
+            if (!readFrame(MS_GATEWAY_ACK_WAIT_MS - waited)) { break; }
+            uint32_t ackTime;
+            memcpy(&ackTime, _frame + GATEWAY_POS_TIME, sizeof(ackTime));
+            if (_frame[GATEWAY_POS_TYPE] == GATEWAY_FRAME_ACK &&
+                _frame[GATEWAY_POS_NODE] == _nodeNumber &&
+                ackTime == utcEpoch) {
+                MS_DBG(F("The gateway has the record"));
+                return true;
+            }
+        }
+    }
+    PRINTOUT(F("The gateway didn't acknowledge the record"));
+    return false;
+}
+
+
+bool LoggerGateway::queueFrame(void) {
+    if (_frame[GATEWAY_POS_TYPE] != GATEWAY_FRAME_RECORD) { return false; }
+    uint8_t node = 0;
+    while (node < _nodeCount &&
+           _nodes[node].number != _frame[GATEWAY_POS_NODE]) {
+        node++;
+    }
+    if (node == _nodeCount) {
+        MS_DBG(F("Ignoring a record from unknown node"),
+               _frame[GATEWAY_POS_NODE]);
+        return false;
+    }
+    uint8_t count = _frame[GATEWAY_POS_COUNT];
+    if (count != _nodes[node].variables->getVariableCount()) {
+        MS_DBG(F("Ignoring a record with"), count, F("values from node"),
+               _nodes[node].number);
+        return false;
+    }
+    uint32_t utcEpoch;
+    memcpy(&utcEpoch, _frame + GATEWAY_POS_TIME, sizeof(utcEpoch));
+    // Acknowledge it even if it's a repeat, since the last acknowledgement
+    // didn't get there
+    sendFrame(GATEWAY_FRAME_ACK, _nodes[node].number, utcEpoch, nullptr, 0);
+    // The last record queued from the node may already have been published
+    // and left the queue
+    if (_nodes[node].lastHeard == utcEpoch) { return false; }
+    for (uint8_t i = 0; i < MS_GATEWAY_QUEUE_SIZE; i++) {
+        if (_queue[i].pending != 0 && _queue[i].node == node &&
+            _queue[i].utcEpoch == utcEpoch) {
+            return false;
+        }
+    }
+
+    queuedRecord& slot = _queue[_queueNext];
+    if (slot.pending != 0) {
+        MS_DBG(F("The gateway queue is full; dropping the oldest record"));
+    }
+    slot.node     = node;
+    slot.pending  = 0xFF;
+    slot.utcEpoch = utcEpoch;
+    memcpy(slot.values, _frame + GATEWAY_POS_VALUES, 4 * count);
+    _queueNext             = (_queueNext + 1) % MS_GATEWAY_QUEUE_SIZE;
+    _nodes[node].lastHeard = utcEpoch;
+    MS_DBG(F("Queued a record from node"), _nodes[node].number);
+    return true;
+}
+
+
+uint8_t LoggerGateway::listen(uint32_t sinceUTC, uint32_t listen_ms) {
+    uint8_t  queued = 0;
+    uint32_t start  = millis();
+    while (true) {
+        // Take the time once, so the wait can't wrap past the limit
+        uint32_t listened = millis() - start;
+        if (listened >= listen_ms) { break; }
+        if (!readFrame(listen_ms - listened)) { break; }
+        if (!queueFrame()) { continue; }
+        queued++;
+        bool allHeard = true;
+        for (uint8_t i = 0; i < _nodeCount; i++) {
+            if (_nodes[i].lastHeard < sinceUTC) { allHeard = false; }
+        }
+        if (allHeard) { break; }
+    }
+    MS_DBG(F("Queued"), queued, F("records from the nodes"));
+    return queued;
+}
+
+
+LoggerGateway::queuedRecord* LoggerGateway::nextQueued(queuedRecord* after) {
+    // The oldest record is in the slot the next one will be written to, so
+    // count the age of each slot from there
+    uint8_t k = 0;
+    if (after != nullptr) {
+        k = ((after - _queue) + MS_GATEWAY_QUEUE_SIZE - _queueNext) %
+                MS_GATEWAY_QUEUE_SIZE +
+            1;
+    }
+    for (; k < MS_GATEWAY_QUEUE_SIZE; k++) {
+        uint8_t slot = (_queueNext + k) % MS_GATEWAY_QUEUE_SIZE;
+        if (_queue[slot].pending != 0) { return &_queue[slot]; }
+    }
+    return nullptr;
+}
+
+#endif  // MS_LOGGER_GATEWAY
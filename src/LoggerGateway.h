@@ -0,0 +1,292 @@
+/**
+ * @file LoggerGateway.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the LoggerGateway class, which sends the records of nearby
+ * loggers over a radio link to one gateway logger that publishes them all.
+ */
+
+// Header Guards
+#ifndef SRC_LOGGERGATEWAY_H_
+#define SRC_LOGGERGATEWAY_H_
+
+// Debugging Statement
+// #define MS_LOGGERGATEWAY_DEBUG
+
+#ifdef MS_LOGGERGATEWAY_DEBUG
+#define MS_DEBUGGING_STD "LoggerGateway"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "VariableArray.h"
+
+#ifdef MS_LOGGER_GATEWAY
+#ifndef MS_GATEWAY_MAX_NODES
+/**
+ * @brief The number of nodes a gateway can take records from.
+ */
+#define MS_GATEWAY_MAX_NODES 4
+#endif
+
+#ifndef MS_GATEWAY_QUEUE_SIZE
+/**
+ * @brief The number of node records a gateway holds until they're published.
+ *
+ * Each takes 6 bytes and 4 for each of #MS_GATEWAY_MAX_VALUES.  Once the
+ * queue is full the oldest record is written over.
+ */
+#define MS_GATEWAY_QUEUE_SIZE 8
+#endif
+
+#ifndef MS_GATEWAY_MAX_VALUES
+/**
+ * @brief The most variables in a node's record.
+ */
+#define MS_GATEWAY_MAX_VALUES 16
+#endif
+
+#ifndef MS_GATEWAY_LISTEN_MS
+/**
+ * @brief The longest a gateway listens for the nodes' records on each
+ * logging interval, in milliseconds.
+ */
+#define MS_GATEWAY_LISTEN_MS 30000L
+#endif
+
+#ifndef MS_GATEWAY_SEND_MS
+/**
+ * @brief The longest a node keeps sending its record until the gateway
+ * acknowledges it, in milliseconds.
+ */
+#define MS_GATEWAY_SEND_MS 30000L
+#endif
+
+#ifndef MS_GATEWAY_ACK_WAIT_MS
+/**
+ * @brief The time a node waits for the gateway's acknowledgement before
+ * sending its record again, in milliseconds.
+ */
+#define MS_GATEWAY_ACK_WAIT_MS 1000L
+#endif
+
+/**
+ * @brief The first byte of every radio frame.
+ */
+#define MS_GATEWAY_FRAME_MARKER 0xA7
+/**
+ * @brief The bytes of a radio frame around its values - the marker, the
+ * type, the node, the value count, the time, and the check.
+ */
+#define MS_GATEWAY_FRAME_OVERHEAD 9
+
+/**
+ * @brief The kinds of radio frames between the nodes and the gateway.
+ */
+typedef enum gatewayFrameType : uint8_t {
+    GATEWAY_FRAME_RECORD = 'R',  ///< A node's record
+    GATEWAY_FRAME_ACK    = 'A',  ///< The gateway got a record
+} gatewayFrameType;
+
+
+/**
+ * @brief The LoggerGateway class sends the records of nearby loggers (the
+ * nodes) over a low-power radio link to one logger with a modem (the
+ * gateway), which publishes them all in its own connection
+ * (#MS_LOGGER_GATEWAY).
+ *
+ * The radio is any Stream that passes bytes through, like an XBee 900HP in
+ * transparent mode or a LoRa module with a serial bridge.  Each record is
+ * sent as one frame: the marker, the frame type, the node number, the number
+ * of values, the UTC time of the record, the values as 4-byte floats, and a
+ * CRC-8 of everything after the marker.  The gateway answers each good
+ * record with an acknowledgement frame with the same node number and time
+ * and no values.  A node sends its record again every
+ * #MS_GATEWAY_ACK_WAIT_MS until it's acknowledged or #MS_GATEWAY_SEND_MS
+ * has passed; the gateway throws out repeats of a record it already has,
+ * including the node's last record once it's been published.
+ *
+ * The gateway must be told the variables of each node with registerNode(),
+ * in the same order as the node's own variable array.  The variables can be
+ * made without sensors, since only their codes, UUIDs, and resolutions are
+ * used.  The gateway listens for #MS_GATEWAY_LISTEN_MS after updating its
+ * own sensors, or until every node has been heard from, so the nodes and the
+ * gateway should log on the same interval with their clocks set.
+ *
+ * @ingroup base_classes
+ */
+class LoggerGateway {
+ public:
+    /**
+     * @brief Construct a new LoggerGateway object.
+     *
+     * @param radio The stream instance of the radio
+     * @param nodeNumber The number of this logger on the radio link, from 1
+     * to 255; 0 for the gateway
+     */
+    explicit LoggerGateway(Stream* radio, uint8_t nodeNumber = 0);
+    /**
+     * @brief Destroy the LoggerGateway object - no action taken.
+     */
+    ~LoggerGateway();
+
+    /**
+     * @brief Check if this logger is the gateway.
+     *
+     * @return **bool** True for the gateway, false for a node.
+     */
+    bool isGateway(void) {
+        return _nodeNumber == 0;
+    }
+
+    /**
+     * @brief Tell the gateway about a node it takes records from.
+     *
+     * @param nodeNumber The number of the node on the radio link
+     * @param nodeArray The variables of the node, in the order of the node's
+     * own variable array
+     * @param samplingFeatureUUID The sampling feature UUID of the node
+     * @param publishers A bit for each of the gateway's publishers, by its
+     * position in Logger::dataPublishers, that should get the node's records;
+     * optional with the default of all of them.
+     * @return **bool** True if there was room for the node.
+     */
+    bool registerNode(uint8_t nodeNumber, VariableArray* nodeArray,
+                      const char* samplingFeatureUUID,
+                      uint8_t     publishers = 0xFF);
+
+    /**
+     * @brief Send a record to the gateway and wait until it's acknowledged.
+     *
+     * @param utcEpoch The UTC epoch time of the record
+     * @param values The values of the record
+     * @param count The number of values; at most #MS_GATEWAY_MAX_VALUES
+     * @return **bool** True if the gateway acknowledged the record.
+     */
+    bool sendRecord(uint32_t utcEpoch, const float* values, uint8_t count);
+    /**
+     * @brief Listen for the records of the nodes and queue them.
+     *
+     * This stops early once every node has sent a record taken since the
+     * given time.
+     *
+     * @param sinceUTC The UTC epoch time the records of this interval are
+     * taken after
+     * @param listen_ms The longest to listen, in milliseconds
+     * @return **uint8_t** The number of new records queued.
+     */
+    uint8_t listen(uint32_t sinceUTC,
+                   uint32_t listen_ms = MS_GATEWAY_LISTEN_MS);
+
+    /**
+     * @brief A record from a node, queued at the gateway until every
+     * publisher it's for has taken it.
+     */
+    typedef struct queuedRecord {
+        uint8_t  node;     ///< The position of the node in the registry
+        uint8_t  pending;  ///< A bit for each publisher still to send to; 0
+                           ///< when the slot is free
+        uint32_t utcEpoch;                      ///< The time of the record
+        float    values[MS_GATEWAY_MAX_VALUES];  ///< The values of the record
+    } queuedRecord;
+
+    /**
+     * @brief Get the oldest queued record that a publisher is still waiting
+     * for.
+     *
+     * @param after The record to start after; null to start from the oldest
+     * @return **queuedRecord\*** The record, or null if there are no more.
+     */
+    queuedRecord* nextQueued(queuedRecord* after = nullptr);
+    /**
+     * @brief Get the variables of the node a queued record is from.
+     *
+     * @param record The queued record
+     * @return **VariableArray\*** The node's variables.
+     */
+    VariableArray* getNodeArray(queuedRecord* record) {
+        return _nodes[record->node].variables;
+    }
+    /**
+     * @brief Get the sampling feature UUID of the node a queued record is
+     * from.
+     *
+     * @param record The queued record
+     * @return **const char\*** The node's sampling feature UUID.
+     */
+    const char* getNodeSamplingFeature(queuedRecord* record) {
+        return _nodes[record->node].samplingFeatureUUID;
+    }
+    /**
+     * @brief Get the publishers that should get records from the node a
+     * queued record is from.
+     *
+     * @param record The queued record
+     * @return **uint8_t** A bit for each publisher.
+     */
+    uint8_t getNodePublishers(queuedRecord* record) {
+        return _nodes[record->node].publishers;
+    }
+
+ private:
+    /**
+     * @brief A node the gateway takes records from.
+     */
+    typedef struct gatewayNode {
+        uint8_t        number;     ///< The number of the node on the link
+        VariableArray* variables;  ///< The variables of the node
+        const char*    samplingFeatureUUID;  ///< The node's sampling feature
+        uint8_t        publishers;  ///< The publishers to send the records to
+        uint32_t       lastHeard;   ///< The time of the last record queued
+    } gatewayNode;
+
+    /**
+     * @brief Calculate the CRC-8 (polynomial 0x07) of some bytes.
+     *
+     * @param data The bytes
+     * @param length The number of bytes
+     * @return **uint8_t** The CRC.
+     */
+    static uint8_t crc8(const uint8_t* data, uint16_t length);
+    /**
+     * @brief Send a frame over the radio.
+     *
+     * @param type The gatewayFrameType
+     * @param nodeNumber The node the frame is from or for
+     * @param utcEpoch The time of the record
+     * @param values The values; null for none
+     * @param count The number of values
+     */
+    void sendFrame(gatewayFrameType type, uint8_t nodeNumber,
+                   uint32_t utcEpoch, const float* values, uint8_t count);
+    /**
+     * @brief Read the next good frame from the radio into #_frame.
+     *
+     * @param wait_ms The longest to wait for a frame to start, in milliseconds
+     * @return **bool** True if a whole frame with a good CRC was read.
+     */
+    bool readFrame(uint32_t wait_ms);
+    /**
+     * @brief Queue the record in #_frame and acknowledge it.
+     *
+     * @return **bool** True if the record was new.
+     */
+    bool queueFrame(void);
+
+    Stream*      _radio;
+    uint8_t      _nodeNumber;
+    gatewayNode  _nodes[MS_GATEWAY_MAX_NODES];
+    uint8_t      _nodeCount = 0;
+    queuedRecord _queue[MS_GATEWAY_QUEUE_SIZE];
+    uint8_t      _queueNext = 0;
+    /**
+     * @brief The last frame read from the radio
+     */
+    uint8_t _frame[MS_GATEWAY_FRAME_OVERHEAD + 4 * MS_GATEWAY_MAX_VALUES];
+};
+#endif  // MS_LOGGER_GATEWAY
+
+#endif  // SRC_LOGGERGATEWAY_H_
@@ -0,0 +1,92 @@
+/**
+ * @file LoggerLinks.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the LoggerLinks class.
+ */
+
+#include "LoggerLinks.h"
+
+#ifdef MS_LOGGER_FAILOVER
+
+LoggerLinks::LoggerLinks() {}
+LoggerLinks::~LoggerLinks() {}
+
+
+bool LoggerLinks::addLink(loggerModem& modem, Client* client, uint8_t cost,
+                          uint32_t maxConnectTime_ms) {
+    if (_linkCount >= MS_FAILOVER_MAX_LINKS) { return false; }
+    loggerLink& link       = _links[_linkCount];
+    link.modem             = &modem;
+    link.client            = client;
+    link.cost              = cost;
+    link.maxConnectTime_ms = maxConnectTime_ms;
+    // Until it's been tried, expect it to connect in half its time limit
+    link.connectTime_ms = maxConnectTime_ms / 2;
+    link.successRate    = 255;
+    link.tried          = false;
+    _order[_linkCount]  = _linkCount;
+    _linkCount++;
+    return true;
+}
+
+
+uint32_t LoggerLinks::getScore(uint8_t link) {
+    const loggerLink& l = _links[link];
+    // A failure costs the whole time limit before the next link is tried, and
+    // a link that succeeds a fraction p of the time fails (1 - p) / p times
+    // for each success, so a link that keeps failing soon costs more than any
+    // step of cost
+    return static_cast<uint32_t>(l.cost) * MS_FAILOVER_COST_MS +
+        l.connectTime_ms +
+        l.maxConnectTime_ms * (255 - l.successRate) / (l.successRate + 1);
+}
+
+
+void LoggerLinks::rank(void) {
+    for (uint8_t i = 0; i < _linkCount; i++) {
+        if (!_links[i].tried) {
+            _links[i].successRate += (255 - _links[i].successRate +
+                                      (1 << MS_FAILOVER_RECOVERY) - 1) >>
+                MS_FAILOVER_RECOVERY;
+        }
+        _links[i].tried = false;
+    }
+    // There are only a few, so sort them by insertion; ties keep the order
+    // the links were added in
+    for (uint8_t i = 0; i < _linkCount; i++) { _order[i] = i; }
+    for (uint8_t i = 1; i < _linkCount; i++) {
+        uint8_t  link  = _order[i];
+        uint32_t score = getScore(link);
+        uint8_t  j     = i;
+        while (j > 0 && getScore(_order[j - 1]) > score) {
+            _order[j] = _order[j - 1];
+            j--;
+        }
+        _order[j] = link;
+    }
+    MS_DBG(F("Trying"), _links[_order[0]].modem->getModemName(),
+           F("first, with a score of"), getScore(_order[0]));
+}
+
+
+void LoggerLinks::recordAttempt(uint8_t link, bool connected,
+                                uint32_t connectTime_ms) {
+    loggerLink& l = _links[link];
+    l.tried       = true;
+    // Both are moving averages over about the last four attempts
+    if (connected) {
+        l.connectTime_ms = (3 * l.connectTime_ms + connectTime_ms) / 4;
+        l.successRate    = (3 * static_cast<uint16_t>(l.successRate) + 255) /
+            4;
+    } else {
+        l.successRate = (3 * static_cast<uint16_t>(l.successRate)) / 4;
+    }
+    MS_DBG(l.modem->getModemName(), connected ? F("connected") : F("failed"),
+           F("in"), connectTime_ms, F("ms; its success rate is now"),
+           l.successRate);
+}
+
+#endif  // MS_LOGGER_FAILOVER
@@ -0,0 +1,212 @@
+/**
+ * @file LoggerLinks.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the LoggerLinks class, which keeps several modems for one
+ * logger and ranks them by their cost and how they've been connecting.
+ */
+
+// Header Guards
+#ifndef SRC_LOGGERLINKS_H_
+#define SRC_LOGGERLINKS_H_
+
+// Debugging Statement
+// #define MS_LOGGERLINKS_DEBUG
+
+#ifdef MS_LOGGERLINKS_DEBUG
+#define MS_DEBUGGING_STD "LoggerLinks"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "LoggerModem.h"
+#include "Client.h"
+
+#ifdef MS_LOGGER_FAILOVER
+#ifndef MS_FAILOVER_MAX_LINKS
+/**
+ * @brief The number of modems a logger can fail over between.
+ */
+#define MS_FAILOVER_MAX_LINKS 3
+#endif
+
+#ifndef MS_FAILOVER_CONNECT_MS
+/**
+ * @brief The default longest time each link is given to connect, in
+ * milliseconds.
+ */
+#define MS_FAILOVER_CONNECT_MS 20000L
+#endif
+
+#ifndef MS_FAILOVER_BUDGET_MS
+/**
+ * @brief The longest time spent connecting over all of the links together
+ * at each publish, in milliseconds.
+ */
+#define MS_FAILOVER_BUDGET_MS 60000L
+#endif
+
+#ifndef MS_FAILOVER_COST_MS
+/**
+ * @brief How many milliseconds of connecting each step of a link's cost is
+ * worth when the links are ranked.
+ *
+ * With the default, a link one step more expensive is only used first if
+ * the cheaper one takes 30 seconds longer to connect on average.
+ */
+#define MS_FAILOVER_COST_MS 30000L
+#endif
+
+#ifndef MS_FAILOVER_RECOVERY
+/**
+ * @brief How fast the success rate of a link that isn't tried climbs back,
+ * as a shift; each publish it's skipped it gets 1/2^n of the way back to
+ * 100%.
+ *
+ * This is what brings a link that failed back to the front once it's
+ * likely to be working again.
+ */
+#define MS_FAILOVER_RECOVERY 3
+#endif
+
+
+/**
+ * @brief The LoggerLinks class keeps several modems for one logger - like a
+ * WiFi and a cellular modem - and decides which to connect with first
+ * (#MS_LOGGER_FAILOVER).
+ *
+ * Each link is a modem, the client the publishers use over it, a cost, and
+ * the longest it's given to connect.  The links are ranked on each publish by
+ * their cost times #MS_FAILOVER_COST_MS, plus their average time to connect,
+ * plus their connection time limit times the failures expected for each
+ * success at their recent success rate.  A cheap link that's up is tried
+ * first; one that keeps failing - about four times in a row with the
+ * defaults - drops behind the others until its success rate climbs back by
+ * #MS_FAILOVER_RECOVERY.
+ * The logger tries each link in order until one connects or
+ * #MS_FAILOVER_BUDGET_MS has passed, powering each failed modem down before
+ * waking the next.
+ *
+ * Attach the links with Logger::attachLinks() in place of
+ * Logger::attachModem().  Each publisher that was given the client of a link
+ * is moved to the client of the link that's used.
+ *
+ * @ingroup base_classes
+ */
+class LoggerLinks {
+ public:
+    /**
+     * @brief Construct a new LoggerLinks object with no links.
+     */
+    LoggerLinks();
+    /**
+     * @brief Destroy the LoggerLinks object - no action taken.
+     */
+    ~LoggerLinks();
+
+    /**
+     * @brief Add a modem to fail over to.
+     *
+     * @param modem The loggerModem of the link
+     * @param client The client the publishers send over the link
+     * @param cost How expensive the link is to use; 0 for the cheapest, like
+     * WiFi, and more for metered ones, like cellular
+     * @param maxConnectTime_ms The longest the link is given to connect, in
+     * milliseconds; optional with a default of #MS_FAILOVER_CONNECT_MS.
+     * @return **bool** True if there was room for the link.
+     */
+    bool addLink(loggerModem& modem, Client* client, uint8_t cost,
+                 uint32_t maxConnectTime_ms = MS_FAILOVER_CONNECT_MS);
+    /**
+     * @brief Get the number of links.
+     *
+     * @return **uint8_t** The number of links added.
+     */
+    uint8_t getLinkCount(void) {
+        return _linkCount;
+    }
+    /**
+     * @brief Get the modem of a link.
+     *
+     * @param link The position the link was added in
+     * @return **loggerModem\*** The modem.
+     */
+    loggerModem* getModem(uint8_t link) {
+        return _links[link].modem;
+    }
+    /**
+     * @brief Get the client of a link.
+     *
+     * @param link The position the link was added in
+     * @return **Client\*** The client.
+     */
+    Client* getClient(uint8_t link) {
+        return _links[link].client;
+    }
+    /**
+     * @brief Get the longest a link is given to connect.
+     *
+     * @param link The position the link was added in
+     * @return **uint32_t** The time in milliseconds.
+     */
+    uint32_t getMaxConnectTime(uint8_t link) {
+        return _links[link].maxConnectTime_ms;
+    }
+
+    /**
+     * @brief Rank the links for the next publish.
+     *
+     * This also lets the success rate of each link that wasn't tried since
+     * the last ranking climb back.
+     */
+    void rank(void);
+    /**
+     * @brief Get a link by its rank.
+     *
+     * @param position The rank, from 0 for the one to try first
+     * @return **uint8_t** The position the link was added in.
+     */
+    uint8_t getRanked(uint8_t position) {
+        return _order[position];
+    }
+    /**
+     * @brief Keep the result of trying to connect with a link.
+     *
+     * @param link The position the link was added in
+     * @param connected True if it connected
+     * @param connectTime_ms How long it took, in milliseconds
+     */
+    void recordAttempt(uint8_t link, bool connected, uint32_t connectTime_ms);
+    /**
+     * @brief Get the score of a link; the lowest is tried first.
+     *
+     * @param link The position the link was added in
+     * @return **uint32_t** The expected cost of trying the link, in
+     * milliseconds.
+     */
+    uint32_t getScore(uint8_t link);
+
+ private:
+    /**
+     * @brief A modem the logger can connect with.
+     */
+    typedef struct loggerLink {
+        loggerModem* modem;              ///< The modem of the link
+        Client*      client;             ///< The publishers' client
+        uint8_t      cost;               ///< How expensive the link is
+        uint32_t     maxConnectTime_ms;  ///< The longest it's given
+        uint32_t     connectTime_ms;     ///< The average time to connect
+        uint8_t      successRate;        ///< The recent successes, of 255
+        bool         tried;              ///< If it was tried since ranking
+    } loggerLink;
+
+    loggerLink _links[MS_FAILOVER_MAX_LINKS];
+    uint8_t    _order[MS_FAILOVER_MAX_LINKS];
+    uint8_t    _linkCount = 0;
+};
+#endif  // MS_LOGGER_FAILOVER
+
+#endif  // SRC_LOGGERLINKS_H_
@@ -17,6 +17,9 @@ float   loggerModem::_priorModemTemp      = -9999;
 float   loggerModem::_priorBatteryState   = -9999;
 float   loggerModem::_priorBatteryPercent = -9999;
 float   loggerModem::_priorBatteryVoltage = -9999;
+#ifdef MS_MODEM_STATS
+modemStats loggerModem::_stats = {};
+#endif
 
 // Constructor
 loggerModem::loggerModem(int8_t powerPin, int8_t statusPin, bool statusLevel,
@@ -86,11 +89,25 @@ void loggerModem::modemPowerUp(void) {
         digitalWrite(_powerPin, HIGH);
         // Mark the time that the sensor was powered
         _millisPowerOn = millis();
+#ifdef MS_MODEM_WARM_STANDBY
+        _coldStart = true;
+#endif
+#ifdef MS_MODEM_NETWORK_SELECT
+        _operatorPending = true;
+#endif
     } else {
         MS_DBG(F("Power to"), getModemName(),
                F("is not controlled by this library."));
         // Mark the power-on time, just in case it had not been marked
-        if (_millisPowerOn == 0) _millisPowerOn = millis();
+        if (_millisPowerOn == 0) {
+            _millisPowerOn = millis();
+#ifdef MS_MODEM_WARM_STANDBY
+            _coldStart = true;
+#endif
+#ifdef MS_MODEM_NETWORK_SELECT
+            _operatorPending = true;
+#endif
+        }
     }
 }
 
@@ -101,6 +118,13 @@ void loggerModem::modemPowerDown(void) {
         digitalWrite(_powerPin, LOW);
         // Unset the power-on time
         _millisPowerOn = 0;
+#ifdef MS_MODEM_STAY_REGISTERED
+        _powerSaving = false;
+#endif
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+        // The modem is back at its default rate when it's powered again
+        resetModemBaud();
+#endif
     } else {
         MS_DBG(F("Power to"), getModemName(),
                F("is not controlled by this library."));
@@ -201,6 +225,22 @@ bool loggerModem::modemSleep(void) {
 bool loggerModem::modemSleepPowerDown(void) {
     bool     success = true;
     uint32_t start   = millis();
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    _connectState = MODEM_CONNECT_IDLE;
+#endif
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+    _metadataCaptured = false;
+#endif
+#ifdef MS_MODEM_STAY_REGISTERED
+    if (_stayRegistered && _powerSaving) {
+        // The modem drops into PSM on its own when its active timer runs out
+        MS_DBG(F("Leaving"), getModemName(),
+               F("powered and registered in power saving mode."));
+        modemLEDOff();
+        return true;
+    }
+    _powerSaving = false;
+#endif
     MS_DBG(F("Turning"), getModemName(), F("off."));
 
     modemSleep();
@@ -250,6 +290,190 @@ bool loggerModem::modemSleepPowerDown(void) {
     return success;
 }
 
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+void loggerModem::beginConnect(uint32_t maxConnectionTime) {
+    setModemPinModes();
+    if (_millisPowerOn == 0) { modemPowerUp(); }
+    _connectStarted     = millis();
+    _connectStepStarted = _connectStarted;
+#ifdef MS_MODEM_STATS
+    _stats.connectAttempts++;
+#endif
+    _lastConnectPoll    = 0;
+    _connectTimeout     = maxConnectionTime;
+    _connectState       = MODEM_CONNECT_WAKING;
+}
+
+modemConnectState loggerModem::pollConnect(void) {
+    // Without a step by step connection for this modem, connect all at once
+    if (_connectState == MODEM_CONNECT_WAKING) {
+        uint32_t elapsed = millis() - _connectStarted;
+        uint32_t remaining =
+            elapsed < _connectTimeout ? _connectTimeout - elapsed : 1;
+#ifdef MS_MODEM_STATS
+        // connectInternet() counts this connection again
+        _stats.connectAttempts--;
+#endif
+        _connectState = connectInternet(remaining) ? MODEM_CONNECT_CONNECTED
+                                                   : MODEM_CONNECT_FAILED;
+    }
+    return _connectState;
+}
+#endif
+
+#ifdef MS_MODEM_STAY_REGISTERED
+void loggerModem::setStayRegistered(bool stayRegistered,
+                                    const char* periodicTAU,
+                                    const char* activeTime,
+                                    const char* eDRXCycle) {
+    _stayRegistered = stayRegistered;
+    _psmPeriodicTAU = periodicTAU;
+    _psmActiveTime  = activeTime;
+    _eDRXCycle      = eDRXCycle;
+    // The timers are (re-)requested at the next connection
+    _powerSaving = false;
+}
+#endif
+
+#ifdef MS_MODEM_PSM_SCHEDULE
+// The units of the timers from 3GPP TS 24.008, finest first, with their codes
+static const uint32_t psmPeriodicUnits[] = {2, 30, 60, 600, 3600, 36000,
+                                            1152000L};
+static const uint8_t  psmPeriodicCodes[] = {0b011, 0b100, 0b101, 0b000,
+                                            0b001, 0b010, 0b110};
+static const uint32_t psmActiveUnits[]   = {2, 60, 360};
+static const uint8_t  psmActiveCodes[]   = {0b000, 0b001, 0b010};
+
+void loggerModem::encodePSMTimer(uint32_t seconds, bool periodic,
+                                 char* bits) {
+    const uint32_t* units = periodic ? psmPeriodicUnits : psmActiveUnits;
+    const uint8_t*  codes = periodic ? psmPeriodicCodes : psmActiveCodes;
+    uint8_t         count = periodic ? sizeof(psmPeriodicCodes)
+                                     : sizeof(psmActiveCodes);
+    // Use the longest time if even the coarsest unit can't hold it
+    uint8_t  unit  = count - 1;
+    uint32_t value = 31;
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t steps = (seconds + units[i] - 1) / units[i];
+        if (steps <= 31) {
+            unit  = i;
+            value = steps;
+            break;
+        }
+    }
+    uint8_t timer = codes[unit] << 5 | value;
+    for (uint8_t i = 0; i < 8; i++) {
+        bits[i] = (timer & (0x80 >> i)) ? '1' : '0';
+    }
+    bits[8] = '\0';
+}
+
+
+void loggerModem::setPSMSchedule(uint32_t interval_s, uint32_t activeTime_s) {
+    char tau[9];
+    char active[9];
+    encodePSMTimer(interval_s * MS_MODEM_PSM_TAU_FACTOR, true, tau);
+    encodePSMTimer(activeTime_s, false, active);
+    if (strcmp(tau, _psmTAUBits) == 0 && strcmp(active, _psmActiveBits) == 0) {
+        return;
+    }
+    strcpy(_psmTAUBits, tau);
+    strcpy(_psmActiveBits, active);
+    MS_DBG(F("Power saving timers for a"), interval_s,
+           F("second interval are TAU"), _psmTAUBits, F("and active time"),
+           _psmActiveBits);
+#ifdef MS_MODEM_STAY_REGISTERED
+    _psmPeriodicTAU = _psmTAUBits;
+    _psmActiveTime  = _psmActiveBits;
+    // The new timers are requested at the next connection
+    _powerSaving = false;
+#endif
+}
+#endif
+
+#ifdef MS_MODEM_WARM_STANDBY
+void loggerModem::setWarmStandby(float idle_mA, float attach_mA,
+                                 bool (*lowPowerCheck)(void)) {
+    _idleCurrent_mA   = idle_mA;
+    _attachCurrent_mA = attach_mA;
+    _lowPowerCheck    = lowPowerCheck;
+}
+
+
+bool loggerModem::modemStandby(uint32_t untilNextUse_ms, bool connected) {
+    // The charges in mA*ms of staying idle and of attaching again; the
+    // current once powered down is taken as nothing
+    float idleCharge   = _idleCurrent_mA * untilNextUse_ms;
+    float attachCharge = _attachCurrent_mA * _coldAttach_ms;
+    MS_DBG(F("Staying idle"), untilNextUse_ms, F("ms would take"), idleCharge,
+           F("mA*ms; attaching again"), attachCharge, F("mA*ms"));
+    // A modem that never got online since it was powered isn't kept either
+    if (_coldStart || _coldAttach_ms == 0 || idleCharge >= attachCharge ||
+        (_lowPowerCheck != nullptr && _lowPowerCheck())) {
+        if (connected) {
+            MS_DBG(F("Disconnecting from the Internet..."));
+            disconnectInternet();
+        }
+        return modemSleepPowerDown();
+    }
+
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    _connectState = MODEM_CONNECT_IDLE;
+#endif
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+    _metadataCaptured = false;
+#endif
+    MS_DBG(F("Leaving"), getModemName(), F("online in warm standby."));
+    modemLEDOff();
+    return true;
+}
+
+
+uint32_t loggerModem::getAttachTime(void) {
+    return _coldAttach_ms;
+}
+#endif
+
+#ifdef MS_MODEM_NETWORK_SELECT
+void loggerModem::setRadioAccess(modemRadioAccess radioAccess) {
+    _radioAccess        = radioAccess;
+    _radioAccessPending = true;
+}
+
+
+void loggerModem::setBandLock(const char* bands) {
+    _bandLock           = bands;
+    _radioAccessPending = true;
+}
+
+
+const char* loggerModem::getLastOperator(void) {
+    return _lastOperator;
+}
+
+
+void loggerModem::forgetOperator(void) {
+    _lastOperator[0] = '\0';
+    _lastAccess      = -1;
+}
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool loggerModem::addressFromLine(String line, IPAddress& address) {
+    line.trim();
+    int end = line.lastIndexOf('"');
+    if (end > 0) {
+        int start = line.lastIndexOf('"', end - 1);
+        line      = line.substring(start + 1, end);
+    } else {
+        line = line.substring(line.indexOf(':') + 1);
+        line.trim();
+    }
+    MS_DBG(F("Looked up address"), line);
+    return address.fromString(line);
+}
+#endif
+
 // Perform a hard/panic reset for when the modem is completely unresponsive
 bool loggerModem::modemHardReset(void) {
     if (_modemResetPin >= 0) {
@@ -259,12 +483,76 @@ bool loggerModem::modemHardReset(void) {
         digitalWrite(_modemResetPin, _resetLevel);
         delay(_resetPulse_ms);
         digitalWrite(_modemResetPin, !_resetLevel);
+#ifdef MS_MODEM_STAY_REGISTERED
+        // The modem has to attach again after a reset
+        _powerSaving = false;
+#endif
         return true;
     } else {
         MS_DBG(F("No pin has been provided to reset the modem!"));
         return false;
     }
 }
+
+
+#ifdef MS_MODEM_RECOVERY
+void loggerModem::beginRecovery(void) {
+    _recoveryNext = _recoveryStart;
+    _recoveryLast = MODEM_RECOVERY_NONE;
+}
+
+
+modemRecoveryStep loggerModem::nextRecoveryStep(void) {
+    while (_recoveryNext <= MODEM_RECOVERY_FACTORY_RESET) {
+        modemRecoveryStep step = static_cast<modemRecoveryStep>(
+            _recoveryNext++);
+        if (step == MODEM_RECOVERY_HARD_RESET && _modemResetPin < 0) {
+            continue;
+        }
+        if (step == MODEM_RECOVERY_POWER_CYCLE && _powerPin < 0) { continue; }
+        _recoveryLast = step;
+        _recoveryCounts[step]++;
+        MS_DBG(F("Trying recovery step"), step, F("on"), getModemName());
+        return step;
+    }
+    return MODEM_RECOVERY_NONE;
+}
+
+
+bool loggerModem::runRecoveryStep(modemRecoveryStep step) {
+    if (step == MODEM_RECOVERY_HARD_RESET) { return modemHardReset(); }
+    if (step != MODEM_RECOVERY_POWER_CYCLE) { return false; }
+    MS_DBG(F("Power cycling"), getModemName(), F("for"),
+           MS_MODEM_POWER_CYCLE_MS, F("ms"));
+    modemPowerDown();
+    delay(MS_MODEM_POWER_CYCLE_MS);
+    modemPowerUp();
+    while (millis() - _millisPowerOn < _wakeDelayTime_ms) {
+        // wait
+    }
+    return modemWakeFxn();
+}
+
+
+void loggerModem::endRecovery(bool awake) {
+    if (!awake) {
+        // Nothing worked; start from the power cycle next time so the reset
+        // steps that didn't help aren't repeated first
+        _recoveryCounts[MODEM_RECOVERY_NONE]++;
+        _recoveryStart = MODEM_RECOVERY_POWER_CYCLE;
+        _cleanWakes    = 0;
+    } else if (_recoveryLast != MODEM_RECOVERY_NONE) {
+        // Start at the step that worked the next time
+        _recoveryStart = _recoveryLast;
+        _cleanWakes    = 0;
+    } else if (++_cleanWakes >= MS_MODEM_RECOVERY_DECAY) {
+        if (_recoveryStart > MODEM_RECOVERY_SOFT_RESET) { _recoveryStart--; }
+        _cleanWakes = 0;
+    }
+}
+#endif
+
+
 void loggerModem::setModemStatusLevel(bool level) {
     _statusLevel = level;
 }
@@ -326,6 +614,14 @@ void loggerModem::setMetadataPolling(uint8_t pollingBitmask) {
 bool loggerModem::updateModemMetadata(void) {
     bool success = true;
 
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+    if (_metadataCaptured) {
+        MS_DBG(F("Using the modem metadata read while connecting"));
+        _metadataCaptured = false;
+        return true;
+    }
+#endif
+
     // Unset whatever we had previously
     loggerModem::_priorRSSI           = -9999;
     loggerModem::_priorSignalPercent  = -9999;
@@ -403,6 +699,36 @@ bool loggerModem::updateModemMetadata(void) {
     return success;
 }
 
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+void loggerModem::setModemBaud(HardwareSerial* modemSerial,
+                               uint32_t defaultBaud, uint32_t targetBaud) {
+    _baudSerial       = modemSerial;
+    _defaultBaud      = defaultBaud;
+    _targetBaud       = targetBaud;
+    _currentBaud      = defaultBaud;
+    _targetBaudFailed = false;
+}
+
+bool loggerModem::resetModemBaud(void) {
+    if (_baudSerial == nullptr || _currentBaud == _defaultBaud) {
+        return false;
+    }
+    MS_DBG(F("Putting the modem serial port back to"), _defaultBaud, F("baud"));
+    _baudSerial->end();
+    _baudSerial->begin(_defaultBaud);
+    _currentBaud = _defaultBaud;
+    return true;
+}
+#endif
+
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+void loggerModem::captureModemMetadata(void) {
+    MS_DBG(F("Reading the modem metadata while connecting"));
+    _metadataCaptured = false;
+    _metadataCaptured = updateModemMetadata();
+}
+#endif
+
 float loggerModem::getModemRSSI() {
     float retVal = loggerModem::_priorRSSI;
     MS_DEEP_DBG(F("PRIOR RSSI:"), retVal);
@@ -434,6 +760,43 @@ float loggerModem::getModemTemperature() {
     return retVal;
 }
 
+#ifdef MS_MODEM_STATS
+const modemStats& loggerModem::getModemStats(void) {
+    return _stats;
+}
+void loggerModem::resetModemStats(void) {
+    _stats = {};
+}
+void loggerModem::recordSocketOpen(void) {
+    _stats.socketOpens++;
+}
+void loggerModem::recordTraffic(uint32_t bytesSent, uint32_t bytesReceived) {
+    _stats.bytesSent += bytesSent;
+    _stats.bytesReceived += bytesReceived;
+}
+void loggerModem::recordPublish(uint32_t publish_ms) {
+    _stats.publish_ms = publish_ms;
+}
+float loggerModem::getModemRegistrationTime() {
+    return _stats.registration_ms / 1000.0f;
+}
+float loggerModem::getModemConnectTime() {
+    return _stats.connect_ms / 1000.0f;
+}
+float loggerModem::getModemPublishTime() {
+    return _stats.publish_ms / 1000.0f;
+}
+float loggerModem::getModemConnectAttempts() {
+    return _stats.connectAttempts;
+}
+float loggerModem::getModemBytesSent() {
+    return _stats.bytesSent;
+}
+float loggerModem::getModemBytesReceived() {
+    return _stats.bytesReceived;
+}
+#endif
+
 // Helper to get approximate RSSI from CSQ (assuming no noise)
 int16_t loggerModem::getRSSIFromCSQ(int16_t csq) {
     if ((csq < 0) || (csq > 31)) return 0;
@@ -482,3 +845,29 @@ uint32_t loggerModem::parseNISTBytes(byte nistBytes[4]) {
         return unixTimeStamp;
     }
 }
+
+#ifdef MS_MODEM_NETWORK_TIME
+uint32_t loggerModem::parseModemClock(int year, int month, int day, int hour,
+                                      int minute, int second, float timezone) {
+    MS_DBG(F("Modem clock:"), year, '/', month, '/', day, hour, ':', minute,
+           ':', second, F("UTC"), timezone);
+    if (year < 2019 || year >= 2030 || month < 1 || month > 12 || day < 1 ||
+        day > 31) {
+        MS_DBG(F("The modem clock hasn't been set by the network"));
+        return 0;
+    }
+
+    // Count the days since Jan 1, 1970, treating March as the start of the
+    // year so the leap day falls at the end
+    if (month <= 2) {
+        year--;
+        month += 12;
+    }
+    int32_t days = 365L * year + year / 4 - year / 100 + year / 400 +
+        (153 * (month - 3) + 2) / 5 + day - 719469L;
+    int32_t unixTimeStamp = days * 86400L + hour * 3600L + minute * 60L +
+        second - static_cast<int32_t>(timezone * 3600);
+    MS_DBG(F("Unix Timestamp from the modem clock (UTC):"), unixTimeStamp);
+    return unixTimeStamp;
+}
+#endif
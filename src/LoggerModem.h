@@ -31,11 +31,281 @@
 #define MS_DEBUGGING_STD "LoggerModem"
 #endif
 
+/**
+ * @def MS_MODEM_STAY_REGISTERED
+ * @brief Let LTE-M and NB-IoT modems stay registered to the network in power
+ * saving mode (PSM) between connections instead of being powered down.
+ *
+ * This is supported by the SIMComSIM7080, SIMComSIM7000, and QuectelBG96 and
+ * must still be turned on with loggerModem::setStayRegistered().
+ */
+// #define MS_MODEM_STAY_REGISTERED
+
+/**
+ * @def MS_MODEM_PSM_SCHEDULE
+ * @brief Work out the power saving mode (PSM) timers requested with
+ * `AT+CPSMS` from the logger's publish interval instead of using fixed ones.
+ *
+ * The logger gives the modem the time between its publishes with
+ * loggerModem::setPSMSchedule() when it begins and again before each wake.
+ * The periodic tracking area update timer (T3412) is asked for at
+ * #MS_MODEM_PSM_TAU_FACTOR times that, so the modem is back online to publish
+ * before it has to wake just to update the network, and the active timer
+ * (T3324) is #MS_MODEM_PSM_ACTIVE_S.  These replace the timers given to
+ * loggerModem::setStayRegistered() and the fixed timers of the
+ * SequansMonarch.
+ */
+// #define MS_MODEM_PSM_SCHEDULE
+
+#ifdef MS_MODEM_PSM_SCHEDULE
+#ifndef MS_MODEM_PSM_TAU_FACTOR
+/**
+ * @brief The periodic tracking area update timer asked for, as a multiple of
+ * the publish interval (#MS_MODEM_PSM_SCHEDULE).
+ *
+ * With 2, one publish can be held or missed without an extra update.
+ */
+#define MS_MODEM_PSM_TAU_FACTOR 2
+#endif
+#ifndef MS_MODEM_PSM_ACTIVE_S
+/**
+ * @brief The active timer asked for, in seconds (#MS_MODEM_PSM_SCHEDULE).
+ *
+ * This is how long the modem listens after a connection before it goes into
+ * PSM; the logger doesn't expect anything from the network then.
+ */
+#define MS_MODEM_PSM_ACTIVE_S 10
+#endif
+#endif
+
+/**
+ * @def MS_MODEM_RELEASE_ASSIST
+ * @brief Tell the network that no more data is coming before disconnecting,
+ * so an LTE-M or NB-IoT modem releases its radio connection right away
+ * instead of staying connected for the network's inactivity timer.
+ *
+ * loggerModem::disconnectInternet() first sends the 3GPP release assistance
+ * command for "no more packet data" (`AT+CNMPSD`), after the last publisher
+ * has its response.  This is done by the SIMComSIM7080, SIMComSIM7000, and
+ * QuectelBG96; a network or firmware that doesn't take it answers with an
+ * error and the modem waits out the timer as before.  It's sent whether or not
+ * the modem stays registered (#MS_MODEM_STAY_REGISTERED), where it also lets
+ * the modem go into power saving mode sooner.
+ */
+// #define MS_MODEM_RELEASE_ASSIST
+
+/**
+ * @def MS_MODEM_NONBLOCKING_CONNECT
+ * @brief Add loggerModem::beginConnect() and loggerModem::pollConnect() to
+ * connect to the internet a step at a time instead of blocking in
+ * loggerModem::connectInternet().
+ */
+// #define MS_MODEM_NONBLOCKING_CONNECT
+#ifdef MS_LOGGER_OVERLAP_MODEM
+#ifndef MS_MODEM_NONBLOCKING_CONNECT
+#define MS_MODEM_NONBLOCKING_CONNECT
+#endif
+#endif
+
+/**
+ * @def MS_MODEM_NETWORK_TIME
+ * @brief Have loggerModem::getNISTTime() take the time from the modem's own
+ * clock before contacting NIST.
+ *
+ * The modem's clock is set by the network (NITZ) when the modem registers.  If
+ * it hasn't been set, modems with SNTP (SIMCom) sync it with an NTP server
+ * over UDP, and only if that also fails is NIST contacted over TCP.
+ */
+// #define MS_MODEM_NETWORK_TIME
+
+/**
+ * @def MS_MODEM_PIGGYBACK_METADATA
+ * @brief Read the modem metadata as soon as the modem registers, while
+ * connecting, instead of after publishing.
+ *
+ * The signal quality read right after registration is already valid, so
+ * there's no waiting for the modem to report a signal, and
+ * loggerModem::updateModemMetadata() then only hands back what was read
+ * without talking to the modem again.
+ */
+// #define MS_MODEM_PIGGYBACK_METADATA
+
+/**
+ * @def MS_MODEM_BAUD_NEGOTIATION
+ * @brief Add loggerModem::setModemBaud() to move the modem's serial port to a
+ * faster baud rate each time it wakes.
+ *
+ * This is supported by the SIMCom, Quectel, Sequans, u-blox, and Espressif
+ * modems, which don't save the rate; the XBee saves its rate, so it isn't
+ * changed.
+ */
+// #define MS_MODEM_BAUD_NEGOTIATION
+
+/**
+ * @def MS_MODEM_NATIVE_HTTP
+ * @brief Let the EnviroDIY and Ubidots publishers post through the modem's
+ * own HTTP client instead of a TCP socket.
+ *
+ * This is supported by the SIMComSIM7080 (`AT+SH*`) and QuectelBG96
+ * (`AT+QHTTP*`).  The whole body is handed to the modem in one upload and the
+ * status code comes back in a single response, instead of each write going
+ * through TinyGSM's socket commands.  With any other modem the publishers use
+ * their client as usual.
+ */
+// #define MS_MODEM_NATIVE_HTTP
+
+/**
+ * @def MS_MODEM_SECURE_CLIENT
+ * @brief Add a TinyGSM secure (TLS) client, `gsmClientSecure`, to the modems
+ * whose TinyGSM driver supports one.
+ *
+ * This is the SIMComSIM7080, the SIMComSIM7000 (using the TinyGSM SIM7000SSL
+ * driver), QuectelBG96 where TinyGSM supports it, and the EspressifESP8266
+ * (and ESP32 AT firmware).  The secure client uses socket 1, leaving socket 0
+ * to the plain client.
+ *
+ * @note None of these modems hand a TLS session ticket or ID back to the
+ * MCU, so a session can't be resumed after the modem powers down.  To skip
+ * the handshake on later sends, keep the connection open with
+ * #MS_PUBLISHER_KEEP_ALIVE.
+ */
+// #define MS_MODEM_SECURE_CLIENT
+
+/**
+ * @def MS_MODEM_WIFI_FAST_CONNECT
+ * @brief Have the WiFi modems rejoin the last access point directly instead
+ * of scanning and waiting for DHCP on each connection.
+ *
+ * The EspressifESP8266 (and ESP32) remembers the access point's BSSID and the
+ * address, gateway, netmask, and DNS server from the last connection, and
+ * joins that access point with that static address; the DigiXBeeWifi keeps
+ * its DHCP address as a static address in its flash.  If the fast join fails,
+ * the modems go back to DHCP and the usual join.
+ *
+ * @note The address from the last DHCP lease is reused, so the router should
+ * reserve it for the modem.
+ */
+// #define MS_MODEM_WIFI_FAST_CONNECT
+
+/**
+ * @def MS_MODEM_STATS
+ * @brief Keep counts and times of the modem's connections and of the traffic
+ * of the publishers, to find which part of publishing is slow.
+ *
+ * The connectInternet() and pollConnect() functions made by
+ * LoggerModemMacros.h record the time to register and to get online, and the
+ * publishers record the sockets they open, the bytes they send and read back,
+ * and how long each publish takes.  They're returned by
+ * loggerModem::getModemStats() and can be logged with the modem statistics
+ * variables, like #Modem_ConnectTime.
+ */
+// #define MS_MODEM_STATS
+
+/**
+ * @def MS_MODEM_WARM_STANDBY
+ * @brief Leave the modem powered and online between closely spaced
+ * publishes when that takes less charge than powering it down and attaching
+ * again.
+ *
+ * The time from powering the modem up to getting online is measured on each
+ * cold attach.  Logger::logDataAndPublish() then calls
+ * loggerModem::modemStandby() with the time until the next publish instead of
+ * disconnectInternet() and modemSleepPowerDown().  That compares the idle
+ * current over that time to the attach current over the measured attach time,
+ * as given to loggerModem::setWarmStandby().  A modem kept in standby isn't
+ * disconnected either, so a WiFi modem doesn't have to join its access point
+ * again.  The modem is always disconnected and powered down on a long gap,
+ * before an attach has been measured, or when the low power check says so.
+ */
+// #define MS_MODEM_WARM_STANDBY
+
+/**
+ * @def MS_MODEM_NETWORK_SELECT
+ * @brief Let the LTE-M/NB-IoT modems be locked to a radio access technology
+ * and a set of bands, and have them try the last operator they registered on
+ * before scanning.
+ *
+ * The radio access technology and band lock given to
+ * loggerModem::setRadioAccess() and loggerModem::setBandLock() are sent once
+ * after they're set; the modems keep them in their own non-volatile memory.
+ * After each registration, the operator and access technology are read with
+ * `AT+COPS?`, and on the next cold attach they're requested with
+ * `AT+COPS=4`, which falls back to the full automatic search if that
+ * operator can't be found.
+ *
+ * This is implemented for the SIMComSIM7080, SIMComSIM7000, QuectelBG96, and
+ * SodaqUBeeR410M.
+ *
+ * @note The last operator is kept in RAM, so it's lost on a reset of the
+ * logger but not when the modem is powered down.  Asking for it blocks, even
+ * in loggerModem::pollConnect(), for up to #MS_MODEM_OPERATOR_TIMEOUT_MS.
+ */
+// #define MS_MODEM_NETWORK_SELECT
+
+/**
+ * @def MS_MODEM_RECOVERY
+ * @brief Recover a modem that doesn't answer AT commands when it's woken with
+ * a ladder of steps that gets stronger each time, instead of only
+ * loggerModem::modemHardReset().
+ *
+ * The steps are a soft restart with AT commands, a hard reset on the reset
+ * pin, a power cycle on the power pin, and restoring the factory settings,
+ * after which the modem is set up again; the steps the pins can't do are
+ * skipped.  The modem remembers which step brought it back, so on its next
+ * failure it starts there instead of repeating the slower steps that didn't
+ * work.  Once it has woken #MS_MODEM_RECOVERY_DECAY times in a row without
+ * help, it starts one step lower again.  The counts are returned by
+ * loggerModem::getRecoveryCount().
+ *
+ * @note The state is kept in RAM, so it lasts across the modem's sleeps and
+ * power downs but not a reset of the logger.
+ */
+// #define MS_MODEM_RECOVERY
+
+#ifdef MS_MODEM_RECOVERY
+#ifndef MS_MODEM_RECOVERY_DECAY
+/**
+ * @brief The number of wakes in a row without recovery before the ladder
+ * starts one step lower (#MS_MODEM_RECOVERY).
+ */
+#define MS_MODEM_RECOVERY_DECAY 4
+#endif
+#ifndef MS_MODEM_POWER_CYCLE_MS
+/**
+ * @brief The time in milliseconds the power of the modem is off for in a
+ * power cycle (#MS_MODEM_RECOVERY).
+ */
+#define MS_MODEM_POWER_CYCLE_MS 2000L
+#endif
+#endif
+
+#ifdef MS_MODEM_NETWORK_SELECT
+#ifndef MS_MODEM_OPERATOR_TIMEOUT_MS
+/**
+ * @brief The longest time in milliseconds to wait for the modem to register
+ * on the last operator before going on with the usual registration wait.
+ */
+#define MS_MODEM_OPERATOR_TIMEOUT_MS 30000L
+#endif
+#endif
+
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+/**
+ * @brief The minimum time in milliseconds between the registration checks in
+ * loggerModem::pollConnect(), so a tight polling loop doesn't flood the modem
+ * with AT commands.
+ */
+#define MS_MODEM_CONNECT_POLL_MS 500L
+#endif
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "VariableBase.h"
 #include <Arduino.h>
+#ifdef MS_PUBLISHER_DNS_CACHE
+#include <IPAddress.h>
+#endif
 
 
 /**
@@ -75,10 +345,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "RSSI"
-#define MODEM_RSSI_VAR_NAME "RSSI"
+#define MODEM_RSSI_VAR_NAME MS_VAR_TEXT("RSSI")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "RSSI"
-#define MODEM_RSSI_UNIT_NAME "RSSI"
+#define MODEM_RSSI_UNIT_NAME MS_VAR_TEXT("RSSI")
 /// @brief Default variable short code; "decibelMiliWatt"
 #define MODEM_RSSI_DEFAULT_CODE "decibelMiliWatt"
 /**@}*/
@@ -104,10 +374,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "signalPercent"
-#define MODEM_PERCENT_SIGNAL_VAR_NAME "signalPercent"
+#define MODEM_PERCENT_SIGNAL_VAR_NAME MS_VAR_TEXT("signalPercent")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
-#define MODEM_PERCENT_SIGNAL_UNIT_NAME "percent"
+#define MODEM_PERCENT_SIGNAL_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "signalPercent"
 #define MODEM_PERCENT_SIGNAL_DEFAULT_CODE "signalPercent"
 /**@}*/
@@ -137,11 +407,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "batteryChargeState"
-#define MODEM_BATTERY_STATE_VAR_NAME "batteryChargeState"
+#define MODEM_BATTERY_STATE_VAR_NAME MS_VAR_TEXT("batteryChargeState")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "number"
 /// (dimensionless)
-#define MODEM_BATTERY_STATE_UNIT_NAME "number"
+#define MODEM_BATTERY_STATE_UNIT_NAME MS_VAR_TEXT("number")
 /// @brief Default variable short code; "modemBatteryCS"
 #define MODEM_BATTERY_STATE_DEFAULT_CODE "modemBatteryCS"
 /**@}*/
@@ -167,10 +437,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "batteryVoltage"
-#define MODEM_BATTERY_PERCENT_VAR_NAME "batteryVoltage"
+#define MODEM_BATTERY_PERCENT_VAR_NAME MS_VAR_TEXT("batteryVoltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
-#define MODEM_BATTERY_PERCENT_UNIT_NAME "percent"
+#define MODEM_BATTERY_PERCENT_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "modemBatteryPct"
 #define MODEM_BATTERY_PERCENT_DEFAULT_CODE "modemBatteryPct"
 /**@}*/
@@ -200,10 +470,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "batteryVoltage"
-#define MODEM_BATTERY_VOLTAGE_VAR_NAME "batteryVoltage"
+#define MODEM_BATTERY_VOLTAGE_VAR_NAME MS_VAR_TEXT("batteryVoltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millivolt"
-#define MODEM_BATTERY_VOLTAGE_UNIT_NAME "millivolt"
+#define MODEM_BATTERY_VOLTAGE_UNIT_NAME MS_VAR_TEXT("millivolt")
 /// @brief Default variable short code; "modemBatterymV"
 #define MODEM_BATTERY_VOLTAGE_DEFAULT_CODE "modemBatterymV"
 /**@}*/
@@ -232,11 +502,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define MODEM_TEMPERATURE_VAR_NAME "temperature"
+#define MODEM_TEMPERATURE_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define MODEM_TEMPERATURE_UNIT_NAME "degreeCelsius"
+#define MODEM_TEMPERATURE_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "modemTemp"
 #define MODEM_TEMPERATURE_DEFAULT_CODE "modemTemp"
 /**@}*/
@@ -261,10 +531,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "timeElapsed"
-#define MODEM_ACTIVATION_VAR_NAME "timeElapsed"
+#define MODEM_ACTIVATION_VAR_NAME MS_VAR_TEXT("timeElapsed")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "second"
-#define MODEM_ACTIVATION_UNIT_NAME "second"
+#define MODEM_ACTIVATION_UNIT_NAME MS_VAR_TEXT("second")
 /// @brief Default variable short code; "modemActiveSec"
 #define MODEM_ACTIVATION_DEFAULT_CODE "modemActiveSec"
 /**@}*/
@@ -288,17 +558,136 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "timeElapsed"
-#define MODEM_POWERED_VAR_NAME "timeElapsed"
+#define MODEM_POWERED_VAR_NAME MS_VAR_TEXT("timeElapsed")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "second"
-#define MODEM_POWERED_UNIT_NAME "second"
+#define MODEM_POWERED_UNIT_NAME MS_VAR_TEXT("second")
 /// @brief Default variable short code; "modemPoweredSec"
 #define MODEM_POWERED_DEFAULT_CODE "modemPoweredSec"
 /**@}*/
 #endif
+
+#ifdef MS_MODEM_STATS
+/**
+ * @anchor modem_stats
+ * @name Modem Statistics
+ * The connection and traffic statistics of a modem-like device
+ * (#MS_MODEM_STATS).
+ *
+ * {{ @ref Modem_RegistrationTime::Modem_RegistrationTime }}
+ * {{ @ref Modem_ConnectTime::Modem_ConnectTime }}
+ * {{ @ref Modem_PublishTime::Modem_PublishTime }}
+ * {{ @ref Modem_ConnectAttempts::Modem_ConnectAttempts }}
+ * {{ @ref Modem_BytesSent::Modem_BytesSent }}
+ * {{ @ref Modem_BytesReceived::Modem_BytesReceived }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; the times should have 3.
+#define MODEM_STATS_TIME_RESOLUTION 3
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "timeElapsed"
+#define MODEM_STATS_TIME_VAR_NAME MS_VAR_TEXT("timeElapsed")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "second"
+#define MODEM_STATS_TIME_UNIT_NAME MS_VAR_TEXT("second")
+/// @brief Decimals places in string representation; the counts should have 0.
+#define MODEM_STATS_COUNT_RESOLUTION 0
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "counter"
+#define MODEM_STATS_COUNT_VAR_NAME MS_VAR_TEXT("counter")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "count"
+#define MODEM_STATS_COUNT_UNIT_NAME MS_VAR_TEXT("count")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "byte"
+#define MODEM_STATS_BYTES_UNIT_NAME MS_VAR_TEXT("byte")
+/// @brief Default variable short code; "modemRegisterSec"
+#define MODEM_REGISTRATION_DEFAULT_CODE "modemRegisterSec"
+/// @brief Default variable short code; "modemConnectSec"
+#define MODEM_CONNECT_DEFAULT_CODE "modemConnectSec"
+/// @brief Default variable short code; "modemPublishSec"
+#define MODEM_PUBLISH_DEFAULT_CODE "modemPublishSec"
+/// @brief Default variable short code; "modemConnects"
+#define MODEM_CONNECT_ATTEMPTS_DEFAULT_CODE "modemConnects"
+/// @brief Default variable short code; "modemBytesSent"
+#define MODEM_BYTES_SENT_DEFAULT_CODE "modemBytesSent"
+/// @brief Default variable short code; "modemBytesRcvd"
+#define MODEM_BYTES_RECEIVED_DEFAULT_CODE "modemBytesRcvd"
+/**@}*/
+#endif
 /**@}*/
 
 
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+/**
+ * @brief The steps of a non-blocking internet connection, as returned by
+ * loggerModem::pollConnect().
+ */
+typedef enum {
+    /// No connection has been started
+    MODEM_CONNECT_IDLE = 0,
+    /// Waiting for the modem to warm up so it can be woken
+    MODEM_CONNECT_WAKING,
+    /// Waiting for network registration, or for a WiFi modem to reconnect on
+    /// its own
+    MODEM_CONNECT_REGISTERING,
+    /// Waiting for a WiFi modem to connect after sending the credentials
+    MODEM_CONNECT_ATTACHING,
+    /// Connected to the internet
+    MODEM_CONNECT_CONNECTED,
+    /// The modem didn't wake or didn't connect in time
+    MODEM_CONNECT_FAILED
+} modemConnectState;
+#endif
+
+#ifdef MS_MODEM_RECOVERY
+/**
+ * @brief The steps of the ladder that recovers a modem that doesn't answer
+ * (#MS_MODEM_RECOVERY).
+ */
+typedef enum modemRecoveryStep : uint8_t {
+    MODEM_RECOVERY_NONE = 0,       ///< No step; the ladder is used up
+    MODEM_RECOVERY_SOFT_RESET,     ///< Restart with AT commands
+    MODEM_RECOVERY_HARD_RESET,     ///< Pulse the reset pin
+    MODEM_RECOVERY_POWER_CYCLE,    ///< Turn the power pin off and on
+    MODEM_RECOVERY_FACTORY_RESET,  ///< Restore the factory settings
+} modemRecoveryStep;
+#endif
+
+#ifdef MS_MODEM_NETWORK_SELECT
+/**
+ * @brief The radio access technologies a modem can be locked to
+ * (#MS_MODEM_NETWORK_SELECT).
+ */
+typedef enum modemRadioAccess : uint8_t {
+    RADIO_ACCESS_AUTO = 0,  ///< Leave the choice to the modem
+    RADIO_ACCESS_LTE_M,     ///< Only LTE Cat-M1
+    RADIO_ACCESS_NB_IOT,    ///< Only NB-IoT
+} modemRadioAccess;
+#endif
+
+#ifdef MS_MODEM_STATS
+/**
+ * @brief The connection and traffic statistics of the modem
+ * (#MS_MODEM_STATS).
+ *
+ * The counts are since the logger started or resetModemStats() was called;
+ * the times are those of the last connection or publish.
+ */
+typedef struct modemStats {
+    uint16_t connectAttempts;  ///< The connections started
+    uint16_t connects;         ///< The connections that got online
+    uint16_t socketOpens;      ///< The sockets opened by the publishers
+    uint32_t bytesSent;        ///< The bytes the publishers sent
+    uint32_t bytesReceived;    ///< The bytes of the responses read back
+    uint32_t registration_ms;  ///< The time from starting to registering
+    uint32_t connect_ms;       ///< The time from starting to being online
+    uint32_t publish_ms;       ///< The time taken to send to every publisher
+} modemStats;
+#endif
+
 /* ===========================================================================
  * Functions for the modem class
  * This is basically a wrapper for TinyGsm with power control added
@@ -461,6 +850,149 @@ class loggerModem {
      * state _and_ then powered off
      */
     virtual bool modemSleepPowerDown(void);
+#ifdef MS_MODEM_STAY_REGISTERED
+    /**
+     * @brief Ask the modem to stay registered to the network in power saving
+     * mode (PSM) between connections instead of powering it down.
+     *
+     * The timers are requested from the network the next time the modem
+     * connects.  Once the modem has accepted them, disconnectInternet() leaves
+     * the PDP context open, modemSleepPowerDown() leaves the modem powered to
+     * drop into PSM on its own when its active timer runs out, and the next
+     * connection skips the network attach if the context is still open.  The
+     * modem is woken from PSM by a pulse on its `PWRKEY`.
+     *
+     * This is only honored by modems that implement requestPowerSaving(); all
+     * others are still powered down.
+     *
+     * @param stayRegistered True to stay registered between connections.
+     * @param periodicTAU The requested periodic tracking area update timer
+     * (T3412) as the 8 bit string used by `AT+CPSMS`; default 1 hour.
+     * @param activeTime The requested active timer (T3324) as the 8 bit
+     * string used by `AT+CPSMS`; default 10 seconds.
+     * @param eDRXCycle The requested eDRX cycle as the 4 bit string used by
+     * `AT+CEDRXS`, or null to not request eDRX.
+     */
+    void setStayRegistered(bool        stayRegistered,
+                           const char* periodicTAU = "00100001",
+                           const char* activeTime  = "00000101",
+                           const char* eDRXCycle   = nullptr);
+#endif
+#ifdef MS_MODEM_PSM_SCHEDULE
+    /**
+     * @brief Work out the power saving mode timers from the time between
+     * connections (#MS_MODEM_PSM_SCHEDULE).
+     *
+     * The timers are requested again at the next connection only if they
+     * changed.
+     *
+     * @param interval_s The time between connections, in seconds
+     * @param activeTime_s The active timer (T3324) to ask for, in seconds;
+     * optional with a default of #MS_MODEM_PSM_ACTIVE_S.
+     */
+    void setPSMSchedule(uint32_t interval_s,
+                        uint32_t activeTime_s = MS_MODEM_PSM_ACTIVE_S);
+    /**
+     * @brief Encode a power saving mode timer as the 8 bit string used by
+     * `AT+CPSMS`: three bits of unit and five of value.
+     *
+     * The finest unit that can hold the time is used, rounding up.
+     *
+     * @param seconds The time, in seconds
+     * @param periodic True for the periodic tracking area update timer
+     * (T3412); false for the active timer (T3324)
+     * @param bits The buffer for the string; 9 characters
+     */
+    static void encodePSMTimer(uint32_t seconds, bool periodic, char* bits);
+#endif
+#ifdef MS_MODEM_WARM_STANDBY
+    /**
+     * @brief Set the currents compared to pick between leaving the modem in
+     * warm standby and powering it down (#MS_MODEM_WARM_STANDBY).
+     *
+     * @param idle_mA The current of the modem while it's registered and idle,
+     * in mA
+     * @param attach_mA The average current of the modem while it boots,
+     * registers, and attaches, in mA
+     * @param lowPowerCheck A function returning true when the modem should
+     * always be powered down, ie, for a low battery; optional.
+     */
+    void setWarmStandby(float idle_mA, float attach_mA,
+                        bool (*lowPowerCheck)(void) = nullptr);
+    /**
+     * @brief Leave the modem powered and online until its next use if
+     * that's cheaper than attaching again; otherwise disconnect it from the
+     * internet and run modemSleepPowerDown().
+     *
+     * A WiFi modem would have to join its access point again after
+     * disconnectInternet(), so a modem kept in standby isn't disconnected.
+     *
+     * @param untilNextUse_ms The time until the modem is needed again, in ms
+     * @param connected True if the modem is connected to the internet and
+     * should be disconnected before it's powered down
+     * @return **bool** True if the modem was left in standby or was
+     * successfully powered down.
+     */
+    bool modemStandby(uint32_t untilNextUse_ms, bool connected);
+    /**
+     * @brief Get the time taken by the last cold attach, from powering the
+     * modem up to getting online.
+     *
+     * @return **uint32_t** The attach time in ms, or 0 if none has been
+     * measured.
+     */
+    uint32_t getAttachTime(void);
+#endif
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @brief Lock the modem to a radio access technology
+     * (#MS_MODEM_NETWORK_SELECT).
+     *
+     * @param radioAccess The modemRadioAccess to use
+     */
+    void setRadioAccess(modemRadioAccess radioAccess);
+    /**
+     * @brief Lock the modem to a set of bands (#MS_MODEM_NETWORK_SELECT).
+     *
+     * The bands are given as the modem's own arguments to its band command;
+     * see the documentation of each modem.
+     *
+     * @param bands The bands to use, or null to leave the bands alone
+     */
+    void setBandLock(const char* bands);
+    /**
+     * @brief Get the operator the modem last registered on.
+     *
+     * @return **const char\*** The numeric operator code, ie, "310410", or an
+     * empty string if none is known.
+     */
+    const char* getLastOperator(void);
+    /**
+     * @brief Forget the last operator, so the next attach uses the full
+     * search.
+     */
+    void forgetOperator(void);
+#endif
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    /**
+     * @brief Ask the modem to talk at a faster baud rate once it's awake.
+     *
+     * Each time the modem wakes the faster rate is requested and checked with
+     * an AT command; if the modem doesn't answer at the faster rate, the port
+     * goes back to the default rate and the faster rate isn't tried again.
+     * The rate the port is at is kept while the modem sleeps, and the port is
+     * put back to the default rate when the modem loses power or stops
+     * answering.
+     *
+     * @param modemSerial The hardware serial port the modem is on, already
+     * begun at the default rate.
+     * @param defaultBaud The rate the modem starts at after power up.
+     * @param targetBaud The faster rate to use, ie, 460800 or 921600 on a SAMD
+     * board.
+     */
+    void setModemBaud(HardwareSerial* modemSerial, uint32_t defaultBaud,
+                      uint32_t targetBaud);
+#endif
     /**@}*/
 
     /**
@@ -475,6 +1007,28 @@ class loggerModem {
      * possible with the current pin/modem configuration.
      */
     virtual bool modemHardReset(void);
+#ifdef MS_MODEM_RECOVERY
+    /**
+     * @brief Get the step the recovery ladder starts at on the next failure
+     * (#MS_MODEM_RECOVERY).
+     *
+     * @return **modemRecoveryStep** The first step to try.
+     */
+    modemRecoveryStep getRecoveryLevel(void) {
+        return static_cast<modemRecoveryStep>(_recoveryStart);
+    }
+    /**
+     * @brief Get the number of times a step of the recovery ladder has been
+     * tried, or with #MODEM_RECOVERY_NONE the number of wakes the whole
+     * ladder failed on (#MS_MODEM_RECOVERY).
+     *
+     * @param step The modemRecoveryStep
+     * @return **uint16_t** The count since the logger started.
+     */
+    uint16_t getRecoveryCount(modemRecoveryStep step) {
+        return _recoveryCounts[step];
+    }
+#endif
 
 
     /**
@@ -544,6 +1098,45 @@ class loggerModem {
      * the cellular network.
      */
     virtual void disconnectInternet(void) = 0;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    /**
+     * @brief Start connecting to the internet without waiting for the
+     * connection; follow this with calls to pollConnect().
+     *
+     * This only powers the modem, if it isn't already, so the logger can go on
+     * to measure sensors or write to the SD card while it warms up.
+     *
+     * @param maxConnectionTime The maximum length of time in milliseconds from
+     * now for the modem to wake and connect.  Defaults to 50,000ms (50s).
+     */
+    void beginConnect(uint32_t maxConnectionTime = 50000L);
+    /**
+     * @brief Take the next step of a connection started with beginConnect().
+     *
+     * Each call returns as soon as the current step can't go any further, so
+     * this should be called repeatedly until it returns
+     * #MODEM_CONNECT_CONNECTED or #MODEM_CONNECT_FAILED.  Waking the modem and
+     * (for cellular modems) starting the data connection are still done in one
+     * call each, but they take a few seconds rather than the tens of seconds
+     * of network registration.
+     *
+     * For most modules, this function is created by the
+     * #MS_MODEM_POLL_CONNECT macro; any other module connects all at once
+     * with connectInternet() on its first call.
+     *
+     * @return **modemConnectState** The step the connection is on.
+     */
+    virtual modemConnectState pollConnect(void);
+    /**
+     * @brief Check if the connection started with beginConnect() succeeded.
+     *
+     * @return **bool** True if the last call to pollConnect() found the
+     * modem connected.
+     */
+    bool isConnected(void) {
+        return _connectState == MODEM_CONNECT_CONNECTED;
+    }
+#endif
 
 
     /**
@@ -552,6 +1145,10 @@ class loggerModem {
      * This would be much more efficient if done over UDP, but I'm doing it over
      * TCP because I don't have a UDP library for all the modems.
      *
+     * With #MS_MODEM_NETWORK_TIME the modem's network clock and then its SNTP
+     * client are tried first, and NIST is only contacted if neither gives a
+     * believable time.
+     *
      * @note The return is the number of seconds since Jan 1, 1970 IN UTC
      *
      * @return **uint32_t** The number of seconds since Jan 1, 1970 IN UTC
@@ -559,6 +1156,100 @@ class loggerModem {
     virtual uint32_t getNISTTime(void) = 0;
     /**@}*/
 
+#ifdef MS_PUBLISHER_DNS_CACHE
+    /**
+     * @brief Look up the address of a host with the modem's own DNS client,
+     * for the publishers' DNS cache (#MS_PUBLISHER_DNS_CACHE).
+     *
+     * @param host The host name to look up
+     * @param address The address of the host
+     * @return **bool** True if the modem can look up hosts and found this
+     * one; false to connect by name instead.
+     */
+    virtual bool resolveHost(const char* host, IPAddress& address) {
+        (void)host;
+        (void)address;
+        return false;
+    }
+    /**
+     * @brief Check if a client is one of the modem's secure (TLS) clients
+     * (#MS_MODEM_SECURE_CLIENT), which must be connected by the host name so
+     * the name can be sent and checked in the handshake.
+     *
+     * @param client The client to check
+     * @return **bool** True if the client is the modem's secure client.
+     */
+    virtual bool isSecureClient(Client* client) {
+        (void)client;
+        return false;
+    }
+#endif
+#ifdef MS_MODEM_NATIVE_HTTP
+    /**
+     * @anchor modem_http_functions
+     * @name Posting through the modem's HTTP client
+     * Functions for modems with their own HTTP client
+     * (#MS_MODEM_NATIVE_HTTP).
+     *
+     * A post is made by calling httpBegin(), httpAddHeader() for each header,
+     * httpStartBody() and writing exactly the body length to the returned
+     * stream, and then httpFinish().
+     */
+    /**@{*/
+    /**
+     * @brief Start an HTTP post with the modem's own HTTP client.
+     *
+     * @param host The host name to post to
+     * @param port The port to post to
+     * @param path The path to post to
+     * @param bodyLength The exact length of the body that will be written
+     * @return **bool** True if the modem has an HTTP client and the post was
+     * started; false to post over a client instead.
+     */
+    virtual bool httpBegin(const char* host, uint16_t port, const char* path,
+                           uint16_t bodyLength) {
+        (void)host;
+        (void)port;
+        (void)path;
+        (void)bodyLength;
+        return false;
+    }
+    /**
+     * @brief Add a header to the post started by httpBegin().
+     *
+     * The host and content length headers are added by the modem.
+     *
+     * @param name The header name
+     * @param value The header value; this must stay valid until httpFinish()
+     * @return **bool** True if the header was added.
+     */
+    virtual bool httpAddHeader(const char* name, const char* value) {
+        (void)name;
+        (void)value;
+        return false;
+    }
+    /**
+     * @brief Get the modem ready for the body of the post.
+     *
+     * @return **Stream\*** The stream to write the body to, or null if the
+     * modem didn't take the request; the post is then closed and needs no
+     * httpFinish().
+     */
+    virtual Stream* httpStartBody(void) {
+        return nullptr;
+    }
+    /**
+     * @brief Send the post, wait for the response, and close the connection.
+     *
+     * @return **int16_t** The http status code of the response, or 0 if
+     * there wasn't one.
+     */
+    virtual int16_t httpFinish(void) {
+        return 0;
+    }
+    /**@}*/
+#endif
+
 
     /**
      * @anchor modem_metadata_functions
@@ -646,6 +1337,9 @@ class loggerModem {
      * @brief Query the modem for signal quality, battery, and temperature
      * information and store the values to the static internal variables.
      *
+     * With #MS_MODEM_PIGGYBACK_METADATA, values already read while connecting
+     * are kept and the modem isn't queried again.
+     *
      * @return **bool** True indicates that the communication with the modem
      * was successful and the values of the internal static variables should
      * be valid.
@@ -717,6 +1411,73 @@ class loggerModem {
      * @return **float** The stored temperature in degrees Celsius
      */
     static float getModemTemperature();
+#ifdef MS_MODEM_STATS
+    /**
+     * @brief Get the connection and traffic statistics of the modem
+     * (#MS_MODEM_STATS).
+     *
+     * @return **const modemStats&** The statistics.
+     */
+    static const modemStats& getModemStats(void);
+    /**
+     * @brief Set all of the statistics back to 0.
+     */
+    static void resetModemStats(void);
+    /**
+     * @brief Count a socket opened by a publisher.
+     */
+    static void recordSocketOpen(void);
+    /**
+     * @brief Add to the bytes sent and received by the publishers.
+     *
+     * @param bytesSent The bytes written to the client
+     * @param bytesReceived The bytes read back from the client
+     */
+    static void recordTraffic(uint32_t bytesSent, uint32_t bytesReceived);
+    /**
+     * @brief Keep the time taken to send to all of the publishers.
+     *
+     * @param publish_ms The time the publishers took in milliseconds
+     */
+    static void recordPublish(uint32_t publish_ms);
+    /**
+     * @brief Get the time to register in the last connection.
+     *
+     * @return **float** The time in seconds.
+     */
+    static float getModemRegistrationTime();
+    /**
+     * @brief Get the time to get online in the last connection.
+     *
+     * @return **float** The time in seconds.
+     */
+    static float getModemConnectTime();
+    /**
+     * @brief Get the time taken by the last round of sending to all of the
+     * publishers.
+     *
+     * @return **float** The time in seconds.
+     */
+    static float getModemPublishTime();
+    /**
+     * @brief Get the number of connections started.
+     *
+     * @return **float** The number of connections.
+     */
+    static float getModemConnectAttempts();
+    /**
+     * @brief Get the number of bytes sent by the publishers.
+     *
+     * @return **float** The number of bytes.
+     */
+    static float getModemBytesSent();
+    /**
+     * @brief Get the number of bytes read back by the publishers.
+     *
+     * @return **float** The number of bytes.
+     */
+    static float getModemBytesReceived();
+#endif
     /**@}*/
 
  protected:
@@ -803,6 +1564,38 @@ class loggerModem {
      * sucessfully - does _NOT_ indicate that the modem is now responsive.
      */
     virtual bool modemWakeFxn(void) = 0;
+#ifdef MS_MODEM_RECOVERY
+    /**
+     * @brief Start the recovery ladder of a wake at its remembered step
+     * (#MS_MODEM_RECOVERY).
+     */
+    void beginRecovery(void);
+    /**
+     * @brief Get the next step of the recovery ladder for this wake, skipping
+     * the ones the pins can't do.
+     *
+     * @return **modemRecoveryStep** The step to try, or #MODEM_RECOVERY_NONE
+     * if they've all been tried.
+     */
+    modemRecoveryStep nextRecoveryStep(void);
+    /**
+     * @brief Do a recovery step that only needs the pins: a hard reset or a
+     * power cycle.
+     *
+     * The soft restart and the factory reset need the TinyGSM modem, so
+     * they're done by the wake function made by LoggerModemMacros.h.
+     *
+     * @param step The modemRecoveryStep
+     * @return **bool** True if the step ran.
+     */
+    bool runRecoveryStep(modemRecoveryStep step);
+    /**
+     * @brief Remember where the ladder should start on the next failure.
+     *
+     * @param awake True if the modem answered in the end
+     */
+    void endRecovery(bool awake);
+#endif
     /**
      * @brief Perform the parts of the modem set up process that are unique to a
      * specific module, as opposed to the parts of setup that are common to all
@@ -838,6 +1631,117 @@ class loggerModem {
     virtual bool isModemAwake(void) = 0;
     /**@}*/
 
+#ifdef MS_MODEM_STAY_REGISTERED
+    /**
+     * @brief Send the power saving mode and eDRX timers requested by
+     * setStayRegistered() to the modem.
+     *
+     * For the modules that support it, this function is created by the
+     * #MS_MODEM_REQUEST_POWER_SAVING macro.
+     *
+     * @return **bool** True if the modem accepted the timers and can be left
+     * registered in power saving mode.
+     */
+    virtual bool requestPowerSaving(void) {
+        return false;
+    }
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+    /**
+     * @brief Tell the network that no more data is coming so it can release
+     * the radio connection (#MS_MODEM_RELEASE_ASSIST).
+     *
+     * For the modules that support it, this function is created by the
+     * #MS_MODEM_RELEASE_RADIO macro.
+     *
+     * @return **bool** True if the modem accepted the release request.
+     */
+    virtual bool releaseRadio(void) {
+        return false;
+    }
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+    /**
+     * @brief Read the address from the modem's answer to a DNS lookup.
+     *
+     * The address is the last quoted text on the line, or everything after
+     * the first colon if nothing is quoted.
+     *
+     * @param line The line of the answer with the address
+     * @param address The address read
+     * @return **bool** True if an address was read.
+     */
+    static bool addressFromLine(String line, IPAddress& address);
+#endif
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @brief Send the radio access technology and band lock to the modem.
+     *
+     * The modules that support it implement this with their own commands.
+     *
+     * @return **bool** True if the modem accepted the settings.
+     */
+    virtual bool applyRadioAccess(void) {
+        return true;
+    }
+#endif
+
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    /**
+     * @brief Move the modem and its serial port to the rate given to
+     * setModemBaud(), if it hasn't been moved already.
+     *
+     * For the modules that support it, this function is created by the
+     * #MS_MODEM_NEGOTIATE_BAUD macro.  It's called by modemWake() once the
+     * modem answers AT commands.
+     *
+     * @return **bool** True if the modem is answering at the faster rate.
+     */
+    virtual bool negotiateBaud(void) {
+        return false;
+    }
+    /**
+     * @brief Put the serial port back to the default baud rate.
+     *
+     * @return **bool** True if the port was at another rate.
+     */
+    bool resetModemBaud(void);
+#endif
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+    /**
+     * @brief Rejoin the access point from the last connection directly, with
+     * the address from that connection.
+     *
+     * This is called by the WiFi connectInternet() and pollConnect() before
+     * waiting for the modem to connect by itself.
+     *
+     * @return **bool** True if the modem rejoined the access point.
+     */
+    virtual bool fastConnect(void) {
+        return false;
+    }
+    /**
+     * @brief Remember the access point and address of the current connection
+     * for fastConnect().
+     *
+     * This is called by the WiFi connectInternet() and pollConnect() each
+     * time the modem connects; it does nothing if the connection is already
+     * saved.
+     */
+    virtual void saveConnection(void) {}
+#endif
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+    /**
+     * @brief Read the modem metadata while the modem is connecting, for the
+     * next call to updateModemMetadata().
+     *
+     * This is called by connectInternet() and pollConnect() as soon as the
+     * modem is registered.
+     */
+    void captureModemMetadata(void);
+#endif
+
     /**
      * @brief Convert the 4 bytes returned on the NIST daytime protocol to the
      * number of seconds since January 1, 1970 in UTC.
@@ -852,6 +1756,28 @@ class loggerModem {
      * UTC
      */
     static uint32_t parseNISTBytes(byte nistBytes[4]);
+#ifdef MS_MODEM_NETWORK_TIME
+    /**
+     * @brief Convert the date and time read from the modem's clock to the
+     * number of seconds since January 1, 1970 in UTC.
+     *
+     * A modem that hasn't been given the time by the network reports a
+     * default date in its clock; like the NIST time, anything before 2019 or
+     * after 2030 is taken to be one.
+     *
+     * @param year The four digit year
+     * @param month The month, 1-12
+     * @param day The day of the month, 1-31
+     * @param hour The hour, 0-23
+     * @param minute The minute, 0-59
+     * @param second The second, 0-59
+     * @param timezone The offset of the clock from UTC in hours
+     * @return **uint32_t** the number of seconds since January 1, 1970 00:00:00
+     * UTC, or 0 if the clock hasn't been set.
+     */
+    static uint32_t parseModemClock(int year, int month, int day, int hour,
+                                    int minute, int second, float timezone);
+#endif
 
     /**
      * @anchor modem_ctor_variables
@@ -988,11 +1914,175 @@ class loggerModem {
      * completed setup.
      */
     bool _hasBeenSetup = false;
+#ifdef MS_MODEM_RECOVERY
+    /**
+     * @brief The step the recovery ladder starts at on the next failure
+     */
+    uint8_t _recoveryStart = MODEM_RECOVERY_SOFT_RESET;
+    /**
+     * @brief The next step of the recovery ladder in this wake
+     */
+    uint8_t _recoveryNext = MODEM_RECOVERY_SOFT_RESET;
+    /**
+     * @brief The last step tried in this wake, or #MODEM_RECOVERY_NONE
+     */
+    uint8_t _recoveryLast = MODEM_RECOVERY_NONE;
+    /**
+     * @brief The wakes in a row the modem answered without recovery
+     */
+    uint8_t _cleanWakes = 0;
+    /**
+     * @brief The times each step was tried; the first is the wakes the whole
+     * ladder failed on
+     */
+    uint16_t _recoveryCounts[MODEM_RECOVERY_FACTORY_RESET + 1] = {0, 0, 0, 0,
+                                                                   0};
+#endif
     /**
      * @brief Flag.  True indicates that the pins on the mcu attached to the
      * modem are set to the correct mode (ie, input vs output).
      */
     bool _pinModesSet = false;
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+    /**
+     * @brief Flag.  True if the metadata was read while connecting and hasn't
+     * been handed back by updateModemMetadata() yet.
+     */
+    bool _metadataCaptured = false;
+#endif
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    /**
+     * @brief The hardware serial port the modem is on
+     */
+    HardwareSerial* _baudSerial = nullptr;
+    /**
+     * @brief The rate the modem starts at after power up
+     */
+    uint32_t _defaultBaud = 0;
+    /**
+     * @brief The faster rate to move the modem to
+     */
+    uint32_t _targetBaud = 0;
+    /**
+     * @brief The rate the serial port is at now
+     */
+    uint32_t _currentBaud = 0;
+    /**
+     * @brief Flag.  True if the modem didn't answer at the faster rate, so it
+     * won't be tried again.
+     */
+    bool _targetBaudFailed = false;
+#endif
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    /**
+     * @brief The step of the connection started by beginConnect().
+     */
+    modemConnectState _connectState = MODEM_CONNECT_IDLE;
+    /**
+     * @brief The processor elapsed time when beginConnect() was called.
+     */
+    uint32_t _connectStarted = 0;
+    /**
+     * @brief The maximum time in milliseconds given to beginConnect().
+     */
+    uint32_t _connectTimeout = 0;
+    /**
+     * @brief The processor elapsed time when the current step of the
+     * connection started.
+     */
+    uint32_t _connectStepStarted = 0;
+    /**
+     * @brief The processor elapsed time when the connection was last checked
+     * by pollConnect().
+     */
+    uint32_t _lastConnectPoll = 0;
+#endif
+#ifdef MS_MODEM_STAY_REGISTERED
+    /**
+     * @brief Flag.  True if the modem should stay registered in power saving
+     * mode between connections; set by setStayRegistered().
+     */
+    bool _stayRegistered = false;
+    /**
+     * @brief Flag.  True when the modem has accepted the power saving timers
+     * and is being left powered and registered between connections.
+     */
+    bool _powerSaving = false;
+    /**
+     * @brief The requested periodic tracking area update timer (T3412)
+     */
+    const char* _psmPeriodicTAU = nullptr;
+    /**
+     * @brief The requested active timer (T3324)
+     */
+    const char* _psmActiveTime = nullptr;
+    /**
+     * @brief The requested eDRX cycle, or null for none
+     */
+    const char* _eDRXCycle = nullptr;
+#endif
+#ifdef MS_MODEM_PSM_SCHEDULE
+    /**
+     * @brief The periodic tracking area update timer (T3412) worked out by
+     * setPSMSchedule(); empty until it's called
+     */
+    char _psmTAUBits[9] = "";
+    /**
+     * @brief The active timer (T3324) worked out by setPSMSchedule()
+     */
+    char _psmActiveBits[9] = "";
+#endif
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @brief The radio access technology to lock the modem to
+     */
+    modemRadioAccess _radioAccess = RADIO_ACCESS_AUTO;
+    /**
+     * @brief The modem's arguments for its band lock, or null
+     */
+    const char* _bandLock = nullptr;
+    /**
+     * @brief Flag.  True when the radio access or bands have been changed and
+     * haven't yet been sent to the modem.
+     */
+    bool _radioAccessPending = false;
+    /**
+     * @brief Flag.  True from powering the modem up until the last operator
+     * has been requested.
+     */
+    bool _operatorPending = false;
+    /**
+     * @brief The numeric code of the operator last registered on
+     */
+    char _lastOperator[8] = "";
+    /**
+     * @brief The access technology the last operator was registered with, as
+     * given by `AT+COPS?`, or -1
+     */
+    int8_t _lastAccess = -1;
+#endif
+#ifdef MS_MODEM_WARM_STANDBY
+    /**
+     * @brief The current of the modem while registered and idle, in mA
+     */
+    float _idleCurrent_mA = 0;
+    /**
+     * @brief The average current of the modem while attaching, in mA
+     */
+    float _attachCurrent_mA = 0;
+    /**
+     * @brief A function returning true when the modem should be powered down
+     */
+    bool (*_lowPowerCheck)(void) = nullptr;
+    /**
+     * @brief The time from power up to online of the last cold attach, in ms
+     */
+    uint32_t _coldAttach_ms = 0;
+    /**
+     * @brief Flag.  True from powering the modem up until it gets online.
+     */
+    bool _coldStart = false;
+#endif
     /**@}*/
 
     // NOTE:  These must be static so that the modem variables can call the
@@ -1045,6 +2135,15 @@ class loggerModem {
      * Returned by #getModemBatteryVoltage().
      */
     static float _priorBatteryVoltage;
+#ifdef MS_MODEM_STATS
+    /**
+     * @brief The connection and traffic statistics (#MS_MODEM_STATS).
+     *
+     * Filled in by connectInternet(), pollConnect(), and the publishers.
+     * Returned by #getModemStats().
+     */
+    static modemStats _stats;
+#endif
     // static float _priorActivationDuration;
     // static float _priorPoweredDuration;
     /**@}*/
@@ -1136,8 +2235,7 @@ class Modem_RSSI : public Variable {
     explicit Modem_RSSI(loggerModem* parentModem, const char* uuid = "",
                         const char* varCode = MODEM_RSSI_DEFAULT_CODE)
         : Variable(&parentModem->getModemRSSI, (uint8_t)MODEM_RSSI_RESOLUTION,
-                   &*MODEM_RSSI_VAR_NAME, &*MODEM_RSSI_UNIT_NAME, varCode,
-                   uuid) {
+                   MODEM_RSSI_VAR_NAME, MODEM_RSSI_UNIT_NAME, varCode, uuid) {
         parentModem->enableMetadataPolling(MODEM_RSSI_ENABLE_BITMASK);
     }
     /**
@@ -1171,8 +2269,8 @@ class Modem_SignalPercent : public Variable {
         const char* varCode = MODEM_PERCENT_SIGNAL_DEFAULT_CODE)
         : Variable(&parentModem->getModemSignalPercent,
                    (uint8_t)MODEM_PERCENT_SIGNAL_RESOLUTION,
-                   &*MODEM_PERCENT_SIGNAL_VAR_NAME,
-                   &*MODEM_PERCENT_SIGNAL_UNIT_NAME, varCode, uuid) {
+                   MODEM_PERCENT_SIGNAL_VAR_NAME,
+                   MODEM_PERCENT_SIGNAL_UNIT_NAME, varCode, uuid) {
         parentModem->enableMetadataPolling(MODEM_PERCENT_SIGNAL_ENABLE_BITMASK);
     }
     /**
@@ -1209,8 +2307,8 @@ class Modem_BatteryState : public Variable {
         const char* varCode = MODEM_BATTERY_STATE_DEFAULT_CODE)
         : Variable(&parentModem->getModemBatteryChargeState,
                    (uint8_t)MODEM_BATTERY_STATE_RESOLUTION,
-                   &*MODEM_BATTERY_STATE_VAR_NAME,
-                   &*MODEM_BATTERY_STATE_UNIT_NAME, varCode, uuid) {
+                   MODEM_BATTERY_STATE_VAR_NAME,
+                   MODEM_BATTERY_STATE_UNIT_NAME, varCode, uuid) {
         parentModem->enableMetadataPolling(MODEM_BATTERY_STATE_ENABLE_BITMASK);
     }
     /**
@@ -1247,8 +2345,8 @@ class Modem_BatteryPercent : public Variable {
         const char* varCode = MODEM_BATTERY_PERCENT_DEFAULT_CODE)
         : Variable(&parentModem->getModemBatteryChargePercent,
                    (uint8_t)MODEM_BATTERY_PERCENT_RESOLUTION,
-                   &*MODEM_BATTERY_PERCENT_VAR_NAME,
-                   &*MODEM_BATTERY_PERCENT_UNIT_NAME, varCode, uuid) {
+                   MODEM_BATTERY_PERCENT_VAR_NAME,
+                   MODEM_BATTERY_PERCENT_UNIT_NAME, varCode, uuid) {
         parentModem->enableMetadataPolling(
             MODEM_BATTERY_PERCENT_ENABLE_BITMASK);
     }
@@ -1286,8 +2384,8 @@ class Modem_BatteryVoltage : public Variable {
         const char* varCode = MODEM_BATTERY_VOLTAGE_DEFAULT_CODE)
         : Variable(&parentModem->getModemBatteryVoltage,
                    (uint8_t)MODEM_BATTERY_VOLTAGE_RESOLUTION,
-                   &*MODEM_BATTERY_VOLTAGE_VAR_NAME,
-                   &*MODEM_BATTERY_VOLTAGE_UNIT_NAME, varCode, uuid) {
+                   MODEM_BATTERY_VOLTAGE_VAR_NAME,
+                   MODEM_BATTERY_VOLTAGE_UNIT_NAME, varCode, uuid) {
         parentModem->enableMetadataPolling(
             MODEM_BATTERY_VOLTAGE_ENABLE_BITMASK);
     }
@@ -1324,7 +2422,7 @@ class Modem_Temp : public Variable {
                         const char* varCode = MODEM_TEMPERATURE_DEFAULT_CODE)
         : Variable(&parentModem->getModemTemperature,
                    (uint8_t)MODEM_TEMPERATURE_RESOLUTION,
-                   &*MODEM_TEMPERATURE_VAR_NAME, &*MODEM_TEMPERATURE_UNIT_NAME,
+                   MODEM_TEMPERATURE_VAR_NAME, MODEM_TEMPERATURE_UNIT_NAME,
                    varCode, uuid) {
         parentModem->enableMetadataPolling(MODEM_TEMPERATURE_ENABLE_BITMASK);
     }
@@ -1334,5 +2432,211 @@ class Modem_Temp : public Variable {
     ~Modem_Temp() {}
 };
 
+
+#ifdef MS_MODEM_STATS
+/**
+ * @brief The Variable sub-class used for the time a modem took to register
+ * (#MS_MODEM_STATS).
+ *
+ * The value is the time in seconds from the start of the last connection to
+ * the modem registering on the network; for a WiFi modem, to joining the
+ * access point.
+ *
+ * @ingroup modem_measured_variables
+ */
+class Modem_RegistrationTime : public Variable {
+ public:
+    /**
+     * @brief Construct a new Modem_RegistrationTime object.
+     *
+     * @param parentModem The parent modem providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "modemRegisterSec".
+     */
+    explicit Modem_RegistrationTime(
+        loggerModem* parentModem, const char* uuid = "",
+        const char* varCode = MODEM_REGISTRATION_DEFAULT_CODE)
+        : Variable(&parentModem->getModemRegistrationTime,
+                   (uint8_t)MODEM_STATS_TIME_RESOLUTION,
+                   MODEM_STATS_TIME_VAR_NAME, MODEM_STATS_TIME_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Destroy the Modem_RegistrationTime object - no action needed.
+     */
+    ~Modem_RegistrationTime() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the time a modem took to get online
+ * (#MS_MODEM_STATS).
+ *
+ * The value is the time in seconds from the start of the last connection to
+ * the modem being online.
+ *
+ * @ingroup modem_measured_variables
+ */
+class Modem_ConnectTime : public Variable {
+ public:
+    /**
+     * @brief Construct a new Modem_ConnectTime object.
+     *
+     * @param parentModem The parent modem providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "modemConnectSec".
+     */
+    explicit Modem_ConnectTime(
+        loggerModem* parentModem, const char* uuid = "",
+        const char* varCode = MODEM_CONNECT_DEFAULT_CODE)
+        : Variable(&parentModem->getModemConnectTime,
+                   (uint8_t)MODEM_STATS_TIME_RESOLUTION,
+                   MODEM_STATS_TIME_VAR_NAME, MODEM_STATS_TIME_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Destroy the Modem_ConnectTime object - no action needed.
+     */
+    ~Modem_ConnectTime() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the time the last publish took
+ * (#MS_MODEM_STATS).
+ *
+ * The value is the time in seconds the last publisher took to send its data
+ * and get a response.
+ *
+ * @ingroup modem_measured_variables
+ */
+class Modem_PublishTime : public Variable {
+ public:
+    /**
+     * @brief Construct a new Modem_PublishTime object.
+     *
+     * @param parentModem The parent modem providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "modemPublishSec".
+     */
+    explicit Modem_PublishTime(
+        loggerModem* parentModem, const char* uuid = "",
+        const char* varCode = MODEM_PUBLISH_DEFAULT_CODE)
+        : Variable(&parentModem->getModemPublishTime,
+                   (uint8_t)MODEM_STATS_TIME_RESOLUTION,
+                   MODEM_STATS_TIME_VAR_NAME, MODEM_STATS_TIME_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Destroy the Modem_PublishTime object - no action needed.
+     */
+    ~Modem_PublishTime() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the number of connections a modem
+ * has started (#MS_MODEM_STATS).
+ *
+ * The value is the number of connections started since the logger started.
+ *
+ * @ingroup modem_measured_variables
+ */
+class Modem_ConnectAttempts : public Variable {
+ public:
+    /**
+     * @brief Construct a new Modem_ConnectAttempts object.
+     *
+     * @param parentModem The parent modem providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "modemConnects".
+     */
+    explicit Modem_ConnectAttempts(
+        loggerModem* parentModem, const char* uuid = "",
+        const char* varCode = MODEM_CONNECT_ATTEMPTS_DEFAULT_CODE)
+        : Variable(&parentModem->getModemConnectAttempts,
+                   (uint8_t)MODEM_STATS_COUNT_RESOLUTION,
+                   MODEM_STATS_COUNT_VAR_NAME, MODEM_STATS_COUNT_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Destroy the Modem_ConnectAttempts object - no action needed.
+     */
+    ~Modem_ConnectAttempts() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the bytes sent by the publishers
+ * (#MS_MODEM_STATS).
+ *
+ * The value is the number of bytes the publishers have sent since the logger
+ * started.
+ *
+ * @ingroup modem_measured_variables
+ */
+class Modem_BytesSent : public Variable {
+ public:
+    /**
+     * @brief Construct a new Modem_BytesSent object.
+     *
+     * @param parentModem The parent modem providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "modemBytesSent".
+     */
+    explicit Modem_BytesSent(
+        loggerModem* parentModem, const char* uuid = "",
+        const char* varCode = MODEM_BYTES_SENT_DEFAULT_CODE)
+        : Variable(&parentModem->getModemBytesSent,
+                   (uint8_t)MODEM_STATS_COUNT_RESOLUTION,
+                   MODEM_STATS_COUNT_VAR_NAME, MODEM_STATS_BYTES_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Destroy the Modem_BytesSent object - no action needed.
+     */
+    ~Modem_BytesSent() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the bytes of the responses read by
+ * the publishers (#MS_MODEM_STATS).
+ *
+ * The value is the number of bytes of the responses to the publishers read
+ * since the logger started.
+ *
+ * @ingroup modem_measured_variables
+ */
+class Modem_BytesReceived : public Variable {
+ public:
+    /**
+     * @brief Construct a new Modem_BytesReceived object.
+     *
+     * @param parentModem The parent modem providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "modemBytesRcvd".
+     */
+    explicit Modem_BytesReceived(
+        loggerModem* parentModem, const char* uuid = "",
+        const char* varCode = MODEM_BYTES_RECEIVED_DEFAULT_CODE)
+        : Variable(&parentModem->getModemBytesReceived,
+                   (uint8_t)MODEM_STATS_COUNT_RESOLUTION,
+                   MODEM_STATS_COUNT_VAR_NAME, MODEM_STATS_BYTES_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Destroy the Modem_BytesReceived object - no action needed.
+     */
+    ~Modem_BytesReceived() {}
+};
+#endif
+
 // #include <LoggerModem.tpp>
 #endif  // SRC_LOGGERMODEM_H_
@@ -0,0 +1,157 @@
+/**
+ * @file LoggerProfiler.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the LoggerProfiler class.
+ */
+
+#include "LoggerProfiler.h"
+
+#ifdef MS_LOGGER_PROFILE
+
+profileEntry LoggerProfiler::_trace[MS_PROFILE_TRACE_SIZE];
+uint8_t      LoggerProfiler::_traceHead  = 0;
+uint8_t      LoggerProfiler::_traceCount = 0;
+uint32_t     LoggerProfiler::_spanStart[SPAN_COUNT];
+uint16_t     LoggerProfiler::_spanOpen = 0;
+uint32_t     LoggerProfiler::_cycleTime[SPAN_COUNT];
+uint32_t     LoggerProfiler::_lastCycleTime[SPAN_COUNT];
+#ifdef MS_LOGGER_ENERGY
+float (*LoggerProfiler::_readCurrent)(void) = nullptr;
+float    LoggerProfiler::_lastCurrent_mA    = 0;
+uint32_t LoggerProfiler::_lastSampleMillis  = 0;
+bool     LoggerProfiler::_haveSample        = false;
+float    LoggerProfiler::_cycleCharge[SPAN_COUNT];
+float    LoggerProfiler::_lastCycleCharge[SPAN_COUNT];
+#endif
+
+
+void LoggerProfiler::startCycle(void) {
+    for (uint8_t i = 0; i < SPAN_COUNT; i++) {
+        _lastCycleTime[i] = _cycleTime[i];
+        _cycleTime[i]     = 0;
+#ifdef MS_LOGGER_ENERGY
+        _lastCycleCharge[i] = _cycleCharge[i];
+        _cycleCharge[i]     = 0;
+#endif
+    }
+    startSpan(SPAN_CYCLE);
+}
+void LoggerProfiler::endCycle(void) {
+    endSpan(SPAN_CYCLE);
+}
+
+
+void LoggerProfiler::startSpan(profileSpan span) {
+    if (_spanOpen & (1 << span)) return;
+#ifdef MS_LOGGER_ENERGY
+    // Close off the charge of the spans already open before this one starts
+    sampleCurrent();
+#endif
+    _spanStart[span] = millis();
+    _spanOpen |= 1 << span;
+}
+
+
+void LoggerProfiler::endSpan(profileSpan span, uint8_t detail) {
+    if (!(_spanOpen & (1 << span))) return;
+#ifdef MS_LOGGER_ENERGY
+    sampleCurrent();
+#endif
+    _spanOpen &= ~(1 << span);
+    uint32_t duration = millis() - _spanStart[span];
+    _cycleTime[span] += duration;
+
+    // Write over the oldest span once the trace is full
+    uint8_t slot = (_traceHead + _traceCount) % MS_PROFILE_TRACE_SIZE;
+    if (_traceCount < MS_PROFILE_TRACE_SIZE) {
+        _traceCount++;
+    } else {
+        _traceHead = (_traceHead + 1) % MS_PROFILE_TRACE_SIZE;
+    }
+    _trace[slot].start_ms    = _spanStart[span];
+    _trace[slot].duration_ms = duration;
+    _trace[slot].span        = span;
+    _trace[slot].detail      = detail;
+}
+
+
+uint32_t LoggerProfiler::getLastCycleTime(profileSpan span) {
+    return _lastCycleTime[span];
+}
+
+
+uint8_t LoggerProfiler::getCount(void) {
+    return _traceCount;
+}
+
+
+bool LoggerProfiler::getEntry(uint8_t index, profileEntry& entry) {
+    if (index >= _traceCount) return false;
+    entry = _trace[(_traceHead + index) % MS_PROFILE_TRACE_SIZE];
+    return true;
+}
+
+
+void LoggerProfiler::printTrace(Stream* stream) {
+    profileEntry entry;
+    for (uint8_t i = 0; getEntry(i, entry); i++) {
+        stream->print(entry.span);
+        stream->print(',');
+        stream->print(entry.detail);
+        stream->print(',');
+        stream->print(entry.start_ms);
+        stream->print(',');
+        stream->println(entry.duration_ms);
+    }
+}
+
+
+void LoggerProfiler::clearTrace(void) {
+    _traceHead  = 0;
+    _traceCount = 0;
+}
+
+
+#ifdef MS_LOGGER_ENERGY
+void LoggerProfiler::setCurrentSource(float (*readCurrent)(void)) {
+    _readCurrent = readCurrent;
+    _haveSample  = false;
+}
+
+
+void LoggerProfiler::sampleCurrent(void) {
+    if (_readCurrent == nullptr) return;
+    float    current_mA = _readCurrent();
+    uint32_t now        = millis();
+    if (isnan(current_mA) || current_mA == -9999) return;
+    if (_haveSample) {
+        // Take the current as changing evenly between the two samples
+        float charge_mAh = (_lastCurrent_mA + current_mA) / 2 *
+            (now - _lastSampleMillis) / 3600000.0f;
+        for (uint8_t i = 0; i < SPAN_COUNT; i++) {
+            if (_spanOpen & (1 << i)) _cycleCharge[i] += charge_mAh;
+        }
+    }
+    _lastCurrent_mA   = current_mA;
+    _lastSampleMillis = now;
+    _haveSample       = true;
+}
+
+
+void LoggerProfiler::sampleCurrentIfDue(void) {
+    if (_haveSample && millis() - _lastSampleMillis < MS_ENERGY_SAMPLE_MS) {
+        return;
+    }
+    sampleCurrent();
+}
+
+
+float LoggerProfiler::getLastCycleCharge(profileSpan span) {
+    return _lastCycleCharge[span];
+}
+#endif
+
+#endif  // MS_LOGGER_PROFILE
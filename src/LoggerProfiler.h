@@ -0,0 +1,278 @@
+/**
+ * @file LoggerProfiler.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the LoggerProfiler class, which times the named parts of
+ * each logging cycle into a fixed-size trace, and the MS_PROFILE_ macros used
+ * to mark those parts.
+ */
+
+// Header Guards
+#ifndef SRC_LOGGERPROFILER_H_
+#define SRC_LOGGERPROFILER_H_
+
+// Included Dependencies
+#include <Arduino.h>
+
+/**
+ * @brief The number of timed spans kept in the trace; once it's full the
+ * oldest are written over.
+ *
+ * Each span takes 10 to 12 bytes of RAM.
+ */
+#ifndef MS_PROFILE_TRACE_SIZE
+#define MS_PROFILE_TRACE_SIZE 32
+#endif
+// The position and count of the trace are kept in single bytes
+static_assert(MS_PROFILE_TRACE_SIZE <= 255,
+              "MS_PROFILE_TRACE_SIZE can't be more than 255");
+
+#ifdef MS_LOGGER_ENERGY
+#ifndef MS_LOGGER_PROFILE
+#define MS_LOGGER_PROFILE
+#endif
+/**
+ * @brief The shortest time in milliseconds between the current samples taken
+ * while the sensors are being updated (#MS_LOGGER_ENERGY).
+ *
+ * The current is also sampled at the start and end of every span.
+ */
+#ifndef MS_ENERGY_SAMPLE_MS
+#define MS_ENERGY_SAMPLE_MS 250
+#endif
+#endif
+
+/**
+ * @brief The parts of a logging cycle timed by the LoggerProfiler.
+ */
+typedef enum profileSpan : uint8_t {
+    SPAN_CYCLE = 0,    ///< A whole logging cycle
+    SPAN_SENSORS,      ///< Updating all of the sensors
+    SPAN_SD_OPEN,      ///< Mounting the SD card and opening the log file
+    SPAN_SD_WRITE,     ///< Writing a record to the log file
+    SPAN_SD_CLOSE,     ///< Saving and closing the log file
+    SPAN_MODEM_WAKE,   ///< Waking up the modem
+    SPAN_CONNECT,      ///< Connecting to the internet
+    SPAN_PUBLISH,      ///< Sending to one publisher, given as the detail
+    SPAN_TIME_SYNC,    ///< Getting the time to set the clock
+    SPAN_MODEM_SLEEP,  ///< Disconnecting and powering down the modem
+    SPAN_COUNT         ///< The number of spans
+} profileSpan;
+
+/**
+ * @brief One timed span in the trace of the LoggerProfiler.
+ */
+typedef struct profileEntry {
+    uint32_t start_ms;     ///< The processor time the span started
+    uint32_t duration_ms;  ///< How long the span took
+    uint8_t  span;         ///< The profileSpan
+    uint8_t  detail;       ///< Which one, like the index of a publisher
+} profileEntry;
+
+#ifdef MS_LOGGER_PROFILE
+/**
+ * @brief Start timing a span of the profile.
+ */
+#define MS_PROFILE_START(span) LoggerProfiler::startSpan(span)
+/**
+ * @brief Finish timing a span of the profile and add it to the trace.
+ */
+#define MS_PROFILE_END(span) LoggerProfiler::endSpan(span, 0)
+/**
+ * @brief Finish timing a span of the profile for one of several of the same
+ * thing, like a publisher, and add it to the trace.
+ */
+#define MS_PROFILE_END_FOR(span, detail) LoggerProfiler::endSpan(span, detail)
+#else
+/**
+ * @brief Start timing a span of the profile; does nothing without
+ * #MS_LOGGER_PROFILE.
+ */
+#define MS_PROFILE_START(span)
+/**
+ * @brief Finish timing a span of the profile; does nothing without
+ * #MS_LOGGER_PROFILE.
+ */
+#define MS_PROFILE_END(span)
+/**
+ * @brief Finish timing a span of the profile for one of several of the same
+ * thing; does nothing without #MS_LOGGER_PROFILE.
+ */
+#define MS_PROFILE_END_FOR(span, detail)
+#endif
+
+#ifdef MS_LOGGER_ENERGY
+/**
+ * @brief Sample the current if it's been #MS_ENERGY_SAMPLE_MS since the last
+ * sample.
+ */
+#define MS_PROFILE_SAMPLE() LoggerProfiler::sampleCurrentIfDue()
+#else
+/**
+ * @brief Sample the current; does nothing without #MS_LOGGER_ENERGY.
+ */
+#define MS_PROFILE_SAMPLE()
+#endif
+
+
+#ifdef MS_LOGGER_PROFILE
+/**
+ * @brief The LoggerProfiler times the named parts of each logging cycle
+ * (#MS_LOGGER_PROFILE).
+ *
+ * Every span that's finished is added to a ring of #MS_PROFILE_TRACE_SIZE
+ * entries and to the total time of its kind for the current cycle.  Timing
+ * a span costs a call to millis() at each end, so it can be left in field
+ * builds, unlike the debugging timers that only print.
+ *
+ * The trace can be appended to a file on the SD card with
+ * Logger::writeProfileTrace() or printed with printTrace().  The totals of
+ * the last finished cycle can be logged or published as calculated variables,
+ * for example:
+ *
+ * @code{.cpp}
+ * float getConnectTime(void) {
+ *     return LoggerProfiler::getLastCycleTime(SPAN_CONNECT);
+ * }
+ * Variable* connectTime = new Variable(getConnectTime, 0, "timeElapsed",
+ *                                      "millisecond", "connectTime");
+ * @endcode
+ *
+ * With #MS_LOGGER_ENERGY the current from the function given to
+ * setCurrentSource() is also sampled at the start and end of each span and
+ * every #MS_ENERGY_SAMPLE_MS while the sensors are updated.  The charge
+ * between two samples is added to every span that was being timed between
+ * them, and getLastCycleCharge() gives the total of each kind of span for
+ * the last cycle in mAh.
+ *
+ * @ingroup base_classes
+ */
+class LoggerProfiler {
+ public:
+    /**
+     * @brief Start a new logging cycle.
+     *
+     * The totals of the cycle before become those returned by
+     * getLastCycleTime() and the #SPAN_CYCLE span is started.
+     */
+    static void startCycle(void);
+    /**
+     * @brief Finish the logging cycle, ending its #SPAN_CYCLE span.
+     */
+    static void endCycle(void);
+    /**
+     * @brief Start timing a span.
+     *
+     * Only one span of each kind is timed at a time; starting one that's
+     * already being timed has no effect, so it runs on until it's finished.
+     *
+     * @param span The profileSpan to start
+     */
+    static void startSpan(profileSpan span);
+    /**
+     * @brief Finish timing a span, adding it to the trace and the totals of
+     * the cycle.  A span that wasn't started is ignored.
+     *
+     * @param span The profileSpan to finish
+     * @param detail Which one of several of the same span this is, like the
+     * index of a publisher; optional with a default value of 0.
+     */
+    static void endSpan(profileSpan span, uint8_t detail = 0);
+
+    /**
+     * @brief Get the total time spent in one kind of span during the last
+     * finished cycle.
+     *
+     * @param span The profileSpan to get the time of
+     * @return **uint32_t** The time in milliseconds.
+     */
+    static uint32_t getLastCycleTime(profileSpan span);
+    /**
+     * @brief Get the number of spans in the trace.
+     *
+     * @return **uint8_t** The number of spans, up to #MS_PROFILE_TRACE_SIZE.
+     */
+    static uint8_t getCount(void);
+    /**
+     * @brief Get a span from the trace.
+     *
+     * @param index The position of the span in the trace, the oldest first
+     * @param entry The profileEntry to copy the span into
+     * @return **bool** True if there was a span at that position.
+     */
+    static bool getEntry(uint8_t index, profileEntry& entry);
+    /**
+     * @brief Print the trace as comma separated lines of the span, the
+     * detail, the start and the duration, the oldest first.
+     *
+     * @param stream An Arduino Stream instance; like a File or Serial
+     */
+    static void printTrace(Stream* stream);
+    /**
+     * @brief Empty the trace.  The totals of the cycles are kept.
+     */
+    static void clearTrace(void);
+
+#ifdef MS_LOGGER_ENERGY
+    /**
+     * @brief Set the function that reads the current drawn by the logger
+     * (#MS_LOGGER_ENERGY).
+     *
+     * The function must be quick and safe to call between the steps of any
+     * sensor, like TIINA219::readCurrent() of an INA219 that's always
+     * powered.  A NaN or -9999 result is skipped.
+     *
+     * @code{.cpp}
+     * TIINA219 ina219(-1);
+     * float    readLoggerCurrent(void) {
+     *     return ina219.readCurrent();
+     * }
+     * // in setup()
+     * LoggerProfiler::setCurrentSource(readLoggerCurrent);
+     * @endcode
+     *
+     * @param readCurrent A function returning the current in mA
+     */
+    static void setCurrentSource(float (*readCurrent)(void));
+    /**
+     * @brief Sample the current, adding the charge since the last sample to
+     * every span being timed.
+     */
+    static void sampleCurrent(void);
+    /**
+     * @brief Sample the current if it's been #MS_ENERGY_SAMPLE_MS since the
+     * last sample.
+     */
+    static void sampleCurrentIfDue(void);
+    /**
+     * @brief Get the total charge drawn during one kind of span in the last
+     * finished cycle.
+     *
+     * @param span The profileSpan to get the charge of
+     * @return **float** The charge in mAh.
+     */
+    static float getLastCycleCharge(profileSpan span);
+#endif
+
+ private:
+    static profileEntry _trace[MS_PROFILE_TRACE_SIZE];
+    static uint8_t      _traceHead;
+    static uint8_t      _traceCount;
+    static uint32_t     _spanStart[SPAN_COUNT];
+    static uint16_t     _spanOpen;
+    static uint32_t     _cycleTime[SPAN_COUNT];
+    static uint32_t     _lastCycleTime[SPAN_COUNT];
+#ifdef MS_LOGGER_ENERGY
+    static float (*_readCurrent)(void);
+    static float    _lastCurrent_mA;
+    static uint32_t _lastSampleMillis;
+    static bool     _haveSample;
+    static float    _cycleCharge[SPAN_COUNT];
+    static float    _lastCycleCharge[SPAN_COUNT];
+#endif
+};
+#endif  // MS_LOGGER_PROFILE
+
+#endif  // SRC_LOGGERPROFILER_H_
@@ -0,0 +1,135 @@
+/**
+ * @file LoggerRecordStore.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the FRAMRecordStore class.
+ */
+
+#include "LoggerRecordStore.h"
+
+// The SPI opcodes common to FRAM chips
+#define FRAM_SPI_WREN 0x06
+#define FRAM_SPI_WRITE 0x02
+#define FRAM_SPI_READ 0x03
+
+// The most bytes to move in one I2C transaction, leaving room for the address
+// in the Wire buffer
+#define FRAM_I2C_CHUNK 30
+
+
+FRAMRecordStore::FRAMRecordStore(int8_t csPin, uint32_t size,
+                                 SPIClass* theSPI)
+    : _csPin(csPin),
+      _spi(theSPI),
+      _i2c(nullptr),
+      _i2cAddress(0),
+      _size(size) {}
+FRAMRecordStore::FRAMRecordStore(TwoWire* theI2C, uint8_t i2cAddress,
+                                 uint32_t size)
+    : _csPin(-1),
+      _spi(nullptr),
+      _i2c(theI2C),
+      _i2cAddress(i2cAddress),
+      _size(size) {}
+FRAMRecordStore::~FRAMRecordStore() {}
+
+
+bool FRAMRecordStore::begin(void) {
+    if (_i2c != nullptr) {
+        _i2c->begin();
+        _i2c->beginTransmission(_i2cAddress);
+        bool answered = _i2c->endTransmission() == 0;
+        if (!answered) {
+            MS_DBG(F("No FRAM answered at 0x"), String(_i2cAddress, HEX));
+        }
+        return answered;
+    }
+    if (_csPin < 0) return false;
+    pinMode(_csPin, OUTPUT);
+    digitalWrite(_csPin, HIGH);
+    _spi->begin();
+    return true;
+}
+
+
+uint32_t FRAMRecordStore::capacity(void) {
+    return _size;
+}
+
+
+void FRAMRecordStore::sendSPICommand(uint8_t opcode, uint32_t address) {
+    _spi->transfer(opcode);
+    if (_size > 0x10000UL) {
+        _spi->transfer(static_cast<uint8_t>(address >> 16));
+    }
+    _spi->transfer(static_cast<uint8_t>(address >> 8));
+    _spi->transfer(static_cast<uint8_t>(address));
+}
+
+
+bool FRAMRecordStore::read(uint32_t address, void* buffer, uint16_t length) {
+    if (address + length > _size) return false;
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    if (_i2c == nullptr) {
+        // An SPI FRAM streams out as many bytes as are clocked
+        _spi->beginTransaction(SPISettings(8000000, MSBFIRST, SPI_MODE0));
+        digitalWrite(_csPin, LOW);
+        sendSPICommand(FRAM_SPI_READ, address);
+        for (uint16_t i = 0; i < length; i++) { out[i] = _spi->transfer(0); }
+        digitalWrite(_csPin, HIGH);
+        _spi->endTransaction();
+        return true;
+    }
+    while (length > 0) {
+        uint8_t chunk = length > FRAM_I2C_CHUNK ? FRAM_I2C_CHUNK : length;
+        // Don't let a chunk cross into the next 64 kB
+        uint32_t toBoundary = 0x10000UL - (address & 0xFFFF);
+        if (chunk > toBoundary) chunk = toBoundary;
+        uint8_t device = _i2cAddress | ((address >> 16) & 0x01);
+        _i2c->beginTransmission(device);
+        _i2c->write(static_cast<uint8_t>(address >> 8));
+        _i2c->write(static_cast<uint8_t>(address));
+        if (_i2c->endTransmission(false) != 0) return false;
+        if (_i2c->requestFrom(device, chunk) != chunk) return false;
+        for (uint8_t i = 0; i < chunk; i++) { *out++ = _i2c->read(); }
+        address += chunk;
+        length -= chunk;
+    }
+    return true;
+}
+
+
+bool FRAMRecordStore::write(uint32_t address, const void* buffer,
+                            uint16_t length) {
+    if (address + length > _size) return false;
+    const uint8_t* in = static_cast<const uint8_t*>(buffer);
+    if (_i2c == nullptr) {
+        _spi->beginTransaction(SPISettings(8000000, MSBFIRST, SPI_MODE0));
+        // Every write has to be enabled first
+        digitalWrite(_csPin, LOW);
+        _spi->transfer(FRAM_SPI_WREN);
+        digitalWrite(_csPin, HIGH);
+        digitalWrite(_csPin, LOW);
+        sendSPICommand(FRAM_SPI_WRITE, address);
+        for (uint16_t i = 0; i < length; i++) { _spi->transfer(in[i]); }
+        digitalWrite(_csPin, HIGH);
+        _spi->endTransaction();
+        return true;
+    }
+    while (length > 0) {
+        uint8_t chunk = length > FRAM_I2C_CHUNK ? FRAM_I2C_CHUNK : length;
+        uint32_t toBoundary = 0x10000UL - (address & 0xFFFF);
+        if (chunk > toBoundary) chunk = toBoundary;
+        _i2c->beginTransmission(_i2cAddress | ((address >> 16) & 0x01));
+        _i2c->write(static_cast<uint8_t>(address >> 8));
+        _i2c->write(static_cast<uint8_t>(address));
+        _i2c->write(in, chunk);
+        if (_i2c->endTransmission() != 0) return false;
+        in += chunk;
+        address += chunk;
+        length -= chunk;
+    }
+    return true;
+}
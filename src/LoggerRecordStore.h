@@ -0,0 +1,143 @@
+/**
+ * @file LoggerRecordStore.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the LoggerRecordStore interface for non-volatile memory
+ * that holds the logger's buffered records, and the FRAMRecordStore class
+ * that implements it for SPI and I2C FRAM chips.
+ */
+
+// Header Guards
+#ifndef SRC_LOGGERRECORDSTORE_H_
+#define SRC_LOGGERRECORDSTORE_H_
+
+// Debugging Statement
+// #define MS_LOGGERRECORDSTORE_DEBUG
+
+#ifdef MS_LOGGERRECORDSTORE_DEBUG
+#define MS_DEBUGGING_STD "LoggerRecordStore"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+
+
+/**
+ * @brief A LoggerRecordStore is a block of byte-addressed memory that keeps
+ * its contents through resets and power loss, used by the logger to hold
+ * buffered records until they're written to the SD card.
+ *
+ * See #MS_LOGGER_RECORD_STORE.  To keep the records somewhere other than the
+ * FRAM chips supported by FRAMRecordStore, derive a class from this one.
+ *
+ * @ingroup base_classes
+ */
+class LoggerRecordStore {
+ public:
+    /**
+     * @brief Destroy the LoggerRecordStore object - no action taken.
+     */
+    virtual ~LoggerRecordStore() {}
+
+    /**
+     * @brief Get the memory ready to use.
+     *
+     * @return **bool** True if the memory answered.
+     */
+    virtual bool begin(void) = 0;
+    /**
+     * @brief Get the size of the memory.
+     *
+     * @return **uint32_t** The number of bytes that can be stored.
+     */
+    virtual uint32_t capacity(void) = 0;
+    /**
+     * @brief Read bytes from the memory.
+     *
+     * @param address The address of the first byte
+     * @param buffer The buffer to read into
+     * @param length The number of bytes to read
+     * @return **bool** True if all of the bytes were read.
+     */
+    virtual bool read(uint32_t address, void* buffer, uint16_t length) = 0;
+    /**
+     * @brief Write bytes to the memory.
+     *
+     * @param address The address of the first byte
+     * @param buffer The bytes to write
+     * @param length The number of bytes to write
+     * @return **bool** True if all of the bytes were written.
+     */
+    virtual bool write(uint32_t address, const void* buffer,
+                       uint16_t length) = 0;
+};
+
+
+/**
+ * @brief A FRAMRecordStore keeps the logger's buffered records in a
+ * ferroelectric RAM chip, like the Fujitsu MB85RS (SPI) and MB85RC (I2C)
+ * series or the Cypress FM25 and FM24 series.
+ *
+ * FRAM writes at bus speed with no erase or page delays, takes very little
+ * energy per write, and lasts for trillions of writes, so every record can be
+ * written to it as it's taken.
+ *
+ * 16-bit addresses are used for SPI chips up to 64 kB and 24-bit addresses
+ * for larger ones.  I2C chips larger than 64 kB take the 17th address bit in
+ * the lowest bit of their I2C address, like the MB85RC1M.
+ *
+ * @ingroup base_classes
+ */
+class FRAMRecordStore : public LoggerRecordStore {
+ public:
+    /**
+     * @brief Construct a new FRAMRecordStore object for an SPI FRAM chip.
+     *
+     * @param csPin The chip select pin of the FRAM
+     * @param size The size of the FRAM in bytes
+     * @param theSPI The SPI bus the FRAM is on; optional with a default value
+     * of SPI.
+     */
+    FRAMRecordStore(int8_t csPin, uint32_t size, SPIClass* theSPI = &SPI);
+    /**
+     * @brief Construct a new FRAMRecordStore object for an I2C FRAM chip.
+     *
+     * @param theI2C A TwoWire instance for I2C communication
+     * @param i2cAddress The I2C address of the FRAM, 0x50 to 0x57
+     * @param size The size of the FRAM in bytes
+     */
+    FRAMRecordStore(TwoWire* theI2C, uint8_t i2cAddress, uint32_t size);
+    /**
+     * @brief Destroy the FRAMRecordStore object - no action taken.
+     */
+    virtual ~FRAMRecordStore();
+
+    bool     begin(void) override;
+    uint32_t capacity(void) override;
+    bool     read(uint32_t address, void* buffer, uint16_t length) override;
+    bool     write(uint32_t address, const void* buffer,
+                   uint16_t length) override;
+
+ private:
+    /**
+     * @brief Send the opcode and address of an SPI command.
+     *
+     * @param opcode The SPI opcode
+     * @param address The memory address
+     */
+    void sendSPICommand(uint8_t opcode, uint32_t address);
+
+    int8_t    _csPin;
+    SPIClass* _spi;
+    TwoWire*  _i2c;
+    uint8_t   _i2cAddress;
+    uint32_t  _size;
+};
+
+#endif  // SRC_LOGGERRECORDSTORE_H_
@@ -0,0 +1,72 @@
+/**
+ * @file LoggerSdSpiDMA.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the LoggerSdSpiDMA class.
+ */
+
+// Be careful to use a platform-specific conditional include to only make the
+// code visible for the appropriate platform.  Arduino will try to compile and
+// link all .cpp files regardless of platform.
+#if defined(MS_LOGGER_SD_DMA) && defined(ARDUINO_ARCH_SAMD)
+
+#include "LoggerSdSpiDMA.h"
+
+
+LoggerSdSpiDMA::LoggerSdSpiDMA(SPIClass* theSPI)
+    : _spi(theSPI),
+      _settings(SD_SCK_MHZ(4), MSBFIRST, SPI_MODE0) {}
+
+
+void LoggerSdSpiDMA::begin(SdSpiConfig config) {
+    (void)config;
+    _spi->begin();
+}
+void LoggerSdSpiDMA::end() {}
+
+
+void LoggerSdSpiDMA::activate() {
+    _spi->beginTransaction(_settings);
+}
+void LoggerSdSpiDMA::deactivate() {
+    _spi->endTransaction();
+}
+
+
+void LoggerSdSpiDMA::setSckSpeed(uint32_t maxSck) {
+    MS_DBG(F("SD card SPI clock set to"), maxSck, F("Hz"));
+    _settings = SPISettings(maxSck, MSBFIRST, SPI_MODE0);
+}
+
+
+uint8_t LoggerSdSpiDMA::receive() {
+    return _spi->transfer(0XFF);
+}
+uint8_t LoggerSdSpiDMA::receive(uint8_t* buf, size_t count) {
+    // The card needs 0xFF clocked out while it answers; each byte is sent
+    // before its place in the buffer is written by the received byte
+    memset(buf, 0XFF, count);
+    if (count < MS_SD_DMA_MIN_BYTES) {
+        _spi->transfer(buf, count);
+    } else {
+        _spi->transfer(buf, buf, count, true);
+    }
+    return 0;
+}
+
+
+void LoggerSdSpiDMA::send(uint8_t data) {
+    _spi->transfer(data);
+}
+void LoggerSdSpiDMA::send(const uint8_t* buf, size_t count) {
+    if (count < MS_SD_DMA_MIN_BYTES) {
+        for (size_t i = 0; i < count; i++) { _spi->transfer(buf[i]); }
+    } else {
+        // Nothing needs to be kept from what the card sends back
+        _spi->transfer(buf, nullptr, count, true);
+    }
+}
+
+#endif
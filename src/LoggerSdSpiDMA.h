@@ -0,0 +1,81 @@
+/**
+ * @file LoggerSdSpiDMA.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the LoggerSdSpiDMA class, an SdFat SPI driver that moves the
+ * sectors of an SD card with DMA on SAMD boards.
+ */
+
+// Header Guards
+#ifndef SRC_LOGGERSDSPIDMA_H_
+#define SRC_LOGGERSDSPIDMA_H_
+
+// Debugging Statement
+// #define MS_LOGGERSDSPIDMA_DEBUG
+
+#ifdef MS_LOGGERSDSPIDMA_DEBUG
+#define MS_DEBUGGING_STD "LoggerSdSpiDMA"
+#endif
+
+/**
+ * @brief The fewest bytes in one transfer that are moved with DMA; shorter
+ * transfers, like commands and responses, cost less from the processor.
+ */
+#ifndef MS_SD_DMA_MIN_BYTES
+#define MS_SD_DMA_MIN_BYTES 32
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+#include <SPI.h>
+#include <SdFat.h>
+
+#if SPI_DRIVER_SELECT != 3
+#error MS_LOGGER_SD_DMA needs SdFat built with SPI_DRIVER_SELECT=3
+#endif
+
+
+/**
+ * @brief A LoggerSdSpiDMA is an SdFat SPI driver that sends and receives the
+ * data blocks of an SD card through the DMA transfer of the SAMD SPI class
+ * (#MS_LOGGER_SD_DMA).
+ *
+ * The processor doesn't have to feed the SPI data register a byte at a time,
+ * so the bus runs back to back at the full clock rate for each 512 byte
+ * sector.  Short transfers still go through the usual byte transfers.
+ *
+ * This needs Adafruit's SAMD core, or one built on it, whose SPIClass has the
+ * DMA `transfer(txbuf, rxbuf, count, block)`.
+ *
+ * @ingroup base_classes
+ */
+class LoggerSdSpiDMA : public SdSpiBaseClass {
+ public:
+    /**
+     * @brief Construct a new LoggerSdSpiDMA object.
+     *
+     * @param theSPI The SPI bus the SD card is on; optional with a default
+     * value of SPI.
+     */
+    explicit LoggerSdSpiDMA(SPIClass* theSPI = &SPI);
+
+    void    activate() override;
+    void    begin(SdSpiConfig config) override;
+    void    deactivate() override;
+    void    end() override;
+    uint8_t receive() override;
+    uint8_t receive(uint8_t* buf, size_t count) override;
+    void    send(uint8_t data) override;
+    void    send(const uint8_t* buf, size_t count) override;
+    void    setSckSpeed(uint32_t maxSck) override;
+
+ private:
+    SPIClass*   _spi;
+    SPISettings _settings;
+};
+
+#endif  // SRC_LOGGERSDSPIDMA_H_
@@ -0,0 +1,78 @@
+/**
+ * @file LoggerSectorWriter.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the LoggerSectorWriter class.
+ */
+
+#include "LoggerSectorWriter.h"
+
+
+LoggerSectorWriter::LoggerSectorWriter() {}
+LoggerSectorWriter::~LoggerSectorWriter() {}
+
+
+void LoggerSectorWriter::begin(File* file) {
+    _file     = file;
+    _used     = 0;
+    _unsynced = false;
+    _failed   = false;
+}
+
+
+size_t LoggerSectorWriter::write(uint8_t c) {
+    return write(&c, 1);
+}
+size_t LoggerSectorWriter::write(const uint8_t* buffer, size_t size) {
+    if (_file == nullptr) { return 0; }
+    size_t taken = 0;
+    while (taken < size) {
+        if (_used == sizeof(_buffer) && !writeSectors()) { return taken; }
+        size_t chunk = sizeof(_buffer) - _used;
+        if (chunk > size - taken) { chunk = size - taken; }
+        memcpy(_buffer + _used, buffer + taken, chunk);
+        _used += chunk;
+        taken += chunk;
+    }
+    return taken;
+}
+
+
+bool LoggerSectorWriter::writeSectors(void) {
+    if (_file == nullptr || _used == 0) { return true; }
+    // Finish the file's last sector first, so the rest starts on a boundary
+    uint16_t head = (MS_SD_SECTOR_SIZE -
+                     _file->curPosition() % MS_SD_SECTOR_SIZE) %
+        MS_SD_SECTOR_SIZE;
+    if (_used < head) { return true; }
+    uint16_t whole = (_used - head) / MS_SD_SECTOR_SIZE * MS_SD_SECTOR_SIZE;
+    if (head + whole == 0) { return true; }
+    MS_DBG(F("Writing"), head + whole, F("bytes in"),
+           whole / MS_SD_SECTOR_SIZE, F("whole sectors"));
+    return writeOut(head + whole);
+}
+bool LoggerSectorWriter::writeAll(void) {
+    if (_file == nullptr || _used == 0) { return true; }
+    return writeOut(_used);
+}
+
+
+bool LoggerSectorWriter::takeUnsynced(void) {
+    bool unsynced = _unsynced;
+    _unsynced     = false;
+    return unsynced;
+}
+
+
+bool LoggerSectorWriter::writeOut(uint16_t length) {
+    size_t written = _file->write(_buffer, length);
+    if (written > length) { written = 0; }
+    if (written > 0) { _unsynced = true; }
+    // Keep whatever wasn't written, to try again
+    _used -= written;
+    memmove(_buffer, _buffer + written, _used);
+    if (written != length) { _failed = true; }
+    return written == length;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file LoggerSectorWriter.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the LoggerSectorWriter class, which gathers what's appended
+ * to the log file into whole SD card sectors.
+ */
+
+// Header Guards
+#ifndef SRC_LOGGERSECTORWRITER_H_
+#define SRC_LOGGERSECTORWRITER_H_
+
+// Debugging Statement
+// #define MS_LOGGERSECTORWRITER_DEBUG
+
+#ifdef MS_LOGGERSECTORWRITER_DEBUG
+#define MS_DEBUGGING_STD "LoggerSectorWriter"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+#include <SdFat.h>
+
+#ifndef MS_SECTOR_WRITER_SECTORS
+/**
+ * @brief The number of 512 byte sectors the sector writer gathers before
+ * writing them to the card together.
+ *
+ * SdFat only writes several sectors with one multi-block command when it's
+ * given at least two whole sectors at once.
+ */
+#define MS_SECTOR_WRITER_SECTORS 2
+#endif
+
+/**
+ * @brief The size of one SD card sector.
+ */
+#define MS_SD_SECTOR_SIZE 512
+
+
+/**
+ * @brief A LoggerSectorWriter holds what's appended to an open file until it
+ * has whole sectors of it, and then writes all of them to the card together
+ * (#MS_LOGGER_SECTOR_WRITER).
+ *
+ * The first write after the file is opened only fills the file's last sector;
+ * every write after that starts on a sector boundary.  A write of two or more
+ * sectors to a file preallocated by #MS_LOGGER_PERSISTENT_SD goes past the
+ * SdFat sector cache to the card in one multi-block command, and the file
+ * only needs to be synced once for the whole batch.  Less than a sector is
+ * kept back until the file is closed.
+ *
+ * @ingroup base_classes
+ */
+class LoggerSectorWriter : public Stream {
+ public:
+    /**
+     * @brief Construct a new LoggerSectorWriter object with no file.
+     */
+    LoggerSectorWriter();
+    /**
+     * @brief Destroy the LoggerSectorWriter object - no action taken.
+     */
+    ~LoggerSectorWriter();
+
+    /**
+     * @brief Start appending to a file.
+     *
+     * Anything still held for the last file must be written with writeAll()
+     * before this is called.
+     *
+     * @param file The open file
+     */
+    void begin(File* file);
+
+    /**
+     * @brief Append one byte.
+     *
+     * @param c The byte
+     * @return **size_t** 1 if it was kept or written, 0 if the card failed.
+     */
+    size_t write(uint8_t c) override;
+    /**
+     * @brief Append some bytes.
+     *
+     * @param buffer The bytes
+     * @param size The number of bytes
+     * @return **size_t** The number of bytes kept or written.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Write every whole sector held.
+     *
+     * @return **bool** True if nothing failed.
+     */
+    bool writeSectors(void);
+    /**
+     * @brief Write everything held, including the part of a sector at the end.
+     *
+     * @return **bool** True if nothing failed.
+     */
+    bool writeAll(void);
+    /**
+     * @brief Check if anything was written to the card since the last call.
+     *
+     * @return **bool** True if the file needs a sync.
+     */
+    bool takeUnsynced(void);
+    /**
+     * @brief Check if a write to the card failed since begin().
+     *
+     * @return **bool** True if some of what was appended was lost.
+     */
+    bool hasFailed(void) {
+        return _failed;
+    }
+    /**
+     * @brief Get the number of bytes held back from the card.
+     *
+     * @return **uint16_t** The number of bytes.
+     */
+    uint16_t getPending(void) {
+        return _used;
+    }
+
+    /**
+     * @brief The sector writer can't be read.
+     *
+     * @return **int** 0
+     */
+    int available(void) override {
+        return 0;
+    }
+    /**
+     * @brief The sector writer can't be read.
+     *
+     * @return **int** -1
+     */
+    int read(void) override {
+        return -1;
+    }
+    /**
+     * @brief The sector writer can't be read.
+     *
+     * @return **int** -1
+     */
+    int peek(void) override {
+        return -1;
+    }
+
+ private:
+    /**
+     * @brief Write the first bytes held to the file and keep the rest.
+     *
+     * @param length The number of bytes to write
+     * @return **bool** True if they were all written.
+     */
+    bool writeOut(uint16_t length);
+
+    File*    _file = nullptr;
+    uint8_t  _buffer[MS_SECTOR_WRITER_SECTORS * MS_SD_SECTOR_SIZE];
+    uint16_t _used     = 0;
+    bool     _unsynced = false;
+    bool     _failed   = false;
+};
+
+#endif  // SRC_LOGGERSECTORWRITER_H_
@@ -30,7 +30,352 @@
 #endif
 #endif  // ifndef STANDARD_SERIAL_OUTPUT
 
+/**
+ * @def MS_NONBLOCKING_OUTPUT
+ * @brief Define this build flag to never wait on the serial port for any
+ * printouts or debugging output.
+ *
+ * Text is only put into the serial port's own transmit buffer, which is
+ * emptied by the UART interrupt; whatever doesn't fit is dropped.  If the port
+ * says nothing is attached - ie, a SAMD native USB port with no terminal open
+ * - nothing is written at all.  This keeps a field logger with nobody
+ * listening from spending time pushing text out at 115200 baud.
+ *
+ * @note Output is lost whenever it comes faster than the port can send it, so
+ * this isn't useful when actually debugging.  The transmit buffer size is set
+ * by the core, ie, SERIAL_TX_BUFFER_SIZE on AVR.
+ */
+// #define MS_NONBLOCKING_OUTPUT
+
+#ifdef MS_NONBLOCKING_OUTPUT
+/**
+ * @brief A Print that only writes what fits in a serial port's transmit
+ * buffer without waiting and drops the rest.
+ *
+ * @tparam SerialType The type of the serial port
+ */
+template <typename SerialType>
+class NonBlockingOutput : public Print {
+ public:
+    /**
+     * @brief Construct a new NonBlockingOutput object.
+     *
+     * @param port The serial port to write to
+     */
+    explicit NonBlockingOutput(SerialType& port) : _port(port) {}
+
+    /**
+     * @brief Write a single byte if there's room for it.
+     *
+     * @param c The byte to write
+     * @return **size_t** Always 1, so printing carries on.
+     */
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+    /**
+     * @brief Write as much of a buffer as there is room for.
+     *
+     * @param buffer The bytes to write
+     * @param size The number of bytes to write
+     * @return **size_t** Always the full size, so printing carries on.
+     */
+    size_t write(const uint8_t* buffer, size_t size) override {
+        // Don't write anything if nobody is listening
+        if (!_port) { return size; }
+        int room = _port.availableForWrite();
+        if (room < 0) { room = 0; }
+        size_t fits = size < static_cast<size_t>(room) ? size : room;
+        if (fits > 0) { _port.write(buffer, fits); }
+        _dropped += size - fits;
+        return size;
+    }
+    using Print::write;
+
+    /**
+     * @brief Get the number of bytes dropped because they didn't fit
+     *
+     * @return **uint32_t** The number of bytes dropped since the program
+     * started.
+     */
+    uint32_t getDroppedCount(void) {
+        return _dropped;
+    }
+
+ private:
+    SerialType& _port;
+    uint32_t    _dropped = 0;
+};
+#endif
+
+/**
+ * @def MS_DEBUG_TOKENIZED
+ * @brief Define this build flag to have MS_DBG and MS_DEEP_DBG put compact
+ * binary records into a ring buffer in RAM instead of printing text.
+ *
+ * Each record is a marker byte, the processor millis, and then each argument:
+ * text marked with F() is written as just its address in flash, numbers are
+ * written as their raw bytes, and anything else is printed into the record as
+ * text.  So a debug line costs a few bytes copied into RAM instead of tens of
+ * characters pushed out of the serial port, and a debug build keeps close to
+ * the timing of a field build.  The buffer holds the last #MS_TOKEN_LOG_SIZE
+ * bytes.  It's written out as raw bytes with TokenLog::dump() - the logger does
+ * it to the debugging port each time it goes to sleep, and whenever the buffer
+ * is three quarters full so that a busy wake doesn't write over its oldest
+ * records - and turned back into text on a computer with
+ * extras/debug_token_decoder/decode_debug_tokens.py, which looks each address
+ * up in the program's ELF file.  PRINTOUT is still printed as text.
+ */
+// #define MS_DEBUG_TOKENIZED
+
+#ifdef MS_DEBUG_TOKENIZED
+#ifndef MS_TOKEN_LOG_SIZE
+/**
+ * @brief The size of the ring buffer of tokenized debugging records, in bytes
+ * (#MS_DEBUG_TOKENIZED).
+ */
+#define MS_TOKEN_LOG_SIZE 512
+#endif
+
+/**
+ * @brief The first byte of every tokenized debugging record.
+ */
+#define MS_TOKEN_FRAME_MARKER 0xD5
+
+/**
+ * @brief The ring buffer of tokenized debugging records (#MS_DEBUG_TOKENIZED).
+ *
+ * Once it's full each new byte writes over the oldest, so the oldest record
+ * left may be cut off at the front; the decoder skips it.  If it's been given
+ * an output with setOutput(), it's dumped there before a record is started
+ * once it's three quarters full, so records are only lost if nothing is
+ * listening.
+ */
+class TokenLog : public Print {
+ public:
+    /**
+     * @brief Add a byte, writing over the oldest if the buffer is full.
+     *
+     * @param c The byte
+     * @return **size_t** Always 1.
+     */
+    size_t write(uint8_t c) override {
+        _buffer[_next] = c;
+        _next          = (_next + 1) % MS_TOKEN_LOG_SIZE;
+        if (_count < MS_TOKEN_LOG_SIZE) {
+            _count++;
+        } else {
+            _overwritten++;
+        }
+        return 1;
+    }
+    using Print::write;
+
+    /**
+     * @brief Start a record.
+     *
+     * @param module The text in flash naming the module it's from
+     */
+    void startRecord(const void* module) {
+        if (_output != nullptr &&
+            _count > MS_TOKEN_LOG_SIZE - MS_TOKEN_LOG_SIZE / 4) {
+            dump(*_output);
+        }
+        write(static_cast<uint8_t>(MS_TOKEN_FRAME_MARKER));
+        uint32_t now = millis();
+        write(reinterpret_cast<const uint8_t*>(&now), sizeof(now));
+        putToken(module);
+    }
+    /**
+     * @brief End a record.
+     */
+    void endRecord(void) {
+        write(static_cast<uint8_t>(0));
+    }
+    /**
+     * @brief Add text in flash as its address.
+     *
+     * @param text The text
+     */
+    void putToken(const void* text) {
+        uint32_t address = reinterpret_cast<uintptr_t>(text);
+        write('F');
+        write(reinterpret_cast<const uint8_t*>(&address), sizeof(address));
+    }
+    /**
+     * @brief Add a number as its raw bytes.
+     *
+     * @tparam T The type of the number
+     * @param type 'i' for a signed integer, 'u' for an unsigned one, or 'f'
+     * for a float
+     * @param value The number
+     */
+    template <typename T>
+    void putNumber(char type, T value) {
+        write(type);
+        write(static_cast<uint8_t>(sizeof(value)));
+        write(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+    }
+
+    /**
+     * @brief Write out everything in the buffer, the oldest first, and empty
+     * it.
+     *
+     * @param out The stream to write the raw bytes to
+     * @return **size_t** The number of bytes written.
+     */
+    size_t dump(Print& out) {
+        size_t   written = _count;
+        uint16_t oldest  = (_next + MS_TOKEN_LOG_SIZE - _count) %
+            MS_TOKEN_LOG_SIZE;
+        for (uint16_t i = 0; i < _count; i++) {
+            out.write(_buffer[(oldest + i) % MS_TOKEN_LOG_SIZE]);
+        }
+        _count = 0;
+        return written;
+    }
+    /**
+     * @brief Set where to dump the buffer when it's getting full.
+     *
+     * @param out The stream to write the raw bytes to; null to let the
+     * oldest records be written over instead
+     */
+    void setOutput(Print* out) {
+        _output = out;
+    }
+    /**
+     * @brief Get the number of bytes written over before they were dumped.
+     *
+     * @return **uint32_t** The number of bytes lost since the program
+     * started.
+     */
+    uint32_t getOverwrittenCount(void) {
+        return _overwritten;
+    }
+
+ private:
+    uint8_t  _buffer[MS_TOKEN_LOG_SIZE];
+    uint16_t _next        = 0;
+    uint16_t _count       = 0;
+    uint32_t _overwritten = 0;
+    Print*   _output      = nullptr;
+};
+
+/**
+ * @brief Get the one shared ring buffer of tokenized debugging records.
+ *
+ * @return **TokenLog&** The token log.
+ */
+inline TokenLog& msTokenLog() {
+    static TokenLog log;
+    return log;
+}
+
+/**
+ * @brief Add the type of a number and its raw bytes to the token log.
+ */
+#define MS_TOKEN_NUMBER(type, tag) \
+    inline void msTokenArg(type value) { msTokenLog().putNumber(tag, value); }
+MS_TOKEN_NUMBER(signed char, 'i')
+MS_TOKEN_NUMBER(unsigned char, 'u')
+MS_TOKEN_NUMBER(short, 'i')
+MS_TOKEN_NUMBER(unsigned short, 'u')
+MS_TOKEN_NUMBER(int, 'i')
+MS_TOKEN_NUMBER(unsigned int, 'u')
+MS_TOKEN_NUMBER(long, 'i')
+MS_TOKEN_NUMBER(unsigned long, 'u')
+MS_TOKEN_NUMBER(bool, 'u')
+MS_TOKEN_NUMBER(float, 'f')
+#undef MS_TOKEN_NUMBER
+/**
+ * @brief Add a double to the token log as a float.
+ *
+ * @param value The number
+ */
+inline void msTokenArg(double value) {
+    msTokenLog().putNumber('f', static_cast<float>(value));
+}
+/**
+ * @brief Add a character to the token log.
+ *
+ * @param value The character
+ */
+inline void msTokenArg(char value) {
+    msTokenLog().write('c');
+    msTokenLog().write(static_cast<uint8_t>(value));
+}
+/**
+ * @brief Add text in flash to the token log as its address.
+ *
+ * @param text The text
+ */
+inline void msTokenArg(const __FlashStringHelper* text) {
+    msTokenLog().putToken(text);
+}
+/**
+ * @brief Add text in RAM to the token log; it could change, so it's copied.
+ *
+ * @param text The text
+ */
+inline void msTokenArg(const char* text) {
+    msTokenLog().write('T');
+    msTokenLog().print(text);
+    msTokenLog().write(static_cast<uint8_t>(0));
+}
+/**
+ * @brief Add anything else that can be printed to the token log as text.
+ *
+ * @tparam T Any type that can be printed
+ * @param value The value
+ */
+template <typename T>
+void msTokenArg(const T& value) {
+    msTokenLog().write('T');
+    msTokenLog().print(value);
+    msTokenLog().write(static_cast<uint8_t>(0));
+}
+/**
+ * @brief Add the arguments of a debugging record to the token log - the
+ * end of the list.
+ */
+inline void msTokenArgs(void) {}
+/**
+ * @brief Add the arguments of a debugging record to the token log.
+ *
+ * @tparam T Any type that can be printed
+ * @tparam Args Any type that can be printed
+ * @param head The first argument
+ * @param tail The rest of the arguments
+ */
+template <typename T, typename... Args>
+void msTokenArgs(T head, Args... tail) {
+    msTokenArg(head);
+    msTokenArgs(tail...);
+}
+#endif  // MS_DEBUG_TOKENIZED
+
 #ifdef STANDARD_SERIAL_OUTPUT
+#ifdef MS_NONBLOCKING_OUTPUT
+/**
+ * @brief Get the non-blocking version of #STANDARD_SERIAL_OUTPUT
+ *
+ * @return **NonBlockingOutput&** The one shared non-blocking output.
+ */
+inline NonBlockingOutput<decltype(STANDARD_SERIAL_OUTPUT)>& msStandardOutput() {
+    static NonBlockingOutput<decltype(STANDARD_SERIAL_OUTPUT)> out(
+        STANDARD_SERIAL_OUTPUT);
+    return out;
+}
+/**
+ * @brief The output that PRINTOUT writes to
+ */
+#define MS_PRINTOUT_PORT msStandardOutput()
+#else
+/**
+ * @brief The output that PRINTOUT writes to
+ */
+#define MS_PRINTOUT_PORT STANDARD_SERIAL_OUTPUT
+#endif
 // namespace {
 /**
  * @brief Prints text to the "debugging" serial port.  This is intended for text
@@ -41,7 +386,7 @@
  */
 template <typename T>
 static void PRINTOUT(T last) {
-    STANDARD_SERIAL_OUTPUT.println(last);
+    MS_PRINTOUT_PORT.println(last);
 }
 
 /**
@@ -55,8 +400,8 @@ static void PRINTOUT(T last) {
  */
 template <typename T, typename... Args>
 static void PRINTOUT(T head, Args... tail) {
-    STANDARD_SERIAL_OUTPUT.print(head);
-    STANDARD_SERIAL_OUTPUT.print(' ');
+    MS_PRINTOUT_PORT.print(head);
+    MS_PRINTOUT_PORT.print(' ');
     PRINTOUT(tail...);
 }
 // }  // namespace
@@ -74,6 +419,48 @@ static void PRINTOUT(T head, Args... tail) {
 #endif  // ifndef DEBUGGING_SERIAL_OUTPUT
 
 #if defined(DEBUGGING_SERIAL_OUTPUT) && defined(MS_DEBUGGING_STD)
+#ifndef MS_DEBUG_PORT
+#ifdef MS_NONBLOCKING_OUTPUT
+/**
+ * @brief Get the non-blocking version of #DEBUGGING_SERIAL_OUTPUT
+ *
+ * @return **NonBlockingOutput&** The one shared non-blocking output.
+ */
+inline NonBlockingOutput<decltype(DEBUGGING_SERIAL_OUTPUT)>& msDebugOutput() {
+    static NonBlockingOutput<decltype(DEBUGGING_SERIAL_OUTPUT)> out(
+        DEBUGGING_SERIAL_OUTPUT);
+    return out;
+}
+/**
+ * @brief The output that MS_DBG writes to
+ */
+#define MS_DEBUG_PORT msDebugOutput()
+#else
+/**
+ * @brief The output that MS_DBG writes to
+ */
+#define MS_DEBUG_PORT DEBUGGING_SERIAL_OUTPUT
+#endif
+#endif
+#ifdef MS_DEBUG_TOKENIZED
+/**
+ * @brief The name of the module, in flash, for its tokenized records.
+ */
+static const char ms_debug_module[] PROGMEM = MS_DEBUGGING_STD;
+/**
+ * @brief Puts a record in the token log (#MS_DEBUG_TOKENIZED).  This is
+ * intended for debugging the code of a specific module.
+ *
+ * @tparam Args Any type that can be printed
+ * @param args The text to record
+ */
+template <typename... Args>
+static void MS_DBG(Args... args) {
+    msTokenLog().startRecord(ms_debug_module);
+    msTokenArgs(args...);
+    msTokenLog().endRecord();
+}
+#else
 // namespace {
 /**
  * @brief Prints text to the "debugging" serial port.  This is intended for
@@ -87,9 +474,9 @@ static void PRINTOUT(T head, Args... tail) {
  */
 template <typename T>
 static void MS_DBG(T last) {
-    DEBUGGING_SERIAL_OUTPUT.print(last);
-    DEBUGGING_SERIAL_OUTPUT.print(" <--");
-    DEBUGGING_SERIAL_OUTPUT.println(MS_DEBUGGING_STD);
+    MS_DEBUG_PORT.print(last);
+    MS_DEBUG_PORT.print(" <--");
+    MS_DEBUG_PORT.println(MS_DEBUGGING_STD);
 }
 
 /**
@@ -106,11 +493,12 @@ static void MS_DBG(T last) {
  */
 template <typename T, typename... Args>
 static void MS_DBG(T head, Args... tail) {
-    DEBUGGING_SERIAL_OUTPUT.print(head);
-    DEBUGGING_SERIAL_OUTPUT.print(' ');
+    MS_DEBUG_PORT.print(head);
+    MS_DEBUG_PORT.print(' ');
     MS_DBG(tail...);
 }
 // }  // namespace
+#endif  // MS_DEBUG_TOKENIZED
 /**
  * @brief Initializes a variable called start with the current processor millis.
  *
@@ -172,6 +560,51 @@ static void MS_DBG(T head, Args... tail) {
 #endif  // ifndef DEEP_DEBUGGING_SERIAL_OUTPUT
 
 #if defined(DEEP_DEBUGGING_SERIAL_OUTPUT) && defined(MS_DEBUGGING_DEEP)
+#ifndef MS_DEEP_DEBUG_PORT
+#ifdef MS_NONBLOCKING_OUTPUT
+/**
+ * @brief Get the non-blocking version of #DEEP_DEBUGGING_SERIAL_OUTPUT
+ *
+ * @return **NonBlockingOutput&** The one shared non-blocking output.
+ */
+inline NonBlockingOutput<decltype(DEEP_DEBUGGING_SERIAL_OUTPUT)>&
+msDeepDebugOutput() {
+    static NonBlockingOutput<decltype(DEEP_DEBUGGING_SERIAL_OUTPUT)> out(
+        DEEP_DEBUGGING_SERIAL_OUTPUT);
+    return out;
+}
+/**
+ * @brief The output that MS_DEEP_DBG writes to
+ */
+#define MS_DEEP_DEBUG_PORT msDeepDebugOutput()
+#else
+/**
+ * @brief The output that MS_DEEP_DBG writes to
+ */
+#define MS_DEEP_DEBUG_PORT DEEP_DEBUGGING_SERIAL_OUTPUT
+#endif
+#endif
+#ifdef MS_DEBUG_TOKENIZED
+/**
+ * @brief The name of the module, in flash, for its tokenized deep debugging
+ * records.
+ */
+static const char ms_deep_debug_module[] PROGMEM = MS_DEBUGGING_DEEP;
+/**
+ * @brief Puts a record in the token log (#MS_DEBUG_TOKENIZED).  This is
+ * intended for printouts considered to be excessive during "normal"
+ * debugging.
+ *
+ * @tparam Args Any type that can be printed
+ * @param args The text to record
+ */
+template <typename... Args>
+static void MS_DEEP_DBG(Args... args) {
+    msTokenLog().startRecord(ms_deep_debug_module);
+    msTokenArgs(args...);
+    msTokenLog().endRecord();
+}
+#else
 // namespace {
 /**
  * @brief Prints text to the "debugging" serial port.  This is intended for
@@ -185,9 +618,9 @@ static void MS_DBG(T head, Args... tail) {
  */
 template <typename T>
 static void MS_DEEP_DBG(T last) {
-    DEEP_DEBUGGING_SERIAL_OUTPUT.print(last);
-    DEEP_DEBUGGING_SERIAL_OUTPUT.print(" <--");
-    DEEP_DEBUGGING_SERIAL_OUTPUT.println(MS_DEBUGGING_DEEP);
+    MS_DEEP_DEBUG_PORT.print(last);
+    MS_DEEP_DEBUG_PORT.print(" <--");
+    MS_DEEP_DEBUG_PORT.println(MS_DEBUGGING_DEEP);
 }
 /**
  * @brief Prints text to the "debugging" serial port.  This is intended for
@@ -203,11 +636,12 @@ static void MS_DEEP_DBG(T last) {
  */
 template <typename T, typename... Args>
 static void MS_DEEP_DBG(T head, Args... tail) {
-    DEEP_DEBUGGING_SERIAL_OUTPUT.print(head);
-    DEEP_DEBUGGING_SERIAL_OUTPUT.print(' ');
+    MS_DEEP_DEBUG_PORT.print(head);
+    MS_DEEP_DEBUG_PORT.print(' ');
     MS_DEEP_DBG(tail...);
 }
 // }  // namespace
+#endif  // MS_DEBUG_TOKENIZED
 #else
 /**
  * @brief Prints text to the "debugging" serial port.  This is intended for
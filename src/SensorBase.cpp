@@ -10,11 +10,41 @@
 
 #include "SensorBase.h"
 #include "VariableBase.h"
+#include "ClockScaler.h"
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+#include <Wire.h>
+#endif
+#ifdef MS_SENSOR_DATA_READY
+#define LIBCALL_ENABLEINTERRUPT
+#include "ModSensorInterrupts.h"
+#endif
 
 // ============================================================================
 //  The class and functions for interfacing with a sensor
 // ============================================================================
 
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+// The shared result pool.  These are plain arrays and counters so they're
+// zero-initialized before any of the sensors in the global scope are
+// constructed.
+static float     resultValuePool[MS_SENSOR_RESULT_POOL_SIZE];
+static measurementCount_t resultCountPool[MS_SENSOR_RESULT_POOL_SIZE];
+static Variable* resultVariablePool[MS_SENSOR_RESULT_POOL_SIZE];
+static uint16_t  resultPoolUsed = 0;
+// Stand-in storage shared by any sensors that didn't fit in the pool, so they
+// can't write over anything else
+static float     overflowValues[MAX_NUMBER_VARS];
+static measurementCount_t overflowCounts[MAX_NUMBER_VARS];
+static Variable* overflowVariables[MAX_NUMBER_VARS];
+#endif
+#ifdef MS_LOGGER_POWER_POLICY
+// The limits of the low battery profile the logger is in
+static measurementCount_t averagingLimit = 0;
+#ifdef MS_SENSOR_DECIMATION
+static uint8_t decimationFactor = 1;
+#endif
+#endif
+
 // The constructor
 Sensor::Sensor(const char* sensorName, const uint8_t totalReturnedValues,
                uint32_t warmUpTime_ms, uint32_t stabilizationTime_ms,
@@ -29,17 +59,54 @@ Sensor::Sensor(const char* sensorName, const uint8_t totalReturnedValues,
       _warmUpTime_ms(warmUpTime_ms),
       _stabilizationTime_ms(stabilizationTime_ms),
       _measurementTime_ms(measurementTime_ms) {
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    takeResultStorage();
+    uint8_t nSlots = _resultPoolOverflow ? MAX_NUMBER_VARS
+                                         : _numReturnedValues;
+#else
+    uint8_t nSlots = MAX_NUMBER_VARS;
+#endif
     // Clear arrays
-    for (uint8_t i = 0; i < MAX_NUMBER_VARS; i++) {
+    for (uint8_t i = 0; i < nSlots; i++) {
         variables[i]                  = nullptr;
         sensorValues[i]               = -9999;
         numberGoodMeasurementsMade[i] = 0;
     }
+#ifdef MS_CHECK_SENSOR_TIMING
+    resetPhaseTimes();
+#endif
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    setAdaptiveTiming(false);
+#endif
 }
 // Destructor
 Sensor::~Sensor() {}
 
 
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+// Hand out the next slice of the result pool.  Sensors are expected to live
+// for the whole program, so the pool is never given back.
+void Sensor::takeResultStorage(void) {
+    uint16_t start = resultPoolUsed;
+    resultPoolUsed += _numReturnedValues;
+    _resultPoolOverflow = resultPoolUsed > MS_SENSOR_RESULT_POOL_SIZE ||
+        _numReturnedValues > MAX_NUMBER_VARS;
+    if (_resultPoolOverflow) {
+        sensorValues               = overflowValues;
+        numberGoodMeasurementsMade = overflowCounts;
+        variables                  = overflowVariables;
+    } else {
+        sensorValues               = &resultValuePool[start];
+        numberGoodMeasurementsMade = &resultCountPool[start];
+        variables                  = &resultVariablePool[start];
+    }
+}
+uint16_t Sensor::getResultPoolUsed(void) {
+    return resultPoolUsed;
+}
+#endif
+
+
 // This gets the place the sensor is installed ON THE MAYFLY (ie, pin number)
 String Sensor::getSensorLocation(void) {
     String senseLoc = F("Pin");
@@ -52,12 +119,25 @@ String Sensor::getSensorLocation(void) {
 String Sensor::getSensorName(void) {
     return _sensorName;
 }
+const char* Sensor::getSensorNameChars(void) {
+    return _sensorName;
+}
 
 
 // This concatentates and returns the name and location.
+#ifdef MS_SENSOR_LOCATION_CACHE
+const char* Sensor::getSensorNameAndLocation(void) {
+    if (_nameAndLocation[0] == '\0') {
+        snprintf(_nameAndLocation, sizeof(_nameAndLocation), "%s at %s",
+                 _sensorName, getSensorLocation().c_str());
+    }
+    return _nameAndLocation;
+}
+#else
 String Sensor::getSensorNameAndLocation(void) {
     return getSensorName() + " at " + getSensorLocation();
 }
+#endif
 
 
 // This returns the number of the power pin
@@ -68,12 +148,205 @@ int8_t Sensor::getPowerPin(void) {
 
 // These functions get and set the number of readings to average for a sensor
 // Generally these values should be set in the constructor
-void Sensor::setNumberMeasurementsToAverage(uint8_t nReadings) {
+void Sensor::setNumberMeasurementsToAverage(measurementCount_t nReadings) {
     _measurementsToAverage = nReadings;
 }
-uint8_t Sensor::getNumberMeasurementsToAverage(void) {
+measurementCount_t Sensor::getNumberMeasurementsToAverage(void) {
+#ifdef MS_LOGGER_POWER_POLICY
+    if (averagingLimit > 0 && _measurementsToAverage > averagingLimit) {
+        return averagingLimit;
+    }
+#endif
     return _measurementsToAverage;
 }
+#ifdef MS_LOGGER_POWER_POLICY
+void Sensor::setAveragingLimit(measurementCount_t maxAverages) {
+    averagingLimit = maxAverages;
+}
+#ifdef MS_SENSOR_DECIMATION
+void Sensor::setDecimationFactor(uint8_t factor) {
+    decimationFactor = factor > 0 ? factor : 1;
+}
+#endif
+#endif
+
+
+#ifdef MS_STAGGER_POWER_UP
+void Sensor::setStartupCurrent(uint16_t startupCurrent_mA) {
+    _startupCurrent_mA = startupCurrent_mA;
+}
+uint16_t Sensor::getStartupCurrent(void) {
+    return _startupCurrent_mA;
+}
+#endif
+
+
+#ifdef MS_SENSOR_STANDBY
+void Sensor::setStandbyPolicy(sensorStandby policy) {
+    _standbyPolicy = policy;
+    _standbyInUse  = policy == STANDBY_AUTO ? STANDBY_POWER_CYCLE : policy;
+}
+sensorStandby Sensor::getStandbyPolicy(void) {
+    return _standbyInUse;
+}
+void Sensor::setStandbyCosts(uint16_t active_mA, uint16_t sleep_mA,
+                             uint32_t sleepReady_ms) {
+    _activeCurrent_mA = active_mA;
+    _sleepCurrent_mA  = sleep_mA;
+    _sleepReady_ms    = sleepReady_ms;
+}
+
+
+float Sensor::getStandbyCost(sensorStandby policy, uint32_t interval_ms) {
+    uint32_t measuring_ms = _measurementTime_ms *
+        getNumberMeasurementsToAverage();
+    uint32_t powered_ms;
+    switch (policy) {
+        case STANDBY_POWER_CYCLE:
+            powered_ms = _warmUpTime_ms + _stabilizationTime_ms + measuring_ms;
+            return static_cast<float>(_activeCurrent_mA) * powered_ms / 1000;
+        case STANDBY_SLEEP: {
+            if (_sleepReady_ms == 0xFFFFFFFF) { return -9999; }
+            powered_ms = _sleepReady_ms + measuring_ms;
+            uint32_t asleep_ms = interval_ms > powered_ms
+                ? interval_ms - powered_ms
+                : 0;
+            return (static_cast<float>(_activeCurrent_mA) * powered_ms +
+                    static_cast<float>(_sleepCurrent_mA) * asleep_ms) /
+                1000;
+        }
+        case STANDBY_STAY_ON:
+            return static_cast<float>(_activeCurrent_mA) * interval_ms / 1000;
+        default: return -9999;
+    }
+}
+
+
+void Sensor::chooseStandby(uint32_t interval_ms) {
+    if (_standbyPolicy != STANDBY_AUTO || _activeCurrent_mA == 0) { return; }
+    _standbyInUse = STANDBY_POWER_CYCLE;
+    float lowest  = getStandbyCost(STANDBY_POWER_CYCLE, interval_ms);
+    // An option has to be cheaper than the best so far, so ties keep the
+    // simpler one
+    for (uint8_t p = STANDBY_SLEEP; p <= STANDBY_STAY_ON; p++) {
+        float cost = getStandbyCost(static_cast<sensorStandby>(p),
+                                    interval_ms);
+        if (cost != -9999 && cost < lowest) {
+            lowest        = cost;
+            _standbyInUse = static_cast<sensorStandby>(p);
+        }
+    }
+    MS_DBG(getSensorNameAndLocation(), F("will use standby policy"),
+           _standbyInUse, F("costing"), lowest, F("mAs per interval"));
+}
+
+
+bool Sensor::standby(void) {
+    if (_standbyInUse == STANDBY_STAY_ON) {
+        MS_DBG(getSensorNameAndLocation(), F("is being left on"));
+        return true;
+    }
+    bool success = sleep();
+    if (_standbyInUse == STANDBY_SLEEP) { _sleptPowered = true; }
+    return success;
+}
+#endif
+
+
+#ifdef MS_SENSOR_DECIMATION
+void Sensor::setMeasureEvery(uint8_t nCycles, bool keepLastValue) {
+    _measureEvery  = nCycles > 0 ? nCycles : 1;
+    _keepLastValue = keepLastValue;
+    // Start counting again from the next update
+    _cyclesUntilDue = 0;
+}
+uint8_t Sensor::getMeasureEvery(void) {
+    return _measureEvery;
+}
+bool Sensor::getKeepLastValue(void) {
+#ifdef MS_SENSOR_QUARANTINE
+    // A quarantined sensor's last values are stale
+    if (_consecutiveFailures >= MS_QUARANTINE_FAILURES) return false;
+#endif
+    return _keepLastValue;
+}
+bool Sensor::checkDueThisCycle(void) {
+    if (_cyclesUntilDue > 0) {
+        _cyclesUntilDue--;
+        MS_DBG(getSensorNameAndLocation(), F("is skipped for"),
+               _cyclesUntilDue + 1, F("more update[s]"));
+        return false;
+    }
+    _cyclesUntilDue = _measureEvery - 1;
+#ifdef MS_LOGGER_POWER_POLICY
+    if (_measureEvery > 1) {
+        _cyclesUntilDue = _measureEvery * decimationFactor - 1;
+    }
+#endif
+    return true;
+}
+#endif
+
+
+#ifdef MS_SENSOR_QUARANTINE
+bool Sensor::checkQuarantine(void) {
+    if (_quarantineLeft == 0) return false;
+    _quarantineLeft--;
+    MS_DBG(getSensorNameAndLocation(), F("is quarantined for"),
+           _quarantineLeft + 1, F("more update[s]"));
+    return true;
+}
+void Sensor::recordUpdateHealth(void) {
+    for (uint8_t i = 0; i < _numReturnedValues; i++) {
+        if (sensorValues[i] != -9999) {
+            if (_consecutiveFailures >= MS_QUARANTINE_FAILURES) {
+                MS_DBG(getSensorNameAndLocation(),
+                       F("is responding again; ending its quarantine"));
+            }
+            _consecutiveFailures = 0;
+            return;
+        }
+    }
+    if (_failedUpdates < 0xFFFF) _failedUpdates++;
+    if (_consecutiveFailures < 0xFF) _consecutiveFailures++;
+    if (_consecutiveFailures < MS_QUARANTINE_FAILURES) return;
+    // Double the wait with each further failure: 1, 2, 4, ... updates
+    uint8_t  doublings = _consecutiveFailures - MS_QUARANTINE_FAILURES;
+    uint16_t skip      = MS_QUARANTINE_MAX_SKIP;
+    if (doublings < 16) skip = static_cast<uint16_t>(1) << doublings;
+    if (skip > MS_QUARANTINE_MAX_SKIP) skip = MS_QUARANTINE_MAX_SKIP;
+    _quarantineLeft = skip;
+    MS_DBG(getSensorNameAndLocation(), F("has failed"), _consecutiveFailures,
+           F("updates in a row; skipping it for"), _quarantineLeft,
+           F("update[s]"));
+}
+float Sensor::getHealthStatistic(sensorHealthStat stat) {
+    switch (stat) {
+        case SENSOR_HEALTH_CONSECUTIVE: return _consecutiveFailures;
+        case SENSOR_HEALTH_QUARANTINED: return _quarantineLeft;
+        case SENSOR_HEALTH_FAILURES:
+        default: return _failedUpdates;
+    }
+}
+void Sensor::resetHealth(void) {
+    _failedUpdates       = 0;
+    _consecutiveFailures = 0;
+    _quarantineLeft      = 0;
+}
+#endif
+
+
+#ifdef MS_SHARE_SENSOR_RESULTS
+bool Sensor::hasFreshResults(uint32_t cycleStart) {
+    // Results averaged after the update started aren't from another array
+    return _hasResults &&
+        static_cast<int32_t>(cycleStart - _resultsTakenAt) >= 0 &&
+        cycleStart - _resultsTakenAt < MS_SENSOR_RESULT_MAX_AGE_MS;
+}
+void Sensor::expireResults(void) {
+    _hasResults = false;
+}
+#endif
 
 
 // This returns the 8-bit code for the current status of the sensor.
@@ -92,6 +365,13 @@ uint8_t Sensor::getStatus(void) {
 
 // This turns on sensor power
 void Sensor::powerUp(void) {
+#ifdef MS_SENSOR_STANDBY
+    // A sensor kept powered between updates is already warmed up
+    if (_powerPin >= 0 && bitRead(_sensorStatus, 2) && _millisPowerOn != 0) {
+        MS_DBG(getSensorNameAndLocation(), F("was kept powered"));
+        return;
+    }
+#endif
     if (_powerPin >= 0) {
         MS_DBG(F("Powering"), getSensorNameAndLocation(), F("with pin"),
                _powerPin);
@@ -113,6 +393,10 @@ void Sensor::powerUp(void) {
 
 // This turns off sensor power
 void Sensor::powerDown(void) {
+#ifdef MS_SENSOR_DATA_READY
+    // The output floats once the sensor has no power
+    disarmDataReady();
+#endif
     if (_powerPin >= 0) {
         MS_DBG(F("Turning off power to"), getSensorNameAndLocation(),
                F("with pin"), _powerPin);
@@ -126,6 +410,9 @@ void Sensor::powerDown(void) {
         // Unset the status bits for sensor power (bits 1 & 2),
         // activation (bits 3 & 4), and measurement request (bits 5 & 6)
         _sensorStatus &= 0b10000001;
+#ifdef MS_SENSOR_STANDBY
+        _sleptPowered = false;
+#endif
     } else {
         MS_DBG(F("Power to"), getSensorNameAndLocation(),
                F("is not controlled by this library."));
@@ -150,6 +437,18 @@ bool Sensor::setup(void) {
     MS_DBG(_measurementsToAverage,
            F("individual measurements will be averaged for each reading."));
 
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    if (_resultPoolOverflow) {
+        PRINTOUT(F("There is no room in the result pool for"),
+                 getSensorNameAndLocation(), F("- increase"),
+                 F("MS_SENSOR_RESULT_POOL_SIZE to at least"),
+                 getResultPoolUsed());
+        // Set the status error bit (bit 7)
+        _sensorStatus |= 0b10000000;
+        return false;
+    }
+#endif
+
     if (_powerPin >= 0) pinMode(_powerPin, OUTPUT);  // NOTE:  Not setting value
     if (_dataPin >= 0)
         pinMode(_dataPin, INPUT);  // NOTE:  Not turning on pull-up!
@@ -213,6 +512,8 @@ bool Sensor::startSingleMeasurement(void) {
     }
 
     MS_DBG(F("Starting measurement on"), getSensorNameAndLocation());
+    _measurementExtension_ms = 0;
+    _measurementStep         = 0;
     // Set the status bits for measurement requested (bit 5)
     // Setting this bit even if we failed to start a measurement to show that an
     // attempt was made.
@@ -225,6 +526,9 @@ bool Sensor::startSingleMeasurement(void) {
         _millisMeasurementRequested = millis();
         // Set the status bit for measurement start success (bit 6)
         _sensorStatus |= 0b01000000;
+#ifdef MS_SENSOR_DATA_READY
+        armDataReady();
+#endif
     } else {
         // Otherwise, make sure that the measurement start time and success bit
         // (bit 6) are unset
@@ -239,6 +543,15 @@ bool Sensor::startSingleMeasurement(void) {
 
 
 void Sensor::registerVariable(int sensorVarNum, Variable* var) {
+    if (sensorVarNum < 0 || sensorVarNum >= _numReturnedValues) {
+        MS_DBG(F("Variable number"), sensorVarNum, F("is out of range for"),
+               getSensorNameAndLocation());
+        return;
+    }
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    // Don't notify variables through the shared overflow storage
+    if (_resultPoolOverflow) return;
+#endif
     variables[sensorVarNum] = var;
 }
 
@@ -252,7 +565,7 @@ void Sensor::notifyVariables(void) {
             // Bad things happen if try to update nullptr
             MS_DBG(F("Sending value update from"), getSensorNameAndLocation(),
                    F("to variable"), i, F("which is"),
-                   variables[i]->getVarName(), F("..."));
+                   variables[i]->getVarNameChars(), F("..."));
             variables[i]->onSensorUpdate(this);
         } else {
             MS_DBG(getSensorNameAndLocation(),
@@ -270,6 +583,18 @@ void Sensor::clearValues(void) {
         sensorValues[i]               = -9999;
         numberGoodMeasurementsMade[i] = 0;
     }
+#ifdef MS_SENSOR_BURST_STATS
+    memset(&_burstStats, 0, sizeof(_burstStats));
+    _burstTaken = 0;
+#endif
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+    _robustCount   = 0;
+    _robustSum     = 0;
+    _robustReduced = 0;
+#endif
+#ifdef MS_LOGGER_RESULT_TIMES
+    _lastResultAt = 0;
+#endif
 }
 
 
@@ -277,6 +602,38 @@ void Sensor::clearValues(void) {
 // averaged
 void Sensor::verifyAndAddMeasurementResult(uint8_t resultNumber,
                                            float   resultValue) {
+#ifdef MS_LOGGER_RESULT_TIMES
+    _lastResultAt = millis();
+#endif
+#ifdef MS_SENSOR_BURST_STATS
+    // Add good results to the running statistics with Welford's method
+    if (resultNumber == _burstResultNumber && resultValue != -9999) {
+        sensorBurstStats& stats = _burstStats;
+        if (stats.count == 0 || resultValue < stats.min) {
+            stats.min = resultValue;
+        }
+        if (stats.count == 0 || resultValue > stats.max) {
+            stats.max = resultValue;
+        }
+        stats.count++;
+        float delta = resultValue - stats.mean;
+        stats.mean += delta / stats.count;
+        stats.m2 += delta * (resultValue - stats.mean);
+    }
+#endif
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+    // Insert good results into the window in order
+    if (_robustMode != SENSOR_AVERAGE_MEAN &&
+        resultNumber == _robustResultNumber && resultValue != -9999) {
+        uint8_t j = _robustCount;
+        while (j > 0 && _robustWindow[j - 1] > resultValue) {
+            _robustWindow[j] = _robustWindow[j - 1];
+            j--;
+        }
+        _robustWindow[j] = resultValue;
+        if (++_robustCount == MS_ROBUST_WINDOW_SIZE) { reduceRobustWindow(); }
+    }
+#endif
     // If the new result is good and there was were only bad results, set the
     // result value as the new result and add 1 to the good result total
     if (sensorValues[resultNumber] == -9999 && resultValue != -9999) {
@@ -320,11 +677,27 @@ void Sensor::verifyAndAddMeasurementResult(uint8_t resultNumber,
 void Sensor::averageMeasurements(void) {
     MS_DBG(F("Averaging results from"), getSensorNameAndLocation(), F("over"),
            _measurementsToAverage, F("reading[s]"));
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+    if (_robustMode != SENSOR_AVERAGE_MEAN) { reduceRobustWindow(); }
+#endif
     for (uint8_t i = 0; i < _numReturnedValues; i++) {
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+        if (_robustMode != SENSOR_AVERAGE_MEAN && i == _robustResultNumber) {
+            if (_robustReduced > 0) {
+                sensorValues[i] = _robustSum / _robustReduced;
+            }
+            MS_DBG(F("    ->Result #"), i, F("(robust):"), sensorValues[i]);
+            continue;
+        }
+#endif
         if (numberGoodMeasurementsMade[i] > 0)
             sensorValues[i] /= numberGoodMeasurementsMade[i];
         MS_DBG(F("    ->Result #"), i, ':', sensorValues[i]);
     }
+#ifdef MS_SHARE_SENSOR_RESULTS
+    _hasResults     = true;
+    _resultsTakenAt = millis();
+#endif
 }
 
 
@@ -355,13 +728,18 @@ bool Sensor::update(void) {
     waitForStability();
 
     // loop through as many measurements as requested
-    for (uint8_t j = 0; j < _measurementsToAverage; j++) {
+    for (measurementCount_t j = 0; j < getNumberMeasurementsToAverage();
+         j++) {
         // start a measurement
         ret_val &= startSingleMeasurement();
         // wait for the measurement to finish
         waitForMeasurementCompletion();
         // get the measurement result
         ret_val &= addSingleMeasurementResult();
+#ifdef MS_SENSOR_BURST_STATS
+        // stop early if the mean is already good enough
+        if (hasEnoughMeasurements(j + 1)) break;
+#endif
     }
 
     averageMeasurements();
@@ -438,7 +816,21 @@ bool Sensor::isWarmedUp(bool debug) {
             MS_DBG(F("It's been"), elapsed_since_power_on, F("ms, and"),
                    getSensorNameAndLocation(), F("should be warmed up!"));
         }
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+        // If the sensor never confirmed it was ready, go back to the full time
+        if (_adaptiveWarmUp.confirmedFor != _millisPowerOn) {
+            _adaptiveWarmUp.estimate_ms = _warmUpTime_ms;
+        }
+#endif
+        return true;
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    } else if (checkReadyEarly(_adaptiveWarmUp, _millisPowerOn, true)) {
+        if (debug) {
+            MS_DBG(getSensorNameAndLocation(), F("confirmed it was warmed up"),
+                   F("after"), elapsed_since_power_on, F("ms"));
+        }
         return true;
+#endif
     } else {
         // If the sensor has power but the time hasn't passed, we still need to
         // wait
@@ -451,9 +843,11 @@ bool Sensor::isWarmedUp(bool debug) {
 // NOTE:  This is "blocking" - that is, nothing else can happen during this
 // wait.
 void Sensor::waitForWarmUp(void) {
+    MS_CLOCK_SLOW();
     while (!isWarmedUp()) {
         // wait
     }
+    MS_CLOCK_FAST();
 }
 
 
@@ -471,12 +865,27 @@ bool Sensor::isStable(bool debug) {
 
     uint32_t elapsed_since_wake_up = millis() - _millisSensorActivated;
     // If the sensor has been activated and enough time has elapsed, it's stable
-    if (elapsed_since_wake_up > _stabilizationTime_ms) {
+    if (elapsed_since_wake_up > stabilizationTime()) {
         if (debug) {
             MS_DBG(F("It's been"), elapsed_since_wake_up, F("ms, and"),
                    getSensorNameAndLocation(), F("should be stable!"));
         }
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+        // If the sensor never confirmed it was stable, go back to the full time
+        if (_adaptiveStabilization.confirmedFor != _millisSensorActivated) {
+            _adaptiveStabilization.estimate_ms = _stabilizationTime_ms;
+        }
+#endif
         return true;
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    } else if (checkReadyEarly(_adaptiveStabilization, _millisSensorActivated,
+                               false)) {
+        if (debug) {
+            MS_DBG(getSensorNameAndLocation(), F("confirmed it was stable"),
+                   F("after"), elapsed_since_wake_up, F("ms"));
+        }
+        return true;
+#endif
     } else {
         // If the sensor has been activated but the time hasn't passed, we still
         // need to wait
@@ -489,12 +898,60 @@ bool Sensor::isStable(bool debug) {
 // NOTE:  This is "blocking" - that is, nothing else can happen during this
 // wait.
 void Sensor::waitForStability(void) {
+    MS_CLOCK_SLOW();
     while (!isStable()) {
         // wait
     }
+    MS_CLOCK_FAST();
 }
 
 
+#ifdef MS_SENSOR_DATA_READY
+// The sensors with a data-ready pin, by their slot; the interrupt of each slot
+// only sets the flag of its sensor
+static Sensor* dataReadySensors[MS_DATA_READY_MAX_SENSORS];
+static uint8_t dataReadyCount = 0;
+
+template <uint8_t slot>
+void Sensor::dataReadyISR(void) {
+    dataReadySensors[slot]->_dataReady = true;
+}
+bool Sensor::setDataReadyPin(int8_t pin, uint8_t mode) {
+    disarmDataReady();
+    // Once the sensor has a slot it keeps it, even while it has no pin
+    if (pin >= 0 && _dataReadySlot == 0xFF) {
+        if (dataReadyCount >= MS_DATA_READY_MAX_SENSORS) {
+            MS_DBG(F("There's no room for a data-ready pin for"),
+                   getSensorNameAndLocation());
+            return false;
+        }
+        _dataReadySlot                   = dataReadyCount++;
+        dataReadySensors[_dataReadySlot] = this;
+    }
+    _dataReadyPin  = pin;
+    _dataReadyMode = mode;
+    return true;
+}
+
+void Sensor::armDataReady(void) {
+    static void (*const dataReadyISRs[4])(void) = {
+        dataReadyISR<0>, dataReadyISR<1>, dataReadyISR<2>, dataReadyISR<3>};
+    if (_dataReadyPin < 0) { return; }
+    _dataReady = false;
+    pinMode(_dataReadyPin, INPUT);
+    enableInterrupt(_dataReadyPin, dataReadyISRs[_dataReadySlot],
+                    _dataReadyMode);
+    _dataReadyArmed = true;
+}
+
+void Sensor::disarmDataReady(void) {
+    if (!_dataReadyArmed) { return; }
+    disableInterrupt(_dataReadyPin);
+    _dataReadyArmed = false;
+}
+#endif
+
+
 // This checks to see if enough time has passed for measurement completion
 bool Sensor::isMeasurementComplete(bool debug) {
     // If a measurement failed to start, the sensor will never return a result,
@@ -506,11 +963,26 @@ bool Sensor::isMeasurementComplete(bool debug) {
         }
         return true;
     }
+#ifdef MS_SENSOR_DATA_READY
+    // The sensor said so; the measurement time is only the longest to wait
+    if (_dataReady) {
+        disarmDataReady();
+        if (debug) {
+            MS_DBG(getSensorNameAndLocation(),
+                   F("signalled its measurement is complete"));
+        }
+        return true;
+    }
+#endif
 
     uint32_t elapsed_since_meas_start = millis() - _millisMeasurementRequested;
     // If the sensor is measuring and enough time has elapsed, the reading is
     // finished
-    if (elapsed_since_meas_start > _measurementTime_ms) {
+    if (elapsed_since_meas_start >
+        _measurementTime_ms + _measurementExtension_ms) {
+#ifdef MS_SENSOR_DATA_READY
+        disarmDataReady();
+#endif
         if (debug) {
             MS_DBG(F("It's been"), elapsed_since_meas_start,
                    F("ms, and measurement by"), getSensorNameAndLocation(),
@@ -528,7 +1000,373 @@ bool Sensor::isMeasurementComplete(bool debug) {
 // NOTE:  This is "blocking" - that is, nothing else can happen during this
 // wait.
 void Sensor::waitForMeasurementCompletion(void) {
+    // Not slowed down, since many sensors are asked if they're done
     while (!isMeasurementComplete()) {
         // wait
     }
 }
+
+
+// This calculates when the sensor will next be ready to be acted on.
+// NOTE:  The timing comparisons in isWarmedUp(), isStable() and
+// isMeasurementComplete() are strictly greater than, so the deadline is one
+// millisecond after the end of each period.
+uint32_t Sensor::getNextDeadline(void) {
+    // If there's no power, the warm up is already "passed"
+    if (!bitRead(_sensorStatus, 2)) { return millis(); }
+    // If no attempt has been made to wake the sensor, wait for the warm up
+    if (!bitRead(_sensorStatus, 3)) {
+        uint32_t deadline = _millisPowerOn + _warmUpTime_ms + 1;
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+        if (_adaptiveTiming) {
+            uint32_t probeAt = nextProbeTime(_adaptiveWarmUp, _millisPowerOn);
+            if (static_cast<int32_t>(probeAt - deadline) < 0) {
+                deadline = probeAt;
+            }
+        }
+#endif
+        return deadline;
+    }
+    // If the wake failed, there's nothing to wait for
+    if (!bitRead(_sensorStatus, 4)) { return millis(); }
+    // If no measurement has been requested, wait for stability
+    if (!bitRead(_sensorStatus, 5)) {
+        uint32_t deadline = _millisSensorActivated + stabilizationTime() + 1;
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+        if (_adaptiveTiming) {
+            uint32_t probeAt = nextProbeTime(_adaptiveStabilization,
+                                             _millisSensorActivated);
+            if (static_cast<int32_t>(probeAt - deadline) < 0) {
+                deadline = probeAt;
+            }
+        }
+#endif
+        return deadline;
+    }
+    // If the measurement failed to start, there's nothing to wait for
+    if (!bitRead(_sensorStatus, 6)) { return millis(); }
+#ifdef MS_SENSOR_DATA_READY
+    // The sensor already signalled its data is ready
+    if (_dataReady) { return millis(); }
+#endif
+    // Otherwise, wait for the measurement to finish
+    return _millisMeasurementRequested + _measurementTime_ms +
+        _measurementExtension_ms + 1;
+}
+
+
+uint32_t Sensor::getExpectedDuration(measurementCount_t nMeasurements) {
+    return _warmUpTime_ms + _stabilizationTime_ms +
+        _measurementTime_ms * nMeasurements;
+}
+
+
+// Extend the current measurement so it finishes the given time from now
+void Sensor::rescheduleMeasurement(uint32_t delay_ms) {
+    uint32_t newEnd = millis() - _millisMeasurementRequested + delay_ms;
+    _measurementExtension_ms =
+        newEnd > _measurementTime_ms ? newEnd - _measurementTime_ms : 0;
+    MS_DBG(getSensorNameAndLocation(), F("will be checked again in"),
+           delay_ms, F("ms"));
+}
+
+
+// Move on to the next step of the measurement, due the given time from now
+void Sensor::nextMeasurementStep(uint32_t delay_ms) {
+    _measurementStep++;
+    // NOTE:  The extension is allowed to wrap around so that, added to the
+    // measurement time, it can also bring the end of the measurement forward.
+    _measurementExtension_ms = millis() - _millisMeasurementRequested +
+        delay_ms - _measurementTime_ms;
+    MS_DBG(getSensorNameAndLocation(), F("will do measurement step"),
+           _measurementStep, F("in"), delay_ms, F("ms"));
+}
+
+
+// The bus the sensor communicates over
+sensorBusType Sensor::getBusType(void) {
+    return _busType;
+}
+uintptr_t Sensor::getBusId(void) {
+    return _busId;
+}
+void Sensor::setBus(sensorBusType busType, uintptr_t busId) {
+    _busType = busType;
+    _busId   = busId;
+}
+// Sensors with an unknown bus are never considered to share one
+bool Sensor::sharesBusWith(Sensor* other) {
+    return _busType != SENSOR_BUS_NONE && other->_busType == _busType &&
+        other->_busId == _busId;
+}
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+void Sensor::setI2CClock(uint32_t clock_hz) {
+    _i2cClock_hz = clock_hz;
+}
+// Only the bus and clock last set are kept; going back and forth between two
+// buses just sets the clock again
+static uintptr_t lastI2CBus   = 0;
+static uint32_t  lastI2CClock = 0;
+void Sensor::selectI2CClock(bool force) {
+    if (_busType != SENSOR_BUS_I2C || _busId == 0) return;
+    uint32_t clock = _i2cClock_hz ? _i2cClock_hz : MS_I2C_DEFAULT_CLOCK;
+    if (!force && _busId == lastI2CBus && clock == lastI2CClock) return;
+    reinterpret_cast<TwoWire*>(_busId)->setClock(clock);
+    lastI2CBus   = _busId;
+    lastI2CClock = clock;
+}
+void Sensor::forgetI2CClock(void) {
+    lastI2CBus = 0;
+}
+#endif
+// By default, sensors only use the bus while they're being talked to
+bool Sensor::isHoldingBus(void) {
+    return false;
+}
+
+
+// By default, sensors can't tell us when they're ready
+bool Sensor::probeWarmedUp(void) {
+    return false;
+}
+bool Sensor::probeStable(void) {
+    return false;
+}
+
+
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+// This turns adaptive timing on or off and (re)starts the learned estimates
+// from the full warm-up and stabilization times
+void Sensor::setAdaptiveTiming(bool enable, uint32_t warmUpFloor_ms,
+                               uint32_t stabilizationFloor_ms) {
+    _adaptiveTiming                     = enable;
+    _adaptiveWarmUp.estimate_ms         = _warmUpTime_ms;
+    _adaptiveWarmUp.floor_ms            = warmUpFloor_ms;
+    _adaptiveWarmUp.confirmedFor        = 0;
+    _adaptiveStabilization.estimate_ms  = _stabilizationTime_ms;
+    _adaptiveStabilization.floor_ms     = stabilizationFloor_ms;
+    _adaptiveStabilization.confirmedFor = 0;
+}
+uint32_t Sensor::getWarmUpEstimate(void) {
+    return _adaptiveTiming ? _adaptiveWarmUp.estimate_ms : _warmUpTime_ms;
+}
+uint32_t Sensor::getStabilizationEstimate(void) {
+    return _adaptiveTiming ? _adaptiveStabilization.estimate_ms
+                           : _stabilizationTime_ms;
+}
+
+
+// This probes the sensor if a probe is due and updates the learned estimate
+// if the sensor confirms it is ready.
+bool Sensor::checkReadyEarly(adaptivePhaseTiming& timing, uint32_t phaseStart,
+                             bool warmUp) {
+    if (!_adaptiveTiming) return false;
+    // Don't re-probe if the sensor already confirmed for this period
+    if (timing.confirmedFor == phaseStart) return true;
+
+    uint32_t now = millis();
+    if (static_cast<int32_t>(now - nextProbeTime(timing, phaseStart)) < 0) {
+        return false;
+    }
+    _millisLastProbe = now;
+
+    bool ready = warmUp ? probeWarmedUp() : probeStable();
+    if (ready) {
+        timing.estimate_ms  = max(timing.floor_ms, now - phaseStart);
+        timing.confirmedFor = phaseStart;
+        MS_DBG(getSensorNameAndLocation(), F("new"),
+               warmUp ? F("warm-up") : F("stabilization"), F("estimate is"),
+               timing.estimate_ms, F("ms"));
+    }
+    return ready;
+}
+
+
+// Probing starts at three-quarters of the current estimate (but not before
+// the floor) and is repeated no more often than the probe interval.
+uint32_t Sensor::nextProbeTime(adaptivePhaseTiming& timing,
+                               uint32_t             phaseStart) {
+    uint32_t probeAt = phaseStart +
+        max(timing.floor_ms, timing.estimate_ms - timing.estimate_ms / 4);
+    uint32_t nextAllowed = _millisLastProbe + MS_READINESS_PROBE_INTERVAL_MS;
+    if (static_cast<int32_t>(nextAllowed - probeAt) > 0) {
+        probeAt = nextAllowed;
+    }
+    return probeAt;
+}
+#endif
+
+
+#ifdef MS_CHECK_SENSOR_TIMING
+// This records the duration of a phase from the sensor's own timestamps
+void Sensor::markPhaseComplete(sensorTimingPhase phase) {
+    switch (phase) {
+        case SENSOR_PHASE_WARM_UP:
+            recordPhaseTime(phase, _millisSensorActivated - _millisPowerOn);
+            break;
+        case SENSOR_PHASE_STABILIZATION:
+            recordPhaseTime(phase, _millisMeasurementRequested -
+                                       _millisSensorActivated);
+            break;
+        case SENSOR_PHASE_MEASUREMENT:
+            recordPhaseTime(phase, millis() - _millisMeasurementRequested);
+            break;
+        default: break;
+    }
+}
+
+
+// This adds a duration to the summary statistics for a phase
+void Sensor::recordPhaseTime(sensorTimingPhase phase, uint32_t elapsed_ms) {
+    if (phase >= SENSOR_PHASE_COUNT) return;
+    sensorPhaseStats& stats = _phaseStats[phase];
+    stats.last              = elapsed_ms;
+    if (stats.count == 0 || elapsed_ms < stats.min) stats.min = elapsed_ms;
+    if (stats.count == 0 || elapsed_ms > stats.max) stats.max = elapsed_ms;
+    // Don't let the running mean overflow; it just becomes a very slowly
+    // moving average
+    if (stats.count < 0xFFFF) stats.count++;
+    stats.mean += (static_cast<float>(elapsed_ms) - stats.mean) / stats.count;
+    MS_DBG(getSensorNameAndLocation(), F("phase"), phase, F("took"),
+           elapsed_ms, F("ms"));
+}
+
+
+// This returns the requested summary statistic for a phase in seconds
+float Sensor::getPhaseTime(sensorTimingPhase phase, sensorTimingStat stat) {
+    if (phase >= SENSOR_PHASE_COUNT || _phaseStats[phase].count == 0) {
+        return -9999;
+    }
+    switch (stat) {
+        case SENSOR_TIMING_MIN: return _phaseStats[phase].min / 1000.0f;
+        case SENSOR_TIMING_MAX: return _phaseStats[phase].max / 1000.0f;
+        case SENSOR_TIMING_MEAN: return _phaseStats[phase].mean / 1000.0f;
+        case SENSOR_TIMING_LAST:
+        default: return _phaseStats[phase].last / 1000.0f;
+    }
+}
+
+
+// This clears all of the timing statistics
+void Sensor::resetPhaseTimes(void) {
+    memset(_phaseStats, 0, sizeof(_phaseStats));
+}
+#endif
+
+
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+// This sets how the measurements of one result are combined
+void Sensor::setRobustAveraging(sensorAverageMode mode, uint8_t resultNumber) {
+    if (resultNumber >= _numReturnedValues) { mode = SENSOR_AVERAGE_MEAN; }
+    _robustMode         = mode;
+    _robustResultNumber = resultNumber;
+    _robustCount        = 0;
+    _robustSum          = 0;
+    _robustReduced      = 0;
+}
+
+
+// This reduces the sorted window to its estimate; the window is small, so
+// the deviations for the Hampel filter are sorted by insertion too
+void Sensor::reduceRobustWindow(void) {
+    uint8_t n = _robustCount;
+    if (n == 0) { return; }
+    const float* w      = _robustWindow;
+    float        median = (n & 1) ? w[n / 2] : (w[n / 2 - 1] + w[n / 2]) / 2;
+    float        estimate = median;
+    if (_robustMode == SENSOR_AVERAGE_TRIMMED) {
+        uint8_t trim = n / 4;
+        float   sum  = 0;
+        for (uint8_t i = trim; i < n - trim; i++) { sum += w[i]; }
+        estimate = sum / (n - 2 * trim);
+    } else if (_robustMode == SENSOR_AVERAGE_HAMPEL) {
+        float dev[MS_ROBUST_WINDOW_SIZE];
+        for (uint8_t i = 0; i < n; i++) {
+            float   d = fabs(w[i] - median);
+            uint8_t j = i;
+            while (j > 0 && dev[j - 1] > d) {
+                dev[j] = dev[j - 1];
+                j--;
+            }
+            dev[j] = d;
+        }
+        float mad = (n & 1) ? dev[n / 2] : (dev[n / 2 - 1] + dev[n / 2]) / 2;
+        // 1.4826 scales the MAD to a standard deviation for normal noise
+        float   limit = 3 * 1.4826f * mad;
+        float   sum   = 0;
+        uint8_t kept  = 0;
+        for (uint8_t i = 0; i < n; i++) {
+            if (fabs(w[i] - median) <= limit) {
+                sum += w[i];
+                kept++;
+            }
+        }
+        estimate = sum / kept;
+        MS_DBG(F("Hampel filter dropped"), n - kept, F("of"), n,
+               F("measurements from"), getSensorNameAndLocation());
+    }
+    _robustSum += estimate * n;
+    _robustReduced += n;
+    _robustCount = 0;
+}
+#endif
+
+
+#ifdef MS_SENSOR_BURST_STATS
+// This turns on the burst statistics for one result
+void Sensor::setBurstStatistics(measurementCount_t nReadings,
+                                uint8_t            resultNumber) {
+    _measurementsToAverage = nReadings;
+    _burstResultNumber     = resultNumber < _numReturnedValues
+            ? static_cast<int8_t>(resultNumber)
+            : -1;
+    memset(&_burstStats, 0, sizeof(_burstStats));
+    _burstTaken       = 0;
+    _adaptiveStdError = 0;
+}
+
+
+// This turns on burst statistics and uses them to end each burst early
+void Sensor::setAdaptiveAveraging(measurementCount_t minReadings,
+                                  measurementCount_t maxReadings,
+                                  float targetStdError, uint8_t resultNumber) {
+    setBurstStatistics(maxReadings, resultNumber);
+    _adaptiveMinReadings = minReadings > 2 ? minReadings : 2;
+    _adaptiveStdError    = targetStdError > 0 ? targetStdError : 0;
+}
+
+
+// This checks the standard error of the mean of the burst so far
+bool Sensor::hasEnoughMeasurements(measurementCount_t nTaken) {
+    _burstTaken = nTaken;
+    if (_adaptiveStdError <= 0 || _burstResultNumber < 0) { return false; }
+    if (nTaken < _adaptiveMinReadings || _burstStats.count < 2) {
+        return false;
+    }
+    // SE^2 = s^2 / n = m2 / ((n - 1) * n); compare squares to skip the root
+    float n        = _burstStats.count;
+    float variance = _burstStats.m2 / ((n - 1) * n);
+    if (variance > _adaptiveStdError * _adaptiveStdError) { return false; }
+    MS_DBG(getSensorNameAndLocation(), F("has a standard error of"),
+           sqrt(variance), F("after"), nTaken, F("measurements"));
+    return true;
+}
+
+
+// This returns the requested summary statistic of the last burst
+float Sensor::getBurstStatistic(sensorBurstStat stat) {
+    if (_burstResultNumber < 0) { return -9999; }
+    if (stat == SENSOR_BURST_COUNT) { return _burstStats.count; }
+    if (stat == SENSOR_BURST_TAKEN) { return _burstTaken; }
+    if (_burstStats.count == 0) { return -9999; }
+    switch (stat) {
+        case SENSOR_BURST_MIN: return _burstStats.min;
+        case SENSOR_BURST_MAX: return _burstStats.max;
+        case SENSOR_BURST_STDEV:
+            if (_burstStats.count < 2) { return -9999; }
+            return sqrt(_burstStats.m2 / (_burstStats.count - 1));
+        case SENSOR_BURST_MEAN:
+        default: return _burstStats.mean;
+    }
+}
+#endif
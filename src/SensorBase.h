@@ -35,6 +35,10 @@
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include <pins_arduino.h>
+#if defined(MS_CHECK_SENSOR_TIMING) || defined(MS_SENSOR_BURST_STATS) || \
+    defined(MS_SENSOR_QUARANTINE)
+#include "VariableBase.h"
+#endif
 
 #ifndef MAX_NUMBER_VARS
 /**
@@ -44,8 +48,441 @@
 // GroPoint Profile GPLP-8 has 8 Moisture and 13 Temperature values
 #endif
 
+/**
+ * @def MS_SENSOR_RESULT_POOL_SIZE
+ * @brief Define this build flag to give each sensor room for only as many
+ * results as it actually returns, taken from one shared pool with room for
+ * this many results in total.
+ *
+ * Without this flag every sensor reserves room for #MAX_NUMBER_VARS results -
+ * a value, a count of good measurements, and a variable pointer for each -
+ * whether it returns 1 value or 21.  With it, the pool is handed out as the
+ * sensors are constructed.  Set the pool size to at least the total number of
+ * values returned by all of your sensors; Sensor::getResultPoolUsed() will
+ * tell you how much you've used.  A sensor that doesn't fit in the pool will
+ * fail setup and never report values.
+ */
+// #define MS_SENSOR_RESULT_POOL_SIZE 64
+
+/**
+ * @def MS_DISCOVERY_CACHE
+ * @brief Define this build flag to keep what the sensors find when they
+ * search their buses at setup in EEPROM, so it's only searched for again
+ * when it's no longer there.
+ *
+ * A MaximDS18 without an address keeps the ROM it found on its pin and only
+ * searches the bus again if that ROM doesn't answer.  An SDI12Sensors keeps
+ * the identification of the sensor at its address and skips the
+ * acknowledgement and identification commands at setup; a failed measurement
+ * forgets it, so the next setup asks again.  See DiscoveryCache for where the
+ * cache is kept.
+ */
+// #define MS_DISCOVERY_CACHE
+
 class Variable;  // Forward declaration
 
+/**
+ * @def MS_CHECK_SENSOR_TIMING
+ * @brief Define this build flag to record how long each sensor spends in each
+ * phase of its measurement cycle.
+ *
+ * The timing can be logged or published with Sensor_PhaseDuration variables.
+ *
+ * @note This is only a testing/development diagnostic.  It uses about 70
+ * bytes of RAM per sensor.
+ */
+// #define MS_CHECK_SENSOR_TIMING
+
+/**
+ * @brief The phases of a sensor's measurement cycle that can be timed.
+ */
+typedef enum {
+    /// From power on until the sensor is awoken
+    SENSOR_PHASE_WARM_UP = 0,
+    /// From the sensor being awoken until the first measurement is started
+    SENSOR_PHASE_STABILIZATION,
+    /// From a measurement being started until the result is requested
+    SENSOR_PHASE_MEASUREMENT,
+    /// The time taken to retrieve a measurement result
+    SENSOR_PHASE_RETRIEVAL,
+    /// The number of timed phases
+    SENSOR_PHASE_COUNT
+} sensorTimingPhase;
+
+/**
+ * @brief The summary statistics kept for each timed phase.
+ */
+typedef enum {
+    /// The time taken the last time the phase ran
+    SENSOR_TIMING_LAST = 0,
+    /// The shortest time taken by the phase
+    SENSOR_TIMING_MIN,
+    /// The longest time taken by the phase
+    SENSOR_TIMING_MAX,
+    /// The mean time taken by the phase
+    SENSOR_TIMING_MEAN
+} sensorTimingStat;
+
+/**
+ * @brief The types of physical bus a sensor can communicate over.
+ *
+ * Sensors on different buses never conflict with each other.  Sensors on the
+ * same bus only conflict if one of them holds the bus while it is measuring;
+ * see Sensor::isHoldingBus().
+ */
+typedef enum {
+    /// The sensor's bus is not known or not shared; it is never arbitrated
+    SENSOR_BUS_NONE = 0,
+    /// An I2C (Wire) bus
+    SENSOR_BUS_I2C,
+    /// An SDI-12 data line
+    SENSOR_BUS_SDI12,
+    /// A Modbus/RS485 serial stream
+    SENSOR_BUS_RS485,
+    /// A OneWire data line
+    SENSOR_BUS_ONEWIRE
+} sensorBusType;
+
+/**
+ * @def MS_SENSOR_STANDBY
+ * @brief Define this build flag to choose for each sensor what happens to it
+ * between updates: its power cut, a sleep command with the power left on, or
+ * nothing at all.
+ *
+ * Set the policy with Sensor::setStandbyPolicy().  With #STANDBY_AUTO the
+ * policy is picked by Sensor::chooseStandby() - called by Logger::begin()
+ * with the logging interval, or the interval of the sampling group the sensor
+ * is in, whichever is shorter - as the one with the lowest charge per interval
+ * from the currents and times given to Sensor::setStandbyCosts().  A sensor
+ * that's kept powered skips its warm-up, and one woken from a powered sleep
+ * waits for its sleep ready time instead of its full stabilization time.  A
+ * power pin is only cut when every sensor on it is power cycled.
+ */
+// #define MS_SENSOR_STANDBY
+
+#ifdef MS_SENSOR_STANDBY
+/**
+ * @brief What happens to a sensor between updates (#MS_SENSOR_STANDBY).
+ */
+typedef enum sensorStandby : uint8_t {
+    /// Put to sleep and the power cut; every update pays the full warm-up
+    STANDBY_POWER_CYCLE = 0,
+    /// Put to sleep with the power left on
+    STANDBY_SLEEP,
+    /// Left powered and awake
+    STANDBY_STAY_ON,
+    /// Picked from the interval between updates and the declared costs
+    STANDBY_AUTO
+} sensorStandby;
+#endif
+
+/**
+ * @def MS_ADAPTIVE_SENSOR_TIMING
+ * @brief Define this build flag to allow sensors that can report their own
+ * readiness to finish their warm-up and stabilization early.
+ *
+ * Adaptive timing must also be turned on for each sensor with
+ * Sensor::setAdaptiveTiming().
+ */
+// #define MS_ADAPTIVE_SENSOR_TIMING
+
+/**
+ * @def MS_SENSOR_BURST_STATS
+ * @brief Define this build flag to allow bursts of hundreds of measurements
+ * per update and keep streaming summary statistics of one result of a sensor.
+ *
+ * With this flag the number of measurements to average is a 16-bit count
+ * (#measurementCount_t) instead of being capped at 255.  Turn on the
+ * statistics for a sensor with Sensor::setBurstStatistics(); the mean,
+ * minimum, maximum, standard deviation, and count of the burst can then be
+ * logged or published with Sensor_BurstStatistic variables.  The statistics
+ * are accumulated as each measurement comes in, so no samples are stored.
+ *
+ * The statistics can also end the burst early: with
+ * Sensor::setAdaptiveAveraging(), measurements stop as soon as the standard
+ * error of the mean is small enough, between a minimum and maximum count.
+ *
+ * @note This is only useful for sensors that can take many measurements
+ * quickly, like the analog and ADS1x15 based sensors or the MaxBotix.
+ */
+// #define MS_SENSOR_BURST_STATS
+
+/**
+ * @def MS_SENSOR_ROBUST_AVERAGE
+ * @brief Define this build flag to let one result of a sensor be combined
+ * with a median, a trimmed mean, or a Hampel filter instead of the mean.
+ *
+ * One spike in the measurements of an update - a surface echo on a MaxBotix,
+ * a DHT glitch, a bubble on a Cyclops - ruins the mean, and taking more
+ * measurements to drown it out keeps the sensor awake longer.  Choose the
+ * estimator for a sensor with Sensor::setRobustAveraging().  The good
+ * measurements of that result are kept sorted as they come in, in a window
+ * of #MS_ROBUST_WINDOW_SIZE values; each full window is reduced to its
+ * estimate and the update's result is the mean of those estimates, so the
+ * memory used doesn't grow with the number of measurements.
+ */
+// #define MS_SENSOR_ROBUST_AVERAGE
+
+#ifndef MS_ROBUST_WINDOW_SIZE
+/**
+ * @brief With #MS_SENSOR_ROBUST_AVERAGE, the number of measurements each
+ * robust estimate is made over; each sensor takes 4 bytes for each.
+ */
+#define MS_ROBUST_WINDOW_SIZE 9
+#endif
+
+/**
+ * @def MS_SENSOR_DECIMATION
+ * @brief Define this build flag to allow slow or power hungry sensors to be
+ * measured only every few logging intervals.
+ *
+ * Set how often each sensor is measured with Sensor::setMeasureEvery().  In
+ * the intervals a sensor is skipped, VariableArray::completeUpdate() doesn't
+ * power it up or wake it, and a power pin is only switched on if one of the
+ * sensors on it is due.  The skipped sensor's variables either keep their last
+ * value or are set to -9999.
+ */
+// #define MS_SENSOR_DECIMATION
+
+/**
+ * @def MS_SENSOR_QUARANTINE
+ * @brief Define this build flag to stop trying a sensor every update once it
+ * keeps failing.
+ *
+ * An update fails for a sensor if every one of its values is -9999 - either
+ * it didn't wake or it didn't give a single good result.  After
+ * #MS_QUARANTINE_FAILURES failed updates in a row, the sensor is quarantined:
+ * VariableArray::completeUpdate() skips it (without powering or waking it) for
+ * 1 update, then 2, 4, and so on up to #MS_QUARANTINE_MAX_SKIP updates, trying
+ * it once in between.  One good update ends the quarantine.  The failure
+ * counts can be logged with Sensor_HealthStatistic variables.
+ */
+// #define MS_SENSOR_QUARANTINE
+
+#ifndef MS_QUARANTINE_FAILURES
+/**
+ * @brief The number of failed updates in a row before a sensor is
+ * quarantined.
+ */
+#define MS_QUARANTINE_FAILURES 3
+#endif
+
+#ifndef MS_QUARANTINE_MAX_SKIP
+/**
+ * @brief The most updates a quarantined sensor is skipped between tries.
+ *
+ * This can be up to 65535.
+ */
+#define MS_QUARANTINE_MAX_SKIP 64
+#endif
+
+/**
+ * @def MS_SHARE_SENSOR_RESULTS
+ * @brief Define this build flag to let a sensor in more than one VariableArray
+ * be measured only once when the arrays are updated one after another.
+ *
+ * Each sensor keeps the time its results were last averaged.  When a
+ * VariableArray update starts within #MS_SENSOR_RESULT_MAX_AGE_MS of that,
+ * the sensor isn't powered, woken, or measured again; its last results are
+ * handed to the array's variables instead.  A sensor that is reused doesn't
+ * count toward its decimation or quarantine either, so it isn't counted off
+ * twice in the same logging interval.  With the sensor left alone, its power
+ * pin is left however the other array's update left it.
+ */
+// #define MS_SHARE_SENSOR_RESULTS
+
+#ifndef MS_SENSOR_RESULT_MAX_AGE_MS
+/**
+ * @brief With #MS_SHARE_SENSOR_RESULTS, the oldest results in milliseconds
+ * that can be used again instead of measuring a sensor.
+ *
+ * This should be well under the shortest logging interval, or the results of
+ * one interval will be used in the next.
+ */
+#define MS_SENSOR_RESULT_MAX_AGE_MS 30000L
+#endif
+
+/**
+ * @def MS_I2C_CLOCK_PER_SENSOR
+ * @brief Define this build flag to let each I2C sensor be serviced at its own
+ * bus clock speed.
+ *
+ * Before a VariableArray sets up, wakes, measures, or sleeps an I2C sensor, the
+ * clock of the sensor's bus is set to the speed given to
+ * Sensor::setI2CClock(), or to #MS_I2C_DEFAULT_CLOCK if none was given.  The
+ * clock is only changed when it has to be, so sensors left at the same speed
+ * cost nothing.  A sensor that can run in fast mode (400 kHz) then spends less
+ * time on the bus, while a slow or long-wired sensor on the same bus can still
+ * be read at 100 kHz.
+ */
+// #define MS_I2C_CLOCK_PER_SENSOR
+
+#ifndef MS_I2C_DEFAULT_CLOCK
+/**
+ * @brief With #MS_I2C_CLOCK_PER_SENSOR, the I2C clock speed in Hz for sensors
+ * that haven't been given their own.
+ */
+#define MS_I2C_DEFAULT_CLOCK 100000L
+#endif
+
+/**
+ * @def MS_SENSOR_LOCATION_CACHE
+ * @brief Define this build flag to put together the name and location of each
+ * sensor once and keep it, instead of building a new String each time it's
+ * printed.
+ *
+ * Sensor::getSensorNameAndLocation() then returns the kept text as a
+ * `const char*`.  It's built the first time it's asked for and again after
+ * each sensor is set up, since some sensors only know their address once
+ * they've found it.  Each sensor takes #MS_SENSOR_LOCATION_SIZE more bytes
+ * of RAM; longer names and locations are cut off.
+ */
+// #define MS_SENSOR_LOCATION_CACHE
+
+#ifndef MS_SENSOR_LOCATION_SIZE
+/**
+ * @brief With #MS_SENSOR_LOCATION_CACHE, the size of the buffer kept for the
+ * name and location of each sensor.
+ */
+#define MS_SENSOR_LOCATION_SIZE 40
+#endif
+
+/**
+ * @def MS_SENSOR_DATA_READY
+ * @brief Define this build flag to let sensors with a data-ready or alert
+ * output tell the logger a measurement is done by an interrupt, through
+ * Sensor::setDataReadyPin().
+ *
+ * The interrupt is armed when each measurement is started and only sets a
+ * flag, so isMeasurementComplete() is finished as soon as the sensor says so
+ * instead of after its whole measurement time; the measurement time is then
+ * only the longest to wait if the interrupt never comes.  With
+ * #MS_USE_DEADLINE_SCHEDULER and #MS_IDLE_BETWEEN_DEADLINES the processor
+ * idles until the interrupt wakes it.  Up to #MS_DATA_READY_MAX_SENSORS
+ * sensors can have a pin.
+ */
+// #define MS_SENSOR_DATA_READY
+
+#ifdef MS_SENSOR_DATA_READY
+#ifndef MS_DATA_READY_MAX_SENSORS
+/**
+ * @brief With #MS_SENSOR_DATA_READY, the number of sensors that can be given
+ * a data-ready pin; at most 4.
+ */
+#define MS_DATA_READY_MAX_SENSORS 4
+#endif
+#if MS_DATA_READY_MAX_SENSORS > 4
+#error MS_DATA_READY_MAX_SENSORS can be at most 4
+#endif
+#endif
+
+#ifdef MS_SENSOR_QUARANTINE
+/**
+ * @brief The health statistics kept for each sensor.
+ */
+typedef enum {
+    /// The total number of failed updates
+    SENSOR_HEALTH_FAILURES = 0,
+    /// The number of failed updates in a row
+    SENSOR_HEALTH_CONSECUTIVE,
+    /// The number of updates left to skip before the sensor is tried again
+    SENSOR_HEALTH_QUARANTINED
+} sensorHealthStat;
+#endif
+
+#ifdef MS_SENSOR_BURST_STATS
+/**
+ * @brief The type used to count the measurements to average
+ */
+typedef uint16_t measurementCount_t;
+
+/**
+ * @brief The summary statistics kept for a burst of measurements.
+ */
+typedef enum {
+    /// The mean of the good measurements in the burst
+    SENSOR_BURST_MEAN = 0,
+    /// The smallest good measurement in the burst
+    SENSOR_BURST_MIN,
+    /// The largest good measurement in the burst
+    SENSOR_BURST_MAX,
+    /// The sample standard deviation of the good measurements in the burst
+    SENSOR_BURST_STDEV,
+    /// The number of good measurements in the burst
+    SENSOR_BURST_COUNT,
+    /// The number of measurements taken in the burst, good or bad; with
+    /// adaptive averaging this is how many were needed
+    SENSOR_BURST_TAKEN
+} sensorBurstStat;
+
+/**
+ * @brief The streaming accumulators for the statistics of one burst.
+ */
+typedef struct {
+    float    min;    ///< The smallest good measurement
+    float    max;    ///< The largest good measurement
+    float    mean;   ///< The running mean of the good measurements
+    float    m2;     ///< The running sum of squared differences from the mean
+    uint16_t count;  ///< The number of good measurements
+} sensorBurstStats;
+#else
+/**
+ * @brief The type used to count the measurements to average
+ */
+typedef uint8_t measurementCount_t;
+#endif
+
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+/**
+ * @brief The ways the measurements of one result can be combined.
+ */
+typedef enum {
+    /// The mean of the good measurements, as without robust averaging
+    SENSOR_AVERAGE_MEAN = 0,
+    /// The median of the good measurements
+    SENSOR_AVERAGE_MEDIAN,
+    /// The mean of the good measurements without the lowest and highest
+    /// quarter
+    SENSOR_AVERAGE_TRIMMED,
+    /// The mean of the good measurements within 3 scaled median absolute
+    /// deviations of the median
+    SENSOR_AVERAGE_HAMPEL
+} sensorAverageMode;
+#endif
+
+#ifndef MS_READINESS_PROBE_INTERVAL_MS
+/**
+ * @brief The minimum time between readiness probes of a single sensor when
+ * using adaptive timing.
+ */
+#define MS_READINESS_PROBE_INTERVAL_MS 250
+#endif
+
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+/**
+ * @brief The learned timing of a single warm-up or stabilization period.
+ */
+typedef struct {
+    uint32_t estimate_ms;   ///< The current estimate of the period
+    uint32_t floor_ms;      ///< The shortest the estimate is allowed to be
+    uint32_t confirmedFor;  ///< The start time of the last confirmed period
+} adaptivePhaseTiming;
+#endif
+
+#ifdef MS_CHECK_SENSOR_TIMING
+/**
+ * @brief The recorded durations of a single phase of a sensor's measurement
+ * cycle, in milliseconds.
+ */
+typedef struct {
+    uint32_t last;   ///< The last recorded duration
+    uint32_t min;    ///< The shortest recorded duration
+    uint32_t max;    ///< The longest recorded duration
+    float    mean;   ///< The mean of all recorded durations
+    uint16_t count;  ///< The number of durations recorded
+} sensorPhaseStats;
+#endif
+
 /**
  * @brief The "Sensor" class is used for all sensor-level operations - waking,
  * sleeping, and taking measurements.
@@ -135,6 +572,31 @@ class Sensor {
      * @return **String** The sensor name as given in the constructor.
      */
     virtual String getSensorName(void);
+    /**
+     * @brief Get the name of the sensor without copying it into a String.
+     *
+     * @return **const char\*** The sensor name as given in the constructor.
+     */
+    virtual const char* getSensorNameChars(void);
+#ifdef MS_SENSOR_LOCATION_CACHE
+    /**
+     * @brief Get the name and location of the sensor, put together the first
+     * time it's asked for.
+     *
+     * @return **const char\*** The sensor name and its "location" - how it is
+     * connected to the mcu.
+     */
+    const char* getSensorNameAndLocation(void);
+    /**
+     * @brief Forget the kept name and location, so they are put together
+     * again the next time they're asked for.
+     *
+     * Call this whenever getSensorLocation() would give something new.
+     */
+    void clearSensorLocation(void) {
+        _nameAndLocation[0] = '\0';
+    }
+#else
     /**
      * @brief Concatentate and returns the name and location of the sensor.
      *
@@ -142,12 +604,102 @@ class Sensor {
      * - how it is connected to the mcu.
      */
     String getSensorNameAndLocation(void);
+#endif
     /**
      * @brief Get the pin number controlling sensor power.
      *
      * @return **int8_t** The pin on the mcu controlling power to the sensor.
      */
     virtual int8_t getPowerPin(void);
+#ifdef MS_STAGGER_POWER_UP
+    /**
+     * @brief Set an estimate of the current the sensor draws while it's
+     * powering up.
+     *
+     * This is used by VariableArray::setPowerBudget() to keep the power pins
+     * switched on together under the board's limit.  For a sensor with a
+     * second power pin, like the Yosemitech and Keller sensors with an RS485
+     * adapter, include the current of whatever is on that pin.
+     *
+     * @param startupCurrent_mA The peak current at power up, in mA; 0 (the
+     * default) if it's too small to count.
+     */
+    void setStartupCurrent(uint16_t startupCurrent_mA);
+    /**
+     * @brief Get the estimate of the current the sensor draws while it's
+     * powering up.
+     *
+     * @return **uint16_t** The peak current at power up, in mA.
+     */
+    uint16_t getStartupCurrent(void);
+#endif
+#ifdef MS_SENSOR_STANDBY
+    /**
+     * @brief Set what happens to the sensor between updates
+     * (#MS_SENSOR_STANDBY).
+     *
+     * @param policy The sensorStandby policy; #STANDBY_AUTO to have
+     * chooseStandby() pick one.
+     */
+    void setStandbyPolicy(sensorStandby policy);
+    /**
+     * @brief Get what happens to the sensor between updates.
+     *
+     * @return **sensorStandby** The policy in use; #STANDBY_POWER_CYCLE for
+     * #STANDBY_AUTO until chooseStandby() has picked one.
+     */
+    sensorStandby getStandbyPolicy(void);
+    /**
+     * @brief Give the costs used to choose a standby policy.
+     *
+     * @param active_mA The current drawn while the sensor is powered and
+     * awake, in mA
+     * @param sleep_mA The current drawn while it's asleep with the power on,
+     * in mA
+     * @param sleepReady_ms The time from waking it from a powered sleep until
+     * its readings are stable, in ms.  Use -1 (the default) if the sensor has
+     * no sleep command that keeps it ready, so #STANDBY_SLEEP isn't picked.
+     */
+    void setStandbyCosts(uint16_t active_mA, uint16_t sleep_mA,
+                         uint32_t sleepReady_ms = 0xFFFFFFFF);
+    /**
+     * @brief Estimate the charge one interval between updates costs with a
+     * standby policy.
+     *
+     * The powered time of each update - the warm-up, stabilization and
+     * measurements of a power cycled sensor, or the sleep ready time and
+     * measurements of a sleeping one - is charged at the active current and
+     * the rest of the interval at the sleep current.  A sensor left on draws
+     * the active current the whole interval.
+     *
+     * @param policy The sensorStandby policy to cost
+     * @param interval_ms The time between updates, in ms
+     * @return **float** The charge in mA·s, or -9999 for a policy the sensor
+     * can't use.
+     */
+    float getStandbyCost(sensorStandby policy, uint32_t interval_ms);
+    /**
+     * @brief Pick the standby policy with the lowest cost for an interval
+     * between updates, if the policy is #STANDBY_AUTO.
+     *
+     * Without an active current from setStandbyCosts() the sensor stays power
+     * cycled.
+     *
+     * @param interval_ms The time between updates, in ms
+     */
+    void chooseStandby(uint32_t interval_ms);
+    /**
+     * @brief Put the sensor into standby at the end of an update, by its
+     * standby policy.
+     *
+     * A sensor left on is left alone; any other is put to sleep.  The power
+     * isn't touched here; VariableArray cuts it only if every sensor on the
+     * pin is power cycled.
+     *
+     * @return **bool** True if the sensor was put into standby.
+     */
+    bool standby(void);
+#endif
 
     /**
      * @brief Set the number measurements to average.
@@ -157,16 +709,157 @@ class Sensor {
      * @param nReadings The number of readings to take and average to create a
      * result from the sensor.  Overrides any value given in the constructor.
      */
-    void setNumberMeasurementsToAverage(uint8_t nReadings);
+    void setNumberMeasurementsToAverage(measurementCount_t nReadings);
     /**
      * @brief Get the number of measurements to average.
      *
-     * @return **uint8_t** The number of readings to take and average to create
-     * a result from the sensor.
+     * @return **measurementCount_t** The number of readings to take and
+     * average to create a result from the sensor.
      *
      * @copydetails _measurementsToAverage
      */
-    uint8_t getNumberMeasurementsToAverage(void);
+    measurementCount_t getNumberMeasurementsToAverage(void);
+#ifdef MS_LOGGER_POWER_POLICY
+    /**
+     * @brief Limit the number of measurements every sensor averages, ie, to
+     * save energy on a low battery (#MS_LOGGER_POWER_POLICY).
+     *
+     * @param maxAverages The most measurements averaged; 0 for no limit.
+     */
+    static void setAveragingLimit(measurementCount_t maxAverages);
+#ifdef MS_SENSOR_DECIMATION
+    /**
+     * @brief Measure the decimated sensors less often, ie, to save energy on
+     * a low battery (#MS_LOGGER_POWER_POLICY).
+     *
+     * Sensors measured every update aren't changed.
+     *
+     * @param factor The times set with setMeasureEvery() are multiplied by
+     * this; 1 to put them back.
+     */
+    static void setDecimationFactor(uint8_t factor);
+#endif
+#endif
+
+#ifdef MS_SENSOR_DECIMATION
+    /**
+     * @brief Set how often the sensor is measured by
+     * VariableArray::completeUpdate().
+     *
+     * The sensor is always measured in the first update.
+     *
+     * @param nCycles Measure the sensor every this many updates; 1 (the
+     * default) for every update.
+     * @param keepLastValue True to have the sensor's variables keep their last
+     * value in the updates the sensor is skipped; false to set them to -9999.
+     */
+    void setMeasureEvery(uint8_t nCycles, bool keepLastValue = false);
+    /**
+     * @brief Get how often the sensor is measured.
+     *
+     * @return **uint8_t** The number of updates between measurements.
+     */
+    uint8_t getMeasureEvery(void);
+    /**
+     * @brief Check if the sensor keeps its last values when skipped.
+     *
+     * @return **bool** True if the variables keep their last value.
+     */
+    bool getKeepLastValue(void);
+    /**
+     * @brief Count off an update and check whether the sensor is measured in
+     * it.
+     *
+     * This is called once for each sensor at the start of each
+     * VariableArray::completeUpdate().
+     *
+     * @return **bool** True if the sensor should be measured in this update.
+     */
+    bool checkDueThisCycle(void);
+#endif
+
+#ifdef MS_SENSOR_QUARANTINE
+    /**
+     * @brief Count off an update and check whether the sensor is quarantined
+     * for it.
+     *
+     * This is called once for each sensor at the start of each
+     * VariableArray::completeUpdate().
+     *
+     * @return **bool** True if the sensor should be skipped in this update.
+     */
+    bool checkQuarantine(void);
+    /**
+     * @brief Record whether the last update succeeded, quarantining the
+     * sensor if it keeps failing.
+     *
+     * This is called after the results of an update are averaged; the update
+     * failed if all of the values are -9999.
+     */
+    void recordUpdateHealth(void);
+    /**
+     * @brief Get one of the health statistics of the sensor.
+     *
+     * @param stat The statistic to return.
+     * @return **float** The statistic.
+     */
+    float getHealthStatistic(sensorHealthStat stat);
+    /**
+     * @brief Clear the failure counts and end any quarantine.
+     */
+    void resetHealth(void);
+#endif
+
+#ifdef MS_SHARE_SENSOR_RESULTS
+    /**
+     * @brief Check if the sensor's results are recent enough to be used
+     * instead of measuring it again.
+     *
+     * @param cycleStart The processor time the update asking started.
+     * @return **bool** True if the results were averaged less than
+     * #MS_SENSOR_RESULT_MAX_AGE_MS before cycleStart.
+     */
+    bool hasFreshResults(uint32_t cycleStart);
+    /**
+     * @brief Forget when the sensor's results were taken, so the next update
+     * measures it again.
+     */
+    void expireResults(void);
+#endif
+#ifdef MS_LOGGER_RESULT_TIMES
+    /**
+     * @brief Get the processor time the last measurement result was added.
+     *
+     * @return **uint32_t** The time in milliseconds; 0 if there have been no
+     * results since the values were cleared.
+     */
+    uint32_t getLastResultTime(void) {
+        return _lastResultAt;
+    }
+#endif
+#ifdef MS_SENSOR_DATA_READY
+    /**
+     * @brief Set the pin the sensor signals a finished measurement on.
+     *
+     * The pin is set up as an input when each measurement starts, and left
+     * alone otherwise, so a pull-up or the sensor's own drive is needed.
+     *
+     * @param pin The pin of the sensor's data-ready or alert output; -1 to
+     * go back to waiting out the measurement time
+     * @param mode The change that means the data is ready; optional with a
+     * default of FALLING
+     * @return **bool** True if there was room for another data-ready pin.
+     */
+    bool setDataReadyPin(int8_t pin, uint8_t mode = FALLING);
+    /**
+     * @brief Get the data-ready pin of the sensor.
+     *
+     * @return **int8_t** The pin; -1 if it has none.
+     */
+    int8_t getDataReadyPin(void) {
+        return _dataReadyPin;
+    }
+#endif
 
     /**
      * @brief Get the 8-bit code for the current status of the sensor.
@@ -324,7 +1017,11 @@ class Sensor {
     /**
      * @brief The array of result values for each sensor.
      */
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    float* sensorValues;
+#else
     float sensorValues[MAX_NUMBER_VARS];
+#endif
 
     /**
      * @brief Clear the values array - that is, sets all values to -9999.
@@ -439,32 +1136,326 @@ class Sensor {
      */
     void waitForMeasurementCompletion(void);
 
-
- protected:
     /**
-     * @brief Digital pin number on the mcu receiving sensor data
+     * @brief Ask the sensor whether it is already warmed up and ready to
+     * receive commands.
      *
-     * @note SIGNED int, to allow negative numbers for unused pins
+     * This is only used with adaptive timing.  By default the sensor cannot
+     * report its own readiness and this always returns false.  Sensors that
+     * can tell (ie, by answering a command) should override this.
+     *
+     * @return **bool** True if the sensor confirmed it is ready.
      */
-    int8_t _dataPin;
+    virtual bool probeWarmedUp(void);
     /**
-     * @brief Digital pin number on the mcu controlling sensor power
+     * @brief Ask the sensor whether it is already giving stable values.
      *
-     * @note SIGNED int, to allow negative numbers for unused pins
+     * This is only used with adaptive timing.  By default the sensor cannot
+     * report its own stability and this always returns false.
+     *
+     * @return **bool** True if the sensor confirmed it is stable.
      */
-    int8_t _powerPin;
+    virtual bool probeStable(void);
+
     /**
-     * @brief The sensor name.
+     * @brief Get the processor time at which the sensor is next expected to be
+     * ready for the library to act on it.
+     *
+     * This mirrors the checks in isWarmedUp(), isStable() and
+     * isMeasurementComplete(): the sensor's next deadline is the end of
+     * whichever of the warm-up, stabilization, or measurement periods it is
+     * currently in.  If the sensor can be acted on right away (ie, power, wake,
+     * or the measurement start failed) the current time is returned.
+     *
+     * @return **uint32_t** The processor time (in milliseconds since start-up)
+     * when the sensor next needs attention.
      */
-    const char* _sensorName;
+    uint32_t getNextDeadline(void);
     /**
-     * @brief The number of values the sensor is capable of reporting.
+     * @brief Get the expected time from power on until the last of a number
+     * of measurements is finished.
      *
-     * This includes raw values from the sensor and any values that are always
-     * calculated within the library for the sensor.  The @ref _incCalcValues
-     * are *included* in this total.
+     * This is the warm-up and stabilization times plus the measurement time
+     * for each measurement, assuming nothing holds the sensor up.
+     *
+     * @param nMeasurements The number of measurements to take.
+     * @return **uint32_t** The expected time in milliseconds.
      */
-    const uint8_t _numReturnedValues;
+    uint32_t getExpectedDuration(measurementCount_t nMeasurements);
+
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    /**
+     * @brief Get the number of results taken from the shared result pool by
+     * all of the sensors constructed so far.
+     *
+     * @return **uint16_t** The number of results used, out of
+     * #MS_SENSOR_RESULT_POOL_SIZE.  If this is more than the pool size, some
+     * sensors didn't fit.
+     */
+    static uint16_t getResultPoolUsed(void);
+#endif
+
+    /**
+     * @brief Get the type of bus the sensor communicates over.
+     *
+     * @return **sensorBusType** The type of bus.
+     */
+    sensorBusType getBusType(void);
+    /**
+     * @brief Get the identifier of the bus the sensor communicates over.
+     *
+     * This is the data pin for pin-based buses (SDI-12, OneWire) and the
+     * address of the Wire or Stream object for object-based buses (I2C,
+     * RS485).
+     *
+     * @return **uintptr_t** The bus identifier.
+     */
+    uintptr_t getBusId(void);
+    /**
+     * @brief Check if this sensor and another are on the same physical bus.
+     *
+     * @param other The other sensor.
+     * @return **bool** True if both sensors are on the same known bus.
+     */
+    bool sharesBusWith(Sensor* other);
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+    /**
+     * @brief Set the I2C clock speed this sensor is serviced at
+     * (#MS_I2C_CLOCK_PER_SENSOR).
+     *
+     * The speed must be one the sensor and every other device on the bus can
+     * tolerate while this sensor is being talked to; most sensors support
+     * 400 kHz.
+     *
+     * @param clock_hz The clock speed in Hz; 0 to use #MS_I2C_DEFAULT_CLOCK.
+     */
+    void setI2CClock(uint32_t clock_hz);
+    /**
+     * @brief Set the clock of the sensor's I2C bus to the speed for this
+     * sensor, if it isn't already (#MS_I2C_CLOCK_PER_SENSOR).
+     *
+     * This does nothing for sensors that aren't on a known I2C bus.
+     *
+     * @param force True to set the clock even if it was last set to the same
+     * speed, like after the Wire library has been started again; optional
+     * with a default value of false.
+     */
+    void selectI2CClock(bool force = false);
+    /**
+     * @brief Forget the I2C clock last set, so the next call to
+     * selectI2CClock() sets it again (#MS_I2C_CLOCK_PER_SENSOR).
+     *
+     * Call this after the Wire library has been started again, which puts
+     * the clock back to its default.
+     */
+    static void forgetI2CClock(void);
+#endif
+    /**
+     * @brief Check if the sensor currently needs exclusive use of its bus.
+     *
+     * Most sensors only use their bus while a function of the sensor is being
+     * called, so they can be left measuring while other sensors on the same
+     * bus are serviced.  A sensor that must keep the bus to itself for the
+     * whole of its measurement (ie, a parasite powered DS18 converting) should
+     * return true here until the measurement result has been collected.  No
+     * other sensor on the bus will be started or read while it does.
+     *
+     * @return **bool** True if no other sensor may use the bus right now.
+     */
+    virtual bool isHoldingBus(void);
+
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    /**
+     * @brief Turn adaptive warm-up and stabilization timing on or off.
+     *
+     * When adaptive timing is on, the sensor is probed with probeWarmedUp()
+     * and probeStable() before the end of its full warm-up and stabilization
+     * times.  The time at which the sensor confirms it is ready becomes the
+     * estimate for the next cycle and probing starts at three-quarters of the
+     * estimate, so the estimate keeps tightening as long as the sensor keeps
+     * confirming early.  The estimate never goes below the given floor and the
+     * full constructor times are always the upper limit.
+     *
+     * @note Adaptive timing only helps sensors that implement probeWarmedUp()
+     * or probeStable()!
+     *
+     * @param enable True to turn on adaptive timing.
+     * @param warmUpFloor_ms The shortest warm-up to accept; optional with a
+     * default value of 0.
+     * @param stabilizationFloor_ms The shortest stabilization to accept;
+     * optional with a default value of 0.
+     */
+    void setAdaptiveTiming(bool enable, uint32_t warmUpFloor_ms = 0,
+                           uint32_t stabilizationFloor_ms = 0);
+    /**
+     * @brief Get the current learned estimate of the warm-up time.
+     *
+     * @return **uint32_t** The warm-up estimate in milliseconds.
+     */
+    uint32_t getWarmUpEstimate(void);
+    /**
+     * @brief Get the current learned estimate of the stabilization time.
+     *
+     * @return **uint32_t** The stabilization estimate in milliseconds.
+     */
+    uint32_t getStabilizationEstimate(void);
+#endif
+
+#ifdef MS_CHECK_SENSOR_TIMING
+    /**
+     * @brief Record the duration of a phase that has just finished, using the
+     * sensor's own power, activation, and measurement timestamps.
+     *
+     * This is called by the VariableArray at each phase transition.  The
+     * warm-up ends when the sensor is awoken, the stabilization when the first
+     * measurement is started, and the measurement when the result is requested.
+     * The retrieval time must be supplied with recordPhaseTime().
+     *
+     * @param phase The phase that just finished.
+     */
+    void markPhaseComplete(sensorTimingPhase phase);
+    /**
+     * @brief Record the duration of a phase.
+     *
+     * @param phase The timed phase.
+     * @param elapsed_ms The time the phase took in milliseconds.
+     */
+    void recordPhaseTime(sensorTimingPhase phase, uint32_t elapsed_ms);
+    /**
+     * @brief Get a summary statistic for the duration of a phase.
+     *
+     * @param phase The timed phase.
+     * @param stat The summary statistic to return.
+     * @return **float** The duration in seconds, or -9999 if the phase has
+     * never been timed.
+     */
+    float getPhaseTime(sensorTimingPhase phase, sensorTimingStat stat);
+    /**
+     * @brief Clear all recorded phase timing.
+     */
+    void resetPhaseTimes(void);
+#else
+    /**
+     * @brief Record the duration of a phase that has just finished; does
+     * nothing without #MS_CHECK_SENSOR_TIMING.
+     */
+    void markPhaseComplete(sensorTimingPhase) {}
+    /**
+     * @brief Record the duration of a phase; does nothing without
+     * #MS_CHECK_SENSOR_TIMING.
+     */
+    void recordPhaseTime(sensorTimingPhase, uint32_t) {}
+#endif
+
+#ifdef MS_SENSOR_BURST_STATS
+    /**
+     * @brief Turn on the burst statistics for one result of the sensor, and
+     * set how many measurements to take in each burst.
+     *
+     * @param nReadings The number of measurements to take in each update;
+     * this replaces the number of measurements to average.
+     * @param resultNumber The position of the result to keep statistics for
+     * within the result array.
+     */
+    void setBurstStatistics(measurementCount_t nReadings,
+                            uint8_t            resultNumber = 0);
+    /**
+     * @brief Get a summary statistic of the last burst of measurements.
+     *
+     * @param stat The summary statistic to return.
+     * @return **float** The statistic, or -9999 if burst statistics aren't
+     * on or there weren't enough good measurements.
+     */
+    float getBurstStatistic(sensorBurstStat stat);
+    /**
+     * @brief Turn on burst statistics for one result and stop each burst as
+     * soon as the mean of that result is good enough.
+     *
+     * Measurements stop once at least minReadings have been taken and the
+     * standard error of the mean (the standard deviation over the square root
+     * of the number of good measurements) is at or below targetStdError, or
+     * once maxReadings have been taken.  Quiet conditions need few
+     * measurements; noisy ones get up to the maximum.  The number needed can
+     * be logged with a Sensor_BurstStatistic for #SENSOR_BURST_TAKEN.
+     *
+     * @param minReadings The fewest measurements to take; at least 2 are
+     * always taken to have a standard error.
+     * @param maxReadings The most measurements to take; this replaces the
+     * number of measurements to average.
+     * @param targetStdError The standard error of the mean to stop at, in the
+     * units of the result; 0 to always take maxReadings.
+     * @param resultNumber The position of the result to keep statistics for
+     * within the result array.
+     */
+    void setAdaptiveAveraging(measurementCount_t minReadings,
+                              measurementCount_t maxReadings,
+                              float              targetStdError,
+                              uint8_t            resultNumber = 0);
+    /**
+     * @brief Check if enough measurements have been taken in this burst.
+     *
+     * This is called after each measurement result is added.
+     *
+     * @param nTaken The number of measurements taken so far in this update.
+     * @return **bool** True if adaptive averaging is on and the mean is good
+     * enough to stop.
+     */
+    bool hasEnoughMeasurements(measurementCount_t nTaken);
+#endif
+
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+    /**
+     * @brief Set how the measurements of one result of the sensor are
+     * combined in each update.
+     *
+     * The other results are still averaged.
+     *
+     * @param mode The #sensorAverageMode; #SENSOR_AVERAGE_MEAN turns robust
+     * averaging back off.
+     * @param resultNumber The position of the result within the result
+     * array.
+     */
+    void setRobustAveraging(sensorAverageMode mode, uint8_t resultNumber = 0);
+    /**
+     * @brief Reduce the window of measurements to its robust estimate and
+     * add that to the estimates of the update.
+     */
+    void reduceRobustWindow(void);
+#endif
+
+
+ protected:
+    /**
+     * @brief Digital pin number on the mcu receiving sensor data
+     *
+     * @note SIGNED int, to allow negative numbers for unused pins
+     */
+    int8_t _dataPin;
+    /**
+     * @brief Digital pin number on the mcu controlling sensor power
+     *
+     * @note SIGNED int, to allow negative numbers for unused pins
+     */
+    int8_t _powerPin;
+    /**
+     * @brief The sensor name.
+     */
+    const char* _sensorName;
+#ifdef MS_SENSOR_LOCATION_CACHE
+    /**
+     * @brief The name and location of the sensor, or empty if they haven't
+     * been put together yet
+     */
+    char _nameAndLocation[MS_SENSOR_LOCATION_SIZE] = "";
+#endif
+    /**
+     * @brief The number of values the sensor is capable of reporting.
+     *
+     * This includes raw values from the sensor and any values that are always
+     * calculated within the library for the sensor.  The @ref _incCalcValues
+     * are *included* in this total.
+     */
+    const uint8_t _numReturnedValues;
     /**
      * @brief The number of measurements from the sensor to average.
      *
@@ -474,7 +1465,127 @@ class Sensor {
      * number of "good" values that are averaged may be less than what was
      * requested.
      */
-    uint8_t _measurementsToAverage;
+    measurementCount_t _measurementsToAverage;
+#ifdef MS_STAGGER_POWER_UP
+    /**
+     * @brief The estimated peak current at power up, in mA.
+     */
+    uint16_t _startupCurrent_mA = 0;
+#endif
+#ifdef MS_SENSOR_STANDBY
+    /**
+     * @brief The standby policy asked for.
+     */
+    sensorStandby _standbyPolicy = STANDBY_POWER_CYCLE;
+    /**
+     * @brief The standby policy in use, once #STANDBY_AUTO is resolved.
+     */
+    sensorStandby _standbyInUse = STANDBY_POWER_CYCLE;
+    /**
+     * @brief The current drawn while powered and awake, in mA.
+     */
+    uint16_t _activeCurrent_mA = 0;
+    /**
+     * @brief The current drawn while asleep with the power on, in mA.
+     */
+    uint16_t _sleepCurrent_mA = 0;
+    /**
+     * @brief The time from waking from a powered sleep until stable, in ms;
+     * 0xFFFFFFFF if there's no such sleep.
+     */
+    uint32_t _sleepReady_ms = 0xFFFFFFFF;
+    /**
+     * @brief True if the sensor was put to sleep and its power hasn't been
+     * cut since.
+     */
+    bool _sleptPowered = false;
+#endif
+#ifdef MS_SENSOR_DECIMATION
+    /**
+     * @brief The number of updates between measurements of the sensor.
+     */
+    uint8_t _measureEvery = 1;
+    /**
+     * @brief The number of updates left to skip before the sensor is measured
+     * again.
+     */
+    uint8_t _cyclesUntilDue = 0;
+    /**
+     * @brief True if the variables keep their last value when the sensor is
+     * skipped.
+     */
+    bool _keepLastValue = false;
+#endif
+#ifdef MS_SENSOR_QUARANTINE
+    /**
+     * @brief The total number of failed updates.
+     */
+    uint16_t _failedUpdates = 0;
+    /**
+     * @brief The number of failed updates in a row.
+     */
+    uint8_t _consecutiveFailures = 0;
+    /**
+     * @brief The number of updates left to skip while quarantined.
+     */
+    uint16_t _quarantineLeft = 0;
+#endif
+#ifdef MS_SHARE_SENSOR_RESULTS
+    /**
+     * @brief True if the sensor has results that could be used again.
+     */
+    bool _hasResults = false;
+    /**
+     * @brief The processor time the sensor's results were last averaged.
+     */
+    uint32_t _resultsTakenAt = 0;
+#endif
+#ifdef MS_LOGGER_RESULT_TIMES
+    /**
+     * @brief The processor time the last measurement result was added.
+     */
+    uint32_t _lastResultAt = 0;
+#endif
+#ifdef MS_SENSOR_DATA_READY
+    /**
+     * @brief Start listening for the data-ready interrupt of a new
+     * measurement.
+     */
+    void armDataReady(void);
+    /**
+     * @brief Stop listening for the data-ready interrupt.
+     */
+    void disarmDataReady(void);
+    /**
+     * @brief The pin the sensor signals a finished measurement on; -1 for
+     * none.
+     */
+    int8_t _dataReadyPin = -1;
+    /**
+     * @brief The change of the pin that means the data is ready.
+     */
+    uint8_t _dataReadyMode = FALLING;
+    /**
+     * @brief The position of the sensor in the table of data-ready sensors;
+     * 0xFF until it's given one.
+     */
+    uint8_t _dataReadySlot = 0xFF;
+    /**
+     * @brief True while the interrupt is attached.
+     */
+    bool _dataReadyArmed = false;
+    /**
+     * @brief Set by the interrupt when the sensor signals the data is ready.
+     */
+    volatile bool _dataReady = false;
+    /**
+     * @brief The data-ready interrupt for each slot of the table.
+     *
+     * @tparam slot The position in the table of data-ready sensors.
+     */
+    template <uint8_t slot>
+    static void dataReadyISR(void);
+#endif
     /**
      * @brief The number of included calculated variables from the
      * sensor, if any.
@@ -489,7 +1600,11 @@ class Sensor {
      * @brief Array with the number of valid measurement values taken by the
      * sensor in the current update cycle.
      */
-    uint8_t numberGoodMeasurementsMade[MAX_NUMBER_VARS];
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    measurementCount_t* numberGoodMeasurementsMade;
+#else
+    measurementCount_t numberGoodMeasurementsMade[MAX_NUMBER_VARS];
+#endif
 
     /**
      * @brief The time needed from the when a sensor has power until it's ready
@@ -510,6 +1625,18 @@ class Sensor {
      * readings are stable.
      */
     uint32_t _stabilizationTime_ms;
+    /**
+     * @brief The stabilization time to wait for after the current wake.
+     *
+     * @return **uint32_t** The #_sleepReady_ms after waking from a powered
+     * sleep (#MS_SENSOR_STANDBY), otherwise #_stabilizationTime_ms.
+     */
+    uint32_t stabilizationTime(void) {
+#ifdef MS_SENSOR_STANDBY
+        if (_sleptPowered) { return _sleepReady_ms; }
+#endif
+        return _stabilizationTime_ms;
+    }
     /**
      * @brief The processor elapsed time when the sensor was activiated - ie,
      * when the wake() function was run.
@@ -534,6 +1661,45 @@ class Sensor {
      * addSingleMeasurementResult() function.
      */
     uint32_t _millisMeasurementRequested = 0;
+    /**
+     * @brief Extra time in ms added to the #_measurementTime_ms of the current
+     * measurement by rescheduleMeasurement() or nextMeasurementStep().
+     */
+    uint32_t _measurementExtension_ms = 0;
+    /**
+     * @brief Push the end of the current measurement back to a time from now.
+     *
+     * A sensor whose read fails can call this from isMeasurementComplete() and
+     * try again when the measurement next completes, instead of waiting for
+     * the retry inline.  The new end is also reported by getNextDeadline().
+     * The extension is cleared when the next measurement is started.
+     *
+     * @param delay_ms The time from now until the measurement is complete.
+     */
+    void rescheduleMeasurement(uint32_t delay_ms);
+    /**
+     * @brief The step of a measurement taken in several steps that the sensor
+     * is on.
+     *
+     * The step is reset to 0 when a measurement is started and is moved on by
+     * nextMeasurementStep().
+     */
+    uint8_t _measurementStep = 0;
+    /**
+     * @brief Move the current measurement on to its next step and have that
+     * step run a time from now.
+     *
+     * A sensor driver that would otherwise wait inside one of its functions
+     * can instead do one step of its measurement each time
+     * isMeasurementComplete() finds the measurement time passed, call this
+     * and return false, so the other sensors are looked after in the
+     * meantime.  Unlike rescheduleMeasurement(), the next step can be sooner
+     * than the end of the measurement time.  The time of the step is also
+     * reported by getNextDeadline().
+     *
+     * @param delay_ms The time from now until the next step is due.
+     */
+    void nextMeasurementStep(uint32_t delay_ms);
 
     /**
      * @brief An 8-bit code for the sensor status
@@ -544,9 +1710,325 @@ class Sensor {
      * @brief An array for each sensor containing the variable objects tied to
      * that sensor.  The #MAX_NUMBER_VARS cannot be determined on a per-sensor
      * basis, because of the way memory is used on an Arduino.  It must be
-     * defined once for the whole class.
+     * defined once for the whole class, unless #MS_SENSOR_RESULT_POOL_SIZE is
+     * used.
      */
+#ifdef MS_SENSOR_RESULT_POOL_SIZE
+    Variable** variables;
+    /**
+     * @brief True if there wasn't room left in the result pool for this
+     * sensor.
+     */
+    bool _resultPoolOverflow;
+    /**
+     * @brief Take this sensor's result storage from the shared pool.
+     */
+    void takeResultStorage(void);
+#else
     Variable* variables[MAX_NUMBER_VARS];
+#endif
+
+    /**
+     * @brief The type of bus the sensor communicates over.
+     */
+    sensorBusType _busType = SENSOR_BUS_NONE;
+    /**
+     * @brief The identifier of the bus the sensor communicates over.
+     */
+    uintptr_t _busId = 0;
+    /**
+     * @brief Set the bus the sensor communicates over.
+     *
+     * This should be called from the constructor of any sensor that can share
+     * a bus with other sensors.
+     *
+     * @param busType The type of bus.
+     * @param busId The bus identifier; see getBusId().
+     */
+    void setBus(sensorBusType busType, uintptr_t busId);
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+    /**
+     * @brief The I2C clock speed in Hz this sensor is serviced at; 0 for
+     * #MS_I2C_DEFAULT_CLOCK.
+     */
+    uint32_t _i2cClock_hz = 0;
+#endif
+
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    /**
+     * @brief True if adaptive timing is enabled for this sensor.
+     */
+    bool _adaptiveTiming = false;
+    /**
+     * @brief The learned warm-up timing.
+     */
+    adaptivePhaseTiming _adaptiveWarmUp;
+    /**
+     * @brief The learned stabilization timing.
+     */
+    adaptivePhaseTiming _adaptiveStabilization;
+    /**
+     * @brief The processor time of the last readiness probe.
+     */
+    uint32_t _millisLastProbe = 0;
+    /**
+     * @brief Probe the sensor's readiness if a probe is due.
+     *
+     * @param timing The learned timing of the period being waited on.
+     * @param phaseStart The processor time the period began.
+     * @param warmUp True to probe for warm-up, false for stability.
+     * @return **bool** True if the sensor has confirmed it is ready during
+     * this period.
+     */
+    bool checkReadyEarly(adaptivePhaseTiming& timing, uint32_t phaseStart,
+                         bool warmUp);
+    /**
+     * @brief Get the processor time of the next readiness probe.
+     *
+     * @param timing The learned timing of the period being waited on.
+     * @param phaseStart The processor time the period began.
+     * @return **uint32_t** The processor time of the next probe.
+     */
+    uint32_t nextProbeTime(adaptivePhaseTiming& timing, uint32_t phaseStart);
+#endif
+
+#ifdef MS_CHECK_SENSOR_TIMING
+    /**
+     * @brief The recorded timing of each phase of the measurement cycle.
+     */
+    sensorPhaseStats _phaseStats[SENSOR_PHASE_COUNT];
+#endif
+
+#ifdef MS_SENSOR_BURST_STATS
+    /**
+     * @brief The position of the result burst statistics are kept for; -1 if
+     * they're off.
+     */
+    int8_t _burstResultNumber = -1;
+    /**
+     * @brief The statistics of the current or last burst.
+     */
+    sensorBurstStats _burstStats;
+    /**
+     * @brief The number of measurements taken in the current or last burst.
+     */
+    measurementCount_t _burstTaken = 0;
+    /**
+     * @brief The fewest measurements to take with adaptive averaging.
+     */
+    measurementCount_t _adaptiveMinReadings = 0;
+    /**
+     * @brief The standard error of the mean to stop at; 0 if adaptive
+     * averaging is off.
+     */
+    float _adaptiveStdError = 0;
+#endif
+#ifdef MS_SENSOR_ROBUST_AVERAGE
+    /**
+     * @brief How the measurements of #_robustResultNumber are combined.
+     */
+    sensorAverageMode _robustMode = SENSOR_AVERAGE_MEAN;
+    /**
+     * @brief The position of the result robust averaging is used for.
+     */
+    uint8_t _robustResultNumber = 0;
+    /**
+     * @brief The good measurements of the current window, in order.
+     */
+    float _robustWindow[MS_ROBUST_WINDOW_SIZE];
+    /**
+     * @brief The number of measurements in the current window.
+     */
+    uint8_t _robustCount = 0;
+    /**
+     * @brief The sum of the window estimates, each weighted by its number of
+     * measurements.
+     */
+    float _robustSum = 0;
+    /**
+     * @brief The number of measurements in the windows already reduced.
+     */
+    measurementCount_t _robustReduced = 0;
+#endif
 };
 
+
+#ifdef MS_CHECK_SENSOR_TIMING
+/**
+ * @anchor sensor_phase_time
+ * @name Sensor Phase Time
+ * The time a sensor spends in a single phase of its measurement cycle.
+ *
+ * @note This is only a testing/development diagnostic.
+ *
+ * {{ @ref Sensor_PhaseDuration::Sensor_PhaseDuration }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; phase times should have
+/// 3.
+#define SENSOR_PHASE_TIME_RESOLUTION 3
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "timeElapsed"
+#define SENSOR_PHASE_TIME_VAR_NAME MS_VAR_TEXT("timeElapsed")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "second"
+#define SENSOR_PHASE_TIME_UNIT_NAME MS_VAR_TEXT("second")
+/// @brief Default variable short code; "sensorPhaseSec"
+#define SENSOR_PHASE_TIME_DEFAULT_CODE "sensorPhaseSec"
+/**@}*/
+
+/**
+ * @brief The Variable sub-class used for the time a sensor spends in one phase
+ * of its measurement cycle.
+ *
+ * This is a calculated variable that reports one summary statistic (last,
+ * min, max, or mean) of the phase durations recorded by the sensor.  The
+ * value is in seconds and has a resolution of 1 ms.
+ *
+ * @note This is only a testing/development diagnostic.
+ *
+ * @ingroup base_classes
+ */
+class Sensor_PhaseDuration : public Variable {
+ public:
+    /**
+     * @brief Construct a new Sensor_PhaseDuration object.
+     *
+     * @param parentSense The sensor whose timing should be reported.
+     * @param phase The phase of the measurement cycle to report.
+     * @param stat The summary statistic to report; optional with a default of
+     * the last recorded duration.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "sensorPhaseSec".
+     */
+    Sensor_PhaseDuration(
+        Sensor* parentSense, sensorTimingPhase phase,
+        sensorTimingStat stat = SENSOR_TIMING_LAST, const char* uuid = "",
+        const char* varCode = SENSOR_PHASE_TIME_DEFAULT_CODE)
+        : Variable(&getPhaseDuration, this,
+                   (uint8_t)SENSOR_PHASE_TIME_RESOLUTION,
+                   SENSOR_PHASE_TIME_VAR_NAME, SENSOR_PHASE_TIME_UNIT_NAME,
+                   varCode, uuid),
+          _timedSensor(parentSense),
+          _phase(phase),
+          _stat(stat) {}
+    /**
+     * @brief Destroy the Sensor_PhaseDuration object - no action needed.
+     */
+    ~Sensor_PhaseDuration() {}
+
+ private:
+    static float getPhaseDuration(void* variable) {
+        Sensor_PhaseDuration* self =
+            static_cast<Sensor_PhaseDuration*>(variable);
+        return self->_timedSensor->getPhaseTime(self->_phase, self->_stat);
+    }
+    Sensor*           _timedSensor;
+    sensorTimingPhase _phase;
+    sensorTimingStat  _stat;
+};
+#endif
+
+
+#ifdef MS_SENSOR_BURST_STATS
+/**
+ * @brief The Variable sub-class used for a summary statistic of a burst of
+ * measurements from a sensor.
+ *
+ * This is a calculated variable that reports one summary statistic (mean,
+ * min, max, standard deviation, or count) of the result the sensor keeps
+ * burst statistics for; see Sensor::setBurstStatistics().  The variable name,
+ * unit, and resolution must be given, since they depend on the result.
+ *
+ * @ingroup base_classes
+ */
+class Sensor_BurstStatistic : public Variable {
+ public:
+    /**
+     * @brief Construct a new Sensor_BurstStatistic object.
+     *
+     * @param parentSense The sensor whose burst statistics should be reported.
+     * @param stat The summary statistic to report.
+     * @param decimalResolution The resolution (in decimal places) of the
+     * value.
+     * @param varName The name of the variable as given in the
+     * [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/).
+     * @param varUnit The unit of the variable as given in the
+     * [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/).
+     * @param varCode A short code for the variable to use in files.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     */
+    Sensor_BurstStatistic(Sensor* parentSense, sensorBurstStat stat,
+                          uint8_t decimalResolution, const char* varName,
+                          const char* varUnit, const char* varCode,
+                          const char* uuid = "")
+        : Variable(&getStatistic, this, decimalResolution, varName, varUnit,
+                   varCode, uuid),
+          _burstSensor(parentSense),
+          _stat(stat) {}
+    /**
+     * @brief Destroy the Sensor_BurstStatistic object - no action needed.
+     */
+    ~Sensor_BurstStatistic() {}
+
+ private:
+    static float getStatistic(void* variable) {
+        Sensor_BurstStatistic* self =
+            static_cast<Sensor_BurstStatistic*>(variable);
+        return self->_burstSensor->getBurstStatistic(self->_stat);
+    }
+    Sensor*         _burstSensor;
+    sensorBurstStat _stat;
+};
+#endif
+
+
+#ifdef MS_SENSOR_QUARANTINE
+/**
+ * @brief The Variable sub-class used for a health statistic of a sensor.
+ *
+ * This is a calculated variable that reports the total or consecutive number
+ * of failed updates of a sensor, or the number of updates it is still
+ * quarantined for; see #MS_SENSOR_QUARANTINE.
+ *
+ * @ingroup base_classes
+ */
+class Sensor_HealthStatistic : public Variable {
+ public:
+    /**
+     * @brief Construct a new Sensor_HealthStatistic object.
+     *
+     * @param parentSense The sensor whose health should be reported.
+     * @param stat The health statistic to report.
+     * @param varCode A short code for the variable to use in files; optional
+     * with a default value of "SensorHealth".
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     */
+    Sensor_HealthStatistic(Sensor* parentSense, sensorHealthStat stat,
+                           const char* varCode = "SensorHealth",
+                           const char* uuid    = "")
+        : Variable(&getStatistic, this, 0, "counter", "count", varCode, uuid),
+          _healthSensor(parentSense),
+          _stat(stat) {}
+    /**
+     * @brief Destroy the Sensor_HealthStatistic object - no action needed.
+     */
+    ~Sensor_HealthStatistic() {}
+
+ private:
+    static float getStatistic(void* variable) {
+        Sensor_HealthStatistic* self =
+            static_cast<Sensor_HealthStatistic*>(variable);
+        return self->_healthSensor->getHealthStatistic(self->_stat);
+    }
+    Sensor*          _healthSensor;
+    sensorHealthStat _stat;
+};
+#endif
+
 #endif  // SRC_SENSORBASE_H_
@@ -9,24 +9,43 @@
  */
 
 #include "VariableArray.h"
+#include "LoggerProfiler.h"
+#include "ClockScaler.h"
+
+#if defined(MS_USE_DEADLINE_SCHEDULER) && \
+    defined(MS_IDLE_BETWEEN_DEADLINES) &&  \
+    (defined(ARDUINO_ARCH_AVR) || defined(__AVR__))
+#include <avr/sleep.h>
+#endif
 
 
 // Constructors
-VariableArray::VariableArray() {}
+VariableArray::VariableArray() : _cycleState(nullptr) {}
 VariableArray::VariableArray(uint8_t variableCount, Variable* variableList[])
     : arrayOfVars(variableList),
-      _variableCount(variableCount) {
+      _variableCount(variableCount),
+      _cycleState(nullptr) {
+    buildSensorList();
     _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
 }
 VariableArray::VariableArray(uint8_t variableCount, Variable* variableList[],
                              const char* uuids[])
     : arrayOfVars(variableList),
-      _variableCount(variableCount) {
+      _variableCount(variableCount),
+      _cycleState(nullptr) {
+    buildSensorList();
     _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
     matchUUIDs(uuids);
 }
+VariableArray::VariableArray(uint8_t variableCount, Variable* variableList[],
+                             bool sensorsByObject)
+    : arrayOfVars(variableList),
+      _variableCount(variableCount),
+      _sensorsByObject(sensorsByObject),
+      _cycleState(nullptr) {
+    buildSensorList();
+    _maxSamplestoAverage = countMaxToAverage();
+}
 
 // Destructor
 VariableArray::~VariableArray() {}
@@ -36,8 +55,8 @@ void VariableArray::begin(uint8_t variableCount, Variable* variableList[],
     _variableCount = variableCount;
     arrayOfVars    = variableList;
 
+    buildSensorList();
     _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
     matchUUIDs(uuids);
     checkVariableUUIDs();
 }
@@ -45,13 +64,13 @@ void VariableArray::begin(uint8_t variableCount, Variable* variableList[]) {
     _variableCount = variableCount;
     arrayOfVars    = variableList;
 
+    buildSensorList();
     _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
     checkVariableUUIDs();
 }
 void VariableArray::begin() {
+    buildSensorList();
     _maxSamplestoAverage = countMaxToAverage();
-    _sensorCount         = getSensorCount();
     checkVariableUUIDs();
 }
 
@@ -106,35 +125,57 @@ bool VariableArray::setupSensors(void) {
     // Check for any sensors that have been set up outside of this (ie, the
     // modem)
     uint8_t nSensorsSetup = 0;
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)  // Skip non-unique sensors
-            && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0) ==
-                1  // already set up
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (bitRead(_sensors[s]->getStatus(), 0) == 1  // already set up
         ) {
-            MS_DBG(F("   "), arrayOfVars[i]->getParentSensorNameAndLocation(),
+            MS_DBG(F("   "), _sensors[s]->getSensorNameAndLocation(),
                    F("was already set up!"));
 
             nSensorsSetup++;
         }
     }
 
+#ifdef MS_PARALLEL_SENSOR_SETUP
+    // Note every sensor that's already on before powering the rest, so the
+    // warm-ups all run at the same time
+    bool wasOn[MAX_NUMBER_SENSORS];
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        wasOn[s] = _sensors[s]->checkPowerOn();
+    }
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (bitRead(_sensors[s]->getStatus(), 0) == 0 && !wasOn[s]) {
+            _sensors[s]->powerUp();
+        }
+    }
+#endif
+
     // We're going to keep looping through all of the sensors and check if each
     // one has been on long enough to be warmed up.  Once it has, we'll set it
     // up and increment the counter marking that's been done.
     // We keep looping until they've all been done.
     while (nSensorsSetup < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            if (isLastVarFromSensor(i)  // Skip non-unique sensors
-                && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0) ==
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            if (bitRead(_sensors[s]->getStatus(), 0) ==
                     0  // only set up if it has not yet been set up
+#ifdef MS_PARALLEL_SENSOR_SETUP
+                && _sensors[s]->isWarmedUp()  // and it's warmed up
+#endif
             ) {
                 MS_DBG(F("    Set up of"),
-                       arrayOfVars[i]->getParentSensorNameAndLocation(),
+                       _sensors[s]->getSensorNameAndLocation(),
                        F("..."));
 
-                bool sensorSuccess =
-                    arrayOfVars[i]->parentSensor->setup();  // set it up
+                bool sensorSuccess = _sensors[s]->setup();  // set it up
                 success &= sensorSuccess;
+#ifdef MS_SENSOR_LOCATION_CACHE
+                // The location may have been found in the setup
+                _sensors[s]->clearSensorLocation();
+#endif
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+                // Starting the Wire library can put the clock back to its
+                // default, so it's always set again after the setup
+                _sensors[s]->selectI2CClock(true);
+#endif
                 nSensorsSetup++;
 
                 if (!sensorSuccess) {
@@ -146,6 +187,20 @@ bool VariableArray::setupSensors(void) {
         }
     }
 
+#ifdef MS_PARALLEL_SENSOR_SETUP
+    // Power down the pins that were off before, unless another sensor on
+    // the same pin was already on
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        bool groupWasOn = false;
+        for (uint8_t t = 0; t < _sensorCount; t++) {
+            if (_powerPinGroup[t] == _powerPinGroup[s] && wasOn[t]) {
+                groupWasOn = true;
+            }
+        }
+        if (!groupWasOn) { _sensors[s]->powerDown(); }
+    }
+#endif
+
     if (success) { MS_DBG(F("... Success!")); }
 
     return success;
@@ -159,13 +214,11 @@ bool VariableArray::setupSensors(void) {
 // sensor.
 void VariableArray::sensorsPowerUp(void) {
     MS_DBG(F("Powering up sensors..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            MS_DBG(F("    Powering up"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation());
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        MS_DBG(F("    Powering up"),
+               _sensors[s]->getSensorNameAndLocation());
 
-            arrayOfVars[i]->parentSensor->powerUp();
-        }
+        _sensors[s]->powerUp();
     }
 }
 
@@ -188,13 +241,12 @@ bool VariableArray::sensorsWake(void) {
 
     // Check for any sensors that are awake outside of being sent a "wake"
     // command
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)  // Skip non-unique sensors
-            && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                1  // already attempted to wake
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (bitRead(_sensors[s]->getStatus(), 3) ==
+            1  // already attempted to wake
         ) {
             MS_DBG(F("    Wake up of"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(),
+                   _sensors[s]->getSensorNameAndLocation(),
                    F("has already been attempted."));
             nSensorsAwake++;
         }
@@ -205,26 +257,29 @@ bool VariableArray::sensorsWake(void) {
     // up and increment the counter marking that's been done.
     // We keep looping until they've all been done.
     while (nSensorsAwake < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
-            if (isLastVarFromSensor(i)  // Skip non-unique sensors
-                && bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            if (bitRead(_sensors[s]->getStatus(), 3) ==
                     0  // If no attempts yet made to wake the sensor up
-                && arrayOfVars[i]->parentSensor->isWarmedUp(
+                && _sensors[s]->isWarmedUp(
                        deepDebugTiming)  // and if it is already warmed up
             ) {
                 MS_DBG(F("    Wake up of"),
-                       arrayOfVars[i]->getParentSensorNameAndLocation(),
+                       _sensors[s]->getSensorNameAndLocation(),
                        F("..."));
 
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+                _sensors[s]->selectI2CClock();
+#endif
                 // Make a single attempt to wake the sensor after it is
                 // warmed up
-                bool sensorSuccess = arrayOfVars[i]->parentSensor->wake();
+                bool sensorSuccess = _sensors[s]->wake();
                 success &= sensorSuccess;
                 // We increment up the number of sensors awake/active,
                 // even if the wake up command failed!
                 nSensorsAwake++;
 
                 if (sensorSuccess) {
+                    _sensors[s]->markPhaseComplete(SENSOR_PHASE_WARM_UP);
                     MS_DBG(F("        ... wake up succeeded."));
                 } else {
                     MS_DBG(F("        ... wake up failed!"));
@@ -245,19 +300,20 @@ bool VariableArray::sensorsWake(void) {
 bool VariableArray::sensorsSleep(void) {
     MS_DBG(F("Putting sensors to sleep..."));
     bool success = true;
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            MS_DBG(F("    "), arrayOfVars[i]->getParentSensorNameAndLocation(),
-                   F("..."));
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        MS_DBG(F("    "), _sensors[s]->getSensorNameAndLocation(),
+               F("..."));
 
-            bool sensorSuccess = arrayOfVars[i]->parentSensor->sleep();
-            success &= sensorSuccess;
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+        _sensors[s]->selectI2CClock();
+#endif
+        bool sensorSuccess = _sensors[s]->sleep();
+        success &= sensorSuccess;
 
-            if (sensorSuccess) {
-                MS_DBG(F("        ... successfully put to sleep."));
-            } else {
-                MS_DBG(F("        ... failed to sleep!"));
-            }
+        if (sensorSuccess) {
+            MS_DBG(F("        ... successfully put to sleep."));
+        } else {
+            MS_DBG(F("        ... failed to sleep!"));
         }
     }
     return success;
@@ -271,13 +327,11 @@ bool VariableArray::sensorsSleep(void) {
 // sensor.
 void VariableArray::sensorsPowerDown(void) {
     MS_DBG(F("Powering down sensors..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            MS_DBG(F("    Powering down"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation());
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        MS_DBG(F("    Powering down"),
+               _sensors[s]->getSensorNameAndLocation());
 
-            arrayOfVars[i]->parentSensor->powerDown();
-        }
+        _sensors[s]->powerDown();
     }
 }
 
@@ -290,8 +344,41 @@ void VariableArray::sensorsPowerDown(void) {
 // a calculated variable will never be marked as the last variable from a
 // sensor.
 bool VariableArray::updateAllSensors(void) {
+    // Use the fixed bookkeeping arrays if there are any big enough, otherwise
+    // put them on the stack
+    if (_cycleState != nullptr && _cycleState->capacity >= _sensorCount) {
+        return updateAllSensors(*_cycleState);
+    }
+    measurementCount_t nMeasurementsCompleted[_sensorCount];
+    measurementCount_t nMeasurementsToAverage[_sensorCount];
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    sensorDeadline deadlineHeap[_sensorCount];
+#endif
+    updateCycleState state;
+    state.capacity               = _sensorCount;
+    state.nMeasurementsCompleted = nMeasurementsCompleted;
+    state.nMeasurementsToAverage = nMeasurementsToAverage;
+    state.nMeasurementsOnPin     = nullptr;
+    state.nCompletedOnPin        = nullptr;
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    state.deadlineHeap = deadlineHeap;
+#endif
+#ifdef MS_STAGGER_POWER_UP
+    state.powerUpAt = nullptr;
+#endif
+    return updateAllSensors(state);
+}
+bool VariableArray::updateAllSensors(updateCycleState& state) {
     bool    success           = true;
     uint8_t nSensorsCompleted = 0;
+#ifdef MS_SHARE_SENSOR_RESULTS
+    uint32_t cycleStart = millis();
+#endif
+
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    // The cached values are about to be out of date
+    _valueCacheValid = false;
+#endif
 
 #ifdef MS_VARIABLEARRAY_DEBUG_DEEP
     bool deepDebugTiming = true;
@@ -299,120 +386,158 @@ bool VariableArray::updateAllSensors(void) {
     bool deepDebugTiming = false;
 #endif
 
-    // Create an array with the unique-ness value (so we can skip the function
-    // calls later)
-    MS_DBG(F("Creating a mask array with the uniqueness for each sensor.."));
-    bool lastSensorVariable[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        lastSensorVariable[i] = isLastVarFromSensor(i);
+    // Zero the bookkeeping array for the number of measurements already
+    // completed
+    MS_DBG(F("Zeroing the number of completed measurements.."));
+    measurementCount_t* nMeasurementsCompleted =
+        state.nMeasurementsCompleted;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nMeasurementsCompleted[s] = 0;
     }
 
-    // Create an array for the number of measurements already completed and set
-    // all to zero
-    MS_DBG(F("Creating an array for the number of completed measurements.."));
-    uint8_t nMeasurementsCompleted[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        nMeasurementsCompleted[i] = 0;
+    // Fill the bookkeeping array for the number of measurements to average
+    // (another short cut)
+    MS_DBG(F("Filling in the number of measurements to average.."));
+    measurementCount_t* nMeasurementsToAverage =
+        state.nMeasurementsToAverage;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nMeasurementsToAverage[s] =
+            _sensors[s]->getNumberMeasurementsToAverage();
     }
 
-    // Create an array for the number of measurements to average (another short
-    // cut)
-    MS_DBG(F("Creating an array with the number of measurements to average.."));
-    uint8_t nMeasurementsToAverage[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            nMeasurementsToAverage[i] =
-                arrayOfVars[i]->parentSensor->getNumberMeasurementsToAverage();
-        } else {
-            nMeasurementsToAverage[i] = 0;
+#ifdef MS_SHARE_SENSOR_RESULTS
+    // Sensors another array just measured are done before we start
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        Sensor* sensor = _sensors[s];
+        if (sensor->hasFreshResults(cycleStart)) {
+            MS_DBG(sensor->getSensorNameAndLocation(),
+                   F("was just measured; using its results again"));
+            nMeasurementsToAverage[s] = 0;
+            nSensorsCompleted++;
         }
     }
+#endif
 
     // Clear the initial variable arrays
     MS_DBG(F("----->> Clearing all results arrays before taking new "
              "measurements. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            arrayOfVars[i]->parentSensor->clearValues();
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+#ifdef MS_SHARE_SENSOR_RESULTS
+        if (_sensors[s]->hasFreshResults(cycleStart)) {
+            continue;
         }
+#endif
+        _sensors[s]->clearValues();
     }
     MS_DBG(F("    ... Complete. <<-----"));
 
     // Check for any sensors that didn't wake up and mark them as "complete" so
     // they will be skipped in further looping.
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]  // Skip non-unique sensors
-            && (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                    0  // No attempt made to wake the sensor up
-                || bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4) ==
-                    0  // OR Wake up failed
-                )) {
-            MS_DBG(i, F("--->>"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(),
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+#ifdef MS_SHARE_SENSOR_RESULTS
+        // A sensor whose results are used again was never meant to be awake
+        if (nMeasurementsToAverage[s] == 0) continue;
+#endif
+        if (bitRead(_sensors[s]->getStatus(), 3) ==
+                0  // No attempt made to wake the sensor up
+            || bitRead(_sensors[s]->getStatus(), 4) == 0  // OR Wake up failed
+        ) {
+            MS_DBG(s, F("--->>"),
+                   _sensors[s]->getSensorNameAndLocation(),
                    F("isn't awake/active!  No measurements will be taken! "
                      "<<---"),
-                   i);
+                   s);
 
             // Set the number of measurements already equal to whatever
             // total number requested to ensure the sensor is skipped in
             // further loops.
-            nMeasurementsCompleted[i] = nMeasurementsToAverage[i];
+            nMeasurementsCompleted[s] = nMeasurementsToAverage[s];
             // Bump up the finished count.
             nSensorsCompleted++;
         }
     }
 
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    // Queue up every sensor that still has measurements to take
+    sensorDeadline* deadlineHeap = state.deadlineHeap;
+    uint8_t        heapSize = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (nMeasurementsToAverage[s] > nMeasurementsCompleted[s]) {
+            pushDeadline(deadlineHeap, heapSize, s);
+        }
+    }
+#endif
+
     while (nSensorsCompleted < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
+        MS_PROFILE_SAMPLE();
+#ifdef MS_USE_DEADLINE_SCHEDULER
+        // Only check on the sensor with the earliest deadline, and don't touch
+        // it at all until that deadline arrives.
+        if (heapSize == 0) break;
+        sensorDeadline next = popDeadline(deadlineHeap, heapSize);
+        waitForDeadline(next.deadline);
+        uint8_t firstSensor = next.sensorNumber;
+        uint8_t endSensor   = next.sensorNumber + 1;
+#else
+        uint8_t firstSensor = 0;
+        uint8_t endSensor   = _sensorCount;
+#endif
+        for (uint8_t s = firstSensor; s < endSensor; s++) {
             /***
             // THIS IS PURELY FOR DEEP DEBUGGING OF THE TIMING!
             // Leave this whole section commented out unless you want excessive
             // printouts (ie, thousands of lines) of the timing information!!
-            if (lastSensorVariable[i] and
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i])
+            if (nMeasurementsToAverage[s] > nMeasurementsCompleted[s])
             {
-                MS_DEEP_DBG(i), '-',
-            arrayOfVars[i]->getParentSensorNameAndLocation(), F("- millis:"),
+                MS_DEEP_DBG(s), '-',
+            _sensors[s]->getSensorNameAndLocation(), F("- millis:"),
             millis(), F("- status: 0b"),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            7), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 6),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            5), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            3), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 2),
-                           bitRead(arrayOfVars[i]->parentSensor->getStatus(),
-            1), bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0), F("-
-            measurement #"), (nMeasurementsCompleted[i] + 1);
+                           bitRead(_sensors[s]->getStatus(),
+            7), bitRead(_sensors[s]->getStatus(), 6),
+                           bitRead(_sensors[s]->getStatus(),
+            5), bitRead(_sensors[s]->getStatus(), 4),
+                           bitRead(_sensors[s]->getStatus(),
+            3), bitRead(_sensors[s]->getStatus(), 2),
+                           bitRead(_sensors[s]->getStatus(),
+            1), bitRead(_sensors[s]->getStatus(), 0), F("-
+            measurement #"), (nMeasurementsCompleted[s] + 1);
             }
             // END CHUNK FOR DEBUGGING!
             ***/
 
             // Only do checks on sensors that still have measurements to finish
-            if (lastSensorVariable[i] &&
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i]) {
+            // and that aren't waiting for another sensor to free their bus
+            if (nMeasurementsToAverage[s] > nMeasurementsCompleted[s] &&
+                findBusHolder(s) == nullptr) {
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+                _sensors[s]->selectI2CClock();
+#endif
                 // first, make sure the sensor is stable
-                if (arrayOfVars[i]->parentSensor->isStable(deepDebugTiming)) {
+                if (_sensors[s]->isStable(deepDebugTiming)) {
                     // now, if the sensor is not currently measuring...
-                    if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 5) ==
+                    if (bitRead(_sensors[s]->getStatus(), 5) ==
                         0) {  // NO attempt yet to start a measurement
                         // Start a reading
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
+                        MS_DBG(s, '.', nMeasurementsCompleted[s] + 1,
                                F("--->> Starting reading"),
-                               nMeasurementsCompleted[i] + 1, F("on"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
+                               nMeasurementsCompleted[s] + 1, F("on"),
+                               _sensors[s]->getSensorNameAndLocation(),
                                '-');
 
                         bool sensorSuccess_start =
-                            arrayOfVars[i]
-                                ->parentSensor->startSingleMeasurement();
+                            _sensors[s]->startSingleMeasurement();
                         success &= sensorSuccess_start;
 
                         if (sensorSuccess_start) {
-                            MS_DBG(F("   ... reading started! <<---"), i, '.',
-                                   nMeasurementsCompleted[i] + 1);
+                            if (nMeasurementsCompleted[s] == 0) {
+                                _sensors[s]->markPhaseComplete(
+                                    SENSOR_PHASE_STABILIZATION);
+                            }
+                            MS_DBG(F("   ... reading started! <<---"), s, '.',
+                                   nMeasurementsCompleted[s] + 1);
                         } else {
                             MS_DBG(F("   ... failed to start reading! <<---"),
-                                   i, '.', nMeasurementsCompleted[i] + 1);
+                                   s, '.', nMeasurementsCompleted[s] + 1);
                         }
                     }
 
@@ -424,39 +549,47 @@ bool VariableArray::updateAllSensors(void) {
                     // measurement failed (bit 6 not set).  In that case, the
                     // addSingleMeasurementResult() will be "adding" -9999
                     // values.
-                    if (arrayOfVars[i]->parentSensor->isMeasurementComplete(
-                            deepDebugTiming)) {
+                    if (_sensors[s]->isMeasurementComplete(deepDebugTiming)) {
                         // Get the value
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
+                        MS_DBG(s, '.', nMeasurementsCompleted[s] + 1,
                                F("--->> Collected result of reading"),
-                               nMeasurementsCompleted[i] + 1, F("from"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
+                               nMeasurementsCompleted[s] + 1, F("from"),
+                               _sensors[s]->getSensorNameAndLocation(),
                                F("..."));
 
-                        bool sensorSuccess_result =
-                            arrayOfVars[i]
-                                ->parentSensor->addSingleMeasurementResult();
+                        if (bitRead(_sensors[s]->getStatus(), 6) == 1) {
+                            _sensors[s]->markPhaseComplete(
+                                SENSOR_PHASE_MEASUREMENT);
+                        }
+                        uint32_t retrievalStart = millis();
+                        bool     sensorSuccess_result =
+                            _sensors[s]->addSingleMeasurementResult();
+                        _sensors[s]->recordPhaseTime(
+                            SENSOR_PHASE_RETRIEVAL, millis() - retrievalStart);
                         success &= sensorSuccess_result;
-                        nMeasurementsCompleted[i] +=
+                        nMeasurementsCompleted[s] +=
                             1;  // increment the number of measurements that
                                 // sensor has completed
+#ifdef MS_SENSOR_BURST_STATS
+                        checkEnoughMeasurements(state, s);
+#endif
 
                         if (sensorSuccess_result) {
-                            MS_DBG(F("   ... got measurement result. <<---"), i,
-                                   '.', nMeasurementsCompleted[i]);
+                            MS_DBG(F("   ... got measurement result. <<---"), s,
+                                   '.', nMeasurementsCompleted[s]);
                         } else {
                             MS_DBG(F("   ... failed to get measurement result! "
                                      "<<---"),
-                                   i, '.', nMeasurementsCompleted[i]);
+                                   s, '.', nMeasurementsCompleted[s]);
                         }
                     }
                 }
 
                 // if all the measurements are done, mark the whole sensor as
                 // done
-                if (nMeasurementsCompleted[i] == nMeasurementsToAverage[i]) {
+                if (nMeasurementsCompleted[s] == nMeasurementsToAverage[s]) {
                     MS_DBG(F("--- Finished all measurements from"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
+                           _sensors[s]->getSensorNameAndLocation(),
                            F("---"));
 
                     nSensorsCompleted++;
@@ -465,22 +598,42 @@ bool VariableArray::updateAllSensors(void) {
                 }
             }
         }
+#ifdef MS_USE_DEADLINE_SCHEDULER
+        // Put the sensor back in the queue if it isn't finished
+        if (nMeasurementsToAverage[next.sensorNumber] >
+            nMeasurementsCompleted[next.sensorNumber]) {
+            pushDeadline(deadlineHeap, heapSize, next.sensorNumber);
+        }
+#endif
     }
 
     // Average measurements and notify varibles of the updates
     MS_DBG(F("----->> Averaging results and notifying all variables. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            MS_DEEP_DBG(F("--- Averaging results from"),
-                        arrayOfVars[i]->getParentSensorNameAndLocation(),
-                        F("---"));
-            arrayOfVars[i]->parentSensor->averageMeasurements();
-            MS_DEEP_DBG(F("--- Notifying variables from"),
-                        arrayOfVars[i]->getParentSensorNameAndLocation(),
-                        F("---"));
-            arrayOfVars[i]->parentSensor->notifyVariables();
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+#ifdef MS_SHARE_SENSOR_RESULTS
+        if (_sensors[s]->hasFreshResults(cycleStart)) {
+            refreshVariables(_sensors[s]);
+            continue;
         }
+#endif
+        MS_DEEP_DBG(F("--- Averaging results from"),
+                    _sensors[s]->getSensorNameAndLocation(),
+                    F("---"));
+        _sensors[s]->averageMeasurements();
+        MS_DEEP_DBG(F("--- Notifying variables from"),
+                    _sensors[s]->getSensorNameAndLocation(),
+                    F("---"));
+        _sensors[s]->notifyVariables();
+#ifdef MS_SHARE_SENSOR_RESULTS
+        refreshVariables(_sensors[s]);
+#endif
     }
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    evaluateCalculatedVariables();
+#endif
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    cacheValueStrings();
+#endif
     MS_DBG(F("... Complete. <<-----"));
 
     return success;
@@ -490,8 +643,58 @@ bool VariableArray::updateAllSensors(void) {
 // This function is an even more complete version of the updateAllSensors
 // function - it handles power up/down and wake/sleep.
 bool VariableArray::completeUpdate(void) {
+    // Use the fixed bookkeeping arrays if there are any big enough, otherwise
+    // put them on the stack
+    if (_cycleState != nullptr && _cycleState->capacity >= _sensorCount) {
+        return completeUpdate(*_cycleState);
+    }
+    measurementCount_t nMeasurementsCompleted[_sensorCount];
+    measurementCount_t nMeasurementsToAverage[_sensorCount];
+    measurementCount_t nMeasurementsOnPin[_sensorCount];
+    measurementCount_t nCompletedOnPin[_sensorCount];
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    sensorDeadline deadlineHeap[_sensorCount];
+#endif
+#ifdef MS_STAGGER_POWER_UP
+    uint32_t powerUpAt[_sensorCount];
+#endif
+    updateCycleState state;
+    state.capacity               = _sensorCount;
+    state.nMeasurementsCompleted = nMeasurementsCompleted;
+    state.nMeasurementsToAverage = nMeasurementsToAverage;
+    state.nMeasurementsOnPin     = nMeasurementsOnPin;
+    state.nCompletedOnPin        = nCompletedOnPin;
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    state.deadlineHeap = deadlineHeap;
+#endif
+#ifdef MS_STAGGER_POWER_UP
+    state.powerUpAt = powerUpAt;
+#endif
+    return completeUpdate(state);
+}
+
+
+// This finds the time the slowest sensor needs for all of its measurements
+uint32_t VariableArray::getExpectedUpdateTime(void) {
+    uint32_t slowest = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        uint32_t duration = _sensors[s]->getExpectedDuration(
+            _sensors[s]->getNumberMeasurementsToAverage());
+        if (duration > slowest) { slowest = duration; }
+    }
+    return slowest;
+}
+bool VariableArray::completeUpdate(updateCycleState& state) {
     bool    success           = true;
     uint8_t nSensorsCompleted = 0;
+#if defined(MS_STAGGER_POWER_UP) || defined(MS_SHARE_SENSOR_RESULTS)
+    uint32_t cycleStart = millis();
+#endif
+
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    // The cached values are about to be out of date
+    _valueCacheValid = false;
+#endif
 
 #ifdef MS_VARIABLEARRAY_DEBUG_DEEP
     bool deepDebugTiming = true;
@@ -499,244 +702,283 @@ bool VariableArray::completeUpdate(void) {
     bool deepDebugTiming = false;
 #endif
 
-    // Create an array with the unique-ness value (so we can skip the function
-    // calls later)
-    MS_DBG(F("Creating a mask array with the uniqueness for each sensor.."));
-    bool lastSensorVariable[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        lastSensorVariable[i] = isLastVarFromSensor(i);
+    // Zero the bookkeeping array for the number of measurements already
+    // completed
+    MS_DBG(F("Zeroing the number of completed measurements.."));
+    measurementCount_t* nMeasurementsCompleted =
+        state.nMeasurementsCompleted;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nMeasurementsCompleted[s] = 0;
     }
 
-    // Create an array for the number of measurements already completed and set
-    // all to zero
-    MS_DBG(F("Creating an array for the number of completed measurements.."));
-    uint8_t nMeasurementsCompleted[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        nMeasurementsCompleted[i] = 0;
+    // Fill the bookkeeping array for the number of measurements to average
+    // (another short cut)
+    MS_DBG(F("Filling in the number of measurements to average.."));
+    measurementCount_t* nMeasurementsToAverage =
+        state.nMeasurementsToAverage;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nMeasurementsToAverage[s] =
+            _sensors[s]->getNumberMeasurementsToAverage();
     }
 
-    // Create an array for the number of measurements to average (another short
-    // cut)
-    MS_DBG(F("Creating an array with the number of measurements to average.."));
-    uint8_t nMeasurementsToAverage[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            nMeasurementsToAverage[i] =
-                arrayOfVars[i]->parentSensor->getNumberMeasurementsToAverage();
-        } else {
-            nMeasurementsToAverage[i] = 0;
+#if defined(MS_SENSOR_DECIMATION) || defined(MS_SENSOR_QUARANTINE) || \
+    defined(MS_SHARE_SENSOR_RESULTS)
+    // Skip any sensors that aren't due this time, are quarantined, or were
+    // just measured by another array by giving them nothing to measure;
+    // they're done before we start
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        Sensor* sensor = _sensors[s];
+        bool    skip   = false;
+#ifdef MS_SHARE_SENSOR_RESULTS
+        // A sensor used again isn't counted off for decimation or quarantine
+        if (sensor->hasFreshResults(cycleStart)) {
+            MS_DBG(sensor->getSensorNameAndLocation(),
+                   F("was just measured; using its results again"));
+            nMeasurementsToAverage[s] = 0;
+            nSensorsCompleted++;
+            continue;
         }
-    }
-
-    // Create an array of the power pins
-    MS_DBG(F("Creating an array of the power pins.."));
-    int8_t powerPins[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            powerPins[i] = arrayOfVars[i]->parentSensor->getPowerPin();
-        } else {
-            powerPins[i] = 0;
+#endif
+#ifdef MS_SENSOR_DECIMATION
+        skip |= !sensor->checkDueThisCycle();
+#endif
+#ifdef MS_SENSOR_QUARANTINE
+        skip |= sensor->checkQuarantine();
+#endif
+        if (skip) {
+            nMeasurementsToAverage[s] = 0;
+            nSensorsCompleted++;
         }
     }
+#endif
 
-    // Create an array of the last variable on each power pin
-    MS_DBG(F("Creating arrays of the power pin locations.."));
-    bool lastPinVariable[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { lastPinVariable[i] = true; }
-    // Create an array containing the index of the power pin in the powerPins
-    // array
-    int8_t powerPinIndex[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { powerPinIndex[i] = 0; }
-    // Create an array to tell us how many measurements must be taken
-    // before all the sensors attached to a power pin are done
-    uint8_t nMeasurementsOnPin[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        nMeasurementsOnPin[i] = nMeasurementsToAverage[i];
-    }
-    // Now correctly populate the previous three arrays
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        for (uint8_t j = i + 1; j < _variableCount; j++) {
-            if (!lastSensorVariable[i]) {
-                lastPinVariable[i] = false;
-            } else if (powerPins[i] == powerPins[j]) {
-                lastPinVariable[i] = false;
-            }
-            i++;
-        }
+    // Fill the bookkeeping arrays that tell us how many measurements must be
+    // taken before all the sensors attached to a power pin are done and how
+    // many have already been taken.  These are indexed by the first sensor on
+    // each power pin.
+    MS_DBG(F("Counting the measurements on each power pin.."));
+    measurementCount_t* nMeasurementsOnPin = state.nMeasurementsOnPin;
+    measurementCount_t* nCompletedOnPin    = state.nCompletedOnPin;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nMeasurementsOnPin[s] = 0;
+        nCompletedOnPin[s]    = 0;
     }
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastPinVariable[i]) {
-            powerPinIndex[i]      = i;
-            nMeasurementsOnPin[i] = nMeasurementsToAverage[i];
-            for (uint8_t j = 0; j < _variableCount; j++) {
-                if (powerPins[j] == powerPins[i] && i != j) {
-                    powerPinIndex[j] = i;
-                    nMeasurementsOnPin[i] += nMeasurementsToAverage[j];
-                    nMeasurementsOnPin[j] = 0;
-                }
-            }
-        }
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nMeasurementsOnPin[_powerPinGroup[s]] += nMeasurementsToAverage[s];
     }
 
 // This is just for debugging
-#ifdef MS_VARIABLEARRAY_DEBUG_DEEP
-    uint8_t arrayPositions[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { arrayPositions[i] = i; }
-    String nameLocation[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        // nameLocation[i] = arrayOfVars[i]->getParentSensorNameAndLocation();
-        nameLocation[i] = arrayOfVars[i]->getParentSensorName();
+#if defined(MS_VARIABLEARRAY_DEBUG_DEEP) && !defined(MS_NO_STRING_GETTERS)
+    String nameLocation[_sensorCount];
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        nameLocation[s] = arrayOfVars[_sensorList[s]]->getParentSensorName();
     }
     MS_DEEP_DBG(F("----------------------------------"));
-    MS_DEEP_DBG(F("arrayPositions:\t\t\t"));
-    prettyPrintArray(arrayPositions);
+    MS_DEEP_DBG(F("sensorList:\t\t\t"));
+    prettyPrintArray(_sensorList, _sensorCount);
     MS_DEEP_DBG(F("sensor:\t\t\t"));
-    prettyPrintArray(nameLocation);
-    MS_DEEP_DBG(F("lastSensorVariable:\t\t"));
-    prettyPrintArray(lastSensorVariable);
+    prettyPrintArray(nameLocation, _sensorCount);
     MS_DEEP_DBG(F("nMeasurementsToAverage:\t\t"));
-    prettyPrintArray(nMeasurementsToAverage);
-    MS_DEEP_DBG(F("nMeasurementsCompleted:\t\t"));
-    prettyPrintArray(nMeasurementsCompleted);
-    MS_DEEP_DBG(F("powerPins:\t\t\t"));
-    prettyPrintArray(powerPins);
-    MS_DEEP_DBG(F("lastPinVariable:\t\t"));
-    prettyPrintArray(lastPinVariable);
-    MS_DEEP_DBG(F("powerPinIndex:\t\t\t"));
-    prettyPrintArray(powerPinIndex);
+    prettyPrintArray(nMeasurementsToAverage, _sensorCount);
+    MS_DEEP_DBG(F("powerPinGroup:\t\t\t"));
+    prettyPrintArray(_powerPinGroup, _sensorCount);
     MS_DEEP_DBG(F("nMeasurementsOnPin:\t\t"));
-    prettyPrintArray(nMeasurementsOnPin);
-    MS_DEEP_DBG(F("powerPinIndex:\t\t\t"));
-    prettyPrintArray(powerPinIndex);
+    prettyPrintArray(nMeasurementsOnPin, _sensorCount);
 #endif
 
-    // Another array for the number of measurements already completed per power
-    // pin
-    uint8_t nCompletedOnPin[_variableCount];
-    for (uint8_t i = 0; i < _variableCount; i++) { nCompletedOnPin[i] = 0; }
-
     // Clear the initial variable arrays
     MS_DBG(F("----->> Clearing all results arrays before taking new "
              "measurements. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            arrayOfVars[i]->parentSensor->clearValues();
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+#ifdef MS_SENSOR_DECIMATION
+        // Leave the last values in place for a skipped sensor that keeps them
+        if (nMeasurementsToAverage[s] == 0 && _sensors[s]->getKeepLastValue()) {
+            continue;
         }
+#endif
+#ifdef MS_SHARE_SENSOR_RESULTS
+        if (_sensors[s]->hasFreshResults(cycleStart)) {
+            continue;
+        }
+#endif
+        _sensors[s]->clearValues();
     }
     MS_DBG(F("   ... Complete. <<-----"));
 
+#ifdef MS_STAGGER_POWER_UP
+    // Power up each pin only when it's needed to finish with the slowest
+    MS_DBG(F("----->> Planning staggered power up of sensors. ..."));
+    planPowerUps(state);
+    powerUpDueGroups(state, cycleStart);
+#else
     // power up all of the sensors together
     MS_DBG(F("----->> Powering up all sensors together. ..."));
+#if defined(MS_SENSOR_DECIMATION) || defined(MS_SENSOR_QUARANTINE) || \
+    defined(MS_SHARE_SENSOR_RESULTS)
+    // Only the sensors that are due; a shared power pin is only switched on
+    // if one of its sensors is
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (nMeasurementsToAverage[s] == 0) continue;
+        _sensors[s]->powerUp();
+    }
+#else
     sensorsPowerUp();
+#endif
+#endif
     MS_DBG(F("   ... Complete. <<-----"));
 
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    // Queue up every sensor that still has measurements to take
+    sensorDeadline* deadlineHeap = state.deadlineHeap;
+    uint8_t        heapSize = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (nMeasurementsToAverage[s] > nMeasurementsCompleted[s]) {
+#ifdef MS_STAGGER_POWER_UP
+            pushDeadline(deadlineHeap, heapSize, s, state.powerUpAt,
+                         cycleStart);
+#else
+            pushDeadline(deadlineHeap, heapSize, s);
+#endif
+        }
+    }
+#endif
+
     while (nSensorsCompleted < _sensorCount) {
-        for (uint8_t i = 0; i < _variableCount; i++) {
+        MS_PROFILE_SAMPLE();
+#ifdef MS_LOGGER_OVERLAP_MODEM
+        if (_updatePoll != nullptr) { _updatePoll(_updatePollContext); }
+#endif
+#ifdef MS_STAGGER_POWER_UP
+        powerUpDueGroups(state, cycleStart);
+#endif
+#ifdef MS_USE_DEADLINE_SCHEDULER
+        // Only check on the sensor with the earliest deadline, and don't touch
+        // it at all until that deadline arrives.
+        if (heapSize == 0) break;
+        sensorDeadline next = popDeadline(deadlineHeap, heapSize);
+        waitForDeadline(next.deadline);
+#ifdef MS_STAGGER_POWER_UP
+        // The deadline may be the time a group is due to be powered
+        powerUpDueGroups(state, cycleStart);
+#endif
+        uint8_t firstSensor = next.sensorNumber;
+        uint8_t endSensor   = next.sensorNumber + 1;
+#else
+        uint8_t firstSensor = 0;
+        uint8_t endSensor   = _sensorCount;
+#endif
+        for (uint8_t s = firstSensor; s < endSensor; s++) {
             /***
             // THIS IS PURELY FOR DEEP DEBUGGING OF THE TIMING!
             // Leave this whole section commented out unless you want excessive
             // printouts (ie, thousands of lines) of the timing information!!
-            if (lastSensorVariable[i] and
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i]) {
+            if (nMeasurementsToAverage[s] > nMeasurementsCompleted[s]) {
                 MS_DEEP_DBG(
-                    i, '-', arrayOfVars[i]->getParentSensorNameAndLocation(),
+                    s, '-', _sensors[s]->getSensorNameAndLocation(),
                     F("- millis:"), millis(), F("- status: 0b"),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 7),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 6),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 5),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 2),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 1),
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0),
-                    F("- measurement #"), (nMeasurementsCompleted[i] + 1));
+                    bitRead(_sensors[s]->getStatus(), 7),
+                    bitRead(_sensors[s]->getStatus(), 6),
+                    bitRead(_sensors[s]->getStatus(), 5),
+                    bitRead(_sensors[s]->getStatus(), 4),
+                    bitRead(_sensors[s]->getStatus(), 3),
+                    bitRead(_sensors[s]->getStatus(), 2),
+                    bitRead(_sensors[s]->getStatus(), 1),
+                    bitRead(_sensors[s]->getStatus(), 0),
+                    F("- measurement #"), (nMeasurementsCompleted[s] + 1));
             }
             MS_DEEP_DBG(F("----------------------------------"));
             MS_DEEP_DBG(F("nMeasurementsToAverage:\t\t"));
-            prettyPrintArray(nMeasurementsToAverage);
+            prettyPrintArray(nMeasurementsToAverage, _sensorCount);
             MS_DEEP_DBG(F("nMeasurementsCompleted:\t\t"));
-            prettyPrintArray(nMeasurementsCompleted);
+            prettyPrintArray(nMeasurementsCompleted, _sensorCount);
             MS_DEEP_DBG(F("nMeasurementsOnPin:\t\t"));
-            prettyPrintArray(nMeasurementsOnPin);
+            prettyPrintArray(nMeasurementsOnPin, _sensorCount);
             MS_DEEP_DBG(F("nCompletedOnPin:\t\t\t"));
-            prettyPrintArray(nCompletedOnPin);
+            prettyPrintArray(nCompletedOnPin, _sensorCount);
             // END CHUNK FOR DEBUGGING!
             ***/
 
             // Only do checks on sensors that still have measurements to finish
-            if (lastSensorVariable[i] &&
-                nMeasurementsToAverage[i] > nMeasurementsCompleted[i]) {
-                if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
+            // and that aren't waiting for another sensor to free their bus
+            // (or, when staggering, for their time to be powered up)
+            if (nMeasurementsToAverage[s] > nMeasurementsCompleted[s] &&
+#ifdef MS_STAGGER_POWER_UP
+                state.powerUpAt[_powerPinGroup[s]] == VA_POWERED_UP &&
+#endif
+                findBusHolder(s) == nullptr) {
+#ifdef MS_I2C_CLOCK_PER_SENSOR
+                _sensors[s]->selectI2CClock();
+#endif
+                if (bitRead(_sensors[s]->getStatus(), 3) ==
                         0  // If no attempts yet made to wake the sensor up
-                    && arrayOfVars[i]->parentSensor->isWarmedUp(
+                    && _sensors[s]->isWarmedUp(
                            deepDebugTiming)  // and if it is already warmed up
                 ) {
-                    MS_DBG(i, F("--->> Waking"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
+                    MS_DBG(s, F("--->> Waking"),
+                           _sensors[s]->getSensorNameAndLocation(),
                            F("..."));
 
                     // Make a single attempt to wake the sensor after it is
                     // warmed up
-                    bool sensorSuccess_wake =
-                        arrayOfVars[i]->parentSensor->wake();
+                    bool sensorSuccess_wake = _sensors[s]->wake();
                     success &= sensorSuccess_wake;
 
                     if (sensorSuccess_wake) {
-                        MS_DBG(F("   ... wake up success. <<---"), i);
+                        _sensors[s]->markPhaseComplete(SENSOR_PHASE_WARM_UP);
+                        MS_DBG(F("   ... wake up success. <<---"), s);
                     } else {
-                        MS_DBG(F("   ... wake up failed! <<---"), i);
+                        MS_DBG(F("   ... wake up failed! <<---"), s);
                     }
                 }
 
                 // If attempts were made to wake the sensor, but they failed
                 // then we're just bumping up the number of measurements to
                 // completion
-                if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 3) ==
-                        1 &&
-                    bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4) ==
-                        0) {
-                    MS_DBG(i, F("--->>"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
+                if (bitRead(_sensors[s]->getStatus(), 3) == 1 &&
+                    bitRead(_sensors[s]->getStatus(), 4) == 0) {
+                    MS_DBG(s, F("--->>"),
+                           _sensors[s]->getSensorNameAndLocation(),
                            F("did not wake up! No measurements will be taken! "
                              "<<---"),
-                           i);
+                           s);
                     // Set the number of measurements already equal to whatever
                     // total number requested to ensure the sensor is skipped in
                     // further loops.
-                    nMeasurementsCompleted[i] = nMeasurementsToAverage[i];
+                    nMeasurementsCompleted[s] = nMeasurementsToAverage[s];
                     // increment the number of measurements that the power pin
                     // has completed
-                    nCompletedOnPin[powerPinIndex[i]] +=
-                        nMeasurementsToAverage[i];
+                    nCompletedOnPin[_powerPinGroup[s]] +=
+                        nMeasurementsToAverage[s];
                 }
 
                 // If the sensor was successfully awoken/activated...
                 // .. make sure the sensor is stable
-                if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 4) ==
-                        1 &&
-                    arrayOfVars[i]->parentSensor->isStable(deepDebugTiming)) {
+                if (bitRead(_sensors[s]->getStatus(), 4) == 1 &&
+                    _sensors[s]->isStable(deepDebugTiming)) {
                     // If no attempt has yet been made to start a measurement,
                     // start one
-                    if (bitRead(arrayOfVars[i]->parentSensor->getStatus(), 5) ==
-                        0) {
+                    if (bitRead(_sensors[s]->getStatus(), 5) == 0) {
                         // Start a reading
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
+                        MS_DBG(s, '.', nMeasurementsCompleted[s] + 1,
                                F("--->> Starting reading"),
-                               nMeasurementsCompleted[i] + 1, F("on"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
+                               nMeasurementsCompleted[s] + 1, F("on"),
+                               _sensors[s]->getSensorNameAndLocation(),
                                F("..."));
 
                         bool sensorSuccess_start =
-                            arrayOfVars[i]
-                                ->parentSensor->startSingleMeasurement();
+                            _sensors[s]->startSingleMeasurement();
                         success &= sensorSuccess_start;
 
                         if (sensorSuccess_start) {
+                            if (nMeasurementsCompleted[s] == 0) {
+                                _sensors[s]->markPhaseComplete(
+                                    SENSOR_PHASE_STABILIZATION);
+                            }
                             MS_DBG(F("   ... start reading succeeded. <<---"),
-                                   i, '.', nMeasurementsCompleted[i] + 1);
+                                   s, '.', nMeasurementsCompleted[s] + 1);
                         } else {
-                            MS_DBG(F("   ... start reading failed! <<---"), i,
-                                   '.', nMeasurementsCompleted[i] + 1);
+                            MS_DBG(F("   ... start reading failed! <<---"), s,
+                                   '.', nMeasurementsCompleted[s] + 1);
                         }
                     }
 
@@ -746,68 +988,89 @@ bool VariableArray::completeUpdate(void) {
                     // isMeasurementComplete(deepDebugTiming) will do that and
                     // we stil want the addSingleMeasurementResult() function to
                     // fill in the -9999 results for a failed measurement.
-                    if (arrayOfVars[i]->parentSensor->isMeasurementComplete(
-                            deepDebugTiming)) {
+                    if (_sensors[s]->isMeasurementComplete(deepDebugTiming)) {
                         // Get the value
-                        MS_DBG(i, '.', nMeasurementsCompleted[i] + 1,
+                        MS_DBG(s, '.', nMeasurementsCompleted[s] + 1,
                                F("--->> Collected result of reading"),
-                               nMeasurementsCompleted[i] + 1, F("from"),
-                               arrayOfVars[i]->getParentSensorNameAndLocation(),
+                               nMeasurementsCompleted[s] + 1, F("from"),
+                               _sensors[s]->getSensorNameAndLocation(),
                                F("..."));
 
-                        bool sensorSuccess_result =
-                            arrayOfVars[i]
-                                ->parentSensor->addSingleMeasurementResult();
+                        if (bitRead(_sensors[s]->getStatus(), 6) == 1) {
+                            _sensors[s]->markPhaseComplete(
+                                SENSOR_PHASE_MEASUREMENT);
+                        }
+                        uint32_t retrievalStart = millis();
+                        bool     sensorSuccess_result =
+                            _sensors[s]->addSingleMeasurementResult();
+                        _sensors[s]->recordPhaseTime(
+                            SENSOR_PHASE_RETRIEVAL, millis() - retrievalStart);
                         success &= sensorSuccess_result;
-                        nMeasurementsCompleted[i] +=
+                        nMeasurementsCompleted[s] +=
                             1;  // increment the number of measurements that
                                 // sensor has completed
-                        nCompletedOnPin[powerPinIndex[i]] +=
+                        nCompletedOnPin[_powerPinGroup[s]] +=
                             1;  // increment the number of measurements that the
                                 // power pin has completed
+#ifdef MS_SENSOR_BURST_STATS
+                        checkEnoughMeasurements(state, s);
+#endif
 
                         if (sensorSuccess_result) {
-                            MS_DBG(F("   ... got measurement result. <<---"), i,
-                                   '.', nMeasurementsCompleted[i]);
+                            MS_DBG(F("   ... got measurement result. <<---"), s,
+                                   '.', nMeasurementsCompleted[s]);
                         } else {
                             MS_DBG(F("   ... failed to get measurement result! "
                                      "<<---"),
-                                   i, '.', nMeasurementsCompleted[i]);
+                                   s, '.', nMeasurementsCompleted[s]);
                         }
                     }
                 }
 
                 // If all the measurements are done
-                if (nMeasurementsCompleted[i] == nMeasurementsToAverage[i]) {
-                    MS_DBG(i, F("--->> Finished all measurements from"),
-                           arrayOfVars[i]->getParentSensorNameAndLocation(),
+                if (nMeasurementsCompleted[s] == nMeasurementsToAverage[s]) {
+                    MS_DBG(s, F("--->> Finished all measurements from"),
+                           _sensors[s]->getSensorNameAndLocation(),
                            F(", putting it to sleep. ..."));
 
                     // Put the completed sensor to sleep
-                    bool sensorSuccess_sleep =
-                        arrayOfVars[i]->parentSensor->sleep();
+#ifdef MS_SENSOR_STANDBY
+                    // or leave it on, by its standby policy
+                    bool sensorSuccess_sleep = _sensors[s]->standby();
+#else
+                    bool sensorSuccess_sleep = _sensors[s]->sleep();
+#endif
                     success &= sensorSuccess_sleep;
 
                     if (sensorSuccess_sleep) {
                         MS_DBG(F("   ... succeeded in putting sensor to sleep. "
                                  "<<---"),
-                               i);
+                               s);
                     } else {
-                        MS_DBG(F("   ... sleep failed! <<---"), i);
+                        MS_DBG(F("   ... sleep failed! <<---"), s);
                     }
 
                     // Now cut the power, if ready, to this sensors and all that
                     // share the pin
-                    if (nCompletedOnPin[powerPinIndex[i]] ==
-                        nMeasurementsOnPin[powerPinIndex[i]]) {
-                        for (uint8_t k = 0; k < _variableCount; k++) {
-                            if (powerPinIndex[k] == powerPinIndex[i] &&
-                                lastSensorVariable[k]) {
-                                arrayOfVars[k]->parentSensor->powerDown();
-                                MS_DBG(k, F("--->>"),
-                                       arrayOfVars[k]
+                    if (nCompletedOnPin[_powerPinGroup[s]] ==
+                            nMeasurementsOnPin[_powerPinGroup[s]]
+#ifdef MS_SENSOR_STANDBY
+                        && groupPowerCycles(_powerPinGroup[s])
+#endif
+                    ) {
+                        for (uint8_t k = 0; k < _sensorCount; k++) {
+#if defined(MS_SENSOR_DECIMATION) || defined(MS_SENSOR_QUARANTINE) || \
+    defined(MS_SHARE_SENSOR_RESULTS)
+                            // A skipped or reused sensor was never powered up
+                            if (nMeasurementsToAverage[k] == 0) continue;
+#endif
+                            if (_powerPinGroup[k] == _powerPinGroup[s]) {
+                                _sensors[k]->powerDown();
+                                MS_DBG(_sensorList[k], F("--->>"),
+                                       arrayOfVars[_sensorList[k]]
                                            ->getParentSensorNameAndLocation(),
-                                       F("powered down. <<---"), k);
+                                       F("powered down. <<---"),
+                                       _sensorList[k]);
                             }
                         }
                     }
@@ -818,20 +1081,60 @@ bool VariableArray::completeUpdate(void) {
                 }
             }
         }
+#ifdef MS_USE_DEADLINE_SCHEDULER
+        // Put the sensor back in the queue if it isn't finished
+        if (nMeasurementsToAverage[next.sensorNumber] >
+            nMeasurementsCompleted[next.sensorNumber]) {
+#ifdef MS_STAGGER_POWER_UP
+            pushDeadline(deadlineHeap, heapSize, next.sensorNumber,
+                         state.powerUpAt, cycleStart);
+#else
+            pushDeadline(deadlineHeap, heapSize, next.sensorNumber);
+#endif
+        }
+#endif
     }
 
     // Average measurements and notify varibles of the updates
     MS_DBG(F("----->> Averaging results and notifying all variables. ..."));
-    for (uint8_t i = 0; i < _variableCount; i++) {
-        if (lastSensorVariable[i]) {
-            MS_DBG(F("--- Averaging results from"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(), F("---"));
-            arrayOfVars[i]->parentSensor->averageMeasurements();
-            MS_DBG(F("--- Notifying variables from"),
-                   arrayOfVars[i]->getParentSensorNameAndLocation(), F("---"));
-            arrayOfVars[i]->parentSensor->notifyVariables();
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+#ifdef MS_SENSOR_DECIMATION
+        // The variables of a skipped sensor that keeps its values already
+        // have them
+        if (nMeasurementsToAverage[s] == 0 &&
+            _sensors[s]->getKeepLastValue()) {
+            continue;
+        }
+#endif
+#ifdef MS_SHARE_SENSOR_RESULTS
+        // The results of a sensor used again are already averaged
+        if (_sensors[s]->hasFreshResults(cycleStart)) {
+            refreshVariables(_sensors[s]);
+            continue;
         }
+#endif
+        MS_DBG(F("--- Averaging results from"),
+               _sensors[s]->getSensorNameAndLocation(), F("---"));
+        _sensors[s]->averageMeasurements();
+#ifdef MS_SENSOR_QUARANTINE
+        // Only the sensors that were tried have anything new to say
+        if (nMeasurementsToAverage[s] > 0) {
+            _sensors[s]->recordUpdateHealth();
+        }
+#endif
+        MS_DBG(F("--- Notifying variables from"),
+               _sensors[s]->getSensorNameAndLocation(), F("---"));
+        _sensors[s]->notifyVariables();
+#ifdef MS_SHARE_SENSOR_RESULTS
+        refreshVariables(_sensors[s]);
+#endif
     }
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    evaluateCalculatedVariables();
+#endif
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    cacheValueStrings();
+#endif
     MS_DBG(F("... Complete. <<-----"));
 
     return success;
@@ -843,11 +1146,11 @@ bool VariableArray::completeUpdate(void) {
 void VariableArray::printSensorData(Stream* stream) {
     for (uint8_t i = 0; i < _variableCount; i++) {
         if (arrayOfVars[i]->isCalculated) {
-            stream->print(arrayOfVars[i]->getVarName());
+            stream->print(arrayOfVars[i]->getVarNameChars());
             stream->print(F(" is calculated to be "));
-            stream->print(arrayOfVars[i]->getValueString());
+            stream->print(getValueChars(i));
             stream->print(F(" "));
-            stream->print(arrayOfVars[i]->getVarUnit());
+            stream->print(arrayOfVars[i]->getVarUnitChars());
             stream->println();
         } else {
             stream->print(arrayOfVars[i]->getParentSensorNameAndLocation());
@@ -869,23 +1172,118 @@ void VariableArray::printSensorData(Stream* stream) {
             // stream->print(
             //     bitRead(arrayOfVars[i]->parentSensor->getStatus(), 0));
             stream->print(F(" reports "));
-            stream->print(arrayOfVars[i]->getVarName());
+            stream->print(arrayOfVars[i]->getVarNameChars());
             stream->print(F(" is "));
-            stream->print(arrayOfVars[i]->getValueString());
+            stream->print(getValueChars(i));
             stream->print(F(" "));
-            stream->print(arrayOfVars[i]->getVarUnit());
+            stream->print(arrayOfVars[i]->getVarUnitChars());
             stream->println();
         }
     }
 }
 
 
+// A shared buffer for values that aren't in the cache
+static char valueCharBuffer[VALUE_STRING_BUFFER_SIZE];
+
+const char* VariableArray::getValueChars(uint8_t arrayIndex) {
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    if (_valueCacheValid && arrayIndex < _variableCount) {
+        // The values are almost always read in order, so walk forward from
+        // the last value looked up instead of from the start of the cache
+        if (arrayIndex < _cacheCursorVar) {
+            _cacheCursorVar = 0;
+            _cacheCursorPos = 0;
+        }
+        while (_cacheCursorVar < arrayIndex) {
+            _cacheCursorPos += strlen(&_valueCache[_cacheCursorPos]) + 1;
+            _cacheCursorVar++;
+        }
+        return &_valueCache[_cacheCursorPos];
+    }
+#endif
+    arrayOfVars[arrayIndex]->getValueChars(valueCharBuffer);
+    return valueCharBuffer;
+}
+
+
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+void VariableArray::evaluateCalculatedVariables(void) {
+    // Forget all of the old results first so none of them are used as inputs
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        arrayOfVars[i]->clearCalculation();
+    }
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        arrayOfVars[i]->memoizeCalculation();
+    }
+}
+#endif
+
+
+#ifdef MS_VARIABLE_HISTORY
+void VariableArray::recordHistory(uint32_t timestamp) {
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        if (!arrayOfVars[i]->isCalculated) {
+            arrayOfVars[i]->recordHistory(timestamp);
+        }
+    }
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    // The kept results were calculated before the new values were in the
+    // histories
+    evaluateCalculatedVariables();
+#endif
+    bool calculatedHistory = false;
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        if (arrayOfVars[i]->isCalculated &&
+            arrayOfVars[i]->getHistory() != nullptr) {
+            arrayOfVars[i]->recordHistory(timestamp);
+            calculatedHistory = true;
+        }
+    }
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    // And again for anything calculated from those, like a WindowedVariable
+    if (calculatedHistory) { evaluateCalculatedVariables(); }
+#else
+    (void)calculatedHistory;
+#endif
+}
+#endif
+
+
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+void VariableArray::cacheValueStrings(void) {
+    _valueCacheValid = false;
+    _cacheCursorVar  = 0;
+    _cacheCursorPos  = 0;
+    uint16_t pos     = 0;
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        uint8_t len = arrayOfVars[i]->getValueChars(valueCharBuffer);
+        if (pos + len + 1 > MS_VALUE_STRING_CACHE_SIZE) {
+            MS_DBG(F("The value string cache is too small for all"),
+                   _variableCount, F("variables!"));
+            return;
+        }
+        memcpy(&_valueCache[pos], valueCharBuffer, len + 1);
+        pos += len + 1;
+    }
+    MS_DBG(F("Cached"), pos, F("characters of formatted values"));
+    _valueCacheValid = true;
+}
+#endif
+
+
 // Check for unique sensors
 bool VariableArray::isLastVarFromSensor(int arrayIndex) {
     // Calculated Variables are never the last variable from a sensor, simply
     // because the don't come from a sensor at all.
     if (arrayOfVars[arrayIndex]->isCalculated) {
         return false;
+    } else if (_sensorsByObject) {
+        Sensor* parent = arrayOfVars[arrayIndex]->parentSensor;
+        for (int j = arrayIndex + 1; j < _variableCount; j++) {
+            if (arrayOfVars[j]->parentSensor == parent) { return false; }
+        }
+        return true;
     } else {
         String sensNameLoc =
             arrayOfVars[arrayIndex]->getParentSensorNameAndLocation();
@@ -904,30 +1302,380 @@ bool VariableArray::isLastVarFromSensor(int arrayIndex) {
 
 // Count the maximum number of measurements needed from a single sensor for the
 // requested averaging
-uint8_t VariableArray::countMaxToAverage(void) {
-    uint8_t numReps = 0;
+measurementCount_t VariableArray::countMaxToAverage(void) {
+    measurementCount_t numReps = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        numReps = max(numReps, _sensors[s]->getNumberMeasurementsToAverage());
+    }
+    return numReps;
+}
+
+
+#ifdef MS_SENSOR_BURST_STATS
+// Cut a sensor's measurements short once its adaptive average is good enough
+void VariableArray::checkEnoughMeasurements(updateCycleState& state,
+                                            uint8_t           sensorNumber) {
+    measurementCount_t nTaken = state.nMeasurementsCompleted[sensorNumber];
+    measurementCount_t nToAverage =
+        state.nMeasurementsToAverage[sensorNumber];
+    if (nTaken >= nToAverage) {
+        // Let the sensor know how many were taken, but there's nothing to cut
+        _sensors[sensorNumber]->hasEnoughMeasurements(nTaken);
+        return;
+    }
+    if (!_sensors[sensorNumber]->hasEnoughMeasurements(nTaken)) {
+        return;
+    }
+    MS_DBG(F("   ... skipping the last"), nToAverage - nTaken,
+           F("measurements; the average is good enough. <<---"),
+           sensorNumber);
+    if (state.nMeasurementsOnPin != nullptr) {
+        state.nMeasurementsOnPin[_powerPinGroup[sensorNumber]] -=
+            nToAverage - nTaken;
+    }
+    state.nMeasurementsToAverage[sensorNumber] = nTaken;
+}
+#endif
+
+
+#ifdef MS_STAGGER_POWER_UP
+void VariableArray::setMaxConcurrentPowerUps(uint8_t maxPowerUps) {
+    _maxConcurrentPowerUps = maxPowerUps;
+}
+void VariableArray::setPowerBudget(uint16_t budget_mA) {
+    _powerBudget_mA = budget_mA;
+}
+
+
+// Give each power pin group a start time that has it finish with the slowest
+// NOTE:  The times are indexed by the first sensor on each power pin, like the
+// measurement counts on each pin.
+void VariableArray::planPowerUps(updateCycleState& state) {
+    uint32_t slowest = 0;
+    for (uint8_t s = 0; s < _sensorCount; s++) { state.powerUpAt[s] = 0; }
+    // Start with the time each group needs, which is the time its slowest
+    // sensor needs
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (state.nMeasurementsToAverage[s] == 0) continue;
+        uint32_t duration = _sensors[s]->getExpectedDuration(
+            state.nMeasurementsToAverage[s]);
+        uint8_t group = _powerPinGroup[s];
+        if (duration > state.powerUpAt[group]) {
+            state.powerUpAt[group] = duration;
+        }
+        if (duration > slowest) { slowest = duration; }
+    }
+    // Then turn that into how long to wait before powering the group
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (_powerPinGroup[s] != s) continue;
+        if (state.nMeasurementsOnPin[s] == 0) {
+            // Nothing to measure on this pin, so never power it
+            state.powerUpAt[s] = VA_POWERED_UP;
+            continue;
+        }
+        // There's nothing to save by waiting to start a sensor whose power
+        // isn't switched
+        int8_t powerPin = _sensors[s]->getPowerPin();
+        state.powerUpAt[s] = powerPin < 0 ? 0 : slowest - state.powerUpAt[s];
+        MS_DBG(F("    Power pin"), powerPin, F("will be powered"),
+               state.powerUpAt[s], F("ms into the update"));
+    }
+}
+
+
+// Power the groups whose time has come, as far as the inrush limit allows
+void VariableArray::powerUpDueGroups(updateCycleState& state,
+                                     uint32_t          cycleStart) {
+    uint32_t elapsed = millis() - cycleStart;
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        if (_powerPinGroup[s] != s) continue;
+        if (state.powerUpAt[s] == VA_POWERED_UP) continue;
+        if (elapsed < state.powerUpAt[s]) continue;
+        if (_maxConcurrentPowerUps > 0 || _powerBudget_mA > 0) {
+            if (millis() - _inrushWindowStart >= MS_INRUSH_WINDOW_MS) {
+                _inrushWindowStart = millis();
+                _inrushCount       = 0;
+                _inrushCurrent_mA  = 0;
+            }
+            if (_maxConcurrentPowerUps > 0 &&
+                _inrushCount >= _maxConcurrentPowerUps) {
+                return;
+            }
+            uint16_t groupCurrent = 0;
+            for (uint8_t k = s; k < _sensorCount; k++) {
+                if (_powerPinGroup[k] != s) continue;
+                if (state.nMeasurementsToAverage[k] == 0) continue;
+                Sensor* sensor = _sensors[k];
+                groupCurrent += sensor->getStartupCurrent();
+            }
+            // Let the first pin of a window through even if it's over the
+            // budget on its own, or it would never be powered
+            if (_powerBudget_mA > 0 && _inrushCount > 0 &&
+                _inrushCurrent_mA + groupCurrent > _powerBudget_mA) {
+                continue;
+            }
+            _inrushCount++;
+            _inrushCurrent_mA += groupCurrent;
+        }
+        for (uint8_t k = s; k < _sensorCount; k++) {
+            if (_powerPinGroup[k] != s) continue;
+            // A sensor with nothing to measure was skipped
+            if (state.nMeasurementsToAverage[k] == 0) continue;
+            Variable* var = arrayOfVars[_sensorList[k]];
+            MS_DBG(F("    Powering up"), var->getParentSensorNameAndLocation(),
+                   F("after"), elapsed, F("ms"));
+            var->parentSensor->powerUp();
+        }
+        state.powerUpAt[s] = VA_POWERED_UP;
+    }
+}
+#endif
+
+
+#ifdef MS_SHARE_SENSOR_RESULTS
+// A sensor only notifies the last variable registered for each of its values,
+// so hand the values to this array's own variables directly
+void VariableArray::refreshVariables(Sensor* sensor) {
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        if (arrayOfVars[i]->isCalculated) continue;
+        if (arrayOfVars[i]->parentSensor != sensor) continue;
+        arrayOfVars[i]->onSensorUpdate(sensor);
+    }
+}
+#endif
+
+
+// Find the unique sensors and the sensors that share power pins
+// NOTE:  This is the only place the (slow) check for unique sensors is run;
+// every other function reads the cached list.
+void VariableArray::buildSensorList(void) {
+    _sensorCount = 0;
     for (uint8_t i = 0; i < _variableCount; i++) {
-        if (isLastVarFromSensor(i)) {  // Skip non-unique sensors
-            numReps = max(
-                numReps,
-                arrayOfVars[i]->parentSensor->getNumberMeasurementsToAverage());
+        if (!isLastVarFromSensor(i)) continue;
+        if (_sensorCount >= MAX_NUMBER_SENSORS) {
+            PRINTOUT(F("There are more than"), MAX_NUMBER_SENSORS,
+                     F("sensors in the variable array!  Increase "
+                       "MAX_NUMBER_SENSORS."));
+            break;
         }
+        _sensorList[_sensorCount]    = i;
+        _sensors[_sensorCount]       = arrayOfVars[i]->parentSensor;
+        _powerPinGroup[_sensorCount] = _sensorCount;
+        // Group this sensor with the first earlier sensor on the same pin
+        int8_t powerPin = _sensors[_sensorCount]->getPowerPin();
+        for (uint8_t s = 0; s < _sensorCount; s++) {
+            if (_sensors[s]->getPowerPin() == powerPin) {
+                _powerPinGroup[_sensorCount] = _powerPinGroup[s];
+                break;
+            }
+        }
+        _sensorCount++;
     }
-    return numReps;
+    MS_DBG(F("There are"), _sensorCount, F("unique sensors in the group."));
+}
+
+
+// Look for a different sensor on the same bus that needs the bus to itself
+Sensor* VariableArray::findBusHolder(uint8_t sensorNumber) {
+    Sensor* sensor = _sensors[sensorNumber];
+    if (sensor->getBusType() == SENSOR_BUS_NONE) return nullptr;
+    for (uint8_t k = 0; k < _sensorCount; k++) {
+        if (k == sensorNumber) continue;
+        Sensor* other = _sensors[k];
+        if (sensor->sharesBusWith(other) && other->isHoldingBus()) {
+            return other;
+        }
+    }
+    return nullptr;
+}
+
+
+#ifdef MS_SENSOR_STANDBY
+void VariableArray::chooseStandby(uint32_t interval_ms) {
+    for (uint8_t s = 0; s < _sensorCount; s++) {
+        _sensors[s]->chooseStandby(interval_ms);
+    }
+}
+
+
+bool VariableArray::groupPowerCycles(uint8_t powerPinGroup) {
+    for (uint8_t k = 0; k < _sensorCount; k++) {
+        if (_powerPinGroup[k] == powerPinGroup &&
+            _sensors[k]->getStandbyPolicy() != STANDBY_POWER_CYCLE) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+
+#ifdef MS_USE_DEADLINE_SCHEDULER
+// Add a sensor to the deadline min-heap, sifting it up into place
+// NOTE:  Deadlines are compared by their difference so the order is still
+// correct when millis() rolls over.
+void VariableArray::pushDeadline(sensorDeadline heap[], uint8_t& heapSize,
+                                 uint8_t         sensorNumber,
+                                 const uint32_t* powerUpAt,
+                                 uint32_t        cycleStart) {
+    Variable*      lastVar = arrayOfVars[_sensorList[sensorNumber]];
+    sensorDeadline entry;
+    entry.sensorNumber = sensorNumber;
+    entry.deadline     = lastVar->parentSensor->getNextDeadline();
+#ifdef MS_STAGGER_POWER_UP
+    // A sensor that isn't powered yet can't do anything before its group is
+    uint8_t group = _powerPinGroup[sensorNumber];
+    if (powerUpAt != nullptr && powerUpAt[group] != VA_POWERED_UP) {
+        uint32_t poweredAt = cycleStart + powerUpAt[group];
+        // Once its time has come, it's only waiting on the inrush limit
+        if (static_cast<int32_t>(millis() - poweredAt) >= 0) {
+            poweredAt = _inrushWindowStart + MS_INRUSH_WINDOW_MS;
+        }
+        if (static_cast<int32_t>(poweredAt - entry.deadline) > 0) {
+            entry.deadline = poweredAt;
+        }
+    }
+#else
+    (void)powerUpAt;
+    (void)cycleStart;
+#endif
+    // If another sensor is holding the bus, nothing can happen until it's
+    // done with it
+    Sensor* holder = findBusHolder(sensorNumber);
+    if (holder != nullptr) {
+        uint32_t released = holder->getNextDeadline();
+        if (static_cast<int32_t>(released - entry.deadline) > 0) {
+            entry.deadline = released;
+        }
+    }
+    MS_DEEP_DBG(F("Next deadline for"),
+                lastVar->getParentSensorNameAndLocation(), F("is at"),
+                entry.deadline);
+
+    uint8_t child = heapSize++;
+    while (child > 0) {
+        uint8_t parent = (child - 1) / 2;
+        if (static_cast<int32_t>(heap[parent].deadline - entry.deadline) <= 0) {
+            break;
+        }
+        heap[child] = heap[parent];
+        child       = parent;
+    }
+    heap[child] = entry;
 }
 
 
+// Remove the earliest deadline from the min-heap, sifting the last entry down
+// into the hole
+VariableArray::sensorDeadline
+VariableArray::popDeadline(sensorDeadline heap[], uint8_t& heapSize) {
+    sensorDeadline top  = heap[0];
+    sensorDeadline last = heap[--heapSize];
+
+    uint8_t parent = 0;
+    while (true) {
+        uint8_t child = 2 * parent + 1;
+        if (child >= heapSize) break;
+        if (child + 1 < heapSize &&
+            static_cast<int32_t>(heap[child + 1].deadline -
+                                 heap[child].deadline) < 0) {
+            child++;
+        }
+        if (static_cast<int32_t>(last.deadline - heap[child].deadline) <= 0) {
+            break;
+        }
+        heap[parent] = heap[child];
+        parent       = child;
+    }
+    heap[parent] = last;
+    return top;
+}
+
+
+// Wait for a deadline, optionally idling the processor
+void VariableArray::waitForDeadline(uint32_t deadline) {
+#if defined(MS_IDLE_BETWEEN_DEADLINES) && \
+    (defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO))
+    // Only idle the CPU; the sleep mode set up for the logger's sleep would
+    // stop the clocks that the sensors and the SysTick need
+    uint32_t savedSCR = SCB->SCR;
+    // Clear the deep sleep bit
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+#if defined(__SAMD51__)
+    uint8_t savedSleepMode     = PM->SLEEPCFG.bit.SLEEPMODE;
+    PM->SLEEPCFG.bit.SLEEPMODE = PM_SLEEPCFG_SLEEPMODE_IDLE_Val;
+    while (PM->SLEEPCFG.bit.SLEEPMODE != PM_SLEEPCFG_SLEEPMODE_IDLE_Val)
+        ;  // Wait for it to take
+#else
+    uint8_t savedIdle  = PM->SLEEP.bit.IDLE;
+    PM->SLEEP.bit.IDLE = PM_SLEEP_IDLE_CPU_Val;
+#endif
+#endif
+#ifdef MS_LOGGER_OVERLAP_MODEM
+    // The poll may talk to the modem, so the clock can't be slowed for it
+    bool slowClock = _updatePoll == nullptr;
+    if (slowClock) { MS_CLOCK_SLOW(); }
+#else
+    MS_CLOCK_SLOW();
+#endif
+    while (static_cast<int32_t>(deadline - millis()) > 0) {
+        MS_PROFILE_SAMPLE();
+#ifdef MS_LOGGER_OVERLAP_MODEM
+        if (_updatePoll != nullptr) { _updatePoll(_updatePollContext); }
+#endif
+#if defined(MS_IDLE_BETWEEN_DEADLINES)
+#if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO)
+        // Wait for any interrupt; at most until the next SysTick
+        __DSB();
+        __WFI();
+#elif defined(ARDUINO_ARCH_AVR) || defined(__AVR__)
+        // Idle until any interrupt; at most until the next Timer0 overflow
+        set_sleep_mode(SLEEP_MODE_IDLE);
+        sleep_enable();
+        sleep_cpu();
+        sleep_disable();
+#endif
+#endif
+    }
+#ifdef MS_LOGGER_OVERLAP_MODEM
+    if (slowClock) { MS_CLOCK_FAST(); }
+#else
+    MS_CLOCK_FAST();
+#endif
+#if defined(MS_IDLE_BETWEEN_DEADLINES) && \
+    (defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO))
+    // Put back the sleep mode for the logger's sleep
+#if defined(__SAMD51__)
+    PM->SLEEPCFG.bit.SLEEPMODE = savedSleepMode;
+    while (PM->SLEEPCFG.bit.SLEEPMODE != savedSleepMode)
+        ;  // Wait for it to take
+#else
+    PM->SLEEP.bit.IDLE = savedIdle;
+#endif
+    SCB->SCR = savedSCR;
+#endif
+}
+#endif
+
+
 // Check that all variable have valid UUID's, if they are assigned
 bool VariableArray::checkVariableUUIDs(void) {
     bool success = true;
+    // Hash each UUID once, so only the UUIDs with the same hash are compared
+    uint16_t hashes[_variableCount];
+    for (uint8_t i = 0; i < _variableCount; i++) {
+        hashes[i] = arrayOfVars[i]->getUUIDHash();
+    }
     for (uint8_t i = 0; i < _variableCount; i++) {
         if (!arrayOfVars[i]->checkUUIDFormat()) {
-            PRINTOUT(arrayOfVars[i]->getVarCode(), F("has an invalid UUID!"));
+            PRINTOUT(arrayOfVars[i]->getVarCodeChars(),
+                     F("has an invalid UUID!"));
             success = false;
         }
         for (uint8_t j = i + 1; j < _variableCount; j++) {
-            if (arrayOfVars[i]->getVarUUID() == arrayOfVars[j]->getVarUUID()) {
-                PRINTOUT(arrayOfVars[i]->getVarCode(),
+            if (hashes[i] == hashes[j] &&
+                arrayOfVars[i]->hasSameUUID(arrayOfVars[j])) {
+                PRINTOUT(arrayOfVars[i]->getVarCodeChars(),
                          F("has a non-unique UUID!"));
                 success = false;
                 // don't keep looping
@@ -939,8 +1687,10 @@ bool VariableArray::checkVariableUUIDs(void) {
         PRINTOUT(F("All variable UUID's appear to be correctly formed.\n"));
     // Print out all UUID's to check
     for (uint8_t i = 0; i < _variableCount; i++) {
-        PRINTOUT(arrayOfVars[i]->getVarUUID(), F("->"),
-                 arrayOfVars[i]->getVarCode());
+        // The UUID and code may share a buffer, so print them one at a time
+        MS_PRINTOUT_PORT.print(arrayOfVars[i]->getVarUUIDChars());
+        MS_PRINTOUT_PORT.print(' ');
+        PRINTOUT(F("->"), arrayOfVars[i]->getVarCodeChars());
     }
     PRINTOUT(' ');
     return success;
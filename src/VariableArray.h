@@ -33,6 +33,102 @@
 #include "VariableBase.h"
 #include "SensorBase.h"
 
+/**
+ * @brief The marker in updateCycleState::powerUpAt for a power pin group that
+ * has been powered up.
+ */
+#define VA_POWERED_UP 0xFFFFFFFF
+
+#ifndef MAX_NUMBER_SENSORS
+/**
+ * @brief The largest number of unique sensors in a single variable array.
+ *
+ * Override this with a build flag if you have an exceptionally large station.
+ */
+#define MAX_NUMBER_SENSORS 32
+#endif
+
+/**
+ * @def MS_USE_DEADLINE_SCHEDULER
+ * @brief Define this build flag to have updateAllSensors() and
+ * completeUpdate() service only the sensor with the earliest upcoming
+ * deadline instead of re-checking every sensor on every pass.
+ *
+ * The deadline for each sensor is calculated from its warm-up, stabilization,
+ * and measurement times (see Sensor::getNextDeadline()) and kept in a small
+ * min-heap.  Between deadlines the processor is not talking to any sensors.
+ */
+// #define MS_USE_DEADLINE_SCHEDULER
+
+/**
+ * @def MS_IDLE_BETWEEN_DEADLINES
+ * @brief Define this build flag, along with #MS_USE_DEADLINE_SCHEDULER, to put
+ * the processor into its idle sleep mode while waiting for the next sensor
+ * deadline.
+ *
+ * On AVR boards this uses `SLEEP_MODE_IDLE`, on SAMD boards `WFI`.  In both
+ * cases the peripherals and clocks stay running and the processor wakes on
+ * the next interrupt - at the latest the 1 ms system tick that keeps millis()
+ * counting - so no extra timer is needed and the wait can never overshoot a
+ * deadline by more than a tick.
+ */
+// #define MS_IDLE_BETWEEN_DEADLINES
+
+/**
+ * @def MS_VALUE_STRING_CACHE_SIZE
+ * @brief Define this build flag to format the value of every variable in the
+ * array once at the end of each update and keep the text in a fixed character
+ * buffer of this many bytes.
+ *
+ * All of the readers of VariableArray::getValueChars() - the logger's data
+ * file and serial output and every publisher - then share the same text
+ * instead of each formatting the values again.  Allow about 8 bytes per
+ * variable.  If the buffer is too small the values are formatted on request,
+ * just as they are without this flag.
+ */
+// #define MS_VALUE_STRING_CACHE_SIZE 256
+
+/**
+ * @def MS_STAGGER_POWER_UP
+ * @brief Define this build flag to have completeUpdate() stagger the power up
+ * of each power pin so that they all finish around the same time, instead of
+ * powering every sensor at the start of the update.
+ *
+ * The time each sensor needs is estimated from its warm-up, stabilization, and
+ * measurement times and the number of measurements to average (see
+ * Sensor::getExpectedDuration()).  The pin with the slowest sensors is
+ * powered first, and every other pin is powered only when it's left with just
+ * enough time to finish with it.  Sensors on a shared pin are powered
+ * together, and sensors without a power pin are started right away.  The
+ * update takes just as long, but sensors that are quick to read spend much
+ * less time powered.  Use VariableArray::setMaxConcurrentPowerUps() or
+ * VariableArray::setPowerBudget() to also limit how many pins or how much
+ * startup current are switched on at once.
+ */
+// #define MS_STAGGER_POWER_UP
+
+/**
+ * @def MS_PARALLEL_SENSOR_SETUP
+ * @brief Define this build flag to have setupSensors() power up every sensor
+ * at once and set each one up as soon as it's warmed up, instead of letting
+ * each sensor power itself up and wait for its own warm-up in turn.
+ *
+ * Setting up the array then takes about as long as the slowest warm-up
+ * rather than the sum of them all.  The sensors that were off before are
+ * powered down again at the end.  The limits of
+ * setMaxConcurrentPowerUps() and setPowerBudget() aren't applied to this
+ * power up.
+ */
+// #define MS_PARALLEL_SENSOR_SETUP
+
+#ifndef MS_INRUSH_WINDOW_MS
+/**
+ * @brief With #MS_STAGGER_POWER_UP and a limit on concurrent power ups, the
+ * power pins switched on within this many milliseconds of each other are
+ * counted as being switched on at once.
+ */
+#define MS_INRUSH_WINDOW_MS 100
+#endif
 
 /**
  * @brief The variable array class defines the logic for iterating through many
@@ -173,6 +269,25 @@ class VariableArray {
      * @return **uint8_t** The number of sensors
      */
     uint8_t getSensorCount(void);
+    /**
+     * @brief Get the number of unique sensors found when the array was begun.
+     *
+     * Unlike getSensorCount(), this doesn't search the variables again.
+     *
+     * @return **uint8_t** The number of sensors in #_sensorList
+     */
+    uint8_t getSensorListCount(void) {
+        return _sensorCount;
+    }
+    /**
+     * @brief Get one of the unique sensors found when the array was begun.
+     *
+     * @param sensorNumber The position of the sensor in #_sensorList.
+     * @return **Sensor\*** The sensor.
+     */
+    Sensor* getListedSensor(uint8_t sensorNumber) {
+        return _sensors[sensorNumber];
+    }
 
     /**
      * @brief Match UUID's from the given variables in the variable array.
@@ -255,6 +370,76 @@ class VariableArray {
      * @return **bool** True if all steps of the update succeeded.
      */
     bool completeUpdate(void);
+    /**
+     * @brief Get the time completeUpdate() is expected to take to finish the
+     * measurements.
+     *
+     * This is the longest Sensor::getExpectedDuration() of any sensor for its
+     * number of measurements to average, since the sensors are powered and
+     * measured together.
+     *
+     * @return **uint32_t** The expected time in milliseconds.
+     */
+    uint32_t getExpectedUpdateTime(void);
+#ifdef MS_LOGGER_OVERLAP_MODEM
+    /**
+     * @brief Set a function to call over and over while completeUpdate()
+     * waits on the sensors, ie, to take the next step of a modem connection.
+     *
+     * The function must return quickly; it's called between every check of
+     * the sensors and while waiting for each deadline.  The processor clock
+     * isn't slowed (#MS_SAMD_CLOCK_SCALING) while there's a function to call.
+     *
+     * @param pollFxn The function to call, or a nullptr to stop calling it.
+     * @param pollContext The pointer to give the function each time.
+     */
+    void setUpdatePoll(void (*pollFxn)(void*), void* pollContext) {
+        _updatePoll        = pollFxn;
+        _updatePollContext = pollContext;
+    }
+#endif
+#ifdef MS_STAGGER_POWER_UP
+    /**
+     * @brief Limit the number of power pins completeUpdate() switches on at
+     * once.
+     *
+     * Pins switched on within #MS_INRUSH_WINDOW_MS of each other count as
+     * being switched on at once; a pin that is due while the limit is reached
+     * waits for the next window.
+     *
+     * @param maxPowerUps The most pins to switch on at once; 0 (the default)
+     * for no limit.
+     */
+    void setMaxConcurrentPowerUps(uint8_t maxPowerUps);
+    /**
+     * @brief Limit the total startup current of the power pins
+     * completeUpdate() switches on at once.
+     *
+     * Each sensor's share is set with Sensor::setStartupCurrent().  As with
+     * setMaxConcurrentPowerUps(), pins switched on within
+     * #MS_INRUSH_WINDOW_MS of each other count as being switched on at once.
+     * A due pin that would go over the budget waits for the next window, but
+     * a smaller pin due at the same time may still go ahead of it.  A pin
+     * that is over the budget on its own is switched on alone.
+     *
+     * @param budget_mA The most current to switch on at once, in mA; 0 (the
+     * default) for no limit.
+     */
+    void setPowerBudget(uint16_t budget_mA);
+#endif
+#ifdef MS_SENSOR_STANDBY
+    /**
+     * @brief Have every sensor with the #STANDBY_AUTO policy pick what
+     * happens to it between updates (#MS_SENSOR_STANDBY).
+     *
+     * Logger::begin() calls this for its variable array with the logging
+     * interval; call it for any other array that's updated on its own
+     * interval.
+     *
+     * @param interval_ms The time between updates, in ms
+     */
+    void chooseStandby(uint32_t interval_ms);
+#endif
 
     /**
      * @brief Print out the results for all connected sensors to a stream
@@ -269,11 +454,80 @@ class VariableArray {
      */
     void printSensorData(Stream* stream = &Serial);
 
+    /**
+     * @brief Get the current value of the variable at a position in the
+     * array as text with the correct decimal resolution, without creating a
+     * String.
+     *
+     * With #MS_VALUE_STRING_CACHE_SIZE this returns the text formatted at the
+     * end of the last update of the array.  Otherwise the value is formatted
+     * into a shared buffer that is overwritten by the next call, so copy or
+     * print the text before asking for another value.
+     *
+     * @param arrayIndex The position of the variable in the array.
+     * @return **const char\*** The value as text.
+     */
+    const char* getValueChars(uint8_t arrayIndex);
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    /**
+     * @brief Format the current value of every variable in the array into the
+     * value string cache.
+     *
+     * This is called at the end of updateAllSensors() and completeUpdate().
+     * Call it yourself if you change the variable values some other way.
+     */
+    void cacheValueStrings(void);
+#endif
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    /**
+     * @brief Calculate and keep the value of every calculated variable in the
+     * array, each after the calculated variables it declares as inputs.
+     *
+     * This is called at the end of updateAllSensors() and completeUpdate(),
+     * after the sensors have notified their variables.
+     */
+    void evaluateCalculatedVariables(void);
+#endif
+#ifdef MS_VARIABLE_HISTORY
+    /**
+     * @brief Add the current value of every variable with a history to it
+     * (#MS_VARIABLE_HISTORY).
+     *
+     * The measured variables are added first, so calculated variables that
+     * read the histories of measured ones see the new values.  This is
+     * called by the logger for each record it takes.
+     *
+     * @param timestamp The time of the values, in seconds.
+     */
+    void recordHistory(uint32_t timestamp);
+#endif
+
  protected:
+    /**
+     * @brief Construct a new Variable Array object that may tell its sensors
+     * apart by their objects.
+     *
+     * @param variableCount The number of variables in the array
+     * @param variableList An array of pointers to variable objects.
+     * @param sensorsByObject True to treat each sensor object as one sensor,
+     * instead of each sensor name and location; see #_sensorsByObject.
+     */
+    VariableArray(uint8_t variableCount, Variable* variableList[],
+                  bool sensorsByObject);
+
     /**
      * @brief The count of variables in the array
      */
     uint8_t _variableCount;
+    /**
+     * @brief True if the unique sensors are found by comparing the parent
+     * sensor objects of the variables.
+     *
+     * Otherwise two variables are from the same sensor when their parent
+     * sensors have the same name and location, which builds two Strings for
+     * every pair of variables compared when the array is begun.
+     */
+    bool _sensorsByObject = false;
     /**
      * @brief The count of unique sensors tied to variables in the array
      */
@@ -281,12 +535,275 @@ class VariableArray {
     /**
      * @brief The maximum number of samples to average of an single sensor.
      */
-    uint8_t _maxSamplestoAverage;
+    measurementCount_t _maxSamplestoAverage;
+    /**
+     * @brief The position in the variable array of the last variable from
+     * each unique sensor.
+     *
+     * This is filled by buildSensorList() when the array is begun so the
+     * update functions don't need to search for unique sensors every time
+     * they're called.
+     */
+    uint8_t _sensorList[MAX_NUMBER_SENSORS];
+    /**
+     * @brief The parent sensor of each variable in #_sensorList.
+     *
+     * The update loops read the sensor from here instead of from the
+     * variable, so each step of an update is one lookup.
+     */
+    Sensor* _sensors[MAX_NUMBER_SENSORS];
+    /**
+     * @brief For each unique sensor in #_sensorList, the position in
+     * #_sensorList of the first sensor with the same power pin.
+     *
+     * All sensors with the same value share a power pin and are powered down
+     * together.
+     */
+    uint8_t _powerPinGroup[MAX_NUMBER_SENSORS];
+
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    /**
+     * @brief A sensor's next deadline and the sensor's position in
+     * #_sensorList.
+     */
+    typedef struct {
+        /**
+         * @brief The processor time when the sensor next needs attention.
+         */
+        uint32_t deadline;
+        /**
+         * @brief The position of the sensor in #_sensorList.
+         */
+        uint8_t sensorNumber;
+    } sensorDeadline;
+#endif
+    /**
+     * @brief The per-sensor bookkeeping used during an update cycle.
+     *
+     * Each array needs one entry per unique sensor.
+     */
+    typedef struct {
+        /**
+         * @brief The number of sensors the arrays have room for.
+         */
+        uint8_t capacity;
+        /**
+         * @brief The number of measurements each sensor has completed.
+         */
+        measurementCount_t* nMeasurementsCompleted;
+        /**
+         * @brief The number of measurements each sensor must average.
+         */
+        measurementCount_t* nMeasurementsToAverage;
+        /**
+         * @brief The number of measurements to take on each power pin group;
+         * only used by completeUpdate().
+         */
+        measurementCount_t* nMeasurementsOnPin;
+        /**
+         * @brief The number of measurements completed on each power pin
+         * group; only used by completeUpdate().
+         */
+        measurementCount_t* nCompletedOnPin;
+#ifdef MS_USE_DEADLINE_SCHEDULER
+        /**
+         * @brief Room for the min-heap of sensor deadlines.
+         */
+        sensorDeadline* deadlineHeap;
+#endif
+#ifdef MS_STAGGER_POWER_UP
+        /**
+         * @brief The time after the start of the update to power up each
+         * power pin group, or #VA_POWERED_UP once it's been powered; only
+         * used by completeUpdate().
+         */
+        uint32_t* powerUpAt;
+#endif
+    } updateCycleState;
+    /**
+     * @brief Fixed storage for the update cycle bookkeeping, if any.
+     *
+     * If this is a nullptr, or too small for the number of sensors, the
+     * bookkeeping arrays are put on the stack each time updateAllSensors() or
+     * completeUpdate() is called.  This is set by StaticVariableArray.
+     */
+    updateCycleState* _cycleState;
+#ifdef MS_LOGGER_OVERLAP_MODEM
+    /**
+     * @brief The function called while completeUpdate() waits, if any.
+     */
+    void (*_updatePoll)(void*) = nullptr;
+    /**
+     * @brief The pointer given to #_updatePoll.
+     */
+    void* _updatePollContext = nullptr;
+#endif
+
+#ifdef MS_VALUE_STRING_CACHE_SIZE
+    /**
+     * @brief The formatted values of all of the variables, in order, each
+     * followed by a null.
+     */
+    char _valueCache[MS_VALUE_STRING_CACHE_SIZE];
+    /**
+     * @brief True if #_valueCache holds the values from the last update.
+     */
+    bool _valueCacheValid = false;
+    /**
+     * @brief The array position of the variable last looked up in the cache.
+     */
+    uint8_t _cacheCursorVar = 0;
+    /**
+     * @brief The position in #_valueCache of the value last looked up.
+     */
+    uint16_t _cacheCursorPos = 0;
+#endif
 
  private:
     bool    isLastVarFromSensor(int arrayIndex);
-    uint8_t countMaxToAverage(void);
+    measurementCount_t countMaxToAverage(void);
     bool    checkVariableUUIDs(void);
+    /**
+     * @brief Build the list of unique sensors and their power pin groups and
+     * set #_sensorCount.
+     */
+    void buildSensorList(void);
+    /**
+     * @brief Find another sensor in the array that is holding the bus shared
+     * with a sensor.
+     *
+     * Sensors on different buses (or with no known bus) are never held up by
+     * each other, so their measurements can overlap freely.  Only a sensor
+     * that needs exclusive use of its bus while it measures (see
+     * Sensor::isHoldingBus()) makes the other sensors on that bus wait.
+     *
+     * @param sensorNumber The position of the sensor in #_sensorList.
+     * @return **Sensor\*** The sensor holding the bus, or a nullptr if the bus
+     * is free.
+     */
+    Sensor* findBusHolder(uint8_t sensorNumber);
+    /**
+     * @brief The body of updateAllSensors(), using the given bookkeeping.
+     *
+     * @param state The bookkeeping arrays for the cycle.
+     * @return **bool** True if all steps of the update succeeded.
+     */
+    bool updateAllSensors(updateCycleState& state);
+    /**
+     * @brief The body of completeUpdate(), using the given bookkeeping.
+     *
+     * @param state The bookkeeping arrays for the cycle.
+     * @return **bool** True if all steps of the update succeeded.
+     */
+    bool completeUpdate(updateCycleState& state);
+#ifdef MS_STAGGER_POWER_UP
+    /**
+     * @brief Work out when to power each power pin group so they all finish
+     * together.
+     *
+     * @param state The bookkeeping arrays for the cycle.
+     */
+    void planPowerUps(updateCycleState& state);
+    /**
+     * @brief Power up every power pin group whose time has come, within the
+     * concurrent power up limit.
+     *
+     * @param state The bookkeeping arrays for the cycle.
+     * @param cycleStart The processor time the update started.
+     */
+    void powerUpDueGroups(updateCycleState& state, uint32_t cycleStart);
+    /**
+     * @brief The most power pins to switch on at once; 0 for no limit.
+     */
+    uint8_t _maxConcurrentPowerUps = 0;
+    /**
+     * @brief The processor time the current inrush window started.
+     */
+    uint32_t _inrushWindowStart = 0;
+    /**
+     * @brief The number of power pins switched on in the current inrush
+     * window.
+     */
+    uint8_t _inrushCount = 0;
+    /**
+     * @brief The most startup current to switch on at once, in mA; 0 for no
+     * limit.
+     */
+    uint16_t _powerBudget_mA = 0;
+    /**
+     * @brief The startup current switched on in the current inrush window, in
+     * mA.
+     */
+    uint16_t _inrushCurrent_mA = 0;
+#endif
+#ifdef MS_SENSOR_STANDBY
+    /**
+     * @brief Check if every sensor on a power pin is power cycled, so the pin
+     * can be cut.
+     *
+     * @param powerPinGroup The power pin group, from #_powerPinGroup
+     * @return **bool** True if none of the sensors on the pin is kept
+     * powered.
+     */
+    bool groupPowerCycles(uint8_t powerPinGroup);
+#endif
+#ifdef MS_SHARE_SENSOR_RESULTS
+    /**
+     * @brief Give the current results of a sensor to every variable in this
+     * array that comes from it.
+     *
+     * @param sensor The sensor with the results.
+     */
+    void refreshVariables(Sensor* sensor);
+#endif
+#ifdef MS_SENSOR_BURST_STATS
+    /**
+     * @brief End a sensor's measurements early if adaptive averaging says its
+     * mean is already good enough.
+     *
+     * The sensor's number of measurements to average, and the number for its
+     * power pin if those are being counted, are cut down to what's been
+     * taken.
+     *
+     * @param state The bookkeeping arrays for the cycle.
+     * @param sensorNumber The position of the sensor in #_sensorList.
+     */
+    void checkEnoughMeasurements(updateCycleState& state,
+                                 uint8_t           sensorNumber);
+#endif
+
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    /**
+     * @brief Add a sensor to a min-heap of deadlines.
+     *
+     * @param heap The heap of deadlines; must have room for one more entry.
+     * @param heapSize The number of entries in the heap; incremented.
+     * @param sensorNumber The position of the sensor in #_sensorList.
+     * @param powerUpAt With #MS_STAGGER_POWER_UP, when each power pin group
+     * is powered in the update (updateCycleState::powerUpAt); a sensor isn't
+     * due before its group is.  nullptr if nothing is staggered.
+     * @param cycleStart The millis() the update started at.
+     */
+    void pushDeadline(sensorDeadline heap[], uint8_t& heapSize,
+                      uint8_t sensorNumber, const uint32_t* powerUpAt = nullptr,
+                      uint32_t cycleStart = 0);
+    /**
+     * @brief Remove and return the earliest deadline from a min-heap of
+     * deadlines.
+     *
+     * @param heap The heap of deadlines; must not be empty.
+     * @param heapSize The number of entries in the heap; decremented.
+     * @return **sensorDeadline** The entry with the earliest deadline.
+     */
+    sensorDeadline popDeadline(sensorDeadline heap[], uint8_t& heapSize);
+    /**
+     * @brief Hold until the processor time reaches the deadline, idling the
+     * processor if #MS_IDLE_BETWEEN_DEADLINES is defined.
+     *
+     * @param deadline The processor time to wait for.
+     */
+    void waitForDeadline(uint32_t deadline);
+#endif
 
 #ifdef MS_VARIABLEARRAY_DEBUG_DEEP
     /**
@@ -295,11 +812,12 @@ class VariableArray {
      *
      * @tparam T Any printable type
      * @param arrayToPrint The array of values to print.
+     * @param count The number of values in the array.
      */
     template <typename T>
-    void prettyPrintArray(T arrayToPrint[]) {
+    void prettyPrintArray(T arrayToPrint[], uint8_t count) {
         DEEP_DEBUGGING_SERIAL_OUTPUT.print("[,\t");
-        for (uint8_t i = 0; i < _variableCount; i++) {
+        for (uint8_t i = 0; i < count; i++) {
             DEEP_DEBUGGING_SERIAL_OUTPUT.print(arrayToPrint[i]);
             DEEP_DEBUGGING_SERIAL_OUTPUT.print(",\t");
         }
@@ -314,4 +832,183 @@ class VariableArray {
 #endif  // DEEP_DEBUGGING_SERIAL_OUTPUT
 };
 
+
+/**
+ * @brief A variable array with the number of variables and unique sensors
+ * fixed at compile time.
+ *
+ * This works exactly like a VariableArray, and can be used anywhere one is
+ * expected, but all of the bookkeeping used by updateAllSensors() and
+ * completeUpdate() is kept in fixed members instead of being put on the stack
+ * with every update.  That way the memory needed to update the sensors is
+ * counted in the static RAM use reported by the compiler instead of showing
+ * up as a stack overflow on a board with little RAM.
+ *
+ * If the array turns out to contain more sensors than it was sized for, it
+ * warns and falls back to stack bookkeeping.
+ *
+ * A StaticVariableArray finds its unique sensors by their objects rather than
+ * by their names and locations, so beginning it only compares pointers.  With
+ * #MS_VARIABLE_METADATA_PROGMEM the UUIDs can also be given as one table in
+ * flash, checked against the number of variables by the compiler and parsed
+ * straight into the variables without their text ever being copied to RAM.
+ * With the variables declared as global objects instead of made with `new`,
+ * the whole station is then laid out at compile time:
+ *
+ * @code{.cpp}
+ * Variable* variableList[] = {&mcuSampleNo, &mcuBattery, &ds3231Temp};
+ * const char uuids[][MS_UUID_TEXT_SIZE] PROGMEM = {
+ *     "12345678-abcd-1234-ef00-1234567890ab",
+ *     "12345678-abcd-1234-ef00-1234567890ac",
+ *     "12345678-abcd-1234-ef00-1234567890ad",
+ * };
+ * StaticVariableArray<3, 2> varArray(variableList, uuids);
+ * @endcode
+ *
+ * @tparam N The number of variables in the array.
+ * @tparam S The number of unique sensors attached to those variables.
+ *
+ * @ingroup base_classes
+ */
+template <uint8_t N, uint8_t S>
+class StaticVariableArray : public VariableArray {
+    static_assert(S > 0, "A StaticVariableArray needs room for a sensor");
+    static_assert(S <= MAX_NUMBER_SENSORS,
+                  "S is larger than MAX_NUMBER_SENSORS");
+
+ public:
+    /**
+     * @brief Construct a new Static Variable Array object
+     */
+    StaticVariableArray() : VariableArray() {
+        attachCycleState();
+    }
+    /**
+     * @brief Construct a new Static Variable Array object
+     *
+     * @param variableList An array of exactly N pointers of variable objects.
+     */
+    explicit StaticVariableArray(Variable* (&variableList)[N])
+        : VariableArray(N, variableList, true) {
+        attachCycleState();
+    }
+    /**
+     * @brief Construct a new Static Variable Array object
+     *
+     * @param variableList An array of exactly N pointers of variable objects.
+     * @param uuids An array of UUIDs.  These are linked 1-to-1 with the
+     * variables by array position.
+     */
+    StaticVariableArray(Variable* (&variableList)[N], const char* uuids[])
+        : VariableArray(N, variableList, true) {
+        matchUUIDs(uuids);
+        attachCycleState();
+    }
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Construct a new Static Variable Array object
+     *
+     * @param variableList An array of exactly N pointers of variable objects.
+     * @param uuids A table of exactly N UUIDs, declared `PROGMEM`.  These are
+     * linked 1-to-1 with the variables by array position.
+     */
+    StaticVariableArray(Variable* (&variableList)[N],
+                        const char (&uuids)[N][MS_UUID_TEXT_SIZE])
+        : VariableArray(N, variableList, true) {
+        setFlashUUIDs(variableList, uuids);
+        attachCycleState();
+    }
+#endif
+
+    using VariableArray::begin;
+    /**
+     * @brief Begins the StaticVariableArray.
+     *
+     * @param variableList An array of exactly N pointers of variable objects.
+     */
+    void begin(Variable* (&variableList)[N]) {
+        VariableArray::begin(N, variableList);
+        checkCapacity();
+    }
+    /**
+     * @brief Begins the StaticVariableArray.
+     *
+     * @param variableList An array of exactly N pointers of variable objects.
+     * @param uuids An array of UUIDs.  These are linked 1-to-1 with the
+     * variables by array position.
+     */
+    void begin(Variable* (&variableList)[N], const char* uuids[]) {
+        VariableArray::begin(N, variableList, uuids);
+        checkCapacity();
+    }
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Begins the StaticVariableArray.
+     *
+     * @param variableList An array of exactly N pointers of variable objects.
+     * @param uuids A table of exactly N UUIDs, declared `PROGMEM`.  These are
+     * linked 1-to-1 with the variables by array position.
+     */
+    void begin(Variable* (&variableList)[N],
+               const char (&uuids)[N][MS_UUID_TEXT_SIZE]) {
+        setFlashUUIDs(variableList, uuids);
+        VariableArray::begin(N, variableList);
+        checkCapacity();
+    }
+#endif
+
+ private:
+    measurementCount_t _nMeasurementsCompleted[S];
+    measurementCount_t _nMeasurementsToAverage[S];
+    measurementCount_t _nMeasurementsOnPin[S];
+    measurementCount_t _nCompletedOnPin[S];
+#ifdef MS_USE_DEADLINE_SCHEDULER
+    sensorDeadline _deadlineHeap[S];
+#endif
+#ifdef MS_STAGGER_POWER_UP
+    uint32_t _powerUpAt[S];
+#endif
+    updateCycleState _fixedState;
+
+    /**
+     * @brief Point the base class at the fixed bookkeeping members.
+     */
+    void attachCycleState(void) {
+        _fixedState.capacity               = S;
+        _fixedState.nMeasurementsCompleted = _nMeasurementsCompleted;
+        _fixedState.nMeasurementsToAverage = _nMeasurementsToAverage;
+        _fixedState.nMeasurementsOnPin     = _nMeasurementsOnPin;
+        _fixedState.nCompletedOnPin        = _nCompletedOnPin;
+#ifdef MS_USE_DEADLINE_SCHEDULER
+        _fixedState.deadlineHeap = _deadlineHeap;
+#endif
+#ifdef MS_STAGGER_POWER_UP
+        _fixedState.powerUpAt = _powerUpAt;
+#endif
+        _cycleState      = &_fixedState;
+        _sensorsByObject = true;
+    }
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Parse a table of UUIDs in flash into the variables.
+     */
+    static void setFlashUUIDs(Variable* (&variableList)[N],
+                              const char (&uuids)[N][MS_UUID_TEXT_SIZE]) {
+        for (uint8_t i = 0; i < N; i++) {
+            variableList[i]->setVarUUID(
+                reinterpret_cast<const __FlashStringHelper*>(uuids[i]));
+        }
+    }
+#endif
+    /**
+     * @brief Warn if there are more sensors than the array was sized for.
+     */
+    void checkCapacity(void) {
+        if (_sensorCount > S) {
+            PRINTOUT(F("This StaticVariableArray has"), _sensorCount,
+                     F("sensors but room for only"), S, F("of them!"));
+        }
+    }
+};
+
 #endif  // SRC_VARIABLEARRAY_H_
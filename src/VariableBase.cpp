@@ -10,6 +10,48 @@
 
 #include "VariableBase.h"
 #include "SensorBase.h"
+#if defined(ARDUINO_ARCH_SAMD)
+#include <avr/dtostrf.h>
+#endif
+
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+#if VARIABLE_TEXT_BUFFER_SIZE < 37
+#error VARIABLE_TEXT_BUFFER_SIZE must have room for a 36 character UUID
+#endif
+
+// Bits of _textInFlash
+#define VAR_NAME_IN_FLASH 0x01
+#define VAR_UNIT_IN_FLASH 0x02
+#define VAR_CODE_IN_FLASH 0x04
+
+// Values of _uuidState
+#define VAR_UUID_NONE 0
+#define VAR_UUID_LOWER 1
+#define VAR_UUID_UPPER 2
+#define VAR_UUID_INVALID 3
+
+// The buffer text from flash is copied into and UUIDs are formatted into
+static char variableTextBuffer[VARIABLE_TEXT_BUFFER_SIZE];
+
+#ifndef MS_NO_STRING_GETTERS
+// Returns variable text as a String, reading it from flash if needed
+static String metadataString(const char* text, bool inFlash) {
+    if (inFlash) {
+        return String(reinterpret_cast<const __FlashStringHelper*>(text));
+    }
+    return String(text);
+}
+#endif
+// Returns variable text as a char pointer, copying it out of flash into the
+// shared buffer if needed
+static const char* metadataChars(const char* text, bool inFlash) {
+    if (text == nullptr) { return ""; }
+    if (!inFlash) { return text; }
+    strncpy_P(variableTextBuffer, text, VARIABLE_TEXT_BUFFER_SIZE - 1);
+    variableTextBuffer[VARIABLE_TEXT_BUFFER_SIZE - 1] = '\0';
+    return variableTextBuffer;
+}
+#endif
 
 // ============================================================================
 //  The class and functions for interfacing with a specific variable.
@@ -66,6 +108,73 @@ Variable::Variable(float (*calcFxn)(), uint8_t decimalResolution,
     setCalculation(calcFxn);
 }
 
+Variable::Variable(float (*calcFxn)(void*), void* calcContext,
+                   uint8_t decimalResolution, const char* varName,
+                   const char* varUnit, const char* varCode, const char* uuid)
+    : isCalculated(true) {
+    setVarUUID(uuid);
+    setVarCode(varCode);
+    setVarUnit(varUnit);
+    setVarName(varName);
+    setResolution(decimalResolution);
+
+    setCalculation(calcFxn, calcContext);
+}
+
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+// The same constructors with the name and unit in flash
+Variable::Variable(Sensor* parentSense, const uint8_t sensorVarNum,
+                   uint8_t decimalResolution,
+                   const __FlashStringHelper* varName,
+                   const __FlashStringHelper* varUnit, const char* varCode,
+                   const char* uuid)
+    : _sensorVarNum(sensorVarNum) {
+    setVarUUID(uuid);
+    setVarCode(varCode);
+    setVarUnit(varUnit);
+    setVarName(varName);
+    setResolution(decimalResolution);
+
+    attachSensor(parentSense);
+}
+Variable::Variable(const uint8_t sensorVarNum, uint8_t decimalResolution,
+                   const __FlashStringHelper* varName,
+                   const __FlashStringHelper* varUnit, const char* varCode)
+    : _sensorVarNum(sensorVarNum) {
+    setVarCode(varCode);
+    setVarUnit(varUnit);
+    setVarName(varName);
+    setResolution(decimalResolution);
+}
+Variable::Variable(float (*calcFxn)(), uint8_t decimalResolution,
+                   const __FlashStringHelper* varName,
+                   const __FlashStringHelper* varUnit, const char* varCode,
+                   const char* uuid)
+    : isCalculated(true) {
+    setVarUUID(uuid);
+    setVarCode(varCode);
+    setVarUnit(varUnit);
+    setVarName(varName);
+    setResolution(decimalResolution);
+
+    setCalculation(calcFxn);
+}
+Variable::Variable(float (*calcFxn)(void*), void* calcContext,
+                   uint8_t decimalResolution,
+                   const __FlashStringHelper* varName,
+                   const __FlashStringHelper* varUnit, const char* varCode,
+                   const char* uuid)
+    : isCalculated(true) {
+    setVarUUID(uuid);
+    setVarCode(varCode);
+    setVarUnit(varUnit);
+    setVarName(varName);
+    setResolution(decimalResolution);
+
+    setCalculation(calcFxn, calcContext);
+}
+#endif
+
 // constructor with no arguments
 Variable::Variable() : isCalculated(true) {}
 // Destructor
@@ -131,6 +240,7 @@ void Variable::onSensorUpdate(Sensor* parentSense) {
 
 // This is a helper - it returns the name of the parent sensor, if applicable
 // This is needed for dealing with variables in arrays
+#ifndef MS_NO_STRING_GETTERS
 String Variable::getParentSensorName(void) {
     if (isCalculated) {
         return "Calculated";
@@ -141,6 +251,17 @@ String Variable::getParentSensorName(void) {
         return parentSensor->getSensorName();
     }
 }
+#endif
+const char* Variable::getParentSensorNameChars(void) {
+    if (isCalculated) {
+        return "Calculated";
+    } else if (parentSensor == nullptr) {
+        MS_DBG(F("ERROR! This variable is missing a parent sensor!"));
+        return "";
+    } else {
+        return parentSensor->getSensorNameChars();
+    }
+}
 
 
 // This is a helper - it returns the name and location of the parent sensor, if
@@ -159,8 +280,102 @@ String Variable::getParentSensorNameAndLocation(void) {
 
 // This ties a calculated variable to its calculation function
 void Variable::setCalculation(float (*calcFxn)()) {
-    if (isCalculated) { _calcFxn = calcFxn; }
+    if (isCalculated) {
+        _calcFxn            = calcFxn;
+        _calcFxnWithContext = nullptr;
+    }
 }
+void Variable::setCalculation(float (*calcFxn)(void*), void* calcContext) {
+    if (isCalculated) {
+        _calcFxnWithContext = calcFxn;
+        _calcContext        = calcContext;
+    }
+}
+
+
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+// Values of _calcState
+#define VAR_CALC_STALE 0
+#define VAR_CALC_BUSY 1
+#define VAR_CALC_KEPT 2
+
+// This declares the variables a calculation uses
+void Variable::setCalcInputs(Variable** calcInputs, uint8_t inputCount) {
+    _calcInputs     = calcInputs;
+    _calcInputCount = calcInputs == nullptr ? 0 : inputCount;
+}
+// This calculates the value of the inputs and then this variable, and keeps it
+void Variable::memoizeCalculation(void) {
+    // Skip measured variables, those already done, and loops of inputs
+    if (!isCalculated || _calcState != VAR_CALC_STALE) { return; }
+    _calcState = VAR_CALC_BUSY;
+    for (uint8_t i = 0; i < _calcInputCount; i++) {
+        _calcInputs[i]->memoizeCalculation();
+    }
+    _currentValue = getValue(true);
+    _calcState    = VAR_CALC_KEPT;
+}
+// This forgets the kept values of this variable and its inputs
+void Variable::clearCalculation(void) {
+    // Stop at loops of inputs
+    if (_calcState == VAR_CALC_BUSY) { return; }
+    _calcState = VAR_CALC_BUSY;
+    for (uint8_t i = 0; i < _calcInputCount; i++) {
+        _calcInputs[i]->clearCalculation();
+    }
+    _calcState = VAR_CALC_STALE;
+}
+#endif
+
+
+#ifdef MS_PUBLISH_ON_CHANGE
+void Variable::setDeadband(float deadband, uint32_t maxSilence_s) {
+    _deadband     = deadband;
+    _maxSilence_s = maxSilence_s;
+    // Send the next value whatever it is
+    _hasPublished = false;
+}
+bool Variable::checkForChange(uint32_t timestamp) {
+    float value = getValue();
+    if (_deadband < 0 || !_hasPublished) {
+        _changed = true;
+    } else if ((value == -9999) != (_lastPublishedValue == -9999)) {
+        // Going bad or coming back is always news
+        _changed = true;
+    } else {
+        _changed = fabs(value - _lastPublishedValue) > _deadband ||
+            (_maxSilence_s > 0 &&
+             timestamp - _lastPublishedTime >= _maxSilence_s);
+    }
+    if (_changed) {
+        _lastPublishedValue = value;
+        _lastPublishedTime  = timestamp;
+        _hasPublished       = true;
+    } else {
+        MS_DBG(getVarCodeChars(), F("hasn't changed; it won't be published"));
+    }
+    return _changed;
+}
+bool Variable::hasChanged(void) {
+    return _changed;
+}
+#endif
+
+
+#ifdef MS_VARIABLE_HISTORY
+void Variable::setHistory(VariableHistory* history, Variable* historySource) {
+    _history       = history;
+    _historySource = historySource == nullptr ? this : historySource;
+}
+VariableHistory* Variable::getHistory(void) {
+    return _history;
+}
+void Variable::recordHistory(uint32_t timestamp) {
+    if (_history != nullptr) {
+        _history->add(_historySource->getValue(), timestamp);
+    }
+}
+#endif
 
 
 // This gets/sets the variable's resolution for value strings
@@ -173,38 +388,223 @@ void Variable::setResolution(uint8_t decimalResolution) {
 
 // This gets/sets the variable's name using
 // http://vocabulary.odm2.org/variablename/
+#ifndef MS_NO_STRING_GETTERS
 String Variable::getVarName(void) {
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    return metadataString(_varName, _textInFlash & VAR_NAME_IN_FLASH);
+#else
     return _varName;
+#endif
+}
+#endif
+// The char versions return an empty string rather than a null pointer for
+// unset text, the same as the String versions do
+const char* Variable::getVarNameChars(void) {
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    return metadataChars(_varName, _textInFlash & VAR_NAME_IN_FLASH);
+#else
+    return _varName == nullptr ? "" : _varName;
+#endif
 }
 void Variable::setVarName(const char* varName) {
     _varName = varName;
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    _textInFlash &= ~VAR_NAME_IN_FLASH;
+#endif
+}
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+void Variable::setVarName(const __FlashStringHelper* varName) {
+    _varName = reinterpret_cast<const char*>(varName);
+    _textInFlash |= VAR_NAME_IN_FLASH;
 }
+#endif
 
 // This gets/sets the variable's unit using http://vocabulary.odm2.org/units/
+#ifndef MS_NO_STRING_GETTERS
 String Variable::getVarUnit(void) {
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    return metadataString(_varUnit, _textInFlash & VAR_UNIT_IN_FLASH);
+#else
     return _varUnit;
+#endif
+}
+#endif
+const char* Variable::getVarUnitChars(void) {
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    return metadataChars(_varUnit, _textInFlash & VAR_UNIT_IN_FLASH);
+#else
+    return _varUnit == nullptr ? "" : _varUnit;
+#endif
 }
 void Variable::setVarUnit(const char* varUnit) {
     _varUnit = varUnit;
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    _textInFlash &= ~VAR_UNIT_IN_FLASH;
+#endif
+}
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+void Variable::setVarUnit(const __FlashStringHelper* varUnit) {
+    _varUnit = reinterpret_cast<const char*>(varUnit);
+    _textInFlash |= VAR_UNIT_IN_FLASH;
 }
+#endif
 
 // This returns a customized code for the variable
+#ifndef MS_NO_STRING_GETTERS
 String Variable::getVarCode(void) {
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    return metadataString(_varCode, _textInFlash & VAR_CODE_IN_FLASH);
+#else
     return _varCode;
+#endif
+}
+#endif
+const char* Variable::getVarCodeChars(void) {
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    return metadataChars(_varCode, _textInFlash & VAR_CODE_IN_FLASH);
+#else
+    return _varCode == nullptr ? "" : _varCode;
+#endif
 }
 // This sets the variable code to a new custom value
 void Variable::setVarCode(const char* varCode) {
     _varCode = varCode;
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    _textInFlash &= ~VAR_CODE_IN_FLASH;
+#endif
 }
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+void Variable::setVarCode(const __FlashStringHelper* varCode) {
+    _varCode = reinterpret_cast<const char*>(varCode);
+    _textInFlash |= VAR_CODE_IN_FLASH;
+}
+#endif
 
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+// This returns the variable UUID, if one has been assigned, formatted from
+// the stored bytes
+#ifndef MS_NO_STRING_GETTERS
+String Variable::getVarUUID(void) {
+    return String(getVarUUIDChars());
+}
+#endif
+const char* Variable::getVarUUIDChars(void) {
+    if (_uuidState != VAR_UUID_LOWER && _uuidState != VAR_UUID_UPPER) {
+        return "";
+    }
+    const char* hexDigits = _uuidState == VAR_UUID_UPPER ? "0123456789ABCDEF"
+                                                         : "0123456789abcdef";
+    char*       out       = variableTextBuffer;
+    for (uint8_t i = 0; i < 16; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) { *out++ = '-'; }
+        *out++ = hexDigits[_uuidBytes[i] >> 4];
+        *out++ = hexDigits[_uuidBytes[i] & 0x0F];
+    }
+    *out = '\0';
+    return variableTextBuffer;
+}
+// This sets the UUID
+void Variable::setVarUUID(const char* uuid) {
+    parseUUID(uuid, false);
+}
+void Variable::setVarUUID(const __FlashStringHelper* uuid) {
+    parseUUID(reinterpret_cast<const char*>(uuid), true);
+}
+// This parses "12345678-abcd-1234-ef00-1234567890ab" into 16 bytes
+void Variable::parseUUID(const char* uuid, bool inFlash) {
+    memset(_uuidBytes, 0, sizeof(_uuidBytes));
+    _uuidState = VAR_UUID_NONE;
+    if (uuid == nullptr) { return; }
+
+    bool    valid   = true;
+    bool    upper   = false;
+    uint8_t nibbles = 0;
+    uint8_t len     = 0;
+    // Read at most one character past a correctly sized UUID
+    for (; len < MS_UUID_TEXT_SIZE; len++) {
+        char c = inFlash ? pgm_read_byte(uuid + len) : uuid[len];
+        if (c == '\0') { break; }
+        if (len == 8 || len == 13 || len == 18 || len == 23) {
+            if (c != '-') { valid = false; }
+            continue;
+        }
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            nibble = c - 'A' + 10;
+            upper  = true;
+        } else {
+            valid = false;
+            continue;
+        }
+        if (nibbles < 32) {
+            _uuidBytes[nibbles / 2] |= (nibbles % 2) ? nibble : nibble << 4;
+            nibbles++;
+        }
+    }
+
+    // If no UUID, move on
+    if (len == 0) { return; }
+    if (len != 36 || !valid) {
+        MS_DBG(F("UUID for"), getVarCodeChars(),
+               F("is not a correctly formatted 36 character UUID and will not "
+                 "be used."));
+        memset(_uuidBytes, 0, sizeof(_uuidBytes));
+        _uuidState = VAR_UUID_INVALID;
+        return;
+    }
+    _uuidState = upper ? VAR_UUID_UPPER : VAR_UUID_LOWER;
+}
+// This checks that the UUID was properly formatted
+bool Variable::checkUUIDFormat(void) {
+    return _uuidState != VAR_UUID_INVALID;
+}
+// This checks if two variables have the same UUID
+bool Variable::hasSameUUID(Variable* other) {
+    return _uuidState == other->_uuidState &&
+        memcmp(_uuidBytes, other->_uuidBytes, sizeof(_uuidBytes)) == 0;
+}
+// This hashes the same bytes hasSameUUID() compares
+uint16_t Variable::getUUIDHash(void) {
+    // FNV-1a, folded down to 16 bits
+    uint32_t hash = (2166136261UL ^ _uuidState) * 16777619UL;
+    for (uint8_t i = 0; i < sizeof(_uuidBytes); i++) {
+        hash ^= _uuidBytes[i];
+        hash *= 16777619UL;
+    }
+    return (hash >> 16) ^ (hash & 0xFFFF);
+}
+#else
 // This returns the variable UUID, if one has been assigned
+#ifndef MS_NO_STRING_GETTERS
 String Variable::getVarUUID(void) {
     return _uuid;
 }
+#endif
+const char* Variable::getVarUUIDChars(void) {
+    return _uuid == nullptr ? "" : _uuid;
+}
 // This sets the UUID
 void Variable::setVarUUID(const char* uuid) {
     _uuid = uuid;
 }
+// This checks if two variables have the same UUID
+bool Variable::hasSameUUID(Variable* other) {
+    return strcmp(getVarUUIDChars(), other->getVarUUIDChars()) == 0;
+}
+// This hashes the same text hasSameUUID() compares
+uint16_t Variable::getUUIDHash(void) {
+    // FNV-1a, folded down to 16 bits
+    uint32_t hash = 2166136261UL;
+    for (const char* c = getVarUUIDChars(); *c != '\0'; c++) {
+        hash ^= static_cast<uint8_t>(*c);
+        hash *= 16777619UL;
+    }
+    return (hash >> 16) ^ (hash & 0xFFFF);
+}
 // This checks that the UUID is properly formatted
 bool Variable::checkUUIDFormat(void) {
     // If no UUID, move on
@@ -212,7 +612,7 @@ bool Variable::checkUUIDFormat(void) {
 
     // Should be 36 characters long with dashes
     if (strlen(_uuid) != 36) {
-        MS_DBG(F("UUID length for"), getVarCode(), '(', _uuid, ')',
+        MS_DBG(F("UUID length for"), getVarCodeChars(), '(', _uuid, ')',
                F("is incorrect, should be 36 characters not"), strlen(_uuid));
         return false;
     }
@@ -221,29 +621,38 @@ bool Variable::checkUUIDFormat(void) {
     const char* acceptableChars = "0123456789abcdefABCDEF-";
     if (_uuid[8] != '-' || _uuid[13] != '-' || _uuid[18] != '-' ||
         _uuid[23] != '-') {
-        MS_DBG(F("UUID format for"), getVarCode(), '(', _uuid, ')',
+        MS_DBG(F("UUID format for"), getVarCodeChars(), '(', _uuid, ')',
                F("is incorrect, expecting dashes at positions 9, 14, 19, and "
                  "24."));
         return false;
     }
     int first_invalid = strspn(_uuid, acceptableChars);
     if (first_invalid != 36) {
-        MS_DBG(F("UUID for"), getVarCode(), '(', _uuid, ')',
+        MS_DBG(F("UUID for"), getVarCodeChars(), '(', _uuid, ')',
                F("has a bad character"), _uuid[first_invalid], F("at"),
                first_invalid);
         return false;
     }
     return true;
 }
+#endif
 
 
 // This returns the current value of the variable as a float
 float Variable::getValue(bool updateValue) {
     if (isCalculated) {
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+        if (!updateValue && _calcState == VAR_CALC_KEPT) {
+            return _currentValue;
+        }
+#endif
         // NOTE:  We cannot "update" the parent sensor's values before doing
         // the calculation because we don't know which sensors those are.
         // Make sure you update the parent sensors manually for a calculated
         // variable!!
+        if (_calcFxnWithContext != nullptr) {
+            return _calcFxnWithContext(_calcContext);
+        }
         return _calcFxn();
     } else {
         if (updateValue) parentSensor->update();
@@ -254,12 +663,72 @@ float Variable::getValue(bool updateValue) {
 
 // This returns the current value of the variable as a string
 // with the correct number of significant figures
+#ifndef MS_NO_STRING_GETTERS
 String Variable::getValueString(bool updateValue) {
+    char buffer[VALUE_STRING_BUFFER_SIZE];
+    getValueChars(buffer, updateValue);
+    return String(buffer);
+}
+#endif
+// This formats the value the same way the String constructors do
+uint8_t Variable::getValueChars(char* buffer, bool updateValue) {
+    return formatValue(getValue(updateValue), _decimalResolution, buffer);
+}
+#ifdef MS_FIXED_POINT_VALUES
+// The scale of each resolution up to 9 digits, so the value is scaled with
+// a single multiply
+static const float resolutionScales[] PROGMEM = {
+    1.0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+#endif
+uint8_t Variable::formatValue(float value, uint8_t resolution, char* buffer) {
+    // Nearly every missing value is the same, so write it without any math;
+    // the text is what dtostrf() would have made of it
+    if (value == -9999 && resolution < VALUE_STRING_BUFFER_SIZE - 6) {
+        memcpy(buffer, "-9999", 5);
+        uint8_t len = 5;
+        if (resolution > 0) {
+            buffer[len++] = '.';
+            memset(buffer + len, '0', resolution);
+            len += resolution;
+        }
+        buffer[len] = '\0';
+        return len;
+    }
+#ifdef MS_FIXED_POINT_VALUES
+    // Count whole units of the resolution; a resolution of 0 is truncated
+    // rather than rounded, as by itoa()
+    float scaled = value;
+    if (resolution <= 9) {
+        scaled *= pgm_read_float(&resolutionScales[resolution]);
+    }
+    if (resolution > 0) { scaled += scaled < 0 ? -0.5f : 0.5f; }
+    if (resolution <= 9 && scaled < 2147483647.0f &&
+        scaled > -2147483647.0f) {
+        int32_t  whole     = static_cast<int32_t>(scaled);
+        uint32_t magnitude = whole < 0 ? -static_cast<uint32_t>(whole) : whole;
+        // Collect the digits backwards, with at least one before the point
+        char    digits[11];
+        uint8_t nDigits = 0;
+        do {
+            digits[nDigits++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude != 0 || nDigits <= resolution);
+        uint8_t len = 0;
+        if (whole < 0) { buffer[len++] = '-'; }
+        while (nDigits > 0) {
+            if (nDigits == resolution) { buffer[len++] = '.'; }
+            buffer[len++] = digits[--nDigits];
+        }
+        buffer[len] = '\0';
+        return len;
+    }
+#endif
     // Need this because otherwise get extra spaces in strings from int
-    if (_decimalResolution == 0) {
-        auto val = static_cast<int16_t>(getValue(updateValue));
-        return String(val);
+    if (resolution == 0) {
+        auto val = static_cast<int16_t>(value);
+        itoa(val, buffer, 10);
     } else {
-        return String(getValue(updateValue), _decimalResolution);
+        dtostrf(value, resolution + 2, resolution, buffer);
     }
+    return strlen(buffer);
 }
@@ -27,6 +27,142 @@ class Sensor;
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
+#ifdef MS_VARIABLE_HISTORY
+#include "VariableHistory.h"
+#endif
+
+/**
+ * @brief The size of a character buffer big enough for any value formatted
+ * by Variable::getValueChars().
+ *
+ * This is the same size as the buffer used by the Arduino String constructor
+ * for floats.
+ */
+#define VALUE_STRING_BUFFER_SIZE 33
+
+/**
+ * @def MS_VARIABLE_METADATA_PROGMEM
+ * @brief Keep the names and units of the variables in this library in flash
+ * and hold UUIDs as 16 raw bytes.
+ *
+ * On AVR boards every quoted name and unit is otherwise copied into RAM at
+ * start up.  With this defined they stay in flash and are only copied out,
+ * one at a time, into a small shared buffer while they are being printed or
+ * sent.  UUIDs are parsed into 16 bytes when they are set and turned back into
+ * text only when they are sent; to keep the UUID text itself out of RAM, set
+ * it from flash with `setVarUUID(F("..."))`.
+ *
+ * A UUID that is not correctly formatted cannot be stored this way and is
+ * dropped; checkUUIDFormat() still reports it.
+ */
+// #define MS_VARIABLE_METADATA_PROGMEM
+
+/**
+ * @def MS_NO_STRING_GETTERS
+ * @brief Leave out the functions of the variables and the logger that return
+ * their text as Strings.
+ *
+ * Each of those Strings is allocated from the heap every time it is called,
+ * which breaks up the little heap of an AVR board over a long deployment.
+ * With this defined only the `...Chars()` versions remain, so any sketch or
+ * library code still using the String versions fails to build instead of
+ * allocating.  The text returned by the `...Chars()` versions may be in a
+ * shared buffer; use it before getting any other variable text.
+ *
+ * @note This only removes these getters.  Other parts of the library, like
+ * the sensor locations and the modem, still build Strings on the heap.
+ */
+// #define MS_NO_STRING_GETTERS
+
+/**
+ * @def MS_FIXED_POINT_VALUES
+ * @brief Write values as text by turning them into a whole number of units of
+ * their resolution and printing that, instead of with dtostrf().
+ *
+ * On AVR boards dtostrf() works through the value in software floating point
+ * one digit at a time; this takes only one floating point multiply per digit
+ * of resolution and then works with whole numbers.  The text is the same,
+ * except that a negative value that rounds to zero is written without the
+ * minus sign and a resolution of 0 no longer wraps above 32767.  Values too
+ * large for a 32 bit whole number of units still go through dtostrf().
+ */
+// #define MS_FIXED_POINT_VALUES
+
+/**
+ * @brief The size of the text of a UUID, with its terminating null.
+ */
+#define MS_UUID_TEXT_SIZE 37
+
+#if defined(MS_VARIABLE_METADATA_PROGMEM) || defined(DOXYGEN)
+#ifndef VARIABLE_TEXT_BUFFER_SIZE
+/**
+ * @brief The size of the buffer that variable text stored in flash is copied
+ * into by the char accessors; longer text is truncated.
+ *
+ * Only used with #MS_VARIABLE_METADATA_PROGMEM.  It must have room for a 36
+ * character UUID.
+ */
+#define VARIABLE_TEXT_BUFFER_SIZE 49
+#endif
+#endif
+
+/**
+ * @def MS_MEMOIZE_CALCULATED_VARIABLES
+ * @brief Define this build flag to have a VariableArray evaluate each of its
+ * calculated variables once at the end of every update and keep the result.
+ *
+ * Every later call to Variable::getValue() - from the data file, each
+ * publisher, or another calculated variable that uses it - then returns the
+ * kept value instead of running the calculation again.  Declare the variables
+ * a calculation reads with Variable::setCalcInputs() so they are evaluated
+ * first, wherever they are in the array.
+ */
+// #define MS_MEMOIZE_CALCULATED_VARIABLES
+
+/**
+ * @def MS_PUBLISH_ON_CHANGE
+ * @brief Define this build flag to let publishers that can take partial
+ * updates leave out variables that haven't changed.
+ *
+ * Give a variable a deadband, and optionally a longest silence, with
+ * Variable::setDeadband().  At each publish, the variable is only included by
+ * the Ubidots, MQTT, and CBOR publishers if it has moved more than the
+ * deadband from the last value that was sent, if it has gone to or from
+ * -9999, or if the longest silence has passed.  The other publishers and the
+ * data file always get every variable, and so do records sent from the
+ * outbox.
+ *
+ * @note The value counts as sent once a publish starts.  Without
+ * #MS_PUBLISHER_OUTBOX, a change in a publish that fails isn't sent again
+ * until the variable changes again or its longest silence passes.
+ */
+// #define MS_PUBLISH_ON_CHANGE
+
+/**
+ * @def MS_VARIABLE_HISTORY
+ * @brief Define this build flag to let variables keep their recent values in
+ * RAM, with a running sum, minimum, maximum, and slope.
+ *
+ * Give a variable a VariableHistory with Variable::setHistory().  Each time
+ * the logger takes a record, every variable with a history adds its value,
+ * with the time of the record, before any calculated variable is read, so a
+ * calculation can use something like the mean of the last hour without
+ * reading the data file.  A WindowedVariable reports a statistic of the
+ * recent values of another variable, like a rolling mean or a 24-hour total,
+ * as a variable of its own.  The number of values kept is set at compile time
+ * with #MS_VARIABLE_HISTORY_SIZE.
+ */
+// #define MS_VARIABLE_HISTORY
+
+/**
+ * @brief Mark the text of a variable name or unit defined in this library so
+ * that it is stored in flash when #MS_VARIABLE_METADATA_PROGMEM is defined.
+ */
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+#define MS_VAR_TEXT(text) F(text)
+#else
+#define MS_VAR_TEXT(text) text
+#endif
 
 /**
  * @brief The variable class for a value and related metadata.
@@ -131,6 +267,73 @@ class Variable {
      */
     Variable(float (*calcFxn)(), uint8_t decimalResolution, const char* varName,
              const char* varUnit, const char* varCode);
+    /**
+     * @brief Construct a new Variable object for a calculated variable whose
+     * calculation function needs some extra context - ie, a pointer to the
+     * object it calculates from.
+     *
+     * @param calcFxn Any function taking a void pointer and returning a float
+     * value
+     * @param calcContext The pointer handed to the calcFxn every time it is
+     * run.
+     * @param decimalResolution The resolution (in decimal places) of the value.
+     * @param varName The name of the variable per the [ODM2 variable name
+     * controlled vocabulary](http://vocabulary.odm2.org/variablename/)
+     * @param varUnit The unit of the variable per the [ODM2 unit controlled
+     * vocabulary](http://vocabulary.odm2.org/units/)
+     * @param varCode A custom code for the variable.  This can be any short
+     * text helping to identify the variable in files.
+     * @param uuid A universally unique identifier for the variable.
+     */
+    Variable(float (*calcFxn)(void*), void* calcContext,
+             uint8_t decimalResolution, const char* varName,
+             const char* varUnit, const char* varCode, const char* uuid);
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Construct a new Variable object for a measured variable whose
+     * name and unit are stored in flash.
+     *
+     * The parameters are the same as for the constructor taking the name and
+     * unit as `const char*`.
+     */
+    Variable(Sensor* parentSense, const uint8_t sensorVarNum,
+             uint8_t decimalResolution, const __FlashStringHelper* varName,
+             const __FlashStringHelper* varUnit, const char* varCode,
+             const char* uuid);
+    /**
+     * @brief Construct a new Variable object for a measured variable whose
+     * name and unit are stored in flash, but do not tie it to a specific
+     * sensor.
+     *
+     * The parameters are the same as for the constructor taking the name and
+     * unit as `const char*`.
+     */
+    Variable(const uint8_t sensorVarNum, uint8_t decimalResolution,
+             const __FlashStringHelper* varName,
+             const __FlashStringHelper* varUnit, const char* varCode);
+    /**
+     * @brief Construct a new Variable object for a calculated variable whose
+     * name and unit are stored in flash.
+     *
+     * The parameters are the same as for the constructor taking the name and
+     * unit as `const char*`.
+     */
+    Variable(float (*calcFxn)(), uint8_t decimalResolution,
+             const __FlashStringHelper* varName,
+             const __FlashStringHelper* varUnit, const char* varCode,
+             const char* uuid);
+    /**
+     * @brief Construct a new Variable object for a calculated variable with a
+     * context pointer whose name and unit are stored in flash.
+     *
+     * The parameters are the same as for the constructor taking the name and
+     * unit as `const char*`.
+     */
+    Variable(float (*calcFxn)(void*), void* calcContext,
+             uint8_t decimalResolution, const __FlashStringHelper* varName,
+             const __FlashStringHelper* varUnit, const char* varCode,
+             const char* uuid);
+#endif
     /**
      * @brief Construct a new Variable object
      */
@@ -234,6 +437,7 @@ class Variable {
      * @param parentSense  The Sensor object supplying values.
      */
     void onSensorUpdate(Sensor* parentSense);
+#ifndef MS_NO_STRING_GETTERS
     /**
      * @brief Get the parent sensor name, if applicable
      *
@@ -242,6 +446,14 @@ class Variable {
      * @return **String** The parent sensor name
      */
     String getParentSensorName(void);
+#endif
+    /**
+     * @brief Get the parent sensor name, if applicable, without copying it
+     * into a String
+     *
+     * @return **const char\*** The parent sensor name
+     */
+    const char* getParentSensorNameChars(void);
     /**
      * @brief Get the parent sensor name and location, if applicable.
      *
@@ -257,6 +469,101 @@ class Variable {
      * @param calcFxn Any function returning a float value.
      */
     void setCalculation(float (*calcFxn)());
+    /**
+     * @brief Set the calculation function for a calculated variable that needs
+     * extra context.
+     *
+     * @param calcFxn Any function taking a void pointer and returning a float
+     * value.
+     * @param calcContext The pointer handed to the calcFxn every time it is
+     * run.
+     */
+    void setCalculation(float (*calcFxn)(void*), void* calcContext);
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    /**
+     * @brief Declare the variables the calculation function of a calculated
+     * variable reads its values from.
+     *
+     * Any calculated variables among the inputs are evaluated before this one.
+     *
+     * @param calcInputs An array of pointers to the input variables.  The
+     * array is not copied and must stay in scope.
+     * @param inputCount The number of variables in the array.
+     */
+    void setCalcInputs(Variable** calcInputs, uint8_t inputCount);
+    /**
+     * @brief Evaluate a calculated variable, after any calculated variables
+     * it uses, and keep the result to return from getValue().
+     *
+     * This does nothing if the variable is not calculated or already has a
+     * kept value.  It is called by VariableArray at the end of each update.
+     */
+    void memoizeCalculation(void);
+    /**
+     * @brief Forget the kept value of a calculated variable and of all of the
+     * calculated variables it uses, so the next getValue() calculates again.
+     */
+    void clearCalculation(void);
+#endif
+
+#ifdef MS_PUBLISH_ON_CHANGE
+    /**
+     * @brief Set how much the variable must change before publishers that
+     * take partial updates send it again.
+     *
+     * @param deadband The smallest change from the last value sent that is
+     * sent again; a negative deadband (the default) sends every value.
+     * @param maxSilence_s The longest time in seconds to go without sending
+     * the variable, even if it hasn't changed; 0 for no limit.
+     */
+    void setDeadband(float deadband, uint32_t maxSilence_s = 0);
+    /**
+     * @brief Decide whether the current value is worth publishing, and if it
+     * is remember it as the last value sent.
+     *
+     * This is called once for each variable by Logger::publishDataToRemotes()
+     * before any publisher runs, so every publisher gets the same answer.
+     *
+     * @param timestamp The time of the record being published, in seconds.
+     * @return **bool** True if the value should be published.
+     */
+    bool checkForChange(uint32_t timestamp);
+    /**
+     * @brief Get the answer of the last checkForChange().
+     *
+     * @return **bool** True if the value should be published.
+     */
+    bool hasChanged(void);
+#endif
+
+#ifdef MS_VARIABLE_HISTORY
+    /**
+     * @brief Give the variable a history of its recent values
+     * (#MS_VARIABLE_HISTORY).
+     *
+     * @param history The history to add the values to; null for none.  It is
+     * not copied and must stay in scope.
+     * @param historySource The variable whose values are added to the
+     * history; optional with the default of null for this one.
+     */
+    void setHistory(VariableHistory* history,
+                    Variable*        historySource = nullptr);
+    /**
+     * @brief Get the history of the variable's recent values
+     * (#MS_VARIABLE_HISTORY).
+     *
+     * @return **VariableHistory\*** The history, or null if it has none.
+     */
+    VariableHistory* getHistory(void);
+    /**
+     * @brief Add the current value to the variable's history, if it has one.
+     *
+     * This is called for every variable by VariableArray::recordHistory().
+     *
+     * @param timestamp The time of the value, in seconds.
+     */
+    void recordHistory(uint32_t timestamp);
+#endif
 
     // This gets/sets the variable's resolution for value strings
     /**
@@ -271,12 +578,24 @@ class Variable {
      * @param decimalResolution The resolution (in decimal places) of the value.
      */
     void setResolution(uint8_t decimalResolution);
+#ifndef MS_NO_STRING_GETTERS
     /**
      * @brief Get the variable name
      *
      * @return **String** The variable name
      */
     String getVarName(void);
+#endif
+    /**
+     * @brief Get the variable name without copying it into a String
+     *
+     * @return **const char\*** The variable name
+     *
+     * @note With #MS_VARIABLE_METADATA_PROGMEM the text may be copied into a
+     * buffer shared by all variables; it is only valid until the next call to
+     * any of the char accessors.
+     */
+    const char* getVarNameChars(void);
     /**
      * @brief Set the variable name.
      *
@@ -287,12 +606,32 @@ class Variable {
      * controlled vocabulary.
      */
     void setVarName(const char* varName);
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Set the variable name from text stored in flash.
+     *
+     * @param varName The text, ie, `F("...")`.
+     */
+    void setVarName(const __FlashStringHelper* varName);
+#endif
+#ifndef MS_NO_STRING_GETTERS
     /**
      * @brief Get the variable unit
      *
      * @return **String** The variable unit
      */
     String getVarUnit(void);
+#endif
+    /**
+     * @brief Get the variable unit without copying it into a String
+     *
+     * @return **const char\*** The variable unit
+     *
+     * @note With #MS_VARIABLE_METADATA_PROGMEM the text may be copied into a
+     * buffer shared by all variables; it is only valid until the next call to
+     * any of the char accessors.
+     */
+    const char* getVarUnitChars(void);
     /**
      * @brief Set the variable unit.
      *
@@ -303,12 +642,33 @@ class Variable {
      * vocabulary.
      */
     void setVarUnit(const char* varUnit);
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Set the variable unit from text stored in flash.
+     *
+     * @param varUnit The text, ie, `F("...")`.
+     */
+    void setVarUnit(const __FlashStringHelper* varUnit);
+#endif
+#ifndef MS_NO_STRING_GETTERS
     /**
      * @brief Get the customized code for the variable
      *
      * @return **String** The customized code for the variable
      */
     String getVarCode(void);
+#endif
+    /**
+     * @brief Get the customized code for the variable without copying it into
+     * a String
+     *
+     * @return **const char\*** The customized code for the variable
+     *
+     * @note With #MS_VARIABLE_METADATA_PROGMEM the text may be copied into a
+     * buffer shared by all variables; it is only valid until the next call to
+     * any of the char accessors.
+     */
+    const char* getVarCodeChars(void);
     /**
      * @brief Set a customized code for the variable
      *
@@ -316,19 +676,48 @@ class Variable {
      * text helping to identify the variable in files.
      */
     void setVarCode(const char* varCode);
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Set the variable code from text stored in flash.
+     *
+     * @param varCode The text, ie, `F("...")`.
+     */
+    void setVarCode(const __FlashStringHelper* varCode);
+#endif
     // This gets/sets the variable UUID, if one has been assigned
+#ifndef MS_NO_STRING_GETTERS
     /**
      * @brief Get the customized code for the variable
      *
      * @return **String** The customized code for the variable
      */
     String getVarUUID(void);
+#endif
+    /**
+     * @brief Get the variable UUID without copying it into a String
+     *
+     * @return **const char\*** The variable UUID; an empty string if none has
+     * been assigned
+     *
+     * @note With #MS_VARIABLE_METADATA_PROGMEM the text may be copied into a
+     * buffer shared by all variables; it is only valid until the next call to
+     * any of the char accessors.
+     */
+    const char* getVarUUIDChars(void);
     /**
      * @brief Set a customized code for the variable
      *
      * @param uuid A universally unique identifier for the variable.
      */
     void setVarUUID(const char* uuid);
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Set the UUID of the variable from text stored in flash.
+     *
+     * @param uuid The text, ie, `F("...")`.
+     */
+    void setVarUUID(const __FlashStringHelper* uuid);
+#endif
     /**
      * @brief Verify the the UUID is correctly formatted
      *
@@ -338,15 +727,34 @@ class Variable {
      * indicate that the value of the UUID is correct.
      */
     bool checkUUIDFormat(void);
+    /**
+     * @brief Check if another variable has been given the same UUID as this
+     * one.
+     *
+     * @param other The variable to compare with.
+     * @return **bool** True if the UUIDs are the same.
+     */
+    bool hasSameUUID(Variable* other);
+    /**
+     * @brief Get a short hash of the UUID of the variable.
+     *
+     * Variables with the same UUID always have the same hash, so only the
+     * variables with matching hashes need to be compared with hasSameUUID().
+     *
+     * @return **uint16_t** The hash of the UUID
+     */
+    uint16_t getUUIDHash(void);
 
     /**
      * @brief Get current value of the variable as a float
      *
      * @param updateValue True to ask the parent sensor to measure and return a
-     * new value.  Default is false.
+     * new value.  Default is false.  For a calculated variable this runs the
+     * calculation again even if there is a kept value.
      * @return **float** The current value of the variable
      */
     float getValue(bool updateValue = false);
+#ifndef MS_NO_STRING_GETTERS
     /**
      * @brief Get current value of the variable as a string with the correct
      * decimal resolution
@@ -356,6 +764,38 @@ class Variable {
      * @return **String** The current value of the variable
      */
     String getValueString(bool updateValue = false);
+#endif
+    /**
+     * @brief Write the current value of the variable, with the correct decimal
+     * resolution, into a character buffer without creating a String.
+     *
+     * The text is exactly the same as that returned by getValueString().
+     *
+     * @param buffer A character buffer with room for at least
+     * #VALUE_STRING_BUFFER_SIZE characters.
+     * @param updateValue True to ask the parent sensor to measure and return a
+     * new value.  Default is false.
+     * @return **uint8_t** The number of characters written, not including the
+     * terminating null.
+     */
+    uint8_t getValueChars(char* buffer, bool updateValue = false);
+    /**
+     * @brief Write any value as text with the given decimal resolution, the
+     * same way getValueChars() writes the value of a variable.
+     *
+     * This is the formatter behind every csv record, JSON body, and
+     * ThingSpeak update.  A value of -9999 is written straight out without
+     * going through dtostrf(), and with #MS_FIXED_POINT_VALUES every other
+     * value is scaled to whole units of its resolution with one multiply.
+     *
+     * @param value The value to write
+     * @param resolution The number of digits after the decimal place
+     * @param buffer A character buffer with room for at least
+     * #VALUE_STRING_BUFFER_SIZE characters.
+     * @return **uint8_t** The number of characters written, not including the
+     * terminating null.
+     */
+    static uint8_t formatValue(float value, uint8_t resolution, char* buffer);
 
     /**
      * @brief Pointer to the parent sensor
@@ -378,6 +818,26 @@ class Variable {
 
  private:
     float (*_calcFxn)(void) = nullptr;
+    float (*_calcFxnWithContext)(void*) = nullptr;
+    void* _calcContext                  = nullptr;
+#ifdef MS_MEMOIZE_CALCULATED_VARIABLES
+    Variable** _calcInputs     = nullptr;
+    uint8_t    _calcInputCount = 0;
+    // Whether _currentValue holds a kept calculation result
+    uint8_t _calcState = 0;
+#endif
+#ifdef MS_PUBLISH_ON_CHANGE
+    float    _deadband           = -1;
+    uint32_t _maxSilence_s       = 0;
+    float    _lastPublishedValue = -9999;
+    uint32_t _lastPublishedTime  = 0;
+    bool     _hasPublished       = false;
+    bool     _changed            = true;
+#endif
+#ifdef MS_VARIABLE_HISTORY
+    VariableHistory* _history       = nullptr;
+    Variable*        _historySource = nullptr;
+#endif
 
     const uint8_t _sensorVarNum      = 0;
     uint8_t       _decimalResolution = 0;
@@ -385,7 +845,23 @@ class Variable {
     const char* _varName = nullptr;
     const char* _varUnit = nullptr;
     const char* _varCode = nullptr;
-    const char* _uuid    = nullptr;
+#ifdef MS_VARIABLE_METADATA_PROGMEM
+    /**
+     * @brief Parse UUID text into #_uuidBytes.
+     *
+     * @param uuid The UUID text.
+     * @param inFlash True if the text is stored in flash.
+     */
+    void parseUUID(const char* uuid, bool inFlash);
+
+    // Bits marking which of the name, unit, and code point into flash
+    uint8_t _textInFlash = 0;
+    // The UUID as raw bytes and whether it is unset, valid, or invalid
+    uint8_t _uuidBytes[16] = {0};
+    uint8_t _uuidState     = 0;
+#else
+    const char* _uuid = nullptr;
+#endif
 };
 
 #endif  // SRC_VARIABLEBASE_H_
@@ -0,0 +1,165 @@
+/**
+ * @file VariableHistory.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the VariableHistory class.
+ */
+
+#include "VariableHistory.h"
+
+#ifdef MS_VARIABLE_HISTORY
+
+VariableHistory::VariableHistory(uint32_t maxAge_s) : _maxAge_s(maxAge_s) {}
+VariableHistory::~VariableHistory() {}
+
+
+void VariableHistory::add(float value, uint32_t timestamp) {
+    if (value == -9999) { return; }
+    if (_count > 0) {
+        uint32_t latest = getLatestTime();
+        if (timestamp == latest) { return; }
+        if (timestamp < latest) {
+            MS_DBG(F("The clock went back; starting the history again"));
+            clear();
+        }
+    }
+    if (_count == MS_VARIABLE_HISTORY_SIZE) {
+        // A full ring of values that are all still young enough cuts the
+        // window short
+        if (!_warnedFull && _maxAge_s > 0 &&
+            timestamp - _times[_oldest] <= _maxAge_s) {
+            PRINTOUT(F("A variable history filled up"),
+                     timestamp - _times[_oldest], F("s into its"), _maxAge_s,
+                     F("s window; raise MS_VARIABLE_HISTORY_SIZE"));
+            _warnedFull = true;
+        }
+        dropOldest();
+    }
+    while (_count > 0 && _maxAge_s > 0 &&
+           timestamp - _times[_oldest] > _maxAge_s) {
+        dropOldest();
+    }
+    if (_count == 0) { _base = timestamp; }
+
+    uint16_t slot = (_oldest + _count) % MS_VARIABLE_HISTORY_SIZE;
+    _values[slot] = value;
+    _times[slot]  = timestamp;
+
+    float x = timestamp - _base;
+    _sumY += value;
+    _sumX += x;
+    _sumXX += x * x;
+    _sumXY += x * value;
+
+    // Anything newer that's no lower can never be the minimum once this is
+    // in the queue, and likewise for the maximum
+    while (_minCount > 0 &&
+           _values[at(_minQueue, _minStart, _minCount - 1)] >= value) {
+        _minCount--;
+    }
+    _minQueue[(_minStart + _minCount) % MS_VARIABLE_HISTORY_SIZE] = slot;
+    _minCount++;
+    while (_maxCount > 0 &&
+           _values[at(_maxQueue, _maxStart, _maxCount - 1)] <= value) {
+        _maxCount--;
+    }
+    _maxQueue[(_maxStart + _maxCount) % MS_VARIABLE_HISTORY_SIZE] = slot;
+    _maxCount++;
+    _count++;
+
+    if (slot == MS_VARIABLE_HISTORY_SIZE - 1) { resum(); }
+}
+
+
+void VariableHistory::clear(void) {
+    _oldest   = 0;
+    _count    = 0;
+    _minStart = 0;
+    _minCount = 0;
+    _maxStart = 0;
+    _maxCount = 0;
+    resum();
+}
+
+
+void VariableHistory::dropOldest(void) {
+    uint16_t slot = _oldest;
+    float    x    = _times[slot] - _base;
+    _sumY -= _values[slot];
+    _sumX -= x;
+    _sumXX -= x * x;
+    _sumXY -= x * _values[slot];
+    if (_minCount > 0 && _minQueue[_minStart] == slot) {
+        _minStart = (_minStart + 1) % MS_VARIABLE_HISTORY_SIZE;
+        _minCount--;
+    }
+    if (_maxCount > 0 && _maxQueue[_maxStart] == slot) {
+        _maxStart = (_maxStart + 1) % MS_VARIABLE_HISTORY_SIZE;
+        _maxCount--;
+    }
+    _oldest = (_oldest + 1) % MS_VARIABLE_HISTORY_SIZE;
+    _count--;
+    if (_count == 0) { resum(); }
+}
+
+
+void VariableHistory::resum(void) {
+    _base  = _count > 0 ? _times[_oldest] : 0;
+    _sumY  = 0;
+    _sumX  = 0;
+    _sumXX = 0;
+    _sumXY = 0;
+    for (uint16_t n = 0; n < _count; n++) {
+        uint16_t slot = (_oldest + n) % MS_VARIABLE_HISTORY_SIZE;
+        float    x    = _times[slot] - _base;
+        _sumY += _values[slot];
+        _sumX += x;
+        _sumXX += x * x;
+        _sumXY += x * _values[slot];
+    }
+}
+
+
+uint32_t VariableHistory::getSpan(void) {
+    if (_count == 0) { return 0; }
+    return getLatestTime() - _times[_oldest];
+}
+
+uint32_t VariableHistory::getLatestTime(void) {
+    if (_count == 0) { return 0; }
+    return _times[(_oldest + _count - 1) % MS_VARIABLE_HISTORY_SIZE];
+}
+
+float VariableHistory::getLatest(void) {
+    if (_count == 0) { return -9999; }
+    return _values[(_oldest + _count - 1) % MS_VARIABLE_HISTORY_SIZE];
+}
+
+float VariableHistory::getSum(void) {
+    return _count > 0 ? _sumY : -9999;
+}
+
+float VariableHistory::getMean(void) {
+    return _count > 0 ? _sumY / _count : -9999;
+}
+
+float VariableHistory::getMin(void) {
+    return _minCount > 0 ? _values[_minQueue[_minStart]] : -9999;
+}
+
+float VariableHistory::getMax(void) {
+    return _maxCount > 0 ? _values[_maxQueue[_maxStart]] : -9999;
+}
+
+float VariableHistory::getSlope(void) {
+    if (_count < 2) { return -9999; }
+    // The sums are measured from the base time, but the slope doesn't depend
+    // on where the times are counted from
+    float spreadX = _sumXX - _sumX * _sumX / _count;
+    if (spreadX <= 0) { return -9999; }
+    return (_sumXY - _sumX * _sumY / _count) / spreadX;
+}
+
+#endif  // MS_VARIABLE_HISTORY
@@ -0,0 +1,203 @@
+/**
+ * @file VariableHistory.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the VariableHistory class, which keeps the recent values of
+ * a variable in RAM with their sum, minimum, maximum, and slope.
+ */
+
+// Header Guards
+#ifndef SRC_VARIABLEHISTORY_H_
+#define SRC_VARIABLEHISTORY_H_
+
+// Debugging Statement
+// #define MS_VARIABLEHISTORY_DEBUG
+
+#ifdef MS_VARIABLEHISTORY_DEBUG
+#define MS_DEBUGGING_STD "VariableHistory"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+
+#ifdef MS_VARIABLE_HISTORY
+#ifndef MS_VARIABLE_HISTORY_SIZE
+/**
+ * @brief The most values each VariableHistory holds (#MS_VARIABLE_HISTORY).
+ *
+ * Each value takes 14 bytes.  A history that fills up before its values are
+ * as old as its limit prints a warning once.
+ */
+#define MS_VARIABLE_HISTORY_SIZE 12
+#endif
+
+
+/**
+ * @brief The VariableHistory class keeps the most recent values of a variable,
+ * with their times, in a fixed ring (#MS_VARIABLE_HISTORY).
+ *
+ * The sums for the mean and the least-squares slope are kept up to date as
+ * values come and go, and the minimum and maximum are kept with a monotonic
+ * queue of the ring positions, so adding a value and every statistic take the
+ * same time however full the ring is.  The sums are added up again from the
+ * values each time the ring wraps around, so rounding doesn't build up.
+ * Values of -9999 aren't added, so the statistics are of the good values
+ * only.
+ *
+ * Attach a history to a variable with Variable::setHistory(); the logger then
+ * adds each value it records.
+ *
+ * @ingroup base_classes
+ */
+class VariableHistory {
+ public:
+    /**
+     * @brief Construct a new VariableHistory object.
+     *
+     * @param maxAge_s The oldest value to keep, in seconds before the newest;
+     * optional with the default of 0 to keep the last
+     * #MS_VARIABLE_HISTORY_SIZE values whatever their age.
+     */
+    explicit VariableHistory(uint32_t maxAge_s = 0);
+    /**
+     * @brief Destroy the VariableHistory object - no action taken.
+     */
+    ~VariableHistory();
+
+    /**
+     * @brief Add a value, dropping the oldest if the ring is full or it's
+     * too old.
+     *
+     * A value with the same time as the newest is ignored, and a time earlier
+     * than the newest (the clock was set back) starts the history again.
+     *
+     * @param value The value; -9999 is ignored
+     * @param timestamp The time of the value, in seconds
+     */
+    void add(float value, uint32_t timestamp);
+    /**
+     * @brief Forget all of the values.
+     */
+    void clear(void);
+
+    /**
+     * @brief Get the number of values held.
+     *
+     * @return **uint16_t** The number of values.
+     */
+    uint16_t getCount(void) {
+        return _count;
+    }
+    /**
+     * @brief Get the time from the oldest value held to the newest.
+     *
+     * @return **uint32_t** The time in seconds.
+     */
+    uint32_t getSpan(void);
+    /**
+     * @brief Get the time of the newest value.
+     *
+     * @return **uint32_t** The time in seconds, or 0 if there are no values.
+     */
+    uint32_t getLatestTime(void);
+    /**
+     * @brief Get the newest value.
+     *
+     * @return **float** The value, or -9999 if there are no values.
+     */
+    float getLatest(void);
+    /**
+     * @brief Get the sum of the values held.
+     *
+     * @return **float** The sum, or -9999 if there are no values.
+     */
+    float getSum(void);
+    /**
+     * @brief Get the mean of the values held.
+     *
+     * @return **float** The mean, or -9999 if there are no values.
+     */
+    float getMean(void);
+    /**
+     * @brief Get the smallest value held.
+     *
+     * @return **float** The minimum, or -9999 if there are no values.
+     */
+    float getMin(void);
+    /**
+     * @brief Get the largest value held.
+     *
+     * @return **float** The maximum, or -9999 if there are no values.
+     */
+    float getMax(void);
+    /**
+     * @brief Get the least-squares slope of the values held against their
+     * times.
+     *
+     * @return **float** The slope in units per second, or -9999 if there are
+     * fewer than two values or they're all at the same time.
+     */
+    float getSlope(void);
+
+ private:
+    /**
+     * @brief Drop the oldest value.
+     */
+    void dropOldest(void);
+    /**
+     * @brief Add up the sums again from the values held, measuring the times
+     * from the oldest.
+     */
+    void resum(void);
+    /**
+     * @brief Get the ring position of a place in a monotonic queue.
+     *
+     * @param queue The queue
+     * @param start The place of its front
+     * @param n The place after the front
+     * @return **uint16_t** The ring position.
+     */
+    static uint16_t at(const uint16_t* queue, uint16_t start, uint16_t n) {
+        return queue[(start + n) % MS_VARIABLE_HISTORY_SIZE];
+    }
+
+    float    _values[MS_VARIABLE_HISTORY_SIZE];
+    uint32_t _times[MS_VARIABLE_HISTORY_SIZE];
+    uint16_t _oldest = 0;
+    uint16_t _count  = 0;
+    uint32_t _maxAge_s;
+    /**
+     * @brief True once it's been said that the history is too short for its
+     * age limit
+     */
+    bool _warnedFull = false;
+    /**
+     * @brief The ring positions of the values that could still be the
+     * minimum, from the oldest, with their values rising
+     */
+    uint16_t _minQueue[MS_VARIABLE_HISTORY_SIZE];
+    uint16_t _minStart = 0;
+    uint16_t _minCount = 0;
+    /**
+     * @brief The ring positions of the values that could still be the
+     * maximum, from the oldest, with their values falling
+     */
+    uint16_t _maxQueue[MS_VARIABLE_HISTORY_SIZE];
+    uint16_t _maxStart = 0;
+    uint16_t _maxCount = 0;
+    /**
+     * @brief The time the sums measure the times from; the oldest time
+     */
+    uint32_t _base = 0;
+    float    _sumY  = 0;
+    float    _sumX  = 0;
+    float    _sumXX = 0;
+    float    _sumXY = 0;
+};
+#endif  // MS_VARIABLE_HISTORY
+
+#endif  // SRC_VARIABLEHISTORY_H_
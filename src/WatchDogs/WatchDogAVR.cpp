@@ -19,6 +19,11 @@
 #include <avr/wdt.h>
 
 volatile uint32_t extendedWatchDogAVR::_barksUntilReset = 0;
+#ifdef MS_WATCHDOG_PHASES
+volatile uint8_t extendedWatchDogAVR::_phase = 0;
+// The phase that overran and its complement, kept through the reset
+static volatile uint8_t overrunRecord[2] __attribute__((section(".noinit")));
+#endif
 
 extendedWatchDogAVR::extendedWatchDogAVR() {}
 extendedWatchDogAVR::~extendedWatchDogAVR() {
@@ -30,6 +35,14 @@ extendedWatchDogAVR::~extendedWatchDogAVR() {
 void extendedWatchDogAVR::setupWatchDog(uint32_t resetTime_s) {
     _resetTime_s                          = resetTime_s;
     extendedWatchDogAVR::_barksUntilReset = _resetTime_s / 8;
+#ifdef MS_WATCHDOG_PHASES
+    // Take the phase the watchdog reset the board in, then clear it
+    if (overrunRecord[1] == static_cast<uint8_t>(~overrunRecord[0])) {
+        _overrunPhase = overrunRecord[0];
+    }
+    overrunRecord[0] = 0;
+    overrunRecord[1] = 0;
+#endif
     MS_DBG(F("Watch-dog timeout is set for"), _resetTime_s,
            F("sec with the interrupt firing"),
            extendedWatchDogAVR::_barksUntilReset, F("times before the reset."));
@@ -87,12 +100,47 @@ void extendedWatchDogAVR::disableWatchDog() {
 
 
 void extendedWatchDogAVR::resetWatchDog() {
+#ifdef MS_WATCHDOG_PHASES
+    // A running phase only gets its own budget
+    if (_phase == 0) {
+        extendedWatchDogAVR::_barksUntilReset = _resetTime_s / 8;
+    }
+#else
     extendedWatchDogAVR::_barksUntilReset = _resetTime_s / 8;
+#endif
     // Reset the watchdog.
     wdt_reset();
 }
 
 
+#ifdef MS_WATCHDOG_PHASES
+void extendedWatchDogAVR::startPhase(uint8_t phase, uint32_t budget_s) {
+    _phaseStart     = millis();
+    _phaseBudget_ms = budget_s * 1000;
+    _phase          = phase;
+    // One more bark than the budget, so the phase can notice it's over first
+    extendedWatchDogAVR::_barksUntilReset = budget_s / 8 + 1;
+    wdt_reset();
+}
+
+
+void extendedWatchDogAVR::endPhase(void) {
+    _phase = 0;
+    resetWatchDog();
+}
+
+
+bool extendedWatchDogAVR::phaseExpired(void) {
+    return _phase != 0 && millis() - _phaseStart >= _phaseBudget_ms;
+}
+
+
+uint8_t extendedWatchDogAVR::getOverrunPhase(void) {
+    return _overrunPhase;
+}
+#endif
+
+
 /**
  * @brief ISR for watchdog early warning
  */
@@ -103,6 +151,11 @@ ISR(WDT_vect) {
     // extendedWatchDogAVR::_barksUntilReset);
     if (extendedWatchDogAVR::_barksUntilReset <= 0) {
         MCUSR = 0;  // reset flags
+#ifdef MS_WATCHDOG_PHASES
+        // Remember which phase hung
+        overrunRecord[0] = extendedWatchDogAVR::_phase;
+        overrunRecord[1] = ~extendedWatchDogAVR::_phase;
+#endif
 
         // Put timer in reset-only mode:
         WDTCSR |= 0b00011000;  // Enter config mode.
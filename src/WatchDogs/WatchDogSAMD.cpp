@@ -16,6 +16,17 @@
 #if defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO)
 
 volatile uint32_t extendedWatchDogSAMD::_barksUntilReset = 0;
+#ifdef MS_WATCHDOG_PHASES
+volatile uint8_t extendedWatchDogSAMD::_phase = 0;
+// The phase that overran and its complement, kept through the reset if the
+// board has RAM that isn't cleared at start up (#MS_WARM_BOOT_SECTION)
+#ifdef MS_WARM_BOOT_SECTION
+static volatile uint8_t overrunRecord[2]
+    __attribute__((section(MS_WARM_BOOT_SECTION)));
+#else
+static volatile uint8_t overrunRecord[2];
+#endif
+#endif
 
 extendedWatchDogSAMD::extendedWatchDogSAMD() {}
 extendedWatchDogSAMD::~extendedWatchDogSAMD() {
@@ -25,6 +36,14 @@ extendedWatchDogSAMD::~extendedWatchDogSAMD() {
 // One-time initialization of watchdog timer.
 void extendedWatchDogSAMD::setupWatchDog(uint32_t resetTime_s) {
     _resetTime_s = resetTime_s;
+#ifdef MS_WATCHDOG_PHASES
+    // Take the phase the watchdog reset the board in, then clear it
+    if (overrunRecord[1] == static_cast<uint8_t>(~overrunRecord[0])) {
+        _overrunPhase = overrunRecord[0];
+    }
+    overrunRecord[0] = 0;
+    overrunRecord[1] = 0;
+#endif
     // Longest interrupt is 16s, so we loop that as many times as needed
     extendedWatchDogSAMD::_barksUntilReset = _resetTime_s / 8;
 
@@ -265,7 +284,14 @@ void extendedWatchDogSAMD::disableWatchDog() {
 
 
 void extendedWatchDogSAMD::resetWatchDog() {
+#ifdef MS_WATCHDOG_PHASES
+    // A running phase only gets its own budget
+    if (_phase == 0) {
+        extendedWatchDogSAMD::_barksUntilReset = _resetTime_s / 8;
+    }
+#else
     extendedWatchDogSAMD::_barksUntilReset = _resetTime_s / 8;
+#endif
     // Write the watchdog clear key value (0xA5) to the watchdog
     // clear register to clear the watchdog timer and reset it.
     WDT->CLEAR.reg = WDT_CLEAR_CLEAR_KEY;
@@ -274,6 +300,35 @@ void extendedWatchDogSAMD::resetWatchDog() {
     WDT->INTFLAG.bit.EW = 1;
 }
 
+#ifdef MS_WATCHDOG_PHASES
+void extendedWatchDogSAMD::startPhase(uint8_t phase, uint32_t budget_s) {
+    _phaseStart     = millis();
+    _phaseBudget_ms = budget_s * 1000;
+    _phase          = phase;
+    // One more bark than the budget, so the phase can notice it's over first
+    extendedWatchDogSAMD::_barksUntilReset = budget_s / 8 + 1;
+    WDT->CLEAR.reg = WDT_CLEAR_CLEAR_KEY;
+    waitForWDTBitSync();
+}
+
+
+void extendedWatchDogSAMD::endPhase(void) {
+    _phase = 0;
+    resetWatchDog();
+}
+
+
+bool extendedWatchDogSAMD::phaseExpired(void) {
+    return _phase != 0 && millis() - _phaseStart >= _phaseBudget_ms;
+}
+
+
+uint8_t extendedWatchDogSAMD::getOverrunPhase(void) {
+    return _overrunPhase;
+}
+#endif
+
+
 void extendedWatchDogSAMD::waitForWDTBitSync() {
 #if defined(__SAMD51__)
     while (WDT->SYNCBUSY.reg) {
@@ -296,6 +351,11 @@ void WDT_Handler(void) {
     if (extendedWatchDogSAMD::_barksUntilReset <=
         0) {  // Clear Early Warning (EW) Interrupt Flag
         WDT->INTFLAG.bit.EW = 1;
+#ifdef MS_WATCHDOG_PHASES
+        // Remember which phase hung
+        overrunRecord[0] = extendedWatchDogSAMD::_phase;
+        overrunRecord[1] = ~extendedWatchDogSAMD::_phase;
+#endif
         // Writing a value different than WDT_CLEAR_CLEAR_KEY causes reset
         WDT->CLEAR.reg = 0xFF;
         while (true) {
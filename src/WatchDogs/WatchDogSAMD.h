@@ -74,7 +74,43 @@ class extendedWatchDogSAMD {
      * @brief Reset the watchdog's clock to prevent the board from resetting.
      */
     void resetWatchDog();
+#ifdef MS_WATCHDOG_PHASES
+    /**
+     * @brief Start a phase with a budget of its own (#MS_WATCHDOG_PHASES).
+     *
+     * Until endPhase(), resetWatchDog() doesn't give the phase any more time;
+     * the board is reset about 8 s after the budget runs out and the phase is
+     * kept for getOverrunPhase() after the reset.
+     *
+     * @param phase A non-zero number for the phase
+     * @param budget_s The time in seconds the phase may take
+     */
+    void startPhase(uint8_t phase, uint32_t budget_s);
+    /**
+     * @brief End the phase, going back to the full time between resets.
+     */
+    void endPhase(void);
+    /**
+     * @brief Check if the phase has used up its budget, so a loop can give up
+     * on the rest of its work before the board is reset.
+     *
+     * @return **bool** True if a phase is running and its budget is used up.
+     */
+    bool phaseExpired(void);
+    /**
+     * @brief Get the phase that was running when the watchdog last reset the
+     * board.
+     *
+     * @return **uint8_t** The phase, or 0 if the last reset wasn't a phase
+     * overrun.
+     */
+    uint8_t getOverrunPhase(void);
 
+    /**
+     * @brief The phase running now, 0 for none.
+     */
+    static volatile uint8_t _phase;
+#endif
 
     /**
      * @brief The number of times the pre-reset interrupt is allowed to fire
@@ -85,6 +121,11 @@ class extendedWatchDogSAMD {
  private:
     void inline waitForWDTBitSync();
     uint32_t _resetTime_s;
+#ifdef MS_WATCHDOG_PHASES
+    uint32_t _phaseStart     = 0;
+    uint32_t _phaseBudget_ms = 0;
+    uint8_t  _overrunPhase   = 0;
+#endif
 };
 
 #endif  // SRC_WATCHDOGS_WATCHDOGSAMD_H_
@@ -0,0 +1,44 @@
+/**
+ * @file WindowedVariable.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the WindowedVariable class.
+ */
+
+#include "WindowedVariable.h"
+
+#ifdef MS_VARIABLE_HISTORY
+
+WindowedVariable::WindowedVariable(Variable* source, windowStatistic statistic,
+                                   uint32_t window_s, uint8_t decimalResolution,
+                                   const char* varName, const char* varUnit,
+                                   const char* varCode, const char* uuid)
+    : Variable(&WindowedVariable::calculate, this, decimalResolution, varName,
+               varUnit, varCode, uuid),
+      _statistic(statistic),
+      _window(window_s) {
+    setHistory(&_window, source);
+}
+WindowedVariable::~WindowedVariable() {}
+
+
+float WindowedVariable::calculate(void* context) {
+    WindowedVariable* windowed = static_cast<WindowedVariable*>(context);
+    VariableHistory&  window   = windowed->_window;
+    switch (windowed->_statistic) {
+        case WINDOW_SUM: return window.getSum();
+        case WINDOW_MIN: return window.getMin();
+        case WINDOW_MAX: return window.getMax();
+        case WINDOW_RATE: {
+            float slope = window.getSlope();
+            return slope == -9999 ? -9999 : slope * 3600;
+        }
+        case WINDOW_COUNT: return window.getCount();
+        case WINDOW_MEAN:
+        default: return window.getMean();
+    }
+}
+
+#endif  // MS_VARIABLE_HISTORY
@@ -0,0 +1,105 @@
+/**
+ * @file WindowedVariable.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the WindowedVariable class, a calculated variable with a
+ * statistic of the recent values of another variable, like a rolling mean or
+ * a 24-hour total.
+ */
+
+// Header Guards
+#ifndef SRC_WINDOWEDVARIABLE_H_
+#define SRC_WINDOWEDVARIABLE_H_
+
+// Debugging Statement
+// #define MS_WINDOWEDVARIABLE_DEBUG
+
+#ifdef MS_WINDOWEDVARIABLE_DEBUG
+#define MS_DEBUGGING_STD "WindowedVariable"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "VariableBase.h"
+
+#ifdef MS_VARIABLE_HISTORY
+/**
+ * @brief The statistics a WindowedVariable can report.
+ */
+typedef enum windowStatistic : uint8_t {
+    WINDOW_MEAN = 0,  ///< The mean of the values in the window
+    WINDOW_SUM,       ///< The total of the values, like a rain total
+    WINDOW_MIN,       ///< The smallest value
+    WINDOW_MAX,       ///< The largest value
+    WINDOW_RATE,      ///< The least-squares slope, in units per hour
+    WINDOW_COUNT,     ///< The number of good values in the window
+} windowStatistic;
+
+
+/**
+ * @brief The WindowedVariable class is a calculated variable that reports a
+ * statistic of the recent values of another variable (#MS_VARIABLE_HISTORY).
+ *
+ * Each holds its own VariableHistory of the source variable, limited to the
+ * window, and adds the source's value each time the logger takes a record, so
+ * the statistic is kept up to date without going back over the values.  It
+ * goes into a variable array, and so into the data file and to the
+ * publishers, like any other variable.  Put it in the same array as its
+ * source.
+ *
+ * The window is a rolling one, the values of the last so many seconds, and
+ * can't hold more than #MS_VARIABLE_HISTORY_SIZE values; raise that for a
+ * long window at a short logging interval, to at least the window divided by
+ * the logging interval.  A window that fills up before it's as long as it
+ * should be prints a warning once.  Until the logger has run for the
+ * whole window, the statistic is of the values it has.  Bad values (-9999)
+ * of the source are left out; if there are no good values in the window, the
+ * value is -9999 (or 0 for #WINDOW_COUNT).
+ *
+ * @ingroup base_classes
+ */
+class WindowedVariable : public Variable {
+ public:
+    /**
+     * @brief Construct a new WindowedVariable object.
+     *
+     * @param source The variable to take the values from
+     * @param statistic The windowStatistic to report
+     * @param window_s The length of the window, in seconds
+     * @param decimalResolution The resolution (in decimal places) of the value.
+     * @param varName The name of the variable per the [ODM2 variable name
+     * controlled vocabulary](http://vocabulary.odm2.org/variablename/)
+     * @param varUnit The unit of the variable per the [ODM2 unit controlled
+     * vocabulary](http://vocabulary.odm2.org/units/)
+     * @param varCode A custom code for the variable.  This can be any short
+     * text helping to identify the variable in files.
+     * @param uuid A universally unique identifier for the variable; optional
+     * with the default of none.
+     */
+    WindowedVariable(Variable* source, windowStatistic statistic,
+                     uint32_t window_s, uint8_t decimalResolution,
+                     const char* varName, const char* varUnit,
+                     const char* varCode, const char* uuid = nullptr);
+    /**
+     * @brief Destroy the WindowedVariable object - no action taken.
+     */
+    ~WindowedVariable();
+
+ private:
+    /**
+     * @brief Work out the statistic of a WindowedVariable.
+     *
+     * @param context The WindowedVariable
+     * @return **float** The statistic, or -9999 if there are no values.
+     */
+    static float calculate(void* context);
+
+    windowStatistic _statistic;
+    VariableHistory _window;
+};
+#endif  // MS_VARIABLE_HISTORY
+
+#endif  // SRC_WINDOWEDVARIABLE_H_
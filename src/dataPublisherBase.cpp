@@ -11,15 +11,41 @@
  */
 #include "dataPublisherBase.h"
 
-char    dataPublisher::txBuffer[MS_SEND_BUFFER_SIZE];
-Client* dataPublisher::txBufferOutClient = nullptr;
+char    dataPublisher::txBufferDefault[MS_SEND_BUFFER_SIZE];
+char*   dataPublisher::txBuffer          = dataPublisher::txBufferDefault;
+size_t  dataPublisher::txBufferSize      = MS_SEND_BUFFER_SIZE;
+Stream* dataPublisher::txBufferOutClient = nullptr;
 size_t  dataPublisher::txBufferLen;
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+Client*     dataPublisher::_keptClient = nullptr;
+const char* dataPublisher::_keptHost   = nullptr;
+uint16_t    dataPublisher::_keptPort   = 0;
+#endif
+#ifdef MS_PUBLISHER_DNS_CACHE
+dataPublisher::dnsCacheEntry dataPublisher::_dnsCache[MS_DNS_CACHE_ENTRIES];
+#endif
+#ifdef MS_PUBLISHER_DATE_SYNC
+uint32_t dataPublisher::_responseDate = 0;
+#endif
+#ifdef MS_LOGGER_BACKFILL
+uint32_t dataPublisher::_responseBackfillFrom = 0;
+uint32_t dataPublisher::_responseBackfillTo   = 0;
+#endif
+#ifdef MS_PUBLISHER_STATS
+dataPublisher* dataPublisher::_statsPublisher = nullptr;
+#endif
 
 // Basic chunks of HTTP
 const char* dataPublisher::getHeader  = "GET ";
 const char* dataPublisher::postHeader = "POST ";
 const char* dataPublisher::HTTPtag    = " HTTP/1.1";
 const char* dataPublisher::hostHeader = "\r\nHost: ";
+const char  dataPublisher::HTTPHostTag[] PROGMEM = " HTTP/1.1\r\nHost: ";
+#ifdef MS_PUBLISHER_CHUNKED
+int16_t     dataPublisher::txBufferChunkStart     = -1;
+const char* dataPublisher::transferEncodingHeader =
+    "\r\nTransfer-Encoding: chunked";
+#endif
 
 // Constructors
 dataPublisher::dataPublisher() {}
@@ -60,6 +86,19 @@ void dataPublisher::setSendInterval(int sendEveryX) {
 }
 
 
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+bool dataPublisher::countRecord(void) {
+    if (_recordsHeld < 0xFFFF) { _recordsHeld++; }
+    return _recordsHeld >= _sendEveryX;
+}
+#endif
+
+
+void dataPublisher::setWaitForResponse(bool waitForResponse) {
+    _waitForResponse = waitForResponse;
+}
+
+
 // "Begins" the publisher - attaches client and logger
 void dataPublisher::begin(Logger& baseLogger, Client* inClient) {
     setClient(inClient);
@@ -70,18 +109,98 @@ void dataPublisher::begin(Logger& baseLogger) {
 }
 
 
-void dataPublisher::txBufferInit(Client* outClient) {
+#ifdef MS_PUBLISHER_VIEWS
+void dataPublisher::setVariableView(const uint8_t* positions, uint8_t count) {
+    _view        = positions;
+    _viewSize    = positions == nullptr ? 0 : count;
+    _viewChecked = false;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_VIEWS
+// The view is of the logger's own variables, so the records of the nodes of a
+// gateway (#MS_LOGGER_GATEWAY) are sent whole
+bool dataPublisher::viewApplies(void) {
+    if (_view == nullptr) { return false; }
+    if (!_viewChecked) {
+        // The logger's array may not have been set when the view was
+        _viewChecked = true;
+        for (uint8_t slot = 0; slot < _viewSize; slot++) {
+            if (_view[slot] >= _baseLogger->getArrayVarCount()) {
+                PRINTOUT(F("Position"), _view[slot], F("of the view of"),
+                         getEndpoint(), F("is past the end of the array;"),
+                         F("sending every variable"));
+                _view = nullptr;
+                return false;
+            }
+        }
+    }
+#ifdef MS_LOGGER_GATEWAY
+    const loggerRecord* record = _baseLogger->getRecord();
+    if (record != nullptr && (record->status & RECORD_FROM_NODE)) {
+        return false;
+    }
+#endif
+    return true;
+}
+#endif
+
+
+uint8_t dataPublisher::viewSize(void) {
+#ifdef MS_PUBLISHER_VIEWS
+    if (viewApplies()) { return _viewSize; }
+#endif
+    return _baseLogger->getArrayVarCount();
+}
+
+
+uint8_t dataPublisher::viewPosition(uint8_t slot) {
+#ifdef MS_PUBLISHER_VIEWS
+    if (viewApplies()) { return _view[slot]; }
+#endif
+    return slot;
+}
+
+
+// This swaps the buffer every publisher writes outgoing data to
+void dataPublisher::setSendBuffer(char* buffer, size_t size) {
+    if (buffer == nullptr || size < 32) {
+        txBuffer     = txBufferDefault;
+        txBufferSize = MS_SEND_BUFFER_SIZE;
+        return;
+    }
+#ifdef MS_PUBLISHER_CHUNKED
+    // the chunk size line only has room for three hex digits
+    if (size > 4095) { size = 4095; }
+#endif
+    txBuffer     = buffer;
+    txBufferSize = size;
+}
+
+
+void dataPublisher::txBufferInit(Stream* outClient) {
     // remember client we are sending to
     txBufferOutClient = outClient;
 
     // reset buffer length to be empty
     txBufferLen = 0;
+#ifdef MS_PUBLISHER_CHUNKED
+    txBufferChunkStart = -1;
+#endif
 }
 
 void dataPublisher::txBufferAppend(const char* data, size_t length) {
+#ifdef MS_PUBLISHER_CHUNKED
+    // leave room for the line end after a chunk
+    size_t capacity = txBufferChunkStart >= 0 ? txBufferSize - 2
+                                              : txBufferSize;
+#else
+    size_t capacity = txBufferSize;
+#endif
     while (length > 0) {
         // space left in the buffer
-        size_t remaining = MS_SEND_BUFFER_SIZE - txBufferLen;
+        size_t remaining = capacity - txBufferLen;
         // the number of characters that will be added to the buffer
         // this will be the lesser of the length desired and the space left in
         // the buffer
@@ -97,7 +216,7 @@ void dataPublisher::txBufferAppend(const char* data, size_t length) {
         txBufferLen += amount;
 
         // write out the buffer if it fills
-        if (txBufferLen == MS_SEND_BUFFER_SIZE) { txBufferFlush(); }
+        if (txBufferLen == capacity) { txBufferFlush(); }
     }
 }
 
@@ -109,19 +228,465 @@ void dataPublisher::txBufferAppend(char c) {
     txBufferAppend(&c, 1);
 }
 
+void dataPublisher::txBufferAppend_P(const char* data) {
+    size_t length = strlen_P(data);
+#ifdef MS_PUBLISHER_CHUNKED
+    size_t capacity = txBufferChunkStart >= 0 ? txBufferSize - 2
+                                              : txBufferSize;
+#else
+    size_t capacity = txBufferSize;
+#endif
+    // the same as appending from RAM, but copying out of flash
+    while (length > 0) {
+        size_t remaining = capacity - txBufferLen;
+        size_t amount    = remaining < length ? remaining : length;
+        memcpy_P(&txBuffer[txBufferLen], data, amount);
+        length -= amount;
+        data += amount;
+        txBufferLen += amount;
+        if (txBufferLen == capacity) { txBufferFlush(); }
+    }
+}
+
 void dataPublisher::txBufferFlush() {
+#ifdef MS_PUBLISHER_CHUNKED
+    bool chunking = txBufferChunkStart >= 0;
+    if (chunking) { txBufferCloseChunk(); }
+#endif
 #if defined(STANDARD_SERIAL_OUTPUT)
     // write out to the printout stream
+#ifdef MS_NONBLOCKING_OUTPUT
+    // Only mirror what fits without waiting on the serial port
+    MS_PRINTOUT_PORT.write((const uint8_t*)txBuffer, txBufferLen);
+#else
     STANDARD_SERIAL_OUTPUT.write((const uint8_t*)txBuffer, txBufferLen);
     STANDARD_SERIAL_OUTPUT.flush();
+#endif
 #endif
     // write out to the client
     txBufferOutClient->write((const uint8_t*)txBuffer, txBufferLen);
     txBufferOutClient->flush();
+#ifdef MS_MODEM_STATS
+    loggerModem::recordTraffic(txBufferLen, 0);
+#endif
+#ifdef MS_PUBLISHER_STATS
+    if (_statsPublisher != nullptr) {
+        _statsPublisher->_stats.bytesSent += txBufferLen;
+    }
+#endif
 
     txBufferLen = 0;
+#ifdef MS_PUBLISHER_CHUNKED
+    // the next chunk starts at the beginning of the buffer
+    if (chunking) { txBufferStartChunks(); }
+#endif
+}
+
+
+#ifdef MS_PUBLISHER_CHUNKED
+// This leaves room for the chunk size line, filled in when the chunk ends
+void dataPublisher::txBufferStartChunks() {
+    if (txBufferSize - txBufferLen < 8) { txBufferFlush(); }
+    txBufferChunkStart = txBufferLen;
+    txBufferAppend("000\r\n", 5);
+}
+
+// The size is written as three hex digits, enough for any send buffer up to
+// 4095 bytes
+void dataPublisher::txBufferCloseChunk() {
+    size_t chunkLen = txBufferLen - txBufferChunkStart - 5;
+    if (chunkLen == 0) {
+        // an empty chunk would end the body
+        txBufferLen = txBufferChunkStart;
+    } else {
+        const char* hexDigits = "0123456789ABCDEF";
+        char*       sizeLine  = &txBuffer[txBufferChunkStart];
+        sizeLine[0]           = hexDigits[(chunkLen >> 8) & 0xF];
+        sizeLine[1]           = hexDigits[(chunkLen >> 4) & 0xF];
+        sizeLine[2]           = hexDigits[chunkLen & 0xF];
+
+        txBuffer[txBufferLen++] = '\r';
+        txBuffer[txBufferLen++] = '\n';
+    }
+    txBufferChunkStart = -1;
+}
+
+void dataPublisher::txBufferEndChunks() {
+    if (txBufferChunkStart >= 0) { txBufferCloseChunk(); }
+    txBufferAppend("0\r\n\r\n");
+    txBufferFlush();
+}
+#endif
+
+
+// This writes the major type and argument that start every CBOR data item,
+// with the argument in as few bytes as it fits in
+void dataPublisher::txBufferAppendCBORHead(uint8_t majorType, uint32_t value) {
+    uint8_t type = majorType << 5;
+    if (value < 24) {
+        txBufferAppend(static_cast<char>(type | value));
+        return;
+    }
+    uint8_t nBytes = cborHeadSize(value) - 1;
+    txBufferAppend(static_cast<char>(type | (nBytes == 1   ? 24
+                                             : nBytes == 2 ? 25
+                                                           : 26)));
+    for (int8_t b = nBytes - 1; b >= 0; b--) {
+        txBufferAppend(static_cast<char>(value >> (8 * b)));
+    }
+}
+void dataPublisher::txBufferAppendCBORText(const char* s) {
+    size_t length = strlen(s);
+    txBufferAppendCBORHead(3, length);
+    txBufferAppend(s, length);
+}
+void dataPublisher::txBufferAppendCBORUUID(const char* uuid) {
+    if (cborUUIDSize(uuid) != 17) {
+        txBufferAppendCBORText(uuid);
+        return;
+    }
+    txBufferAppendCBORHead(2, 16);
+    uint8_t byte   = 0;
+    bool    second = false;
+    for (const char* c = uuid; *c != '\0'; c++) {
+        if (*c == '-') { continue; }
+        uint8_t nibble = *c <= '9' ? *c - '0' : (*c | 0x20) - 'a' + 10;
+        byte           = (byte << 4) | nibble;
+        if (second) { txBufferAppend(static_cast<char>(byte)); }
+        second = !second;
+    }
+}
+// CBOR floats are sent most significant byte first
+void dataPublisher::txBufferAppendCBORFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    txBufferAppend(static_cast<char>(0xFA));
+    for (int8_t b = 3; b >= 0; b--) {
+        txBufferAppend(static_cast<char>(bits >> (8 * b)));
+    }
+}
+uint8_t dataPublisher::cborHeadSize(uint32_t value) {
+    if (value < 24) return 1;
+    if (value < 256) return 2;
+    if (value < 65536L) return 3;
+    return 5;
+}
+uint16_t dataPublisher::cborUUIDSize(const char* uuid) {
+    uint16_t nDigits = 0;
+    for (const char* c = uuid; *c != '\0'; c++) {
+        char lower = *c | 0x20;
+        if ((*c >= '0' && *c <= '9') || (lower >= 'a' && lower <= 'f')) {
+            nDigits++;
+        } else if (*c != '-') {
+            nDigits = 0xFFFF;
+            break;
+        }
+    }
+    if (nDigits == 32) { return 17; }
+    uint16_t length = strlen(uuid);
+    return cborHeadSize(length) + length;
+}
+
+
+// This opens a connection, reusing the kept one if it's to the same host
+bool dataPublisher::connectClient(Client* outClient, const char* host,
+                                  uint16_t port) {
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+    if (_keptClient != nullptr) {
+        if (_keptClient == outClient && _keptPort == port &&
+            strcmp(_keptHost, host) == 0 && outClient->connected()) {
+            MS_DBG(F("Reusing the connection to"), host);
+            return true;
+        }
+        if (_keptClient == outClient) { closeKeptConnection(); }
+    }
+#endif
+    if (!openConnection(outClient, host, port)) { return false; }
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+    // With several clients connected at once (#MS_PUBLISHER_PARALLEL) only
+    // the first is kept; the others are closed after their requests
+    if (_keptClient == nullptr) {
+        _keptClient = outClient;
+        _keptHost   = host;
+        _keptPort   = port;
+    }
+#endif
+    return true;
+}
+
+
+// This opens a new connection, by the kept address of the host if possible
+bool dataPublisher::openConnection(Client* outClient, const char* host,
+                                   uint16_t port) {
+#ifdef MS_PUBLISHER_STATS
+    uint32_t connectStart = millis();
+#endif
+#ifdef MS_PUBLISHER_DNS_CACHE
+    // A TLS connection needs the host name for the server name and the
+    // certificate check, so it's never made by address
+    loggerModem* modem  = _baseLogger != nullptr ? _baseLogger->_logModem
+                                                 : nullptr;
+    bool         secure = port == 443 || port == 8883 ||
+        (modem != nullptr && modem->isSecureClient(outClient));
+    IPAddress    address;
+    bool         connected;
+    if (!secure && lookupHost(host, address)) {
+        connected = outClient->connect(address, port);
+        // The host may have moved
+        if (!connected) { forgetHost(host); }
+    } else {
+        connected = outClient->connect(host, port);
+    }
+#else
+    bool connected = outClient->connect(host, port);
+#endif
+#ifdef MS_PUBLISHER_STATS
+    _stats.connect_ms = millis() - connectStart;
+#endif
+    if (!connected) { return false; }
+#ifdef MS_MODEM_STATS
+    loggerModem::recordSocketOpen();
+#endif
+    return true;
+}
+
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool dataPublisher::lookupHost(const char* host, IPAddress& address) {
+    uint32_t now  = Logger::getNowUTCEpoch();
+    int8_t   free = -1;
+    for (uint8_t i = 0; i < MS_DNS_CACHE_ENTRIES; i++) {
+        if (_dnsCache[i].host != nullptr &&
+            strcmp(_dnsCache[i].host, host) == 0) {
+            if (now < _dnsCache[i].expires) {
+                address = _dnsCache[i].address;
+                MS_DBG(F("Using the kept address of"), host);
+                return true;
+            }
+            _dnsCache[i].host = nullptr;
+        }
+        if (_dnsCache[i].host == nullptr && free < 0) { free = i; }
+    }
+
+    loggerModem* modem = _baseLogger != nullptr ? _baseLogger->_logModem
+                                                : nullptr;
+    if (modem == nullptr || !modem->resolveHost(host, address)) {
+        return false;
+    }
+    // Replace the entry that expires first if they're all in use
+    if (free < 0) {
+        free = 0;
+        for (uint8_t i = 1; i < MS_DNS_CACHE_ENTRIES; i++) {
+            if (_dnsCache[i].expires < _dnsCache[free].expires) { free = i; }
+        }
+    }
+    _dnsCache[free].host    = host;
+    _dnsCache[free].address = address;
+    _dnsCache[free].expires = now + MS_DNS_CACHE_TTL;
+    return true;
+}
+
+
+void dataPublisher::forgetHost(const char* host) {
+    for (uint8_t i = 0; i < MS_DNS_CACHE_ENTRIES; i++) {
+        if (_dnsCache[i].host != nullptr &&
+            strcmp(_dnsCache[i].host, host) == 0) {
+            MS_DBG(F("Forgetting the address of"), host);
+            _dnsCache[i].host = nullptr;
+        }
+    }
+}
+#endif
+
+
+// This closes the connection after a request, unless it can be kept for the
+// next one
+void dataPublisher::finishRequest(Client* outClient) {
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+    if (outClient == _keptClient && readResponseToEnd(outClient)) {
+        MS_DBG(F("Keeping the connection open"));
+        return;
+    }
+    if (outClient == _keptClient) { _keptClient = nullptr; }
+#endif
+#ifdef MS_MODEM_STATS
+    // The rest of the response was still received, even if it isn't read
+    loggerModem::recordTraffic(0, outClient->available());
+#endif
+    // Close the TCP/IP connection
+    MS_DBG(F("Stopping client"));
+    MS_START_DEBUG_TIMER;
+    outClient->stop();
+    MS_DBG(F("Client stopped after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+}
+
+
+// This closes the connection kept for the next request
+void dataPublisher::closeKeptConnection(void) {
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+    if (_keptClient == nullptr) { return; }
+    MS_DBG(F("Closing the kept connection to"), _keptHost);
+    _keptClient->stop();
+    _keptClient = nullptr;
+#endif
+}
+
+
+#if defined(MS_PUBLISHER_KEEP_ALIVE) || defined(MS_PUBLISHER_DATE_SYNC) || \
+    defined(MS_LOGGER_BACKFILL)
+// This reads the headers of the response, picking out the ones of use
+bool dataPublisher::readResponseHeaders(Client* outClient,
+                                        int32_t& contentLength,
+                                        bool&    keepOpen) {
+    char     line[48];
+    bool     firstLine = true;
+    uint32_t start     = millis();
+    contentLength      = -1;
+    keepOpen           = true;
+    outClient->setTimeout(5000L);
+    while (millis() - start < 10000L) {
+        size_t len = outClient->readBytesUntil('\n', line, sizeof(line) - 1);
+        if (len == 0) { return false; }
+#ifdef MS_MODEM_STATS
+        // The count includes the new line, which isn't put in the buffer
+        loggerModem::recordTraffic(0, len + 1);
+#endif
+        if (len == sizeof(line) - 1) {
+            // Skip the rest of a long line, so it isn't taken for more lines
+            char   rest[16];
+            size_t more;
+            do {
+                more = outClient->readBytesUntil('\n', rest, sizeof(rest));
+#ifdef MS_MODEM_STATS
+                loggerModem::recordTraffic(0, more);
+#endif
+            } while (more == sizeof(rest));
+        }
+        line[len] = '\0';
+        if (len > 0 && line[len - 1] == '\r') { line[--len] = '\0'; }
+        // The rest of the status line is skipped
+        if (firstLine) {
+            firstLine = false;
+            continue;
+        }
+        // A blank line ends the headers
+        if (len == 0) { return true; }
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            contentLength = atol(line + 15);
+        } else if (strncasecmp(line, "Connection:", 11) == 0 &&
+                   strstr(line + 11, "close") != nullptr) {
+            keepOpen = false;
+#ifdef MS_PUBLISHER_DATE_SYNC
+        } else if (strncasecmp(line, "Date:", 5) == 0) {
+            _responseDate = parseHTTPDate(line + 5);
+#endif
+#ifdef MS_LOGGER_BACKFILL
+        } else if (strncasecmp(line, "X-Backfill:", 11) == 0) {
+            if (!parseBackfillRange(line + 11, _responseBackfillFrom,
+                                    _responseBackfillTo)) {
+                _responseBackfillTo = 0;
+            }
+#endif
+        }
+    }
+    return false;
+}
+#endif
+
+
+#ifdef MS_LOGGER_BACKFILL
+bool dataPublisher::parseBackfillRange(const char* text, uint32_t& fromUTC,
+                                       uint32_t& toUTC) {
+    char* end;
+    fromUTC = strtoul(text, &end, 10);
+    if (*end != ',') { return false; }
+    toUTC = strtoul(end + 1, nullptr, 10);
+    return toUTC != 0 && toUTC >= fromUTC;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_DATE_SYNC
+// The date is always given in the format "Sun, 06 Nov 1994 08:49:37 GMT"
+uint32_t dataPublisher::parseHTTPDate(const char* value) {
+    const char* comma = strchr(value, ',');
+    if (comma == nullptr) { return 0; }
+    int  day, year, hour, minute, second;
+    char monthName[4];
+    if (sscanf(comma + 1, " %d %3s %d %d:%d:%d", &day, monthName, &year, &hour,
+               &minute, &second) != 6 ||
+        year < 2000) {
+        return 0;
+    }
+    const char* months = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    const char* found  = strstr(months, monthName);
+    if (found == nullptr || (found - months) % 3 != 0) { return 0; }
+    DateTime dt(year, (found - months) / 3 + 1, day, hour, minute, second);
+    return dt.get() + EPOCH_TIME_OFF;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+// This reads the headers and body of the response, so the next request on the
+// connection gets its own response
+bool dataPublisher::readResponseToEnd(Client* outClient) {
+    int32_t  contentLength;
+    bool     keepOpen;
+    uint32_t start = millis();
+    if (!readResponseHeaders(outClient, contentLength, keepOpen)) {
+        return false;
+    }
+    // Without a length the end of the response can't be found
+    if (contentLength < 0 || !keepOpen) { return false; }
+#ifdef MS_MODEM_STATS
+    int32_t bodyLength = contentLength;
+#endif
+    while (contentLength > 0 && millis() - start < 10000L) {
+        if (outClient->available()) {
+            outClient->read();
+            contentLength--;
+        } else {
+            delay(2);
+        }
+    }
+#ifdef MS_MODEM_STATS
+    loggerModem::recordTraffic(0, bodyLength - contentLength);
+#endif
+    return contentLength == 0;
+}
+#endif
+
+
+#ifdef MS_MODEM_NATIVE_HTTP
+// This hands a post to the modem's own HTTP client, if it has one
+bool dataPublisher::modemPostStart(const char* host, uint16_t port,
+                                   const char* path, uint16_t bodyLength,
+                                   const char* tokenHeader,
+                                   const char* token) {
+    loggerModem* modem = _baseLogger->_logModem;
+    if (modem == nullptr || !modem->httpBegin(host, port, path, bodyLength)) {
+        return false;
+    }
+    MS_DBG(F("Posting through the modem's HTTP client"));
+    modem->httpAddHeader(tokenHeader, token);
+    modem->httpAddHeader("Content-Type", "application/json");
+    Stream* body = modem->httpStartBody();
+    if (body == nullptr) {
+        MS_DBG(F("The modem didn't take the post; using the client"));
+        return false;
+    }
+    txBufferInit(body);
+    return true;
 }
 
+int16_t dataPublisher::modemPostFinish(void) {
+    txBufferFlush();
+    int16_t status = _baseLogger->_logModem->httpFinish();
+    MS_DBG(F("HTTP status from the modem:"), status);
+    return status;
+}
+#endif
 
 // This sends data on the "default" client of the modem
 int16_t dataPublisher::publishData() {
@@ -132,6 +697,308 @@ int16_t dataPublisher::publishData() {
         return publishData(_inClient);
     }
 }
+// Publishers that don't split their requests have nothing to send ahead
+bool dataPublisher::startRequest(Client* outClient) {
+    (void)outClient;
+    return false;
+}
+
+
+// This reads the status code from the start of an http response
+int16_t dataPublisher::finishResponse(Client* outClient, bool requestSent) {
+    // Create a buffer for the start of the response
+    char     tempBuffer[13] = "";
+    uint16_t did_respond    = 0;
+
+    if (requestSent && !_waitForResponse) {
+        // Close the connection without waiting for the response
+        MS_DBG(F("Not waiting for a response; stopping client"));
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+        if (outClient == _keptClient) { _keptClient = nullptr; }
+#endif
+        outClient->stop();
+        return 202;
+    }
+
+    if (requestSent) {
+        // Wait 10 seconds for a response from the server, or as long as the
+        // server usually takes
+#ifdef MS_PUBLISHER_ADAPTIVE_TIMEOUT
+        uint32_t wait = _responseWait;
+#else
+        uint32_t wait = 10000L;
+#endif
+        uint32_t start = millis();
+        while ((millis() - start) < wait && outClient->available() < 12) {
+            delay(10);
+        }
+#ifdef MS_PUBLISHER_STATS
+        _stats.response_ms = millis() - start;
+#endif
+#ifdef MS_PUBLISHER_ADAPTIVE_TIMEOUT
+        updateResponseWait(outClient->available() >= 12, millis() - start);
+#endif
+
+        // Read only the first 12 characters of the response
+        // We're only reading as far as the http code, anything beyond that
+        // we don't care about.
+        did_respond = outClient->readBytes(tempBuffer, 12);
+#ifdef MS_MODEM_STATS
+        loggerModem::recordTraffic(0, did_respond);
+#endif
+#if defined(MS_PUBLISHER_DATE_SYNC) || defined(MS_LOGGER_BACKFILL)
+#ifdef MS_PUBLISHER_DATE_SYNC
+        _responseDate = 0;
+#endif
+#ifdef MS_LOGGER_BACKFILL
+        _responseBackfillTo = 0;
+#endif
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+        // A kept connection has its headers read by finishRequest()
+        if (outClient != _keptClient && did_respond > 0) {
+#else
+        if (did_respond > 0) {
+#endif
+            int32_t contentLength;
+            bool    keepOpen;
+            readResponseHeaders(outClient, contentLength, keepOpen);
+        }
+#endif
+
+        // Close the TCP/IP connection, or keep it for the next request
+        finishRequest(outClient);
+#ifdef MS_PUBLISHER_DATE_SYNC
+        if (_responseDate != 0 && _baseLogger != nullptr) {
+            _baseLogger->syncFromServerTime(_responseDate);
+        }
+#endif
+#ifdef MS_LOGGER_BACKFILL
+        if (_responseBackfillTo != 0 && _baseLogger != nullptr) {
+            _baseLogger->requestBackfill(this, _responseBackfillFrom,
+                                         _responseBackfillTo);
+        }
+#endif
+    }
+
+    // Process the HTTP response
+    int16_t responseCode = 0;
+    if (did_respond > 0) {
+        char responseCode_char[4];
+        responseCode_char[3] = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            responseCode_char[i] = tempBuffer[i + 9];
+        }
+        responseCode = atoi(responseCode_char);
+    } else {
+        responseCode = 504;
+    }
+
+    PRINTOUT(F("\n-- Response Code --"));
+    PRINTOUT(responseCode);
+
+    return responseCode;
+}
+
+
+#ifdef MS_PUBLISHER_STATS
+void dataPublisher::startPublishStats(void) {
+    _stats.connect_ms  = 0;
+    _stats.response_ms = 0;
+    _stats.bytesSent   = 0;
+    _statsPublisher    = this;
+}
+
+
+void dataPublisher::recordPublishStats(int16_t result) {
+    _stats.lastResult = result;
+    if (publishSucceeded(result)) {
+        _stats.failures = 0;
+    } else if (_stats.failures < UINT16_MAX) {
+        _stats.failures++;
+    }
+    _statsPublisher = nullptr;
+}
+
+
+float dataPublisher::getPublisherResult(void* publisher) {
+    return static_cast<dataPublisher*>(publisher)->_stats.lastResult;
+}
+
+
+float dataPublisher::getPublisherConnectTime(void* publisher) {
+    return static_cast<dataPublisher*>(publisher)->_stats.connect_ms /
+        1000.0;
+}
+
+
+float dataPublisher::getPublisherResponseTime(void* publisher) {
+    return static_cast<dataPublisher*>(publisher)->_stats.response_ms /
+        1000.0;
+}
+
+
+float dataPublisher::getPublisherBytesSent(void* publisher) {
+    return static_cast<dataPublisher*>(publisher)->_stats.bytesSent;
+}
+
+
+float dataPublisher::getPublisherFailures(void* publisher) {
+    return static_cast<dataPublisher*>(publisher)->_stats.failures;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_RETRY
+void dataPublisher::setRetryPolicy(const publishRetryPolicy& policy) {
+    _retryPolicy = policy;
+}
+
+
+publishOutcome dataPublisher::classifyResult(int16_t result) {
+    if (publishSucceeded(result)) { return PUBLISH_SUCCEEDED; }
+    // finishResponse() gives a 504 when there's no response in time
+    if (result <= 0 || result == 504) { return PUBLISH_NO_CONNECTION; }
+    if (result == 408 || result == 429 || result >= 500) {
+        return PUBLISH_SERVER_ERROR;
+    }
+    return PUBLISH_REJECTED;
+}
+
+
+int16_t dataPublisher::publishWithRetries(void) {
+    int16_t  result         = publishData();
+    uint32_t wait           = _retryPolicy.retryDelay_ms;
+    uint8_t  connectRetries = 0;
+    uint8_t  serverRetries  = 0;
+    while (true) {
+        publishOutcome outcome = classifyResult(result);
+        if (outcome == PUBLISH_NO_CONNECTION &&
+            connectRetries < _retryPolicy.connectRetries) {
+            connectRetries++;
+        } else if (outcome == PUBLISH_SERVER_ERROR &&
+                   serverRetries < _retryPolicy.serverRetries) {
+            serverRetries++;
+        } else {
+            break;
+        }
+        MS_DBG(F("Trying the publication again in"), wait, F("ms"));
+        // Wait a second at a time, so the growing wait can't run out the
+        // watchdog
+        for (uint32_t waited = 0; waited < wait; waited += 1000) {
+            _baseLogger->watchDogTimer.resetWatchDog();
+            delay(wait - waited < 1000 ? wait - waited : 1000);
+        }
+        _baseLogger->watchDogTimer.resetWatchDog();
+        wait *= 2;
+        result = publishData();
+    }
+    recordWakeResult(result);
+    return result;
+}
+
+
+// The wakes skipped double after each failed wake: 1, 2, 4, ...
+void dataPublisher::recordWakeResult(int16_t result) {
+    publishOutcome outcome = classifyResult(result);
+    if (outcome == PUBLISH_NO_CONNECTION || outcome == PUBLISH_SERVER_ERROR) {
+        if (_failedWakes < 8) { _failedWakes++; }
+        uint16_t skip = 1 << (_failedWakes - 1);
+        if (skip > _retryPolicy.maxSkippedWakes) {
+            skip = _retryPolicy.maxSkippedWakes;
+        }
+        _wakesToSkip = skip;
+        MS_DBG(F("Skipping the next"), _wakesToSkip, F("wakes"));
+    } else {
+        _failedWakes = 0;
+        _wakesToSkip = 0;
+    }
+}
+
+
+bool dataPublisher::skipsThisWake(void) {
+    if (_wakesToSkip == 0) { return false; }
+    _wakesToSkip--;
+    return true;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_BUDGET
+void dataPublisher::setPriority(uint8_t priority) {
+    _priority = priority;
+}
+
+
+// The mean moves an eighth of the way to each new time, like the response
+// times
+void dataPublisher::recordPublishTime(uint32_t publishTime) {
+    if (_publishMean == 0) {
+        _publishMean = publishTime;
+    } else {
+        int32_t difference = publishTime - _publishMean;
+        _publishMean += difference / 8;
+    }
+    MS_DBG(F("Mean publication time:"), _publishMean, F("ms"));
+}
+
+
+bool dataPublisher::sendsBefore(dataPublisher* other) {
+    if (_priority != other->_priority) { return _priority > other->_priority; }
+    return _publishMean < other->_publishMean;
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_ADAPTIVE_TIMEOUT
+// This keeps the wait at the mean response time plus four mean deviations,
+// the way TCP sets its retransmission timeout
+void dataPublisher::updateResponseWait(bool     responded,
+                                       uint32_t responseTime) {
+    if (!responded) {
+        _responseWait = min(2L * _responseWait, 10000L);
+        MS_DBG(F("No response in time, now waiting"), _responseWait, F("ms"));
+        return;
+    }
+    int32_t sample = min(responseTime, 10000UL);
+    if (_responseMean == 0) {
+        _responseMean      = sample;
+        _responseDeviation = sample / 2;
+    } else {
+        int32_t difference = sample - _responseMean;
+        _responseDeviation += (abs(difference) - _responseDeviation) / 4;
+        _responseMean += difference / 8;
+    }
+    int32_t wait = _responseMean + 4L * _responseDeviation;
+    if (wait < MS_PUBLISHER_MIN_RESPONSE_WAIT) {
+        wait = MS_PUBLISHER_MIN_RESPONSE_WAIT;
+    }
+    _responseWait = min(wait, 10000L);
+    MS_DBG(F("Response after"), sample, F("ms, now waiting"), _responseWait,
+           F("ms"));
+}
+#endif
+
+
+#ifdef MS_PUBLISHER_PARALLEL
+// These split publishData() on the linked client into sending and reading
+bool dataPublisher::startPublish(void) {
+    if (_inClient == nullptr) {
+        PRINTOUT(F("ERROR! No web client assigned to publish data!"));
+        return false;
+    }
+    return startRequest(_inClient);
+}
+int16_t dataPublisher::finishPublish(bool requestSent) {
+    if (_inClient == nullptr) { return 0; }
+    return finishResponse(_inClient, requestSent);
+}
+#endif
+
+
+// Most receivers answer with an http response code
+bool dataPublisher::publishSucceeded(int16_t result) {
+    return result >= 200 && result < 300;
+}
 // Duplicates for backwards compatibility
 int16_t dataPublisher::sendData(Client* outClient) {
     return publishData(outClient);
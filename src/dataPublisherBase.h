@@ -47,12 +47,260 @@
 #define MS_SEND_BUFFER_SIZE 750
 #endif
 
+/**
+ * @def MS_PUBLISHER_KEEP_ALIVE
+ * @brief Define this build flag to keep the TCP connection to a receiver open
+ * after a request so the next request to the same host can use it instead of
+ * connecting again.
+ *
+ * Logger::publishDataToRemotes() sends to publishers with the same endpoint
+ * one after another, and the connection is closed with
+ * dataPublisher::closeKeptConnection() before the logger disconnects from the
+ * internet.  Each response is read to its end so it can't be mistaken for the
+ * response to the next request; the connection is closed instead if the
+ * receiver doesn't give the length of its response or asks to close it.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_KEEP_ALIVE
+
+/**
+ * @def MS_PUBLISHER_PARALLEL
+ * @brief Define this build flag to send the requests to every http receiver
+ * before waiting for any of the responses.
+ *
+ * Logger::publishDataToRemotes() first sends the request of each publisher
+ * that has a client of its own and then reads each of the responses, so the
+ * receivers answer at the same time instead of one after another.  The
+ * publishers must each be given a different client, such as TinyGSM clients
+ * on different mux numbers of the same modem; publishers sharing a client,
+ * and publishers that can't split their requests, are sent to one after
+ * another as usual.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_PARALLEL
+
+/**
+ * @def MS_PUBLISHER_ADAPTIVE_TIMEOUT
+ * @brief Define this build flag to wait for each http receiver's response
+ * only as long as it usually takes to answer, instead of always up to 10
+ * seconds.
+ *
+ * Each publisher keeps a running mean and mean deviation of how long its
+ * receiver takes to start answering and waits for the mean plus four times
+ * the deviation - about the slowest one in twenty responses - but never less
+ * than #MS_PUBLISHER_MIN_RESPONSE_WAIT or more than 10 seconds.  The wait is
+ * doubled after each response that doesn't come in time.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_ADAPTIVE_TIMEOUT
+/**
+ * @def MS_PUBLISHER_CHUNKED
+ * @brief Define this build flag to send http request bodies with chunked
+ * transfer encoding instead of with a Content-Length.
+ *
+ * The EnviroDIY and Ubidots publishers then format each value only once,
+ * instead of once to count the length of the body and again to send it, and
+ * each flush of the TX buffer sends one chunk.  Bodies can be longer than
+ * calculateJsonSize() can count, but the receiver must accept chunked
+ * requests.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_CHUNKED
+/**
+ * @def MS_PUBLISHER_DNS_CACHE
+ * @brief Define this build flag to keep the addresses of the receivers'
+ * hosts, so the publishers connect by address instead of looking the host up
+ * again on every wake.
+ *
+ * The first connection to a host asks the logger's modem for its address with
+ * loggerModem::resolveHost() and keeps it for #MS_DNS_CACHE_TTL seconds.  An
+ * address is forgotten when a connection to it fails, so the next connection
+ * looks it up again.  Modems that can't look up a host connect by name as
+ * usual, and so do TLS connections - to port 443 or 8883, or through the
+ * modem's secure client - which need the host name for the server name and
+ * the certificate check.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_DNS_CACHE
+
+/**
+ * @def MS_PUBLISHER_DATE_SYNC
+ * @brief Define this build flag to read the headers of the http responses and
+ * set the clock from their `Date` header.
+ *
+ * The `Date` of each response is compared to the RTC, and the clock is set
+ * if they're more than #MS_DATE_SYNC_TOLERANCE seconds apart.  While the
+ * receivers keep giving their time, the daily clock sync with
+ * loggerModem::getNISTTime() is skipped.
+ *
+ * @note The `Date` is when the receiver made its response, so the clock is
+ * only set to within about a second.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_DATE_SYNC
+
+/**
+ * @def MS_PUBLISHER_BUDGET
+ * @brief Define this build flag to limit the time spent publishing on each
+ * wake and send to the most important publishers first.
+ *
+ * Logger::publishDataToRemotes() sends to the publishers in order of their
+ * priority (dataPublisher::setPriority()) and, among those of the same
+ * priority, the quickest first by the running mean of how long each took to
+ * publish.  Once the time set with Logger::setPublishBudget() is used up, or
+ * a publisher would usually take longer than what's left of it, the
+ * publisher is skipped; with #MS_PUBLISHER_OUTBOX its record waits in the
+ * outbox for the next connection.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_BUDGET
+
+/**
+ * @def MS_PUBLISHER_RETRY
+ * @brief Define this build flag to try failed publications again, and to
+ * wait longer and longer before trying a publisher that keeps failing.
+ *
+ * Each result from a publisher is sorted into a publishOutcome by
+ * dataPublisher::classifyResult().  What's done next is set with
+ * dataPublisher::setRetryPolicy():
+ * - A connection that fails or isn't answered is tried again in the same wake
+ * only up to the policy's connection retries, since on a bad link each try
+ * keeps the modem on longer.
+ * - A server error (5xx, 408, or 429) is tried again up to the policy's
+ * server retries.  The first retry waits the policy's delay and each one
+ * after waits twice as long.
+ * - A rejection (any other 4xx) isn't tried again, because the same request
+ * gets the same answer.
+ *
+ * After a wake that still ends in a connection failure or server error, the
+ * publisher skips the next wake, then two, four, and so on up to the
+ * policy's most skipped wakes, until it succeeds again.  With
+ * #MS_PUBLISHER_OUTBOX the records of the skipped wakes wait in the outbox,
+ * as does the record of a rejection, so nothing is lost.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_RETRY
+
+/**
+ * @def MS_PUBLISHER_STATS
+ * @brief Define this build flag to keep the result, times, and traffic of
+ * each publisher's last publication, so they can be logged with the
+ * publisher statistics variables, like #Publisher_ResponseTime.
+ *
+ * Logger::publishDataToRemotes() keeps, for each publisher, the result of
+ * its publication, how long it took to connect and for the receiver to start
+ * answering, the bytes it sent, and how many publications in a row have
+ * failed.  Since the variables are read when a record is logged, before it's
+ * published, each record has the statistics of the publication of the record
+ * before it.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_STATS
+
+/**
+ * @def MS_PUBLISHER_VIEWS
+ * @brief Define this build flag to send each publisher only some of the
+ * logger's variables, in the order its receiver wants them.
+ *
+ * A view, set with dataPublisher::setVariableView(), is a list of positions
+ * in the logger's variable array, one for each slot the receiver has - like
+ * the 8 fields of a ThingSpeak channel.  The publishers go through the slots
+ * of their view instead of through the whole array, so the variables a
+ * receiver doesn't need are never formatted or sent.  The values are read
+ * from the logger's record as usual; nothing is copied.  Publishers without
+ * a view send every variable.
+ *
+ * @ingroup the_publishers
+ */
+// #define MS_PUBLISHER_VIEWS
+
+#ifdef MS_PUBLISHER_DATE_SYNC
+#ifndef MS_DATE_SYNC_TOLERANCE
+/**
+ * @brief The largest difference in seconds between the RTC and the `Date` of
+ * a response that's left alone with #MS_PUBLISHER_DATE_SYNC.
+ */
+#define MS_DATE_SYNC_TOLERANCE 5
+#endif
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+#ifndef MS_DNS_CACHE_ENTRIES
+/**
+ * @brief The number of host addresses kept with #MS_PUBLISHER_DNS_CACHE.
+ */
+#define MS_DNS_CACHE_ENTRIES 4
+#endif
+#ifndef MS_DNS_CACHE_TTL
+/**
+ * @brief The time in seconds a host address is kept with
+ * #MS_PUBLISHER_DNS_CACHE; default one day.
+ */
+#define MS_DNS_CACHE_TTL 86400L
+#endif
+#endif
+
+#ifdef MS_PUBLISHER_ADAPTIVE_TIMEOUT
+/**
+ * @brief The shortest time in milliseconds to wait for an http response with
+ * #MS_PUBLISHER_ADAPTIVE_TIMEOUT.
+ */
+#ifndef MS_PUBLISHER_MIN_RESPONSE_WAIT
+#define MS_PUBLISHER_MIN_RESPONSE_WAIT 1000L
+#endif
+#endif
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "LoggerBase.h"
 #include "Client.h"
 
+#ifdef MS_PUBLISHER_RETRY
+/**
+ * @brief The kinds of results of a publication (#MS_PUBLISHER_RETRY).
+ */
+typedef enum publishOutcome : uint8_t {
+    PUBLISH_SUCCEEDED = 0,  ///< The receiver accepted the data
+    PUBLISH_NO_CONNECTION,  ///< No connection, or no response in time
+    PUBLISH_SERVER_ERROR,   ///< The receiver couldn't handle it right now
+    PUBLISH_REJECTED,       ///< The receiver won't take the request as it is
+} publishOutcome;
+
+/**
+ * @brief How a publisher tries again after a failure (#MS_PUBLISHER_RETRY).
+ */
+typedef struct publishRetryPolicy {
+    uint8_t  connectRetries;   ///< Retries in a wake after no connection
+    uint8_t  serverRetries;    ///< Retries in a wake after a server error
+    uint16_t retryDelay_ms;    ///< The wait before the first retry
+    uint8_t  maxSkippedWakes;  ///< The most wakes to skip after failing wakes
+} publishRetryPolicy;
+#endif
+
+#ifdef MS_PUBLISHER_STATS
+/**
+ * @brief The statistics of the last publication of a publisher
+ * (#MS_PUBLISHER_STATS).
+ */
+typedef struct publisherStats {
+    int16_t  lastResult;    ///< The result returned by publishData()
+    uint16_t failures;      ///< The publications in a row that failed
+    uint32_t connect_ms;    ///< The time to connect; 0 if it was kept open
+    uint32_t response_ms;   ///< The time until the receiver started answering
+    uint32_t bytesSent;     ///< The bytes written to the client
+} publisherStats;
+#endif
+
 /**
  * @brief The dataPublisher class is a virtual class used by other publishers to
  * distribute data online.
@@ -87,7 +335,8 @@ class dataPublisher {
      *
      * @param baseLogger The logger supplying the data to be published
      * @param sendEveryX Interval (in units of the logging interval) between
-     * attempted data transmissions. Not respected by all publishers.
+     * attempted data transmissions. Only respected with
+     * #MS_PUBLISHER_SEND_INTERVAL.
      */
     explicit dataPublisher(Logger& baseLogger, int sendEveryX = 1);
     /**
@@ -98,7 +347,8 @@ class dataPublisher {
      * Allows the use of any type of client and multiple clients tied to a
      * single TinyGSM modem instance
      * @param sendEveryX Interval (in units of the logging interval) between
-     * attempted data transmissions. Not respected by all publishers.
+     * attempted data transmissions. Only respected with
+     * #MS_PUBLISHER_SEND_INTERVAL.
      */
     dataPublisher(Logger& baseLogger, Client* inClient, int sendEveryX = 1);
     /**
@@ -129,9 +379,31 @@ class dataPublisher {
      * attempted data transmissions
      *
      * @param sendEveryX Interval (in units of the logging interval) between
-     * attempted data transmissions. Not respected by all publishers.
+     * attempted data transmissions. Only respected with
+     * #MS_PUBLISHER_SEND_INTERVAL.
      */
     void setSendInterval(int sendEveryX);
+    /**
+     * @brief Get the interval (in units of the logging interval) between
+     * attempted data transmissions
+     *
+     * @return **int** The interval set with setSendInterval()
+     */
+    int getSendInterval(void) {
+        return _sendEveryX;
+    }
+    /**
+     * @brief Set whether to wait for the receiver's response to each
+     * request.
+     *
+     * Without waiting, the connection is closed as soon as the request is
+     * written and the request is counted as accepted (202) whether or not it
+     * was.  Only use this for receivers whose answer you don't need.
+     *
+     * @param waitForResponse False to send requests without waiting for the
+     * response; true by default.
+     */
+    void setWaitForResponse(bool waitForResponse);
 
     /**
      * @brief Begin the publisher - linking it to the client and logger.
@@ -161,6 +433,20 @@ class dataPublisher {
      */
     void begin(Logger& baseLogger);
 
+#ifdef MS_PUBLISHER_VIEWS
+    /**
+     * @brief Send only the variables at the given positions, in that order
+     * (#MS_PUBLISHER_VIEWS).
+     *
+     * @param positions The position in the logger's variable array of the
+     * variable for each slot of the receiver.  The list isn't copied, so it
+     * must stay valid; null to send every variable.  If any position is past
+     * the end of the logger's array, the view is dropped the first time it's
+     * used and every variable is sent.
+     * @param count The number of slots
+     */
+    void setVariableView(const uint8_t* positions, uint8_t count);
+#endif
 
     /**
      * @brief Get the destination for published data - generally the host name
@@ -198,6 +484,27 @@ class dataPublisher {
      */
     virtual int16_t publishData();
 
+    /**
+     * @brief Check if a result returned by publishData() means the data was
+     * accepted by the receiver.
+     *
+     * @param result The result of publishing data
+     * @return **bool** True for any 2xx http response code.
+     */
+    virtual bool publishSucceeded(int16_t result);
+    /**
+     * @brief Check if the publisher can send several records from the outbox
+     * (#MS_PUBLISHER_OUTBOX) in one request.
+     *
+     * A publisher returning true must send every record from
+     * Logger::getReplayRecordCount() in each call to publishData().
+     *
+     * @return **bool** False unless overridden.
+     */
+    virtual bool publishesBatches(void) {
+        return false;
+    }
+
     /**
      * @brief Retained for backwards compatibility; use publishData(Client*
      * outClient) in new code.
@@ -231,8 +538,251 @@ class dataPublisher {
      */
     String parseMQTTState(int state);
 
+    /**
+     * @brief Close the connection kept open for the next request
+     * (#MS_PUBLISHER_KEEP_ALIVE), if there is one.
+     */
+    static void closeKeptConnection(void);
+
+    /**
+     * @brief Give the publishers a different buffer for outgoing data.
+     *
+     * The buffer is written out to the client each time it fills, so a
+     * buffer the size of the modem's largest single send (e.g. 1460 bytes for
+     * a SIM7080 or 1500 for an ESP32) takes the fewest writes.  This lets
+     * boards with more memory use a bigger buffer than #MS_SEND_BUFFER_SIZE
+     * without recompiling, or share a buffer the sketch already has.  The
+     * buffer must stay valid while data is being published.
+     *
+     * @param buffer The buffer to use; null to go back to the default buffer
+     * @param size The size of the buffer; at least 32 bytes.  With
+     * #MS_PUBLISHER_CHUNKED, no more than 4095 bytes are used.
+     */
+    static void setSendBuffer(char* buffer, size_t size);
+
+#ifdef MS_PUBLISHER_BUDGET
+    /**
+     * @brief Set how important the publisher is; publishers with a higher
+     * priority are sent to first (#MS_PUBLISHER_BUDGET).
+     *
+     * @param priority The priority; default is 0.
+     */
+    void setPriority(uint8_t priority);
+    /**
+     * @brief Get the running mean of the time the publisher takes to publish.
+     *
+     * @return **uint32_t** The time in milliseconds; 0 before the first
+     * publication.
+     */
+    uint32_t getPublishTime(void) {
+        return _publishMean;
+    }
+    /**
+     * @brief Add the time the last publication took to the running mean.
+     *
+     * @param publishTime The time in milliseconds
+     */
+    void recordPublishTime(uint32_t publishTime);
+    /**
+     * @brief Check if the publisher should be sent to before another - it has
+     * a higher priority, or the same priority and is usually quicker.
+     *
+     * @param other The other publisher
+     * @return **bool** True if this publisher goes first.
+     */
+    bool sendsBefore(dataPublisher* other);
+#endif
+
+#ifdef MS_PUBLISHER_STATS
+    /**
+     * @brief Get the statistics of the last publication
+     * (#MS_PUBLISHER_STATS).
+     *
+     * @return **const publisherStats&** The statistics.
+     */
+    const publisherStats& getPublisherStats(void) {
+        return _stats;
+    }
+    /**
+     * @brief Start keeping the statistics of a new publication.
+     */
+    void startPublishStats(void);
+    /**
+     * @brief Finish the statistics of a publication with its result.
+     *
+     * @param result The result of publishing data
+     */
+    void recordPublishStats(int16_t result);
+    /**
+     * @brief Get the result of the last publication.
+     *
+     * @param publisher The publisher
+     * @return **float** The result code.
+     */
+    static float getPublisherResult(void* publisher);
+    /**
+     * @brief Get the time to connect in the last publication.
+     *
+     * @param publisher The publisher
+     * @return **float** The time in seconds.
+     */
+    static float getPublisherConnectTime(void* publisher);
+    /**
+     * @brief Get the time until the receiver started answering in the last
+     * publication.
+     *
+     * @param publisher The publisher
+     * @return **float** The time in seconds.
+     */
+    static float getPublisherResponseTime(void* publisher);
+    /**
+     * @brief Get the bytes sent in the last publication.
+     *
+     * @param publisher The publisher
+     * @return **float** The number of bytes.
+     */
+    static float getPublisherBytesSent(void* publisher);
+    /**
+     * @brief Get the number of publications in a row that failed.
+     *
+     * @param publisher The publisher
+     * @return **float** The number of publications.
+     */
+    static float getPublisherFailures(void* publisher);
+#endif
+
+#ifdef MS_PUBLISHER_RETRY
+    /**
+     * @brief Set how the publisher tries again after a failure
+     * (#MS_PUBLISHER_RETRY).
+     *
+     * @param policy The retry policy; the default is no connection retries,
+     * one server retry after 2 seconds, and at most 16 skipped wakes.
+     */
+    void setRetryPolicy(const publishRetryPolicy& policy);
+    /**
+     * @brief Sort a result returned by publishData() into its kind.
+     *
+     * @param result The result of publishing data
+     * @return **publishOutcome** Success for any result that
+     * publishSucceeded(); otherwise a connection failure for 0, 504, or a
+     * negative result, a server error for 408, 429, or any other 5xx, and a
+     * rejection for anything else.
+     */
+    virtual publishOutcome classifyResult(int16_t result);
+    /**
+     * @brief Publish data, trying again as the retry policy allows.
+     *
+     * @return **int16_t** The result of the last try.
+     */
+    int16_t publishWithRetries(void);
+    /**
+     * @brief Count the result of the publication of a wake toward the skipped
+     * wakes.
+     *
+     * @param result The last result of publishing data in the wake
+     */
+    void recordWakeResult(int16_t result);
+    /**
+     * @brief Check if the publisher is skipping wakes after failures.
+     *
+     * @return **bool** True if the next wake will be skipped.
+     */
+    bool isBackingOff(void) {
+        return _wakesToSkip != 0;
+    }
+    /**
+     * @brief Check if this wake is skipped, and count it off if it is.
+     *
+     * @return **bool** True if the publisher shouldn't be sent to this wake.
+     */
+    bool skipsThisWake(void);
+#endif
+
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+    /**
+     * @brief Count a new record toward the send interval
+     * (#MS_PUBLISHER_SEND_INTERVAL).
+     *
+     * @return **bool** True if the publisher is due to be sent to.
+     */
+    bool countRecord(void);
+    /**
+     * @brief Start counting the send interval over, once the publisher has
+     * been sent to successfully.
+     */
+    void restartSendInterval(void) {
+        _recordsHeld = 0;
+    }
+#endif
+
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @brief Check if the publisher can send its request and read the
+     * response separately with startPublish() and finishPublish()
+     * (#MS_PUBLISHER_PARALLEL).
+     *
+     * @return **bool** False unless overridden.
+     */
+    virtual bool sendsRequestsAhead(void) {
+        return false;
+    }
+#endif
+#if defined(MS_PUBLISHER_PARALLEL) || defined(MS_LOGGER_FAILOVER)
+    /**
+     * @brief Get the client linked to the publisher
+     *
+     * @return **Client\*** The client; null if none was given.
+     */
+    Client* getClient(void) {
+        return _inClient;
+    }
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @brief Open a socket to the receiver on the linked client and send the
+     * request, without waiting for the response.
+     *
+     * @return **bool** True if the request was sent.
+     */
+    bool startPublish(void);
+    /**
+     * @brief Read the response to a request sent with startPublish().
+     *
+     * @param requestSent The value returned by startPublish()
+     * @return **int16_t** The result of publishing data, as from
+     * publishData().
+     */
+    int16_t finishPublish(bool requestSent);
+#endif
+
 
  protected:
+    /**
+     * @brief Get the number of variables to send - the slots of the view, or
+     * every variable in the logger's array.
+     *
+     * @return **uint8_t** The number of variables.
+     */
+    uint8_t viewSize(void);
+    /**
+     * @brief Get the position in the logger's variable array of the variable
+     * to send in a slot.
+     *
+     * @param slot The slot, from 0 to viewSize() - 1
+     * @return **uint8_t** The position of the variable.
+     */
+    uint8_t viewPosition(uint8_t slot);
+#ifdef MS_PUBLISHER_VIEWS
+    /**
+     * @brief Check if the view is used for the record being published.
+     *
+     * @return **bool** True if there's a view and the record is the logger's
+     * own.
+     */
+    bool viewApplies(void);
+#endif
+
     /**
      * @brief The internal pointer to the logger instance to be used.
      */
@@ -243,13 +793,24 @@ class dataPublisher {
     Client* _inClient = nullptr;
 
     /**
-     * @brief The buffer for outgoing data.
+     * @brief The buffer for outgoing data; the default buffer unless another
+     * was given with setSendBuffer().
+     */
+    static char* txBuffer;
+    /**
+     * @brief The size of the buffer for outgoing data.
      */
-    static char txBuffer[MS_SEND_BUFFER_SIZE];
+    static size_t txBufferSize;
     /**
-     * @brief The pointer to the client instance the TX buffer is writing to.
+     * @brief The default buffer for outgoing data, #MS_SEND_BUFFER_SIZE
+     * long.
      */
-    static Client* txBufferOutClient;
+    static char txBufferDefault[MS_SEND_BUFFER_SIZE];
+    /**
+     * @brief The pointer to the client instance (or, with
+     * #MS_MODEM_NATIVE_HTTP, the modem stream) the TX buffer is writing to.
+     */
+    static Stream* txBufferOutClient;
     /**
      * @brief The number of used characters in the TX buffer.
      */
@@ -260,7 +821,7 @@ class dataPublisher {
      *
      * @param outClient The client to transmit to.
      */
-    static void txBufferInit(Client* outClient);
+    static void txBufferInit(Stream* outClient);
     /**
      * @brief Append the given data to the TX buffer, flushing if necessary.
      *
@@ -280,17 +841,376 @@ class dataPublisher {
      * @param c The char to append.
      */
     static void txBufferAppend(char c);
+    /**
+     * @brief Append the given string from flash to the TX buffer in one bulk
+     * copy, flushing if necessary.
+     *
+     * This is meant for the invariant parts of a request, kept as a single
+     * PROGMEM string so they don't take up RAM or need an append for each
+     * piece.
+     *
+     * @param s The null-terminated string in flash (PROGMEM) to append.
+     */
+    static void txBufferAppend_P(const char* s);
     /**
      * @brief Write the TX buffer contents to the initialized stream and also to
      * the debugging port.
      */
     static void txBufferFlush();
+#ifdef MS_PUBLISHER_CHUNKED
+    /**
+     * @brief Start sending the rest of the TX buffer contents as chunks
+     * (#MS_PUBLISHER_CHUNKED); call this right after the end of the http
+     * headers.
+     */
+    static void txBufferStartChunks();
+    /**
+     * @brief Send the last chunk and the end of the chunked body.
+     */
+    static void txBufferEndChunks();
+    /**
+     * @brief Fill in the size at the start of the chunk being built and end
+     * it.
+     */
+    static void txBufferCloseChunk();
+    /**
+     * @brief The position of the chunk being built in the TX buffer; -1 if
+     * the buffer isn't being sent as chunks.
+     */
+    static int16_t txBufferChunkStart;
+#endif
+
+    /**
+     * @brief Append the head of a CBOR data item to the TX buffer.
+     *
+     * @param majorType The CBOR major type, from 0 to 7
+     * @param value The argument of the head - the value of an integer or the
+     * length of a string, array, or map
+     */
+    static void txBufferAppendCBORHead(uint8_t majorType, uint32_t value);
+    /**
+     * @brief Append a string to the TX buffer as a CBOR text string.
+     *
+     * @param s The null-terminated string to append.
+     */
+    static void txBufferAppendCBORText(const char* s);
+    /**
+     * @brief Append a UUID to the TX buffer as a 16 byte CBOR byte string.
+     *
+     * Anything that isn't 32 hex digits with or without dashes is appended
+     * as a text string instead.
+     *
+     * @param uuid The UUID as text
+     */
+    static void txBufferAppendCBORUUID(const char* uuid);
+    /**
+     * @brief Append a value to the TX buffer as a CBOR single precision
+     * float.
+     *
+     * @param value The value to append.
+     */
+    static void txBufferAppendCBORFloat(float value);
+    /**
+     * @brief Get the number of bytes in the head of a CBOR data item.
+     *
+     * @param value The argument of the head
+     * @return **uint8_t** The number of bytes, from 1 to 5
+     */
+    static uint8_t cborHeadSize(uint32_t value);
+    /**
+     * @brief Get the number of bytes txBufferAppendCBORUUID() appends.
+     *
+     * @param uuid The UUID as text
+     * @return **uint16_t** The number of bytes
+     */
+    static uint16_t cborUUIDSize(const char* uuid);
+
+    /**
+     * @brief Open a TCP connection to a receiver, using the connection kept
+     * from the last request if it's to the same host (#MS_PUBLISHER_KEEP_ALIVE)
+     *
+     * @param outClient The client to connect
+     * @param host The host name of the receiver
+     * @param port The port of the receiver
+     * @return **bool** True if the client is connected.
+     */
+    bool connectClient(Client* outClient, const char* host, uint16_t port);
+    /**
+     * @brief Open a new TCP connection to a host, by its kept address if
+     * there is one (#MS_PUBLISHER_DNS_CACHE).
+     *
+     * @param outClient The client to connect
+     * @param host The host name of the receiver
+     * @param port The port of the receiver
+     * @return **bool** True if the client is connected.
+     */
+    bool openConnection(Client* outClient, const char* host, uint16_t port);
+#ifdef MS_PUBLISHER_DNS_CACHE
+    /**
+     * @brief Get the address of a host, from the cache or by asking the
+     * logger's modem to look it up.
+     *
+     * @param host The host name
+     * @param address The address of the host
+     * @return **bool** True if the address is known.
+     */
+    bool lookupHost(const char* host, IPAddress& address);
+    /**
+     * @brief Forget the kept address of a host, ie, after a connection to it
+     * failed.
+     *
+     * @param host The host name
+     */
+    static void forgetHost(const char* host);
+    /**
+     * @brief A host address kept by the DNS cache.
+     */
+    typedef struct dnsCacheEntry {
+        const char* host;     ///< The host name; null for an empty entry
+        IPAddress   address;  ///< The address of the host
+        uint32_t    expires;  ///< The Unix time the address expires at
+    } dnsCacheEntry;
+    /**
+     * @brief The kept host addresses
+     */
+    static dnsCacheEntry _dnsCache[MS_DNS_CACHE_ENTRIES];
+#endif
+    /**
+     * @brief Finish a request after the start of the response has been read,
+     * either closing the connection or, with #MS_PUBLISHER_KEEP_ALIVE, reading
+     * the rest of the response and keeping the connection for the next
+     * request.
+     *
+     * @param outClient The client the request was made on
+     */
+    static void finishRequest(Client* outClient);
+#ifdef MS_MODEM_NATIVE_HTTP
+    /**
+     * @brief Start a JSON post through the HTTP client of the logger's modem,
+     * if it has one, and point the TX buffer at the modem for the body.
+     *
+     * @param host The host name to post to
+     * @param port The port to post to
+     * @param path The path to post to; this must stay valid until
+     * modemPostFinish()
+     * @param bodyLength The exact length of the JSON body
+     * @param tokenHeader The name of the authentication header
+     * @param token The authentication token
+     * @return **bool** True if the body should now be written to the TX
+     * buffer and the post finished with modemPostFinish(); false to post over
+     * the client instead.
+     */
+    bool modemPostStart(const char* host, uint16_t port, const char* path,
+                        uint16_t bodyLength, const char* tokenHeader,
+                        const char* token);
+    /**
+     * @brief Flush the rest of the body to the modem and wait for the
+     * response to the post started by modemPostStart().
+     *
+     * @return **int16_t** The http status code of the response.
+     */
+    int16_t modemPostFinish(void);
+#endif
+
+    /**
+     * @brief Open a socket to the receiver and send the request, without
+     * waiting for the response.
+     *
+     * Publishers that override this send the whole of their request here and
+     * read the response with finishResponse().
+     *
+     * @param outClient The client to send the request on
+     * @return **bool** True if the request was sent; false if the connection
+     * failed or the publisher doesn't split its requests.
+     */
+    virtual bool startRequest(Client* outClient);
+    /**
+     * @brief Wait up to 10 seconds (or as set by
+     * #MS_PUBLISHER_ADAPTIVE_TIMEOUT) for the http response to a request sent
+     * by startRequest(), read its status code, and finish the request.
+     *
+     * @param outClient The client the request was sent on
+     * @param requestSent The value returned by startRequest()
+     * @return **int16_t** The http response code; 504 if there was no
+     * response or 202 if not waiting for one (setWaitForResponse()).
+     */
+    virtual int16_t finishResponse(Client* outClient, bool requestSent);
+#if defined(MS_PUBLISHER_KEEP_ALIVE) || defined(MS_PUBLISHER_DATE_SYNC) || \
+    defined(MS_LOGGER_BACKFILL)
+    /**
+     * @brief Read the rest of the status line and the headers of an http
+     * response whose first 12 characters have already been read.
+     *
+     * With #MS_PUBLISHER_DATE_SYNC, the time of a `Date` header is kept in
+     * #_responseDate.  With #MS_LOGGER_BACKFILL, the range of an
+     * `X-Backfill` header is kept in #_responseBackfillFrom and
+     * #_responseBackfillTo.
+     *
+     * @param outClient The client the response is coming in on
+     * @param contentLength The length of the body, or -1 if it wasn't given
+     * @param keepOpen False if the receiver asked to close the connection
+     * @return **bool** True if the headers were read to their end.
+     */
+    static bool readResponseHeaders(Client* outClient, int32_t& contentLength,
+                                    bool& keepOpen);
+#endif
+#ifdef MS_PUBLISHER_DATE_SYNC
+    /**
+     * @brief Convert the value of an http `Date` header, like
+     * `Tue, 14 Oct 2025 12:34:56 GMT`, to Unix time.
+     *
+     * @param value The text after "Date:"
+     * @return **uint32_t** The time in seconds since 1970, or 0 if the date
+     * couldn't be read.
+     */
+    static uint32_t parseHTTPDate(const char* value);
+    /**
+     * @brief The time of the `Date` header of the last response read; 0 if
+     * there was none.
+     */
+    static uint32_t _responseDate;
+#endif
+#ifdef MS_LOGGER_BACKFILL
+    /**
+     * @brief Read a backfill range of two UTC Unix times, like
+     * `1700000000,1700086400` (#MS_LOGGER_BACKFILL).
+     *
+     * @param text The range
+     * @param fromUTC The start of the range; set
+     * @param toUTC The end of the range; set
+     * @return **bool** True if there were two times in order.
+     */
+    static bool parseBackfillRange(const char* text, uint32_t& fromUTC,
+                                   uint32_t& toUTC);
+    /**
+     * @brief The start of the range of the `X-Backfill` header of the last
+     * response read
+     */
+    static uint32_t _responseBackfillFrom;
+    /**
+     * @brief The end of the range of the `X-Backfill` header of the last
+     * response read; 0 if there was none.
+     */
+    static uint32_t _responseBackfillTo;
+#endif
+#ifdef MS_PUBLISHER_KEEP_ALIVE
+    /**
+     * @brief Read the rest of an http response whose first 12 characters
+     * have already been read.
+     *
+     * @param outClient The client the response is coming in on
+     * @return **bool** True if the whole response was read and the
+     * connection can be used again.
+     */
+    static bool readResponseToEnd(Client* outClient);
+    /**
+     * @brief The client with a connection kept open; null if there is none
+     */
+    static Client* _keptClient;
+    /**
+     * @brief The host the kept connection is to
+     */
+    static const char* _keptHost;
+    /**
+     * @brief The port the kept connection is to
+     */
+    static uint16_t _keptPort;
+#endif
 
     /**
      * @brief Interval (in units of the logging interval) between
      * attempted data transmissions. Not respected by all publishers.
      */
     int _sendEveryX = 1;
+#ifdef MS_PUBLISHER_SEND_INTERVAL
+    /**
+     * @brief The number of records logged since the publisher was last sent
+     * to (#MS_PUBLISHER_SEND_INTERVAL)
+     */
+    uint16_t _recordsHeld = 0;
+#endif
+    /**
+     * @brief Whether to wait for the receiver's response to each request.
+     */
+    bool _waitForResponse = true;
+#ifdef MS_PUBLISHER_VIEWS
+    /**
+     * @brief The position of the variable of each slot; null to send every
+     * variable (#MS_PUBLISHER_VIEWS)
+     */
+    const uint8_t* _view = nullptr;
+    /**
+     * @brief The number of slots in #_view
+     */
+    uint8_t _viewSize = 0;
+    /**
+     * @brief True once the positions of #_view have been checked against the
+     * logger's variable array
+     */
+    bool _viewChecked = false;
+#endif
+#ifdef MS_PUBLISHER_STATS
+    /**
+     * @brief The statistics of the last publication (#MS_PUBLISHER_STATS)
+     */
+    publisherStats _stats = {0, 0, 0, 0, 0};
+    /**
+     * @brief The publisher the TX buffer's bytes are counted for; null
+     * outside of a publication.
+     */
+    static dataPublisher* _statsPublisher;
+#endif
+#ifdef MS_PUBLISHER_RETRY
+    /**
+     * @brief How the publisher tries again after a failure
+     * (#MS_PUBLISHER_RETRY)
+     */
+    publishRetryPolicy _retryPolicy = {0, 1, 2000, 16};
+    /**
+     * @brief The number of wakes in a row that ended in a failure worth
+     * trying again
+     */
+    uint8_t _failedWakes = 0;
+    /**
+     * @brief The number of wakes still to skip
+     */
+    uint8_t _wakesToSkip = 0;
+#endif
+#ifdef MS_PUBLISHER_BUDGET
+    /**
+     * @brief How important the publisher is (#MS_PUBLISHER_BUDGET)
+     */
+    uint8_t _priority = 0;
+    /**
+     * @brief The running mean of the publication times in milliseconds; 0
+     * before the first publication.
+     */
+    uint32_t _publishMean = 0;
+#endif
+#ifdef MS_PUBLISHER_ADAPTIVE_TIMEOUT
+    /**
+     * @brief The time in milliseconds to wait for the next response
+     * (#MS_PUBLISHER_ADAPTIVE_TIMEOUT)
+     */
+    uint16_t _responseWait = 10000;
+    /**
+     * @brief The running mean of the response times in milliseconds; 0
+     * before the first response.
+     */
+    uint16_t _responseMean = 0;
+    /**
+     * @brief The running mean deviation of the response times in
+     * milliseconds.
+     */
+    uint16_t _responseDeviation = 0;
+    /**
+     * @brief Update the response wait with how long the last response took.
+     *
+     * @param responded True if the response came in time
+     * @param responseTime The time in milliseconds until the response started
+     */
+    void updateResponseWait(bool responded, uint32_t responseTime);
+#endif
 
     // Basic chunks of HTTP
     /**
@@ -309,6 +1229,238 @@ class dataPublisher {
      * @brief the text "\r\nHost: "
      */
     static const char* hostHeader;
+    /**
+     * @brief the text " HTTP/1.1\r\nHost: ", kept in flash
+     */
+    static const char HTTPHostTag[];
+#ifdef MS_PUBLISHER_CHUNKED
+    /**
+     * @brief the text "\r\nTransfer-Encoding: chunked"
+     */
+    static const char* transferEncodingHeader;
+#endif
 };
 
+
+#ifdef MS_PUBLISHER_STATS
+/**
+ * @anchor publisher_stats
+ * @name Publisher Statistics
+ * The statistics of the last publication of a publisher
+ * (#MS_PUBLISHER_STATS).
+ *
+ * {{ @ref Publisher_Result::Publisher_Result }}
+ * {{ @ref Publisher_ConnectTime::Publisher_ConnectTime }}
+ * {{ @ref Publisher_ResponseTime::Publisher_ResponseTime }}
+ * {{ @ref Publisher_BytesSent::Publisher_BytesSent }}
+ * {{ @ref Publisher_Failures::Publisher_Failures }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; the times should have 3.
+#define PUBLISHER_STATS_TIME_RESOLUTION 3
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "timeElapsed"
+#define PUBLISHER_STATS_TIME_VAR_NAME MS_VAR_TEXT("timeElapsed")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "second"
+#define PUBLISHER_STATS_TIME_UNIT_NAME MS_VAR_TEXT("second")
+/// @brief Decimals places in string representation; the counts should have 0.
+#define PUBLISHER_STATS_COUNT_RESOLUTION 0
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "counter"
+#define PUBLISHER_STATS_COUNT_VAR_NAME MS_VAR_TEXT("counter")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "count"
+#define PUBLISHER_STATS_COUNT_UNIT_NAME MS_VAR_TEXT("count")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "byte"
+#define PUBLISHER_STATS_BYTES_UNIT_NAME MS_VAR_TEXT("byte")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
+/// "dimensionless"
+#define PUBLISHER_STATS_RESULT_UNIT_NAME MS_VAR_TEXT("dimensionless")
+/// @brief Default variable short code; "publishResult"
+#define PUBLISHER_RESULT_DEFAULT_CODE "publishResult"
+/// @brief Default variable short code; "publishConnectSec"
+#define PUBLISHER_CONNECT_DEFAULT_CODE "publishConnectSec"
+/// @brief Default variable short code; "publishResponseSec"
+#define PUBLISHER_RESPONSE_DEFAULT_CODE "publishResponseSec"
+/// @brief Default variable short code; "publishBytesSent"
+#define PUBLISHER_BYTES_SENT_DEFAULT_CODE "publishBytesSent"
+/// @brief Default variable short code; "publishFailures"
+#define PUBLISHER_FAILURES_DEFAULT_CODE "publishFailures"
+/**@}*/
+
+
+/**
+ * @brief The Variable sub-class used for the result of a publisher's last
+ * publication (#MS_PUBLISHER_STATS).
+ *
+ * The value is what publishData() returned - an http status code for the
+ * http publishers, or the publisher's own result code for the others.
+ *
+ * @ingroup the_publishers
+ */
+class Publisher_Result : public Variable {
+ public:
+    /**
+     * @brief Construct a new Publisher_Result object.
+     *
+     * @param parentPublisher The publisher providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "publishResult".
+     */
+    explicit Publisher_Result(
+        dataPublisher* parentPublisher, const char* uuid = "",
+        const char* varCode = PUBLISHER_RESULT_DEFAULT_CODE)
+        : Variable(&dataPublisher::getPublisherResult, parentPublisher,
+                   (uint8_t)PUBLISHER_STATS_COUNT_RESOLUTION,
+                   PUBLISHER_STATS_COUNT_VAR_NAME,
+                   PUBLISHER_STATS_RESULT_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Destroy the Publisher_Result object - no action needed.
+     */
+    ~Publisher_Result() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the time a publisher took to
+ * connect (#MS_PUBLISHER_STATS).
+ *
+ * The value is the time in seconds the last publication took to open its
+ * connection; 0 if it reused a connection kept open.
+ *
+ * @ingroup the_publishers
+ */
+class Publisher_ConnectTime : public Variable {
+ public:
+    /**
+     * @brief Construct a new Publisher_ConnectTime object.
+     *
+     * @param parentPublisher The publisher providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "publishConnectSec".
+     */
+    explicit Publisher_ConnectTime(
+        dataPublisher* parentPublisher, const char* uuid = "",
+        const char* varCode = PUBLISHER_CONNECT_DEFAULT_CODE)
+        : Variable(&dataPublisher::getPublisherConnectTime, parentPublisher,
+                   (uint8_t)PUBLISHER_STATS_TIME_RESOLUTION,
+                   PUBLISHER_STATS_TIME_VAR_NAME,
+                   PUBLISHER_STATS_TIME_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Destroy the Publisher_ConnectTime object - no action needed.
+     */
+    ~Publisher_ConnectTime() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the time a publisher's receiver
+ * took to answer (#MS_PUBLISHER_STATS).
+ *
+ * The value is the time in seconds from sending the last request until the
+ * receiver started answering.
+ *
+ * @ingroup the_publishers
+ */
+class Publisher_ResponseTime : public Variable {
+ public:
+    /**
+     * @brief Construct a new Publisher_ResponseTime object.
+     *
+     * @param parentPublisher The publisher providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "publishResponseSec".
+     */
+    explicit Publisher_ResponseTime(
+        dataPublisher* parentPublisher, const char* uuid = "",
+        const char* varCode = PUBLISHER_RESPONSE_DEFAULT_CODE)
+        : Variable(&dataPublisher::getPublisherResponseTime, parentPublisher,
+                   (uint8_t)PUBLISHER_STATS_TIME_RESOLUTION,
+                   PUBLISHER_STATS_TIME_VAR_NAME,
+                   PUBLISHER_STATS_TIME_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Destroy the Publisher_ResponseTime object - no action needed.
+     */
+    ~Publisher_ResponseTime() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the bytes a publisher sent
+ * (#MS_PUBLISHER_STATS).
+ *
+ * The value is the number of bytes sent in the last publication.
+ *
+ * @ingroup the_publishers
+ */
+class Publisher_BytesSent : public Variable {
+ public:
+    /**
+     * @brief Construct a new Publisher_BytesSent object.
+     *
+     * @param parentPublisher The publisher providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "publishBytesSent".
+     */
+    explicit Publisher_BytesSent(
+        dataPublisher* parentPublisher, const char* uuid = "",
+        const char* varCode = PUBLISHER_BYTES_SENT_DEFAULT_CODE)
+        : Variable(&dataPublisher::getPublisherBytesSent, parentPublisher,
+                   (uint8_t)PUBLISHER_STATS_COUNT_RESOLUTION,
+                   PUBLISHER_STATS_COUNT_VAR_NAME,
+                   PUBLISHER_STATS_BYTES_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Destroy the Publisher_BytesSent object - no action needed.
+     */
+    ~Publisher_BytesSent() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the failed publications of a
+ * publisher (#MS_PUBLISHER_STATS).
+ *
+ * The value is the number of publications in a row that weren't accepted;
+ * 0 after a success.
+ *
+ * @ingroup the_publishers
+ */
+class Publisher_Failures : public Variable {
+ public:
+    /**
+     * @brief Construct a new Publisher_Failures object.
+     *
+     * @param parentPublisher The publisher providing the result values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "publishFailures".
+     */
+    explicit Publisher_Failures(
+        dataPublisher* parentPublisher, const char* uuid = "",
+        const char* varCode = PUBLISHER_FAILURES_DEFAULT_CODE)
+        : Variable(&dataPublisher::getPublisherFailures, parentPublisher,
+                   (uint8_t)PUBLISHER_STATS_COUNT_RESOLUTION,
+                   PUBLISHER_STATS_COUNT_VAR_NAME,
+                   PUBLISHER_STATS_COUNT_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Destroy the Publisher_Failures object - no action needed.
+     */
+    ~Publisher_Failures() {}
+};
+#endif
+
 #endif  // SRC_DATAPUBLISHERBASE_H_
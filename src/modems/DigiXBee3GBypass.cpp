@@ -36,6 +36,9 @@ MS_IS_MODEM_AWAKE(DigiXBee3GBypass);
 MS_MODEM_WAKE(DigiXBee3GBypass);
 
 MS_MODEM_CONNECT_INTERNET(DigiXBee3GBypass);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(DigiXBee3GBypass);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(DigiXBee3GBypass);
 MS_MODEM_IS_INTERNET_AVAILABLE(DigiXBee3GBypass);
 
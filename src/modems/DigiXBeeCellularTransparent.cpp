@@ -39,6 +39,9 @@ MS_IS_MODEM_AWAKE(DigiXBeeCellularTransparent);
 MS_MODEM_WAKE(DigiXBeeCellularTransparent);
 
 MS_MODEM_CONNECT_INTERNET(DigiXBeeCellularTransparent);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(DigiXBeeCellularTransparent);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(DigiXBeeCellularTransparent);
 MS_MODEM_IS_INTERNET_AVAILABLE(DigiXBeeCellularTransparent);
 
@@ -57,8 +60,11 @@ bool DigiXBeeCellularTransparent::modemWakeFxn(void) {
         if (gsmModem.commandMode()) {
             gsmModem.sendAT(GF("AM"), 0);
             gsmModem.waitResponse();
-            // Write changes to flash and apply them
-            gsmModem.writeChanges();
+            // Apply the change without writing it to flash; writing to flash
+            // every cycle is slow and wears the flash out, and the setting
+            // is made again on the next wake or sleep anyway
+            gsmModem.sendAT(GF("AC"));
+            gsmModem.waitResponse(GF("OK\r"));
             // Exit command mode
             gsmModem.exitCommand();
         }
@@ -76,8 +82,9 @@ bool DigiXBeeCellularTransparent::modemSleepFxn(void) {
         if (gsmModem.commandMode()) {
             gsmModem.sendAT(GF("AM"), 0);
             gsmModem.waitResponse();
-            // Write changes to flash and apply them
-            gsmModem.writeChanges();
+            // Apply the change without writing it to flash, as on waking
+            gsmModem.sendAT(GF("AC"));
+            gsmModem.waitResponse(GF("OK\r"));
             // Exit command mode
             gsmModem.exitCommand();
         }
@@ -191,6 +198,26 @@ bool DigiXBeeCellularTransparent::extraModemSetup(void) {
 }
 
 uint32_t DigiXBeeCellularTransparent::getNISTTime(void) {
+#ifdef MS_MODEM_NETWORK_TIME
+    // The XBee keeps the network time as the seconds since Jan 1, 2000 (UTC)
+    MS_DBG(F("Asking the XBee for the network time"));
+    String dt = "";
+    if (gsmModem.commandMode()) {
+        gsmModem.sendAT(GF("DT"));
+        if (gsmModem.waitResponse(1000L, dt, GF("\r")) == 1) {
+            uint32_t secFrom2000 = strtoul(dt.c_str(), nullptr, 16);
+            MS_DBG(F("Seconds from Jan 1, 2000 from the XBee (UTC):"),
+                   secFrom2000);
+            // 0 or a small number means the network hasn't given the time
+            uint32_t unixTimeStamp = secFrom2000 + 946684800L;
+            if (unixTimeStamp >= 1546300800 && unixTimeStamp <= 1893456000) {
+                gsmModem.exitCommand();
+                return unixTimeStamp;
+            }
+        }
+        gsmModem.exitCommand();
+    }
+#endif
     /* bail if not connected to the internet */
     if (!isInternetAvailable()) {
         MS_DBG(F("No internet connection, cannot connect to NIST."));
@@ -249,6 +276,14 @@ uint32_t DigiXBeeCellularTransparent::getNISTTime(void) {
 bool DigiXBeeCellularTransparent::updateModemMetadata(void) {
     bool success = true;
 
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+    if (_metadataCaptured) {
+        MS_DBG(F("Using the modem metadata read while connecting"));
+        _metadataCaptured = false;
+        return true;
+    }
+#endif
+
     // Unset whatever we had previously
     loggerModem::_priorRSSI           = -9999;
     loggerModem::_priorSignalPercent  = -9999;
@@ -36,6 +36,9 @@ MS_IS_MODEM_AWAKE(DigiXBeeLTEBypass);
 MS_MODEM_WAKE(DigiXBeeLTEBypass);
 
 MS_MODEM_CONNECT_INTERNET(DigiXBeeLTEBypass);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(DigiXBeeLTEBypass);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(DigiXBeeLTEBypass);
 MS_MODEM_IS_INTERNET_AVAILABLE(DigiXBeeLTEBypass);
 
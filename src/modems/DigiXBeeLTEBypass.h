@@ -145,6 +145,9 @@ class DigiXBeeLTEBypass : public DigiXBee {
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
 
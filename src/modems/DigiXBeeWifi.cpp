@@ -69,12 +69,26 @@ bool DigiXBeeWifi::connectInternet(uint32_t maxConnectionTime) {
                  "credentials..."));
         if (!(gsmModem.isNetworkConnected())) {
             if (!gsmModem.waitForNetwork(maxConnectionTime)) {
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+                // The saved static address may no longer suit the network
+                if (useDHCPAddress()) {
+                    success = gsmModem.waitForNetwork(maxConnectionTime);
+                } else {
+                    success = false;
+                }
+                if (!success) { PRINTOUT(F("... WiFi connection failed")); }
+#else
                 PRINTOUT(F("... WiFi connection failed"));
                 success = false;
+#endif
             }
         }
         MS_DBG(F("... WiFi connected after"), MS_PRINT_DEBUG_TIMER,
                F("milliseconds!"));
+        if (success) {
+            MS_MODEM_SAVE_CONNECTION
+            MS_MODEM_WARM_ATTACHED
+        }
     }
     if (!wasPowered) {
         MS_DBG(F("Modem was powered to connect to the internet!  "
@@ -87,6 +101,60 @@ bool DigiXBeeWifi::connectInternet(uint32_t maxConnectionTime) {
 }
 MS_MODEM_IS_INTERNET_AVAILABLE(DigiXBeeWifi);
 
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+// Keep the address given by DHCP as a static address in the XBee's flash
+void DigiXBeeWifi::saveConnection(void) {
+    if (_connectionSaved) { return; }
+    _connectionSaved = true;
+    if (!gsmModem.commandMode()) { return; }
+    // MA is the IP addressing mode: 0 for DHCP, 1 for static
+    if (gsmModem.sendATGetString(GFP("MA")).toInt() == 0) {
+        String ip      = gsmModem.sendATGetString(GFP("MY"));
+        String gateway = gsmModem.sendATGetString(GFP("GW"));
+        String netmask = gsmModem.sendATGetString(GFP("MK"));
+        String dns     = gsmModem.sendATGetString(GFP("NS"));
+        if (ip.length() > 0 && ip != "0.0.0.0") {
+            MS_DBG(F("Keeping"), ip, F("as a static address"));
+            bool success = true;
+            gsmModem.sendAT(GF("MA"), 1);
+            success &= gsmModem.waitResponse(GF("OK\r")) == 1;
+            gsmModem.sendAT(GF("MY"), ip);
+            success &= gsmModem.waitResponse(GF("OK\r")) == 1;
+            gsmModem.sendAT(GF("GW"), gateway);
+            success &= gsmModem.waitResponse(GF("OK\r")) == 1;
+            gsmModem.sendAT(GF("MK"), netmask);
+            success &= gsmModem.waitResponse(GF("OK\r")) == 1;
+            gsmModem.sendAT(GF("NS"), dns);
+            success &= gsmModem.waitResponse(GF("OK\r")) == 1;
+            if (success) {
+                gsmModem.writeChanges();
+            } else {
+                MS_DBG(F("Failed to set the static address"));
+                gsmModem.sendAT(GF("MA"), 0);
+                gsmModem.waitResponse(GF("OK\r"));
+                gsmModem.writeChanges();
+            }
+        }
+    }
+    gsmModem.exitCommand();
+}
+
+
+bool DigiXBeeWifi::useDHCPAddress(void) {
+    bool changed = false;
+    if (!gsmModem.commandMode()) { return false; }
+    if (gsmModem.sendATGetString(GFP("MA")).toInt() != 0) {
+        MS_DBG(F("Putting the XBee back on DHCP"));
+        gsmModem.sendAT(GF("MA"), 0);
+        changed = gsmModem.waitResponse(GF("OK\r")) == 1;
+        if (changed) { gsmModem.writeChanges(); }
+        _connectionSaved = false;
+    }
+    gsmModem.exitCommand();
+    return changed;
+}
+#endif
+
 MS_MODEM_GET_MODEM_BATTERY_DATA(DigiXBeeWifi);
 MS_MODEM_GET_MODEM_TEMPERATURE_DATA(DigiXBeeWifi);
 
@@ -176,8 +176,28 @@ class DigiXBeeWifi : public DigiXBee {
      */
     bool extraModemSetup(void) override;
     bool isModemAwake(void) override;
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+    /**
+     * @copybrief loggerModem::saveConnection()
+     *
+     * For the XBee, the address given by DHCP is written to the XBee's flash
+     * as a static address, so later joins skip DHCP.  This is only checked
+     * once after the logger starts.
+     */
+    void saveConnection(void) override;
+#endif
 
  private:
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+    /**
+     * @brief Put the XBee back on DHCP if it was given a static address.
+     *
+     * @return **bool** True if the XBee was moved back to DHCP.
+     */
+    bool useDHCPAddress(void);
+
+    bool _connectionSaved = false;
+#endif
     const char* _ssid;
     const char* _pwd;
     bool        _maintainAssociation;
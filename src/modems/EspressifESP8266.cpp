@@ -28,6 +28,9 @@ EspressifESP8266::EspressifESP8266(Stream* modemStream, int8_t powerPin,
       gsmModem(*modemStream),
 #endif
       gsmClient(gsmModem),
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+      gsmClientSecure(gsmModem, 1),
+#endif
       _modemStream(modemStream),
       _ssid(ssid),
       _pwd(pwd) {
@@ -38,8 +41,14 @@ EspressifESP8266::~EspressifESP8266() {}
 
 MS_IS_MODEM_AWAKE(EspressifESP8266);
 MS_MODEM_WAKE(EspressifESP8266);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(EspressifESP8266);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(EspressifESP8266, ESP8266_RECONNECT_TIME_MS);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(EspressifESP8266, ESP8266_RECONNECT_TIME_MS);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(EspressifESP8266);
 MS_MODEM_IS_INTERNET_AVAILABLE(EspressifESP8266);
 
@@ -129,6 +138,114 @@ bool EspressifESP8266::extraModemSetup(void) {
     if (_modemSleepRqPin >= 0) { digitalWrite(_modemSleepRqPin, !_wakeLevel); }
     gsmModem.init();
     gsmClient.init(&gsmModem);
+    MS_MODEM_INIT_SECURE_CLIENT
     _modemName = gsmModem.getModemName();
     return true;
 }
+
+
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+// Join the access point from the last connection directly, skipping the scan
+// for the strongest access point and the wait for DHCP
+bool EspressifESP8266::fastConnect(void) {
+    if (_bssid[0] == '\0' || gsmModem.isNetworkConnected()) { return false; }
+    MS_DBG(F("Rejoining"), _bssid, F("as"), _staticIP, F("..."));
+    MS_START_DEBUG_TIMER
+    gsmModem.sendAT(GF("+CIPSTA_CUR=\""), _staticIP, GF("\",\""), _gateway,
+                    GF("\",\""), _netmask, '"');
+    bool success = gsmModem.waitResponse() == 1;
+    if (success && _dnsServer[0] != '\0') {
+        gsmModem.sendAT(GF("+CIPDNS_CUR=1,\""), _dnsServer, '"');
+        gsmModem.waitResponse();
+    }
+    if (success) {
+        gsmModem.sendAT(GF("+CWJAP_CUR=\""), _ssid, GF("\",\""), _pwd,
+                        GF("\",\""), _bssid, '"');
+        success = gsmModem.waitResponse(ESP8266_FAST_CONNECT_TIME_MS) == 1;
+    }
+    if (success) {
+        MS_DBG(F("... rejoined after"), MS_PRINT_DEBUG_TIMER,
+               F("milliseconds"));
+    } else {
+        // Forget the access point and go back to DHCP for the usual join
+        MS_DBG(F("... failed to rejoin; going back to DHCP"));
+        _bssid[0] = '\0';
+        gsmModem.sendAT(GF("+CWDHCP_CUR=1,1"));
+        gsmModem.waitResponse();
+    }
+    return success;
+}
+
+
+// Remember the access point and the address given by DHCP
+void EspressifESP8266::saveConnection(void) {
+    if (_bssid[0] != '\0') { return; }
+    // +CWJAP_CUR:<ssid>,<bssid>,<channel>,<rssi>
+    gsmModem.sendAT(GF("+CWJAP_CUR?"));
+    if (gsmModem.waitResponse(GF("+CWJAP_CUR:")) != 1) { return; }
+    readModemField(nullptr, 0, ',');
+    readModemField(_bssid, sizeof(_bssid), ',');
+    gsmModem.waitResponse();
+
+    // +CIPSTA_CUR:ip:<ip> then the gateway and netmask on their own lines
+    gsmModem.sendAT(GF("+CIPSTA_CUR?"));
+    if (gsmModem.waitResponse(GF("ip:")) == 1) {
+        readModemField(_staticIP, sizeof(_staticIP), '\n');
+    }
+    if (gsmModem.waitResponse(GF("gateway:")) == 1) {
+        readModemField(_gateway, sizeof(_gateway), '\n');
+    }
+    if (gsmModem.waitResponse(GF("netmask:")) == 1) {
+        readModemField(_netmask, sizeof(_netmask), '\n');
+    }
+    gsmModem.waitResponse();
+
+    gsmModem.sendAT(GF("+CIPDNS_CUR?"));
+    if (gsmModem.waitResponse(GF("+CIPDNS_CUR:")) == 1) {
+        readModemField(_dnsServer, sizeof(_dnsServer), '\n');
+    }
+    gsmModem.waitResponse();
+
+    if (_staticIP[0] == '\0' || _gateway[0] == '\0' || _netmask[0] == '\0') {
+        _bssid[0] = '\0';
+        return;
+    }
+    MS_DBG(F("Saved access point"), _bssid, F("and address"), _staticIP);
+}
+
+
+void EspressifESP8266::readModemField(char* buf, uint8_t size,
+                                      char terminator) {
+    uint8_t n      = 0;
+    bool    quoted = false;
+    char    c;
+    while (gsmModem.stream.readBytes(&c, 1) == 1 && c != '\n' &&
+           (quoted || c != terminator)) {
+        // A terminator between the quotes, like a comma in an SSID, is part
+        // of the field
+        if (c == '"') {
+            quoted = !quoted;
+            continue;
+        }
+        if (buf != nullptr && c != '\r' && n < size - 1) { buf[n++] = c; }
+    }
+    if (buf != nullptr) { buf[n] = '\0'; }
+}
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool EspressifESP8266::resolveHost(const char* host, IPAddress& address) {
+    // The answer is +CIPDOMAIN:<address>
+    gsmModem.sendAT(GF("+CIPDOMAIN=\""), host, '"');
+    if (gsmModem.waitResponse(15000L, GF("+CIPDOMAIN:")) != 1) { return false; }
+    bool found = addressFromLine(gsmModem.stream.readStringUntil('\n'),
+                                 address);
+    gsmModem.waitResponse();
+    return found;
+}
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+bool EspressifESP8266::isSecureClient(Client* client) {
+    return client == &gsmClientSecure;
+}
+#endif
+#endif
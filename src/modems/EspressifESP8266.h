@@ -179,6 +179,13 @@
  * credentials.
  */
 #define ESP8266_RECONNECT_TIME_MS 2500
+/**
+ * @brief The amount of time in ms to wait for the ESP8266 to rejoin the last
+ * access point directly with #MS_MODEM_WIFI_FAST_CONNECT.
+ *
+ * A direct join usually takes about 300ms.
+ */
+#define ESP8266_FAST_CONNECT_TIME_MS 5000L
 
 // Included Dependencies
 #include "ModSensorDebugger.h"
@@ -226,9 +233,15 @@ class EspressifESP8266 : public loggerModem {
     ~EspressifESP8266();
 
     bool modemWake(void) override;
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    bool negotiateBaud(void) override;
+#endif
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
 
@@ -236,6 +249,12 @@ class EspressifESP8266 : public loggerModem {
     bool  getModemBatteryStats(uint8_t& chargeState, int8_t& percent,
                                uint16_t& milliVolts) override;
     float getModemChipTemperature(void) override;
+#ifdef MS_PUBLISHER_DNS_CACHE
+    bool resolveHost(const char* host, IPAddress& address) override;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    bool isSecureClient(Client* client) override;
+#endif
+#endif
 
 #ifdef MS_ESPRESSIFESP8266_DEBUG_DEEP
     StreamDebugger _modemATDebugger;
@@ -249,6 +268,12 @@ class EspressifESP8266 : public loggerModem {
      * @brief Public reference to the TinyGSM Client.
      */
     TinyGsmClient gsmClient;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    /**
+     * @brief Public reference to the TinyGSM secure (TLS) client, on socket 1.
+     */
+    TinyGsmClientSecure gsmClientSecure;
+#endif
 
     /**
      * @brief A pointer to the Arduino serial Stream used for communication
@@ -264,11 +289,34 @@ class EspressifESP8266 : public loggerModem {
     bool modemWakeFxn(void) override;
     bool extraModemSetup(void) override;
     bool isModemAwake(void) override;
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+    bool fastConnect(void) override;
+    void saveConnection(void) override;
+#endif
 
  private:
     bool        ESPwaitForBoot(void);
     const char* _ssid;
     const char* _pwd;
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+    /**
+     * @brief Read one field of a response from the ESP8266, without its
+     * quotes.
+     *
+     * A terminator inside the quotes doesn't end the field.
+     *
+     * @param buf The buffer for the field; null to skip it
+     * @param size The size of the buffer
+     * @param terminator The character after the field
+     */
+    void readModemField(char* buf, uint8_t size, char terminator);
+
+    char _bssid[18]     = "";
+    char _staticIP[16]  = "";
+    char _gateway[16]   = "";
+    char _netmask[16]   = "";
+    char _dnsServer[16] = "";
+#endif
 };
 
 /**
@@ -16,6 +16,20 @@
 #define SRC_MODEMS_LOGGERMODEMMACROS_H_
 
 
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+/**
+ * @brief Creates a text string to attach the secure client to the TinyGSM
+ * modem, for the extraModemSetup() and modemWake() functions.
+ */
+#define MS_MODEM_INIT_SECURE_CLIENT gsmClientSecure.init(&gsmModem, 1);
+#else
+/**
+ * @brief Creates a text string to attach the secure client to the TinyGSM
+ * modem; empty without #MS_MODEM_SECURE_CLIENT or TLS support in TinyGSM.
+ */
+#define MS_MODEM_INIT_SECURE_CLIENT
+#endif
+
 /**
  * @brief Creates an extraModemSetup() function for a specific modem subclass.
  *
@@ -31,6 +45,7 @@
     bool specificModem::extraModemSetup(void) { \
         bool success = gsmModem.init();         \
         gsmClient.init(&gsmModem);              \
+        MS_MODEM_INIT_SECURE_CLIENT             \
         _modemName = gsmModem.getModemName();   \
         return success;                         \
     }
@@ -91,6 +106,134 @@
     }
 
 
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+/**
+ * @brief Creates a text string to move the modem to the faster baud rate once
+ * it answers AT commands, for the modemWake() function.
+ */
+#define MS_MODEM_FAST_BAUD \
+    if (success) { negotiateBaud(); }
+/**
+ * @brief Creates a text string to retry the AT check at the default rate
+ * before a hard reset, in case the modem lost power at the faster rate.
+ */
+#define MS_MODEM_BAUD_FALLBACK \
+    if (resetModemBaud()) { continue; }
+
+/**
+ * @brief Creates a negotiateBaud() function for a specific modem subclass.
+ *
+ * This asks for the rate given to loggerModem::setModemBaud() with the
+ * specific modem's TinyGSM setBaud() function, moves the serial port to that
+ * rate, and checks it with an AT command.  If there's no answer, the modem is
+ * asked to go back to the default rate and isn't asked for the faster rate
+ * again.
+ *
+ * @param specificModem The modem subclass
+ *
+ * @return The text of a negotiateBaud() function specific to a single modem
+ * subclass.
+ */
+#define MS_MODEM_NEGOTIATE_BAUD(specificModem)                              \
+    bool specificModem::negotiateBaud(void) {                               \
+        if (_baudSerial == nullptr || _targetBaudFailed) { return false; }  \
+        if (_currentBaud == _targetBaud) { return true; }                   \
+        MS_DBG(F("Asking the modem for"), _targetBaud, F("baud"));          \
+        gsmModem.setBaud(_targetBaud);                                      \
+        /** Let the modem finish its response before switching */           \
+        delay(100);                                                         \
+        _baudSerial->end();                                                 \
+        _baudSerial->begin(_targetBaud);                                    \
+        _currentBaud = _targetBaud;                                         \
+        if (gsmModem.testAT(1000L)) {                                       \
+            MS_DBG(F("... modem answered at"), _targetBaud, F("baud"));     \
+            return true;                                                    \
+        }                                                                   \
+        MS_DBG(F("... no answer, staying at"), _defaultBaud, F("baud"));    \
+        _targetBaudFailed = true;                                           \
+        gsmModem.setBaud(_defaultBaud);                                     \
+        delay(100);                                                         \
+        resetModemBaud();                                                   \
+        gsmModem.testAT(1000L);                                             \
+        return false;                                                       \
+    }
+#else
+/**
+ * @brief Creates a text string to move the modem to the faster baud rate;
+ * empty without #MS_MODEM_BAUD_NEGOTIATION.
+ */
+#define MS_MODEM_FAST_BAUD
+/**
+ * @brief Creates a text string to retry the AT check at the default rate;
+ * empty without #MS_MODEM_BAUD_NEGOTIATION.
+ */
+#define MS_MODEM_BAUD_FALLBACK
+#endif
+
+#ifdef MS_MODEM_RECOVERY
+/**
+ * @brief The number of times a wake checks for an AT response: once before
+ * the recovery steps and once after each of them.
+ *
+ * The loop leaves early once the ladder is used up.
+ */
+#define MS_MODEM_WAKE_RESETS (MODEM_RECOVERY_FACTORY_RESET + 1)
+/**
+ * @brief Creates a text string to start the recovery ladder, for the
+ * modemWake() function.
+ */
+#define MS_MODEM_BEGIN_RECOVERY beginRecovery();
+/**
+ * @brief Creates a text string to take the next step of the recovery ladder,
+ * leaving the loop once they've all been tried, for the modemWake() function.
+ */
+#define MS_MODEM_RECOVER                               \
+    modemRecoveryStep step = nextRecoveryStep();       \
+    if (step == MODEM_RECOVERY_NONE) { break; }        \
+    if (step == MODEM_RECOVERY_SOFT_RESET) {           \
+        gsmModem.restart();                            \
+    } else if (step == MODEM_RECOVERY_FACTORY_RESET) { \
+        gsmModem.factoryDefault();                     \
+        /** Everything set up has to be set again. */  \
+        _hasBeenSetup = false;                         \
+    } else {                                           \
+        runRecoveryStep(step);                         \
+    }                                                  \
+    resets++;
+/**
+ * @brief Creates a text string to remember where the recovery ladder starts
+ * next time, for the modemWake() function.
+ */
+#define MS_MODEM_END_RECOVERY endRecovery(success);
+#else
+/**
+ * @brief The number of hard resets a wake can try.
+ */
+#define MS_MODEM_WAKE_RESETS 2
+/**
+ * @brief Creates a text string to start the recovery ladder; empty without
+ * #MS_MODEM_RECOVERY.
+ */
+#define MS_MODEM_BEGIN_RECOVERY
+/**
+ * @brief Creates a text string to hard reset the modem, leaving the loop if
+ * it can't be, for the modemWake() function.
+ */
+#define MS_MODEM_RECOVER                                             \
+    MS_DBG(F("Attempting a hard reset on the modem! "), resets + 1); \
+    if (!modemHardReset()) {                                         \
+        /** Exit if we can't hard reset. */                          \
+        break;                                                       \
+    } else {                                                         \
+        resets++;                                                    \
+    }
+/**
+ * @brief Creates a text string to remember where the recovery ladder starts
+ * next time; empty without #MS_MODEM_RECOVERY.
+ */
+#define MS_MODEM_END_RECOVERY
+#endif
+
 /**
  * @brief Creates a modemWake() function for a specific modem subclass.
  *
@@ -131,7 +274,8 @@
                                                                                \
         uint8_t resets  = 0;                                                   \
         bool    success = false;                                               \
-        while (!success && resets < 2) {                                       \
+        MS_MODEM_BEGIN_RECOVERY                                                \
+        while (!success && resets < MS_MODEM_WAKE_RESETS) {                    \
             /** Check that the modem is responding to AT commands. */          \
             MS_START_DEBUG_TIMER;                                              \
             MS_DBG(F("\nWaiting up to"), _max_atresponse_time_ms, F("ms for"), \
@@ -141,18 +285,14 @@
                 MS_DBG(F("... AT OK after"), MS_PRINT_DEBUG_TIMER,             \
                        F("milliseconds!"));                                    \
             } else {                                                           \
-                /** Hard reset is there's no AT response. */                   \
+                MS_MODEM_BAUD_FALLBACK                                         \
+                /** Reset if there's no AT response. */                        \
                 MS_DBG(F("No response to AT commands!"));                      \
-                MS_DBG(F("Attempting a hard reset on the modem! "),            \
-                       resets + 1);                                            \
-                if (!modemHardReset()) {                                       \
-                    /** Exit if we can't hard reset. */                        \
-                    break;                                                     \
-                } else {                                                       \
-                    resets++;                                                  \
-                }                                                              \
+                MS_MODEM_RECOVER                                               \
             }                                                                  \
         }                                                                      \
+        MS_MODEM_END_RECOVERY                                                  \
+        MS_MODEM_FAST_BAUD                                                     \
                                                                                \
         /** Clean any junk out of the modem buffer. */                         \
         gsmModem.streamClear();                                                \
@@ -168,6 +308,7 @@
             success &= gsmModem.init();                                        \
         }                                                                      \
         gsmClient.init(&gsmModem);                                             \
+        MS_MODEM_INIT_SECURE_CLIENT                                            \
                                                                                \
         if (success) {                                                         \
             modemLEDOn();                                                      \
@@ -179,6 +320,170 @@
         return success;                                                        \
     }
 
+#ifdef MS_MODEM_PIGGYBACK_METADATA
+/**
+ * @brief Creates a text string to read the modem metadata as soon as the modem
+ * is registered, for the connectInternet() and pollConnect() functions.
+ */
+#define MS_MODEM_CAPTURE_METADATA captureModemMetadata();
+#else
+/**
+ * @brief Creates a text string to read the modem metadata as soon as the modem
+ * is registered; empty without #MS_MODEM_PIGGYBACK_METADATA.
+ */
+#define MS_MODEM_CAPTURE_METADATA
+#endif
+
+#ifdef MS_MODEM_WIFI_FAST_CONNECT
+/**
+ * @brief Creates a text string to rejoin the last access point directly, for
+ * the WiFi connectInternet() and pollConnect() functions.
+ */
+#define MS_MODEM_FAST_CONNECT fastConnect();
+/**
+ * @brief Creates a text string to remember the access point and address of a
+ * new WiFi connection.
+ */
+#define MS_MODEM_SAVE_CONNECTION saveConnection();
+#else
+/**
+ * @brief Creates a text string to rejoin the last access point directly;
+ * empty without #MS_MODEM_WIFI_FAST_CONNECT.
+ */
+#define MS_MODEM_FAST_CONNECT
+/**
+ * @brief Creates a text string to remember the access point and address of a
+ * new WiFi connection; empty without #MS_MODEM_WIFI_FAST_CONNECT.
+ */
+#define MS_MODEM_SAVE_CONNECTION
+#endif
+
+#ifdef MS_MODEM_STATS
+/**
+ * @brief Creates a text string to count a connection and note when it was
+ * started, for the connectInternet() functions.
+ */
+#define MS_MODEM_STATS_START        \
+    uint32_t statsStart = millis(); \
+    _stats.connectAttempts++;
+/**
+ * @brief Creates a text string to keep the time to register of a connection
+ * started at `started`.
+ */
+#define MS_MODEM_STATS_REGISTERED(started) \
+    _stats.registration_ms = millis() - (started);
+/**
+ * @brief Creates a text string to keep the time to get online of a connection
+ * started at `started` and count it as made.
+ */
+#define MS_MODEM_STATS_CONNECTED(started)     \
+    _stats.connect_ms = millis() - (started); \
+    _stats.connects++;
+#else
+/**
+ * @brief Creates a text string to count a connection; empty without
+ * #MS_MODEM_STATS.
+ */
+#define MS_MODEM_STATS_START
+/**
+ * @brief Creates a text string to keep the time to register; empty without
+ * #MS_MODEM_STATS.
+ */
+#define MS_MODEM_STATS_REGISTERED(started)
+/**
+ * @brief Creates a text string to keep the time to get online; empty without
+ * #MS_MODEM_STATS.
+ */
+#define MS_MODEM_STATS_CONNECTED(started)
+#endif
+
+#ifdef MS_MODEM_WARM_STANDBY
+/**
+ * @brief Creates a text string to keep the time from power up to online of a
+ * cold attach, for the connectInternet() and pollConnect() functions.
+ */
+#define MS_MODEM_WARM_ATTACHED                      \
+    if (_coldStart) {                               \
+        _coldAttach_ms = millis() - _millisPowerOn; \
+        _coldStart     = false;                     \
+    }
+#else
+/**
+ * @brief Creates a text string to keep the time of a cold attach; empty
+ * without #MS_MODEM_WARM_STANDBY.
+ */
+#define MS_MODEM_WARM_ATTACHED
+#endif
+
+#if defined(MS_MODEM_NETWORK_SELECT) && defined(TINY_GSM_MODEM_HAS_GPRS)
+/**
+ * @brief Creates a text string to send any new radio access and band lock and
+ * to ask for the last operator once after power up, before waiting for
+ * network registration.
+ *
+ * `AT+COPS=4` tries the given operator first and falls back to the automatic
+ * search; it returns once the modem has registered either way.
+ */
+#define MS_MODEM_SELECT_NETWORK                                           \
+    if (_radioAccessPending) {                                            \
+        MS_DBG(F("Sending the radio access and band lock"));              \
+        _radioAccessPending = !applyRadioAccess();                        \
+    }                                                                     \
+    if (_operatorPending && _lastOperator[0] != '\0') {                   \
+        MS_DBG(F("Trying the last operator"), _lastOperator, F("first")); \
+        if (_lastAccess >= 0) {                                           \
+            gsmModem.sendAT(GF("+COPS=4,2,\""), _lastOperator, GF("\","),  \
+                            _lastAccess);                                 \
+        } else {                                                          \
+            gsmModem.sendAT(GF("+COPS=4,2,\""), _lastOperator, '"');      \
+        }                                                                 \
+        gsmModem.waitResponse(MS_MODEM_OPERATOR_TIMEOUT_MS);              \
+    }                                                                     \
+    _operatorPending = false;
+/**
+ * @brief Creates a text string to read back and keep the operator and access
+ * technology the modem registered on, after network registration.
+ *
+ * The answer to `AT+COPS?` is `+COPS: <mode>,2,"<operator>",<access>`.  The
+ * format is put back to the default long name afterwards, which TinyGSM's
+ * getOperator() expects.
+ */
+#define MS_MODEM_REMEMBER_NETWORK                                         \
+    gsmModem.sendAT(GF("+COPS=3,2"));                                     \
+    gsmModem.waitResponse();                                              \
+    gsmModem.sendAT(GF("+COPS?"));                                        \
+    if (gsmModem.waitResponse(GF("+COPS:")) == 1) {                       \
+        String copsLine = gsmModem.stream.readStringUntil('\n');          \
+        int    opStart  = copsLine.indexOf('"');                          \
+        int    opEnd    = copsLine.indexOf('"', opStart + 1);             \
+        if (opStart >= 0 && opEnd > opStart &&                            \
+            opEnd - opStart <= static_cast<int>(sizeof(_lastOperator))) { \
+            copsLine.substring(opStart + 1, opEnd)                        \
+                .toCharArray(_lastOperator, sizeof(_lastOperator));       \
+            int accessStart = copsLine.indexOf(',', opEnd);               \
+            _lastAccess     = accessStart > 0                             \
+                    ? copsLine.substring(accessStart + 1).toInt()         \
+                    : -1;                                                 \
+            MS_DBG(F("Registered on operator"), _lastOperator,            \
+                   F("with access technology"), _lastAccess);             \
+        }                                                                 \
+        gsmModem.waitResponse();                                          \
+    }                                                                     \
+    gsmModem.sendAT(GF("+COPS=3,0"));                                     \
+    gsmModem.waitResponse();
+#else
+/**
+ * @brief Creates a text string to lock the radio and ask for the last
+ * operator; empty without #MS_MODEM_NETWORK_SELECT.
+ */
+#define MS_MODEM_SELECT_NETWORK
+/**
+ * @brief Creates a text string to keep the operator registered on; empty
+ * without #MS_MODEM_NETWORK_SELECT.
+ */
+#define MS_MODEM_REMEMBER_NETWORK
+#endif
+
 #if defined TINY_GSM_MODEM_HAS_GPRS
 /**
  * @brief Creates an isInternetAvailable() function for a specific modem
@@ -229,6 +534,112 @@
 #define MS_MODEM_SET_APN
 #endif  // #ifndef TINY_GSM_MODEM_XBEE
 
+#ifdef MS_MODEM_STAY_REGISTERED
+/**
+ * @brief Creates a text string of the functions to call for a specific modem to
+ * attach after network registration during the internet connection sequence.
+ *
+ * With #MS_MODEM_STAY_REGISTERED, a PDP context still open from before the
+ * modem went into power saving mode is reused instead of running
+ * #MS_MODEM_SET_APN again, and the power saving timers are requested if the
+ * modem should stay registered and hasn't accepted them yet.  Otherwise this
+ * is #MS_MODEM_SET_APN.
+ *
+ * @return Text string containing the functions to attach to the network.
+ */
+#define MS_MODEM_ATTACH                                                  \
+    if (_powerSaving && gsmModem.isGprsConnected()) {                    \
+        MS_DBG(F("... Still attached from before power saving mode")); \
+    } else {                                                             \
+        MS_MODEM_SET_APN                                                 \
+    }                                                                    \
+    if (_stayRegistered && !_powerSaving) {                              \
+        _powerSaving = requestPowerSaving();                             \
+    }
+/**
+ * @brief Creates a text string to leave the PDP context open when the modem
+ * is staying registered in power saving mode, for the start of the
+ * disconnectInternet() function.
+ */
+#define MS_MODEM_STAY_ATTACHED                                      \
+    if (_powerSaving) {                                             \
+        MS_DBG(F("Leaving the PDP context open for power saving")); \
+        return;                                                     \
+    }
+
+/**
+ * @brief Creates a requestPowerSaving() function for a specific modem
+ * subclass.
+ *
+ * This requests the power saving mode timers with `AT+CPSMS` and, if one was
+ * given, the eDRX cycle for LTE-M with `AT+CEDRXS`.  Only the PSM request has
+ * to succeed; the network may still grant different timers than those
+ * requested.
+ *
+ * @param specificModem The modem subclass
+ *
+ * @return The text of a requestPowerSaving() function specific to a single
+ * modem subclass.
+ */
+#define MS_MODEM_REQUEST_POWER_SAVING(specificModem)                        \
+    bool specificModem::requestPowerSaving(void) {                          \
+        MS_DBG(F("Requesting power saving mode with TAU"), _psmPeriodicTAU, \
+               F("and active time"), _psmActiveTime);                       \
+        gsmModem.sendAT(GF("+CPSMS=1,,,\""), _psmPeriodicTAU, GF("\",\""),  \
+                        _psmActiveTime, '"');                               \
+        bool success = gsmModem.waitResponse() == 1;                        \
+        if (success && _eDRXCycle != nullptr) {                             \
+            MS_DBG(F("Requesting eDRX cycle"), _eDRXCycle);                 \
+            gsmModem.sendAT(GF("+CEDRXS=1,4,\""), _eDRXCycle, '"');         \
+            gsmModem.waitResponse();                                        \
+        }                                                                   \
+        return success;                                                     \
+    }
+#else
+/**
+ * @brief Creates a text string of the functions to call for a specific modem to
+ * attach after network registration; this is #MS_MODEM_SET_APN.
+ */
+#define MS_MODEM_ATTACH MS_MODEM_SET_APN
+/**
+ * @brief Creates a text string to leave the PDP context open in power saving
+ * mode; empty without #MS_MODEM_STAY_REGISTERED.
+ */
+#define MS_MODEM_STAY_ATTACHED
+#endif  // #ifdef MS_MODEM_STAY_REGISTERED
+
+#ifdef MS_MODEM_RELEASE_ASSIST
+/**
+ * @brief Creates a text string to ask the network to release the radio, for
+ * the start of the disconnectInternet() function.
+ */
+#define MS_MODEM_RELEASE_ASSIST_STEP releaseRadio();
+
+/**
+ * @brief Creates a releaseRadio() function for a specific modem subclass.
+ *
+ * This sends the 3GPP "no more packet data" release assistance indication
+ * with `AT+CNMPSD`.
+ *
+ * @param specificModem The modem subclass
+ *
+ * @return The text of a releaseRadio() function specific to a single modem
+ * subclass.
+ */
+#define MS_MODEM_RELEASE_RADIO(specificModem)                    \
+    bool specificModem::releaseRadio(void) {                     \
+        MS_DBG(F("Telling the network no more data is coming")); \
+        gsmModem.sendAT(GF("+CNMPSD"));                          \
+        return gsmModem.waitResponse() == 1;                     \
+    }
+#else
+/**
+ * @brief Creates a text string to ask the network to release the radio; empty
+ * without #MS_MODEM_RELEASE_ASSIST.
+ */
+#define MS_MODEM_RELEASE_ASSIST_STEP
+#endif  // #ifdef MS_MODEM_RELEASE_ASSIST
+
 /**
  * @brief Creates a connectInternet(uint32_t maxConnectionTime) function for a
  * specific modem subclass.
@@ -254,6 +665,7 @@
 #define MS_MODEM_CONNECT_INTERNET(specificModem)                             \
     bool specificModem::connectInternet(uint32_t maxConnectionTime) {        \
         bool success = true;                                                 \
+        MS_MODEM_STATS_START                                                 \
                                                                              \
         /** Power up, if necessary */                                        \
         bool wasPowered = true;                                              \
@@ -277,10 +689,16 @@
                                                                              \
         if (success) {                                                       \
             MS_START_DEBUG_TIMER                                             \
+            MS_MODEM_SELECT_NETWORK                                          \
             MS_DBG(F("\nWaiting up to"), maxConnectionTime / 1000,           \
                    F("seconds for cellular network registration..."));       \
             if (gsmModem.waitForNetwork(maxConnectionTime)) {                \
-                MS_MODEM_SET_APN                                             \
+                MS_MODEM_STATS_REGISTERED(statsStart)                        \
+                MS_MODEM_REMEMBER_NETWORK                                    \
+                MS_MODEM_CAPTURE_METADATA                                    \
+                MS_MODEM_ATTACH                                              \
+                MS_MODEM_STATS_CONNECTED(statsStart)                         \
+                MS_MODEM_WARM_ATTACHED                                       \
                 MS_DBG(F("... Connected after"), MS_PRINT_DEBUG_TIMER,       \
                        F("milliseconds."));                                  \
                 success = true;                                              \
@@ -299,6 +717,67 @@
         return success;                                                      \
     }
 
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+/**
+ * @brief Creates a pollConnect() function for a specific modem subclass.
+ *
+ * For cellular modems, this wakes the modem once it has warmed up, then checks
+ * the network registration every #MS_MODEM_CONNECT_POLL_MS until the modem
+ * registers and then connects to GPRS using #MS_MODEM_ATTACH.
+ *
+ * For WiFi modems, this wakes the modem once it has warmed up, waits to see if
+ * the modem reconnects from saved credentials, and if not sends the
+ * credentials and waits for the connection.
+ *
+ * @param specificModem The modem subclass
+ *
+ * @return The text of a pollConnect() function specific to a single modem
+ * subclass.
+ */
+#define MS_MODEM_POLL_CONNECT(specificModem)                                   \
+    modemConnectState specificModem::pollConnect(void) {                      \
+        if (_connectState == MODEM_CONNECT_IDLE ||                             \
+            _connectState == MODEM_CONNECT_CONNECTED ||                        \
+            _connectState == MODEM_CONNECT_FAILED) {                           \
+            return _connectState;                                              \
+        }                                                                      \
+        if (millis() - _connectStarted > _connectTimeout) {                    \
+            MS_DBG(F("... Connection timed out after"), _connectTimeout,       \
+                   F("milliseconds."));                                        \
+            _connectState = MODEM_CONNECT_FAILED;                              \
+        } else if (_connectState == MODEM_CONNECT_WAKING) {                    \
+            /** Wake the modem once it has warmed up; modemWake() also runs    \
+                the init on a modem that's already awake */                    \
+            if (millis() - _millisPowerOn >= _wakeDelayTime_ms) {              \
+                if (modemWake()) {                                             \
+                    MS_DBG(F("Waiting for cellular network registration...")); \
+                    MS_MODEM_SELECT_NETWORK                                    \
+                    _connectStepStarted = millis();                            \
+                    _connectState       = MODEM_CONNECT_REGISTERING;           \
+                } else {                                                       \
+                    _connectState = MODEM_CONNECT_FAILED;                      \
+                }                                                              \
+            }                                                                  \
+        } else if (millis() - _lastConnectPoll >= MS_MODEM_CONNECT_POLL_MS) {  \
+            /** Check the registration, but not too often */                   \
+            _lastConnectPoll = millis();                                       \
+            if (gsmModem.isNetworkConnected()) {                               \
+                MS_START_DEBUG_TIMER                                           \
+                MS_MODEM_STATS_REGISTERED(_connectStarted)                     \
+                MS_MODEM_REMEMBER_NETWORK                                      \
+                MS_MODEM_CAPTURE_METADATA                                      \
+                MS_MODEM_ATTACH                                                \
+                MS_MODEM_STATS_CONNECTED(_connectStarted)                      \
+                MS_MODEM_WARM_ATTACHED                                         \
+                MS_DBG(F("... Connected after"), millis() - _connectStarted,   \
+                       F("milliseconds."));                                    \
+                _connectState = MODEM_CONNECT_CONNECTED;                       \
+            }                                                                  \
+        }                                                                      \
+        return _connectState;                                                  \
+    }
+#endif  // #ifdef MS_MODEM_NONBLOCKING_CONNECT
+
 /**
  * @brief Creates a disconnectInternet() function for a specific modem subclass.
  *
@@ -315,6 +794,8 @@
  */
 #define MS_MODEM_DISCONNECT_INTERNET(specificModem)           \
     void specificModem::disconnectInternet(void) {            \
+        MS_MODEM_RELEASE_ASSIST_STEP                          \
+        MS_MODEM_STAY_ATTACHED                                \
         MS_START_DEBUG_TIMER;                                 \
         gsmModem.gprsDisconnect();                            \
         MS_DBG(F("Disconnected from cellular network after"), \
@@ -372,6 +853,7 @@
 #define MS_MODEM_CONNECT_INTERNET(specificModem, auto_reconnect_time)        \
     bool specificModem::connectInternet(uint32_t maxConnectionTime) {        \
         bool success = true;                                                 \
+        MS_MODEM_STATS_START                                                 \
                                                                              \
         /** Power up, if necessary */                                        \
         bool wasPowered = true;                                              \
@@ -397,6 +879,7 @@
          * credentials */                                                    \
         if (success) {                                                       \
             MS_START_DEBUG_TIMER                                             \
+            MS_MODEM_FAST_CONNECT                                            \
             MS_DBG(F("\nWaiting"), auto_reconnect_time,                      \
                    F("ms to see if WiFi connects without sending new "       \
                      "credentials..."));                                     \
@@ -417,6 +900,11 @@
             }                                                                \
             MS_DBG(F("... WiFi connected after"), MS_PRINT_DEBUG_TIMER,      \
                    F("milliseconds!"));                                      \
+            MS_MODEM_STATS_REGISTERED(statsStart)                            \
+            MS_MODEM_STATS_CONNECTED(statsStart)                             \
+            MS_MODEM_WARM_ATTACHED                                           \
+            MS_MODEM_SAVE_CONNECTION                                         \
+            MS_MODEM_CAPTURE_METADATA                                        \
         }                                                                    \
                                                                              \
         if (!wasPowered) {                                                   \
@@ -429,6 +917,77 @@
         return success;                                                      \
     }
 
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+/**
+ * @brief Creates a pollConnect() function for a specific modem subclass.
+ *
+ * For cellular modems, this wakes the modem once it has warmed up, then checks
+ * the network registration every #MS_MODEM_CONNECT_POLL_MS until the modem
+ * registers and then connects to GPRS using #MS_MODEM_ATTACH.
+ *
+ * For WiFi modems, this wakes the modem once it has warmed up, waits to see if
+ * the modem reconnects from saved credentials, and if not sends the
+ * credentials and waits for the connection.
+ *
+ * @param specificModem The modem subclass
+ *
+ * @return The text of a pollConnect() function specific to a single modem
+ * subclass.
+ */
+#define MS_MODEM_POLL_CONNECT(specificModem, auto_reconnect_time)             \
+    modemConnectState specificModem::pollConnect(void) {                      \
+        if (_connectState == MODEM_CONNECT_IDLE ||                            \
+            _connectState == MODEM_CONNECT_CONNECTED ||                       \
+            _connectState == MODEM_CONNECT_FAILED) {                          \
+            return _connectState;                                             \
+        }                                                                     \
+        if (millis() - _connectStarted > _connectTimeout) {                   \
+            MS_DBG(F("... Connection timed out after"), _connectTimeout,      \
+                   F("milliseconds."));                                       \
+            _connectState = MODEM_CONNECT_FAILED;                             \
+        } else if (_connectState == MODEM_CONNECT_WAKING) {                   \
+            /** Wake the modem once it has warmed up; modemWake() also runs   \
+                the init on a modem that's already awake */                   \
+            if (millis() - _millisPowerOn >= _wakeDelayTime_ms) {             \
+                if (modemWake()) {                                            \
+                    MS_MODEM_FAST_CONNECT                                     \
+                    MS_DBG(F("Waiting up to"), auto_reconnect_time,           \
+                           F("ms to see if WiFi connects without sending "    \
+                             "new credentials..."));                          \
+                    _connectStepStarted = millis();                           \
+                    _connectState       = MODEM_CONNECT_REGISTERING;          \
+                } else {                                                      \
+                    _connectState = MODEM_CONNECT_FAILED;                     \
+                }                                                             \
+            }                                                                 \
+        } else if (millis() - _lastConnectPoll >= MS_MODEM_CONNECT_POLL_MS) { \
+            /** Check the connection, but not too often */                    \
+            _lastConnectPoll = millis();                                      \
+            if (gsmModem.isNetworkConnected()) {                              \
+                MS_DBG(F("... WiFi connected after"),                         \
+                       millis() - _connectStarted, F("milliseconds!"));       \
+                MS_MODEM_STATS_REGISTERED(_connectStarted)                    \
+                MS_MODEM_STATS_CONNECTED(_connectStarted)                     \
+                MS_MODEM_WARM_ATTACHED                                        \
+                MS_MODEM_SAVE_CONNECTION                                      \
+                MS_MODEM_CAPTURE_METADATA                                     \
+                _connectState = MODEM_CONNECT_CONNECTED;                      \
+            } else if (_connectState == MODEM_CONNECT_REGISTERING &&          \
+                       millis() - _connectStepStarted >                       \
+                           auto_reconnect_time) {                             \
+                /** If still not connected, send new credentials */           \
+                MS_DBG(F("Sending credentials..."));                          \
+                for (uint8_t i = 0; i < 5; i++) {                             \
+                    if (gsmModem.networkConnect(_ssid, _pwd)) { break; }      \
+                }                                                             \
+                _connectStepStarted = millis();                               \
+                _connectState       = MODEM_CONNECT_ATTACHING;                \
+            }                                                                 \
+        }                                                                     \
+        return _connectState;                                                 \
+    }
+#endif  // #ifdef MS_MODEM_NONBLOCKING_CONNECT
+
 /**
  * @brief Creates a disconnectInternet() function for a specific modem subclass.
  *
@@ -453,6 +1012,50 @@
 #endif  // #if defined TINY_GSM_MODEM_HAS_GPRS
 
 
+#if defined(MS_MODEM_NETWORK_TIME) && defined(TINY_GSM_MODEM_HAS_NTP)
+/**
+ * @brief Sync the modem's clock with an NTP server over UDP if it hasn't been
+ * set by the network.
+ *
+ * The time zone is given as 0 so the clock is kept in UTC.
+ */
+#define MS_MODEM_SYNC_NTP                                               \
+    if (modemTime == 0 && isInternetAvailable()) {                      \
+        MS_DBG(F("Syncing the modem clock with pool.ntp.org"));         \
+        if (gsmModem.NTPServerSync("pool.ntp.org", 0) == 1 &&           \
+            gsmModem.getNetworkTime(&year, &month, &day, &hour, &minute, \
+                                    &second, &timezone)) {              \
+            modemTime = parseModemClock(year, month, day, hour, minute, \
+                                        second, timezone);              \
+        }                                                               \
+    }
+#else
+#define MS_MODEM_SYNC_NTP
+#endif
+
+#if defined(MS_MODEM_NETWORK_TIME) && defined(TINY_GSM_MODEM_HAS_TIME)
+/**
+ * @brief Take the time from the modem's clock, as set by the network or
+ * synced over SNTP, and return it if it's believable.
+ */
+#define MS_MODEM_GET_NETWORK_TIME                                            \
+    int      year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0; \
+    float    timezone  = 0;                                                  \
+    uint32_t modemTime = 0;                                                  \
+    if (gsmModem.getNetworkTime(&year, &month, &day, &hour, &minute,         \
+                                &second, &timezone)) {                       \
+        modemTime = parseModemClock(year, month, day, hour, minute, second,  \
+                                    timezone);                               \
+    }                                                                        \
+    MS_MODEM_SYNC_NTP                                                        \
+    if (modemTime != 0) {                                                    \
+        MS_DBG(F("Using the time from the modem clock"));                    \
+        return modemTime;                                                    \
+    }
+#else
+#define MS_MODEM_GET_NETWORK_TIME
+#endif
+
 /**
  * @brief Creates a getNISTTime() function for a specific modem subclass.
  *
@@ -461,6 +1064,9 @@
  * This would be much more efficient if done over UDP, but I'm doing it over TCP
  * because I don't have a UDP library for all the modems.
  *
+ * With #MS_MODEM_NETWORK_TIME the modem's network clock is read first, then
+ * synced over SNTP if the modem supports it, before falling back to NIST.
+ *
  * @note We eust ensure that we do not ping the daylight server more than once
  * every 4 seconds.  NIST clearly specifies here that this is a requirement for
  * all software that accesses its servers:
@@ -474,6 +1080,8 @@
  */
 #define MS_MODEM_GET_NIST_TIME(specificModem)                                 \
     uint32_t specificModem::getNISTTime(void) {                               \
+        MS_MODEM_GET_NETWORK_TIME                                             \
+                                                                              \
         /** Check for and bail if not connected to the internet. */           \
         if (!isInternetAvailable()) {                                         \
             MS_DBG(F("No internet connection, cannot connect to NIST."));     \
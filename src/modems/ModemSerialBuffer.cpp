@@ -0,0 +1,105 @@
+/**
+ * @file ModemSerialBuffer.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the ModemSerialBuffer class.
+ */
+
+#include "ModemSerialBuffer.h"
+
+#ifdef MS_MODEM_SERIAL_BUFFER
+
+#if defined(ARDUINO_ARCH_SAMD) && not defined(MS_MODEM_BUFFER_NO_SYSTICK)
+#define MS_MODEM_BUFFER_SYSTICK
+#endif
+
+ModemSerialBuffer* ModemSerialBuffer::_filledBuffer = nullptr;
+
+
+ModemSerialBuffer::ModemSerialBuffer(Stream* modemSerial)
+    : _serial(modemSerial) {
+    _filledBuffer = this;
+}
+ModemSerialBuffer::~ModemSerialBuffer() {
+    if (_filledBuffer == this) _filledBuffer = nullptr;
+}
+
+
+void ModemSerialBuffer::fill(void) {
+    while (_serial->available()) {
+        uint16_t next = (_head + 1) % MS_MODEM_RX_BUFFER_SIZE;
+        if (next == _tail) {
+            // Leave the rest on the port; it may still make room in time.
+            // Count each time the buffer fills up once, not every call
+            // until it's read.
+            if (!_full) _overflows++;
+            _full = true;
+            return;
+        }
+        _buffer[_head] = _serial->read();
+        _head          = next;
+    }
+}
+
+
+int ModemSerialBuffer::available() {
+#ifndef MS_MODEM_BUFFER_SYSTICK
+    fill();
+#endif
+    return (_head + MS_MODEM_RX_BUFFER_SIZE - _tail) % MS_MODEM_RX_BUFFER_SIZE;
+}
+
+
+int ModemSerialBuffer::read() {
+#ifndef MS_MODEM_BUFFER_SYSTICK
+    fill();
+#endif
+    if (_head == _tail) return -1;
+    uint8_t c = _buffer[_tail];
+    _tail     = (_tail + 1) % MS_MODEM_RX_BUFFER_SIZE;
+    _full     = false;
+    return c;
+}
+
+
+int ModemSerialBuffer::peek() {
+#ifndef MS_MODEM_BUFFER_SYSTICK
+    fill();
+#endif
+    if (_head == _tail) return -1;
+    return _buffer[_tail];
+}
+
+
+void ModemSerialBuffer::flush() {
+    _serial->flush();
+}
+
+
+size_t ModemSerialBuffer::write(uint8_t c) {
+    return _serial->write(c);
+}
+size_t ModemSerialBuffer::write(const uint8_t* buffer, size_t size) {
+    return _serial->write(buffer, size);
+}
+
+
+uint32_t ModemSerialBuffer::getOverflowCount(void) {
+    return _overflows;
+}
+
+
+#ifdef MS_MODEM_BUFFER_SYSTICK
+// Called by the SAMD core on every millisecond tick; returning 0 lets the
+// core go on with its own tick
+extern "C" int sysTickHook(void) {
+    if (ModemSerialBuffer::_filledBuffer != nullptr) {
+        ModemSerialBuffer::_filledBuffer->fill();
+    }
+    return 0;
+}
+#endif
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file ModemSerialBuffer.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the ModemSerialBuffer class, a large receive buffer in
+ * front of the serial port of a modem.
+ */
+
+// Header Guards
+#ifndef SRC_MODEMS_MODEMSERIALBUFFER_H_
+#define SRC_MODEMS_MODEMSERIALBUFFER_H_
+
+// Debugging Statement
+// #define MS_MODEMSERIALBUFFER_DEBUG
+
+#ifdef MS_MODEMSERIALBUFFER_DEBUG
+#define MS_DEBUGGING_STD "ModemSerialBuffer"
+#endif
+
+/**
+ * @def MS_MODEM_SERIAL_BUFFER
+ * @brief Define this build flag to make the ModemSerialBuffer class
+ * available, to give a modem a receive buffer larger than the serial port's.
+ *
+ * On SAMD boards the buffer is filled from the SysTick interrupt every
+ * millisecond, so the 64 byte buffer of the core's serial port is emptied
+ * well before it overflows at 115200 baud, even while the processor is busy
+ * elsewhere.  This takes the core's weak `sysTickHook()`; define
+ * MS_MODEM_BUFFER_NO_SYSTICK if the program needs that hook for something
+ * else.  Without the interrupt, the buffer is filled whenever it's read.
+ *
+ * @ingroup the_modems
+ */
+// #define MS_MODEM_SERIAL_BUFFER
+
+#ifndef MS_MODEM_RX_BUFFER_SIZE
+/**
+ * @brief The size in bytes of the receive buffer of a ModemSerialBuffer.
+ *
+ * @ingroup the_modems
+ */
+#define MS_MODEM_RX_BUFFER_SIZE 1024
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+
+
+/**
+ * @brief A ModemSerialBuffer is a stream that holds what comes in from a
+ * modem's serial port in a buffer of #MS_MODEM_RX_BUFFER_SIZE bytes, and sends
+ * straight through to the port.
+ *
+ * Give it to the modem constructor in place of the serial port:
+ * @code{cpp}
+ * ModemSerialBuffer modemBuffer(&Serial1);
+ * SIMComSIM7080 modem7080(&modemBuffer, modemVccPin, ...);
+ * @endcode
+ *
+ * Only one buffer is filled from the SysTick interrupt; it's the last one
+ * made.
+ *
+ * @ingroup the_modems
+ */
+class ModemSerialBuffer : public Stream {
+ public:
+    /**
+     * @brief Construct a new ModemSerialBuffer object.
+     *
+     * @param modemSerial The serial port of the modem
+     */
+    explicit ModemSerialBuffer(Stream* modemSerial);
+    /**
+     * @brief Destroy the ModemSerialBuffer object, stopping the interrupt from
+     * filling it.
+     */
+    virtual ~ModemSerialBuffer();
+
+    int    available() override;
+    int    read() override;
+    int    peek() override;
+    void   flush() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Move everything waiting on the serial port into the buffer.
+     *
+     * This is called from the SysTick interrupt on SAMD boards, and from
+     * available(), read(), and peek() otherwise.
+     */
+    void fill(void);
+    /**
+     * @brief Get the number of times the buffer filled up.
+     *
+     * While the buffer is full, new bytes are left on the serial port, where
+     * they may be lost if its own buffer overflows before there's room.
+     *
+     * @return **uint32_t** The number of times the buffer has filled since it
+     * was made.
+     */
+    uint32_t getOverflowCount(void);
+
+    /**
+     * @brief The buffer filled from the SysTick interrupt.
+     */
+    static ModemSerialBuffer* _filledBuffer;
+
+ private:
+    Stream*           _serial;
+    uint8_t           _buffer[MS_MODEM_RX_BUFFER_SIZE];
+    volatile uint16_t _head      = 0;
+    volatile uint16_t _tail      = 0;
+    volatile uint32_t _overflows = 0;
+    volatile bool     _full      = false;
+};
+
+#endif  // SRC_MODEMS_MODEMSERIALBUFFER_H_
@@ -28,6 +28,9 @@ QuectelBG96::QuectelBG96(Stream* modemStream, int8_t powerPin, int8_t statusPin,
       gsmModem(*modemStream),
 #endif
       gsmClient(gsmModem),
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+      gsmClientSecure(gsmModem, 1),
+#endif
       _apn(apn) {
 }
 
@@ -37,10 +40,22 @@ QuectelBG96::~QuectelBG96() {}
 MS_MODEM_EXTRA_SETUP(QuectelBG96);
 MS_IS_MODEM_AWAKE(QuectelBG96);
 MS_MODEM_WAKE(QuectelBG96);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(QuectelBG96);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(QuectelBG96);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(QuectelBG96);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(QuectelBG96);
 MS_MODEM_IS_INTERNET_AVAILABLE(QuectelBG96);
+#ifdef MS_MODEM_STAY_REGISTERED
+MS_MODEM_REQUEST_POWER_SAVING(QuectelBG96);
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+MS_MODEM_RELEASE_RADIO(QuectelBG96);
+#endif
 
 MS_MODEM_GET_NIST_TIME(QuectelBG96);
 
@@ -59,6 +74,10 @@ bool QuectelBG96::modemWakeFxn(void) {
         digitalWrite(_modemSleepRqPin, _wakeLevel);
         delay(_wakePulse_ms);  // ≥100ms
         digitalWrite(_modemSleepRqPin, !_wakeLevel);
+#ifdef MS_MODEM_STAY_REGISTERED
+        // There's no start-up message when waking from power saving mode
+        if (_powerSaving) { return true; }
+#endif
         return gsmModem.waitResponse(10000L, GF("RDY")) == 1;
     }
     return true;
@@ -81,3 +100,135 @@ bool QuectelBG96::modemHardReset(void) {
     if (success) { return gsmModem.waitResponse(10000L, GF("RDY")) == 1; }
     return false;
 }
+
+#ifdef MS_MODEM_NATIVE_HTTP
+bool QuectelBG96::httpBegin(const char* host, uint16_t port, const char* path,
+                            uint16_t bodyLength) {
+    _httpHost        = host;
+    _httpPath        = path;
+    _httpBodyLength  = bodyLength;
+    _httpHeaderCount = 0;
+
+    // The request line and headers are sent with the body, so the BG96 only
+    // needs the URL to connect to
+    MS_DBG(F("Setting the HTTP URL for"), host, F("on the BG96"));
+    gsmModem.sendAT(GF("+QHTTPCFG=\"contextid\",1"));
+    gsmModem.waitResponse();
+    gsmModem.sendAT(GF("+QHTTPCFG=\"requestheader\",1"));
+    if (gsmModem.waitResponse() != 1) { return false; }
+
+    char portText[6] = "";
+    itoa(port, portText, 10);
+    uint16_t urlLength = 7 + strlen(host) + 1 + strlen(portText) +
+        strlen(path);
+    gsmModem.sendAT(GF("+QHTTPURL="), urlLength, GF(",30"));
+    if (gsmModem.waitResponse(30000L, GF("CONNECT")) != 1) { return false; }
+    gsmModem.stream.print(F("http://"));
+    gsmModem.stream.print(host);
+    gsmModem.stream.print(':');
+    gsmModem.stream.print(portText);
+    gsmModem.stream.print(path);
+    return gsmModem.waitResponse(30000L) == 1;
+}
+
+bool QuectelBG96::httpAddHeader(const char* name, const char* value) {
+    if (_httpHeaderCount >= MS_BG96_HTTP_HEADERS) { return false; }
+    _httpHeaderNames[_httpHeaderCount]  = name;
+    _httpHeaderValues[_httpHeaderCount] = value;
+    _httpHeaderCount++;
+    return true;
+}
+
+Stream* QuectelBG96::httpStartBody(void) {
+    char lengthText[6] = "";
+    itoa(_httpBodyLength, lengthText, 10);
+
+    // Count the whole request: the request line and host, the headers, the
+    // content length, and the body
+    uint16_t requestLength = 5 + strlen(_httpPath) + 17 + strlen(_httpHost) +
+        2;
+    for (uint8_t i = 0; i < _httpHeaderCount; i++) {
+        requestLength += strlen(_httpHeaderNames[i]) + 2 +
+            strlen(_httpHeaderValues[i]) + 2;
+    }
+    requestLength += 16 + strlen(lengthText) + 4 + _httpBodyLength;
+
+    gsmModem.sendAT(GF("+QHTTPPOST="), requestLength, GF(",60,60"));
+    if (gsmModem.waitResponse(60000L, GF("CONNECT")) != 1) { return nullptr; }
+
+    Stream& out = gsmModem.stream;
+    out.print(F("POST "));
+    out.print(_httpPath);
+    out.print(F(" HTTP/1.1\r\nHost: "));
+    out.print(_httpHost);
+    out.print(F("\r\n"));
+    for (uint8_t i = 0; i < _httpHeaderCount; i++) {
+        out.print(_httpHeaderNames[i]);
+        out.print(F(": "));
+        out.print(_httpHeaderValues[i]);
+        out.print(F("\r\n"));
+    }
+    out.print(F("Content-Length: "));
+    out.print(lengthText);
+    out.print(F("\r\n\r\n"));
+    return &out;
+}
+
+int16_t QuectelBG96::httpFinish(void) {
+    int16_t status = 0;
+    // The response comes as +QHTTPPOST: <err>,<status>,<length>
+    if (gsmModem.waitResponse(60000L) == 1 &&
+        gsmModem.waitResponse(60000L, GF("+QHTTPPOST:")) == 1) {
+        int16_t err = gsmModem.stream.readStringUntil(',').toInt();
+        if (err == 0) {
+            status = gsmModem.stream.readStringUntil(',').toInt();
+        } else {
+            MS_DBG(F("BG96 HTTP error"), err);
+        }
+    }
+    return status;
+}
+#endif
+
+#ifdef MS_MODEM_NETWORK_SELECT
+bool QuectelBG96::applyRadioAccess(void) {
+    // Automatic with the GSM fallback, or LTE only; applied right away
+    gsmModem.sendAT(GF("+QCFG=\"nwscanmode\","),
+                    _radioAccess == RADIO_ACCESS_AUTO ? 0 : 3, GF(",1"));
+    bool success = gsmModem.waitResponse() == 1;
+    // Cat-M1, NB-IoT, or both
+    uint8_t mode = 2;
+    if (_radioAccess == RADIO_ACCESS_LTE_M) { mode = 0; }
+    if (_radioAccess == RADIO_ACCESS_NB_IOT) { mode = 1; }
+    gsmModem.sendAT(GF("+QCFG=\"iotopmode\","), mode, GF(",1"));
+    success &= gsmModem.waitResponse() == 1;
+    if (_bandLock != nullptr) {
+        gsmModem.sendAT(GF("+QCFG=\"band\","), _bandLock, GF(",1"));
+        success &= gsmModem.waitResponse() == 1;
+    }
+    return success;
+}
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool QuectelBG96::resolveHost(const char* host, IPAddress& address) {
+    // The lookup is answered after the OK, with a count line,
+    // +QIURC: "dnsgip",0,<count>,<ttl>, and then a line for each address,
+    // +QIURC: "dnsgip","<address>"
+    gsmModem.sendAT(GF("+QIDNSGIP=1,\""), host, '"');
+    if (gsmModem.waitResponse() != 1) { return false; }
+    if (gsmModem.waitResponse(60000L, GF("+QIURC: \"dnsgip\",")) != 1) {
+        return false;
+    }
+    if (gsmModem.stream.readStringUntil(',').toInt() != 0) { return false; }
+    if (gsmModem.waitResponse(5000L, GF("+QIURC: \"dnsgip\",")) != 1) {
+        return false;
+    }
+    return addressFromLine(gsmModem.stream.readStringUntil('\n'), address);
+}
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+bool QuectelBG96::isSecureClient(Client* client) {
+    return client == &gsmClientSecure;
+}
+#endif
+#endif
@@ -149,6 +149,12 @@
  */
 #define BG96_DISCONNECT_TIME_MS 5000L
 
+/**
+ * @brief The most headers the BG96 keeps for a post through its HTTP client
+ * (#MS_MODEM_NATIVE_HTTP).
+ */
+#define MS_BG96_HTTP_HEADERS 4
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
@@ -194,16 +200,35 @@ class QuectelBG96 : public loggerModem {
     ~QuectelBG96();
 
     bool modemWake(void) override;
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    bool negotiateBaud(void) override;
+#endif
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
+#ifdef MS_MODEM_NATIVE_HTTP
+    bool    httpBegin(const char* host, uint16_t port, const char* path,
+                      uint16_t bodyLength) override;
+    bool    httpAddHeader(const char* name, const char* value) override;
+    Stream* httpStartBody(void) override;
+    int16_t httpFinish(void) override;
+#endif
 
     bool  getModemSignalQuality(int16_t& rssi, int16_t& percent) override;
     bool  getModemBatteryStats(uint8_t& chargeState, int8_t& percent,
                                uint16_t& milliVolts) override;
     float getModemChipTemperature(void) override;
+#ifdef MS_PUBLISHER_DNS_CACHE
+    bool resolveHost(const char* host, IPAddress& address) override;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    bool isSecureClient(Client* client) override;
+#endif
+#endif
 
     bool modemHardReset(void) override;
 
@@ -219,6 +244,12 @@ class QuectelBG96 : public loggerModem {
      * @brief Public reference to the TinyGSM Client.
      */
     TinyGsmClient gsmClient;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    /**
+     * @brief Public reference to the TinyGSM secure (TLS) client, on socket 1.
+     */
+    TinyGsmClientSecure gsmClientSecure;
+#endif
 
  protected:
     bool isInternetAvailable(void) override;
@@ -226,9 +257,33 @@ class QuectelBG96 : public loggerModem {
     bool modemWakeFxn(void) override;
     bool extraModemSetup(void) override;
     bool isModemAwake(void) override;
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @copydoc loggerModem::applyRadioAccess()
+     *
+     * The band lock is the GSM, Cat-M1, and NB-IoT band masks for
+     * `AT+QCFG="band"`, ie, "F,80084,80084".  Locking to either LTE
+     * technology also turns off the GSM fallback.
+     */
+    bool applyRadioAccess(void) override;
+#endif
+#ifdef MS_MODEM_STAY_REGISTERED
+    bool requestPowerSaving(void) override;
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+    bool releaseRadio(void) override;
+#endif
 
  private:
     const char* _apn;
+#ifdef MS_MODEM_NATIVE_HTTP
+    const char* _httpHost       = nullptr;
+    const char* _httpPath       = nullptr;
+    uint16_t    _httpBodyLength = 0;
+    const char* _httpHeaderNames[MS_BG96_HTTP_HEADERS];
+    const char* _httpHeaderValues[MS_BG96_HTTP_HEADERS];
+    uint8_t     _httpHeaderCount = 0;
+#endif
 };
 /**@}*/
 #endif  // SRC_MODEMS_QUECTELBG96_H_
@@ -28,6 +28,9 @@ SIMComSIM7000::SIMComSIM7000(Stream* modemStream, int8_t powerPin,
       gsmModem(*modemStream),
 #endif
       gsmClient(gsmModem),
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+      gsmClientSecure(gsmModem, 1),
+#endif
       _apn(apn) {
 }
 
@@ -37,10 +40,22 @@ SIMComSIM7000::~SIMComSIM7000() {}
 MS_MODEM_EXTRA_SETUP(SIMComSIM7000);
 MS_IS_MODEM_AWAKE(SIMComSIM7000);
 MS_MODEM_WAKE(SIMComSIM7000);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(SIMComSIM7000);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(SIMComSIM7000);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(SIMComSIM7000);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(SIMComSIM7000);
 MS_MODEM_IS_INTERNET_AVAILABLE(SIMComSIM7000);
+#ifdef MS_MODEM_STAY_REGISTERED
+MS_MODEM_REQUEST_POWER_SAVING(SIMComSIM7000);
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+MS_MODEM_RELEASE_RADIO(SIMComSIM7000);
+#endif
 
 MS_MODEM_GET_NIST_TIME(SIMComSIM7000);
 
@@ -75,3 +90,43 @@ bool SIMComSIM7000::modemSleepFxn(void) {
         return true;
     }
 }
+
+#ifdef MS_MODEM_NETWORK_SELECT
+bool SIMComSIM7000::applyRadioAccess(void) {
+    // Automatic with the GSM fallback, or LTE only
+    gsmModem.sendAT(GF("+CNMP="), _radioAccess == RADIO_ACCESS_AUTO ? 2 : 38);
+    bool success = gsmModem.waitResponse() == 1;
+    // Cat-M1, NB-IoT, or both
+    uint8_t mode = 3;
+    if (_radioAccess == RADIO_ACCESS_LTE_M) { mode = 1; }
+    if (_radioAccess == RADIO_ACCESS_NB_IOT) { mode = 2; }
+    gsmModem.sendAT(GF("+CMNB="), mode);
+    success &= gsmModem.waitResponse() == 1;
+    if (_bandLock != nullptr) {
+        gsmModem.sendAT(GF("+CBANDCFG=\""),
+                        _radioAccess == RADIO_ACCESS_NB_IOT ? GF("NB-IOT")
+                                                            : GF("CAT-M"),
+                        GF("\","), _bandLock);
+        success &= gsmModem.waitResponse() == 1;
+    }
+    return success;
+}
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool SIMComSIM7000::resolveHost(const char* host, IPAddress& address) {
+    // The lookup is answered after the OK, with
+    // +CDNSGIP: 1,"<host>","<address>"
+    gsmModem.sendAT(GF("+CDNSGIP=\""), host, '"');
+    if (gsmModem.waitResponse() != 1) { return false; }
+    if (gsmModem.waitResponse(15000L, GF("+CDNSGIP: 1,")) != 1) {
+        return false;
+    }
+    return addressFromLine(gsmModem.stream.readStringUntil('\n'), address);
+}
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+bool SIMComSIM7000::isSecureClient(Client* client) {
+    return client == &gsmClientSecure;
+}
+#endif
+#endif
@@ -62,10 +62,18 @@
 /** @ingroup modem_sim7000 */
 /**@{*/
 
+#ifdef MS_MODEM_SECURE_CLIENT
+/**
+ * @brief The modem type for the underlying TinyGSM library; the SSL driver
+ * with #MS_MODEM_SECURE_CLIENT.
+ */
+#define TINY_GSM_MODEM_SIM7000SSL
+#else
 /**
  * @brief The modem type for the underlying TinyGSM library.
  */
 #define TINY_GSM_MODEM_SIM7000
+#endif
 #ifndef TINY_GSM_RX_BUFFER
 /**
  * @brief The size of the buffer for incoming data.
@@ -185,9 +193,15 @@ class SIMComSIM7000 : public loggerModem {
     ~SIMComSIM7000();
 
     bool modemWake(void) override;
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    bool negotiateBaud(void) override;
+#endif
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
 
@@ -195,6 +209,12 @@ class SIMComSIM7000 : public loggerModem {
     bool  getModemBatteryStats(uint8_t& chargeState, int8_t& percent,
                                uint16_t& milliVolts) override;
     float getModemChipTemperature(void) override;
+#ifdef MS_PUBLISHER_DNS_CACHE
+    bool resolveHost(const char* host, IPAddress& address) override;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    bool isSecureClient(Client* client) override;
+#endif
+#endif
 
 #ifdef MS_SIMCOMSIM7000_DEBUG_DEEP
     StreamDebugger _modemATDebugger;
@@ -208,6 +228,12 @@ class SIMComSIM7000 : public loggerModem {
      * @brief Public reference to the TinyGSM Client.
      */
     TinyGsmClient gsmClient;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    /**
+     * @brief Public reference to the TinyGSM secure (TLS) client, on socket 1.
+     */
+    TinyGsmClientSecure gsmClientSecure;
+#endif
 
  protected:
     bool isInternetAvailable(void) override;
@@ -215,6 +241,22 @@ class SIMComSIM7000 : public loggerModem {
     bool modemWakeFxn(void) override;
     bool extraModemSetup(void) override;
     bool isModemAwake(void) override;
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @copydoc loggerModem::applyRadioAccess()
+     *
+     * The band lock is the bands for `AT+CBANDCFG`, ie, "2,4,12,13"; they're
+     * set for NB-IoT when the modem is locked to it, otherwise for Cat-M.
+     * Locking to either also turns off the GSM fallback.
+     */
+    bool applyRadioAccess(void) override;
+#endif
+#ifdef MS_MODEM_STAY_REGISTERED
+    bool requestPowerSaving(void) override;
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+    bool releaseRadio(void) override;
+#endif
 
  private:
     const char* _apn;
@@ -28,6 +28,9 @@ SIMComSIM7080::SIMComSIM7080(Stream* modemStream, int8_t powerPin,
       gsmModem(*modemStream),
 #endif
       gsmClient(gsmModem),
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+      gsmClientSecure(gsmModem, 1),
+#endif
       _apn(apn) {
 }
 
@@ -37,10 +40,22 @@ SIMComSIM7080::~SIMComSIM7080() {}
 MS_MODEM_EXTRA_SETUP(SIMComSIM7080);
 MS_IS_MODEM_AWAKE(SIMComSIM7080);
 MS_MODEM_WAKE(SIMComSIM7080);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(SIMComSIM7080);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(SIMComSIM7080);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(SIMComSIM7080);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(SIMComSIM7080);
 MS_MODEM_IS_INTERNET_AVAILABLE(SIMComSIM7080);
+#ifdef MS_MODEM_STAY_REGISTERED
+MS_MODEM_REQUEST_POWER_SAVING(SIMComSIM7080);
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+MS_MODEM_RELEASE_RADIO(SIMComSIM7080);
+#endif
 
 MS_MODEM_GET_NIST_TIME(SIMComSIM7080);
 
@@ -59,6 +74,10 @@ bool SIMComSIM7080::modemWakeFxn(void) {
         digitalWrite(_modemSleepRqPin, _wakeLevel);
         delay(_wakePulse_ms);  // >1s
         digitalWrite(_modemSleepRqPin, !_wakeLevel);
+#ifdef MS_MODEM_STAY_REGISTERED
+        // There's no start-up message when waking from power saving mode
+        if (_powerSaving) { return true; }
+#endif
         int ready_response = gsmModem.waitResponse(30000L, GF("SMS Ready"),
                                                    GF("+CPIN: NOT INSERTED"));
         if (ready_response == 1) {
@@ -87,3 +106,100 @@ bool SIMComSIM7080::modemSleepFxn(void) {
         return true;
     }
 }
+
+#ifdef MS_MODEM_NATIVE_HTTP
+bool SIMComSIM7080::httpBegin(const char* host, uint16_t port,
+                              const char* path, uint16_t bodyLength) {
+    // The SIM7080's HTTP client takes a body of up to 4096 bytes
+    if (bodyLength > 4096) { return false; }
+    _httpPath       = path;
+    _httpBodyLength = bodyLength;
+
+    MS_DBG(F("Opening an HTTP connection to"), host, F("from the SIM7080"));
+    gsmModem.sendAT(GF("+SHCONF=\"URL\",\"http://"), host, ':', port, '"');
+    if (gsmModem.waitResponse() != 1) { return false; }
+    gsmModem.sendAT(GF("+SHCONF=\"BODYLEN\","), bodyLength);
+    gsmModem.waitResponse();
+    gsmModem.sendAT(GF("+SHCONF=\"HEADERLEN\",350"));
+    gsmModem.waitResponse();
+    gsmModem.sendAT(GF("+SHCONN"));
+    if (gsmModem.waitResponse(30000L) != 1) {
+        MS_DBG(F("The SIM7080 couldn't open the HTTP connection"));
+        return false;
+    }
+    // Clear any headers left from the last post
+    gsmModem.sendAT(GF("+SHCHEAD"));
+    gsmModem.waitResponse();
+    return true;
+}
+
+bool SIMComSIM7080::httpAddHeader(const char* name, const char* value) {
+    gsmModem.sendAT(GF("+SHAHEAD=\""), name, GF("\",\""), value, '"');
+    return gsmModem.waitResponse() == 1;
+}
+
+Stream* SIMComSIM7080::httpStartBody(void) {
+    // The modem asks for the body with a prompt and then the set number of
+    // bytes is sent
+    gsmModem.sendAT(GF("+SHBOD="), _httpBodyLength, GF(",10000"));
+    if (gsmModem.waitResponse(GF(">")) != 1) {
+        gsmModem.sendAT(GF("+SHDISC"));
+        gsmModem.waitResponse();
+        return nullptr;
+    }
+    return &gsmModem.stream;
+}
+
+int16_t SIMComSIM7080::httpFinish(void) {
+    int16_t status = 0;
+    if (gsmModem.waitResponse(10000L) == 1) {
+        // The response comes as +SHREQ: "POST",<status>,<length>
+        gsmModem.sendAT(GF("+SHREQ=\""), _httpPath, GF("\",3"));
+        if (gsmModem.waitResponse() == 1 &&
+            gsmModem.waitResponse(60000L, GF("+SHREQ:")) == 1) {
+            gsmModem.stream.readStringUntil(',');
+            status = gsmModem.stream.readStringUntil(',').toInt();
+        }
+    }
+    gsmModem.sendAT(GF("+SHDISC"));
+    gsmModem.waitResponse();
+    return status;
+}
+#endif
+
+#ifdef MS_MODEM_NETWORK_SELECT
+bool SIMComSIM7080::applyRadioAccess(void) {
+    // Cat-M1, NB-IoT, or both
+    uint8_t mode = 3;
+    if (_radioAccess == RADIO_ACCESS_LTE_M) { mode = 1; }
+    if (_radioAccess == RADIO_ACCESS_NB_IOT) { mode = 2; }
+    gsmModem.sendAT(GF("+CMNB="), mode);
+    bool success = gsmModem.waitResponse() == 1;
+    if (_bandLock != nullptr) {
+        gsmModem.sendAT(GF("+CBANDCFG=\""),
+                        _radioAccess == RADIO_ACCESS_NB_IOT ? GF("NB-IOT")
+                                                            : GF("CAT-M"),
+                        GF("\","), _bandLock);
+        success &= gsmModem.waitResponse() == 1;
+    }
+    return success;
+}
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool SIMComSIM7080::resolveHost(const char* host, IPAddress& address) {
+    // The lookup is answered after the OK, with
+    // +CDNSGIP: 1,"<host>","<address>"
+    gsmModem.sendAT(GF("+CDNSGIP=\""), host, GF("\",1,10000"));
+    if (gsmModem.waitResponse() != 1) { return false; }
+    if (gsmModem.waitResponse(15000L, GF("+CDNSGIP: 1,")) != 1) {
+        return false;
+    }
+    return addressFromLine(gsmModem.stream.readStringUntil('\n'), address);
+}
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+bool SIMComSIM7080::isSecureClient(Client* client) {
+    return client == &gsmClientSecure;
+}
+#endif
+#endif
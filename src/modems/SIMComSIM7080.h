@@ -180,16 +180,35 @@ class SIMComSIM7080 : public loggerModem {
     ~SIMComSIM7080();
 
     bool modemWake(void) override;
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    bool negotiateBaud(void) override;
+#endif
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
+#ifdef MS_MODEM_NATIVE_HTTP
+    bool    httpBegin(const char* host, uint16_t port, const char* path,
+                      uint16_t bodyLength) override;
+    bool    httpAddHeader(const char* name, const char* value) override;
+    Stream* httpStartBody(void) override;
+    int16_t httpFinish(void) override;
+#endif
 
     bool  getModemSignalQuality(int16_t& rssi, int16_t& percent) override;
     bool  getModemBatteryStats(uint8_t& chargeState, int8_t& percent,
                                uint16_t& milliVolts) override;
     float getModemChipTemperature(void) override;
+#ifdef MS_PUBLISHER_DNS_CACHE
+    bool resolveHost(const char* host, IPAddress& address) override;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    bool isSecureClient(Client* client) override;
+#endif
+#endif
 
 #ifdef MS_SIMCOMSIM7080_DEBUG_DEEP
     StreamDebugger _modemATDebugger;
@@ -203,6 +222,12 @@ class SIMComSIM7080 : public loggerModem {
      * @brief Public reference to the TinyGSM Client.
      */
     TinyGsmClient gsmClient;
+#if defined(MS_MODEM_SECURE_CLIENT) && defined(TINY_GSM_MODEM_HAS_SSL)
+    /**
+     * @brief Public reference to the TinyGSM secure (TLS) client, on socket 1.
+     */
+    TinyGsmClientSecure gsmClientSecure;
+#endif
 
  protected:
     bool isInternetAvailable(void) override;
@@ -210,9 +235,28 @@ class SIMComSIM7080 : public loggerModem {
     bool modemWakeFxn(void) override;
     bool extraModemSetup(void) override;
     bool isModemAwake(void) override;
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @copydoc loggerModem::applyRadioAccess()
+     *
+     * The band lock is the bands for `AT+CBANDCFG`, ie, "2,4,12,13"; they're
+     * set for NB-IoT when the modem is locked to it, otherwise for Cat-M.
+     */
+    bool applyRadioAccess(void) override;
+#endif
+#ifdef MS_MODEM_STAY_REGISTERED
+    bool requestPowerSaving(void) override;
+#endif
+#ifdef MS_MODEM_RELEASE_ASSIST
+    bool releaseRadio(void) override;
+#endif
 
  private:
     const char* _apn;
+#ifdef MS_MODEM_NATIVE_HTTP
+    const char* _httpPath       = nullptr;
+    uint16_t    _httpBodyLength = 0;
+#endif
 };
 /**@}*/
 #endif  // SRC_MODEMS_SIMCOMSIM7080_H_
@@ -37,8 +37,14 @@ SIMComSIM800::~SIMComSIM800() {}
 MS_MODEM_EXTRA_SETUP(SIMComSIM800);
 MS_IS_MODEM_AWAKE(SIMComSIM800);
 MS_MODEM_WAKE(SIMComSIM800);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(SIMComSIM800);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(SIMComSIM800);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(SIMComSIM800);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(SIMComSIM800);
 MS_MODEM_IS_INTERNET_AVAILABLE(SIMComSIM800);
 
@@ -187,9 +187,15 @@ class SIMComSIM800 : public loggerModem {
     ~SIMComSIM800();
 
     bool modemWake(void) override;
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    bool negotiateBaud(void) override;
+#endif
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
 
@@ -36,8 +36,14 @@ SequansMonarch::~SequansMonarch() {}
 
 MS_IS_MODEM_AWAKE(SequansMonarch);
 MS_MODEM_WAKE(SequansMonarch);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(SequansMonarch);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(SequansMonarch);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(SequansMonarch);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(SequansMonarch);
 MS_MODEM_IS_INTERNET_AVAILABLE(SequansMonarch);
 
@@ -125,10 +131,20 @@ bool SequansMonarch::extraModemSetup(void) {
     if (!(_powerPin >= 0) && !(_modemResetPin >= 0) && _modemSleepRqPin >= 0) {
         MS_DBG(
             "Enabling power save mode tracking area update [PSM TAU] timers");
+#ifdef MS_MODEM_PSM_SCHEDULE
+        if (_psmTAUBits[0] != '\0') {
+            // Timers worked out from the logger's publish interval
+            gsmModem.sendAT(GF("+CPSMS=1,,,\""), _psmTAUBits, GF("\",\""),
+                            _psmActiveBits, '"');
+        } else {
+            gsmModem.sendAT(GF("+CPSMS=1,,,\"10100001\",\"00000101\""));
+        }
+#else
         // Requested Periodic TAU (Time in between Tracking Area Updates) = 101
         // 00001 = 5min increments * 1 Requested Active Time (Time connected
         // before entering Power Save Mode) = 000 00101 = 2s increments * 5
         gsmModem.sendAT(GF("+CPSMS=1,,,\"10100001\",\"00000101\""));
+#endif
         success &= static_cast<bool>(gsmModem.waitResponse());
     }
     // If we are going to turn power it on and off or use the reset, turn on
@@ -57,8 +57,14 @@ SodaqUBeeR410M::~SodaqUBeeR410M() {}
 
 MS_IS_MODEM_AWAKE(SodaqUBeeR410M);
 MS_MODEM_WAKE(SodaqUBeeR410M);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(SodaqUBeeR410M);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(SodaqUBeeR410M);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(SodaqUBeeR410M);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(SodaqUBeeR410M);
 MS_MODEM_IS_INTERNET_AVAILABLE(SodaqUBeeR410M);
 
@@ -121,6 +127,10 @@ bool SodaqUBeeR410M::modemWakeFxn(void) {
             gsmModem.setBaud(9600);
             _modemSerial->end();
             _modemSerial->begin(9600);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+            // Any rate asked for before was lost with the power
+            _currentBaud = 9600;
+#endif
             gsmModem.sendAT(GF("E0"));
             gsmModem.waitResponse();
         }
@@ -163,6 +173,10 @@ bool SodaqUBeeR410M::modemHardReset(void) {
         gsmModem.setBaud(9600);
         _modemSerial->end();
         _modemSerial->begin(9600);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+        // Any rate asked for before was lost with the reset
+        _currentBaud = 9600;
+#endif
         gsmModem.sendAT(GF("E0"));
         gsmModem.waitResponse();
 #endif
@@ -183,3 +197,36 @@ bool SodaqUBeeR410M::extraModemSetup(void) {
     gsmModem.waitResponse();
     return success;
 }
+
+#ifdef MS_MODEM_NETWORK_SELECT
+bool SodaqUBeeR410M::applyRadioAccess(void) {
+    // The radio settings can only be changed while deregistered
+    gsmModem.sendAT(GF("+COPS=2"));
+    gsmModem.waitResponse(30000L);
+    gsmModem.sendAT(GF("+URAT="), _radioAccess == RADIO_ACCESS_NB_IOT
+                                      ? GF("8")
+                                      : (_radioAccess == RADIO_ACCESS_LTE_M
+                                             ? GF("7")
+                                             : GF("7,8")));
+    bool success = gsmModem.waitResponse() == 1;
+    if (_bandLock != nullptr) {
+        gsmModem.sendAT(GF("+UBANDMASK="), _bandLock);
+        success &= gsmModem.waitResponse() == 1;
+    }
+    gsmModem.sendAT(GF("+COPS=0"));
+    gsmModem.waitResponse(30000L);
+    return success;
+}
+#endif
+
+#ifdef MS_PUBLISHER_DNS_CACHE
+bool SodaqUBeeR410M::resolveHost(const char* host, IPAddress& address) {
+    // The answer is +UDNSRN: "<address>"
+    gsmModem.sendAT(GF("+UDNSRN=0,\""), host, '"');
+    if (gsmModem.waitResponse(70000L, GF("+UDNSRN:")) != 1) { return false; }
+    bool found = addressFromLine(gsmModem.stream.readStringUntil('\n'),
+                                 address);
+    gsmModem.waitResponse();
+    return found;
+}
+#endif
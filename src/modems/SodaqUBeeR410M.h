@@ -296,9 +296,15 @@ class SodaqUBeeR410M : public loggerModem {
     ~SodaqUBeeR410M();
 
     bool modemWake(void) override;
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+    bool negotiateBaud(void) override;
+#endif
 
     bool connectInternet(uint32_t maxConnectionTime = 50000L) override;
     void disconnectInternet(void) override;
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+    modemConnectState pollConnect(void) override;
+#endif
 
     uint32_t getNISTTime(void) override;
 
@@ -306,6 +312,9 @@ class SodaqUBeeR410M : public loggerModem {
     bool  getModemBatteryStats(uint8_t& chargeState, int8_t& percent,
                                uint16_t& milliVolts) override;
     float getModemChipTemperature(void) override;
+#ifdef MS_PUBLISHER_DNS_CACHE
+    bool resolveHost(const char* host, IPAddress& address) override;
+#endif
 
     bool modemHardReset(void) override;
 
@@ -336,6 +345,16 @@ class SodaqUBeeR410M : public loggerModem {
     bool modemWakeFxn(void) override;
     bool extraModemSetup(void) override;
     bool isModemAwake(void) override;
+#ifdef MS_MODEM_NETWORK_SELECT
+    /**
+     * @copydoc loggerModem::applyRadioAccess()
+     *
+     * The band lock is the arguments of `AT+UBANDMASK`, ie, "0,6170" for
+     * Cat-M1 bands 2, 4, 5, 12, and 13.  The R410M only uses the new settings
+     * after it's next powered up.
+     */
+    bool applyRadioAccess(void) override;
+#endif
 
  private:
     const char* _apn;
@@ -36,8 +36,14 @@ SodaqUBeeU201::~SodaqUBeeU201() {}
 
 MS_IS_MODEM_AWAKE(SodaqUBeeU201);
 MS_MODEM_WAKE(SodaqUBeeU201);
+#ifdef MS_MODEM_BAUD_NEGOTIATION
+MS_MODEM_NEGOTIATE_BAUD(SodaqUBeeU201);
+#endif
 
 MS_MODEM_CONNECT_INTERNET(SodaqUBeeU201);
+#ifdef MS_MODEM_NONBLOCKING_CONNECT
+MS_MODEM_POLL_CONNECT(SodaqUBeeU201);
+#endif
 MS_MODEM_DISCONNECT_INTERNET(SodaqUBeeU201);
 MS_MODEM_IS_INTERNET_AVAILABLE(SodaqUBeeU201);
 
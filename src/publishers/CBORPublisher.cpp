@@ -0,0 +1,214 @@
+/**
+ * @file CBORPublisher.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the CBORPublisher class.
+ */
+
+#include "CBORPublisher.h"
+
+
+// ============================================================================
+//  Functions for a receiver accepting CBOR
+// ============================================================================
+
+// Constant values for post requests
+const char* CBORPublisher::contentLengthHeader = "\r\nContent-Length: ";
+const char* CBORPublisher::contentTypeHeader =
+    "\r\nContent-Type: application/cbor\r\n\r\n";
+
+
+// Constructors
+CBORPublisher::CBORPublisher() : dataPublisher() {}
+CBORPublisher::CBORPublisher(Logger& baseLogger, int sendEveryX)
+    : dataPublisher(baseLogger, sendEveryX) {}
+CBORPublisher::CBORPublisher(Logger& baseLogger, Client* inClient,
+                             int sendEveryX)
+    : dataPublisher(baseLogger, inClient, sendEveryX) {}
+CBORPublisher::CBORPublisher(Logger& baseLogger, Client* inClient,
+                             const char* host, const char* path,
+                             uint16_t port, int sendEveryX)
+    : dataPublisher(baseLogger, inClient, sendEveryX) {
+    setReceiver(host, path, port);
+}
+// Destructor
+CBORPublisher::~CBORPublisher() {}
+
+
+void CBORPublisher::setReceiver(const char* host, const char* path,
+                                uint16_t port) {
+    _host = host;
+    _path = path;
+    _port = port;
+}
+
+
+// A way to begin with everything already set
+void CBORPublisher::begin(Logger& baseLogger, Client* inClient,
+                          const char* host, const char* path, uint16_t port) {
+    setReceiver(host, path, port);
+    dataPublisher::begin(baseLogger, inClient);
+}
+void CBORPublisher::begin(Logger& baseLogger, const char* host,
+                          const char* path, uint16_t port) {
+    setReceiver(host, path, port);
+    dataPublisher::begin(baseLogger);
+}
+
+
+// This is the number of outbox records being sent, or the one current record
+uint8_t CBORPublisher::recordCount(void) {
+#ifdef MS_PUBLISHER_OUTBOX
+    uint8_t records = _baseLogger->getReplayRecordCount();
+    if (records > 1) { return records; }
+#endif
+    return 1;
+}
+
+
+// This is the number of variables in the map of values
+uint8_t CBORPublisher::includedCount(void) {
+    uint8_t count = viewSize();
+#ifdef MS_PUBLISH_ON_CHANGE
+    count = 0;
+    for (uint8_t slot = 0; slot < viewSize(); slot++) {
+        if (_baseLogger->isChangedAtI(viewPosition(slot))) { count++; }
+    }
+#endif
+    return count;
+}
+
+
+// Calculates how long the CBOR will be
+uint16_t CBORPublisher::calculateCBORSize() {
+    uint8_t  records  = recordCount();
+    uint8_t  varCount = viewSize();
+    uint16_t cborLength = 1;  // map of 3
+    cborLength += 3;          // "sf"
+    cborLength += cborUUIDSize(_baseLogger->getSamplingFeatureUUID());
+    cborLength += 2;  // "t"
+    if (records == 1) {
+        cborLength += cborHeadSize(Logger::markedUTCEpochTime);
+    } else {
+#ifdef MS_PUBLISHER_OUTBOX
+        cborLength += cborHeadSize(records);
+        for (uint8_t j = 0; j < records; j++) {
+            _baseLogger->loadReplayRecord(j);
+            cborLength += cborHeadSize(Logger::markedUTCEpochTime);
+        }
+#endif
+    }
+    cborLength += 2;  // "v"
+    cborLength += cborHeadSize(includedCount());
+    for (uint8_t slot = 0; slot < varCount; slot++) {
+        uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+        if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+        cborLength += cborUUIDSize(_baseLogger->getVarUUIDCharsAtI(i));
+        if (records != 1) { cborLength += cborHeadSize(records); }
+        cborLength += 5 * records;  // float32 values
+    }
+    return cborLength;
+}
+
+
+// This writes the map of the sampling feature, times, and values
+void CBORPublisher::txBufferAppendCBORBody(void) {
+    uint8_t records  = recordCount();
+    uint8_t varCount = viewSize();
+
+    txBufferAppendCBORHead(5, 3);
+    txBufferAppendCBORText("sf");
+    txBufferAppendCBORUUID(_baseLogger->getSamplingFeatureUUID());
+    txBufferAppendCBORText("t");
+    if (records == 1) {
+        txBufferAppendCBORHead(0, Logger::markedUTCEpochTime);
+    } else {
+#ifdef MS_PUBLISHER_OUTBOX
+        txBufferAppendCBORHead(4, records);
+        for (uint8_t j = 0; j < records; j++) {
+            _baseLogger->loadReplayRecord(j);
+            txBufferAppendCBORHead(0, Logger::markedUTCEpochTime);
+        }
+#endif
+    }
+    txBufferAppendCBORText("v");
+    txBufferAppendCBORHead(5, includedCount());
+    for (uint8_t slot = 0; slot < varCount; slot++) {
+        uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+        // Leave out the variables that haven't changed
+        if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+        txBufferAppendCBORUUID(_baseLogger->getVarUUIDCharsAtI(i));
+        if (records == 1) {
+            txBufferAppendCBORFloat(_baseLogger->getRecordValueAtI(i));
+        } else {
+#ifdef MS_PUBLISHER_OUTBOX
+            txBufferAppendCBORHead(4, records);
+            for (uint8_t j = 0; j < records; j++) {
+                _baseLogger->loadReplayRecord(j);
+                txBufferAppendCBORFloat(_baseLogger->getRecordValueAtI(i));
+            }
+#endif
+        }
+    }
+}
+
+
+// Post the data as CBOR
+int16_t CBORPublisher::publishData(Client* outClient) {
+    return finishResponse(outClient, startRequest(outClient));
+}
+
+
+// This opens the connection and sends the whole request, leaving the response
+// to be read by finishResponse()
+bool CBORPublisher::startRequest(Client* outClient) {
+    // Create a buffer for the portions of the request
+    char tempBuffer[12] = "";
+
+    if (_host == nullptr) {
+        PRINTOUT(F("\n -- No receiver set for the CBOR publisher --"));
+        return false;
+    }
+
+    uint16_t cborSize = calculateCBORSize();
+    MS_DBG(F("Outgoing CBOR size:"), cborSize);
+
+    // Open a TCP/IP connection to the receiver
+    MS_DBG(F("Connecting client"));
+    MS_START_DEBUG_TIMER;
+    if (connectClient(outClient, _host, _port)) {
+        MS_DBG(F("Client connected after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+        txBufferInit(outClient);
+
+        // copy the initial post header into the tx buffer
+        txBufferAppend(postHeader);
+        txBufferAppend(_path);
+
+        // add the rest of the HTTP POST headers to the outgoing buffer
+        txBufferAppend_P(HTTPHostTag);
+        txBufferAppend(_host);
+
+        txBufferAppend(contentLengthHeader);
+        itoa(cborSize, tempBuffer, 10);  // BASE 10
+        txBufferAppend(tempBuffer);
+
+        txBufferAppend(contentTypeHeader);
+
+        // the CBOR map with the sampling feature, times, and values
+        txBufferAppendCBORBody();
+
+        // Write out the complete request
+        txBufferFlush();
+
+        return true;
+    } else {
+        PRINTOUT(F("\n -- Unable to Establish Connection to"), _host, F("--"));
+    }
+    return false;
+}
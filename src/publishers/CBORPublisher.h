@@ -0,0 +1,209 @@
+/**
+ * @file CBORPublisher.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the CBORPublisher subclass of dataPublisher for posting
+ * data to a receiver of your own as compact CBOR instead of JSON.
+ */
+
+// Header Guards
+#ifndef SRC_PUBLISHERS_CBORPUBLISHER_H_
+#define SRC_PUBLISHERS_CBORPUBLISHER_H_
+
+// Debugging Statement
+// #define MS_CBORPUBLISHER_DEBUG
+
+#ifdef MS_CBORPUBLISHER_DEBUG
+#define MS_DEBUGGING_STD "CBORPublisher"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "dataPublisherBase.h"
+
+
+// ============================================================================
+//  Functions for a receiver accepting CBOR
+// ============================================================================
+/**
+ * @brief The CBORPublisher subclass of dataPublisher posts each record to a
+ * receiver of your own as CBOR (RFC 8949) instead of JSON.
+ *
+ * The body of the post is a map with three keys:
+ * - "sf" - the sampling feature UUID
+ * - "t" - the UTC Unix time of the record
+ * - "v" - a map from each variable UUID to its value
+ *
+ * UUIDs are sent as 16 byte binary strings and values as single precision
+ * floats, taking about a fifth of the bytes of the EnviroDIY JSON.  With
+ * #MS_PUBLISHER_OUTBOX several records are sent in one post with an array of
+ * times under "t" and an array of values for each variable.
+ *
+ * @ingroup the_publishers
+ */
+class CBORPublisher : public dataPublisher {
+ public:
+    // Constructors
+    /**
+     * @brief Construct a new CBOR Publisher object with no members set.
+     */
+    CBORPublisher();
+    /**
+     * @brief Construct a new CBOR Publisher object
+     *
+     * @note If a client is never specified, the publisher will attempt to
+     * create and use a client on a LoggerModem instance tied to the attached
+     * logger.
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    explicit CBORPublisher(Logger& baseLogger, int sendEveryX = 1);
+    /**
+     * @brief Construct a new CBOR Publisher object
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param inClient An Arduino client instance to use to print data to.
+     * Allows the use of any type of client and multiple clients tied to a
+     * single TinyGSM modem instance
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    CBORPublisher(Logger& baseLogger, Client* inClient, int sendEveryX = 1);
+    /**
+     * @brief Construct a new CBOR Publisher object
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param inClient An Arduino client instance to use to print data to.
+     * Allows the use of any type of client and multiple clients tied to a
+     * single TinyGSM modem instance
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The port of the receiver
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    CBORPublisher(Logger& baseLogger, Client* inClient, const char* host,
+                  const char* path, uint16_t port = 80, int sendEveryX = 1);
+    /**
+     * @brief Destroy the CBOR Publisher object
+     */
+    virtual ~CBORPublisher();
+
+    // Returns the data destination
+    String getEndpoint(void) override {
+        return String(_host);
+    }
+
+    /**
+     * @brief Set the receiver of the posts
+     *
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The port of the receiver
+     */
+    void setReceiver(const char* host, const char* path, uint16_t port = 80);
+
+    /**
+     * @brief Calculates how long the outgoing CBOR will be
+     *
+     * @return uint16_t The number of bytes in the CBOR map.
+     */
+    uint16_t calculateCBORSize();
+
+    // A way to begin with everything already set
+    /**
+     * @copydoc dataPublisher::begin(Logger& baseLogger, Client* inClient)
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The port of the receiver
+     */
+    void begin(Logger& baseLogger, Client* inClient, const char* host,
+               const char* path, uint16_t port = 80);
+    /**
+     * @copydoc dataPublisher::begin(Logger& baseLogger)
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The port of the receiver
+     */
+    void begin(Logger& baseLogger, const char* host, const char* path,
+               uint16_t port = 80);
+
+    /**
+     * @brief Utilize an attached modem to open a TCP connection to the
+     * receiver and then stream out a post request over that connection.
+     *
+     * This depends on an internet connection already having been made and a
+     * client being available.
+     *
+     * @param outClient An Arduino client instance to use to print data to.
+     * Allows the use of any type of client and multiple clients tied to a
+     * single TinyGSM modem instance
+     * @return **int16_t** The http status code of the response.
+     */
+    int16_t publishData(Client* outClient) override;
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @copydoc dataPublisher::publishesBatches()
+     *
+     * Several records are sent with an array of times and an array of values
+     * for each variable.
+     */
+    bool publishesBatches(void) override {
+        return true;
+    }
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @copydoc dataPublisher::sendsRequestsAhead()
+     */
+    bool sendsRequestsAhead(void) override {
+        return true;
+    }
+#endif
+
+ protected:
+    /**
+     * @copydoc dataPublisher::startRequest(Client* outClient)
+     */
+    bool startRequest(Client* outClient) override;
+
+    /**
+     * @anchor cbor_post_vars
+     * @name Portions of the POST request to the CBOR receiver
+     *
+     * @{
+     */
+    static const char* contentLengthHeader;  ///< The content length header
+    static const char* contentTypeHeader;    ///< The content type header
+    /**@}*/
+
+    /**
+     * @brief Append the CBOR map of the sampling feature, times, and values
+     * to the TX buffer; it takes calculateCBORSize() bytes.
+     */
+    void txBufferAppendCBORBody(void);
+    /**
+     * @brief The number of records to send in the request
+     *
+     * @return **uint8_t** The number of outbox records being sent, or 1.
+     */
+    uint8_t recordCount(void);
+    /**
+     * @brief The number of variables to send in the request
+     *
+     * @return **uint8_t** The number of variables that changed enough to be
+     * sent (#MS_PUBLISH_ON_CHANGE), or all of them.
+     */
+    uint8_t includedCount(void);
+
+    const char* _host = nullptr;  ///< The host name of the receiver
+    const char* _path = "/";      ///< The path to post to on the receiver
+    uint16_t    _port = 80;       ///< The port of the receiver
+};
+
+#endif  // SRC_PUBLISHERS_CBORPUBLISHER_H_
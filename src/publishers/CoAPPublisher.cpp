@@ -0,0 +1,243 @@
+/**
+ * @file CoAPPublisher.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the CoAPPublisher class.
+ */
+
+#include "CoAPPublisher.h"
+
+
+// ============================================================================
+//  Functions for a receiver accepting CoAP
+// ============================================================================
+
+// The parts of a CoAP message used here
+#define COAP_VERSION 1
+#define COAP_TYPE_CON 0
+#define COAP_TYPE_NON 1
+#define COAP_TYPE_ACK 2
+#define COAP_TYPE_RST 3
+#define COAP_CODE_POST 0x02
+#define COAP_OPTION_URI_PATH 11
+#define COAP_OPTION_CONTENT_FORMAT 12
+#define COAP_FORMAT_CBOR 60
+#define COAP_PAYLOAD_MARKER 0xFF
+
+
+// Constructors
+CoAPPublisher::CoAPPublisher() : CBORPublisher() {}
+CoAPPublisher::CoAPPublisher(Logger& baseLogger, UDP* udp, const char* host,
+                             const char* path, uint16_t port, int sendEveryX)
+    : CBORPublisher(baseLogger, sendEveryX) {
+    setReceiver(host, path, port);
+    setUDP(udp);
+}
+// Destructor
+CoAPPublisher::~CoAPPublisher() {}
+
+
+void CoAPPublisher::setReceiver(const char* host, const char* path,
+                                uint16_t port) {
+    CBORPublisher::setReceiver(host, path, port);
+}
+
+
+void CoAPPublisher::setUDP(UDP* udp) {
+    _udp = udp;
+}
+
+
+void CoAPPublisher::setConfirmable(bool confirmable) {
+    _confirmable = confirmable;
+}
+
+
+// A way to begin with everything already set
+void CoAPPublisher::begin(Logger& baseLogger, UDP* udp, const char* host,
+                          const char* path, uint16_t port) {
+    setReceiver(host, path, port);
+    setUDP(udp);
+    dataPublisher::begin(baseLogger);
+}
+
+
+// The header, a Uri-Path option for each part of the path, the content format,
+// and the payload marker
+uint16_t CoAPPublisher::calculateHeaderSize(void) {
+    uint16_t    headerLength = 4;
+    const char* segment      = _path;
+    while (*segment != '\0') {
+        if (*segment == '/') {
+            segment++;
+            continue;
+        }
+        const char* end = strchr(segment, '/');
+        uint16_t    len = end ? end - segment : strlen(segment);
+        // a length over 12 takes an extra byte
+        headerLength += 1 + (len > 12 ? 1 : 0) + len;
+        segment += len;
+    }
+    headerLength += 2;  // Content-Format
+    headerLength += 1;  // payload marker
+    return headerLength;
+}
+
+
+void CoAPPublisher::txBufferAppendMessage(uint16_t messageId) {
+    uint8_t type = _confirmable ? COAP_TYPE_CON : COAP_TYPE_NON;
+    // version, type, and no token
+    txBufferAppend(static_cast<char>((COAP_VERSION << 6) | (type << 4)));
+    txBufferAppend(static_cast<char>(COAP_CODE_POST));
+    txBufferAppend(static_cast<char>(messageId >> 8));
+    txBufferAppend(static_cast<char>(messageId & 0xFF));
+
+    // Each option number is given as the difference from the one before
+    uint8_t     lastOption = 0;
+    const char* segment    = _path;
+    while (*segment != '\0') {
+        if (*segment == '/') {
+            segment++;
+            continue;
+        }
+        const char* end   = strchr(segment, '/');
+        uint16_t    len   = end ? end - segment : strlen(segment);
+        uint8_t     delta = COAP_OPTION_URI_PATH - lastOption;
+        if (len > 12) {
+            txBufferAppend(static_cast<char>((delta << 4) | 13));
+            txBufferAppend(static_cast<char>(len - 13));
+        } else {
+            txBufferAppend(static_cast<char>((delta << 4) | len));
+        }
+        txBufferAppend(segment, len);
+        lastOption = COAP_OPTION_URI_PATH;
+        segment += len;
+    }
+    txBufferAppend(static_cast<char>(
+        ((COAP_OPTION_CONTENT_FORMAT - lastOption) << 4) | 1));
+    txBufferAppend(static_cast<char>(COAP_FORMAT_CBOR));
+    txBufferAppend(static_cast<char>(COAP_PAYLOAD_MARKER));
+
+    // the CBOR map with the sampling feature, times, and values
+    txBufferAppendCBORBody();
+}
+
+
+// The buffer is written straight to the UDP instance instead of with
+// txBufferFlush() because flushing some UDP instances sends the packet
+bool CoAPPublisher::sendDatagram(void) {
+    if (!_udp->beginPacket(_host, _port)) {
+        PRINTOUT(F("\n -- Unable to Resolve"), _host, F("--"));
+        return false;
+    }
+    _udp->write(reinterpret_cast<const uint8_t*>(txBuffer), txBufferLen);
+#ifdef MS_MODEM_STATS
+    loggerModem::recordTraffic(txBufferLen, 0);
+#endif
+#ifdef MS_PUBLISHER_STATS
+    _stats.bytesSent += txBufferLen;
+#endif
+    return _udp->endPacket();
+}
+
+
+int16_t CoAPPublisher::waitForAck(uint16_t messageId, uint32_t wait_ms) {
+    uint32_t start = millis();
+    while (millis() - start < wait_ms) {
+        int packetSize = _udp->parsePacket();
+        if (packetSize < 4) { continue; }
+#ifdef MS_MODEM_STATS
+        loggerModem::recordTraffic(0, packetSize);
+#endif
+        uint8_t header[4];
+        _udp->read(header, 4);
+        uint8_t  type = (header[0] >> 4) & 0x03;
+        uint16_t id   = (static_cast<uint16_t>(header[2]) << 8) | header[3];
+        // Skip anything that isn't the answer to this message
+        if (id != messageId) { continue; }
+        if (type == COAP_TYPE_RST) {
+            PRINTOUT(F("\n -- The CoAP message was reset by"), _host,
+                     F("--"));
+            return -1;
+        }
+        if (type != COAP_TYPE_ACK) { continue; }
+        // An empty acknowledgement means the response will come later
+        if (header[1] == 0) { return 202; }
+        // The code is a class and a detail, like 2.01
+        return (header[1] >> 5) * 100 + (header[1] & 0x1F);
+    }
+    return 0;
+}
+
+
+int16_t CoAPPublisher::publishData(Client*) {
+    return publishData();
+}
+
+
+int16_t CoAPPublisher::publishData() {
+    if (_udp == nullptr) {
+        PRINTOUT(F("\n -- No UDP instance set for the CoAP publisher --"));
+        return 0;
+    }
+    if (_host == nullptr) {
+        PRINTOUT(F("\n -- No receiver set for the CoAP publisher --"));
+        return 0;
+    }
+
+    uint16_t messageSize = calculateHeaderSize() + calculateCBORSize();
+    MS_DBG(F("Outgoing CoAP size:"), messageSize);
+    if (messageSize > txBufferSize) {
+        PRINTOUT(F("\n -- The CoAP message is larger than the send buffer --"));
+        return 413;
+    }
+
+    // Start the message IDs from the time so they don't repeat those sent
+    // before a restart
+    if (_messageId == 0) {
+        _messageId = static_cast<uint16_t>(Logger::markedUTCEpochTime);
+    }
+    uint16_t messageId = _messageId++;
+
+    txBufferInit(_udp);
+    txBufferAppendMessage(messageId);
+
+    // Throw out anything left over from before
+    while (_udp->parsePacket() > 0) {}
+
+    int16_t  result  = 0;
+    uint32_t timeout = MS_COAP_ACK_TIMEOUT_MS +
+        random(MS_COAP_ACK_TIMEOUT_MS / 2);
+    for (uint8_t attempt = 0; attempt <= MS_COAP_MAX_RETRANSMIT; attempt++) {
+        MS_DBG(F("Sending CoAP message"), messageId);
+        MS_START_DEBUG_TIMER;
+        if (!sendDatagram()) { break; }
+        if (!_confirmable) {
+            result = 202;
+            break;
+        }
+#ifdef MS_PUBLISHER_STATS
+        uint32_t sentAt = millis();
+#endif
+        result = waitForAck(messageId, timeout);
+#ifdef MS_PUBLISHER_STATS
+        _stats.response_ms = millis() - sentAt;
+#endif
+        if (result != 0) {
+            MS_DBG(F("Response after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+            break;
+        }
+        timeout *= 2;
+    }
+    txBufferLen = 0;
+
+    if (result == 0) {
+        PRINTOUT(F("\n -- No acknowledgement from"), _host, F("--"));
+        result = 504;
+    }
+    PRINTOUT(F("-- Response Code --"));
+    PRINTOUT(result);
+    return result;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file CoAPPublisher.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the CoAPPublisher subclass of CBORPublisher for sending
+ * each record to a receiver of your own in a single CoAP datagram over UDP.
+ */
+
+// Header Guards
+#ifndef SRC_PUBLISHERS_COAPPUBLISHER_H_
+#define SRC_PUBLISHERS_COAPPUBLISHER_H_
+
+// Debugging Statement
+// #define MS_COAPPUBLISHER_DEBUG
+
+#ifdef MS_COAPPUBLISHER_DEBUG
+#define MS_DEBUGGING_STD "CoAPPublisher"
+#endif
+
+/**
+ * @brief The CoAP port used when none is given.
+ */
+#define COAP_DEFAULT_PORT 5683
+
+#ifndef MS_COAP_ACK_TIMEOUT_MS
+/**
+ * @brief The time in milliseconds to wait for the acknowledgement of a
+ * confirmable message before sending it again; it's doubled for each retry.
+ *
+ * A random part of up to half this is added, so loggers that wake together
+ * don't retry together.
+ */
+#define MS_COAP_ACK_TIMEOUT_MS 2000L
+#endif
+
+#ifndef MS_COAP_MAX_RETRANSMIT
+/**
+ * @brief The most times a confirmable message is sent again without an
+ * acknowledgement.
+ *
+ * This is lower than the 4 of RFC 7252 so a lost receiver holds up the
+ * logging cycle for at most about 20 seconds.
+ */
+#define MS_COAP_MAX_RETRANSMIT 2
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "CBORPublisher.h"
+#include <Udp.h>
+
+
+// ============================================================================
+//  Functions for a receiver accepting CoAP
+// ============================================================================
+/**
+ * @brief The CoAPPublisher subclass of CBORPublisher sends each record to a
+ * receiver of your own as a CoAP (RFC 7252) POST in a single UDP datagram.
+ *
+ * The payload is the same CBOR map sent by the CBORPublisher, with a 4 byte
+ * CoAP header, the path as Uri-Path options, and a Content-Format of
+ * application/cbor in front of it.  There's no TCP connection to open, no
+ * HTTP headers, and no connection to close, so a record costs one round trip.
+ *
+ * By default the messages are confirmable: the receiver acknowledges each
+ * one by its message ID and a message without an acknowledgement is sent
+ * again after #MS_COAP_ACK_TIMEOUT_MS, doubling each time, up to
+ * #MS_COAP_MAX_RETRANSMIT times.  Non-confirmable messages are only sent
+ * once and never waited for.
+ *
+ * With #MS_PUBLISHER_OUTBOX each queued record is sent as its own message
+ * and acknowledged on its own, so a lost datagram only leaves that one
+ * record in the outbox to send again.  A 30 variable record is about 700
+ * bytes and must fit in the send buffer (#MS_SEND_BUFFER_SIZE).
+ *
+ * @note This needs a UDP instance from the network library, like the
+ * WiFiUDP of the WiFiNINA or ESP32 libraries or an EthernetUDP.  The TinyGSM
+ * clients of the modems in this library are TCP only.  Call begin() on it
+ * with a local port before publishing so it can get the acknowledgements.
+ *
+ * @ingroup the_publishers
+ */
+class CoAPPublisher : public CBORPublisher {
+ public:
+    // Constructors
+    /**
+     * @brief Construct a new CoAP Publisher object with no members set.
+     */
+    CoAPPublisher();
+    /**
+     * @brief Construct a new CoAP Publisher object
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param udp An Arduino UDP instance to send the datagrams with
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The UDP port of the receiver
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    CoAPPublisher(Logger& baseLogger, UDP* udp, const char* host,
+                  const char* path, uint16_t port = COAP_DEFAULT_PORT,
+                  int sendEveryX = 1);
+    /**
+     * @brief Destroy the CoAP Publisher object
+     */
+    virtual ~CoAPPublisher();
+
+    /**
+     * @brief Set the receiver of the messages
+     *
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The UDP port of the receiver
+     */
+    void setReceiver(const char* host, const char* path,
+                     uint16_t port = COAP_DEFAULT_PORT);
+    /**
+     * @brief Set the UDP instance to send the datagrams with
+     *
+     * @param udp An Arduino UDP instance
+     */
+    void setUDP(UDP* udp);
+    /**
+     * @brief Set whether the messages are confirmable
+     *
+     * @param confirmable True to wait for an acknowledgement of each message
+     * and send it again without one; false to send each message once.
+     */
+    void setConfirmable(bool confirmable);
+
+    // A way to begin with everything already set
+    /**
+     * @copydoc dataPublisher::begin(Logger& baseLogger)
+     * @param udp An Arduino UDP instance to send the datagrams with
+     * @param host The host name of the receiver
+     * @param path The path to post to on the receiver
+     * @param port The UDP port of the receiver
+     */
+    void begin(Logger& baseLogger, UDP* udp, const char* host,
+               const char* path, uint16_t port = COAP_DEFAULT_PORT);
+
+    /**
+     * @brief Send the record to the receiver in a CoAP message and, if it's
+     * confirmable, wait for its acknowledgement.
+     *
+     * The client isn't used; the datagram goes out on the UDP instance.
+     *
+     * @param outClient Unused
+     * @return **int16_t** The CoAP response code as a number like an http
+     * code (2.01 is 201), 202 for an empty acknowledgement or a
+     * non-confirmable message, -1 if the receiver reset it, or 504 if it
+     * was never acknowledged.
+     */
+    int16_t publishData(Client* outClient) override;
+    /**
+     * @copydoc CoAPPublisher::publishData(Client* outClient)
+     */
+    int16_t publishData() override;
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @copydoc dataPublisher::publishesBatches()
+     *
+     * Each record is sent and acknowledged in a message of its own.
+     */
+    bool publishesBatches(void) override {
+        return false;
+    }
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @copydoc dataPublisher::sendsRequestsAhead()
+     */
+    bool sendsRequestsAhead(void) override {
+        return false;
+    }
+#endif
+
+ private:
+    /**
+     * @brief Calculate how long the CoAP header and options will be
+     *
+     * @return **uint16_t** The number of bytes before the payload.
+     */
+    uint16_t calculateHeaderSize(void);
+    /**
+     * @brief Put the whole message, header and payload, into the TX buffer
+     *
+     * @param messageId The CoAP message ID
+     */
+    void txBufferAppendMessage(uint16_t messageId);
+    /**
+     * @brief Send the message in the TX buffer as one datagram
+     *
+     * @return **bool** True if the datagram was sent.
+     */
+    bool sendDatagram(void);
+    /**
+     * @brief Wait for the response to a message
+     *
+     * @param messageId The CoAP message ID to wait for
+     * @param wait_ms How long to wait
+     * @return **int16_t** The response code, or 0 if there was no response.
+     */
+    int16_t waitForAck(uint16_t messageId, uint32_t wait_ms);
+
+    UDP*     _udp         = nullptr;
+    bool     _confirmable = true;
+    uint16_t _messageId   = 0;
+};
+
+#endif  // SRC_PUBLISHERS_COAPPUBLISHER_H_
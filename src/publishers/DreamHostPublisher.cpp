@@ -20,6 +20,8 @@ const char* DreamHostPublisher::dreamhostHost  = "swrcsensors.dreamhosters.com";
 const int   DreamHostPublisher::dreamhostPort  = 80;
 const char* DreamHostPublisher::loggerTag      = "?LoggerID=";
 const char* DreamHostPublisher::timestampTagDH = "&Loggertime=";
+const char  DreamHostPublisher::requestEnd[] PROGMEM =
+    " HTTP/1.1\r\nHost: swrcsensors.dreamhosters.com\r\n\r\n";
 
 // Constructors
 DreamHostPublisher::DreamHostPublisher() : dataPublisher() {}
@@ -66,14 +68,20 @@ void DreamHostPublisher::begin(Logger& baseLogger, const char* dhUrl) {
 // Post the data to dream host.
 // int16_t DreamHostPublisher::postDataDreamHost(void)
 int16_t DreamHostPublisher::publishData(Client* outClient) {
-    // Create a buffer for the portions of the request and response
-    char     tempBuffer[37] = "";
-    uint16_t did_respond    = 0;
+    return finishResponse(outClient, startRequest(outClient));
+}
+
+
+// This opens the connection and sends the whole request, leaving the response
+// to be read by finishResponse()
+bool DreamHostPublisher::startRequest(Client* outClient) {
+    // Create a buffer for the portions of the request
+    char tempBuffer[37] = "";
 
     // Open a TCP/IP connection to DreamHost
     MS_DBG(F("Connecting client"));
     MS_START_DEBUG_TIMER;
-    if (outClient->connect(dreamhostHost, dreamhostPort)) {
+    if (connectClient(outClient, dreamhostHost, dreamhostPort)) {
         MS_DBG(F("Client connected after"), MS_PRINT_DEBUG_TIMER, F("ms\n"));
         txBufferInit(outClient);
 
@@ -92,60 +100,23 @@ int16_t DreamHostPublisher::publishData(Client* outClient) {
              10);  // BASE 10
         txBufferAppend(tempBuffer);
 
-        for (uint8_t i = 0; i < _baseLogger->getArrayVarCount(); i++) {
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            uint8_t i = viewPosition(slot);
             txBufferAppend('&');
-            txBufferAppend(_baseLogger->getVarCodeAtI(i).c_str());
+            txBufferAppend(_baseLogger->getVarCodeCharsAtI(i));
             txBufferAppend('=');
-            txBufferAppend(_baseLogger->getValueStringAtI(i).c_str());
+            txBufferAppend(_baseLogger->getValueCharsAtI(i));
         }
 
-        // add the rest of the HTTP GET headers to the outgoing buffer
-        txBufferAppend(HTTPtag);
-        txBufferAppend(hostHeader);
-        txBufferAppend(dreamhostHost);
-        txBufferAppend('\r');
-        txBufferAppend('\n');
-        txBufferAppend('\r');
-        txBufferAppend('\n');
+        // add the unchanging rest of the HTTP GET headers
+        txBufferAppend_P(requestEnd);
 
         // Flush the complete request
         txBufferFlush();
 
-        // Wait 10 seconds for a response from the server
-        uint32_t start = millis();
-        while ((millis() - start) < 10000L && outClient->available() < 12) {
-            delay(10);
-        }
-
-        // Read only the first 12 characters of the response
-        // We're only reading as far as the http code, anything beyond that
-        // we don't care about.
-        did_respond = outClient->readBytes(tempBuffer, 12);
-
-        // Close the TCP/IP connection
-        MS_DBG(F("Stopping client"));
-        MS_RESET_DEBUG_TIMER;
-        outClient->stop();
-        MS_DBG(F("Client stopped after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+        return true;
     } else {
         PRINTOUT(F("\n -- Unable to Establish Connection to DreamHost --"));
     }
-
-    // Process the HTTP response
-    int16_t responseCode = 0;
-    if (did_respond > 0) {
-        char responseCode_char[4];
-        responseCode_char[3] = 0;
-        for (uint8_t i = 0; i < 3; i++) {
-            responseCode_char[i] = tempBuffer[i + 9];
-        }
-        responseCode = atoi(responseCode_char);
-    } else {
-        responseCode = 504;
-    }
-
-    PRINTOUT(F("\n-- Response Code --"));
-    PRINTOUT(responseCode);
-
-    return responseCode;
+    return false;
 }
@@ -135,8 +135,21 @@ class DreamHostPublisher : public dataPublisher {
      * @return **int16_t** The http status code of the response.
      */
     int16_t publishData(Client* outClient) override;
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @copydoc dataPublisher::sendsRequestsAhead()
+     */
+    bool sendsRequestsAhead(void) override {
+        return true;
+    }
+#endif
 
  protected:
+    /**
+     * @copydoc dataPublisher::startRequest(Client* outClient)
+     */
+    bool startRequest(Client* outClient) override;
+
     // portions of the GET request
     /**
      * @anchor dreamhost_protected_vars
@@ -148,7 +161,12 @@ class DreamHostPublisher : public dataPublisher {
     static const int   dreamhostPort;   ///< The host port
     static const char* loggerTag;       ///< The Stroud logger number
     static const char* timestampTagDH;  ///< The timestamp
-                                        /**@}*/
+    /**
+     * @brief The end of the request line and the host header, kept in flash
+     * and sent in one piece
+     */
+    static const char requestEnd[];
+    /**@}*/
 
 
  private:
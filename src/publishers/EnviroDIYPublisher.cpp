@@ -25,9 +25,14 @@ const char* EnviroDIYPublisher::tokenHeader         = "\r\nTOKEN: ";
 const char* EnviroDIYPublisher::contentLengthHeader = "\r\nContent-Length: ";
 const char* EnviroDIYPublisher::contentTypeHeader =
     "\r\nContent-Type: application/json\r\n\r\n";
+const char EnviroDIYPublisher::requestStart[] PROGMEM =
+    "POST /api/data-stream/ HTTP/1.1\r\nHost: data.envirodiy.org\r\nTOKEN: ";
 
 const char* EnviroDIYPublisher::samplingFeatureTag = "{\"sampling_feature\":\"";
 const char* EnviroDIYPublisher::timestampTag       = "\",\"timestamp\":\"";
+#ifdef MS_PUBLISHER_OUTBOX
+const char* EnviroDIYPublisher::timestampBatchTag = "\",\"timestamp\":[";
+#endif
 
 
 // Constructors
@@ -64,17 +69,46 @@ void EnviroDIYPublisher::setToken(const char* registrationToken) {
 
 // Calculates how long the JSON will be
 uint16_t EnviroDIYPublisher::calculateJsonSize() {
+#ifdef MS_PUBLISHER_OUTBOX
+    uint8_t records = _baseLogger->getReplayRecordCount();
+    if (records > 1) {
+        uint16_t jsonLength = 21;    // {"sampling_feature":"
+        jsonLength += 36;            // sampling feature UUID
+        jsonLength += 15;            // ","timestamp":[
+        jsonLength += records * 27;  // "markedISO8601Time"
+        jsonLength += records - 1;   // ,
+        jsonLength += 2;             // ],
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            uint8_t i = viewPosition(slot);
+            jsonLength += 1;   //  "
+            jsonLength += 36;  // variable UUID
+            jsonLength += 3;   //  ":[
+            for (uint8_t j = 0; j < records; j++) {
+                _baseLogger->loadReplayRecord(j);
+                jsonLength += strlen(_baseLogger->getValueCharsAtI(i));
+            }
+            jsonLength += records - 1;  // ,
+            jsonLength += 1;            // ]
+            if (slot + 1 != viewSize()) {
+                jsonLength += 1;  // ,
+            }
+        }
+        jsonLength += 1;  // }
+        return jsonLength;
+    }
+#endif
     uint16_t jsonLength = 21;  // {"sampling_feature":"
     jsonLength += 36;          // sampling feature UUID
     jsonLength += 15;          // ","timestamp":"
     jsonLength += 25;          // markedISO8601Time
     jsonLength += 2;           //  ",
-    for (uint8_t i = 0; i < _baseLogger->getArrayVarCount(); i++) {
+    for (uint8_t slot = 0; slot < viewSize(); slot++) {
+        uint8_t i = viewPosition(slot);
         jsonLength += 1;   //  "
         jsonLength += 36;  // variable UUID
         jsonLength += 2;   //  ":
-        jsonLength += _baseLogger->getValueStringAtI(i).length();
-        if (i + 1 != _baseLogger->getArrayVarCount()) {
+        jsonLength += strlen(_baseLogger->getValueCharsAtI(i));
+        if (slot + 1 != viewSize()) {
             jsonLength += 1;  // ,
         }
     }
@@ -106,99 +140,131 @@ void EnviroDIYPublisher::begin(Logger&     baseLogger,
 // over that connection.
 // The return is the http status code of the response.
 int16_t EnviroDIYPublisher::publishData(Client* outClient) {
-    // Create a buffer for the portions of the request and response
-    char     tempBuffer[37] = "";
-    uint16_t did_respond    = 0;
+#ifdef MS_MODEM_NATIVE_HTTP
+    // Post through the modem's own HTTP client if it has one
+    if (modemPostStart(enviroDIYHost, enviroDIYPort, postEndpoint,
+                       calculateJsonSize(), "TOKEN", _registrationToken)) {
+        writeJsonBody();
+        return modemPostFinish();
+    }
+#endif
+    return finishResponse(outClient, startRequest(outClient));
+}
+
+
+// This opens the connection and sends the whole request, leaving the response
+// to be read by finishResponse()
+bool EnviroDIYPublisher::startRequest(Client* outClient) {
+#ifndef MS_PUBLISHER_CHUNKED
+    // Create a buffer for the portions of the request
+    char tempBuffer[37] = "";
 
     MS_DBG(F("Outgoing JSON size:"), calculateJsonSize());
+#endif
 
     // Open a TCP/IP connection to the Enviro DIY Data Portal (WebSDL)
     MS_DBG(F("Connecting client"));
     MS_START_DEBUG_TIMER;
-    if (outClient->connect(enviroDIYHost, enviroDIYPort)) {
+    if (connectClient(outClient, enviroDIYHost, enviroDIYPort)) {
         MS_DBG(F("Client connected after"), MS_PRINT_DEBUG_TIMER, F("ms"));
         txBufferInit(outClient);
 
-        // copy the initial post header into the tx buffer
-        txBufferAppend(postHeader);
-        txBufferAppend(postEndpoint);
-        txBufferAppend(HTTPtag);
-
-        // add the rest of the HTTP POST headers to the outgoing buffer
-        txBufferAppend(hostHeader);
-        txBufferAppend(enviroDIYHost);
-        txBufferAppend(tokenHeader);
+        // copy the unchanging start of the request into the tx buffer
+        txBufferAppend_P(requestStart);
         txBufferAppend(_registrationToken);
 
+#ifdef MS_PUBLISHER_CHUNKED
+        // the body is sent in chunks instead of being counted first
+        txBufferAppend(transferEncodingHeader);
+        txBufferAppend(contentTypeHeader);
+        txBufferStartChunks();
+#else
         txBufferAppend(contentLengthHeader);
         itoa(calculateJsonSize(), tempBuffer, 10);  // BASE 10
         txBufferAppend(tempBuffer);
 
         txBufferAppend(contentTypeHeader);
+#endif
 
-        // put the start of the JSON into the outgoing response_buffer
-        txBufferAppend(samplingFeatureTag);
-        txBufferAppend(_baseLogger->getSamplingFeatureUUID());
+        writeJsonBody();
 
-        txBufferAppend(timestampTag);
-        txBufferAppend(
-            Logger::formatDateTime_ISO8601(Logger::markedLocalEpochTime)
-                .c_str());
-        txBufferAppend('"');
+        // Write out the complete request
+#ifdef MS_PUBLISHER_CHUNKED
+        txBufferEndChunks();
+#else
+        txBufferFlush();
+#endif
+
+        return true;
+    } else {
+        PRINTOUT(F("\n -- Unable to Establish Connection to EnviroDIY Data "
+                   "Portal --"));
+    }
+    return false;
+}
+
+
+// This writes the JSON object for the record, or the outbox records, into
+// the tx buffer
+void EnviroDIYPublisher::writeJsonBody(void) {
+    // put the start of the JSON into the outgoing response_buffer
+    txBufferAppend(samplingFeatureTag);
+    txBufferAppend(_baseLogger->getSamplingFeatureUUID());
+
+#ifdef MS_PUBLISHER_OUTBOX
+    // Several records from the outbox are sent as a list of timestamps
+    // and a list of values for each variable
+    uint8_t records = _baseLogger->getReplayRecordCount();
+    if (records > 1) {
+        txBufferAppend(timestampBatchTag);
+        for (uint8_t j = 0; j < records; j++) {
+            _baseLogger->loadReplayRecord(j);
+            txBufferAppend('"');
+            txBufferAppend(Logger::getMarkedTimeISO8601());
+            txBufferAppend('"');
+            txBufferAppend(j + 1 != records ? ',' : ']');
+        }
         txBufferAppend(',');
 
-        for (uint8_t i = 0; i < _baseLogger->getArrayVarCount(); i++) {
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            uint8_t i = viewPosition(slot);
             txBufferAppend('"');
-            txBufferAppend(_baseLogger->getVarUUIDAtI(i).c_str());
+            txBufferAppend(_baseLogger->getVarUUIDCharsAtI(i));
             txBufferAppend('"');
             txBufferAppend(':');
-            txBufferAppend(_baseLogger->getValueStringAtI(i).c_str());
-            if (i + 1 != _baseLogger->getArrayVarCount()) {
+            txBufferAppend('[');
+            for (uint8_t j = 0; j < records; j++) {
+                _baseLogger->loadReplayRecord(j);
+                txBufferAppend(_baseLogger->getValueCharsAtI(i));
+                txBufferAppend(j + 1 != records ? ',' : ']');
+            }
+            if (slot + 1 != viewSize()) {
                 txBufferAppend(',');
             } else {
                 txBufferAppend('}');
             }
         }
-
-        // Write out the complete request
-        txBufferFlush();
-
-        // Wait 10 seconds for a response from the server
-        uint32_t start = millis();
-        while ((millis() - start) < 10000L && outClient->available() < 12) {
-            delay(10);
-        }
-
-        // Read only the first 12 characters of the response
-        // We're only reading as far as the http code, anything beyond that
-        // we don't care about.
-        did_respond = outClient->readBytes(tempBuffer, 12);
-
-        // Close the TCP/IP connection
-        MS_DBG(F("Stopping client"));
-        MS_RESET_DEBUG_TIMER;
-        outClient->stop();
-        MS_DBG(F("Client stopped after"), MS_PRINT_DEBUG_TIMER, F("ms"));
     } else {
-        PRINTOUT(F("\n -- Unable to Establish Connection to EnviroDIY Data "
-                   "Portal --"));
-    }
+#endif
+        txBufferAppend(timestampTag);
+        txBufferAppend(Logger::getMarkedTimeISO8601());
+        txBufferAppend('"');
+        txBufferAppend(',');
 
-    // Process the HTTP response
-    int16_t responseCode = 0;
-    if (did_respond > 0) {
-        char responseCode_char[4];
-        responseCode_char[3] = 0;
-        for (uint8_t i = 0; i < 3; i++) {
-            responseCode_char[i] = tempBuffer[i + 9];
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            uint8_t i = viewPosition(slot);
+            txBufferAppend('"');
+            txBufferAppend(_baseLogger->getVarUUIDCharsAtI(i));
+            txBufferAppend('"');
+            txBufferAppend(':');
+            txBufferAppend(_baseLogger->getValueCharsAtI(i));
+            if (slot + 1 != viewSize()) {
+                txBufferAppend(',');
+            } else {
+                txBufferAppend('}');
+            }
         }
-        responseCode = atoi(responseCode_char);
-    } else {
-        responseCode = 504;
+#ifdef MS_PUBLISHER_OUTBOX
     }
-
-    PRINTOUT(F("\n-- Response Code --"));
-    PRINTOUT(responseCode);
-
-    return responseCode;
+#endif
 }
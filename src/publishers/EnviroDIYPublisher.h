@@ -159,8 +159,32 @@ class EnviroDIYPublisher : public dataPublisher {
      * @return **int16_t** The http status code of the response.
      */
     int16_t publishData(Client* outClient) override;
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @copydoc dataPublisher::publishesBatches()
+     *
+     * Several records are sent with a list of timestamps and a list of values
+     * for each variable.
+     */
+    bool publishesBatches(void) override {
+        return true;
+    }
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @copydoc dataPublisher::sendsRequestsAhead()
+     */
+    bool sendsRequestsAhead(void) override {
+        return true;
+    }
+#endif
 
  protected:
+    /**
+     * @copydoc dataPublisher::startRequest(Client* outClient)
+     */
+    bool startRequest(Client* outClient) override;
+
     /**
      * @anchor envirodiy_post_vars
      * @name Portions of the POST request to EnviroDIY
@@ -173,6 +197,11 @@ class EnviroDIYPublisher : public dataPublisher {
     static const char* tokenHeader;          ///< The token header text
     static const char* contentLengthHeader;  ///< The content length header text
     static const char* contentTypeHeader;    ///< The content type header text
+    /**
+     * @brief The request line, host, and token header up to the token, kept
+     * in flash and sent in one piece
+     */
+    static const char requestStart[];
     /**@}*/
 
     /**
@@ -183,9 +212,17 @@ class EnviroDIYPublisher : public dataPublisher {
      */
     static const char* samplingFeatureTag;  ///< The JSON feature UUID tag
     static const char* timestampTag;        ///< The JSON feature timestamp tag
+#ifdef MS_PUBLISHER_OUTBOX
+    static const char* timestampBatchTag;  ///< The JSON tag for several times
+#endif
                                             /**@}*/
 
  private:
+    /**
+     * @brief Write the JSON body of the request into the TX buffer.
+     */
+    void writeJsonBody(void);
+
     // Tokens and UUID's for EnviroDIY
     const char* _registrationToken = nullptr;
 };
@@ -0,0 +1,381 @@
+/**
+ * @file MQTTPublisher.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the MQTTPublisher class.
+ */
+
+#include "MQTTPublisher.h"
+
+
+// ============================================================================
+//  Functions for any MQTT broker
+// ============================================================================
+
+// Constructors
+MQTTPublisher::MQTTPublisher() : dataPublisher() {}
+MQTTPublisher::MQTTPublisher(Logger& baseLogger, int sendEveryX)
+    : dataPublisher(baseLogger, sendEveryX) {}
+MQTTPublisher::MQTTPublisher(Logger& baseLogger, Client* inClient,
+                             int sendEveryX)
+    : dataPublisher(baseLogger, inClient, sendEveryX) {}
+MQTTPublisher::MQTTPublisher(Logger& baseLogger, Client* inClient,
+                             const char* broker, const char* topicTemplate,
+                             uint16_t port, int sendEveryX)
+    : dataPublisher(baseLogger, inClient, sendEveryX) {
+    setBroker(broker, port);
+    setTopic(topicTemplate);
+}
+// Destructor
+MQTTPublisher::~MQTTPublisher() {}
+
+
+void MQTTPublisher::setBroker(const char* broker, uint16_t port) {
+    _broker = broker;
+    _port   = port;
+}
+
+
+void MQTTPublisher::setTopic(const char* topicTemplate) {
+    _topicTemplate = topicTemplate;
+}
+
+
+void MQTTPublisher::setCredentials(const char* user, const char* password) {
+    _user     = user;
+    _password = password;
+}
+
+
+#ifdef MS_LOGGER_BACKFILL
+void MQTTPublisher::setCommandTopic(const char* topicTemplate) {
+    _commandTopic = topicTemplate;
+}
+#endif
+
+
+// A way to begin with everything already set
+void MQTTPublisher::begin(Logger& baseLogger, Client* inClient,
+                          const char* broker, const char* topicTemplate,
+                          uint16_t port) {
+    setBroker(broker, port);
+    setTopic(topicTemplate);
+    dataPublisher::begin(baseLogger, inClient);
+}
+void MQTTPublisher::begin(Logger& baseLogger, const char* broker,
+                          const char* topicTemplate, uint16_t port) {
+    setBroker(broker, port);
+    setTopic(topicTemplate);
+    dataPublisher::begin(baseLogger);
+}
+
+
+// Calculates how long the JSON for the current record will be
+uint16_t MQTTPublisher::calculateJsonSize() {
+    uint16_t jsonLength = 14;  // {"timestamp":"
+    jsonLength += strlen(Logger::getMarkedTimeISO8601());
+    jsonLength += 1;  // "
+    for (uint8_t slot = 0; slot < viewSize(); slot++) {
+        uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+        if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+        jsonLength += 2;  // ,"
+        jsonLength += strlen(_baseLogger->getVarUUIDCharsAtI(i));
+        jsonLength += 2;  // ":
+        jsonLength += strlen(_baseLogger->getValueCharsAtI(i));
+    }
+    jsonLength += 1;  // }
+    return jsonLength;
+}
+
+
+// This fills the logger ID and sampling feature UUID into a topic template
+void MQTTPublisher::makeTopic(char* topic, const char* topicTemplate) {
+    uint8_t     length = 0;
+    const char* c      = topicTemplate;
+    while (*c != '\0' && length < MS_MQTT_TOPIC_SIZE - 1) {
+        const char* fill = nullptr;
+        if (strncmp(c, "{id}", 4) == 0) {
+            fill = _baseLogger->getLoggerID();
+            c += 4;
+        } else if (strncmp(c, "{uuid}", 6) == 0) {
+            fill = _baseLogger->getSamplingFeatureUUID();
+            c += 6;
+        }
+        if (fill == nullptr) {
+            topic[length++] = *c++;
+            continue;
+        }
+        while (*fill != '\0' && length < MS_MQTT_TOPIC_SIZE - 1) {
+            topic[length++] = *fill++;
+        }
+    }
+    topic[length] = '\0';
+}
+
+
+// MQTT lengths are sent seven bits at a time, least significant first
+void MQTTPublisher::txBufferAppendLength(uint32_t length) {
+    do {
+        uint8_t digit = length & 0x7F;
+        length >>= 7;
+        if (length > 0) { digit |= 0x80; }
+        txBufferAppend(static_cast<char>(digit));
+    } while (length > 0);
+}
+void MQTTPublisher::txBufferAppendMQTTString(const char* s) {
+    uint16_t length = strlen(s);
+    txBufferAppend(static_cast<char>(length >> 8));
+    txBufferAppend(static_cast<char>(length));
+    txBufferAppend(s, length);
+}
+
+
+// This connects and publishes every record, waiting for the acknowledgements
+int16_t MQTTPublisher::publishData(Client* outClient) {
+    return finishResponse(outClient, startRequest(outClient));
+}
+
+
+// The connect and every publish are sent before any acknowledgements are read,
+// as MQTT allows
+bool MQTTPublisher::startRequest(Client* outClient) {
+    _recordsSent = 0;
+    if (_broker == nullptr) {
+        PRINTOUT(F("\n -- No broker set for the MQTT publisher --"));
+        return false;
+    }
+
+    char topic[MS_MQTT_TOPIC_SIZE];
+    makeTopic(topic, _topicTemplate);
+    MS_DBG(F("Topic ["), strlen(topic), F("]:"), topic);
+
+    uint8_t records = 1;
+#ifdef MS_PUBLISHER_OUTBOX
+    if (_baseLogger->getReplayRecordCount() > 1) {
+        records = _baseLogger->getReplayRecordCount();
+    }
+#endif
+
+    // Make sure any previous TCP connection is closed, so the new one is to
+    // the broker
+    if (outClient->connected()) { outClient->stop(); }
+
+    MS_DBG(F("Connecting client"));
+    MS_START_DEBUG_TIMER;
+    if (!openConnection(outClient, _broker, _port)) {
+        PRINTOUT(F("\n -- Unable to Establish Connection to"), _broker,
+                 F("--"));
+        return false;
+    }
+    MS_DBG(F("Client connected after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+    txBufferInit(outClient);
+
+    // The CONNECT packet, keeping the session with the logger ID as the
+    // client ID
+    const char* clientId     = _baseLogger->getLoggerID();
+    uint32_t    remainingLen = 10 + 2 + strlen(clientId);
+    uint8_t     connectFlags = 0;
+    // A password can only be sent with a user name, so an empty one is sent
+    // if there isn't one
+    const char* user = _user;
+    if (user == nullptr && _password != nullptr) { user = ""; }
+    if (user != nullptr) {
+        connectFlags |= 0x80;
+        remainingLen += 2 + strlen(user);
+    }
+    if (_password != nullptr) {
+        connectFlags |= 0x40;
+        remainingLen += 2 + strlen(_password);
+    }
+    txBufferAppend(static_cast<char>(0x10));
+    txBufferAppendLength(remainingLen);
+    txBufferAppendMQTTString("MQTT");
+    txBufferAppend(static_cast<char>(4));  // protocol level 3.1.1
+    txBufferAppend(static_cast<char>(connectFlags));
+    txBufferAppend(static_cast<char>(0));   // keep alive high byte
+    txBufferAppend(static_cast<char>(60));  // 60 second keep alive
+    txBufferAppendMQTTString(clientId);
+    if (user != nullptr) { txBufferAppendMQTTString(user); }
+    if (_password != nullptr) { txBufferAppendMQTTString(_password); }
+
+    // Packet ids that don't wrap within the connection
+    if (_packetId > 0xFFFF - records - 1) { _packetId = 0; }
+#ifdef MS_LOGGER_BACKFILL
+    // A SUBSCRIBE packet for the commands, at QoS 1
+    if (_commandTopic != nullptr) {
+        char commandTopic[MS_MQTT_TOPIC_SIZE];
+        makeTopic(commandTopic, _commandTopic);
+        _packetId++;
+        txBufferAppend(static_cast<char>(0x82));
+        txBufferAppendLength(2 + 2 + strlen(commandTopic) + 1);
+        txBufferAppend(static_cast<char>(_packetId >> 8));
+        txBufferAppend(static_cast<char>(_packetId));
+        txBufferAppendMQTTString(commandTopic);
+        txBufferAppend(static_cast<char>(1));
+    }
+#endif
+
+    // A QoS 1 PUBLISH packet for each record
+    for (uint8_t j = 0; j < records; j++) {
+#ifdef MS_PUBLISHER_OUTBOX
+        if (records > 1) { _baseLogger->loadReplayRecord(j); }
+#endif
+        _packetId++;
+        if (j == 0) { _firstPacketId = _packetId; }
+
+        uint16_t jsonSize = calculateJsonSize();
+        MS_DBG(F("Outgoing JSON size:"), jsonSize);
+        txBufferAppend(static_cast<char>(0x32));
+        txBufferAppendLength(2 + strlen(topic) + 2 + jsonSize);
+        txBufferAppendMQTTString(topic);
+        txBufferAppend(static_cast<char>(_packetId >> 8));
+        txBufferAppend(static_cast<char>(_packetId));
+
+        txBufferAppend("{\"timestamp\":\"");
+        txBufferAppend(Logger::getMarkedTimeISO8601());
+        txBufferAppend('"');
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+            // Leave out the variables that haven't changed
+            if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+            txBufferAppend(',');
+            txBufferAppend('"');
+            txBufferAppend(_baseLogger->getVarUUIDCharsAtI(i));
+            txBufferAppend('"');
+            txBufferAppend(':');
+            txBufferAppend(_baseLogger->getValueCharsAtI(i));
+        }
+        txBufferAppend('}');
+        _recordsSent++;
+    }
+
+    // Write out all of the packets
+    txBufferFlush();
+    return true;
+}
+
+
+// This reads the CONNACK and a PUBACK for each record, then disconnects
+int16_t MQTTPublisher::finishResponse(Client* outClient, bool requestSent) {
+    if (!requestSent) { return 0; }
+
+    int16_t  result    = 0;
+    bool     connected = false;
+#ifdef MS_LOGGER_BACKFILL
+    // Commands come after the SUBACK, or right after the CONNACK for the
+    // ones kept while the logger slept
+    bool subscribing = _commandTopic != nullptr;
+#else
+    bool subscribing = false;
+#endif
+    uint32_t start = millis();
+    while (result < _recordsSent || subscribing ||
+           (connected && outClient->available() >= 2)) {
+        // Wait 10 seconds for all of the acknowledgements
+        while ((millis() - start) < 10000L && outClient->available() < 2) {
+            delay(10);
+        }
+        // Each packet is its type, its remaining length seven bits at a time,
+        // and then the rest of it
+        uint8_t header[2];
+        if (outClient->readBytes(header, 2) != 2) { break; }
+        uint32_t length = header[1] & 0x7F;
+        uint8_t  digit  = header[1];
+        for (uint8_t shift = 7; (digit & 0x80) && shift < 28; shift += 7) {
+            if (outClient->readBytes(&digit, 1) != 1) { break; }
+            length |= static_cast<uint32_t>(digit & 0x7F) << shift;
+        }
+        uint8_t  body[MS_MQTT_PACKET_SIZE + 1];
+        uint16_t kept = length < MS_MQTT_PACKET_SIZE ? length
+                                                     : MS_MQTT_PACKET_SIZE;
+        if (outClient->readBytes(body, kept) != kept) { break; }
+        body[kept] = '\0';
+        for (uint32_t i = kept; i < length; i++) {
+            if (outClient->readBytes(&digit, 1) != 1) { break; }
+        }
+#ifdef MS_PUBLISHER_STATS
+        if (!connected) { _stats.response_ms = millis() - start; }
+#endif
+#ifdef MS_MODEM_STATS
+        loggerModem::recordTraffic(0, sizeof(header) + length);
+#endif
+        if (!connected) {
+            if (header[0] != 0x20 || length != 2) { break; }
+            if (body[1] != 0) {
+                PRINTOUT(F("MQTT connection refused with return code"),
+                         body[1]);
+                result = -body[1];
+                break;
+            }
+            connected = true;
+        } else if (header[0] == 0x40 && length == 2) {
+            uint16_t id = (body[0] << 8) | body[1];
+            MS_DBG(F("Broker acknowledged packet"), id);
+            // Only acknowledgements for this connection's packets count
+            if (id >= _firstPacketId && id - _firstPacketId < _recordsSent) {
+                result++;
+            }
+#ifdef MS_LOGGER_BACKFILL
+        } else if (header[0] == 0x90) {
+            MS_DBG(F("Broker took the subscription to the commands"));
+            subscribing = false;
+        } else if ((header[0] & 0xF0) == 0x30) {
+            takeCommand(outClient, header[0], body, kept);
+#endif
+        } else {
+            break;
+        }
+    }
+    PRINTOUT(F("MQTT broker acknowledged"), result > 0 ? result : 0,
+             F("of"), _recordsSent, F("records"));
+
+    // Send DISCONNECT now that the publishes are acknowledged
+    if (connected) {
+        txBufferInit(outClient);
+        txBufferAppend(static_cast<char>(0xE0));
+        txBufferAppend(static_cast<char>(0));
+        txBufferFlush();
+    }
+
+    // Close the TCP/IP connection
+    MS_DBG(F("Stopping client"));
+    MS_START_DEBUG_TIMER;
+    outClient->stop();
+    MS_DBG(F("Client stopped after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+    return result;
+}
+
+
+#ifdef MS_LOGGER_BACKFILL
+// A PUBLISH is the topic, the packet id if it's QoS 1 or 2, and the message
+void MQTTPublisher::takeCommand(Client* outClient, uint8_t flags,
+                                uint8_t* body, uint16_t length) {
+    if (length < 2) { return; }
+    uint16_t pos = 2 + ((body[0] << 8) | body[1]);
+    uint8_t  qos = (flags >> 1) & 0x03;
+    if (qos > 0 && pos + 2 <= length) {
+        // Acknowledge it so the broker doesn't send it again
+        txBufferInit(outClient);
+        txBufferAppend(static_cast<char>(0x40));
+        txBufferAppend(static_cast<char>(2));
+        txBufferAppend(static_cast<char>(body[pos]));
+        txBufferAppend(static_cast<char>(body[pos + 1]));
+        txBufferFlush();
+        pos += 2;
+    }
+    if (pos >= length) { return; }
+    const char* command = reinterpret_cast<const char*>(body + pos);
+    MS_DBG(F("Command from the broker:"), command);
+    uint32_t fromUTC;
+    uint32_t toUTC;
+    if (parseBackfillRange(command, fromUTC, toUTC)) {
+        _baseLogger->requestBackfill(this, fromUTC, toUTC);
+    }
+}
+#endif
@@ -0,0 +1,324 @@
+/**
+ * @file MQTTPublisher.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the MQTTPublisher subclass of dataPublisher for publishing
+ * data to any MQTT broker.
+ */
+
+// Header Guards
+#ifndef SRC_PUBLISHERS_MQTTPUBLISHER_H_
+#define SRC_PUBLISHERS_MQTTPUBLISHER_H_
+
+// Debugging Statement
+// #define MS_MQTTPUBLISHER_DEBUG
+
+#ifdef MS_MQTTPUBLISHER_DEBUG
+#define MS_DEBUGGING_STD "MQTTPublisher"
+#endif
+
+/**
+ * @def MS_MQTT_TOPIC_SIZE
+ * @brief The size of the buffer for the topic, after the logger ID and
+ * sampling feature UUID are filled into the template.
+ *
+ * @ingroup the_publishers
+ */
+#ifndef MS_MQTT_TOPIC_SIZE
+#define MS_MQTT_TOPIC_SIZE 64
+#endif
+
+/**
+ * @def MS_MQTT_PACKET_SIZE
+ * @brief The most bytes kept of each packet from the broker; the rest of a
+ * longer packet is read and thrown out.
+ *
+ * @ingroup the_publishers
+ */
+#ifndef MS_MQTT_PACKET_SIZE
+#define MS_MQTT_PACKET_SIZE 64
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "dataPublisherBase.h"
+
+
+// ============================================================================
+//  Functions for any MQTT broker
+// ============================================================================
+/**
+ * @brief The MQTTPublisher subclass of dataPublisher publishes each record to
+ * an MQTT broker of your own.
+ *
+ * The MQTT 3.1.1 packets are written straight into the shared publisher TX
+ * buffer rather than through PubSubClient and its own buffer.  Each record is
+ * published with QoS 1 as a JSON object of the timestamp and the value for
+ * each variable UUID:
+ * @code{.json}
+ * {"timestamp":"2024-01-01T12:00:00-05:00","<variable UUID>":12.5}
+ * @endcode
+ *
+ * The logger ID is used as the client ID and the session isn't cleaned, so
+ * the broker keeps the session while the logger sleeps.  The connect and all
+ * of the publishes are sent before waiting for any acknowledgements, and with
+ * #MS_PUBLISHER_OUTBOX every waiting record is published in the same
+ * connection; records the broker doesn't acknowledge stay in the outbox.
+ *
+ * In the topic template "{id}" is replaced with the logger ID and "{uuid}"
+ * with the sampling feature UUID.
+ *
+ * With #MS_LOGGER_BACKFILL the publisher can also subscribe to a command
+ * topic (setCommandTopic()).  Since the session is kept, QoS 1 commands sent
+ * while the logger sleeps are delivered on its next connection; each is
+ * acknowledged and its `<from>,<to>` range handed to
+ * Logger::requestBackfill().  Commands shouldn't be retained, or they're
+ * taken again on every connection.
+ *
+ * @ingroup the_publishers
+ */
+class MQTTPublisher : public dataPublisher {
+ public:
+    // Constructors
+    /**
+     * @brief Construct a new MQTT Publisher object with no members set.
+     */
+    MQTTPublisher();
+    /**
+     * @brief Construct a new MQTT Publisher object
+     *
+     * @note If a client is never specified, the publisher will attempt to
+     * create and use a client on a LoggerModem instance tied to the attached
+     * logger.
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    explicit MQTTPublisher(Logger& baseLogger, int sendEveryX = 1);
+    /**
+     * @brief Construct a new MQTT Publisher object
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param inClient An Arduino client instance to use to print data to.
+     * Allows the use of any type of client and multiple clients tied to a
+     * single TinyGSM modem instance
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    MQTTPublisher(Logger& baseLogger, Client* inClient, int sendEveryX = 1);
+    /**
+     * @brief Construct a new MQTT Publisher object
+     *
+     * @param baseLogger The logger supplying the data to be published
+     * @param inClient An Arduino client instance to use to print data to.
+     * Allows the use of any type of client and multiple clients tied to a
+     * single TinyGSM modem instance
+     * @param broker The host name of the broker
+     * @param topicTemplate The topic to publish to, with "{id}" and "{uuid}"
+     * to be replaced with the logger ID and sampling feature UUID
+     * @param port The port of the broker
+     * @param sendEveryX Interval (in units of the logging interval) between
+     * attempted data transmissions. NOTE: not implemented by this publisher!
+     */
+    MQTTPublisher(Logger& baseLogger, Client* inClient, const char* broker,
+                  const char* topicTemplate, uint16_t port = 1883,
+                  int sendEveryX = 1);
+    /**
+     * @brief Destroy the MQTT Publisher object
+     */
+    virtual ~MQTTPublisher();
+
+    // Returns the data destination
+    String getEndpoint(void) override {
+        return String(_broker);
+    }
+
+    /**
+     * @brief Set the broker to publish to
+     *
+     * @param broker The host name of the broker
+     * @param port The port of the broker
+     */
+    void setBroker(const char* broker, uint16_t port = 1883);
+    /**
+     * @brief Set the topic template
+     *
+     * @param topicTemplate The topic to publish to, with "{id}" and "{uuid}"
+     * to be replaced with the logger ID and sampling feature UUID
+     */
+    void setTopic(const char* topicTemplate);
+    /**
+     * @brief Set the user name and password for the broker
+     *
+     * @param user The user name; null for none, which is sent as an empty
+     * name if there's a password
+     * @param password The password; null for none
+     */
+    void setCredentials(const char* user, const char* password);
+#ifdef MS_LOGGER_BACKFILL
+    /**
+     * @brief Set the topic to take backfill commands from
+     * (#MS_LOGGER_BACKFILL).
+     *
+     * @param topicTemplate The topic to subscribe to, with "{id}" and "{uuid}"
+     * to be replaced with the logger ID and sampling feature UUID; null, the
+     * default, to not subscribe
+     */
+    void setCommandTopic(const char* topicTemplate);
+#endif
+
+    /**
+     * @brief Calculates how long the outgoing JSON for the current record
+     * will be
+     *
+     * @return uint16_t The number of characters in the JSON object.
+     */
+    uint16_t calculateJsonSize();
+
+    // A way to begin with everything already set
+    /**
+     * @copydoc dataPublisher::begin(Logger& baseLogger, Client* inClient)
+     * @param broker The host name of the broker
+     * @param topicTemplate The topic to publish to
+     * @param port The port of the broker
+     */
+    void begin(Logger& baseLogger, Client* inClient, const char* broker,
+               const char* topicTemplate, uint16_t port = 1883);
+    /**
+     * @copydoc dataPublisher::begin(Logger& baseLogger)
+     * @param broker The host name of the broker
+     * @param topicTemplate The topic to publish to
+     * @param port The port of the broker
+     */
+    void begin(Logger& baseLogger, const char* broker,
+               const char* topicTemplate, uint16_t port = 1883);
+
+    /**
+     * @brief Connect to the broker, publish the record, and wait for the
+     * broker to acknowledge it.
+     *
+     * This depends on an internet connection already having been made and a
+     * client being available.
+     *
+     * @param outClient An Arduino client instance to use to print data to.
+     * Allows the use of any type of client and multiple clients tied to a
+     * single TinyGSM modem instance
+     * @return **int16_t** The number of records the broker acknowledged, or
+     * the negative CONNACK return code if the connection was refused.
+     */
+    int16_t publishData(Client* outClient) override;
+    /**
+     * @copydoc dataPublisher::publishSucceeded(int16_t)
+     *
+     * Publishing succeeds when every record sent was acknowledged.
+     */
+    bool publishSucceeded(int16_t result) override {
+        return result > 0 && result == _recordsSent;
+    }
+#ifdef MS_PUBLISHER_RETRY
+    /**
+     * @copydoc dataPublisher::classifyResult(int16_t)
+     *
+     * A refused connection is a rejection, and records the broker didn't
+     * acknowledge are a server error.
+     */
+    publishOutcome classifyResult(int16_t result) override {
+        if (publishSucceeded(result)) { return PUBLISH_SUCCEEDED; }
+        if (result == 0) { return PUBLISH_NO_CONNECTION; }
+        return result < 0 ? PUBLISH_REJECTED : PUBLISH_SERVER_ERROR;
+    }
+#endif
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @copydoc dataPublisher::publishesBatches()
+     *
+     * Each record is published as its own message in the same connection.
+     */
+    bool publishesBatches(void) override {
+        return true;
+    }
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @copydoc dataPublisher::sendsRequestsAhead()
+     */
+    bool sendsRequestsAhead(void) override {
+        return true;
+    }
+#endif
+
+ protected:
+    /**
+     * @brief Connect to the broker and send the CONNECT packet and a QoS 1
+     * PUBLISH packet for each record, without waiting for the
+     * acknowledgements.
+     *
+     * @param outClient The client to send the packets on
+     * @return **bool** True if the packets were sent.
+     */
+    bool startRequest(Client* outClient) override;
+    /**
+     * @brief Read the CONNACK and PUBACK packets for the packets sent by
+     * startRequest(), then disconnect from the broker.
+     *
+     * @param outClient The client the packets were sent on
+     * @param requestSent The value returned by startRequest()
+     * @return **int16_t** The number of records acknowledged, or the negative
+     * CONNACK return code if the connection was refused.
+     */
+    int16_t finishResponse(Client* outClient, bool requestSent) override;
+
+ private:
+    /**
+     * @brief Fill the logger ID and sampling feature UUID into a topic
+     * template.
+     *
+     * @param topic The buffer for the topic, #MS_MQTT_TOPIC_SIZE long
+     * @param topicTemplate The template
+     */
+    void makeTopic(char* topic, const char* topicTemplate);
+#ifdef MS_LOGGER_BACKFILL
+    /**
+     * @brief Acknowledge a PUBLISH packet from the broker and take the
+     * backfill command in it.
+     *
+     * @param outClient The client connected to the broker
+     * @param flags The fixed header byte of the packet
+     * @param body The rest of the packet, null terminated
+     * @param length The number of bytes of the body kept
+     */
+    void takeCommand(Client* outClient, uint8_t flags, uint8_t* body,
+                     uint16_t length);
+#endif
+    /**
+     * @brief Append an MQTT remaining length to the TX buffer.
+     *
+     * @param length The number of bytes after the fixed header
+     */
+    static void txBufferAppendLength(uint32_t length);
+    /**
+     * @brief Append an MQTT string, with its two byte length, to the TX
+     * buffer.
+     *
+     * @param s The null-terminated string to append.
+     */
+    static void txBufferAppendMQTTString(const char* s);
+
+    const char* _broker        = nullptr;
+    uint16_t    _port          = 1883;
+    const char* _topicTemplate = "{id}/data";
+    const char* _user          = nullptr;
+    const char* _password      = nullptr;
+    uint16_t    _packetId      = 0;
+    uint16_t    _firstPacketId = 0;
+    int16_t     _recordsSent   = 0;
+#ifdef MS_LOGGER_BACKFILL
+    const char* _commandTopic = nullptr;
+#endif
+};
+
+#endif  // SRC_PUBLISHERS_MQTTPUBLISHER_H_
@@ -22,6 +22,14 @@ const char* ThingSpeakPublisher::mqttServer     = "mqtt.thingspeak.com";
 const int   ThingSpeakPublisher::mqttPort       = 1883;
 const char* ThingSpeakPublisher::mqttClientName = THING_SPEAK_CLIENT_NAME;
 const char* ThingSpeakPublisher::mqttUser       = THING_SPEAK_USER_NAME;
+#ifdef MS_PUBLISHER_OUTBOX
+const char* ThingSpeakPublisher::bulkHost      = "api.thingspeak.com";
+const int   ThingSpeakPublisher::bulkPort      = 80;
+const char* ThingSpeakPublisher::bulkKeyTag    = "{\"write_api_key\":\"";
+const char* ThingSpeakPublisher::bulkUpdateTag = "\",\"updates\":[";
+const char  ThingSpeakPublisher::bulkRequestHost[] PROGMEM =
+    "/bulk_update.json HTTP/1.1\r\nHost: api.thingspeak.com";
+#endif
 
 
 // Constructors
@@ -100,19 +108,120 @@ void ThingSpeakPublisher::begin(Logger&     baseLogger,
 }
 
 
+#ifdef MS_PUBLISHER_OUTBOX
+// Calculates how long the bulk update JSON will be
+uint16_t ThingSpeakPublisher::calculateBulkJsonSize() {
+    uint8_t  numChannels = min(viewSize(), 8);
+    uint8_t  records     = _baseLogger->getReplayRecordCount();
+    uint16_t jsonLength  = 18;  // {"write_api_key":"
+    jsonLength += strlen(_thingSpeakChannelKey);
+    jsonLength += 13;  // ","updates":[
+    for (uint8_t j = 0; j < records; j++) {
+        _baseLogger->loadReplayRecord(j);
+        jsonLength += 15;  // {"created_at":"
+        jsonLength += strlen(Logger::getMarkedTimeISO8601());
+        jsonLength += 1;  // "
+        for (uint8_t slot = 0; slot < numChannels; slot++) {
+            jsonLength += 10;  // ,"fieldN":
+            jsonLength += strlen(_baseLogger->getValueCharsAtI(
+                viewPosition(slot)));
+        }
+        jsonLength += 1;  // }
+        if (j + 1 != records) {
+            jsonLength += 1;  // ,
+        }
+    }
+    jsonLength += 2;  // ]}
+    return jsonLength;
+}
+
+
+// This posts all of the records from the outbox to the bulk update API
+bool ThingSpeakPublisher::startRequest(Client* outClient) {
+    char    tempBuffer[12] = "";
+    uint8_t numChannels    = min(viewSize(), 8);
+    uint8_t records        = _baseLogger->getReplayRecordCount();
+
+    MS_DBG(F("Sending"), records, F("records in one bulk update"));
+    MS_DBG(F("Connecting client"));
+    MS_START_DEBUG_TIMER;
+    if (connectClient(outClient, bulkHost, bulkPort)) {
+        MS_DBG(F("Client connected after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+        txBufferInit(outClient);
+
+        txBufferAppend(postHeader);
+        txBufferAppend("/channels/");
+        txBufferAppend(_thingSpeakChannelID);
+        txBufferAppend_P(bulkRequestHost);
+#ifdef MS_PUBLISHER_CHUNKED
+        txBufferAppend(transferEncodingHeader);
+        txBufferAppend("\r\nContent-Type: application/json\r\n\r\n");
+        txBufferStartChunks();
+#else
+        txBufferAppend("\r\nContent-Length: ");
+        itoa(calculateBulkJsonSize(), tempBuffer, 10);  // BASE 10
+        txBufferAppend(tempBuffer);
+        txBufferAppend("\r\nContent-Type: application/json\r\n\r\n");
+#endif
+
+        txBufferAppend(bulkKeyTag);
+        txBufferAppend(_thingSpeakChannelKey);
+        txBufferAppend(bulkUpdateTag);
+        for (uint8_t j = 0; j < records; j++) {
+            _baseLogger->loadReplayRecord(j);
+            txBufferAppend("{\"created_at\":\"");
+            txBufferAppend(Logger::getMarkedTimeISO8601());
+            txBufferAppend('"');
+            for (uint8_t slot = 0; slot < numChannels; slot++) {
+                txBufferAppend(",\"field");
+                itoa(slot + 1, tempBuffer, 10);  // BASE 10
+                txBufferAppend(tempBuffer);
+                txBufferAppend("\":");
+                txBufferAppend(
+                    _baseLogger->getValueCharsAtI(viewPosition(slot)));
+            }
+            txBufferAppend('}');
+            if (j + 1 != records) { txBufferAppend(','); }
+        }
+        txBufferAppend(']');
+        txBufferAppend('}');
+
+#ifdef MS_PUBLISHER_CHUNKED
+        txBufferEndChunks();
+#else
+        txBufferFlush();
+#endif
+        return true;
+    } else {
+        PRINTOUT(F("\n -- Unable to Establish Connection to ThingSpeak --"));
+    }
+    return false;
+}
+#endif
+
+
 // This sends the data to ThingSpeak
 // bool ThingSpeakPublisher::mqttThingSpeak(void)
 int16_t ThingSpeakPublisher::publishData(Client* outClient) {
     bool retVal = false;
 
+#ifdef MS_PUBLISHER_OUTBOX
+    // A backlog from the outbox goes in one http bulk update instead of one
+    // MQTT message per record
+    if (_baseLogger->getReplayRecordCount() > 1) {
+        int16_t response = finishResponse(outClient, startRequest(outClient));
+        return dataPublisher::publishSucceeded(response);
+    }
+#endif
+
     // Make sure we don't have too many fields
     // A channel can have a max of 8 fields
-    if (_baseLogger->getArrayVarCount() > 8) {
+    if (viewSize() > 8) {
         MS_DBG(F("No more than 8 fields of data can be sent to a single "
                  "ThingSpeak channel!"));
         MS_DBG(F("Only the first 8 fields worth of data will be sent."));
     }
-    uint8_t numChannels = min(_baseLogger->getArrayVarCount(), 8);
+    uint8_t numChannels = min(viewSize(), 8);
     MS_DBG(numChannels, F("fields will be sent to ThingSpeak"));
 
     // Create a buffer for the portions of the request and response
@@ -133,21 +242,31 @@ int16_t ThingSpeakPublisher::publishData(Client* outClient) {
     txBufferInit(nullptr);
 
     txBufferAppend("created_at=");
-    txBufferAppend(
-        Logger::formatDateTime_ISO8601(Logger::markedLocalEpochTime).c_str());
+    txBufferAppend(Logger::getMarkedTimeISO8601());
 
-    for (uint8_t i = 0; i < numChannels; i++) {
+    for (uint8_t slot = 0; slot < numChannels; slot++) {
         txBufferAppend("&field");
-        itoa(i + 1, tempBuffer, 10);  // BASE 10
+        itoa(slot + 1, tempBuffer, 10);  // BASE 10
         txBufferAppend(tempBuffer);
         txBufferAppend('=');
-        txBufferAppend(_baseLogger->getValueStringAtI(i).c_str());
+        txBufferAppend(_baseLogger->getValueCharsAtI(viewPosition(slot)));
     }
     MS_DBG(F("Message ["), strlen(txBuffer), F("]:"), String(txBuffer));
 
     // Set the client connection parameters
     _mqttClient.setClient(*outClient);
+#ifdef MS_PUBLISHER_DNS_CACHE
+    // Connect to the broker by its kept address, if there is one
+    IPAddress mqttAddress;
+    bool      byAddress = lookupHost(mqttServer, mqttAddress);
+    if (byAddress) {
+        _mqttClient.setServer(mqttAddress, mqttPort);
+    } else {
+        _mqttClient.setServer(mqttServer, mqttPort);
+    }
+#else
     _mqttClient.setServer(mqttServer, mqttPort);
+#endif
 
     // Make sure any previous TCP connections are closed
     // NOTE:  The PubSubClient library used for MQTT connect assumes that as
@@ -177,6 +296,10 @@ int16_t ThingSpeakPublisher::publishData(Client* outClient) {
     } else {
         PRINTOUT(F("MQTT connection failed with state:"),
                  parseMQTTState(_mqttClient.state()));
+#ifdef MS_PUBLISHER_DNS_CACHE
+        // The broker may have moved
+        if (byAddress) { forgetHost(mqttServer); }
+#endif
         delay(1000);
         retVal = false;
     }
@@ -59,6 +59,10 @@
  * be "Field3".  Any text names you have given to your fields in ThingSpeak are
  * also irrelevant.
  *
+ * With #MS_PUBLISHER_VIEWS, a view (dataPublisher::setVariableView()) picks
+ * the variable for each field instead: the first position in the view is
+ * sent as Field1, the second as Field2, and so on.
+ *
  * @ingroup the_publishers
  */
 class ThingSpeakPublisher : public dataPublisher {
@@ -187,6 +191,41 @@ class ThingSpeakPublisher : public dataPublisher {
     // This sends the data to ThingSpeak
     // bool mqttThingSpeak(void);
     int16_t publishData(Client* outClient) override;
+    /**
+     * @copydoc dataPublisher::publishSucceeded(int16_t)
+     *
+     * ThingSpeak publishing returns true (1) when the MQTT message is sent.
+     */
+    bool publishSucceeded(int16_t result) override {
+        return result == 1;
+    }
+#ifdef MS_PUBLISHER_RETRY
+    /**
+     * @copydoc dataPublisher::classifyResult(int16_t)
+     *
+     * An MQTT message that isn't sent is a connection failure.
+     */
+    publishOutcome classifyResult(int16_t result) override {
+        return result == 1 ? PUBLISH_SUCCEEDED : PUBLISH_NO_CONNECTION;
+    }
+#endif
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @copydoc dataPublisher::publishesBatches()
+     *
+     * Several records are sent over http in one request to ThingSpeak's bulk
+     * update API, with the channel's write API key, instead of over MQTT.
+     */
+    bool publishesBatches(void) override {
+        return true;
+    }
+    /**
+     * @brief Calculates how long the outgoing bulk update JSON will be
+     *
+     * @return uint16_t The number of characters in the JSON object.
+     */
+    uint16_t calculateBulkJsonSize();
+#endif
 
  protected:
     /**
@@ -200,6 +239,33 @@ class ThingSpeakPublisher : public dataPublisher {
     static const char* mqttClientName;  ///< The MQTT client name
     static const char* mqttUser;        ///< The MQTT user name
                                         /**@}*/
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @anchor ts_bulk_vars
+     * @name Portions of the http bulk update request
+     *
+     * @{
+     */
+    static const char* bulkHost;       ///< The http API host
+    static const int   bulkPort;       ///< The http API port
+    static const char* bulkKeyTag;     ///< The start of the JSON, to the key
+    static const char* bulkUpdateTag;  ///< The start of the list of updates
+    /**
+     * @brief The end of the bulk update request line and the host header,
+     * kept in flash and sent in one piece
+     */
+    static const char bulkRequestHost[];
+    /**@}*/
+
+    /**
+     * @brief Send the records from the outbox in one bulk update request,
+     * without waiting for the response.
+     *
+     * @param outClient The client to send the request on
+     * @return **bool** True if the request was sent.
+     */
+    bool startRequest(Client* outClient) override;
+#endif
 
  private:
     // Keys for ThingSpeak
@@ -29,6 +29,8 @@ const char* UbidotsPublisher::tokenHeader  = "\r\nX-Auth-Token: ";
 const char* UbidotsPublisher::contentLengthHeader = "\r\nContent-Length: ";
 const char* UbidotsPublisher::contentTypeHeader =
     "\r\nContent-Type: application/json\r\n\r\n";
+const char UbidotsPublisher::requestHostTag[] PROGMEM =
+    "/ HTTP/1.1\r\nHost: industrial.api.ubidots.com\r\nX-Auth-Token: ";
 
 const char* UbidotsPublisher::payload = "{";
 
@@ -64,28 +66,68 @@ void UbidotsPublisher::setToken(const char* authentificationToken) {
     _authentificationToken = authentificationToken;
     MS_DBG(F("Registration token set!"));
 }
+void UbidotsPublisher::setPort(uint16_t port) {
+    _port = port;
+}
+
+
+// This is the number of outbox records being sent, or the one current record
+uint8_t UbidotsPublisher::recordCount(void) {
+#ifdef MS_PUBLISHER_OUTBOX
+    uint8_t records = _baseLogger->getReplayRecordCount();
+    if (records > 1) { return records; }
+#endif
+    return 1;
+}
 
 
 // Calculates how long the JSON will be
 uint16_t UbidotsPublisher::calculateJsonSize() {
+    uint8_t  records    = recordCount();
     uint16_t jsonLength = 1;  // {
     // jsonLength += 36;          // sampling feature UUID
     // jsonLength += 15;          // ","timestamp":"
     // jsonLength += 25;          // markedISO8601Time
     // jsonLength += 2;           //  ",
-    for (uint8_t i = 0; i < _baseLogger->getArrayVarCount(); i++) {
+    uint8_t included = 0;
+    for (uint8_t slot = 0; slot < viewSize(); slot++) {
+        uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+        if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+        included++;
         jsonLength += 1;  //  "
-        jsonLength +=
-            _baseLogger->getVarUUIDAtI(i).length();  // parameter ID length
-        jsonLength += 11;                            //  ":{"value":
-        jsonLength += _baseLogger->getValueStringAtI(i).length();
-        jsonLength += 13;  // ,"timestamp":
-        jsonLength += 13;  // epoch time in milliseconds
-        if (i + 1 != _baseLogger->getArrayVarCount()) {
-            jsonLength += 2;  // ,
+        // parameter ID length
+        jsonLength += strlen(_baseLogger->getVarUUIDCharsAtI(i));
+        jsonLength += 2;  //  ":
+        if (records > 1) {
+            jsonLength += 2;            // [ ]
+            jsonLength += records - 1;  // , between the records
+        }
+        jsonLength += 9 * records;   //  {"value":
+        jsonLength += 13 * records;  // ,"timestamp":
+        jsonLength += 13 * records;  // epoch time in milliseconds
+        jsonLength += records;       // }
+        if (records == 1) {
+            jsonLength += strlen(_baseLogger->getValueCharsAtI(i));
         }
+        jsonLength += 1;  // , or the final }
     }
-    jsonLength += 2;  // }
+    if (included == 0) { jsonLength += 1; }  // }
+
+#ifdef MS_PUBLISHER_OUTBOX
+    // The lengths of the values of each record, reading each record once
+    for (uint8_t j = 0; records > 1 && j < records; j++) {
+        _baseLogger->loadReplayRecord(j);
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+            if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+            jsonLength += strlen(_baseLogger->getValueCharsAtI(i));
+        }
+    }
+#endif
 
     return jsonLength;
 }
@@ -114,16 +156,35 @@ void UbidotsPublisher::begin(Logger&     baseLogger,
 // The return is the http status code of the response.
 // int16_t EnviroDIYPublisher::postDataEnviroDIY(void)
 int16_t UbidotsPublisher::publishData(Client* outClient) {
-    // Create a buffer for the portions of the request and response
-    char     tempBuffer[37] = "";
-    uint16_t did_respond    = 0;
+#ifdef MS_MODEM_NATIVE_HTTP
+    // Post through the modem's own HTTP client if it has one
+    char path[64] = "";
+    snprintf(path, sizeof(path), "%s%s/", postEndpoint,
+             _baseLogger->getSamplingFeatureUUID());
+    if (modemPostStart(ubidotsHost, _port, path, calculateJsonSize(),
+                       "X-Auth-Token", _authentificationToken)) {
+        writeJsonBody();
+        return modemPostFinish();
+    }
+#endif
+    return finishResponse(outClient, startRequest(outClient));
+}
+
+
+// This opens the connection and sends the whole request, leaving the response
+// to be read by finishResponse()
+bool UbidotsPublisher::startRequest(Client* outClient) {
+#ifndef MS_PUBLISHER_CHUNKED
+    // Create a buffer for the portions of the request
+    char tempBuffer[37] = "";
 
     MS_DBG(F("Outgoing JSON size:"), calculateJsonSize());
+#endif
 
     // Open a TCP/IP connection to the Enviro DIY Data Portal (WebSDL)
     MS_DBG(F("Connecting client"));
     MS_START_DEBUG_TIMER;
-    if (outClient->connect(ubidotsHost, ubidotsPort)) {
+    if (connectClient(outClient, ubidotsHost, _port)) {
         MS_DBG(F("Client connected after"), MS_PRINT_DEBUG_TIMER, F("ms\n"));
         txBufferInit(outClient);
 
@@ -131,78 +192,104 @@ int16_t UbidotsPublisher::publishData(Client* outClient) {
         txBufferAppend(postHeader);
         txBufferAppend(postEndpoint);
         txBufferAppend(_baseLogger->getSamplingFeatureUUID());
-        txBufferAppend('/');
-        txBufferAppend(HTTPtag);
 
-        // add the rest of the HTTP POST headers to the outgoing buffer
-        txBufferAppend(hostHeader);
-        txBufferAppend(ubidotsHost);
-        txBufferAppend(tokenHeader);
+        // add the unchanging rest of the headers up to the token
+        txBufferAppend_P(requestHostTag);
         txBufferAppend(_authentificationToken);
 
+#ifdef MS_PUBLISHER_CHUNKED
+        // the body is sent in chunks instead of being counted first
+        txBufferAppend(transferEncodingHeader);
+        txBufferAppend(contentTypeHeader);
+        txBufferStartChunks();
+#else
         txBufferAppend(contentLengthHeader);
         itoa(calculateJsonSize(), tempBuffer, 10);  // BASE 10
         txBufferAppend(tempBuffer);
 
         txBufferAppend(contentTypeHeader);
+#endif
 
-        // put the start of the JSON into the outgoing response_buffer
-        txBufferAppend(payload);
-
-        for (uint8_t i = 0; i < _baseLogger->getArrayVarCount(); i++) {
-            txBufferAppend('"');
-            txBufferAppend(_baseLogger->getVarUUIDAtI(i).c_str());
-            txBufferAppend("\":{\"value\":");
-            txBufferAppend(_baseLogger->getValueStringAtI(i).c_str());
-            txBufferAppend(",\"timestamp\":");
-            ltoa(Logger::markedUTCEpochTime, tempBuffer, 10);  // BASE 10
-            txBufferAppend(tempBuffer);
-            txBufferAppend("000}");
-            if (i + 1 != _baseLogger->getArrayVarCount()) {
-                txBufferAppend(',');
-            } else {
-                txBufferAppend('}');
-            }
-        }
+        writeJsonBody();
 
         // Flush the complete request
+#ifdef MS_PUBLISHER_CHUNKED
+        txBufferEndChunks();
+#else
         txBufferFlush();
+#endif
 
-        // Wait 10 seconds for a response from the server
-        uint32_t start = millis();
-        while ((millis() - start) < 10000L && outClient->available() < 12) {
-            delay(10);
-        }
-
-        // Read only the first 12 characters of the response
-        // We're only reading as far as the http code, anything beyond that
-        // we don't care about.
-        did_respond = outClient->readBytes(tempBuffer, 12);
-
-        // Close the TCP/IP connection
-        MS_DBG(F("Stopping client"));
-        MS_RESET_DEBUG_TIMER;
-        outClient->stop();
-        MS_DBG(F("Client stopped after"), MS_PRINT_DEBUG_TIMER, F("ms"));
+        return true;
     } else {
         PRINTOUT(F("\n -- Unable to Establish Connection to Ubiots --"));
     }
+    return false;
+}
 
-    // Process the HTTP response
-    int16_t responseCode = 0;
-    if (did_respond > 0) {
-        char responseCode_char[4];
-        responseCode_char[3] = 0;
-        for (uint8_t i = 0; i < 3; i++) {
-            responseCode_char[i] = tempBuffer[i + 9];
-        }
-        responseCode = atoi(responseCode_char);
-    } else {
-        responseCode = 504;
-    }
 
-    PRINTOUT(F("\n-- Response Code --"));
-    PRINTOUT(responseCode);
+// This writes the JSON object for the record, or the outbox records, into
+// the tx buffer
+void UbidotsPublisher::writeJsonBody(void) {
+    // Create a buffer for the timestamps
+    char tempBuffer[12] = "";
+
+    // put the start of the JSON into the outgoing response_buffer
+    txBufferAppend(payload);
 
-    return responseCode;
+    // Several records from the outbox are sent as a list of values and
+    // timestamps for each variable
+    uint8_t records = recordCount();
+    bool    first   = true;
+#ifdef MS_PUBLISHER_OUTBOX
+    // Read each record once and keep its time and the values to send, rather
+    // than reading it again for every variable
+    bool     replay = records > 1;
+    uint32_t times[records];
+    float    values[records * viewSize()];
+    for (uint8_t j = 0; replay && j < records; j++) {
+        _baseLogger->loadReplayRecord(j);
+        times[j] = Logger::markedUTCEpochTime;
+        for (uint8_t slot = 0; slot < viewSize(); slot++) {
+            values[j * viewSize() + slot] =
+                _baseLogger->getRecordValueAtI(viewPosition(slot));
+        }
+    }
+#endif
+    for (uint8_t slot = 0; slot < viewSize(); slot++) {
+        uint8_t i = viewPosition(slot);
+#ifdef MS_PUBLISH_ON_CHANGE
+        // Leave out the variables that haven't changed
+        if (!_baseLogger->isChangedAtI(i)) { continue; }
+#endif
+        if (!first) { txBufferAppend(','); }
+        first = false;
+        txBufferAppend('"');
+        txBufferAppend(_baseLogger->getVarUUIDCharsAtI(i));
+        txBufferAppend("\":");
+        if (records > 1) { txBufferAppend('['); }
+        for (uint8_t j = 0; j < records; j++) {
+            uint32_t    recordTime = Logger::markedUTCEpochTime;
+            const char* value;
+#ifdef MS_PUBLISHER_OUTBOX
+            if (replay) {
+                recordTime = times[j];
+                value      = _baseLogger->formatValueAtI(
+                    i, values[j * viewSize() + slot]);
+            } else {
+                value = _baseLogger->getValueCharsAtI(i);
+            }
+#else
+            value = _baseLogger->getValueCharsAtI(i);
+#endif
+            txBufferAppend("{\"value\":");
+            txBufferAppend(value);
+            txBufferAppend(",\"timestamp\":");
+            ltoa(recordTime, tempBuffer, 10);  // BASE 10
+            txBufferAppend(tempBuffer);
+            txBufferAppend("000}");
+            if (j + 1 != records) { txBufferAppend(','); }
+        }
+        if (records > 1) { txBufferAppend(']'); }
+    }
+    txBufferAppend('}');
 }
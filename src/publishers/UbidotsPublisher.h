@@ -120,6 +120,13 @@ class UbidotsPublisher : public dataPublisher {
      * specific device's setup panel).
      */
     void setToken(const char* authentificationToken);
+    /**
+     * @brief Set the port to post to Ubidots on
+     *
+     * @param port The port; 443 when the publisher's client is a secure
+     * client, or the default of 80
+     */
+    void setPort(uint16_t port);
 
     /**
      * @brief Calculates how long the outgoing JSON will be
@@ -167,8 +174,32 @@ class UbidotsPublisher : public dataPublisher {
      * @return **int16_t** The http status code of the response.
      */
     int16_t publishData(Client* outClient) override;
+#ifdef MS_PUBLISHER_OUTBOX
+    /**
+     * @copydoc dataPublisher::publishesBatches()
+     *
+     * Several records are sent with a list of values and timestamps for each
+     * variable.
+     */
+    bool publishesBatches(void) override {
+        return true;
+    }
+#endif
+#ifdef MS_PUBLISHER_PARALLEL
+    /**
+     * @copydoc dataPublisher::sendsRequestsAhead()
+     */
+    bool sendsRequestsAhead(void) override {
+        return true;
+    }
+#endif
 
  protected:
+    /**
+     * @copydoc dataPublisher::startRequest(Client* outClient)
+     */
+    bool startRequest(Client* outClient) override;
+
     /**
      * @anchor ubidots_post_vars
      * @name Portions of the POST request to Ubidots
@@ -177,10 +208,15 @@ class UbidotsPublisher : public dataPublisher {
      */
     static const char* postEndpoint;         ///< The endpoint
     static const char* ubidotsHost;          ///< The host name
-    static const int   ubidotsPort;          ///< The host port
+    static const int   ubidotsPort;          ///< The default host port
     static const char* tokenHeader;          ///< The token header text
     static const char* contentLengthHeader;  ///< The content length header text
     static const char* contentTypeHeader;    ///< The content type header text
+    /**
+     * @brief The end of the request line, the host, and the token header up
+     * to the token, kept in flash and sent in one piece
+     */
+    static const char requestHostTag[];
     /**@}*/
 
     /**
@@ -193,8 +229,20 @@ class UbidotsPublisher : public dataPublisher {
                                  /**@}*/
 
  private:
+    /**
+     * @brief The number of records to send in the request
+     *
+     * @return **uint8_t** The number of outbox records being sent, or 1.
+     */
+    uint8_t recordCount(void);
+    /**
+     * @brief Write the JSON body of the request into the TX buffer.
+     */
+    void writeJsonBody(void);
+
     // Tokens for Ubidots
     const char* _authentificationToken = nullptr;
+    uint16_t    _port                  = ubidotsPort;
 };
 
 #endif  // SRC_PUBLISHERS_UBIDOTSPUBLISHER_H_
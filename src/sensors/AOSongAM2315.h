@@ -113,11 +113,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "relativeHumidity"
-#define AM2315_HUMIDITY_VAR_NAME "relativeHumidity"
+#define AM2315_HUMIDITY_VAR_NAME MS_VAR_TEXT("relativeHumidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
 /// (percent relative humidity)
-#define AM2315_HUMIDITY_UNIT_NAME "percent"
+#define AM2315_HUMIDITY_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "AM2315Humidity"
 #define AM2315_HUMIDITY_DEFAULT_CODE "AM2315Humidity"
 /**@}*/
@@ -140,11 +140,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define AM2315_TEMP_VAR_NAME "temperature"
+#define AM2315_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define AM2315_TEMP_UNIT_NAME "degreeCelsius"
+#define AM2315_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "AM2315Temp"
 #define AM2315_TEMP_DEFAULT_CODE "AM2315Temp"
 /**@}*/
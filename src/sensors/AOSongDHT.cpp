@@ -32,6 +32,9 @@ bool AOSongDHT::setup(void) {
 
 
 String AOSongDHT::getSensorName(void) {
+    return getSensorNameChars();
+}
+const char* AOSongDHT::getSensorNameChars(void) {
     switch (_dhtType) {
         case 11: return "AOSongDHT11";
         case 12: return "AOSongDHT12";
@@ -41,6 +44,41 @@ String AOSongDHT::getSensorName(void) {
 }
 
 
+bool AOSongDHT::startSingleMeasurement(void) {
+    _readDone = false;
+    return Sensor::startSingleMeasurement();
+}
+
+
+// Read the sensor once the measurement time is up and, if the read failed,
+// come back for another try later instead of waiting for it
+bool AOSongDHT::isMeasurementComplete(bool debug) {
+    if (!Sensor::isMeasurementComplete(debug)) return false;
+    // Nothing to read if the measurement didn't start or was already read
+    if (!bitRead(_sensorStatus, 6) || _readDone) return true;
+    if (readSensor() || _readDone) return true;
+    MS_DBG(F("  Failed to read from DHT sensor, Retrying..."));
+    nextMeasurementStep(DHT_RETRY_INTERVAL_MS);
+    return false;
+}
+
+
+bool AOSongDHT::readSensor(void) {
+    // Reading temperature or humidity takes about 250 milliseconds!
+    // First read the humidity
+    _humidity = dht_internal.readHumidity();
+    // Read temperature as Celsius (the default)
+    _temperature = dht_internal.readTemperature();
+    // Check if any reads failed
+    // If they are NaN (not a number) then something went wrong
+    // NOTE:  Each retry is a measurement step, so the step is the number of
+    // reads that came before this one.
+    bool success = !isnan(_humidity) && !isnan(_temperature);
+    _readDone    = success || _measurementStep + 1 >= DHT_READ_ATTEMPTS;
+    return success;
+}
+
+
 bool AOSongDHT::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -52,35 +90,23 @@ bool AOSongDHT::addSingleMeasurementResult(void) {
     // Check a measurement was *successfully* started (status bit 6 set)
     // Only go on to get a result if it was
     if (bitRead(_sensorStatus, 6)) {
-        // Reading temperature or humidity takes about 250 milliseconds!
-        // Make 5 attempts to get a decent reading
-        for (uint8_t i = 0; i < 5; i++) {
-            MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
-            // First read the humidity
-            humid_val = dht_internal.readHumidity();
-            // Read temperature as Celsius (the default)
-            temp_val = dht_internal.readTemperature();
-            // Check if any reads failed
-            // If they are NaN (not a number) then something went wrong
-            if (!isnan(humid_val) && !isnan(temp_val)) {
-                // Compute heat index in Celsius (isFahreheit = false)
-                hi_val = dht_internal.computeHeatIndex(temp_val, humid_val,
-                                                       false);
-                MS_DBG(F("  Temp:"), temp_val, F("°C"));
-                MS_DBG(F("  Humidity:"), humid_val, '%');
-                MS_DBG(F("  Calculated Heat Index:"), hi_val, F("°C"));
-                success = true;
-                break;
-            } else {
-                if (i < 4) {
-                    MS_DBG(F("  Failed to read from DHT sensor, Retrying..."));
-                    delay(100);
-                } else {
-                    MS_DBG(F("  Failed to read from DHT sensor!"));
-                    if (isnan(humid_val)) humid_val = -9999;
-                    if (isnan(temp_val)) temp_val = -9999;
-                }
-            }
+        // The sensor is normally read as the measurement finishes, but read it
+        // now if that didn't happen
+        if (!_readDone) readSensor();
+
+        MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
+        if (!isnan(_humidity) && !isnan(_temperature)) {
+            humid_val = _humidity;
+            temp_val  = _temperature;
+            // Compute heat index in Celsius (isFahreheit = false)
+            hi_val = dht_internal.computeHeatIndex(temp_val, humid_val, false);
+            MS_DBG(F("  Temp:"), temp_val, F("°C"));
+            MS_DBG(F("  Humidity:"), humid_val, '%');
+            MS_DBG(F("  Calculated Heat Index:"), hi_val, F("°C"));
+            success = true;
+        } else {
+            MS_DBG(F("  Failed to read from DHT sensor after"),
+                   _measurementStep + 1, F("attempts!"));
         }
     } else {
         MS_DBG(getSensorNameAndLocation(), F("is not currently measuring!"));
@@ -115,6 +115,12 @@ static const uint8_t AM2301{21}; /**< AM2301 */
 /// @brief Sensor::_measurementTime_ms; DHT takes 2000ms (2s) to complete a
 /// measurement.
 #define DHT_MEASUREMENT_TIME_MS 2000
+/// @brief The number of times to try to read a DHT before giving up on a
+/// measurement.
+#define DHT_READ_ATTEMPTS 3
+/// @brief The time in ms to wait before reading a DHT again after a failed
+/// read; the DHT can't be read more often than every 2s.
+#define DHT_RETRY_INTERVAL_MS 2000
 /**@}*/
 
 /**
@@ -135,11 +141,11 @@ static const uint8_t AM2301{21}; /**< AM2301 */
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "relativeHumidity"
-#define DHT_HUMIDITY_VAR_NAME "relativeHumidity"
+#define DHT_HUMIDITY_VAR_NAME MS_VAR_TEXT("relativeHumidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
 /// (percent relative humidity or % RH)
-#define DHT_HUMIDITY_UNIT_NAME "percent"
+#define DHT_HUMIDITY_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "DHTHumidity"
 #define DHT_HUMIDITY_DEFAULT_CODE "DHTHumidity"
 /**@}*/
@@ -162,11 +168,11 @@ static const uint8_t AM2301{21}; /**< AM2301 */
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define DHT_TEMP_VAR_NAME "temperature"
+#define DHT_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (degrees Celsius, °C)
-#define DHT_TEMP_UNIT_NAME "degreeCelsius"
+#define DHT_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "DHTTemp"
 #define DHT_TEMP_DEFAULT_CODE "DHTTemp"
 /**@}*/
@@ -189,11 +195,11 @@ static const uint8_t AM2301{21}; /**< AM2301 */
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "heatIndex"
-#define DHT_HI_VAR_NAME "heatIndex"
+#define DHT_HI_VAR_NAME MS_VAR_TEXT("heatIndex")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define DHT_HI_UNIT_NAME "degreeCelsius"
+#define DHT_HI_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "DHTHI"
 #define DHT_HI_DEFAULT_CODE "DHTHI"
 /**@}*/
@@ -240,15 +246,45 @@ class AOSongDHT : public Sensor {
      * @copydoc Sensor::getSensorName()
      */
     String getSensorName(void) override;
+    /**
+     * @copydoc Sensor::getSensorNameChars()
+     */
+    const char* getSensorNameChars(void) override;
 
+    /**
+     * @copydoc Sensor::startSingleMeasurement()
+     */
+    bool startSingleMeasurement(void) override;
+    /**
+     * @brief Check if the measurement is finished, reading the DHT once the
+     * measurement time is up.
+     *
+     * If the read fails, the measurement is rescheduled to be read again in
+     * #DHT_RETRY_INTERVAL_MS, up to #DHT_READ_ATTEMPTS times, instead of
+     * waiting for the retry.
+     *
+     * @param debug True to output the result to the debugging Serial
+     * @return **bool** True if the measurement is complete.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
 
  private:
+    /**
+     * @brief Read the humidity and temperature from the DHT.
+     *
+     * @return **bool** True if both values were read.
+     */
+    bool readSensor(void);
+
     DHT     dht_internal;
     uint8_t _dhtType;
+    float   _humidity    = NAN;
+    float   _temperature = NAN;
+    bool    _readDone    = false;
 };
 
 
@@ -11,6 +11,7 @@
  */
 
 #include "AnalogElecConductivity.h"
+#include "ProcessorAnalog.h"
 
 // For Mayfly version; the battery resistor depends on it
 AnalogElecConductivity::AnalogElecConductivity(int8_t powerPin, int8_t dataPin,
@@ -42,7 +43,7 @@ float AnalogElecConductivity::readEC() {
 
 
 float AnalogElecConductivity::readEC(uint8_t analogPinNum) {
-    uint32_t sensorEC_adc;
+    float    sensorEC_adc;
     float    Rwater_ohms;      // literal value of water
     float    EC_uScm = -9999;  // units are uS per cm
 
@@ -57,14 +58,13 @@ float AnalogElecConductivity::readEC(uint8_t analogPinNum) {
 
     // First measure the analog voltage.
     // The return value from analogRead() is IN BITS NOT IN VOLTS!!
-    // Take a priming reading.
-    // First reading will be low - discard
-    analogRead(analogPinNum);
-    // Take the reading we'll keep
-    sensorEC_adc = analogRead(analogPinNum);
+    // This takes and discards a priming reading, since the first reading will
+    // be low, then averages #MS_PROCESSOR_ADC_SAMPLES readings.
+    sensorEC_adc = ProcessorAnalog::read(analogPinNum,
+                                         ANALOG_EC_ADC_RESOLUTION);
     MS_DEEP_DBG("adc bits=", sensorEC_adc);
 
-    if (0 == sensorEC_adc) {
+    if (sensorEC_adc < 1) {
         // Prevent underflow, can never be ANALOG_EC_ADC_RANGE
         sensorEC_adc = 1;
     }
@@ -206,11 +206,12 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "electricalConductivity"
-#define ANALOGELECCONDUCTIVITY_EC_VAR_NAME "electricalConductivity"
+#define ANALOGELECCONDUCTIVITY_EC_VAR_NAME MS_VAR_TEXT("electricalConductivity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define ANALOGELECCONDUCTIVITY_EC_UNIT_NAME "microsiemenPerCentimeter"
+#define ANALOGELECCONDUCTIVITY_EC_UNIT_NAME \
+    MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "anlgEc"
 #define ANALOGELECCONDUCTIVITY_EC_DEFAULT_CODE "anlgEc"
 /**@}*/
@@ -19,11 +19,10 @@
 // The constructor - need the power pin and the data pin
 ApogeeSQ212::ApogeeSQ212(int8_t powerPin, uint8_t adsChannel,
                          uint8_t i2cAddress, uint8_t measurementsToAverage)
-    : Sensor("ApogeeSQ212", SQ212_NUM_VARIABLES, SQ212_WARM_UP_TIME_MS,
-             SQ212_STABILIZATION_TIME_MS, SQ212_MEASUREMENT_TIME_MS, powerPin,
-             -1, measurementsToAverage, SQ212_INC_CALC_VARIABLES),
-      _adsChannel(adsChannel),
-      _i2cAddress(i2cAddress) {}
+    : TIADS1x15Parent("ApogeeSQ212", SQ212_NUM_VARIABLES, SQ212_WARM_UP_TIME_MS,
+                      SQ212_STABILIZATION_TIME_MS, SQ212_MEASUREMENT_TIME_MS,
+                      powerPin, adsChannel, i2cAddress, measurementsToAverage,
+                      SQ212_INC_CALC_VARIABLES) {}
 
 // Destructor
 ApogeeSQ212::~ApogeeSQ212() {}
@@ -52,6 +51,10 @@ bool ApogeeSQ212::addSingleMeasurementResult(void) {
     if (bitRead(_sensorStatus, 6)) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
+#ifdef MS_TIADS1X15_SHARED
+        // Collect the conversion queued when the measurement started
+        adcVoltage = readQueuedVoltage();
+#else
 // Create an Auxillary ADD object
 // We create and set up the ADC object here so that each sensor using
 // the ADC may set the gain appropriately without effecting others.
@@ -85,11 +88,12 @@ bool ApogeeSQ212::addSingleMeasurementResult(void) {
             ads.readADC_SingleEnded_V(_adsChannel);  // Getting the reading
         MS_DBG(F("  ads.readADC_SingleEnded_V("), _adsChannel, F("):"),
                adcVoltage);
+#endif
 
         if (adcVoltage < 3.6 && adcVoltage > -0.3) {
             // Skip results out of range
             // Apogee SQ-212 Calibration Factor = 1.0 μmol m-2 s-1 per mV
-            calibResult = 1000 * adcVoltage * SQ212_CALIBRATION_FACTOR;
+            calibResult = adcVoltage * (1000 * SQ212_CALIBRATION_FACTOR);
             MS_DBG(F("  calibResult:"), calibResult);
         } else {
             // set invalid voltages back to -9999
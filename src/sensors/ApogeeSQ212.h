@@ -87,7 +87,7 @@
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "VariableBase.h"
-#include "SensorBase.h"
+#include "TIADS1x15Parent.h"
 
 /** @ingroup sensor_sq212 */
 /**@{*/
@@ -146,11 +146,11 @@
 /// @brief Variable name in [ODM2 controlled
 /// vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "radiationIncomingPAR"
-#define SQ212_PAR_VAR_NAME "radiationIncomingPAR"
+#define SQ212_PAR_VAR_NAME MS_VAR_TEXT("radiationIncomingPAR")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microeinsteinPerSquareMeterPerSecond" (µE m-2 s-1 or µmol * m-2 s-1)
-#define SQ212_PAR_UNIT_NAME "microeinsteinPerSquareMeterPerSecond"
+#define SQ212_PAR_UNIT_NAME MS_VAR_TEXT("microeinsteinPerSquareMeterPerSecond")
 /// @brief Default variable short code; "photosyntheticallyActiveRadiation"
 #define SQ212_PAR_DEFAULT_CODE "photosyntheticallyActiveRadiation"
 #ifdef MS_USE_ADS1015
@@ -186,10 +186,10 @@
 #define SQ212_VOLTAGE_VAR_NUM 1
 /// @brief Variable name in [ODM2 controlled
 /// vocabulary](http://vocabulary.odm2.org/variablename/); "voltage"
-#define SQ212_VOLTAGE_VAR_NAME "voltage"
+#define SQ212_VOLTAGE_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "volt" (V)
-#define SQ212_VOLTAGE_UNIT_NAME "volt"
+#define SQ212_VOLTAGE_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "SQ212Voltage"
 #define SQ212_VOLTAGE_DEFAULT_CODE "SQ212Voltage"
 #ifdef MS_USE_ADS1015
@@ -220,7 +220,7 @@
  *
  * @ingroup sensor_sq212
  */
-class ApogeeSQ212 : public Sensor {
+class ApogeeSQ212 : public TIADS1x15Parent {
  public:
     /**
      * @brief Construct a new Apogee SQ-212 object - need the power pin and the
@@ -265,10 +265,6 @@ class ApogeeSQ212 : public Sensor {
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
-
- private:
-    uint8_t _adsChannel;
-    uint8_t _i2cAddress;
 };
 
 
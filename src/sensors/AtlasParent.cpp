@@ -24,7 +24,9 @@ AtlasParent::AtlasParent(TwoWire* theI2C, int8_t powerPin,
              stabilizationTime_ms, measurementTime_ms, powerPin, -1,
              measurementsToAverage, incCalcValues),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(theI2C) {}
+      _i2c(theI2C) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 AtlasParent::AtlasParent(int8_t powerPin, uint8_t i2cAddressHex,
                          uint8_t measurementsToAverage, const char* sensorName,
                          const uint8_t totalReturnedValues,
@@ -34,7 +36,9 @@ AtlasParent::AtlasParent(int8_t powerPin, uint8_t i2cAddressHex,
              stabilizationTime_ms, measurementTime_ms, powerPin, -1,
              measurementsToAverage, incCalcValues),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(&Wire) {}
+      _i2c(&Wire) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 // Destructors
 AtlasParent::~AtlasParent() {}
 
@@ -119,6 +123,13 @@ bool AtlasParent::startSingleMeasurement(void) {
     if (success) {
         // Update the time that a measurement was requested
         _millisMeasurementRequested = millis();
+#ifdef MS_ATLAS_POLL_STATUS
+        _pollInterval_ms = ATLAS_STATUS_POLL_MS;
+        _polledStatus    = -1;
+        // The first read of the status code is half way through the
+        // measurement
+        nextMeasurementStep(_measurementTime_ms / 2);
+#endif
     } else {
         // Otherwise, make sure that the measurement start time and success bit
         // (bit 6) are unset
@@ -138,10 +149,15 @@ bool AtlasParent::addSingleMeasurementResult(void) {
     // Check a measurement was *successfully* started (status bit 6 set)
     // Only go on to get a result if it was
     if (bitRead(_sensorStatus, 6)) {
+#ifdef MS_ATLAS_POLL_STATUS
+        // The status code and reading may already have been read
+        int code = _polledStatus >= 0 ? _polledStatus : pollStatus();
+#else
         // call the circuit and request 40 bytes (this may be more than we need)
         _i2c->requestFrom(static_cast<int>(_i2cAddressHex), 40, 1);
         // the first byte is the response code, we read this separately.
         int code = _i2c->read();
+#endif
 
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
         // Parse the response code
@@ -168,7 +184,11 @@ bool AtlasParent::addSingleMeasurementResult(void) {
         // If the response code is successful, parse the remaining results
         if (success) {
             for (uint8_t i = 0; i < _numReturnedValues; i++) {
+#ifdef MS_ATLAS_POLL_STATUS
+                float result = _polledResults[i];
+#else
                 float result = _i2c->parseFloat();
+#endif
                 if (isnan(result)) { result = -9999; }
                 if (result < -1020) { result = -9999; }
                 MS_DBG(F("  Result #"), i, ':', result);
@@ -188,23 +208,91 @@ bool AtlasParent::addSingleMeasurementResult(void) {
     _millisMeasurementRequested = 0;
     // Unset the status bits for a measurement request (bits 5 & 6)
     _sensorStatus &= 0b10011111;
+#ifdef MS_ATLAS_POLL_STATUS
+    _polledStatus = -1;
+#endif
 
     return success;
 }
 
 
+#ifdef MS_ATLAS_POLL_STATUS
+// Read the status code from half way through the measurement time, backing
+// off between reads so the bus is left free for other sensors
+bool AtlasParent::isMeasurementComplete(bool debug) {
+    if (_polledStatus >= 0) return true;
+    if (!bitRead(_sensorStatus, 6)) return Sensor::isMeasurementComplete(debug);
+    // Wait for the next read of the status code
+    if (!Sensor::isMeasurementComplete(false)) return false;
+
+    uint32_t elapsed = millis() - _millisMeasurementRequested;
+    pollStatus();
+    if (_polledStatus >= 0) {
+        if (debug) {
+            MS_DBG(getSensorNameAndLocation(), F("returned status code"),
+                   _polledStatus, F("after"), elapsed, F("ms"));
+        }
+        return true;
+    }
+    // Once the whole measurement time is up, the result is read anyway
+    if (elapsed >= _measurementTime_ms) {
+        return Sensor::isMeasurementComplete(debug);
+    }
+    // Read the status code again after the poll interval, but no later than
+    // the end of the measurement time
+    nextMeasurementStep(min(_pollInterval_ms, _measurementTime_ms - elapsed));
+    _pollInterval_ms = min(_pollInterval_ms * 2,
+                           static_cast<uint32_t>(ATLAS_STATUS_POLL_MAX_MS));
+    return false;
+}
+
+
+// Request the status code and the reading; the reading is only kept if the
+// status says it's finished
+int AtlasParent::pollStatus(void) {
+    _polledStatus = -1;
+    // call the circuit and request 40 bytes (this may be more than we need)
+    if (_i2c->requestFrom(static_cast<int>(_i2cAddressHex), 40, 1) == 0) {
+        return -1;
+    }
+    // the first byte is the response code, we read this separately.
+    int code = _i2c->read();
+    if (code == 1) {
+        for (uint8_t i = 0; i < _numReturnedValues && i < ATLAS_MAX_RESULTS;
+             i++) {
+            _polledResults[i] = _i2c->parseFloat();
+        }
+    }
+    // 1 is a finished reading; 2 (failed) and 255 (no data) won't change by
+    // waiting any longer
+    if (code == 1 || code == 2 || code == 255) _polledStatus = code;
+    // Empty what's left of the response
+    while (_i2c->available()) { _i2c->read(); }
+    return code;
+}
+#endif
+
+
 // Wait for a command to process
 // NOTE:  This should ONLY be used as a wait when no response is
 // expected except a status code - the response will be "consumed"
 // and become unavailable.
 bool AtlasParent::waitForProcessing(uint32_t timeout) {
     // Wait for the command to have been processed and implented
+    // Back off between status reads instead of hammering the bus
     bool     processed = false;
     uint32_t start     = millis();
+    uint32_t interval  = ATLAS_STATUS_POLL_MS;
     while (!processed && millis() - start < timeout) {
         _i2c->requestFrom(static_cast<int>(_i2cAddressHex), 1, 1);
         auto code = static_cast<uint8_t>(_i2c->read());
-        if (code == 1) processed = true;
+        if (code == 1) {
+            processed = true;
+        } else {
+            delay(interval);
+            interval = min(interval * 2,
+                           static_cast<uint32_t>(ATLAS_STATUS_POLL_MAX_MS));
+        }
     }
     return processed;
 }
@@ -79,6 +79,37 @@
 #define MS_DEBUGGING_STD "AtlasParent"
 #endif
 
+/**
+ * @def MS_ATLAS_POLL_STATUS
+ * @brief Finish Atlas EZO measurements as soon as the circuit's status code
+ * says the reading is done instead of always waiting out the measurement
+ * time.
+ *
+ * From half way through the measurement time, the status code is read with a
+ * growing interval between reads, starting at #ATLAS_STATUS_POLL_MS.  Each
+ * read is a step of the measurement (Sensor::nextMeasurementStep()), so the
+ * deadline scheduler wakes for it.  The reading that comes with the "1"
+ * status code is kept until the result is collected.
+ *
+ * @ingroup atlas_group
+ */
+// #define MS_ATLAS_POLL_STATUS
+
+/**
+ * @brief The first interval in ms between reads of an EZO circuit's status
+ * code; the interval doubles after each read up to #ATLAS_STATUS_POLL_MAX_MS.
+ */
+#define ATLAS_STATUS_POLL_MS 25
+/**
+ * @brief The longest interval in ms between reads of an EZO circuit's status
+ * code.
+ */
+#define ATLAS_STATUS_POLL_MAX_MS 200
+/**
+ * @brief The largest number of results returned by any EZO circuit.
+ */
+#define ATLAS_MAX_RESULTS 4
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
@@ -220,6 +251,20 @@ class AtlasParent : public Sensor {
      */
     bool addSingleMeasurementResult(void) override;
 
+#ifdef MS_ATLAS_POLL_STATUS
+    /**
+     * @brief Check if the measurement is finished, reading the circuit's
+     * status code once the measurement is half done.
+     *
+     * If the status code is "1", the reading that comes with it is kept for
+     * addSingleMeasurementResult().
+     *
+     * @param debug True to output the result to the debugging Serial
+     * @return **bool** True if the measurement is complete.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+#endif
+
  protected:
     /**
      * @brief The I2C address of the Atlas circuit.
@@ -247,6 +292,30 @@ class AtlasParent : public Sensor {
      * within the wait period.
      */
     bool waitForProcessing(uint32_t timeout = 1000L);
+
+ private:
+#ifdef MS_ATLAS_POLL_STATUS
+    /**
+     * @brief Read the circuit's status code and, if the reading is done, the
+     * results that come with it.
+     *
+     * A final status code (1, 2, or 255) is kept in #_polledStatus.
+     *
+     * @return **int** The status code, or -1 if the circuit didn't answer.
+     */
+    int pollStatus(void);
+
+    /**
+     * @brief The time in ms from one read of the status code to the next
+     */
+    uint32_t _pollInterval_ms = ATLAS_STATUS_POLL_MS;
+    /**
+     * @brief The final status code of the current measurement, or -1 if it
+     * hasn't been read yet
+     */
+    int16_t _polledStatus = -1;
+    float   _polledResults[ATLAS_MAX_RESULTS];
+#endif
 };
 
 #endif  // SRC_SENSORS_ATLASPARENT_H_
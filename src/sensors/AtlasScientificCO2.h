@@ -110,11 +110,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "carbonDioxide"
-#define ATLAS_CO2_VAR_NAME "carbonDioxide"
+#define ATLAS_CO2_VAR_NAME MS_VAR_TEXT("carbonDioxide")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "partPerMillion" (ppm)
-#define ATLAS_CO2_UNIT_NAME "partPerMillion"
+#define ATLAS_CO2_UNIT_NAME MS_VAR_TEXT("partPerMillion")
 /// @brief Default variable short code; "AtlasCO2ppm"
 #define ATLAS_CO2_DEFAULT_CODE "AtlasCO2ppm"
 /**@}*/
@@ -137,11 +137,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define ATLAS_CO2TEMP_VAR_NAME "temperature"
+#define ATLAS_CO2TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define ATLAS_CO2TEMP_UNIT_NAME "degreeCelsius"
+#define ATLAS_CO2TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "AtlasCO2Temp"
 #define ATLAS_CO2TEMP_DEFAULT_CODE "AtlasCO2Temp"
 /**@}*/
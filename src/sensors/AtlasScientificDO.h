@@ -122,11 +122,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolved"
-#define ATLAS_DOMGL_VAR_NAME "oxygenDissolved"
+#define ATLAS_DOMGL_VAR_NAME MS_VAR_TEXT("oxygenDissolved")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define ATLAS_DOMGL_UNIT_NAME "milligramPerLiter"
+#define ATLAS_DOMGL_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "AtlasDOmgL"
 #define ATLAS_DOMGL_DEFAULT_CODE "AtlasDOmgL"
 /**@}*/
@@ -150,11 +150,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolvedPercentOfSaturation"
-#define ATLAS_DOPCT_VAR_NAME "oxygenDissolvedPercentOfSaturation"
+#define ATLAS_DOPCT_VAR_NAME MS_VAR_TEXT("oxygenDissolvedPercentOfSaturation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
 /// (percent saturation)
-#define ATLAS_DOPCT_UNIT_NAME "percent"
+#define ATLAS_DOPCT_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "AtlasDOpct"
 #define ATLAS_DOPCT_DEFAULT_CODE "AtlasDOpct"
 /**@}*/
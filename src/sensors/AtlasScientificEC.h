@@ -128,11 +128,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "electricalConductivity"
-#define ATLAS_COND_VAR_NAME "electricalConductivity"
+#define ATLAS_COND_VAR_NAME MS_VAR_TEXT("electricalConductivity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define ATLAS_COND_UNIT_NAME "microsiemenPerCentimeter"
+#define ATLAS_COND_UNIT_NAME MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "AtlasCond"
 #define ATLAS_COND_DEFAULT_CODE "AtlasCond"
 /**@}*/
@@ -154,11 +154,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "solidsTotalDissolved"
-#define ATLAS_TDS_VAR_NAME "solidsTotalDissolved"
+#define ATLAS_TDS_VAR_NAME MS_VAR_TEXT("solidsTotalDissolved")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "partPerMillion" (ppm)
-#define ATLAS_TDS_UNIT_NAME "partPerMillion"
+#define ATLAS_TDS_UNIT_NAME MS_VAR_TEXT("partPerMillion")
 /// @brief Default variable short code; "AtlasTDS"
 #define ATLAS_TDS_DEFAULT_CODE "AtlasTDS"
 /**@}*/
@@ -180,11 +180,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "salinity"
-#define ATLAS_SALINITY_VAR_NAME "salinity"
+#define ATLAS_SALINITY_VAR_NAME MS_VAR_TEXT("salinity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "practicalSalinityUnit"
-#define ATLAS_SALINITY_UNIT_NAME "practicalSalinityUnit"
+#define ATLAS_SALINITY_UNIT_NAME MS_VAR_TEXT("practicalSalinityUnit")
 /// @brief Default variable short code; "AtlasSalinity"
 #define ATLAS_SALINITY_DEFAULT_CODE "AtlasSalinity"
 /**@}*/
@@ -210,11 +210,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificGravity"
-#define ATLAS_SG_VAR_NAME "specificGravity"
+#define ATLAS_SG_VAR_NAME MS_VAR_TEXT("specificGravity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "dimensionless"
-#define ATLAS_SG_UNIT_NAME "dimensionless"
+#define ATLAS_SG_UNIT_NAME MS_VAR_TEXT("dimensionless")
 /// @brief Default variable short code; "AtlasSpecGravity"
 #define ATLAS_SG_DEFAULT_CODE "AtlasSpecGravity"
 /**@}*/
@@ -105,11 +105,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "reductionPotential"
-#define ATLAS_ORP_VAR_NAME "reductionPotential"
+#define ATLAS_ORP_VAR_NAME MS_VAR_TEXT("reductionPotential")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millivolt"
 /// (mV)
-#define ATLAS_ORP_UNIT_NAME "millivolt"
+#define ATLAS_ORP_UNIT_NAME MS_VAR_TEXT("millivolt")
 /// @brief Default variable short code; "AtlasORP"
 #define ATLAS_ORP_DEFAULT_CODE "AtlasORP"
 /**@}*/
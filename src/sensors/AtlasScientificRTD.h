@@ -115,11 +115,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define ATLAS_RTD_VAR_NAME "temperature"
+#define ATLAS_RTD_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define ATLAS_RTD_UNIT_NAME "degreeCelsius"
+#define ATLAS_RTD_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "AtlasTemp"
 #define ATLAS_RTD_DEFAULT_CODE "AtlasTemp"
 /**@}*/
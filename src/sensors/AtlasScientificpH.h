@@ -107,11 +107,11 @@
 #define ATLAS_PH_VAR_NUM 0
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/); "pH"
-#define ATLAS_PH_VAR_NAME "pH"
+#define ATLAS_PH_VAR_NAME MS_VAR_TEXT("pH")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "pH"
 /// (dimensionless pH units)
-#define ATLAS_PH_UNIT_NAME "pH"
+#define ATLAS_PH_UNIT_NAME MS_VAR_TEXT("pH")
 /// @brief Default variable short code; "AtlaspH"
 #define ATLAS_PH_DEFAULT_CODE "AtlaspH"
 /**@}*/
@@ -15,23 +15,86 @@
 BoschBME280::BoschBME280(TwoWire* theI2C, int8_t powerPin,
                          uint8_t i2cAddressHex, uint8_t measurementsToAverage)
     : Sensor("BoschBME280", BME280_NUM_VARIABLES, BME280_WARM_UP_TIME_MS,
-             BME280_STABILIZATION_TIME_MS, BME280_MEASUREMENT_TIME_MS, powerPin,
+             BME280_STABILIZATION_TIME_MS, 0, powerPin,
              -1, measurementsToAverage),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(theI2C) {}
+      _i2c(theI2C) {
+    _measurementTime_ms = calculateMeasurementTime();
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 
 BoschBME280::BoschBME280(int8_t powerPin, uint8_t i2cAddressHex,
                          uint8_t measurementsToAverage)
     : Sensor("BoschBME280", BME280_NUM_VARIABLES, BME280_WARM_UP_TIME_MS,
-             BME280_STABILIZATION_TIME_MS, BME280_MEASUREMENT_TIME_MS, powerPin,
+             BME280_STABILIZATION_TIME_MS, 0, powerPin,
              -1, measurementsToAverage, BME280_INC_CALC_VARIABLES),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(&Wire) {}
+      _i2c(&Wire) {
+    _measurementTime_ms = calculateMeasurementTime();
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 
 // Destructor
 BoschBME280::~BoschBME280() {}
 
 
+void BoschBME280::setOversampling(
+    Adafruit_BME280::sensor_sampling tempSampling,
+    Adafruit_BME280::sensor_sampling pressSampling,
+    Adafruit_BME280::sensor_sampling humidSampling) {
+    _tempSampling       = tempSampling;
+    _pressSampling      = pressSampling;
+    _humidSampling      = humidSampling;
+    _measurementTime_ms = calculateMeasurementTime();
+}
+
+
+void BoschBME280::setFilter(Adafruit_BME280::sensor_filter filter) {
+    _filter = filter;
+}
+
+
+// The maximum measurement time from section 9.1 of the datasheet
+uint32_t BoschBME280::calculateMeasurementTime(void) {
+    // The oversampling settings 1-5 are 1, 2, 4, 8, and 16 samples
+    uint8_t tempSamples  = _tempSampling ? 1 << (_tempSampling - 1) : 0;
+    uint8_t pressSamples = _pressSampling ? 1 << (_pressSampling - 1) : 0;
+    uint8_t humidSamples = _humidSampling ? 1 << (_humidSampling - 1) : 0;
+
+    uint32_t time_us = BME280_MEASUREMENT_BASE_TIME_US +
+        BME280_MEASUREMENT_SAMPLE_TIME_US * tempSamples;
+    if (pressSamples) {
+        time_us += BME280_MEASUREMENT_SAMPLE_TIME_US * pressSamples +
+            BME280_MEASUREMENT_SETUP_TIME_US;
+    }
+    if (humidSamples) {
+        time_us += BME280_MEASUREMENT_SAMPLE_TIME_US * humidSamples +
+            BME280_MEASUREMENT_SETUP_TIME_US;
+    }
+    return (time_us + 999) / 1000;
+}
+
+
+bool BoschBME280::writeRegister(uint8_t reg, uint8_t value) {
+    _i2c->beginTransmission(_i2cAddressHex);
+    _i2c->write(reg);
+    _i2c->write(value);
+    return _i2c->endTransmission() == 0;
+}
+
+
+bool BoschBME280::readRegister(uint8_t reg, uint8_t& value) {
+    _i2c->beginTransmission(_i2cAddressHex);
+    _i2c->write(reg);
+    if (_i2c->endTransmission() != 0) return false;
+    if (_i2c->requestFrom(_i2cAddressHex, static_cast<uint8_t>(1)) != 1) {
+        return false;
+    }
+    value = _i2c->read();
+    return true;
+}
+
+
 String BoschBME280::getSensorLocation(void) {
     String address = F("I2C_0x");
     address += String(_i2cAddressHex, HEX);
@@ -77,42 +140,79 @@ bool BoschBME280::wake(void) {
     // and status bits.  If it returns false, there's no reason to go on.
     if (!Sensor::wake()) return false;
 
-    // Restart always needed after power-up to set sampling modes
-    // As of Adafruit library version 1.0.7, this function includes all of the
-    // various delays to allow the chip to wake up, get calibrations, get
-    // coefficients, and set sampling modes.
-    // This will also restart "Wire"
-    // Currently this is using the settings that Adafruit considered to be
-    // 'default'
-    //  - sensor mode = normal (sensor measures, sleeps for the "standby time"
-    //  and then automatically remeasures
-    //  - temperature oversampling = 16x
-    //  - pressure oversampling = 16x
-    //  - humidity oversampling = 16x
-    //  - built-in IIR filter = off
-    //  - sleep time between measurements = 0.5ms
-    // TODO(SRGDamia1):  Figure out why this is necessary; setSampling should be
-    // enough and this adds a bunch of small delays...
-    bme_internal.begin(_i2cAddressHex, _i2c);
-
-    // When the Adafruit library is updated to remove the built-in delay after
-    // forcing a sample, it would be better to operate in forced mode.
+    // The calibration coefficients read in setup() are kept by the Adafruit
+    // library, so the sampling settings are all that needs to be written after
+    // the sensor was powered on.  If the sensor doesn't answer with its chip
+    // ID, restart it with begin(), which re-reads the calibration and includes
+    // the library's delays.
+    uint8_t chipID = 0;
+    if (!readRegister(BME280_REGISTER_CHIPID, chipID) || chipID != 0x60) {
+        MS_DBG(getSensorNameAndLocation(),
+               F("did not return its chip ID; restarting it"));
+        bme_internal.begin(_i2cAddressHex, _i2c);
+    }
+
+    // Leave the sensor asleep; each measurement is forced by
+    // startSingleMeasurement()
     bme_internal.setSampling(
-        Adafruit_BME280::MODE_NORMAL,  // sensor mode
-        // bme_internal.setSampling(Adafruit_BME280::MODE_FORCED,  // sensor
-        // mode
-        Adafruit_BME280::SAMPLING_X16,      // temperature oversampling
-        Adafruit_BME280::SAMPLING_X16,      //  pressure oversampling
-        Adafruit_BME280::SAMPLING_X16,      //  humidity oversampling
-        Adafruit_BME280::FILTER_OFF,        // built-in IIR filter
+        Adafruit_BME280::MODE_SLEEP,       // sensor mode
+        _tempSampling,                     // temperature oversampling
+        _pressSampling,                    //  pressure oversampling
+        _humidSampling,                    //  humidity oversampling
+        _filter,                           // built-in IIR filter
         Adafruit_BME280::STANDBY_MS_1000);  // sleep time between measurements
                                             // (N/A in forced mode)
-    delay(100);  // Need this delay after changing sampling mode
 
     return true;
 }
 
 
+bool BoschBME280::startSingleMeasurement(void) {
+    // Sensor::startSingleMeasurement() checks that if it's awake/active and
+    // sets the timestamp and status bits.  If it returns false, there's no
+    // reason to go on.
+    if (!Sensor::startSingleMeasurement()) return false;
+
+    // Writing the measurement control register with the forced mode starts a
+    // single measurement; the humidity oversampling was written in wake()
+    MS_DBG(F("Forcing a BME280 measurement, expected to take"),
+           _measurementTime_ms, F("ms"));
+    uint8_t ctrlMeas = (_tempSampling << 5) | (_pressSampling << 2) |
+        Adafruit_BME280::MODE_FORCED;
+    if (!writeRegister(BME280_REGISTER_CONTROL, ctrlMeas)) {
+        MS_DBG(getSensorNameAndLocation(),
+               F("did not successfully start a measurement."));
+        _millisMeasurementRequested = 0;
+        _sensorStatus &= 0b10111111;
+        return false;
+    }
+    return true;
+}
+
+
+bool BoschBME280::isMeasurementComplete(bool debug) {
+    if (!bitRead(_sensorStatus, 6)) {
+        return Sensor::isMeasurementComplete(debug);
+    }
+    // Give the sensor at least a millisecond to set the measuring bit
+    if (millis() - _millisMeasurementRequested < 2) { return false; }
+
+    // Bit 3 of the status register is set while the sensor is measuring
+    uint8_t status = 0;
+    if (readRegister(BME280_REGISTER_STATUS, status) && !(status & 0x08)) {
+        if (debug) {
+            MS_DBG(F("It's been"), millis() - _millisMeasurementRequested,
+                   F("ms, and measurement by"), getSensorNameAndLocation(),
+                   F("is complete!"));
+        }
+        return true;
+    }
+    // Otherwise the measurement is over once the calculated time has passed,
+    // even if the status can't be read
+    return Sensor::isMeasurementComplete(debug);
+}
+
+
 bool BoschBME280::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -59,6 +59,13 @@
  * @note Software I2C is *not* supported for the BME280.
  * A secondary hardware I2C on a SAMD board is supported.
  *
+ * The BME280 is run in forced mode: each measurement is started by
+ * startSingleMeasurement() and the sensor goes back to sleep when it's done.
+ * The oversampling of each value and the IIR filter can be set with
+ * BoschBME280::setOversampling() and BoschBME280::setFilter(); the time
+ * allowed for the measurement is calculated from the oversampling and the end
+ * of the measurement is read from the status register.
+ *
  * @section sensor_bme280_datasheet Sensor Datasheet
  * Documentation for the sensor can be found at:
  * https://www.bosch-sensortec.com/products/environmental-sensors/humidity-sensors-bme280/
@@ -128,15 +135,19 @@
  */
 #define BME280_STABILIZATION_TIME_MS 4000
 /**
- * @brief Sensor::_measurementTime_ms; BME280 takes 1100ms to complete a
- * measurement.
+ * @brief The time in µs a forced measurement takes before any oversampling.
  *
- * 1.0 s according to datasheet, but slightly better stdev when 1.1 s
- * For details on BME280 stabilization time updates, include testing sketch and
- * link to data in Google Sheet, see:
- * https://github.com/EnviroDIY/ModularSensors/commit/27e3cb531162ed6971a41f3c38f5920d356089e9
+ * Sensor::_measurementTime_ms is calculated from the oversampling with the
+ * maximum measurement time formula in section 9.1 of the datasheet:
+ * 1.25 ms + 2.3 ms for each temperature, pressure, and humidity sample + 0.575
+ * ms each for pressure and humidity if they are measured.  At the default 16x
+ * oversampling of all three a measurement takes 113ms.
  */
-#define BME280_MEASUREMENT_TIME_MS 1100
+#define BME280_MEASUREMENT_BASE_TIME_US 1250L
+/// @brief The time in µs for each temperature, pressure, or humidity sample.
+#define BME280_MEASUREMENT_SAMPLE_TIME_US 2300L
+/// @brief The time in µs to start the pressure or humidity measurement.
+#define BME280_MEASUREMENT_SETUP_TIME_US 575L
 /**@}*/
 
 /**
@@ -157,11 +168,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define BME280_TEMP_VAR_NAME "temperature"
+#define BME280_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define BME280_TEMP_UNIT_NAME "degreeCelsius"
+#define BME280_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "BoschBME280Temp"
 #define BME280_TEMP_DEFAULT_CODE "BoschBME280Temp"
 /**@}*/
@@ -182,11 +193,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "relativeHumidity"
-#define BME280_HUMIDITY_VAR_NAME "relativeHumidity"
+#define BME280_HUMIDITY_VAR_NAME MS_VAR_TEXT("relativeHumidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent" -
 /// percent relative humidity (% RH)
-#define BME280_HUMIDITY_UNIT_NAME "percent"
+#define BME280_HUMIDITY_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "BoschBME280Humidity"
 #define BME280_HUMIDITY_DEFAULT_CODE "BoschBME280Humidity"
 /**@}*/
@@ -210,11 +221,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "barometricPressure"
-#define BME280_PRESSURE_VAR_NAME "barometricPressure"
+#define BME280_PRESSURE_VAR_NAME MS_VAR_TEXT("barometricPressure")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "pascal"
 /// (Pa)
-#define BME280_PRESSURE_UNIT_NAME "pascal"
+#define BME280_PRESSURE_UNIT_NAME MS_VAR_TEXT("pascal")
 /// @brief Default variable short code; "BoschBME280Pressure"
 #define BME280_PRESSURE_DEFAULT_CODE "BoschBME280Pressure"
 /**@}*/
@@ -235,10 +246,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "heightAboveSeaFloor"
-#define BME280_ALTITUDE_VAR_NAME "heightAboveSeaFloor"
+#define BME280_ALTITUDE_VAR_NAME MS_VAR_TEXT("heightAboveSeaFloor")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "meter"
-#define BME280_ALTITUDE_UNIT_NAME "meter"
+#define BME280_ALTITUDE_UNIT_NAME MS_VAR_TEXT("meter")
 /// @brief Default variable short code; "BoschBME280Altitude"
 #define BME280_ALTITUDE_DEFAULT_CODE "BoschBME280Altitude"
 /**@}*/
@@ -299,12 +310,38 @@ class BoschBME280 : public Sensor {
      */
     ~BoschBME280();
 
+    /**
+     * @brief Set the oversampling of each value.
+     *
+     * More samples give less noise but take longer: each sample adds 2.3ms to
+     * the measurement time.  The default is 16x for all three.
+     *
+     * @param tempSampling The oversampling of the temperature
+     * @param pressSampling The oversampling of the pressure;
+     * Adafruit_BME280::SAMPLING_NONE to skip it
+     * @param humidSampling The oversampling of the humidity;
+     * Adafruit_BME280::SAMPLING_NONE to skip it
+     */
+    void setOversampling(Adafruit_BME280::sensor_sampling tempSampling,
+                         Adafruit_BME280::sensor_sampling pressSampling,
+                         Adafruit_BME280::sensor_sampling humidSampling);
+    /**
+     * @brief Set the IIR filter coefficient for the temperature and pressure.
+     *
+     * The filter only works across measurements made while the sensor stays
+     * powered.  The default is Adafruit_BME280::FILTER_OFF.
+     *
+     * @param filter The filter coefficient
+     */
+    void setFilter(Adafruit_BME280::sensor_filter filter);
+
     /**
      * @brief Wake the sensor up, if necessary.  Do whatever it takes to get a
      * sensor in the proper state to begin a measurement.
      *
-     * Verifies that the power is on and updates the #_sensorStatus.  This also
-     * sets the #_millisSensorActivated timestamp.
+     * Verifies that the power is on, writes the oversampling and filter
+     * settings, and updates the #_sensorStatus.  This also sets the
+     * #_millisSensorActivated timestamp.
      *
      * @note This does NOT include any wait for sensor readiness.
      *
@@ -327,7 +364,25 @@ class BoschBME280 : public Sensor {
      */
     String getSensorLocation(void) override;
 
-    // bool startSingleMeasurement(void) override;  // for forced mode
+    /**
+     * @brief Tell the sensor to start a single forced measurement.
+     *
+     * This also sets the #_millisMeasurementRequested timestamp.
+     *
+     * @note This function does NOT include any waiting for the sensor to be
+     * warmed up or stable!
+     *
+     * @return **bool** True if the start measurement function completed
+     * successfully.
+     */
+    bool startSingleMeasurement(void) override;
+    /**
+     * @copydoc Sensor::isMeasurementComplete(bool debug)
+     *
+     * The measurement is finished as soon as the measuring bit of the
+     * BME280's status register clears.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
@@ -346,6 +401,48 @@ class BoschBME280 : public Sensor {
      * @brief An internal reference to the hardware Wire instance.
      */
     TwoWire* _i2c;
+    /**
+     * @brief The oversampling of the temperature
+     */
+    Adafruit_BME280::sensor_sampling _tempSampling =
+        Adafruit_BME280::SAMPLING_X16;
+    /**
+     * @brief The oversampling of the pressure
+     */
+    Adafruit_BME280::sensor_sampling _pressSampling =
+        Adafruit_BME280::SAMPLING_X16;
+    /**
+     * @brief The oversampling of the humidity
+     */
+    Adafruit_BME280::sensor_sampling _humidSampling =
+        Adafruit_BME280::SAMPLING_X16;
+    /**
+     * @brief The IIR filter coefficient
+     */
+    Adafruit_BME280::sensor_filter _filter = Adafruit_BME280::FILTER_OFF;
+
+    /**
+     * @brief Calculate the measurement time from the oversampling.
+     *
+     * @return **uint32_t** The longest a measurement can take, in ms
+     */
+    uint32_t calculateMeasurementTime(void);
+    /**
+     * @brief Write a BME280 register.
+     *
+     * @param reg The register address
+     * @param value The value to write
+     * @return **bool** True if the BME280 acknowledged the write.
+     */
+    bool writeRegister(uint8_t reg, uint8_t value);
+    /**
+     * @brief Read a BME280 register.
+     *
+     * @param reg The register address
+     * @param value The value read
+     * @return **bool** True if the register was read.
+     */
+    bool readRegister(uint8_t reg, uint8_t& value);
 };
 
 
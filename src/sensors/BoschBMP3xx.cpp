@@ -24,7 +24,10 @@ BoschBMP3xx::BoschBMP3xx(int8_t powerPin, Mode mode,
       _tempOversampleEnum(tempOversample),
       _filterCoeffEnum(filterCoeff),
       _standbyEnum(timeStandby),
-      _i2cAddressHex(i2cAddressHex) {}
+      _i2cAddressHex(i2cAddressHex) {
+    // The Bosch library only uses the default Wire instance
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(&Wire));
+}
 // Destructor
 BoschBMP3xx::~BoschBMP3xx() {}
 
@@ -192,6 +195,15 @@ bool BoschBMP3xx::setup(void) {
         }
         ntries++;
     }
+#ifdef MS_BMP3XX_FIFO
+    // The FIFO can only fill between readings in normal mode
+    _useFIFO = false;
+    if (success && _mode == NORMAL_MODE) {
+        _useFIFO = setupFIFO();
+        MS_DBG(_useFIFO ? F("BMP3xx samples will be read from its FIFO")
+                        : F("Unable to set up the BMP3xx FIFO"));
+    }
+#endif
     if (!success) {
         // Set the status error bit (bit 7)
         _sensorStatus |= 0b10000000;
@@ -285,6 +297,18 @@ bool BoschBMP3xx::addSingleMeasurementResult(void) {
     // Check a measurement was *successfully* started (status bit 6 set)
     // Only go on to get a result if it was
     if (bitRead(_sensorStatus, 6)) {
+#ifdef MS_BMP3XX_FIFO
+        // Add every sample waiting in the FIFO; if there aren't any yet, read
+        // the latest values as usual
+        uint8_t nSamples = _useFIFO ? drainFIFO() : 0;
+        if (nSamples > 0) {
+            MS_DBG(getSensorNameAndLocation(), F("read"), nSamples,
+                   F("samples from its FIFO"));
+            _millisMeasurementRequested = 0;
+            _sensorStatus &= 0b10011111;
+            return true;
+        }
+#endif
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Read values
@@ -316,3 +340,129 @@ bool BoschBMP3xx::addSingleMeasurementResult(void) {
 
     return success;
 }
+
+
+#ifdef MS_BMP3XX_FIFO
+bool BoschBMP3xx::setupFIFO(void) {
+    // Read the calibration coefficients for compensating the FIFO samples
+    // ourselves; the library keeps its copy private
+    uint8_t c[21];
+    if (!readRegisters(BMP3XX_REG_CALIBRATION, c, 21)) return false;
+    _calibration.t1 = ldexp(static_cast<uint16_t>(c[1] << 8 | c[0]), 8);
+    _calibration.t2 = ldexp(static_cast<uint16_t>(c[3] << 8 | c[2]), -30);
+    _calibration.t3 = ldexp(static_cast<int8_t>(c[4]), -48);
+    _calibration.p1 = ldexp(static_cast<int16_t>(c[6] << 8 | c[5]) - 16384,
+                            -20);
+    _calibration.p2 = ldexp(static_cast<int16_t>(c[8] << 8 | c[7]) - 16384,
+                            -29);
+    _calibration.p3  = ldexp(static_cast<int8_t>(c[9]), -32);
+    _calibration.p4  = ldexp(static_cast<int8_t>(c[10]), -37);
+    _calibration.p5  = ldexp(static_cast<uint16_t>(c[12] << 8 | c[11]), 3);
+    _calibration.p6  = ldexp(static_cast<uint16_t>(c[14] << 8 | c[13]), -6);
+    _calibration.p7  = ldexp(static_cast<int8_t>(c[15]), -8);
+    _calibration.p8  = ldexp(static_cast<int8_t>(c[16]), -15);
+    _calibration.p9  = ldexp(static_cast<int16_t>(c[18] << 8 | c[17]), -48);
+    _calibration.p10 = ldexp(static_cast<int8_t>(c[19]), -48);
+    _calibration.p11 = ldexp(static_cast<int8_t>(c[20]), -65);
+
+    // Store pressure and temperature frames, without the sensor time, and
+    // keep writing over the oldest frames once the FIFO is full
+    // Then take the filtered values and throw out anything already in the FIFO
+    return writeRegister(BMP3XX_REG_FIFO_CONFIG_1, 0b00011001) &&
+        writeRegister(BMP3XX_REG_FIFO_CONFIG_2, 0b00001000) &&
+        writeRegister(BMP3XX_REG_CMD, 0xB0);
+}
+
+
+uint8_t BoschBMP3xx::drainFIFO(void) {
+    uint8_t length[2];
+    if (!readRegisters(BMP3XX_REG_FIFO_LENGTH, length, 2)) return 0;
+    uint16_t remaining = length[0] | (length[1] & 0x01) << 8;
+    MS_DBG(F("BMP3xx FIFO holds"), remaining, F("bytes"));
+
+    // Frames may be split across the reads, so they're put back together here
+    uint8_t frame[7];
+    uint8_t framePos = 0;
+    uint8_t frameLen = 0;
+    uint8_t nSamples = 0;
+    uint8_t chunk[32];
+    while (remaining > 0) {
+        uint8_t nBytes = remaining > sizeof(chunk) ? sizeof(chunk) : remaining;
+        if (!readRegisters(BMP3XX_REG_FIFO_DATA, chunk, nBytes)) break;
+        remaining -= nBytes;
+        for (uint8_t i = 0; i < nBytes; i++) {
+            frame[framePos++] = chunk[i];
+            if (framePos == 1) {
+                switch (frame[0]) {
+                    case BMP3XX_FIFO_TEMP_PRESS_FRAME: frameLen = 7; break;
+                    // A temperature, pressure, or sensor time frame
+                    case 0x90:
+                    case 0x84:
+                    case 0xA0: frameLen = 4; break;
+                    // A configuration change or error frame
+                    case 0x48:
+                    case 0x44: frameLen = 2; break;
+                    // An empty frame, or anything else, ends the data
+                    default: return nSamples;
+                }
+            }
+            if (framePos == frameLen) {
+                if (frame[0] == BMP3XX_FIFO_TEMP_PRESS_FRAME) {
+                    addFIFOSample(&frame[1]);
+                    nSamples++;
+                }
+                framePos = 0;
+            }
+        }
+    }
+    return nSamples;
+}
+
+
+// Compensation from section 9.2 and 9.3 of the datasheet
+void BoschBMP3xx::addFIFOSample(const uint8_t* data) {
+    const bmp3xxCalibration& c = _calibration;
+
+    float rawTemp = static_cast<uint32_t>(data[2]) << 16 |
+        static_cast<uint32_t>(data[1]) << 8 | data[0];
+    float rawPress = static_cast<uint32_t>(data[5]) << 16 |
+        static_cast<uint32_t>(data[4]) << 8 | data[3];
+
+    float d    = rawTemp - c.t1;
+    float temp = d * c.t2 + d * d * c.t3;
+
+    float out1 = c.p5 + c.p6 * temp + c.p7 * temp * temp +
+        c.p8 * temp * temp * temp;
+    float out2 = rawPress *
+        (c.p1 + c.p2 * temp + c.p3 * temp * temp + c.p4 * temp * temp * temp);
+    float out3 = rawPress * rawPress * (c.p9 + c.p10 * temp) +
+        rawPress * rawPress * rawPress * c.p11;
+    // In hPa, as the library reports it
+    float press = (out1 + out2 + out3) / 100.0f;
+
+    float alt = (pow(SEALEVELPRESSURE_HPA / press, 0.190223) - 1.0f) *
+        (temp + 273.15f) / 0.0065f;
+
+    verifyAndAddMeasurementResult(BMP3XX_TEMP_VAR_NUM, temp);
+    verifyAndAddMeasurementResult(BMP3XX_PRESSURE_VAR_NUM, press);
+    verifyAndAddMeasurementResult(BMP3XX_ALTITUDE_VAR_NUM, alt);
+}
+
+
+bool BoschBMP3xx::readRegisters(uint8_t reg, uint8_t* data, uint8_t length) {
+    Wire.beginTransmission(_i2cAddressHex);
+    Wire.write(reg);
+    if (Wire.endTransmission() != 0) return false;
+    if (Wire.requestFrom(_i2cAddressHex, length) != length) return false;
+    for (uint8_t i = 0; i < length; i++) { data[i] = Wire.read(); }
+    return true;
+}
+
+
+bool BoschBMP3xx::writeRegister(uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(_i2cAddressHex);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+#endif
@@ -116,6 +116,9 @@
  *      - if not defined, 1013.25 is used
  *      - The same sea level pressure flag is used for both the BMP3xx and the BME280.
  * Whatever you select will be used for both sensors.
+ * - ```-D MS_BMP3XX_FIFO```
+ *      - use to have a continuously powered BMP3xx in normal mode fill its FIFO between readings
+ *      - every sample in the FIFO is read in each measurement and averaged; see #MS_BMP3XX_FIFO
  *
  * @section sensor_bmp3xx_ctor Sensor Constructors
  * {{ @ref BoschBMP3xx::BoschBMP3xx(int8_t, Mode, Oversampling, Oversampling, IIRFilter, TimeStandby, uint8_t) }}
@@ -139,6 +142,25 @@
 #define MS_DEBUGGING_STD "BoschBMP3xx"
 #endif
 
+/**
+ * @def MS_BMP3XX_FIFO
+ * @brief Have a BMP3xx in normal mode keep its samples in its FIFO and read
+ * all of them in each measurement.
+ *
+ * The sensor fills the FIFO at its output data rate while the logger sleeps or
+ * reads other sensors.  Each measurement reads the whole FIFO, up to 73
+ * samples, and adds every sample to the result, so the samples are averaged
+ * and, with #MS_SENSOR_BURST_STATS, counted in the burst statistics.  Older
+ * samples are dropped once the FIFO is full, so set the standby time so the
+ * FIFO spans the part of the logging interval you want.
+ *
+ * This only applies with continuous power; a sensor in forced mode is read as
+ * usual.
+ *
+ * @ingroup sensor_bmp3xx
+ */
+// #define MS_BMP3XX_FIFO
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
@@ -216,6 +238,30 @@
 /* clang-format on */
 /**@}*/
 
+#ifdef MS_BMP3XX_FIFO
+/**
+ * @anchor sensor_bmp3xx_fifo
+ * @name FIFO Registers
+ * The BMP3xx registers used to read the FIFO directly
+ */
+/**@{*/
+/// @brief The FIFO length register; the length in bytes is 9 bits.
+#define BMP3XX_REG_FIFO_LENGTH 0x12
+/// @brief The FIFO data register, read repeatedly to empty the FIFO.
+#define BMP3XX_REG_FIFO_DATA 0x14
+/// @brief The first FIFO configuration register.
+#define BMP3XX_REG_FIFO_CONFIG_1 0x17
+/// @brief The second FIFO configuration register.
+#define BMP3XX_REG_FIFO_CONFIG_2 0x18
+/// @brief The first of the 21 bytes of calibration coefficients.
+#define BMP3XX_REG_CALIBRATION 0x31
+/// @brief The command register.
+#define BMP3XX_REG_CMD 0x7E
+/// @brief The header of a FIFO frame holding a temperature and pressure.
+#define BMP3XX_FIFO_TEMP_PRESS_FRAME 0x94
+/**@}*/
+#endif
+
 /**
  * @anchor sensor_bmp3xx_temp
  * @name Temperature
@@ -239,11 +285,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define BMP3XX_TEMP_VAR_NAME "temperature"
+#define BMP3XX_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define BMP3XX_TEMP_UNIT_NAME "degreeCelsius"
+#define BMP3XX_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "BoschBMP3xxTemp"
 #define BMP3XX_TEMP_DEFAULT_CODE "BoschBMP3xxTemp"
 /**@}*/
@@ -270,11 +316,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "barometricPressure"
-#define BMP3XX_PRESSURE_VAR_NAME "barometricPressure"
+#define BMP3XX_PRESSURE_VAR_NAME MS_VAR_TEXT("barometricPressure")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "pascal"
 /// (Pa)
-#define BMP3XX_PRESSURE_UNIT_NAME "pascal"
+#define BMP3XX_PRESSURE_UNIT_NAME MS_VAR_TEXT("pascal")
 /// @brief Default variable short code; "BoschBMP3xxPressure"
 #define BMP3XX_PRESSURE_DEFAULT_CODE "BoschBMP3xxPressure"
 /**@}*/
@@ -295,10 +341,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "heightAboveSeaFloor"
-#define BMP3XX_ALTITUDE_VAR_NAME "heightAboveSeaFloor"
+#define BMP3XX_ALTITUDE_VAR_NAME MS_VAR_TEXT("heightAboveSeaFloor")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "meter"
-#define BMP3XX_ALTITUDE_UNIT_NAME "meter"
+#define BMP3XX_ALTITUDE_UNIT_NAME MS_VAR_TEXT("meter")
 /// @brief Default variable short code; "BoschBMP3xxAltitude"
 #define BMP3XX_ALTITUDE_DEFAULT_CODE "BoschBMP3xxAltitude"
 /**@}*/
@@ -463,6 +509,63 @@ class BoschBMP3xx : public Sensor {
      */
     BMP388_DEV bmp_internal;
 
+#ifdef MS_BMP3XX_FIFO
+    /**
+     * @brief The calibration coefficients, converted to floating point as in
+     * section 9.1 of the datasheet
+     */
+    typedef struct {
+        float t1, t2, t3;
+        float p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11;
+    } bmp3xxCalibration;
+
+    /**
+     * @brief Read the calibration coefficients, and enable and flush the FIFO.
+     *
+     * @return **bool** True if the FIFO was set up.
+     */
+    bool setupFIFO(void);
+    /**
+     * @brief Read every sample in the FIFO and add each one to the results.
+     *
+     * @return **uint8_t** The number of samples added.
+     */
+    uint8_t drainFIFO(void);
+    /**
+     * @brief Compensate the raw temperature and pressure of one FIFO frame
+     * and add them to the results.
+     *
+     * @param data The six data bytes of the frame, temperature first
+     */
+    void addFIFOSample(const uint8_t* data);
+    /**
+     * @brief Read a run of BMP3xx registers.
+     *
+     * @param reg The first register
+     * @param data The buffer for the values read
+     * @param length The number of registers to read, at most 32
+     * @return **bool** True if all of the registers were read.
+     */
+    bool readRegisters(uint8_t reg, uint8_t* data, uint8_t length);
+    /**
+     * @brief Write a BMP3xx register.
+     *
+     * @param reg The register
+     * @param value The value to write
+     * @return **bool** True if the BMP3xx acknowledged the write.
+     */
+    bool writeRegister(uint8_t reg, uint8_t value);
+
+    /**
+     * @brief True if the samples are being read from the FIFO
+     */
+    bool _useFIFO = false;
+    /**
+     * @brief The calibration coefficients for the FIFO samples
+     */
+    bmp3xxCalibration _calibration;
+#endif
+
     /**
      * @brief Data sampling mode
      *
@@ -40,6 +40,14 @@
  * @note While it is supported, you should not average measurements for this sensor.
  * The sensor takes a burst of 30 readings and returns the median of those.
  *
+ * The burst is started with a concurrent measurement (aC!), so the other
+ * sensors can be measured while it runs.  With `MS_SDI12_BUS_CONCURRENT` the
+ * measurements of every awake probe on the same data pin are started back to
+ * back with it, so the whole bus waits for its slowest burst once instead of
+ * for each probe in turn.  A ClariVUE kept powered between readings can
+ * instead have its last burst read straight away with
+ * SDI12Sensors::setContinuousMeasurement().
+ *
  * @section sensor_clarivue_datasheet Sensor Datasheet
  * The specifications and datasheet are available at https://www.campbellsci.com/clarivue10
  *
@@ -121,11 +129,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "turbidity"
-#define CLARIVUE10_TURBIDITY_VAR_NAME "turbidity"
+#define CLARIVUE10_TURBIDITY_VAR_NAME MS_VAR_TEXT("turbidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "formazinNephelometricUnit" (FNU)
-#define CLARIVUE10_TURBIDITY_UNIT_NAME "formazinNephelometricUnit"
+#define CLARIVUE10_TURBIDITY_UNIT_NAME MS_VAR_TEXT("formazinNephelometricUnit")
 /// @brief Default variable short code; "ClariVUETurbidity"
 #define CLARIVUE10_TURBIDITY_DEFAULT_CODE "ClariVUETurbidity"
 /**@}*/
@@ -148,11 +156,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define CLARIVUE10_TEMP_VAR_NAME "temperature"
+#define CLARIVUE10_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define CLARIVUE10_TEMP_UNIT_NAME "degreeCelsius"
+#define CLARIVUE10_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "ClariVUETempC"
 #define CLARIVUE10_TEMP_DEFAULT_CODE "ClariVUETempC"
 /**@}*/
@@ -173,11 +181,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "instrumentStatusCode"
-#define CLARIVUE10_ERRORCODE_VAR_NAME "instrumentStatusCode"
+#define CLARIVUE10_ERRORCODE_VAR_NAME MS_VAR_TEXT("instrumentStatusCode")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "dimensionless"
-#define CLARIVUE10_ERRORCODE_UNIT_NAME "dimensionless"
+#define CLARIVUE10_ERRORCODE_UNIT_NAME MS_VAR_TEXT("dimensionless")
 /// @brief Default variable short code; "ClariVUEError"
 #define CLARIVUE10_ERRORCODE_DEFAULT_CODE "ClariVUEError"
 /**@}*/
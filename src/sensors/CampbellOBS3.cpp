@@ -17,14 +17,13 @@
 CampbellOBS3::CampbellOBS3(int8_t powerPin, uint8_t adsChannel,
                            float x2_coeff_A, float x1_coeff_B, float x0_coeff_C,
                            uint8_t i2cAddress, uint8_t measurementsToAverage)
-    : Sensor("CampbellOBS3", OBS3_NUM_VARIABLES, OBS3_WARM_UP_TIME_MS,
-             OBS3_STABILIZATION_TIME_MS, OBS3_MEASUREMENT_TIME_MS, powerPin, -1,
-             measurementsToAverage, OBS3_INC_CALC_VARIABLES),
-      _adsChannel(adsChannel),
+    : TIADS1x15Parent("CampbellOBS3", OBS3_NUM_VARIABLES, OBS3_WARM_UP_TIME_MS,
+                      OBS3_STABILIZATION_TIME_MS, OBS3_MEASUREMENT_TIME_MS,
+                      powerPin, adsChannel, i2cAddress, measurementsToAverage,
+                      OBS3_INC_CALC_VARIABLES),
       _x2_coeff_A(x2_coeff_A),
       _x1_coeff_B(x1_coeff_B),
-      _x0_coeff_C(x0_coeff_C),
-      _i2cAddress(i2cAddress) {}
+      _x0_coeff_C(x0_coeff_C) {}
 // Destructor
 CampbellOBS3::~CampbellOBS3() {}
 
@@ -52,6 +51,14 @@ bool CampbellOBS3::addSingleMeasurementResult(void) {
     if (bitRead(_sensorStatus, 6)) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
+        // Print out the calibration curve
+        MS_DBG(F("  Input calibration Curve:"), _x2_coeff_A, F("x^2 +"),
+               _x1_coeff_B, F("x +"), _x0_coeff_C);
+
+#ifdef MS_TIADS1X15_SHARED
+        // Collect the conversion queued when the measurement started
+        adcVoltage = readQueuedVoltage();
+#else
 // Create an Auxillary ADD object
 // We create and set up the ADC object here so that each sensor using
 // the ADC may set the gain appropriately without effecting others.
@@ -77,10 +84,6 @@ bool CampbellOBS3::addSingleMeasurementResult(void) {
         // Begin ADC
         ads.begin();
 
-        // Print out the calibration curve
-        MS_DBG(F("  Input calibration Curve:"), _x2_coeff_A, F("x^2 +"),
-               _x1_coeff_B, F("x +"), _x0_coeff_C);
-
         // Read Analog to Digital Converter (ADC)
         // Taking this reading includes the 8ms conversion delay.
         // We're allowing the ADS1115 library to do the bit-to-volts conversion
@@ -89,12 +92,14 @@ bool CampbellOBS3::addSingleMeasurementResult(void) {
             ads.readADC_SingleEnded_V(_adsChannel);  // Getting the reading
         MS_DBG(F("  ads.readADC_SingleEnded_V("), _adsChannel, F("):"),
                adcVoltage);
+#endif
 
         if (adcVoltage < 3.6 && adcVoltage > -0.3) {
             // Skip results out of range
             // Apply the unique calibration curve for the given sensor
-            calibResult = (_x2_coeff_A * sq(adcVoltage)) +
-                (_x1_coeff_B * adcVoltage) + _x0_coeff_C;
+            calibResult = (_x2_coeff_A * adcVoltage + _x1_coeff_B) *
+                    adcVoltage +
+                _x0_coeff_C;
             MS_DBG(F("  calibResult:"), calibResult);
         } else {  // set invalid voltages back to -9999
             adcVoltage = -9999;
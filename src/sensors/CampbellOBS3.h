@@ -80,7 +80,7 @@
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "VariableBase.h"
-#include "SensorBase.h"
+#include "TIADS1x15Parent.h"
 
 // Sensor Specific Defines
 /** @ingroup sensor_obs3 */
@@ -156,11 +156,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "turbidity"
-#define OBS3_TURB_VAR_NAME "turbidity"
+#define OBS3_TURB_VAR_NAME MS_VAR_TEXT("turbidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "nephelometricTurbidityUnit" (NTU)
-#define OBS3_TURB_UNIT_NAME "nephelometricTurbidityUnit"
+#define OBS3_TURB_UNIT_NAME MS_VAR_TEXT("nephelometricTurbidityUnit")
 /// @brief Default variable short code; "OBS3Turbidity"
 #define OBS3_TURB_DEFAULT_CODE "OBS3Turbidity"
 /**@}*/
@@ -185,10 +185,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "voltage"
-#define OBS3_VOLTAGE_VAR_NAME "voltage"
+#define OBS3_VOLTAGE_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "volt"
-#define OBS3_VOLTAGE_UNIT_NAME "volt"
+#define OBS3_VOLTAGE_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "OBS3Voltage"
 #define OBS3_VOLTAGE_DEFAULT_CODE "OBS3Voltage"
 
@@ -221,7 +221,7 @@
  * @ingroup sensor_obs3
  */
 /* clang-format on */
-class CampbellOBS3 : public Sensor {
+class CampbellOBS3 : public TIADS1x15Parent {
  public:
     // The constructor - need the power pin, the ADS1X15 data channel, and the
     // calibration info
@@ -270,9 +270,7 @@ class CampbellOBS3 : public Sensor {
     bool addSingleMeasurementResult(void) override;
 
  private:
-    uint8_t _adsChannel;
-    float   _x2_coeff_A, _x1_coeff_B, _x0_coeff_C;
-    uint8_t _i2cAddress;
+    float _x2_coeff_A, _x1_coeff_B, _x0_coeff_C;
 };
 
 
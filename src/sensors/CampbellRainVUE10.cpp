@@ -0,0 +1,61 @@
+/**
+ * @file CampbellRainVUE10.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the CampbellRainVUE10 class.
+ */
+
+#include "CampbellRainVUE10.h"
+
+#ifdef MS_RAINVUE_ACCUMULATED
+void CampbellRainVUE10::setAccumulatedMode(bool accumulated) {
+    _accumulated = accumulated;
+    setContinuousMeasurement(accumulated);
+    // Averaging differences of totals would count the same tips twice
+    if (accumulated) { _measurementsToAverage = 1; }
+    _lastDepth = -9999;
+    _lastTips  = -9999;
+}
+
+
+// The increase of a running total since the last reading; a total that went
+// down was reset by the sensor, so all of it is new
+static float sinceLast(float total, float& last) {
+    if (total == -9999) { return -9999; }
+    float previous = last;
+    last           = total;
+    if (previous == -9999) { return -9999; }
+    return total >= previous ? total - previous : total;
+}
+
+
+bool CampbellRainVUE10::getResults(void) {
+    if (!_accumulated) { return SDI12Sensors::getResults(); }
+
+    MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
+    // The values can be split over the first two continuous commands
+    float   values[RAINVUE10_NUM_VARIABLES] = {-9999, -9999, -9999, -9999,
+                                               -9999};
+    uint8_t nValues = getDataValues(0, values, RAINVUE10_NUM_VARIABLES);
+    if (nValues > 0 && nValues < RAINVUE10_NUM_VARIABLES) {
+        getDataValues(1, values + nValues, RAINVUE10_NUM_VARIABLES - nValues);
+    }
+
+    float depth = sinceLast(values[RAINVUE10_PRECIPITATION_VAR_NUM],
+                            _lastDepth);
+    float tips  = sinceLast(values[RAINVUE10_TIPS_VAR_NUM], _lastTips);
+    MS_DBG(F("  Precipitation since the last reading:"), depth);
+    MS_DBG(F("  Tips since the last reading:"), tips);
+
+    for (uint8_t i = 0; i < RAINVUE10_NUM_VARIABLES; i++) {
+        float value = values[i];
+        if (i == RAINVUE10_PRECIPITATION_VAR_NUM) { value = depth; }
+        if (i == RAINVUE10_TIPS_VAR_NUM) { value = tips; }
+        verifyAndAddMeasurementResult(i, value);
+    }
+    // The first reading is only the baseline, but the sensor did answer
+    return values[RAINVUE10_PRECIPITATION_VAR_NUM] != -9999;
+}
+#endif
@@ -44,6 +44,15 @@
  * The specifications and datasheet are available at https://www.campbellsci.com/rainvue10
  *
  * @section sensor_rainvue_flags Build flags
+ * - `-D MS_RAINVUE_ACCUMULATED`
+ *    - Adds CampbellRainVUE10::setAccumulatedMode(), which reads the running
+ * totals the RainVUE keeps on board with its continuous measurement command
+ * (aR0!) instead of starting a measurement for each reading
+ *    - The precipitation and tips reported are the increase in those totals
+ * since the last reading, so the logger can read the sensor as seldom as it
+ * likes without losing any tips, and the reading takes no measurement time
+ *    - The sensor must be kept powered between readings
+ *
  * @see @ref sdi12_group_flags
  *
  * @section sensor_rainvue_ctor Sensor Constructor
@@ -124,11 +133,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "precipitation"
-#define RAINVUE10_PRECIPITATION_VAR_NAME "precipitation"
+#define RAINVUE10_PRECIPITATION_VAR_NAME MS_VAR_TEXT("precipitation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "inch" (in_i)
-#define RAINVUE10_PRECIPITATION_UNIT_NAME "inch"
+#define RAINVUE10_PRECIPITATION_UNIT_NAME MS_VAR_TEXT("inch")
 /// @brief Default variable short code; "RainVUEPrecipitation"
 #define RAINVUE10_PRECIPITATION_DEFAULT_CODE "RainVUEPrecipitation"
 /**@}*/
@@ -150,11 +159,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "precipitation"
-#define RAINVUE10_TIPS_VAR_NAME "precipitation"
+#define RAINVUE10_TIPS_VAR_NAME MS_VAR_TEXT("precipitation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "event"
-#define RAINVUE10_TIPS_UNIT_NAME "event"
+#define RAINVUE10_TIPS_UNIT_NAME MS_VAR_TEXT("event")
 /// @brief Default variable short code; "RainVUETips"
 #define RAINVUE10_TIPS_DEFAULT_CODE "RainVUETips"
 /**@}*/
@@ -186,11 +195,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "instrumentStatusCode"
-#define RAINVUE10_RAINRATEAVE_VAR_NAME "rainfallRate"
+#define RAINVUE10_RAINRATEAVE_VAR_NAME MS_VAR_TEXT("rainfallRate")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "inchPerHour"
-#define RAINVUE10_RAINRATEAVE_UNIT_NAME "inchPerHour"
+#define RAINVUE10_RAINRATEAVE_UNIT_NAME MS_VAR_TEXT("inchPerHour")
 /// @brief Default variable short code; "RainVUERateAve"
 #define RAINVUE10_RAINRATEAVE_DEFAULT_CODE "RainVUERateAve"
 /**@}*/
@@ -213,11 +222,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "instrumentStatusCode"
-#define RAINVUE10_RAINRATEMAX_VAR_NAME "rainfallRate"
+#define RAINVUE10_RAINRATEMAX_VAR_NAME MS_VAR_TEXT("rainfallRate")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "inchPerHour"
-#define RAINVUE10_RAINRATEMAX_UNIT_NAME "inchPerHour"
+#define RAINVUE10_RAINRATEMAX_UNIT_NAME MS_VAR_TEXT("inchPerHour")
 /// @brief Default variable short code; "RainVUERateAve"
 #define RAINVUE10_RAINRATEMAX_DEFAULT_CODE "RainVUERateMax"
 /**@}*/
@@ -289,6 +298,53 @@ class CampbellRainVUE10 : public SDI12Sensors {
      * @brief Destroy the Campbell RainVUE10 object
      */
     ~CampbellRainVUE10() {}
+
+#ifdef MS_RAINVUE_ACCUMULATED
+    /**
+     * @brief Read the sensor's own running totals instead of starting a
+     * measurement for each reading (#MS_RAINVUE_ACCUMULATED).
+     *
+     * The precipitation and tips are reported as the increase since the last
+     * reading; the first reading after this is turned on only sets the
+     * starting point and reports them as -9999.  The rain rates are reported
+     * as the sensor gives them.  Only one measurement is taken for each
+     * reading.
+     *
+     * @param accumulated True to read the running totals
+     */
+    void setAccumulatedMode(bool accumulated);
+    /**
+     * @brief Check if the sensor's running totals are read.
+     *
+     * @return **bool** True if they are.
+     */
+    bool getAccumulatedMode(void) {
+        return _accumulated;
+    }
+
+ protected:
+    /**
+     * @copydoc SDI12Sensors::getResults()
+     *
+     * In accumulated mode this turns the running totals into the increase
+     * since the last reading.
+     */
+    bool getResults(void) override;
+
+ private:
+    /**
+     * @brief True if the sensor's running totals are read
+     */
+    bool _accumulated = false;
+    /**
+     * @brief The precipitation total at the last reading, or -9999
+     */
+    float _lastDepth = -9999;
+    /**
+     * @brief The tip count at the last reading, or -9999
+     */
+    float _lastTips = -9999;
+#endif
 };
 
 
@@ -133,11 +133,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "permittivity"
-#define TM_EA_VAR_NAME "permittivity"
+#define TM_EA_VAR_NAME MS_VAR_TEXT("permittivity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "faradPerMeter" (F/m)
-#define TM_EA_UNIT_NAME "faradPerMeter"
+#define TM_EA_UNIT_NAME MS_VAR_TEXT("faradPerMeter")
 /// @brief Default variable short code; "SoilEa"
 #define TM_EA_DEFAULT_CODE "SoilEa"
 /**@}*/
@@ -164,11 +164,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define TM_TEMP_VAR_NAME "temperature"
+#define TM_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define TM_TEMP_UNIT_NAME "degreeCelsius"
+#define TM_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "SoilTemp"
 #define TM_TEMP_DEFAULT_CODE "SoilTemp"
 /**@}*/
@@ -197,11 +197,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "volumetricWaterContent"
-#define TM_VWC_VAR_NAME "volumetricWaterContent"
+#define TM_VWC_VAR_NAME MS_VAR_TEXT("volumetricWaterContent")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent" -
 /// volumetric percent water content (%, m3/100m3)
-#define TM_VWC_UNIT_NAME "percent"
+#define TM_VWC_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "SoilVWC"
 #define TM_VWC_DEFAULT_CODE "SoilVWC"
 /**@}*/
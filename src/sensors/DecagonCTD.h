@@ -115,11 +115,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificConductance"
-#define CTD_COND_VAR_NAME "specificConductance"
+#define CTD_COND_VAR_NAME MS_VAR_TEXT("specificConductance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define CTD_COND_UNIT_NAME "microsiemenPerCentimeter"
+#define CTD_COND_UNIT_NAME MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "CTDcond"
 #define CTD_COND_DEFAULT_CODE "CTDcond"
 /**@}*/
@@ -146,11 +146,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define CTD_TEMP_VAR_NAME "temperature"
+#define CTD_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define CTD_TEMP_UNIT_NAME "degreeCelsius"
+#define CTD_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "CTDtemp"
 #define CTD_TEMP_DEFAULT_CODE "CTDtemp"
 /**@}*/
@@ -177,11 +177,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "waterDepth"
-#define CTD_DEPTH_VAR_NAME "waterDepth"
+#define CTD_DEPTH_VAR_NAME MS_VAR_TEXT("waterDepth")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "millimeter"
-#define CTD_DEPTH_UNIT_NAME "millimeter"
+#define CTD_DEPTH_UNIT_NAME MS_VAR_TEXT("millimeter")
 /// @brief Default variable short code; "CTDdepth"
 #define CTD_DEPTH_DEFAULT_CODE "CTDdepth"
 /**@}*/
@@ -110,11 +110,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificConductance"
-#define ES2_COND_VAR_NAME "specificConductance"
+#define ES2_COND_VAR_NAME MS_VAR_TEXT("specificConductance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define ES2_COND_UNIT_NAME "microsiemenPerCentimeter"
+#define ES2_COND_UNIT_NAME MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "ES2Cond"
 #define ES2_COND_DEFAULT_CODE "ES2Cond"
 /**@}*/
@@ -141,11 +141,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define ES2_TEMP_VAR_NAME "temperature"
+#define ES2_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define ES2_TEMP_UNIT_NAME "degreeCelsius"
+#define ES2_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "ES2Temp"
 #define ES2_TEMP_DEFAULT_CODE "ES2Temp"
 /**@}*/
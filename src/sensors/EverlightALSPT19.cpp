@@ -9,6 +9,7 @@
  */
 
 #include "EverlightALSPT19.h"
+#include "ProcessorAnalog.h"
 
 
 // The constructor - because this is I2C, only need the power pin
@@ -55,14 +56,13 @@ bool EverlightALSPT19::addSingleMeasurementResult(void) {
 
         // First measure the analog voltage.
         // The return value from analogRead() is IN BITS NOT IN VOLTS!!
-        // Take a priming reading.
-        // First reading will be low - discard
-        analogRead(_dataPin);
-        // Take the reading we'll keep
-        uint32_t sensor_adc = analogRead(_dataPin);
+        // This takes and discards a priming reading, since the first reading
+        // will be low, then averages #MS_PROCESSOR_ADC_SAMPLES readings.
+        float sensor_adc = ProcessorAnalog::read(_dataPin,
+                                                 ALSPT19_ADC_RESOLUTION);
         MS_DEEP_DBG("  ADC Bits:", sensor_adc);
 
-        if (0 == sensor_adc) {
+        if (sensor_adc < 1) {
             // Prevent underflow, can never be ALSPT19_ADC_RANGE
             sensor_adc = 1;
         }
@@ -186,11 +186,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "electricCurrent"
-#define ALSPT19_VOLTAGE_VAR_NAME "voltage"
+#define ALSPT19_VOLTAGE_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microampere"
-#define ALSPT19_VOLTAGE_UNIT_NAME "volt"
+#define ALSPT19_VOLTAGE_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "ALSPT19Voltage"
 #define ALSPT19_VOLTAGE_DEFAULT_CODE "ALSPT19Voltage"
 /**@}*/
@@ -217,11 +217,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "electricCurrent"
-#define ALSPT19_CURRENT_VAR_NAME "electricCurrent"
+#define ALSPT19_CURRENT_VAR_NAME MS_VAR_TEXT("electricCurrent")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microampere"
-#define ALSPT19_CURRENT_UNIT_NAME "microampere"
+#define ALSPT19_CURRENT_UNIT_NAME MS_VAR_TEXT("microampere")
 /// @brief Default variable short code; "ALSPT19Current"
 #define ALSPT19_CURRENT_DEFAULT_CODE "ALSPT19Current"
 /**@}*/
@@ -248,11 +248,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "illuminance"
-#define ALSPT19_ILLUMINANCE_VAR_NAME "illuminance"
+#define ALSPT19_ILLUMINANCE_VAR_NAME MS_VAR_TEXT("illuminance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "lux"
-#define ALSPT19_ILLUMINANCE_UNIT_NAME "lux"
+#define ALSPT19_ILLUMINANCE_UNIT_NAME MS_VAR_TEXT("lux")
 /// @brief Default variable short code; "ALSPT19Lux"
 #define ALSPT19_ILLUMINANCE_DEFAULT_CODE "ALSPT19Lux"
 /**@}*/
@@ -19,14 +19,18 @@ FreescaleMPL115A2::FreescaleMPL115A2(TwoWire* theI2C, int8_t powerPin,
     : Sensor("FreescaleMPL115A2", MPL115A2_NUM_VARIABLES,
              MPL115A2_WARM_UP_TIME_MS, MPL115A2_STABILIZATION_TIME_MS,
              MPL115A2_MEASUREMENT_TIME_MS, powerPin, -1, measurementsToAverage),
-      _i2c(theI2C) {}
+      _i2c(theI2C) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 FreescaleMPL115A2::FreescaleMPL115A2(int8_t  powerPin,
                                      uint8_t measurementsToAverage)
     : Sensor("FreescaleMPL115A2", MPL115A2_NUM_VARIABLES,
              MPL115A2_WARM_UP_TIME_MS, MPL115A2_STABILIZATION_TIME_MS,
              MPL115A2_MEASUREMENT_TIME_MS, powerPin, -1, measurementsToAverage,
              MPL115A2_INC_CALC_VARIABLES),
-      _i2c(&Wire) {}
+      _i2c(&Wire) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 // Destructor
 FreescaleMPL115A2::~FreescaleMPL115A2() {}
 
@@ -120,11 +120,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define MPL115A2_TEMP_VAR_NAME "temperature"
+#define MPL115A2_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define MPL115A2_TEMP_UNIT_NAME "degreeCelsius"
+#define MPL115A2_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "FreescaleMPL115A2_Temp"
 #define MPL115A2_TEMP_DEFAULT_CODE "FreescaleMPL115A2_Temp"
 /**@}*/
@@ -147,11 +147,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "atmosphericPressure"
-#define MPL115A2_PRESSURE_VAR_NAME "atmosphericPressure"
+#define MPL115A2_PRESSURE_VAR_NAME MS_VAR_TEXT("atmosphericPressure")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "kilopascal" (kPa)
-#define MPL115A2_PRESSURE_UNIT_NAME "kilopascal"
+#define MPL115A2_PRESSURE_UNIT_NAME MS_VAR_TEXT("kilopascal")
 /// @brief Default variable short code; "FreescaleMPL115A2_Pressure"
 #define MPL115A2_PRESSURE_DEFAULT_CODE "FreescaleMPL115A2_Pressure"
 /**@}*/
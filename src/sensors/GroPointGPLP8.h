@@ -100,10 +100,10 @@
 #define GPLP8_MOIST_RESOLUTION 1
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
-#define GPLP8_MOIST_VAR_NAME "volumetricWaterContent"
+#define GPLP8_MOIST_VAR_NAME MS_VAR_TEXT("volumetricWaterContent")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
-#define GPLP8_MOIST_UNIT_NAME "percent"
+#define GPLP8_MOIST_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "GPLP8Moist"
 #define GPLP8_MOIST_DEFAULT_CODE "GPLP8Moist"
 /**@}*/
@@ -124,11 +124,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define GPLP8_TEMP_VAR_NAME "temperature"
+#define GPLP8_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define GPLP8_TEMP_UNIT_NAME "degreeCelsius"
+#define GPLP8_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "GPLP8Temp"
 #define GPLP8_TEMP_DEFAULT_CODE "GPLP8Temp"
 /**@}*/
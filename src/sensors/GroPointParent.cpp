@@ -27,7 +27,12 @@ GroPointParent::GroPointParent(byte modbusAddress, Stream* stream,
       _modbusAddress(modbusAddress),
       _stream(stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2) {
+    setBus(SENSOR_BUS_RS485, reinterpret_cast<uintptr_t>(_stream));
+#ifdef MS_MODBUS_SHARED
+    _modbusBus = ModbusBusManager::getManager(_stream);
+#endif
+}
 GroPointParent::GroPointParent(byte modbusAddress, Stream& stream,
                                int8_t powerPin, int8_t powerPin2,
                                int8_t enablePin, uint8_t measurementsToAverage,
@@ -43,7 +48,12 @@ GroPointParent::GroPointParent(byte modbusAddress, Stream& stream,
       _modbusAddress(modbusAddress),
       _stream(&stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2) {
+    setBus(SENSOR_BUS_RS485, reinterpret_cast<uintptr_t>(_stream));
+#ifdef MS_MODBUS_SHARED
+    _modbusBus = ModbusBusManager::getManager(_stream);
+#endif
+}
 // Destructor
 GroPointParent::~GroPointParent() {}
 
@@ -60,7 +70,13 @@ String GroPointParent::getSensorLocation(void) {
 bool GroPointParent::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
+#ifdef MS_MODBUS_SHARED
+    _modbusBus->setEnablePin(_RS485EnablePin);
+    // GroPoint probes talk at 19200 baud, not the manager's default 9600
+    _modbusBus->setBaudRate(19200);
+#else
     if (_RS485EnablePin >= 0) pinMode(_RS485EnablePin, OUTPUT);
+#endif
     if (_powerPin2 >= 0) pinMode(_powerPin2, OUTPUT);
 
 #ifdef MS_GROPOINTPARENT_DEBUG_DEEP
@@ -71,6 +87,9 @@ bool GroPointParent::setup(void) {
     // required This realy can't fail so adding the return value is just for
     // show
     retVal &= _gsensor.begin(_model, _modbusAddress, _stream, _RS485EnablePin);
+#ifdef MS_GROPOINT_BLOCK_READ
+    retVal &= _gmodbus.begin(_modbusAddress, _stream, _RS485EnablePin);
+#endif
 
     return retVal;
 }
@@ -87,10 +106,21 @@ bool GroPointParent::wake(void) {
     // Send the command to begin taking readings, trying up to 5 times
     bool    success = false;
     uint8_t ntries  = 0;
+#ifdef MS_MODBUS_SHARED
+    uint8_t maxTries = _modbusBus->getAttempts(_modbusAddress);
+#else
+    uint8_t maxTries = MODBUS_ATTEMPTS;
+#endif
     MS_DBG(F("Start Measurement on"), getSensorNameAndLocation());
-    while (!success && ntries < 5) {
+    while (!success && ntries < maxTries) {
         MS_DBG('(', ntries + 1, F("):"));
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->beginTransaction(_modbusAddress);
+#endif
         success = _gsensor.startMeasurement();
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->endTransaction(_modbusAddress, success);
+#endif
         ntries++;
     }
 
@@ -119,13 +149,24 @@ bool GroPointParent::sleep(void) {
         return true;
     }
 
-    // Send the command to begin taking readings, trying up to 5 times
+    // Send the command to stop taking readings, trying up to 5 times
     bool    success = false;
     uint8_t ntries  = 0;
+#ifdef MS_MODBUS_SHARED
+    uint8_t maxTries = _modbusBus->getAttempts(_modbusAddress);
+#else
+    uint8_t maxTries = MODBUS_ATTEMPTS;
+#endif
     MS_DBG(F("Stop Measurement on"), getSensorNameAndLocation());
-    while (!success && ntries < 5) {
+    while (!success && ntries < maxTries) {
         MS_DBG('(', ntries + 1, F("):"));
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->beginTransaction(_modbusAddress);
+#endif
         success = _gsensor.stopMeasurement();
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->endTransaction(_modbusAddress, success);
+#endif
         ntries++;
     }
     if (success) {
@@ -198,6 +239,27 @@ void GroPointParent::powerDown(void) {
 }
 
 
+#ifdef MS_GROPOINT_BLOCK_READ
+void GroPointParent::setFrameDelay(uint16_t frameDelay_us) {
+    _frameDelay_us = frameDelay_us;
+}
+
+
+// Each register is a big-endian signed integer in tenths; the data of the
+// response starts after the address, the function code, and the byte count
+bool GroPointParent::getRegisterBlock(int16_t startRegister, uint8_t count,
+                                      float* const values[]) {
+    if (!_gmodbus.getRegisters(GROPOINT_READ_COMMAND, startRegister, count)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        *values[i] = _gmodbus.int16FromFrame(bigEndian, 3 + 2 * i) / 10.0f;
+    }
+    return true;
+}
+#endif
+
+
 bool GroPointParent::addSingleMeasurementResult(void) {
     bool success  = false;
     bool successT = false;
@@ -213,7 +275,34 @@ bool GroPointParent::addSingleMeasurementResult(void) {
             case GPLP8: {
                 // Get Moisture Values
                 MS_DBG(F("Get Values from"), getSensorNameAndLocation());
+#ifdef MS_GROPOINT_BLOCK_READ
+                float* const moisture[] = {&M1, &M2, &M3, &M4,
+                                           &M5, &M6, &M7, &M8};
+                float* const temperature[] = {&T1, &T2, &T3, &T4, &T5,
+                                              &T6, &T7, &T8, &T9, &T10,
+                                              &T11, &T12, &T13};
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->beginTransaction(_modbusAddress);
+#endif
+                success = getRegisterBlock(GPLP8_MOIST_REGISTER, 8, moisture);
+                // Don't wait out a second timeout on a probe that isn't there
+                if (success) {
+                    delayMicroseconds(_frameDelay_us);
+                    successT = getRegisterBlock(GPLP8_TEMP_REGISTER, 13,
+                                                temperature);
+                }
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->endTransaction(_modbusAddress, success);
+#endif
+#else
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->beginTransaction(_modbusAddress);
+#endif
                 success = _gsensor.getValues(M1, M2, M3, M4, M5, M6, M7, M8);
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->endTransaction(_modbusAddress, success);
+#endif
+#endif
 
                 // Fix not-a-number values
                 if (!success || isnan(M1)) M1 = -9999;
@@ -230,9 +319,17 @@ bool GroPointParent::addSingleMeasurementResult(void) {
                 MS_DBG(F("    "), M1, ',', M2, ',', M3, ',', M4, ',', M5, ',',
                        M6, ',', M7, ',', M8);
 
+#ifndef MS_GROPOINT_BLOCK_READ
                 // Get Temperature Values
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->beginTransaction(_modbusAddress);
+#endif
                 successT = _gsensor.getTemperatureValues(
                     T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13);
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->endTransaction(_modbusAddress, successT);
+#endif
+#endif
 
                 // Fix not-a-number values
                 if (!successT || isnan(T1)) T1 = -9999;
@@ -73,13 +73,47 @@
 #define MS_DEBUGGING_DEEP "GroPointParent"
 #endif
 
+/**
+ * @def MS_GROPOINT_BLOCK_READ
+ * @brief Read all of the moisture segments and all of the temperature sensors
+ * of a GroPoint profile probe as two register blocks in one bus transaction.
+ *
+ * The probe's moisture and temperature registers aren't next to each other,
+ * so two requests are the fewest it allows.  With this flag the two blocks
+ * are read back to back, only waiting the frame delay set with
+ * GroPointParent::setFrameDelay() between them, and the temperatures aren't
+ * asked for at all if the probe didn't answer for the moisture, so a missing
+ * probe only costs one response timeout.
+ *
+ * @ingroup gropoint_group
+ */
+// #define MS_GROPOINT_BLOCK_READ
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #undef MS_DEBUGGING_DEEP
 #include "VariableBase.h"
 #include "SensorBase.h"
+#include "ModbusBusManager.h"
 #include "GroPointModbus.h"
+#ifdef MS_GROPOINT_BLOCK_READ
+#include <SensorModbusMaster.h>
+
+/// @brief The Modbus function code to read the probe's input registers
+#define GROPOINT_READ_COMMAND 0x04
+/// @brief The first input register of the moisture of the first segment, in
+/// tenths of a percent; one register for each segment.
+#define GPLP8_MOIST_REGISTER 0
+/// @brief The first input register of the first temperature sensor, in tenths
+/// of a degree Celsius; one register for each sensor.
+#define GPLP8_TEMP_REGISTER 100
+#ifndef GROPOINT_FRAME_DELAY_US
+/// @brief The default delay between the requests for the two register blocks,
+/// in microseconds; 3.5 characters at the probe's 19200 baud.
+#define GROPOINT_FRAME_DELAY_US 2000
+#endif
+#endif
 
 /* clang-format off */
 /**
@@ -199,13 +233,44 @@ class GroPointParent : public Sensor {
      */
     bool addSingleMeasurementResult(void) override;
 
+#ifdef MS_GROPOINT_BLOCK_READ
+    /**
+     * @brief Set the delay between the requests for the moisture and the
+     * temperature register blocks.
+     *
+     * The default of #GROPOINT_FRAME_DELAY_US is the Modbus inter-frame gap
+     * at the probe's default baud rate.  Some probes need more time to turn
+     * the line around; a probe at a faster baud rate can use less.
+     *
+     * @param frameDelay_us The delay in microseconds
+     */
+    void setFrameDelay(uint16_t frameDelay_us);
+#endif
+
  private:
+#ifdef MS_GROPOINT_BLOCK_READ
+    /**
+     * @brief Read a block of registers that each hold a value in tenths.
+     *
+     * @param startRegister The first register of the block
+     * @param count The number of registers
+     * @param values Where to put each of the values
+     * @return **bool** True if the probe answered.
+     */
+    bool getRegisterBlock(int16_t startRegister, uint8_t count,
+                          float* const values[]);
+    modbusMaster _gmodbus;
+    uint16_t     _frameDelay_us = GROPOINT_FRAME_DELAY_US;
+#endif
     gropoint      _gsensor;
     gropointModel _model;
     byte          _modbusAddress;
     Stream*       _stream;
     int8_t        _RS485EnablePin;
     int8_t        _powerPin2;
+#ifdef MS_MODBUS_SHARED
+    ModbusBusManager* _modbusBus;
+#endif
 };
 
 #endif  // SRC_SENSORS_GROPOINTPARENT_H_
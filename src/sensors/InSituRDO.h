@@ -233,11 +233,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolved"
-#define INSITU_RDO_DOMGL_VAR_NAME "oxygenDissolved"
+#define INSITU_RDO_DOMGL_VAR_NAME MS_VAR_TEXT("oxygenDissolved")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define INSITU_RDO_DOMGL_UNIT_NAME "milligramPerLiter"
+#define INSITU_RDO_DOMGL_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "RDOppm"
 #define INSITU_RDO_DOMGL_DEFAULT_CODE "RDOppm"
 /**@}*/
@@ -272,11 +272,12 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolvedPercentOfSaturation"
-#define INSITU_RDO_DOPCT_VAR_NAME "oxygenDissolvedPercentOfSaturation"
+#define INSITU_RDO_DOPCT_VAR_NAME \
+    MS_VAR_TEXT("oxygenDissolvedPercentOfSaturation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
 /// (% saturation)
-#define INSITU_RDO_DOPCT_UNIT_NAME "percent"
+#define INSITU_RDO_DOPCT_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "RDOpercent"
 #define INSITU_RDO_DOPCT_DEFAULT_CODE "RDOpercent"
 /**@}*/
@@ -306,11 +307,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define INSITU_RDO_TEMP_VAR_NAME "temperature"
+#define INSITU_RDO_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define INSITU_RDO_TEMP_UNIT_NAME "degreeCelsius"
+#define INSITU_RDO_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "RDOtempC"
 #define INSITU_RDO_TEMP_DEFAULT_CODE "RDOtempC"
 /**@}*/
@@ -333,10 +334,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "vaporPressure"
-#define INSITU_RDO_PRESSURE_VAR_NAME "vaporPressure"
+#define INSITU_RDO_PRESSURE_VAR_NAME MS_VAR_TEXT("vaporPressure")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "torr"
-#define INSITU_RDO_PRESSURE_UNIT_NAME "torr"
+#define INSITU_RDO_PRESSURE_UNIT_NAME MS_VAR_TEXT("torr")
 /// @brief Default variable short code; "RDOppO2"
 #define INSITU_RDO_PRESSURE_DEFAULT_CODE "RDOppO2"
 /**@}*/
@@ -126,11 +126,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificConductance"
-#define ITROLLA_PRESSURE_VAR_NAME "pressureGauge"
+#define ITROLLA_PRESSURE_VAR_NAME MS_VAR_TEXT("pressureGauge")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "pounds per square inch" (psi)
-#define ITROLLA_PRESSURE_UNIT_NAME "psi"
+#define ITROLLA_PRESSURE_UNIT_NAME MS_VAR_TEXT("psi")
 /// @brief Default variable short code; "ITROLLpressure"
 #define ITROLLA_PRESSURE_DEFAULT_CODE "ITROLLpressure"
 /**@}*/
@@ -157,11 +157,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define ITROLLA_TEMP_TEMP_VAR_NAME "temperature"
+#define ITROLLA_TEMP_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define ITROLLA_TEMP_TEMP_UNIT_NAME "degreeCelsius"
+#define ITROLLA_TEMP_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "ITROLLtemp"
 #define ITROLLA_TEMP_DEFAULT_CODE "ITROLLtemp"
 /**@}*/
@@ -188,11 +188,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "waterDepth"
-#define ITROLLA_DEPTH_VAR_NAME "waterDepth"
+#define ITROLLA_DEPTH_VAR_NAME MS_VAR_TEXT("waterDepth")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "millimeter"
-#define ITROLLA_DEPTH_UNIT_NAME "feet"
+#define ITROLLA_DEPTH_UNIT_NAME MS_VAR_TEXT("feet")
 /// @brief Default variable short code; "ITROLLdepth"
 #define ITROLLA_DEPTH_DEFAULT_CODE "ITROLLdepth"
 /**@}*/
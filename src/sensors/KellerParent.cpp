@@ -27,7 +27,13 @@ KellerParent::KellerParent(byte modbusAddress, Stream* stream, int8_t powerPin,
       _modbusAddress(modbusAddress),
       _stream(stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2),
+      _nominalMeasurementTime_ms(measurementTime_ms) {
+    setBus(SENSOR_BUS_RS485, reinterpret_cast<uintptr_t>(_stream));
+#ifdef MS_MODBUS_SHARED
+    _modbusBus = ModbusBusManager::getManager(_stream);
+#endif
+}
 KellerParent::KellerParent(byte modbusAddress, Stream& stream, int8_t powerPin,
                            int8_t powerPin2, int8_t enablePin,
                            uint8_t measurementsToAverage, kellerModel model,
@@ -42,7 +48,13 @@ KellerParent::KellerParent(byte modbusAddress, Stream& stream, int8_t powerPin,
       _modbusAddress(modbusAddress),
       _stream(&stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2),
+      _nominalMeasurementTime_ms(measurementTime_ms) {
+    setBus(SENSOR_BUS_RS485, reinterpret_cast<uintptr_t>(_stream));
+#ifdef MS_MODBUS_SHARED
+    _modbusBus = ModbusBusManager::getManager(_stream);
+#endif
+}
 // Destructor
 KellerParent::~KellerParent() {}
 
@@ -59,7 +71,11 @@ String KellerParent::getSensorLocation(void) {
 bool KellerParent::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
+#ifdef MS_MODBUS_SHARED
+    _modbusBus->setEnablePin(_RS485EnablePin);
+#else
     if (_RS485EnablePin >= 0) pinMode(_RS485EnablePin, OUTPUT);
+#endif
     if (_powerPin2 >= 0) pinMode(_powerPin2, OUTPUT);
 
 #ifdef MS_KELLERPARENT_DEBUG_DEEP
@@ -70,6 +86,9 @@ bool KellerParent::setup(void) {
     // required This realy can't fail so adding the return value is just for
     // show
     retVal &= _ksensor.begin(_model, _modbusAddress, _stream, _RS485EnablePin);
+#ifdef MS_KELLER_SINGLE_FRAME
+    retVal &= _kmodbus.begin(_modbusAddress, _stream, _RS485EnablePin);
+#endif
 
     return retVal;
 }
@@ -128,6 +147,38 @@ void KellerParent::powerDown(void) {
 }
 
 
+// The first reading after a wake always waits the full measurement time
+bool KellerParent::wake(void) {
+    _measurementTime_ms = _nominalMeasurementTime_ms;
+    return Sensor::wake();
+}
+
+
+void KellerParent::setRepollTime(uint32_t repollTime_ms) {
+    _repollTime_ms = repollTime_ms;
+}
+uint32_t KellerParent::getRepollTime(void) {
+    return _repollTime_ms;
+}
+
+
+#ifdef MS_KELLER_SINGLE_FRAME
+// P1 and TOB1 are each a big-endian float in two registers; the data of the
+// response starts after the address, the function code, and the byte count
+bool KellerParent::getValuesSingleFrame(float& pressureBar,
+                                        float& temperatureC) {
+    const int16_t numRegisters = KELLER_TOB1_REGISTER - KELLER_P1_REGISTER + 2;
+    if (!_kmodbus.getRegisters(0x03, KELLER_P1_REGISTER, numRegisters)) {
+        return false;
+    }
+    pressureBar  = _kmodbus.float32FromFrame(bigEndian, 3);
+    temperatureC = _kmodbus.float32FromFrame(
+        bigEndian, 3 + 2 * (KELLER_TOB1_REGISTER - KELLER_P1_REGISTER));
+    return true;
+}
+#endif
+
+
 bool KellerParent::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -143,7 +194,17 @@ bool KellerParent::addSingleMeasurementResult(void) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
         // Get Values
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->beginTransaction(_modbusAddress);
+#endif
+#ifdef MS_KELLER_SINGLE_FRAME
+        success = getValuesSingleFrame(waterPressureBar, waterTempertureC);
+#else
         success     = _ksensor.getValues(waterPressureBar, waterTempertureC);
+#endif
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->endTransaction(_modbusAddress, success);
+#endif
         waterDepthM = _ksensor.calcWaterDepthM(
             waterPressureBar,
             waterTempertureC);  // float calcWaterDepthM(float waterPressureBar,
@@ -161,6 +222,12 @@ bool KellerParent::addSingleMeasurementResult(void) {
         MS_DBG(F("  Pressure_mbar:"), waterPressure_mBar);
         MS_DBG(F("  Temp_C:"), waterTempertureC);
         MS_DBG(F("  Height_m:"), waterDepthM);
+
+        // The sensor has settled, so the next readings only wait the re-poll
+        // time
+        if (success && _repollTime_ms > 0) {
+            _measurementTime_ms = _repollTime_ms;
+        }
     } else {
         MS_DBG(getSensorNameAndLocation(), F("is not currently measuring!"));
     }
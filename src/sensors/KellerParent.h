@@ -91,13 +91,33 @@
 #define MS_DEBUGGING_DEEP "KellerParent"
 #endif
 
+/**
+ * @def MS_KELLER_SINGLE_FRAME
+ * @brief Read the pressure and temperature of a Keller sensor in one Modbus
+ * frame.
+ *
+ * The KellerModbus library asks for the pressure (P1) and the temperature
+ * (TOB1) separately, so every reading is two requests and two responses, each
+ * with its own turnaround and inter-frame gap.  With this flag the registers
+ * from P1 to TOB1 are read in one request instead.  Together with
+ * KellerParent::setRepollTime() this lets a burst of readings be taken
+ * quickly while the sensor stays powered.
+ *
+ * @ingroup keller_group
+ */
+// #define MS_KELLER_SINGLE_FRAME
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #undef MS_DEBUGGING_DEEP
 #include "VariableBase.h"
 #include "SensorBase.h"
+#include "ModbusBusManager.h"
 #include <KellerModbus.h>
+#ifdef MS_KELLER_SINGLE_FRAME
+#include <SensorModbusMaster.h>
+#endif
 
 /** @ingroup keller_group */
 /**@{*/
@@ -108,6 +128,16 @@
 #define KELLER_NUM_VARIABLES 3
 /// @brief Sensor::_incCalcValues; we don't calculate any additional values.
 #define KELLER_INC_CALC_VARIABLES 0
+#ifndef KELLER_P1_REGISTER
+/// @brief The first holding register of the pressure (P1) in bar, a 32-bit
+/// float; used with #MS_KELLER_SINGLE_FRAME.
+#define KELLER_P1_REGISTER 0x0002
+#endif
+#ifndef KELLER_TOB1_REGISTER
+/// @brief The first holding register of the temperature (TOB1) in degrees
+/// Celsius, a 32-bit float; used with #MS_KELLER_SINGLE_FRAME.
+#define KELLER_TOB1_REGISTER 0x0008
+#endif
 
 /**
  * @anchor keller_pressure
@@ -120,10 +150,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "pressureGauge"
-#define KELLER_PRESSURE_VAR_NAME "pressureGauge"
+#define KELLER_PRESSURE_VAR_NAME MS_VAR_TEXT("pressureGauge")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millibar"
-#define KELLER_PRESSURE_UNIT_NAME "millibar"
+#define KELLER_PRESSURE_UNIT_NAME MS_VAR_TEXT("millibar")
 /**@}*/
 
 /**
@@ -137,11 +167,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define KELLER_TEMP_VAR_NAME "temperature"
+#define KELLER_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define KELLER_TEMP_UNIT_NAME "degreeCelsius"
+#define KELLER_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /**@}*/
 
 /**
@@ -155,10 +185,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "gaugeHeight"
-#define KELLER_HEIGHT_VAR_NAME "gaugeHeight"
+#define KELLER_HEIGHT_VAR_NAME MS_VAR_TEXT("gaugeHeight")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "meter"
-#define KELLER_HEIGHT_UNIT_NAME "meter"
+#define KELLER_HEIGHT_UNIT_NAME MS_VAR_TEXT("meter")
 /**@}*/
 
 /**
@@ -244,18 +274,74 @@ class KellerParent : public Sensor {
     void powerUp(void) override;
     void powerDown(void) override;
 
+    /**
+     * @brief Wake the sensor and go back to the full measurement time for its
+     * first reading.
+     *
+     * @return **bool** True if the wake function completed successfully.
+     */
+    bool wake(void) override;
+
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
 
+    /**
+     * @brief Set a shorter measurement time for the readings after the first
+     * while the sensor stays awake.
+     *
+     * A Keller sensor keeps measuring while it's powered, so once the first
+     * reading after the sensor is woken has waited out the full measurement
+     * time the rest of the readings of the update can be taken as soon as the
+     * sensor has a new value.  With ten measurements to average and a re-poll
+     * time of 200 ms, for example, the ten readings take about 2 seconds.
+     * Use #MS_KELLER_SINGLE_FRAME to also make each reading one Modbus
+     * transaction instead of two.
+     *
+     * @param repollTime_ms The time in ms between the readings after the
+     * first; 0 to use the full measurement time for every reading, the
+     * default.
+     */
+    void setRepollTime(uint32_t repollTime_ms);
+    /**
+     * @brief Get the measurement time of the readings after the first.
+     *
+     * @return **uint32_t** The re-poll time in ms, or 0 if every reading waits
+     * the full measurement time.
+     */
+    uint32_t getRepollTime(void);
+
  private:
+#ifdef MS_KELLER_SINGLE_FRAME
+    /**
+     * @brief Read the pressure and temperature in one Modbus request.
+     *
+     * @param pressureBar The pressure in bar
+     * @param temperatureC The temperature in degrees Celsius
+     * @return **bool** True if the sensor answered.
+     */
+    bool getValuesSingleFrame(float& pressureBar, float& temperatureC);
+    modbusMaster _kmodbus;
+#endif
     keller      _ksensor;
     kellerModel _model;
     byte        _modbusAddress;
     Stream*     _stream;
     int8_t      _RS485EnablePin;
     int8_t      _powerPin2;
+    /**
+     * @brief The measurement time of the first reading after a wake
+     */
+    uint32_t _nominalMeasurementTime_ms;
+    /**
+     * @brief The measurement time of the readings after the first; see
+     * setRepollTime()
+     */
+    uint32_t _repollTime_ms = 0;
+#ifdef MS_MODBUS_SHARED
+    ModbusBusManager* _modbusBus;
+#endif
 };
 /**@}*/
 #endif  // SRC_SENSORS_KELLERPARENT_H_
@@ -94,6 +94,132 @@ bool MaxBotixSonar::wake(void) {
 }
 
 
+#if defined MS_MAXBOTIX_COLLECT_FRAMES
+bool MaxBotixSonar::startSingleMeasurement(void) {
+    // Throw away anything from before this measurement
+    while (_stream->available()) { _stream->read(); }
+    _frameCount = 0;
+    _frameValue = -1;
+    if (!Sensor::startSingleMeasurement()) return false;
+    triggerRange();
+    return true;
+}
+
+
+bool MaxBotixSonar::isMeasurementComplete(bool debug) {
+    if (bitRead(_sensorStatus, 6)) {
+        parseFrames();
+        // Trigger again if the last range never came back
+        if (millis() - _millisTrigger > 180) triggerRange();
+        if (_frameCount >= HRXL_MAX_FRAMES) {
+            if (debug) {
+                MS_DBG(getSensorNameAndLocation(), F("has"), _frameCount,
+                       F("frames"));
+            }
+            return true;
+        }
+    }
+    return Sensor::isMeasurementComplete(debug);
+}
+
+
+void MaxBotixSonar::parseFrames(void) {
+    bool measuring = bitRead(_sensorStatus, 6) && _frameCount < HRXL_MAX_FRAMES;
+    while (_stream->available()) {
+        int c = _stream->read();
+        if (!measuring) continue;
+        if (c == 'R') {
+            // Start of a frame
+            _frameValue = 0;
+        } else if (c >= '0' && c <= '9' && _frameValue >= 0) {
+            // Widen first; a fifth digit would overflow a 16-bit int
+            int32_t value = static_cast<int32_t>(_frameValue) * 10 + (c - '0');
+            // No range has more than 4 digits; this is garbage
+            _frameValue = value > 9999 ? -1 : static_cast<int16_t>(value);
+        } else if (c == '\r' && _frameValue >= 0) {
+            MS_DEEP_DBG(F("  Sonar frame:"), _frameValue);
+            if (!isBadRange(_frameValue)) {
+                _frames[_frameCount++] = _frameValue;
+            }
+            _frameValue = -1;
+            triggerRange();
+            if (_frameCount >= HRXL_MAX_FRAMES) measuring = false;
+        } else {
+            // Anything else means we lost our place in the frame
+            _frameValue = -1;
+        }
+    }
+}
+
+
+void MaxBotixSonar::triggerRange(void) {
+    _millisTrigger = millis();
+    if (_triggerPin < 0) return;
+    digitalWrite(_triggerPin, HIGH);
+    delayMicroseconds(30);  // Trigger must be held high for >20 µs
+    digitalWrite(_triggerPin, LOW);
+}
+
+
+// If it cannot obtain a result , the sonar is supposed to send a value just
+// above it's max range.  For 10m models, this is 9999, for 5m models it's
+// 4999.  The sonar might also send readings of 300 or 500 (the blanking
+// distance) if there are too many acoustic echos.  These sensors are not
+// capable of reading 0, so we also know the 0 value is bad.
+bool MaxBotixSonar::isBadRange(int16_t range) {
+    return range <= 300 || range == 500 || range == 4999 || range == 9999;
+}
+
+
+bool MaxBotixSonar::addSingleMeasurementResult(void) {
+    // Initialize values
+    bool    success = false;
+    int16_t result  = -9999;
+
+    // Check a measurement was *successfully* started (status bit 6 set)
+    // Only go on to get a result if it was
+    if (bitRead(_sensorStatus, 6)) {
+        // Pick up anything that came in since the last check
+        parseFrames();
+        MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
+        MS_DBG(F("  Good frames:"), _frameCount);
+
+        if (_frameCount > 0) {
+            // Sort the frames for the median; there are few enough for an
+            // insertion sort
+            for (uint8_t i = 1; i < _frameCount; i++) {
+                int16_t range = _frames[i];
+                int8_t  j     = i - 1;
+                while (j >= 0 && _frames[j] > range) {
+                    _frames[j + 1] = _frames[j];
+                    j--;
+                }
+                _frames[j + 1] = range;
+            }
+            uint8_t mid = _frameCount / 2;
+            if (_frameCount % 2 == 1) {
+                result = _frames[mid];
+            } else {
+                result = (_frames[mid - 1] + _frames[mid] + 1) / 2;
+            }
+            MS_DBG(F("  Median Sonar Range:"), result);
+            success = true;
+        }
+    } else {
+        MS_DBG(getSensorNameAndLocation(), F("is not currently measuring!"));
+    }
+
+    verifyAndAddMeasurementResult(HRXL_VAR_NUM, result);
+
+    // Unset the time stamp for the beginning of this measurement
+    _millisMeasurementRequested = 0;
+    // Unset the status bits for a measurement request (bits 5 & 6)
+    _sensorStatus &= 0b10011111;
+
+    // Return values shows if we got a not-obviously-bad reading
+    return success;
+}
+#else
 bool MaxBotixSonar::addSingleMeasurementResult(void) {
     // Initialize values
     bool    success = false;
@@ -175,3 +301,4 @@ bool MaxBotixSonar::addSingleMeasurementResult(void) {
     // Return values shows if we got a not-obviously-bad reading
     return success;
 }
+#endif
@@ -79,6 +79,25 @@
  *  - "Daisy chaining" sensors so the pulse-width output of one sensor acts as
  * the trigger for a second sensor *is not supported*.
  *
+ * @section sensor_maxbotix_flags Build flags
+ * - `-D MS_MAXBOTIX_COLLECT_FRAMES`
+ *      - collects the range frames as they come in over the whole measurement
+ * window and reports their median, instead of waiting on the stream for the
+ * first good frame
+ * - `-D HRXL_FRAME_WINDOW_MS=####`
+ *      - sets the length of the window frames are collected over; the default
+ * is 1000 ms, or 6 or 7 frames
+ *
+ * With `MS_MAXBOTIX_COLLECT_FRAMES`, the characters waiting on the stream are
+ * parsed each time the logger checks whether the measurement is finished, so
+ * the logger is free to do other work while the frames come in.  A triggered
+ * sonar is triggered again as each frame arrives.  The median throws out the
+ * odd long or short range from a wave or a bird without needing a second
+ * measurement.  The measurement finishes early once #HRXL_MAX_FRAMES frames
+ * are in.  If there are too many characters coming in for the logger's checks
+ * to keep up with the stream's buffer, call MaxBotixSonar::parseFrames() from
+ * the stream's `serialEvent()` or anywhere else in the loop.
+ *
  * @section sensor_maxbotix_datasheet Sensor Datasheet
  * - [HRXL WR Datasheet](https://github.com/EnviroDIY/ModularSensors/wiki/Sensor-Datasheets/Maxbotix-HRXL-MaxSonar-WR-Datasheet.pdf)
  * - [HRXL WRS Datasheet](https://github.com/EnviroDIY/ModularSensors/wiki/Sensor-Datasheets/Maxbotix-HRXL-MaxSonar-WRS-Datasheet.pdf)
@@ -133,9 +152,21 @@
 /// @brief Sensor::_stabilizationTime_ms; the HRXL is stable as soon as it warms
 /// up (0ms stabilization).
 #define HRXL_STABILIZATION_TIME_MS 0
+#if !defined(HRXL_FRAME_WINDOW_MS) || defined(DOXYGEN)
+/// @brief The time in ms frames are collected over for one measurement when
+/// built with `MS_MAXBOTIX_COLLECT_FRAMES`.
+#define HRXL_FRAME_WINDOW_MS 1000
+#endif
+#if defined(MS_MAXBOTIX_COLLECT_FRAMES) && !defined(DOXYGEN)
+#define HRXL_MEASUREMENT_TIME_MS HRXL_FRAME_WINDOW_MS
+#else
 /// @brief Sensor::_measurementTime_ms; the HRXL takes 166ms to complete a
-/// measurement.
+/// measurement, or #HRXL_FRAME_WINDOW_MS when collecting frames.
 #define HRXL_MEASUREMENT_TIME_MS 166
+#endif
+/// @brief The most frames kept for one measurement; the measurement is
+/// finished early when this many are in.
+#define HRXL_MAX_FRAMES 15
 /**@}*/
 
 /**
@@ -156,11 +187,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "distance"
-#define HRXL_VAR_NAME "distance"
+#define HRXL_VAR_NAME MS_VAR_TEXT("distance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "millimeter"
-#define HRXL_UNIT_NAME "millimeter"
+#define HRXL_UNIT_NAME MS_VAR_TEXT("millimeter")
 /// @brief Default variable short code; "SonarRange"
 #define HRXL_DEFAULT_CODE "SonarRange"
 /**@}*/
@@ -235,12 +266,55 @@ class MaxBotixSonar : public Sensor {
      */
     bool wake(void) override;
 
+#if defined(MS_MAXBOTIX_COLLECT_FRAMES) || defined(DOXYGEN)
+    /**
+     * @copydoc Sensor::startSingleMeasurement()
+     *
+     * This also clears the stream buffer and the collected frames and
+     * triggers the first range.
+     */
+    bool startSingleMeasurement(void) override;
+    /**
+     * @brief Check if the measurement is finished, parsing any frames waiting
+     * on the stream.
+     *
+     * @param debug True to output the result to the debugging Serial
+     * @return **bool** True if the measurement is complete.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+    /**
+     * @brief Parse the characters waiting on the stream into range frames.
+     *
+     * This never waits for characters.  Calling it outside of a measurement
+     * just empties the stream.
+     */
+    void parseFrames(void);
+#endif
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
 
  private:
+#if defined(MS_MAXBOTIX_COLLECT_FRAMES) || defined(DOXYGEN)
+    /**
+     * @brief Trigger a range, if there's a trigger pin.
+     */
+    void triggerRange(void);
+    /**
+     * @brief Check if a range is one of the values the sonar sends when it
+     * couldn't get a range.
+     *
+     * @param range The range in mm
+     * @return **bool** True if the range is bad or suspicious.
+     */
+    static bool isBadRange(int16_t range);
+
+    int16_t  _frames[HRXL_MAX_FRAMES];
+    uint8_t  _frameCount    = 0;
+    int16_t  _frameValue    = -1;
+    uint32_t _millisTrigger = 0;
+#endif
     int8_t  _triggerPin;
     Stream* _stream;
 };
@@ -9,31 +9,40 @@
  */
 
 #include "MaximDS18.h"
+#ifdef MS_DISCOVERY_CACHE
+#include "DiscoveryCache.h"
+#endif
 
 
 // The constructor - if the hex address is known - also need the power pin and
 // the data pin
 MaximDS18::MaximDS18(DeviceAddress OneWireAddress, int8_t powerPin,
-                     int8_t dataPin, uint8_t measurementsToAverage)
+                     int8_t dataPin, uint8_t measurementsToAverage,
+                     uint8_t resolution)
     : Sensor("MaximDS18", DS18_NUM_VARIABLES, DS18_WARM_UP_TIME_MS,
              DS18_STABILIZATION_TIME_MS, DS18_MEASUREMENT_TIME_MS, powerPin,
              dataPin, measurementsToAverage, DS18_INC_CALC_VARIABLES),
       _addressKnown(true),
+      _resolution(resolution < 9 ? 9 : (resolution > 12 ? 12 : resolution)),
       _internalOneWire(dataPin),
       _internalDallasTemp(&_internalOneWire) {
+    setBus(SENSOR_BUS_ONEWIRE, static_cast<uintptr_t>(dataPin));
     for (uint8_t i = 0; i < 8; i++) _OneWireAddress[i] = OneWireAddress[i];
 }
 // The constructor - if the hex address is NOT known - only need the power pin
 // and the data pin Can only use this if there is only a single sensor on the
 // pin
 MaximDS18::MaximDS18(int8_t powerPin, int8_t dataPin,
-                     uint8_t measurementsToAverage)
+                     uint8_t measurementsToAverage, uint8_t resolution)
     : Sensor("MaximDS18", DS18_NUM_VARIABLES, DS18_WARM_UP_TIME_MS,
              DS18_STABILIZATION_TIME_MS, DS18_MEASUREMENT_TIME_MS, powerPin,
              dataPin, measurementsToAverage, DS18_INC_CALC_VARIABLES),
       _addressKnown(false),
+      _resolution(resolution < 9 ? 9 : (resolution > 12 ? 12 : resolution)),
       _internalOneWire(dataPin),
-      _internalDallasTemp(&_internalOneWire) {}
+      _internalDallasTemp(&_internalOneWire) {
+    setBus(SENSOR_BUS_ONEWIRE, static_cast<uintptr_t>(dataPin));
+}
 // Destructor
 MaximDS18::~MaximDS18() {}
 
@@ -84,9 +93,24 @@ bool MaximDS18::setup(void) {
             address;  // create a variable to put the found address into
         ntries          = 0;
         bool gotAddress = false;
+#ifdef MS_DISCOVERY_CACHE
+        // Use the ROM found before if it still answers
+        if (DiscoveryCache::load(DISCOVERY_ONEWIRE_ROM, _dataPin, 0, address,
+                                 8) == 8 &&
+            _internalDallasTemp.isConnected(address)) {
+            MS_DBG(F("Using the cached address"));
+            gotAddress = true;
+        }
+#endif
         // Try 5 times to get an address
         while (!gotAddress && ntries < 5) {
             gotAddress = _internalOneWire.search(address);
+#ifdef MS_DISCOVERY_CACHE
+            if (gotAddress) {
+                DiscoveryCache::save(DISCOVERY_ONEWIRE_ROM, _dataPin, 0,
+                                     address, 8);
+            }
+#endif
             ntries++;
         }
         if (gotAddress) {
@@ -118,13 +142,22 @@ bool MaximDS18::setup(void) {
         }
     }
 
-    // Set resolution to 12 bit
+    // Set the resolution and shorten the measurement time to match; each bit
+    // less halves the conversion time.  The DS18S20 (family code 0x10) has no
+    // configuration register and always takes the full time.
     // All variable resolution sensors start up at 12 bit resolution by default
-    if (!_internalDallasTemp.setResolution(_OneWireAddress, 12)) {
+    _measurementTime_ms = DS18_MEASUREMENT_TIME_MS;
+    if (!_internalDallasTemp.setResolution(_OneWireAddress, _resolution)) {
         MS_DBG(F("Unable to set the resolution of this sensor:"),
                makeAddressString(_OneWireAddress));
         // We're not setting the error bit if this fails because not all sensors
         // have variable resolution.
+    } else if (_OneWireAddress[0] != DS18S20MODEL) {
+        uint8_t shift = 12 - _resolution;
+        _measurementTime_ms =
+            (DS18_MEASUREMENT_TIME_MS + (1 << shift) - 1) >> shift;
+        MS_DBG(F("Resolution set to"), _resolution,
+               F("bits; measurements take"), _measurementTime_ms, F("ms"));
     }
 
     // Tell the sensor that we do NOT want to wait for conversions to finish
@@ -154,14 +187,21 @@ bool MaximDS18::startSingleMeasurement(void) {
     // reason to go on.
     if (!Sensor::startSingleMeasurement()) return false;
 
+#ifdef MS_DS18_BUS_CONVERSION
+    // Join a conversion of every DS18 on the pin, or start one
+    uint32_t started = 0;
+    bool     success = joinBusConversion(started);
+#else
     // Send the command to get temperatures
     MS_DBG(F("Asking DS18 to take a measurement"));
     bool success =
         _internalDallasTemp.requestTemperaturesByAddress(_OneWireAddress);
+    uint32_t started = millis();
+#endif
 
     if (success) {
         // Update the time that a measurement was requested
-        _millisMeasurementRequested = millis();
+        _millisMeasurementRequested = started;
     } else {
         // Otherwise, make sure that the measurement start time and success bit
         // (bit 6) are unset
@@ -175,6 +215,65 @@ bool MaximDS18::startSingleMeasurement(void) {
 }
 
 
+#ifdef MS_DS18_BUS_CONVERSION
+MaximDS18::ds18BusConversion MaximDS18::_busConversions[MS_DS18_MAX_BUSES];
+
+bool MaximDS18::joinBusConversion(uint32_t& started) {
+    ds18BusConversion* bus = nullptr;
+    for (uint8_t i = 0; i < MS_DS18_MAX_BUSES && bus == nullptr; i++) {
+        if (_busConversions[i].generation != 0 &&
+            _busConversions[i].pin == _dataPin) {
+            bus = &_busConversions[i];
+        }
+    }
+    for (uint8_t i = 0; i < MS_DS18_MAX_BUSES && bus == nullptr; i++) {
+        if (_busConversions[i].generation == 0) {
+            bus      = &_busConversions[i];
+            bus->pin = _dataPin;
+        }
+    }
+    if (bus == nullptr) {
+        MS_DBG(F("No room to share conversions on pin"), _dataPin,
+               F("- asking DS18 to take a measurement"));
+        started = millis();
+        return _internalDallasTemp.requestTemperaturesByAddress(
+            _OneWireAddress);
+    }
+
+    // A conversion still running that this sensor hasn't read yet
+    if (bus->generation != 0 && bus->generation != _usedGeneration &&
+        millis() - bus->started < _measurementTime_ms) {
+        MS_DBG(F("Joining the DS18 conversion on pin"), _dataPin,
+               F("started"), millis() - bus->started, F("ms ago"));
+        started         = bus->started;
+        _usedGeneration = bus->generation;
+        return true;
+    }
+
+    // Skip ROM and Convert T (0x44), so every DS18 on the pin converts; a
+    // parasite powered bus is held high while they do
+    MS_DBG(F("Asking every DS18 on pin"), _dataPin,
+           F("to take a measurement"));
+    if (!_internalOneWire.reset()) { return false; }
+    _internalOneWire.skip();
+    _internalOneWire.write(0x44, _internalDallasTemp.isParasitePowerMode());
+    bus->started = millis();
+    if (++bus->generation == 0) { bus->generation = 1; }
+    _usedGeneration = bus->generation;
+    started         = bus->started;
+    return true;
+}
+#endif
+
+
+// A parasite powered DS18 draws its power from the data line while it's
+// converting, so nothing else can talk on the line until it's done.
+bool MaximDS18::isHoldingBus(void) {
+    return bitRead(_sensorStatus, 6) &&
+        _internalDallasTemp.isParasitePowerMode();
+}
+
+
 bool MaximDS18::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -88,6 +88,36 @@
 #define MS_DEBUGGING_STD "MaximDS18"
 #endif
 
+/**
+ * @def MS_DS18_BUS_CONVERSION
+ * @brief Start one conversion for every DS18 on a OneWire pin instead of one
+ * for each sensor.
+ *
+ * The first DS18 on the pin to start a measurement sends a Skip ROM Convert T
+ * to all of them.  The others on the pin that start while that conversion is
+ * running take their readings from it, so a string of probes needs only one
+ * conversion time per measurement instead of one per probe.
+ *
+ * @note In parasite power mode the converting sensor holds the bus, so the
+ * others can't start and join it.
+ *
+ * @ingroup sensor_ds18
+ */
+// #define MS_DS18_BUS_CONVERSION
+
+#ifdef MS_DS18_BUS_CONVERSION
+/**
+ * @def MS_DS18_MAX_BUSES
+ * @brief The number of OneWire pins that can share conversions; the DS18s
+ * on any more pins convert one at a time.
+ *
+ * @ingroup sensor_ds18
+ */
+#ifndef MS_DS18_MAX_BUSES
+#define MS_DS18_MAX_BUSES 4
+#endif
+#endif
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
@@ -118,8 +148,11 @@
 /// up (0ms stabilization).
 #define DS18_STABILIZATION_TIME_MS 0
 /// @brief Sensor::_measurementTime_ms; the DS18 takes 750ms to complete a
-/// measurement (at 12-bit: 750ms).
+/// measurement (at 12-bit: 750ms).  Each bit of resolution less halves the
+/// conversion time, down to 94ms at 9-bit.
 #define DS18_MEASUREMENT_TIME_MS 750
+/// @brief The default resolution of the DS18 conversion, in bits
+#define DS18_DEFAULT_RESOLUTION 12
 /**@}*/
 
 /**
@@ -147,11 +180,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define DS18_TEMP_VAR_NAME "temperature"
+#define DS18_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define DS18_TEMP_UNIT_NAME "degreeCelsius"
+#define DS18_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "DS18Temp"
 #define DS18_TEMP_DEFAULT_CODE "DS18Temp"
 /**@}*/
@@ -187,9 +220,14 @@ class MaximDS18 : public Sensor {
      * @param measurementsToAverage The number of measurements to take and
      * average before giving a "final" result from the sensor; optional with a
      * default value of 1.
+     * @param resolution The resolution of the conversion, 9 to 12 bits;
+     * optional with a default value of 12.  At 9-bit a conversion takes 94ms
+     * instead of 750ms, but the temperature is only read to 0.5°C.  The
+     * DS18S20 is always 9-bit and always takes 750ms.
      */
     MaximDS18(DeviceAddress OneWireAddress, int8_t powerPin, int8_t dataPin,
-              uint8_t measurementsToAverage = 1);
+              uint8_t measurementsToAverage = 1,
+              uint8_t resolution            = DS18_DEFAULT_RESOLUTION);
     /**
      * @brief Construct a new Maxim DS18 for a single sensor with an unknown
      * address.
@@ -206,9 +244,12 @@ class MaximDS18 : public Sensor {
      * @param measurementsToAverage The number of measurements to take and
      * average before giving a "final" result from the sensor; optional with a
      * default value of 1.
+     * @param resolution The resolution of the conversion, 9 to 12 bits;
+     * optional with a default value of 12.
      */
     MaximDS18(int8_t powerPin, int8_t dataPin,
-              uint8_t measurementsToAverage = 1);
+              uint8_t measurementsToAverage = 1,
+              uint8_t resolution            = DS18_DEFAULT_RESOLUTION);
     /**
      * @brief Destroy the Maxim DS18 object
      */
@@ -219,8 +260,9 @@ class MaximDS18 : public Sensor {
      * to take readings.
      *
      * This sets the pin modes and verifies the DS18's address.  It also
-     * verifies that the sensor is connected, reporting maximum resolution, and
-     * operating in ASYNC mode and updates the #_sensorStatus.  The sensor must
+     * verifies that the sensor is connected, sets the resolution and the
+     * measurement time to match, puts it in ASYNC mode, and updates the
+     * #_sensorStatus.  The sensor must
      * be powered for setup.
      *
      * @return **bool** True if the setup was successful.
@@ -247,10 +289,18 @@ class MaximDS18 : public Sensor {
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
+    /**
+     * @copydoc Sensor::isHoldingBus()
+     *
+     * A DS18 only holds the OneWire bus while it is converting on parasite
+     * power.
+     */
+    bool isHoldingBus(void) override;
 
  private:
     DeviceAddress _OneWireAddress;
     bool          _addressKnown;
+    uint8_t       _resolution;
     // Setup an internal OneWire instance to communicate with any OneWire
     // devices (not just Maxim/Dallas temperature ICs)
     OneWire _internalOneWire;
@@ -259,6 +309,30 @@ class MaximDS18 : public Sensor {
     DallasTemperature _internalDallasTemp;
     // Turns the address into a printable string
     String makeAddressString(DeviceAddress OneWireAddress);
+#ifdef MS_DS18_BUS_CONVERSION
+    /**
+     * @brief Join the conversion running on the sensor's pin, or start a
+     * conversion of every DS18 on the pin.
+     *
+     * @param started The time the conversion was started
+     * @return **bool** True if the sensor is converting.
+     */
+    bool joinBusConversion(uint32_t& started);
+
+    /**
+     * @brief The latest conversion of every DS18 on a pin
+     */
+    typedef struct {
+        int8_t   pin;
+        uint8_t  generation;  ///< Counts up with each conversion; 0 if unused
+        uint32_t started;
+    } ds18BusConversion;
+    static ds18BusConversion _busConversions[MS_DS18_MAX_BUSES];
+    /**
+     * @brief The last bus conversion the sensor took a reading from
+     */
+    uint8_t _usedGeneration = 0;
+#endif
 };
 
 
@@ -11,6 +11,12 @@
 #include <Sodaq_DS3231.h>
 #include "MaximDS3231.h"
 
+#ifdef MS_DS3231_AUTO_TEMP
+// The status register and its busy flag
+#define DS3231_STATUS_REG 0x0F
+#define DS3231_STATUS_BSY 0x04
+#endif
+
 // Only input is the number of readings to average
 MaximDS3231::MaximDS3231(uint8_t measurementsToAverage)
     : Sensor("MaximDS3231", DS3231_NUM_VARIABLES, DS3231_WARM_UP_TIME_MS,
@@ -39,6 +45,19 @@ bool MaximDS3231::startSingleMeasurement(void) {
     // reason to go on.
     if (!Sensor::startSingleMeasurement()) return false;
 
+#ifdef MS_DS3231_AUTO_TEMP
+    uint32_t now    = rtc.now().getEpoch();
+    bool     recent = _lastConversion != 0 &&
+        now - _lastConversion < _maxTemperatureAge_s;
+    if (_maxTemperatureAge_s >= DS3231_AUTO_CONVERSION_S || recent) {
+        // The last conversion is recent enough, so just read it
+        _measurementTime_ms = 0;
+        return true;
+    }
+    _lastConversion     = now;
+    _measurementTime_ms = DS3231_MEASUREMENT_TIME_MS;
+#endif
+
     // force a temperature sampling and conversion
     // this function already has a forced wait for the conversion to complete
     // TODO(SRGDamia1):  Test how long the conversion takes, update DS3231 lib
@@ -50,6 +69,30 @@ bool MaximDS3231::startSingleMeasurement(void) {
 }
 
 
+#ifdef MS_DS3231_AUTO_TEMP
+bool MaximDS3231::isMeasurementComplete(bool debug) {
+    if (!Sensor::isMeasurementComplete(debug)) return false;
+    if (!_checkBusy || !bitRead(_sensorStatus, 6)) return true;
+    // The temperature registers are only updated at the end of a conversion,
+    // forced or automatic, so wait for one that's running
+    if ((rtc.readRegister(DS3231_STATUS_REG) & DS3231_STATUS_BSY) &&
+        millis() - _millisMeasurementRequested < DS3231_MEASUREMENT_TIME_MS) {
+        rescheduleMeasurement(DS3231_BUSY_POLL_MS);
+        return false;
+    }
+    return true;
+}
+
+
+void MaximDS3231::setMaxTemperatureAge(uint16_t maxAge_s) {
+    _maxTemperatureAge_s = maxAge_s;
+}
+void MaximDS3231::setCheckBusy(bool checkBusy) {
+    _checkBusy = checkBusy;
+}
+#endif
+
+
 bool MaximDS3231::addSingleMeasurementResult(void) {
     // get the temperature value
     MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
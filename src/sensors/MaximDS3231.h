@@ -66,6 +66,22 @@
 #define MS_DEBUGGING_STD "MaximDS3231"
 #endif
 
+/**
+ * @def MS_DS3231_AUTO_TEMP
+ * @brief Read the temperature the DS3231 measures on its own instead of
+ * forcing a conversion for every measurement.
+ *
+ * The DS3231 converts its temperature every 64 seconds to correct its
+ * crystal, and each forced conversion draws extra current for up to 200 ms.
+ * With this flag a measurement just reads the temperature registers, and
+ * only forces a conversion when the last forced one is older than the age
+ * set with MaximDS3231::setMaxTemperatureAge().  If a conversion is still
+ * running when the measurement is read, the read waits for it to finish.
+ *
+ * @ingroup sensor_ds3231
+ */
+// #define MS_DS3231_AUTO_TEMP
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
@@ -102,6 +118,14 @@
  * measurement - A single temperature conversion takes 200ms.
  */
 #define DS3231_MEASUREMENT_TIME_MS 200
+/**
+ * @brief The time between the conversions the DS3231 makes on its own, in
+ * seconds.
+ */
+#define DS3231_AUTO_CONVERSION_S 64
+/// @brief The time between checks of the busy flag while a conversion is
+/// running, in ms; used with #MS_DS3231_AUTO_TEMP.
+#define DS3231_BUSY_POLL_MS 10
 /**@}*/
 
 /**
@@ -122,11 +146,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperatureDatalogger"
-#define DS3231_TEMP_VAR_NAME "temperatureDatalogger"
+#define DS3231_TEMP_VAR_NAME MS_VAR_TEXT("temperatureDatalogger")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define DS3231_TEMP_UNIT_NAME "degreeCelsius"
+#define DS3231_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "BoardTemp"
 #define DS3231_TEMP_DEFAULT_CODE "BoardTemp"
 /**@}*/
@@ -185,10 +209,52 @@ class MaximDS3231 : public Sensor {
      * successfully. successfully.
      */
     bool startSingleMeasurement(void) override;
+#ifdef MS_DS3231_AUTO_TEMP
+    /**
+     * @copydoc Sensor::isMeasurementComplete()
+     *
+     * If the busy flag is checked, this also waits for a running conversion
+     * to finish, up to #DS3231_MEASUREMENT_TIME_MS after the measurement was
+     * started.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+#endif
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
+
+#ifdef MS_DS3231_AUTO_TEMP
+    /**
+     * @brief Set how old the temperature may be before a conversion is
+     * forced.
+     *
+     * The automatic conversions keep the temperature no more than
+     * #DS3231_AUTO_CONVERSION_S old, so at that age or more, the default, a
+     * conversion is never forced.  With a shorter age a conversion is forced
+     * whenever the last forced one is older than that; 0 forces one for every
+     * measurement.
+     *
+     * @param maxAge_s The age in seconds
+     */
+    void setMaxTemperatureAge(uint16_t maxAge_s);
+    /**
+     * @brief Set whether to wait for a running conversion before reading the
+     * temperature.
+     *
+     * @param checkBusy True to check the busy flag, the default; false to read
+     * the last result as soon as the measurement time is up.
+     */
+    void setCheckBusy(bool checkBusy);
+
+ private:
+    uint16_t _maxTemperatureAge_s = DS3231_AUTO_CONVERSION_S;
+    bool     _checkBusy           = true;
+    /**
+     * @brief The RTC time of the last forced conversion; 0 for none yet
+     */
+    uint32_t _lastConversion = 0;
+#endif
 };
 
 
@@ -12,15 +12,48 @@
 
 #include "MeaSpecMS5803.h"
 
+#ifdef MS_MS5803_SCHEDULED
+// The commands of the MS5803
+#define MS5803_CMD_ADC_READ 0x00
+#define MS5803_CMD_CONVERT_D1 0x40
+#define MS5803_CMD_CONVERT_D2 0x50
+#define MS5803_CMD_PROM_READ 0xA0
+#endif
+
+
+// The bits of the conversion commands for an oversampling ratio
+static uint8_t osrCode(uint16_t oversamplingRatio) {
+    if (oversamplingRatio >= 4096) return ADC_4096;
+    if (oversamplingRatio >= 2048) return ADC_2048;
+    if (oversamplingRatio >= 1024) return ADC_1024;
+    if (oversamplingRatio >= 512) return ADC_512;
+    return ADC_256;
+}
+
+#ifdef MS_MS5803_SCHEDULED
+// The longest conversion time at each ratio in the datasheet, rounded up to
+// the whole millisecond
+static uint8_t conversionTime(uint8_t code) {
+    static const uint8_t times_ms[] = {1, 2, 3, 5, 10};
+    return times_ms[code / 2];
+}
+#endif
+
 
 // The constructor - because this is I2C, only need the power pin
 MeaSpecMS5803::MeaSpecMS5803(int8_t powerPin, uint8_t i2cAddressHex,
-                             int16_t maxPressure, uint8_t measurementsToAverage)
+                             int16_t maxPressure, uint8_t measurementsToAverage,
+                             uint16_t oversamplingRatio)
     : Sensor("MeaSpecMS5803", MS5803_NUM_VARIABLES, MS5803_WARM_UP_TIME_MS,
              MS5803_STABILIZATION_TIME_MS, MS5803_MEASUREMENT_TIME_MS, powerPin,
              -1, measurementsToAverage, MS5803_INC_CALC_VARIABLES),
       _i2cAddressHex(i2cAddressHex),
-      _maxPressure(maxPressure) {}
+      _maxPressure(maxPressure),
+      _osrCode(osrCode(oversamplingRatio)) {
+#ifdef MS_MS5803_SCHEDULED
+    _conversionTime_ms = conversionTime(_osrCode);
+#endif
+}
 // Destructor
 MeaSpecMS5803::~MeaSpecMS5803() {}
 
@@ -46,6 +79,23 @@ bool MeaSpecMS5803::setup(void) {
     MS5803_internal.begin(_i2cAddressHex, _maxPressure);
     MS5803_internal.reset();
 
+#ifdef MS_MS5803_SCHEDULED
+    // Keep our own copy of the coefficients to compensate with
+    for (uint8_t i = 1; i < 7; i++) {
+        _prom[i] = 0;
+        if (!sendCommand(MS5803_CMD_PROM_READ + 2 * i)) continue;
+        if (Wire.requestFrom(_i2cAddressHex, static_cast<uint8_t>(2)) == 2) {
+            _prom[i] = static_cast<uint16_t>(Wire.read()) << 8;
+            _prom[i] |= Wire.read();
+        }
+    }
+    _measurementTime_ms = canSchedule() ? 2 * _conversionTime_ms
+                                        : MS5803_MEASUREMENT_TIME_MS;
+    MS_DBG(getSensorNameAndLocation(),
+           canSchedule() ? F("is read in scheduled steps")
+                         : F("is read through the MS5803 library"));
+#endif
+
     // Turn the power back off it it had been turned on
     if (!wasOn) { powerDown(); }
 
@@ -53,6 +103,167 @@ bool MeaSpecMS5803::setup(void) {
 }
 
 
+#ifdef MS_MS5803_SCHEDULED
+bool MeaSpecMS5803::canSchedule(void) {
+    switch (_maxPressure) {
+        case 1:
+        case 2:
+        case 5:
+        case 14:
+        case 30: break;
+        default: return false;
+    }
+    // The coefficients are 0 until they've been read, and a missing sensor
+    // reads as all ones
+    return _prom[1] != 0 && _prom[1] != 0xFFFF;
+}
+
+
+bool MeaSpecMS5803::sendCommand(uint8_t command) {
+    Wire.beginTransmission(_i2cAddressHex);
+    Wire.write(command);
+    return Wire.endTransmission() == 0;
+}
+
+
+uint32_t MeaSpecMS5803::readConversion(void) {
+    if (!sendCommand(MS5803_CMD_ADC_READ)) return 0;
+    if (Wire.requestFrom(_i2cAddressHex, static_cast<uint8_t>(3)) != 3) {
+        return 0;
+    }
+    uint32_t result = Wire.read();
+    result          = result << 8 | Wire.read();
+    result          = result << 8 | Wire.read();
+    return result;
+}
+
+
+// Each step is one conversion; step 1 is the pressure and step 2 the
+// temperature
+bool MeaSpecMS5803::startSingleMeasurement(void) {
+    if (!Sensor::startSingleMeasurement()) return false;
+    if (!canSchedule()) return true;
+    _rawPressure = 0;
+    if (sendCommand(MS5803_CMD_CONVERT_D1 | _osrCode)) {
+        nextMeasurementStep(_conversionTime_ms);
+    } else {
+        MS_DBG(getSensorNameAndLocation(), F("didn't start a conversion"));
+    }
+    return true;
+}
+
+
+bool MeaSpecMS5803::isMeasurementComplete(bool debug) {
+    if (!Sensor::isMeasurementComplete(debug)) return false;
+    // Only the step between the two conversions has anything left to do
+    if (!bitRead(_sensorStatus, 6) || _measurementStep != 1) return true;
+    _rawPressure = readConversion();
+    if (_rawPressure == 0 || !sendCommand(MS5803_CMD_CONVERT_D2 | _osrCode)) {
+        // Nothing more to convert; the measurement is a failure
+        _measurementStep = 0;
+        return true;
+    }
+    nextMeasurementStep(_conversionTime_ms);
+    return false;
+}
+
+
+// The first and second order compensation from the datasheet of each model
+void MeaSpecMS5803::compensate(uint32_t rawTemperature, float& temp,
+                               float& press) {
+    int32_t dT = static_cast<int32_t>(rawTemperature) -
+        (static_cast<int32_t>(_prom[5]) << 8);
+    int32_t TEMP = 2000 + ((static_cast<int64_t>(dT) * _prom[6]) >> 23);
+
+    int64_t dT2     = static_cast<int64_t>(dT) * dT;
+    int64_t low     = static_cast<int64_t>(TEMP - 2000) * (TEMP - 2000);
+    int64_t veryLow = static_cast<int64_t>(TEMP + 1500) * (TEMP + 1500);
+    int64_t OFF, SENS;
+    int64_t T2 = 0, OFF2 = 0, SENS2 = 0;
+    // The pressure comes out in hundredths of a millibar, or in tenths for
+    // the 14 and 30 bar models
+    float   perMillibar = 100;
+
+    switch (_maxPressure) {
+        case 1: {
+            OFF  = (static_cast<int64_t>(_prom[2]) << 16) +
+                ((static_cast<int64_t>(_prom[4]) * dT) >> 7);
+            SENS = (static_cast<int64_t>(_prom[1]) << 15) +
+                ((static_cast<int64_t>(_prom[3]) * dT) >> 8);
+            if (TEMP < 2000) {
+                T2    = dT2 >> 31;
+                OFF2  = 3 * low;
+                SENS2 = (7 * low) >> 3;
+                if (TEMP < -1500) { SENS2 += 2 * veryLow; }
+            } else if (TEMP > 4500) {
+                SENS2 = -((static_cast<int64_t>(TEMP - 4500) * (TEMP - 4500)) >>
+                          3);
+            }
+            break;
+        }
+        case 2: {
+            OFF  = (static_cast<int64_t>(_prom[2]) << 17) +
+                ((static_cast<int64_t>(_prom[4]) * dT) >> 6);
+            SENS = (static_cast<int64_t>(_prom[1]) << 16) +
+                ((static_cast<int64_t>(_prom[3]) * dT) >> 7);
+            if (TEMP < 2000) {
+                T2    = dT2 >> 31;
+                OFF2  = (61 * low) >> 4;
+                SENS2 = 2 * low;
+                if (TEMP < -1500) {
+                    OFF2 += 20 * veryLow;
+                    SENS2 += 12 * veryLow;
+                }
+            }
+            break;
+        }
+        case 5: {
+            OFF  = (static_cast<int64_t>(_prom[2]) << 18) +
+                ((static_cast<int64_t>(_prom[4]) * dT) >> 5);
+            SENS = (static_cast<int64_t>(_prom[1]) << 17) +
+                ((static_cast<int64_t>(_prom[3]) * dT) >> 7);
+            if (TEMP < 2000) {
+                T2    = (3 * dT2) >> 33;
+                OFF2  = (3 * low) >> 3;
+                SENS2 = (7 * low) >> 3;
+                if (TEMP < -1500) { SENS2 += 3 * veryLow; }
+            }
+            break;
+        }
+        default: {  // 14 and 30 bar
+            OFF  = (static_cast<int64_t>(_prom[2]) << 16) +
+                ((static_cast<int64_t>(_prom[4]) * dT) >> 7);
+            SENS = (static_cast<int64_t>(_prom[1]) << 15) +
+                ((static_cast<int64_t>(_prom[3]) * dT) >> 8);
+            if (TEMP < 2000) {
+                T2    = (3 * dT2) >> 33;
+                OFF2  = (3 * low) >> 1;
+                SENS2 = (5 * low) >> 3;
+                if (TEMP < -1500) {
+                    OFF2 += 7 * veryLow;
+                    SENS2 += 4 * veryLow;
+                }
+            } else {
+                T2   = (7 * dT2) >> 37;
+                OFF2 = low >> 4;
+            }
+            perMillibar = 10;
+            break;
+        }
+    }
+
+    TEMP -= static_cast<int32_t>(T2);
+    OFF -= OFF2;
+    SENS -= SENS2;
+    int32_t P = static_cast<int32_t>(
+        (((_rawPressure * SENS) >> 21) - OFF) >> 15);
+
+    temp  = TEMP / 100.0f;
+    press = P / perMillibar;
+}
+#endif
+
+
 bool MeaSpecMS5803::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -64,12 +275,27 @@ bool MeaSpecMS5803::addSingleMeasurementResult(void) {
     // Only go on to get a result if it was
     if (bitRead(_sensorStatus, 6)) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
+#ifdef MS_MS5803_SCHEDULED
+        if (canSchedule()) {
+            // Both conversions were started in steps; read the temperature
+            uint32_t rawTemperature =
+                _measurementStep == 2 ? readConversion() : 0;
+            if (_rawPressure != 0 && rawTemperature != 0) {
+                compensate(rawTemperature, temp, press);
+            } else {
+                MS_DBG(F("  The conversions didn't finish"));
+            }
+        } else {
+#endif
         // Read values
         // NOTE:  These functions actually include the request to begin
         // a measurement and the wait for said measurement to finish.
         // It's pretty fast (max of 11 ms) so we'll just wait.
         temp  = MS5803_internal.getTemperature(CELSIUS, ADC_512);
-        press = MS5803_internal.getPressure(ADC_4096);
+        press = MS5803_internal.getPressure(static_cast<precision>(_osrCode));
+#ifdef MS_MS5803_SCHEDULED
+        }
+#endif
 
         if (isnan(temp)) temp = -9999;
         if (isnan(press)) press = -9999;
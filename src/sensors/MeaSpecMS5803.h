@@ -85,12 +85,32 @@
 #define MS_DEBUGGING_STD "MeaSpecMS5803"
 #endif
 
+/**
+ * @def MS_MS5803_SCHEDULED
+ * @brief Have the MS5803 pressure and temperature conversions started and
+ * read as steps of the measurement instead of inside one blocking call.
+ *
+ * Without this, each reading asks the MS5803 library for the temperature and
+ * then the pressure, and the library converts both for each and waits out
+ * every conversion itself.  With this flag the pressure (D1) conversion is
+ * started with the measurement, the temperature (D2) conversion once the
+ * pressure is read, and each is read when its conversion time for the
+ * oversampling ratio has passed, so the other sensors are looked after in
+ * the meantime.  The readings are compensated here with the first and second
+ * order formulas from the datasheets of the 1, 2, 5, 14, and 30 bar models;
+ * any other model is read through the library as before.
+ */
+// #define MS_MS5803_SCHEDULED
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "VariableBase.h"
 #include "SensorBase.h"
 #include <MS5803.h>
+#ifdef MS_MS5803_SCHEDULED
+#include <Wire.h>
+#endif
 
 /** @ingroup sensor_ms5803 */
 /**@{*/
@@ -117,8 +137,13 @@
  * measurement.
  * - Sensor takes about 0.5 / 1.1 / 2.1 / 4.1 / 8.22 ms to respond
  * at oversampling ratios: 256 / 512 / 1024 / 2048 / 4096, respectively.
+ *
+ * With #MS_MS5803_SCHEDULED the measurement time is instead the time of the
+ * two conversions at the chosen oversampling ratio.
  */
 #define MS5803_MEASUREMENT_TIME_MS 10
+/// @brief The default oversampling ratio of the pressure conversion.
+#define MS5803_DEFAULT_OSR 4096
 /**@}*/
 
 /**
@@ -139,11 +164,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define MS5803_TEMP_VAR_NAME "temperature"
+#define MS5803_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define MS5803_TEMP_UNIT_NAME "degreeCelsius"
+#define MS5803_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "MeaSpecMS5803Temp"
 #define MS5803_TEMP_DEFAULT_CODE "MeaSpecMS5803Temp"
 /**@}*/
@@ -177,10 +202,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "barometricPressure"
-#define MS5803_PRESSURE_VAR_NAME "barometricPressure"
+#define MS5803_PRESSURE_VAR_NAME MS_VAR_TEXT("barometricPressure")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millibar"
-#define MS5803_PRESSURE_UNIT_NAME "millibar"
+#define MS5803_PRESSURE_UNIT_NAME MS_VAR_TEXT("millibar")
 /// @brief Default variable short code; "MeaSpecMS5803Pressure"
 #define MS5803_PRESSURE_DEFAULT_CODE "MeaSpecMS5803Pressure"
 /**@}*/
@@ -215,10 +240,15 @@ class MeaSpecMS5803 : public Sensor {
      * @param measurementsToAverage The number of measurements to take and
      * average before giving a "final" result from the sensor; optional with a
      * default value of 1.
+     * @param oversamplingRatio The oversampling ratio of the conversions; 256,
+     * 512, 1024, 2048, or 4096.  Each step down halves the conversion time,
+     * from about 9 ms at 4096 to 0.6 ms at 256, but doubles the noise.
+     * Optional with a default value of #MS5803_DEFAULT_OSR.
      */
     explicit MeaSpecMS5803(int8_t powerPin, uint8_t i2cAddressHex = 0x76,
-                           int16_t maxPressure           = 14,
-                           uint8_t measurementsToAverage = 1);
+                           int16_t  maxPressure           = 14,
+                           uint8_t  measurementsToAverage = 1,
+                           uint16_t oversamplingRatio     = MS5803_DEFAULT_OSR);
     /**
      * @brief Destroy the MeaSpecMS5803 object
      */
@@ -242,6 +272,22 @@ class MeaSpecMS5803 : public Sensor {
      */
     String getSensorLocation(void) override;
 
+#ifdef MS_MS5803_SCHEDULED
+    /**
+     * @copydoc Sensor::startSingleMeasurement()
+     *
+     * This also starts the pressure conversion.
+     */
+    bool startSingleMeasurement(void) override;
+    /**
+     * @copydoc Sensor::isMeasurementComplete()
+     *
+     * Once the pressure conversion is finished, this reads it and starts the
+     * temperature conversion.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+#endif
+
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
@@ -260,6 +306,54 @@ class MeaSpecMS5803 : public Sensor {
      * @brief Maximum pressure supported by the MS5803.
      */
     int16_t _maxPressure;
+    /**
+     * @brief The oversampling ratio, as the bits of the conversion commands
+     */
+    uint8_t _osrCode;
+#ifdef MS_MS5803_SCHEDULED
+    /**
+     * @brief The time of one conversion at the oversampling ratio, in ms
+     */
+    uint8_t _conversionTime_ms;
+    /**
+     * @brief The factory calibration coefficients C1-C6 from the PROM; the
+     * first is the manufacturer's word, which isn't used.
+     */
+    uint16_t _prom[7] = {0, 0, 0, 0, 0, 0, 0};
+    /**
+     * @brief The raw pressure (D1) of the current measurement
+     */
+    uint32_t _rawPressure = 0;
+    /**
+     * @brief Check if the measurements of this model can be compensated here.
+     *
+     * @return **bool** True for the 1, 2, 5, 14, and 30 bar models once their
+     * coefficients have been read.
+     */
+    bool canSchedule(void);
+    /**
+     * @brief Send a one-byte command to the MS5803.
+     *
+     * @param command The command
+     * @return **bool** True if the MS5803 acknowledged it.
+     */
+    bool sendCommand(uint8_t command);
+    /**
+     * @brief Read the result of the last conversion.
+     *
+     * @return **uint32_t** The 24-bit result, or 0 if the conversion wasn't
+     * finished or the read failed.
+     */
+    uint32_t readConversion(void);
+    /**
+     * @brief Compensate the raw pressure and temperature.
+     *
+     * @param rawTemperature The raw temperature (D2)
+     * @param temp The temperature in °C
+     * @param press The pressure in millibar
+     */
+    void compensate(uint32_t rawTemperature, float& temp, float& press);
+#endif
 };
 
 
@@ -146,11 +146,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define ATMOS14_TEMP_VAR_NAME "temperature"
+#define ATMOS14_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define ATMOS14_TEMP_UNIT_NAME "degreeCelsius"
+#define ATMOS14_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code;
 #define ATMOS14_TEMP_DEFAULT_CODE "AirTemp"
 /**@}*/
@@ -177,11 +177,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "permittivity"
-#define ATMOS14_RH_VAR_NAME "relativeHumidity"
+#define ATMOS14_RH_VAR_NAME MS_VAR_TEXT("relativeHumidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "faradPerMeter" (F/m)
-#define ATMOS14_RH_UNIT_NAME "Dimensionless"
+#define ATMOS14_RH_UNIT_NAME MS_VAR_TEXT("Dimensionless")
 /// @brief Default variable short code; "RH"
 #define ATMOS14_RH_DEFAULT_CODE "RH"
 /**@}*/
@@ -205,10 +205,10 @@
 #define ATMOS14_PRES_VAR_NUM 2
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
-#define ATMOS14_PRES_VAR_NAME "pressureAbsolute"
+#define ATMOS14_PRES_VAR_NAME MS_VAR_TEXT("pressureAbsolute")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
-#define ATMOS14_PRES_UNIT_NAME "Kilopascal"
+#define ATMOS14_PRES_UNIT_NAME MS_VAR_TEXT("Kilopascal")
 /// @brief Default variable short code; "baro"
 #define ATMOS14_PRES_DEFAULT_CODE "Baro"
 /**@}*/
@@ -235,11 +235,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "counter"
-#define ATMOS14_VP_VAR_NAME "vaporPressure"
+#define ATMOS14_VP_VAR_NAME MS_VAR_TEXT("vaporPressure")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "count"
-#define ATMOS14_VP_UNIT_NAME "Kilopascal"
+#define ATMOS14_VP_UNIT_NAME MS_VAR_TEXT("Kilopascal")
 /// @brief Default variable short code;
 #define ATMOS14_VP_DEFAULT_CODE "AtmosVP"
 /**@}*/
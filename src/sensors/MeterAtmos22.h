@@ -114,8 +114,8 @@
 /**@{*/
 #define ATMOS22_WS_RESOLUTION 3
 #define ATMOS22_WS_VAR_NUM 0
-#define ATMOS22_WS_VAR_NAME "windSpeed"
-#define ATMOS22_WS_UNIT_NAME "Meter per Second"
+#define ATMOS22_WS_VAR_NAME MS_VAR_TEXT("windSpeed")
+#define ATMOS22_WS_UNIT_NAME MS_VAR_TEXT("Meter per Second")
 #define ATMOS22_WS_DEFAULT_CODE "WindSpd"
 /**@}*/
 
@@ -127,8 +127,8 @@
 /**@{*/
 #define ATMOS22_WD_RESOLUTION 1
 #define ATMOS22_WD_VAR_NUM 1
-#define ATMOS22_WD_VAR_NAME "windDirection"
-#define ATMOS22_WD_UNIT_NAME "Degree"
+#define ATMOS22_WD_VAR_NAME MS_VAR_TEXT("windDirection")
+#define ATMOS22_WD_UNIT_NAME MS_VAR_TEXT("Degree")
 #define ATMOS22_WD_DEFAULT_CODE "WindDir"
 /**@}*/
 
@@ -140,8 +140,8 @@
 /**@{*/
 #define ATMOS22_WG_RESOLUTION 3
 #define ATMOS22_WG_VAR_NUM 2
-#define ATMOS22_WG_VAR_NAME "windGustSpeed"
-#define ATMOS22_WG_UNIT_NAME "Meter perSecond"
+#define ATMOS22_WG_VAR_NAME MS_VAR_TEXT("windGustSpeed")
+#define ATMOS22_WG_UNIT_NAME MS_VAR_TEXT("Meter perSecond")
 #define ATMOS22_WG_DEFAULT_CODE "Gust"
 /**@}*/
 
@@ -154,8 +154,8 @@
 /**@{*/
 #define ATMOS22_TEMP_RESOLUTION 2
 #define ATMOS22_TEMP_VAR_NUM 3
-#define ATMOS22_TEMP_VAR_NAME "temperature"
-#define ATMOS22_TEMP_UNIT_NAME "Degree Celsius"
+#define ATMOS22_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
+#define ATMOS22_TEMP_UNIT_NAME MS_VAR_TEXT("Degree Celsius")
 #define ATMOS22_TEMP_DEFAULT_CODE "AirTemp"
 /**@}*/
 
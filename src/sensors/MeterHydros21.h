@@ -133,11 +133,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificConductance"
-#define HYDROS21_COND_VAR_NAME "specificConductance"
+#define HYDROS21_COND_VAR_NAME MS_VAR_TEXT("specificConductance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define HYDROS21_COND_UNIT_NAME "microsiemenPerCentimeter"
+#define HYDROS21_COND_UNIT_NAME MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "Hydros21cond"
 #define HYDROS21_COND_DEFAULT_CODE "Hydros21cond"
 /**@}*/
@@ -164,11 +164,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define HYDROS21_TEMP_VAR_NAME "temperature"
+#define HYDROS21_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define HYDROS21_TEMP_UNIT_NAME "degreeCelsius"
+#define HYDROS21_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Hydros21temp"
 #define HYDROS21_TEMP_DEFAULT_CODE "Hydros21temp"
 /**@}*/
@@ -195,11 +195,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "waterDepth"
-#define HYDROS21_DEPTH_VAR_NAME "waterDepth"
+#define HYDROS21_DEPTH_VAR_NAME MS_VAR_TEXT("waterDepth")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "millimeter"
-#define HYDROS21_DEPTH_UNIT_NAME "millimeter"
+#define HYDROS21_DEPTH_UNIT_NAME MS_VAR_TEXT("millimeter")
 /// @brief Default variable short code; "Hydros21depth"
 #define HYDROS21_DEPTH_DEFAULT_CODE "Hydros21depth"
 /**@}*/
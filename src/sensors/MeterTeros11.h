@@ -139,11 +139,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "counter"
-#define TEROS11_COUNT_VAR_NAME "counter"
+#define TEROS11_COUNT_VAR_NAME MS_VAR_TEXT("counter")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "count"
-#define TEROS11_COUNT_UNIT_NAME "count"
+#define TEROS11_COUNT_UNIT_NAME MS_VAR_TEXT("count")
 /// @brief Default variable short code; "RawVWCCounts"
 #define TEROS11_COUNT_DEFAULT_CODE "RawVWCCounts"
 /**@}*/
@@ -172,11 +172,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define TEROS11_TEMP_VAR_NAME "temperature"
+#define TEROS11_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define TEROS11_TEMP_UNIT_NAME "degreeCelsius"
+#define TEROS11_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "SoilTemp"
 #define TEROS11_TEMP_DEFAULT_CODE "SoilTemp"
 /**@}*/
@@ -205,11 +205,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "permittivity"
-#define TEROS11_EA_VAR_NAME "permittivity"
+#define TEROS11_EA_VAR_NAME MS_VAR_TEXT("permittivity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "faradPerMeter" (F/m)
-#define TEROS11_EA_UNIT_NAME "faradPerMeter"
+#define TEROS11_EA_UNIT_NAME MS_VAR_TEXT("faradPerMeter")
 /// @brief Default variable short code; "SoilEa"
 #define TEROS11_EA_DEFAULT_CODE "SoilEa"
 /**@}*/
@@ -243,11 +243,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "volumetricWaterContent"
-#define TEROS11_VWC_VAR_NAME "volumetricWaterContent"
+#define TEROS11_VWC_VAR_NAME MS_VAR_TEXT("volumetricWaterContent")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent" -
 /// volumetric percent water content (%, m3/100m3)
-#define TEROS11_VWC_UNIT_NAME "percent"
+#define TEROS11_VWC_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "SoilVWC"
 #define TEROS11_VWC_DEFAULT_CODE "SoilVWC"
 /**@}*/
@@ -0,0 +1,91 @@
+/**
+ * @file ModbusBusManager.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the ModbusBusManager class.
+ */
+
+#include "ModbusBusManager.h"
+
+
+ModbusBusManager* ModbusBusManager::_firstManager = nullptr;
+
+
+ModbusBusManager* ModbusBusManager::getManager(Stream* stream) {
+    for (ModbusBusManager* manager = _firstManager; manager != nullptr;
+         manager                   = manager->_nextManager) {
+        if (manager->_stream == stream) return manager;
+    }
+    ModbusBusManager* manager = new ModbusBusManager(stream);
+    manager->_nextManager     = _firstManager;
+    _firstManager             = manager;
+    return manager;
+}
+
+
+void ModbusBusManager::setBaudRate(uint32_t baudRate) {
+    // 3.5 characters of 11 bits each, but never less than 1750 µs
+    _frameGap_us = baudRate > 19200 ? 1750 : 38500000L / baudRate;
+    MS_DBG(F("Modbus inter-frame gap set to"), _frameGap_us, F("µs"));
+}
+
+
+void ModbusBusManager::setEnablePin(int8_t enablePin) {
+    if (_enablePin >= 0 || enablePin < 0) return;
+    _enablePin = enablePin;
+    pinMode(_enablePin, OUTPUT);
+    digitalWrite(_enablePin, LOW);
+}
+
+
+uint8_t ModbusBusManager::getAttempts(byte address) {
+    modbusDevice* device = findDevice(address);
+    if (device != nullptr && device->missed) {
+        MS_DBG(F("Modbus device 0x"), String(address, HEX),
+               F("didn't answer last time; trying it once"));
+        return 1;
+    }
+    return MODBUS_ATTEMPTS;
+}
+
+
+void ModbusBusManager::beginTransaction(byte address) {
+    // Only wait out what's left of the gap since the last frame on the bus
+    uint32_t sinceLast = micros() - _lastFrameEnd_us;
+    if (_lastFrameEnd_us != 0 && sinceLast < _frameGap_us) {
+        delayMicroseconds(_frameGap_us - sinceLast);
+    }
+    // Throw away anything left over from another device, like a late answer
+    // to a command that already timed out
+    uint8_t dropped = 0;
+    while (_stream->available()) {
+        _stream->read();
+        dropped++;
+    }
+    if (dropped > 0) {
+        MS_DBG(F("Dropped"), dropped, F("stray bytes before transaction with"),
+               F("Modbus device 0x"), String(address, HEX));
+    }
+}
+
+
+void ModbusBusManager::endTransaction(byte address, bool answered) {
+    _lastFrameEnd_us = micros();
+    // Make sure the adapter is left listening
+    if (_enablePin >= 0) digitalWrite(_enablePin, LOW);
+    modbusDevice* device = findDevice(address);
+    if (device != nullptr) device->missed = !answered;
+}
+
+
+ModbusBusManager::modbusDevice* ModbusBusManager::findDevice(byte address) {
+    for (uint8_t i = 0; i < _deviceCount; i++) {
+        if (_devices[i].address == address) return &_devices[i];
+    }
+    if (_deviceCount >= MS_MODBUS_MAX_DEVICES) return nullptr;
+    _devices[_deviceCount].address = address;
+    _devices[_deviceCount].missed  = false;
+    return &_devices[_deviceCount++];
+}
@@ -0,0 +1,169 @@
+/**
+ * @file ModbusBusManager.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the ModbusBusManager class, which coordinates the Modbus
+ * transactions of all of the Yosemitech, Keller, and GroPoint sensors sharing
+ * one RS485 stream.
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_MODBUSBUSMANAGER_H_
+#define SRC_SENSORS_MODBUSBUSMANAGER_H_
+
+// Debugging Statement
+// #define MS_MODBUSBUSMANAGER_DEBUG
+
+#ifdef MS_MODBUSBUSMANAGER_DEBUG
+#define MS_DEBUGGING_STD "ModbusBusManager"
+#endif
+
+/**
+ * @def MS_MODBUS_SHARED
+ * @brief Have the Yosemitech, Keller, and GroPoint sensors run their Modbus
+ * transactions through a shared ModbusBusManager for their stream.
+ *
+ * The manager sets up the RS485 direction enable pin once for the bus, only
+ * waits out what is left of the Modbus inter-frame gap before each
+ * transaction, and clears stray bytes left on the stream by another device so
+ * they can't spoil the next response.  A device that didn't answer its last
+ * transaction is only tried once instead of five times until it answers
+ * again, so a dead or unplugged probe doesn't hold up the rest of the bus
+ * with its retries every cycle.
+ *
+ * @ingroup the_sensors
+ */
+// #define MS_MODBUS_SHARED
+
+/**
+ * @def MS_MODBUS_MAX_DEVICES
+ * @brief The number of Modbus addresses whose answers are tracked on each
+ * bus.
+ *
+ * Further devices are always given every attempt.
+ *
+ * @ingroup the_sensors
+ */
+#ifndef MS_MODBUS_MAX_DEVICES
+#define MS_MODBUS_MAX_DEVICES 8
+#endif
+
+/**
+ * @brief The number of attempts given to a command to a device that answered
+ * its last transaction.
+ *
+ * @ingroup the_sensors
+ */
+#define MODBUS_ATTEMPTS 5
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+
+
+/**
+ * @brief A ModbusBusManager coordinates the transactions of all of the Modbus
+ * sensors on one RS485 stream.
+ *
+ * There is one manager for each stream; get it with getManager().  The
+ * sensor drivers (YosemitechModbus, KellerModbus, and GroPointModbus) still
+ * build, send, and time their own frames, so a sensor wraps each driver call
+ * in beginTransaction() and endTransaction() and asks getAttempts() how many
+ * times to try a command.
+ *
+ * @ingroup the_sensors
+ */
+class ModbusBusManager {
+ public:
+    /**
+     * @brief Get the manager for a stream, creating it for the first sensor
+     * on that stream.
+     *
+     * @param stream The stream for the RS485 bus
+     * @return **ModbusBusManager*** The manager for the stream.
+     */
+    static ModbusBusManager* getManager(Stream* stream);
+
+    /**
+     * @brief Set the baud rate of the bus, to calculate the inter-frame gap.
+     *
+     * The gap is 3.5 character times, or 1.75 ms above 19200 baud, as in the
+     * Modbus RTU specification.  The default is 9600 baud, as used by the
+     * Yosemitech and Keller sensors; the GroPoint sensors set 19200 baud in
+     * their setup.  Call this after the sensors' setup for any other rate.
+     *
+     * @param baudRate The baud rate of the stream
+     */
+    void setBaudRate(uint32_t baudRate);
+    /**
+     * @brief Set the pin controlling the direction enable on the RS485
+     * adapter.
+     *
+     * Only the first pin given is used; the sensors on a bus should all give
+     * the same pin.  The pin is set as an output and left listening.
+     *
+     * @param enablePin The pin on the mcu controlling the direction enable;
+     * -1 if there isn't one.
+     */
+    void setEnablePin(int8_t enablePin);
+
+    /**
+     * @brief Get the number of times a command to a device should be tried.
+     *
+     * @param address The Modbus address of the device
+     * @return **uint8_t** #MODBUS_ATTEMPTS if the device answered its last
+     * transaction; otherwise 1.
+     */
+    uint8_t getAttempts(byte address);
+    /**
+     * @brief Get ready for a transaction with a device.
+     *
+     * This waits out what is left of the inter-frame gap after the last
+     * transaction on the bus and empties any stray bytes from the stream.
+     *
+     * @param address The Modbus address of the device
+     */
+    void beginTransaction(byte address);
+    /**
+     * @brief Mark the end of a transaction with a device.
+     *
+     * @param address The Modbus address of the device
+     * @param answered True if the device answered the transaction
+     */
+    void endTransaction(byte address, bool answered);
+
+ private:
+    /**
+     * @brief A device on the bus and whether it answered its last transaction
+     */
+    typedef struct {
+        byte address;
+        bool missed;
+    } modbusDevice;
+
+    explicit ModbusBusManager(Stream* stream) : _stream(stream) {}
+
+    /**
+     * @brief Find a device in the list of devices on the bus, adding it if
+     * there's room.
+     *
+     * @param address The Modbus address of the device
+     * @return **modbusDevice*** The device, or a nullptr if the list is full.
+     */
+    modbusDevice* findDevice(byte address);
+
+    static ModbusBusManager* _firstManager;
+
+    ModbusBusManager* _nextManager = nullptr;
+    Stream*           _stream;
+    int8_t            _enablePin       = -1;
+    uint32_t          _frameGap_us     = 4010;
+    uint32_t          _lastFrameEnd_us = 0;
+    modbusDevice      _devices[MS_MODBUS_MAX_DEVICES] = {};
+    uint8_t           _deviceCount = 0;
+};
+
+#endif  // SRC_SENSORS_MODBUSBUSMANAGER_H_
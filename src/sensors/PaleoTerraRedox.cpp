@@ -45,14 +45,18 @@ PaleoTerraRedox::PaleoTerraRedox(TwoWire* theI2C, int8_t powerPin,
              PTR_STABILIZATION_TIME_MS, PTR_MEASUREMENT_TIME_MS, powerPin, -1,
              measurementsToAverage),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(theI2C) {}
+      _i2c(theI2C) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 PaleoTerraRedox::PaleoTerraRedox(int8_t powerPin, uint8_t i2cAddressHex,
                                  uint8_t measurementsToAverage)
     : Sensor("PaleoTerraRedox", PTR_NUM_VARIABLES, PTR_WARM_UP_TIME_MS,
-             PTR_STABILIZATION_TIME_MS, PTR_MEASUREMENT_TIME_MS, powerPin,
+             PTR_STABILIZATION_TIME_MS, PTR_MEASUREMENT_TIME_MS, powerPin, -1,
              measurementsToAverage, PTR_INC_CALC_VARIABLES),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(&Wire) {}
+      _i2c(&Wire) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 #endif
 
 
@@ -96,6 +100,22 @@ bool PaleoTerraRedox::setup(void) {
 }
 
 
+// The conversion is started here and read once the measurement time is up,
+// instead of waiting for it in addSingleMeasurementResult()
+bool PaleoTerraRedox::startSingleMeasurement(void) {
+    // Sensor::startSingleMeasurement() checks that if it's awake/active and
+    // sets the timestamp and status bits.  If it returns false, there's no
+    // reason to go on.
+    if (!Sensor::startSingleMeasurement()) return false;
+
+    _i2c->beginTransmission(_i2cAddressHex);
+    _i2c->write(0b10001100);  // initiate conversion, One-Shot mode, 18
+                              // bits, PGA x1
+    _i2cStatus = _i2c->endTransmission();
+    return true;
+}
+
+
 bool PaleoTerraRedox::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -105,12 +125,8 @@ bool PaleoTerraRedox::addSingleMeasurementResult(void) {
 
     byte i2c_status = -1;
     if (_millisMeasurementRequested > 0) {
-        _i2c->beginTransmission(_i2cAddressHex);
-        _i2c->write(0b10001100);  // initiate conversion, One-Shot mode, 18
-                                  // bits, PGA x1
-        i2c_status = _i2c->endTransmission();
-
-        delay(300);
+        // The conversion was started by startSingleMeasurement()
+        i2c_status = _i2cStatus;
 
         _i2c->requestFrom(int(_i2cAddressHex),
                           4);  // Get 4 bytes from device
@@ -40,6 +40,12 @@
  * @section sensor_pt_redox_flags Build flags
  * - `-D MS_PALEOTERRA_SOFTWAREWIRE`
  *      - switches from using hardware I2C to software I2C
+ * @note Software I2C is much slower than hardware I2C and keeps the processor
+ * busy, with interrupts held off, for each bit it clocks out.  It should only
+ * be used when no hardware bus can be; on a SAMD board a second hardware bus
+ * can be made on a spare SERCOM and given to the TwoWire constructor instead.
+ * Only the sensors on a hardware bus are registered with Sensor::setBus(), so
+ * #MS_I2C_CLOCK_PER_SENSOR doesn't apply to the software I2C ones.
  * @warning Either all or none of your attached redox probes may use software I2C.
  * Using some with software I2C and others with hardware I2C is not supported.
  *
@@ -101,9 +107,11 @@
 /// @brief Sensor::_stabilizationTime_ms; the PaleoTerra redox sensor is
 /// immediately stable.
 #define PTR_STABILIZATION_TIME_MS 0
-/// @brief Sensor::_measurementTime_ms; the PaleoTerra redox sensor takes 67ms
-/// to complete a measurement.
-#define PTR_MEASUREMENT_TIME_MS 67
+/// @brief Sensor::_measurementTime_ms; the 18-bit one-shot conversion of the
+/// MCP3421 in the PaleoTerra redox sensor takes 267ms at 3.75 samples per
+/// second, plus about 10% for the tolerance of the ADC's clock.  This is the
+/// same 300ms that was waited before reading the result.
+#define PTR_MEASUREMENT_TIME_MS 300
 /**@}*/
 
 /**
@@ -126,11 +134,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "Voltage"
-#define PTR_VOLTAGE_VAR_NAME "Voltage"
+#define PTR_VOLTAGE_VAR_NAME MS_VAR_TEXT("Voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millivolt"
 /// (mV)
-#define PTR_VOLTAGE_UNIT_NAME "millivolt"
+#define PTR_VOLTAGE_UNIT_NAME MS_VAR_TEXT("millivolt")
 /// @brief Default variable short code; "PTRVoltage"
 #define PTR_VOLTAGE_DEFAULT_CODE "PTRVoltage"
 /**@}*/
@@ -249,6 +257,16 @@ class PaleoTerraRedox : public Sensor {
      */
     String getSensorLocation(void) override;
 
+    /**
+     * @brief Tell the sensor to start a single measurement by starting a
+     * one-shot conversion on its ADC.
+     *
+     * This also sets the #_millisMeasurementRequested timestamp.
+     *
+     * @return **bool** True if the start measurement function completed
+     * successfully.
+     */
+    bool startSingleMeasurement(void) override;
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
@@ -259,6 +277,10 @@ class PaleoTerraRedox : public Sensor {
      * @brief The I2C address of the redox sensor.
      */
     uint8_t _i2cAddressHex;
+    /**
+     * @brief The I2C status returned when the conversion was started.
+     */
+    byte _i2cStatus = -1;
 #if defined MS_PALEOTERRA_SOFTWAREWIRE
     /**
      * @brief An internal reference to the SoftwareWire instance.
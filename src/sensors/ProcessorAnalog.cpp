@@ -0,0 +1,89 @@
+/**
+ * @file ProcessorAnalog.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the ProcessorAnalog class.
+ */
+
+#include "ProcessorAnalog.h"
+
+
+float ProcessorAnalog::read(uint8_t pin, uint8_t resolution,
+                            uint16_t samples) {
+    // The priming reading sets up the pin and the input mux; the first
+    // reading after switching inputs is low, so it's thrown away
+    analogRead(pin);
+    if (samples <= 1) { return analogRead(pin); }
+
+#if defined(ARDUINO_ARCH_SAMD) && !defined(__SAMD51__)
+    // Let the ADC accumulate 2^shift 12-bit samples in its 16-bit result;
+    // ADJRES divides by at most 16, and past 16 samples the ADC shifts the
+    // rest off itself
+    uint8_t shift = 0;
+    while (shift < 10 && (2u << shift) <= samples) { shift++; }
+    uint8_t adjust = shift < 4 ? shift : 4;
+
+    uint16_t ctrlb   = ADC->CTRLB.reg;
+    uint8_t  avgctrl = ADC->AVGCTRL.reg;
+    while (ADC->STATUS.bit.SYNCBUSY) {}
+    ADC->CTRLB.bit.RESSEL = ADC_CTRLB_RESSEL_16BIT_Val;
+    ADC->AVGCTRL.reg      = ADC_AVGCTRL_SAMPLENUM(shift) |
+        ADC_AVGCTRL_ADJRES(adjust);
+    while (ADC->STATUS.bit.SYNCBUSY) {}
+    ADC->CTRLA.bit.ENABLE = 1;
+    while (ADC->STATUS.bit.SYNCBUSY) {}
+
+    ADC->INTFLAG.reg      = ADC_INTFLAG_RESRDY;
+    ADC->SWTRIG.bit.START = 1;
+    while (!ADC->INTFLAG.bit.RESRDY) {}
+    uint16_t result = ADC->RESULT.reg;
+
+    while (ADC->STATUS.bit.SYNCBUSY) {}
+    ADC->CTRLA.bit.ENABLE = 0;
+    while (ADC->STATUS.bit.SYNCBUSY) {}
+    ADC->CTRLB.reg   = ctrlb;
+    ADC->AVGCTRL.reg = avgctrl;
+    while (ADC->STATUS.bit.SYNCBUSY) {}
+
+    // The result is already the 12-bit average; bring it to the read
+    // resolution
+    float average = static_cast<float>(result) *
+        static_cast<float>(1UL << resolution) / 4096.0;
+    MS_DEEP_DBG(F("Pin"), pin, F("averaged over"), 1 << shift,
+                F("samples:"), average);
+    return average;
+
+#elif defined(ARDUINO_ARCH_AVR) && defined(ADATE) && defined(ADCSRB)
+    (void)resolution;
+    // Run the ADC free on the input analogRead() selected
+    uint8_t  adcsrb = ADCSRB;
+    uint32_t sum    = 0;
+    ADCSRB &= ~(_BV(ADTS2) | _BV(ADTS1) | _BV(ADTS0));
+    ADCSRA |= _BV(ADIF);
+    ADCSRA |= _BV(ADATE) | _BV(ADSC);
+    for (uint16_t i = 0; i < samples; i++) {
+        while (!(ADCSRA & _BV(ADIF))) {}
+        ADCSRA |= _BV(ADIF);
+        sum += ADC;
+    }
+    ADCSRA &= ~_BV(ADATE);
+    while (ADCSRA & _BV(ADSC)) {}
+    ADCSRB = adcsrb;
+
+    float average = static_cast<float>(sum) / samples;
+    MS_DEEP_DBG(F("Pin"), pin, F("averaged over"), samples, F("samples:"),
+                average);
+    return average;
+
+#else
+    (void)resolution;
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < samples; i++) { sum += analogRead(pin); }
+    float average = static_cast<float>(sum) / samples;
+    MS_DEEP_DBG(F("Pin"), pin, F("averaged over"), samples, F("samples:"),
+                average);
+    return average;
+#endif
+}
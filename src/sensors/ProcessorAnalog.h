@@ -0,0 +1,73 @@
+/**
+ * @file ProcessorAnalog.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the ProcessorAnalog class, an oversampled read of the
+ * processor's own ADC shared by the analog sensors.
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_PROCESSORANALOG_H_
+#define SRC_SENSORS_PROCESSORANALOG_H_
+
+// Debugging Statement
+// #define MS_PROCESSORANALOG_DEBUG
+
+#ifdef MS_PROCESSORANALOG_DEBUG
+#define MS_DEBUGGING_STD "ProcessorAnalog"
+#endif
+
+/**
+ * @def MS_PROCESSOR_ADC_SAMPLES
+ * @brief The number of ADC samples averaged into each processor analog
+ * reading.
+ *
+ * The default of 1 is a single reading after the priming reading, as
+ * analogRead() gives.  On a SAMD21 the ADC averages the samples itself and
+ * they're rounded down to a power of two, up to 1024; on an AVR the ADC runs
+ * free for the samples; on other boards they're read one at a time.  This is
+ * used by ProcessorStats, AnalogElecConductivity, and EverlightALSPT19.
+ */
+#ifndef MS_PROCESSOR_ADC_SAMPLES
+#define MS_PROCESSOR_ADC_SAMPLES 1
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Arduino.h>
+
+
+/**
+ * @brief The ProcessorAnalog class takes averaged readings from the
+ * processor's own ADC, using the hardware averaging where the processor has
+ * it.
+ *
+ * Each reading starts with a priming analogRead() to select the pin and
+ * settle the input, which is thrown away.
+ *
+ * @ingroup the_sensors
+ */
+class ProcessorAnalog {
+ public:
+    /**
+     * @brief Take an averaged reading of an analog pin.
+     *
+     * The analog reference (and on processors other than AVR the read
+     * resolution) should already be set.
+     *
+     * @param pin The analog pin to read
+     * @param resolution The read resolution in bits set with
+     * analogReadResolution(); 10 if it wasn't set
+     * @param samples The number of samples to average; optional with a
+     * default value of #MS_PROCESSOR_ADC_SAMPLES
+     * @return **float** The average reading in bits at the read resolution,
+     * with the fraction kept.
+     */
+    static float read(uint8_t pin, uint8_t resolution = 10,
+                      uint16_t samples = MS_PROCESSOR_ADC_SAMPLES);
+};
+
+#endif  // SRC_SENSORS_PROCESSORANALOG_H_
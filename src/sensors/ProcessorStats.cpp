@@ -9,6 +9,50 @@
  */
 
 #include "ProcessorStats.h"
+#include "ProcessorAnalog.h"
+
+#ifdef MS_PROCESSOR_MEMORY_STATS
+#if defined(__AVR__) || defined(ARDUINO_ARCH_AVR)
+extern int16_t __heap_start, *__brkval;
+extern uint8_t _end;
+extern uint8_t __stack;
+// The list of freed blocks kept by the avr-libc malloc
+struct __freelist {
+    size_t             sz;
+    struct __freelist* nx;
+};
+extern struct __freelist* __flp;
+
+// Fill everything above the static variables before main() starts, while
+// nothing is on the stack or in the heap yet
+void paintProcessorRam(void) __attribute__((naked, used, section(".init3")));
+void paintProcessorRam(void) {
+    uint8_t* p = &_end;
+    while (p <= &__stack) { *p++ = PROCESSOR_RAM_PAINT; }
+}
+
+// The first byte above the heap
+static uint8_t* processorHeapTop(void) {
+    return reinterpret_cast<uint8_t*>(__brkval == 0 ? &__heap_start
+                                                    : __brkval);
+}
+#elif defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO)
+#include <malloc.h>
+extern "C" char* sbrk(int i);
+
+static uint8_t* processorHeapTop(void) {
+    return reinterpret_cast<uint8_t*>(sbrk(0));
+}
+
+// Fill the free RAM between the heap and a little below this function's own
+// stack frame
+static void paintProcessorRam(void) {
+    uint8_t  here = 0;
+    uint8_t* p    = processorHeapTop();
+    while (p < &here - 64) { *p++ = PROCESSOR_RAM_PAINT; }
+}
+#endif
+#endif
 
 // Need to know the Mayfly version because the battery resistor depends on it
 ProcessorStats::ProcessorStats(const char* version)
@@ -16,6 +60,10 @@ ProcessorStats::ProcessorStats(const char* version)
              PROCESSOR_STABILIZATION_TIME_MS, PROCESSOR_MEASUREMENT_TIME_MS, -1,
              -1, 1, PROCESSOR_INC_CALC_VARIABLES),
       _version(version) {
+#if defined(MS_PROCESSOR_MEMORY_STATS) && \
+    (defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO))
+    paintProcessorRam();
+#endif
 #if defined(ARDUINO_AVR_ENVIRODIY_MAYFLY) || defined(ARDUINO_AVR_SODAQ_MBILI)
     _batteryPin = A6;
 #elif defined(ARDUINO_AVR_FEATHER32U4) || defined(ARDUINO_SAMD_FEATHER_M0) || \
@@ -58,14 +106,12 @@ bool ProcessorStats::addSingleMeasurementResult(void) {
     MS_DBG(F("Getting battery voltage from pin"), _batteryPin);
 
     float sensorValue_battery = -9999;
-    analogRead(_batteryPin);  // priming reading
 
 #if defined(ARDUINO_AVR_ENVIRODIY_MAYFLY)
     if (strcmp(_version, "v0.3") == 0 || strcmp(_version, "v0.4") == 0) {
         // Get the battery voltage
         // The return value from analogRead() is IN BITS NOT IN VOLTS!!
-        analogRead(_batteryPin);  // priming reading
-        float rawBattery = analogRead(_batteryPin);
+        float rawBattery = ProcessorAnalog::read(_batteryPin);
         MS_DBG(F("Raw battery pin reading in bits:"), rawBattery);
         // convert bits to volts
         sensorValue_battery = (3.3 / 1023.) * 1.47 * rawBattery;
@@ -75,8 +121,7 @@ bool ProcessorStats::addSingleMeasurementResult(void) {
         strcmp(_version, "v1.0") || strcmp(_version, "v1.1") == 0) {
         // Get the battery voltage
         // The return value from analogRead() is IN BITS NOT IN VOLTS!!
-        analogRead(_batteryPin);  // priming reading
-        float rawBattery = analogRead(_batteryPin);
+        float rawBattery = ProcessorAnalog::read(_batteryPin);
         MS_DBG(F("Raw battery pin reading in bits:"), rawBattery);
         // convert bits to volts
         sensorValue_battery = (3.3 / 1023.) * 4.7 * rawBattery;
@@ -85,8 +130,7 @@ bool ProcessorStats::addSingleMeasurementResult(void) {
 
 #elif defined(ARDUINO_AVR_FEATHER32U4) || defined(ARDUINO_SAMD_FEATHER_M0) || \
     defined(ARDUINO_SAMD_FEATHER_M0_EXPRESS)
-    analogRead(_batteryPin);  // priming reading
-    float measuredvbat = analogRead(_batteryPin);
+    float measuredvbat = ProcessorAnalog::read(_batteryPin);
     measuredvbat *= 2;     // we divided by 2, so multiply back
     measuredvbat *= 3.3;   // Multiply by 3.3V, our reference voltage
     measuredvbat /= 1024;  // convert to voltage
@@ -95,26 +139,23 @@ bool ProcessorStats::addSingleMeasurementResult(void) {
 #elif defined(ARDUINO_SODAQ_ONE) || defined(ARDUINO_SODAQ_ONE_BETA)
     if (strcmp(_version, "v0.1") == 0) {
         // Get the battery voltage
-        analogRead(_batteryPin);  // priming reading
-        float rawBattery = analogRead(_batteryPin);
+        float rawBattery = ProcessorAnalog::read(_batteryPin);
         MS_DBG(F("Raw battery pin reading in bits:"), rawBattery);
         sensorValue_battery = (3.3 / 1023.) * 2 * rawBattery;
         MS_DBG(F("Battery in Volts:"), sensorValue_battery);
     }
-    if (strcmp(_version, "v0.2") == 0)
-        analogRead(_batteryPin);  // priming reading{
-    // Get the battery voltage
-    float rawBattery = analogRead(_batteryPin);
-    MS_DBG(F("Raw battery pin reading in bits:"), rawBattery);
-    sensorValue_battery = (3.3 / 1023.) * 1.47 * rawBattery;
-    MS_DBG(F("Battery in Volts:"), sensorValue_battery);
+    if (strcmp(_version, "v0.2") == 0) {
+        // Get the battery voltage
+        float rawBattery = ProcessorAnalog::read(_batteryPin);
+        MS_DBG(F("Raw battery pin reading in bits:"), rawBattery);
+        sensorValue_battery = (3.3 / 1023.) * 1.47 * rawBattery;
+        MS_DBG(F("Battery in Volts:"), sensorValue_battery);
     }
 
 #elif defined(ARDUINO_AVR_SODAQ_NDOGO) || defined(ARDUINO_SODAQ_AUTONOMO) || \
     defined(ARDUINO_AVR_SODAQ_MBILI)
     // Get the battery voltage
-    analogRead(_batteryPin);  // priming reading
-    float rawBattery = analogRead(_batteryPin);
+    float rawBattery = ProcessorAnalog::read(_batteryPin);
     MS_DBG(F("Raw battery pin reading in bits:"), rawBattery);
     sensorValue_battery = (3.3 / 1023.) * 1.47 * rawBattery;
     MS_DBG(F("Battery in Volts:"), sensorValue_battery);
@@ -145,6 +186,48 @@ bool ProcessorStats::addSingleMeasurementResult(void) {
 
     verifyAndAddMeasurementResult(PROCESSOR_RAM_VAR_NUM, sensorValue_freeRam);
 
+#ifdef MS_PROCESSOR_MEMORY_STATS
+    MS_DBG(F("Getting the memory high water mark and heap fragmentation"));
+    float sensorValue_minRam    = -9999;
+    float sensorValue_freeBlock = -9999;
+    float sensorValue_heapFrag  = -9999;
+#if defined(__AVR__) || defined(ARDUINO_ARCH_AVR) || \
+    defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_SAMD_ZERO)
+    uint8_t  here = 0;
+    uint8_t* top  = processorHeapTop();
+    // The stack has never reached the part of the fill that's still there
+    uint8_t* p = top;
+    while (p < &here && *p == PROCESSOR_RAM_PAINT) { p++; }
+    sensorValue_minRam = p - top;
+
+    uint32_t gap     = &here - top;
+    uint32_t largest = gap;
+#if defined(__AVR__) || defined(ARDUINO_ARCH_AVR)
+    uint32_t holes = 0;
+    for (struct __freelist* fl = __flp; fl != nullptr; fl = fl->nx) {
+        holes += fl->sz;
+        if (fl->sz > largest) largest = fl->sz;
+    }
+#else
+    uint32_t holes = mallinfo().fordblks;
+#endif
+    sensorValue_freeBlock = largest;
+    if (gap + holes > 0) {
+        sensorValue_heapFrag = 100.0f * (gap + holes - largest) /
+            (gap + holes);
+    }
+    MS_DBG(F("  Least free RAM:"), sensorValue_minRam);
+    MS_DBG(F("  Largest free block:"), sensorValue_freeBlock);
+    MS_DBG(F("  Heap fragmentation:"), sensorValue_heapFrag);
+#endif
+    verifyAndAddMeasurementResult(PROCESSOR_MIN_RAM_VAR_NUM,
+                                  sensorValue_minRam);
+    verifyAndAddMeasurementResult(PROCESSOR_FREE_BLOCK_VAR_NUM,
+                                  sensorValue_freeBlock);
+    verifyAndAddMeasurementResult(PROCESSOR_HEAP_FRAG_VAR_NUM,
+                                  sensorValue_heapFrag);
+#endif
+
     // bump up the sample number
     sampNum += 1;
 
@@ -6,8 +6,10 @@
  * @author Sara Geleskie Damiano <sdamiano@stroudcenter.org>
  *
  * @brief Contains the ProcessorStats sensor subclass and the variable
- * subclasses ProcessorStats_Battery, ProcessorStats_FreeRam, and
- * ProcessorStats_SampleNumber.
+ * subclasses ProcessorStats_Battery, ProcessorStats_FreeRam,
+ * ProcessorStats_SampleNumber and, with MS_PROCESSOR_MEMORY_STATS,
+ * ProcessorStats_MinFreeRam, ProcessorStats_LargestFreeBlock and
+ * ProcessorStats_HeapFragmentation.
  *
  * These are for metadata on the processor functionality.
  */
@@ -40,6 +42,17 @@
  * - [Atmel ATmega16U4 32U4 Datasheet Summary](https://github.com/EnviroDIY/ModularSensors/wiki/Processor-Datasheets/Atmel-ATmega16U4-32U4-Datasheet-Summary.pdf)
  * - [Atmel ATmega16U4 32U4 Datasheet](https://github.com/EnviroDIY/ModularSensors/wiki/Processor-Datasheets/Atmel-ATmega16U4-32U4-Datasheet.pdf)
  *
+ * @section sensor_processor_flags Build flags
+ * - ```-D MS_PROCESSOR_MEMORY_STATS```
+ *      - adds the stack high water mark, the largest free block of RAM and
+ * the fragmentation of the heap as three more processor variables
+ *      - the free RAM is filled with a known byte when the board starts
+ * (before `main()` on AVR boards, when the ProcessorStats object is made on
+ * SAMD boards); the least free RAM is the part of that fill the stack and
+ * heap have never written over
+ *      - on SAMD boards the free space inside the heap can't be split into
+ * blocks, so all of it is counted as fragments
+ *
  * @section sensor_processor_sensor_ctor Sensor Constructor
  * {{ @ref ProcessorStats::ProcessorStats }}
  *
@@ -73,8 +86,13 @@
 /**@{*/
 
 // Sensor Specific Defines
+#ifdef MS_PROCESSOR_MEMORY_STATS
+/// @brief Sensor::_numReturnedValues; the processor can report 6 values.
+#define PROCESSOR_NUM_VARIABLES 6
+#else
 /// @brief Sensor::_numReturnedValues; the processor can report 3 values.
 #define PROCESSOR_NUM_VARIABLES 3
+#endif
 /// @brief Sensor::_incCalcValues; sample number is (sort-of) calculated.
 #define PROCESSOR_INC_CALC_VARIABLES 1
 
@@ -123,10 +141,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// batteryVoltage
-#define PROCESSOR_BATTERY_VAR_NAME "batteryVoltage"
+#define PROCESSOR_BATTERY_VAR_NAME MS_VAR_TEXT("batteryVoltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "volt"
-#define PROCESSOR_BATTERY_UNIT_NAME "volt"
+#define PROCESSOR_BATTERY_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "Battery"
 #define PROCESSOR_BATTERY_DEFAULT_CODE "Battery"
 /**@}*/
@@ -152,10 +170,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// freeSRAM
-#define PROCESSOR_RAM_VAR_NAME "freeSRAM"
+#define PROCESSOR_RAM_VAR_NAME MS_VAR_TEXT("freeSRAM")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "Bit"
-#define PROCESSOR_RAM_UNIT_NAME "Bit"
+#define PROCESSOR_RAM_UNIT_NAME MS_VAR_TEXT("Bit")
 /// @brief Default variable short code; "FreeRam"
 #define PROCESSOR_RAM_DEFAULT_CODE "FreeRam"
 /**@}*/
@@ -182,15 +200,103 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// sequenceNumber
-#define PROCESSOR_SAMPNUM_VAR_NAME "sequenceNumber"
+#define PROCESSOR_SAMPNUM_VAR_NAME MS_VAR_TEXT("sequenceNumber")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "Dimensionless" (sequence number)
-#define PROCESSOR_SAMPNUM_UNIT_NAME "Dimensionless"
+#define PROCESSOR_SAMPNUM_UNIT_NAME MS_VAR_TEXT("Dimensionless")
 /// @brief Default variable short code; "SampNum"
 #define PROCESSOR_SAMPNUM_DEFAULT_CODE "SampNum"
 /**@}*/
 
+#ifdef MS_PROCESSOR_MEMORY_STATS
+/// @brief The byte the free RAM is filled with when the board starts
+#define PROCESSOR_RAM_PAINT 0xC5
+
+/**
+ * @anchor sensor_processor_min_ram
+ * @name Least Free RAM
+ * The stack high water mark from the processor/mcu (MS_PROCESSOR_MEMORY_STATS)
+ * This is the least RAM there has been between the heap and the stack since
+ * the board started.  If this gets near 0, the stack is about to run into the
+ * heap and crash the board.
+ * - Range is 0 to full RAM available on processor
+ *
+ * {{ @ref ProcessorStats_MinFreeRam::ProcessorStats_MinFreeRam }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; ram should have 0 -
+/// resolution is 1 byte.
+#define PROCESSOR_MIN_RAM_RESOLUTION 0
+/// @brief Least free RAM is stored in sensorValues[3]
+#define PROCESSOR_MIN_RAM_VAR_NUM 3
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// freeSRAM
+#define PROCESSOR_MIN_RAM_VAR_NAME MS_VAR_TEXT("freeSRAM")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "Bit"
+#define PROCESSOR_MIN_RAM_UNIT_NAME MS_VAR_TEXT("Bit")
+/// @brief Default variable short code; "MinFreeRam"
+#define PROCESSOR_MIN_RAM_DEFAULT_CODE "MinFreeRam"
+/**@}*/
+
+/**
+ * @anchor sensor_processor_free_block
+ * @name Largest Free Block
+ * The largest block of RAM that could be allocated from the processor/mcu
+ * (MS_PROCESSOR_MEMORY_STATS)
+ * This is the larger of the largest hole in the heap and the space between
+ * the heap and the stack.
+ * - Range is 0 to full RAM available on processor
+ *
+ * {{ @ref ProcessorStats_LargestFreeBlock::ProcessorStats_LargestFreeBlock }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; ram should have 0 -
+/// resolution is 1 byte.
+#define PROCESSOR_FREE_BLOCK_RESOLUTION 0
+/// @brief Largest free block is stored in sensorValues[4]
+#define PROCESSOR_FREE_BLOCK_VAR_NUM 4
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// freeSRAM
+#define PROCESSOR_FREE_BLOCK_VAR_NAME MS_VAR_TEXT("freeSRAM")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "Bit"
+#define PROCESSOR_FREE_BLOCK_UNIT_NAME MS_VAR_TEXT("Bit")
+/// @brief Default variable short code; "MaxFreeBlock"
+#define PROCESSOR_FREE_BLOCK_DEFAULT_CODE "MaxFreeBlock"
+/**@}*/
+
+/**
+ * @anchor sensor_processor_heap_frag
+ * @name Heap Fragmentation
+ * The fragmentation of the free RAM of the processor/mcu
+ * (MS_PROCESSOR_MEMORY_STATS)
+ * This is the percent of the free RAM that isn't in the largest free block.
+ * A number that keeps climbing means Strings or other allocations are
+ * breaking the heap into pieces too small to use.
+ * - Range is 0 to 100
+ *
+ * {{ @ref ProcessorStats_HeapFragmentation::ProcessorStats_HeapFragmentation }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; fragmentation should
+/// have 1.
+#define PROCESSOR_HEAP_FRAG_RESOLUTION 1
+/// @brief Heap fragmentation is stored in sensorValues[5]
+#define PROCESSOR_HEAP_FRAG_VAR_NUM 5
+/// @brief Variable name; "heapFragmentation"
+#define PROCESSOR_HEAP_FRAG_VAR_NAME MS_VAR_TEXT("heapFragmentation")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
+#define PROCESSOR_HEAP_FRAG_UNIT_NAME MS_VAR_TEXT("percent")
+/// @brief Default variable short code; "HeapFrag"
+#define PROCESSOR_HEAP_FRAG_DEFAULT_CODE "HeapFrag"
+/**@}*/
+#endif
+
 
 // EnviroDIY boards
 #if defined(ARDUINO_AVR_ENVIRODIY_MAYFLY)
@@ -466,5 +572,140 @@ class ProcessorStats_SampleNumber : public Variable {
      */
     ~ProcessorStats_SampleNumber() {}
 };
+
+
+#ifdef MS_PROCESSOR_MEMORY_STATS
+/**
+ * @brief The Variable sub-class used for the
+ * [least free RAM](@ref sensor_processor_min_ram) since the MCU started - the
+ * stack high water mark.
+ *
+ * @ingroup sensor_processor
+ */
+class ProcessorStats_MinFreeRam : public Variable {
+ public:
+    /**
+     * @brief Construct a new ProcessorStats_MinFreeRam object.
+     *
+     * @param parentSense The parent ProcessorStats providing the result
+     * values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "MinFreeRam".
+     */
+    explicit ProcessorStats_MinFreeRam(
+        ProcessorStats* parentSense, const char* uuid = "",
+        const char* varCode = PROCESSOR_MIN_RAM_DEFAULT_CODE)
+        : Variable(parentSense, (const uint8_t)PROCESSOR_MIN_RAM_VAR_NUM,
+                   (uint8_t)PROCESSOR_MIN_RAM_RESOLUTION,
+                   PROCESSOR_MIN_RAM_VAR_NAME, PROCESSOR_MIN_RAM_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Construct a new ProcessorStats_MinFreeRam object.
+     *
+     * @note This must be tied with a parent ProcessorStats before it can be
+     * used.
+     */
+    ProcessorStats_MinFreeRam()
+        : Variable((const uint8_t)PROCESSOR_MIN_RAM_VAR_NUM,
+                   (uint8_t)PROCESSOR_MIN_RAM_RESOLUTION,
+                   PROCESSOR_MIN_RAM_VAR_NAME, PROCESSOR_MIN_RAM_UNIT_NAME,
+                   PROCESSOR_MIN_RAM_DEFAULT_CODE) {}
+    /**
+     * @brief Destroy the ProcessorStats_MinFreeRam object - no action needed.
+     */
+    ~ProcessorStats_MinFreeRam() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the
+ * [largest free block](@ref sensor_processor_free_block) of RAM on the MCU.
+ *
+ * @ingroup sensor_processor
+ */
+class ProcessorStats_LargestFreeBlock : public Variable {
+ public:
+    /**
+     * @brief Construct a new ProcessorStats_LargestFreeBlock object.
+     *
+     * @param parentSense The parent ProcessorStats providing the result
+     * values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "MaxFreeBlock".
+     */
+    explicit ProcessorStats_LargestFreeBlock(
+        ProcessorStats* parentSense, const char* uuid = "",
+        const char* varCode = PROCESSOR_FREE_BLOCK_DEFAULT_CODE)
+        : Variable(parentSense, (const uint8_t)PROCESSOR_FREE_BLOCK_VAR_NUM,
+                   (uint8_t)PROCESSOR_FREE_BLOCK_RESOLUTION,
+                   PROCESSOR_FREE_BLOCK_VAR_NAME,
+                   PROCESSOR_FREE_BLOCK_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Construct a new ProcessorStats_LargestFreeBlock object.
+     *
+     * @note This must be tied with a parent ProcessorStats before it can be
+     * used.
+     */
+    ProcessorStats_LargestFreeBlock()
+        : Variable((const uint8_t)PROCESSOR_FREE_BLOCK_VAR_NUM,
+                   (uint8_t)PROCESSOR_FREE_BLOCK_RESOLUTION,
+                   PROCESSOR_FREE_BLOCK_VAR_NAME,
+                   PROCESSOR_FREE_BLOCK_UNIT_NAME,
+                   PROCESSOR_FREE_BLOCK_DEFAULT_CODE) {}
+    /**
+     * @brief Destroy the ProcessorStats_LargestFreeBlock object - no action
+     * needed.
+     */
+    ~ProcessorStats_LargestFreeBlock() {}
+};
+
+
+/**
+ * @brief The Variable sub-class used for the
+ * [heap fragmentation](@ref sensor_processor_heap_frag) of the MCU.
+ *
+ * @ingroup sensor_processor
+ */
+class ProcessorStats_HeapFragmentation : public Variable {
+ public:
+    /**
+     * @brief Construct a new ProcessorStats_HeapFragmentation object.
+     *
+     * @param parentSense The parent ProcessorStats providing the result
+     * values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "HeapFrag".
+     */
+    explicit ProcessorStats_HeapFragmentation(
+        ProcessorStats* parentSense, const char* uuid = "",
+        const char* varCode = PROCESSOR_HEAP_FRAG_DEFAULT_CODE)
+        : Variable(parentSense, (const uint8_t)PROCESSOR_HEAP_FRAG_VAR_NUM,
+                   (uint8_t)PROCESSOR_HEAP_FRAG_RESOLUTION,
+                   PROCESSOR_HEAP_FRAG_VAR_NAME, PROCESSOR_HEAP_FRAG_UNIT_NAME,
+                   varCode, uuid) {}
+    /**
+     * @brief Construct a new ProcessorStats_HeapFragmentation object.
+     *
+     * @note This must be tied with a parent ProcessorStats before it can be
+     * used.
+     */
+    ProcessorStats_HeapFragmentation()
+        : Variable((const uint8_t)PROCESSOR_HEAP_FRAG_VAR_NUM,
+                   (uint8_t)PROCESSOR_HEAP_FRAG_RESOLUTION,
+                   PROCESSOR_HEAP_FRAG_VAR_NAME, PROCESSOR_HEAP_FRAG_UNIT_NAME,
+                   PROCESSOR_HEAP_FRAG_DEFAULT_CODE) {}
+    /**
+     * @brief Destroy the ProcessorStats_HeapFragmentation object - no action
+     * needed.
+     */
+    ~ProcessorStats_HeapFragmentation() {}
+};
+#endif
 /**@}*/
 #endif  // SRC_SENSORS_PROCESSORSTATS_H_
@@ -40,14 +40,18 @@ RainCounterI2C::RainCounterI2C(TwoWire* theI2C, uint8_t i2cAddressHex,
              1),
       _rainPerTip(rainPerTip),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(theI2C) {}
+      _i2c(theI2C) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 RainCounterI2C::RainCounterI2C(uint8_t i2cAddressHex, float rainPerTip)
     : Sensor("RainCounterI2C", BUCKET_NUM_VARIABLES, BUCKET_WARM_UP_TIME_MS,
              BUCKET_STABILIZATION_TIME_MS, BUCKET_MEASUREMENT_TIME_MS, -1, -1,
              1),
       _rainPerTip(rainPerTip),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(&Wire) {}
+      _i2c(&Wire) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 #endif
 
 
@@ -94,6 +98,10 @@ bool RainCounterI2C::addSingleMeasurementResult(void) {
     // intialize values
     float   rain = -9999;  // Number of mm of rain
     int32_t tips = -9999;  // Number of tip events, increased for anemometer
+#if defined MS_RAIN_EVENT_TIMES
+    float peak1 = -9999;  // Peak 1-minute intensity, per hour
+    float peak5 = -9999;  // Peak 5-minute intensity, per hour
+#endif
 
     // Get data from external tip counter
     // if the 'requestFrom' returns 0, it means no bytes were received
@@ -143,12 +151,31 @@ bool RainCounterI2C::addSingleMeasurementResult(void) {
 
         MS_DBG(F("  Rain:"), rain);
         MS_DBG(F("  Tips:"), tips);
+
+#if defined MS_RAIN_EVENT_TIMES
+        int16_t nEvents = readEventTimes();
+        // With no tips, the intensities are 0 whether or not the counter
+        // keeps tip times.  Otherwise we need a time for the tips.
+        if (tips == 0) {
+            peak1 = 0;
+            peak5 = 0;
+        } else if (nEvents > 0) {
+            peak1 = peakIntensity(nEvents, 60);
+            peak5 = peakIntensity(nEvents, 300);
+        }
+        MS_DBG(F("  Peak 1-minute intensity:"), peak1);
+        MS_DBG(F("  Peak 5-minute intensity:"), peak5);
+#endif
     } else {
         MS_DBG(F("No bytes received from"), getSensorNameAndLocation());
     }
 
     verifyAndAddMeasurementResult(BUCKET_RAIN_VAR_NUM, rain);
     verifyAndAddMeasurementResult(BUCKET_TIPS_VAR_NUM, tips);
+#if defined MS_RAIN_EVENT_TIMES
+    verifyAndAddMeasurementResult(BUCKET_PEAK1_VAR_NUM, peak1);
+    verifyAndAddMeasurementResult(BUCKET_PEAK5_VAR_NUM, peak5);
+#endif
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
@@ -158,3 +185,71 @@ bool RainCounterI2C::addSingleMeasurementResult(void) {
     // Return true when finished
     return true;
 }
+
+
+#if defined MS_RAIN_EVENT_TIMES
+int16_t RainCounterI2C::readEventTimes(void) {
+    int16_t nEvents = 0;
+
+    // Ask for the tip times instead of the count
+    _i2c->beginTransmission(_i2cAddressHex);
+    _i2c->write(static_cast<uint8_t>(BUCKET_EVENT_TIMES_COMMAND));
+    if (_i2c->endTransmission() != 0) {
+        MS_DBG(getSensorNameAndLocation(), F("didn't take the tip time"),
+               F("command"));
+        return -1;
+    }
+
+    uint8_t inFrame = BUCKET_EVENTS_PER_FRAME;
+    while (inFrame == BUCKET_EVENTS_PER_FRAME) {
+        if (!_i2c->requestFrom(
+                static_cast<uint8_t>(_i2cAddressHex),
+                static_cast<uint8_t>(1 + 2 * BUCKET_EVENTS_PER_FRAME))) {
+            MS_DBG(F("  No tip time frame received"));
+            return nEvents > 0 ? nEvents : -1;
+        }
+        inFrame = _i2c->read();
+        // A counter that doesn't know the command answers with its count;
+        // anything too big for a frame can't be a tip time frame
+        if (inFrame > BUCKET_EVENTS_PER_FRAME) {
+            MS_DBG(F("  Counter doesn't send tip times"));
+            return -1;
+        }
+        for (uint8_t i = 0; i < inFrame && _i2c->available() >= 2; i++) {
+            uint16_t age = static_cast<uint16_t>(_i2c->read()) << 8;
+            age |= static_cast<uint16_t>(_i2c->read());
+            if (nEvents < MS_RAIN_MAX_EVENTS) { _eventAges[nEvents++] = age; }
+        }
+        // Empty whatever is left of the frame
+        while (_i2c->available()) { _i2c->read(); }
+    }
+
+    // Put the tips in order, oldest first, in case the counter's ring buffer
+    // wrapped; there are few enough for an insertion sort
+    for (int16_t i = 1; i < nEvents; i++) {
+        uint16_t age = _eventAges[i];
+        int16_t  j   = i - 1;
+        while (j >= 0 && _eventAges[j] < age) {
+            _eventAges[j + 1] = _eventAges[j];
+            j--;
+        }
+        _eventAges[j + 1] = age;
+    }
+    MS_DBG(F("  Read"), nEvents, F("tip times"));
+    return nEvents;
+}
+
+
+float RainCounterI2C::peakIntensity(int16_t nEvents, uint16_t window_s) {
+    // Slide a window over the tips, oldest first, keeping the most tips that
+    // fit within it
+    int16_t peakTips = 0;
+    int16_t first    = 0;
+    for (int16_t last = 0; last < nEvents; last++) {
+        while (_eventAges[first] - _eventAges[last] >= window_s) { first++; }
+        if (last - first + 1 > peakTips) { peakTips = last - first + 1; }
+    }
+    return static_cast<float>(peakTips) * _rainPerTip * 3600.0f /
+        static_cast<float>(window_s);
+}
+#endif
@@ -47,10 +47,41 @@
  * @section sensor_i2c_rain_flags Build flags
  * - `-D MS_RAIN_SOFTWAREWIRE`
  *      - switches from using hardware I2C to software I2C
+ * @note Software I2C is much slower than hardware I2C and keeps the processor
+ * busy, with interrupts held off, for each bit it clocks out.  It should only
+ * be used when no hardware bus can be; on a SAMD board a second hardware bus
+ * can be made on a spare SERCOM and given to the TwoWire constructor instead.
+ * Only the sensors on a hardware bus are registered with Sensor::setBus(), so
+ * #MS_I2C_CLOCK_PER_SENSOR doesn't apply to the software I2C ones.
  * @warning Either all or none of your attached tipping bucket counters may use
  * software I2C. Using some with software I2C and others with hardware I2C is
  * not supported. Though, honestly, having more than one attached seems pretty
  * unlikely anyway.
+ * - `-D MS_RAIN_EVENT_TIMES`
+ *      - also reads the time of each tip since the last reading from the
+ * counter and reports the peak 1- and 5-minute rainfall intensities
+ * - `-D MS_RAIN_MAX_EVENTS=##`
+ *      - sets the number of tip times kept for each reading; the default is
+ * 64.  Tips beyond that are still counted, but not used for the intensities.
+ *
+ * @section sensor_i2c_rain_events Tip Times
+ * With `MS_RAIN_EVENT_TIMES`, after the count is read the logger writes
+ * #BUCKET_EVENT_TIMES_COMMAND to the counter and then reads back the tip
+ * times in frames of up to 31 bytes.  Each frame starts with the number of
+ * tips in it (at most #BUCKET_EVENTS_PER_FRAME), followed by the age of each
+ * of those tips in seconds when the count was read, as big-endian 16-bit
+ * numbers.  A frame with fewer than #BUCKET_EVENTS_PER_FRAME tips is the
+ * last.  The counter then forgets the tip times, as it does its count.  A
+ * counter that doesn't know the command, like the stock Trinket counter,
+ * answers with its (already cleared) count and so reports no tips, leaving
+ * the intensities at -9999.
+ *
+ * The extras/rain_event_counter sketch turns any Arduino into a counter that
+ * keeps the debounced time of each tip and answers the command.
+ *
+ * The peak intensities are the most rain in any 60 or 300 seconds of the
+ * time since the last reading, scaled to millimeters (or whatever unit
+ * rainPerTip is in) per hour.
  *
  * @section sensor_i2c_rain_ctor Sensor Constructors
  * {{ @ref RainCounterI2C::RainCounterI2C(uint8_t, float) }}
@@ -93,12 +124,31 @@
 /**@{*/
 
 // Sensor Specific Defines
+#if defined(MS_RAIN_EVENT_TIMES) || defined(DOXYGEN)
+/// @brief Sensor::_numReturnedValues; the tipping bucket counter can report 4
+/// values when the tip times are read.
+#define BUCKET_NUM_VARIABLES 4
+/// @brief Sensor::_incCalcValues; we calculate rain depth and the two peak
+/// intensities from the tips.
+#define BUCKET_INC_CALC_VARIABLES 3
+#else
 /// @brief Sensor::_numReturnedValues; the tipping bucket counter can report 2
 /// values.
 #define BUCKET_NUM_VARIABLES 2
 /// @brief Sensor::_incCalcValues; we calculate rain depth from the number of
 /// tips, assuming either English or metric calibration.
 #define BUCKET_INC_CALC_VARIABLES 1
+#endif
+
+#if !defined(MS_RAIN_MAX_EVENTS) || defined(DOXYGEN)
+/// @brief The number of tip times kept for each reading.
+#define MS_RAIN_MAX_EVENTS 64
+#endif
+/// @brief The command byte asking the counter for its tip times.
+#define BUCKET_EVENT_TIMES_COMMAND 0x54
+/// @brief The most tip times sent in one frame, to fit the 32 byte Wire
+/// buffer of an AVR.
+#define BUCKET_EVENTS_PER_FRAME 15
 
 /**
  * @anchor sensor_i2c_rain_timing
@@ -141,11 +191,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "precipitation"
-#define BUCKET_RAIN_VAR_NAME "precipitation"
+#define BUCKET_RAIN_VAR_NAME MS_VAR_TEXT("precipitation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "millimeter"
-#define BUCKET_RAIN_UNIT_NAME "millimeter"
+#define BUCKET_RAIN_UNIT_NAME MS_VAR_TEXT("millimeter")
 /// @brief Default variable short code; "RainCounterI2CVol"
 #define BUCKET_RAIN_DEFAULT_CODE "RainCounterI2CVol"
 /**@}*/
@@ -168,14 +218,70 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "precipitation"
-#define BUCKET_TIPS_VAR_NAME "precipitation"
+#define BUCKET_TIPS_VAR_NAME MS_VAR_TEXT("precipitation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "event"
-#define BUCKET_TIPS_UNIT_NAME "event"
+#define BUCKET_TIPS_UNIT_NAME MS_VAR_TEXT("event")
 /// @brief Default variable short code; "RainCounterI2CTips"
 #define BUCKET_TIPS_DEFAULT_CODE "RainCounterI2CTips"
 /**@}*/
 
+/**
+ * @anchor sensor_i2c_rain_peak1
+ * @name Peak 1-Minute Intensity
+ * Defines for the peak 1-minute rainfall intensity from a Trinket-based
+ * tipping bucket counter
+ * - Only available with `MS_RAIN_EVENT_TIMES`
+ * - Resolution is one tip per minute (12 mm/h for a 0.2 mm bucket)
+ *
+ * {{ @ref RainCounterI2C_Peak1Min::RainCounterI2C_Peak1Min }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; intensity should have 1.
+#define BUCKET_PEAK1_RESOLUTION 1
+/// @brief Sensor variable number; the 1-minute intensity is stored in
+/// sensorValues[2].
+#define BUCKET_PEAK1_VAR_NUM 2
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "rainfallRate"
+#define BUCKET_PEAK1_VAR_NAME MS_VAR_TEXT("rainfallRate")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
+/// "millimeterPerHour"
+#define BUCKET_PEAK1_UNIT_NAME MS_VAR_TEXT("millimeterPerHour")
+/// @brief Default variable short code; "RainCounterI2CPeak1"
+#define BUCKET_PEAK1_DEFAULT_CODE "RainCounterI2CPeak1"
+/**@}*/
+
+/**
+ * @anchor sensor_i2c_rain_peak5
+ * @name Peak 5-Minute Intensity
+ * Defines for the peak 5-minute rainfall intensity from a Trinket-based
+ * tipping bucket counter
+ * - Only available with `MS_RAIN_EVENT_TIMES`
+ * - Resolution is one tip per five minutes (2.4 mm/h for a 0.2 mm bucket)
+ *
+ * {{ @ref RainCounterI2C_Peak5Min::RainCounterI2C_Peak5Min }}
+ */
+/**@{*/
+/// @brief Decimals places in string representation; intensity should have 1.
+#define BUCKET_PEAK5_RESOLUTION 1
+/// @brief Sensor variable number; the 5-minute intensity is stored in
+/// sensorValues[3].
+#define BUCKET_PEAK5_VAR_NUM 3
+/// @brief Variable name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
+/// "rainfallRate"
+#define BUCKET_PEAK5_VAR_NAME MS_VAR_TEXT("rainfallRate")
+/// @brief Variable unit name in
+/// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
+/// "millimeterPerHour"
+#define BUCKET_PEAK5_UNIT_NAME MS_VAR_TEXT("millimeterPerHour")
+/// @brief Default variable short code; "RainCounterI2CPeak5"
+#define BUCKET_PEAK5_DEFAULT_CODE "RainCounterI2CPeak5"
+/**@}*/
+
 
 /* clang-format off */
 /**
@@ -281,6 +387,29 @@ class RainCounterI2C : public Sensor {
     bool addSingleMeasurementResult(void) override;
 
  private:
+#if defined(MS_RAIN_EVENT_TIMES) || defined(DOXYGEN)
+    /**
+     * @brief Read the times of the tips since the last reading into
+     * #_eventAges.
+     *
+     * @return **int16_t** The number of tip times read, or -1 if the counter
+     * didn't answer.
+     */
+    int16_t readEventTimes(void);
+    /**
+     * @brief Find the peak rainfall intensity over a window from the tip
+     * times in #_eventAges.
+     *
+     * @param nEvents The number of tip times in #_eventAges, oldest first
+     * @param window_s The length of the window in seconds
+     * @return **float** The most rain in any window, per hour.
+     */
+    float peakIntensity(int16_t nEvents, uint16_t window_s);
+    /**
+     * @brief The ages in seconds of the tips since the last reading.
+     */
+    uint16_t _eventAges[MS_RAIN_MAX_EVENTS];
+#endif
     /**
      * @brief The depth of rain per tip.
      */
@@ -393,5 +522,91 @@ class RainCounterI2C_Depth : public Variable {
      */
     ~RainCounterI2C_Depth() {}
 };
+
+#if defined(MS_RAIN_EVENT_TIMES) || defined(DOXYGEN)
+/**
+ * @brief The Variable sub-class used for the
+ * [peak 1-minute intensity output](@ref sensor_i2c_rain_peak1) from an
+ * [Adafruit Trinket based I2C tipping bucket counter](@ref sensor_i2c_rain)
+ * - gives the most rain in any minute since the last reading, per hour.
+ *
+ * @ingroup sensor_i2c_rain
+ */
+class RainCounterI2C_Peak1Min : public Variable {
+ public:
+    /**
+     * @brief Construct a new RainCounterI2C_Peak1Min object.
+     *
+     * @param parentSense The parent RainCounterI2C providing the result
+     * values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "RainCounterI2CPeak1".
+     */
+    explicit RainCounterI2C_Peak1Min(
+        RainCounterI2C* parentSense, const char* uuid = "",
+        const char* varCode = BUCKET_PEAK1_DEFAULT_CODE)
+        : Variable(parentSense, (const uint8_t)BUCKET_PEAK1_VAR_NUM,
+                   (uint8_t)BUCKET_PEAK1_RESOLUTION, BUCKET_PEAK1_VAR_NAME,
+                   BUCKET_PEAK1_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Construct a new RainCounterI2C_Peak1Min object.
+     *
+     * @note This must be tied with a parent RainCounterI2C before it can be
+     * used.
+     */
+    RainCounterI2C_Peak1Min()
+        : Variable((const uint8_t)BUCKET_PEAK1_VAR_NUM,
+                   (uint8_t)BUCKET_PEAK1_RESOLUTION, BUCKET_PEAK1_VAR_NAME,
+                   BUCKET_PEAK1_UNIT_NAME, BUCKET_PEAK1_DEFAULT_CODE) {}
+    /**
+     * @brief Destroy the RainCounterI2C_Peak1Min object - no action needed.
+     */
+    ~RainCounterI2C_Peak1Min() {}
+};
+
+/**
+ * @brief The Variable sub-class used for the
+ * [peak 5-minute intensity output](@ref sensor_i2c_rain_peak5) from an
+ * [Adafruit Trinket based I2C tipping bucket counter](@ref sensor_i2c_rain)
+ * - gives the most rain in any five minutes since the last reading, per hour.
+ *
+ * @ingroup sensor_i2c_rain
+ */
+class RainCounterI2C_Peak5Min : public Variable {
+ public:
+    /**
+     * @brief Construct a new RainCounterI2C_Peak5Min object.
+     *
+     * @param parentSense The parent RainCounterI2C providing the result
+     * values.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     * @param varCode A short code to help identify the variable in files;
+     * optional with a default value of "RainCounterI2CPeak5".
+     */
+    explicit RainCounterI2C_Peak5Min(
+        RainCounterI2C* parentSense, const char* uuid = "",
+        const char* varCode = BUCKET_PEAK5_DEFAULT_CODE)
+        : Variable(parentSense, (const uint8_t)BUCKET_PEAK5_VAR_NUM,
+                   (uint8_t)BUCKET_PEAK5_RESOLUTION, BUCKET_PEAK5_VAR_NAME,
+                   BUCKET_PEAK5_UNIT_NAME, varCode, uuid) {}
+    /**
+     * @brief Construct a new RainCounterI2C_Peak5Min object.
+     *
+     * @note This must be tied with a parent RainCounterI2C before it can be
+     * used.
+     */
+    RainCounterI2C_Peak5Min()
+        : Variable((const uint8_t)BUCKET_PEAK5_VAR_NUM,
+                   (uint8_t)BUCKET_PEAK5_RESOLUTION, BUCKET_PEAK5_VAR_NAME,
+                   BUCKET_PEAK5_UNIT_NAME, BUCKET_PEAK5_DEFAULT_CODE) {}
+    /**
+     * @brief Destroy the RainCounterI2C_Peak5Min object - no action needed.
+     */
+    ~RainCounterI2C_Peak5Min() {}
+};
+#endif
 /**@}*/
 #endif  // SRC_SENSORS_RAINCOUNTERI2C_H_
@@ -0,0 +1,83 @@
+/**
+ * @file ReplaySensor.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the ReplaySensor class.
+ */
+
+#include "ReplaySensor.h"
+
+
+ReplaySensor::ReplaySensor(const char* sensorName, uint8_t numValues,
+                           const replayStep* steps, uint16_t stepCount,
+                           const float* values, int8_t powerPin,
+                           uint8_t measurementsToAverage)
+    : Sensor(sensorName, numValues, 0, 0, 0, powerPin, -1,
+             measurementsToAverage),
+      _steps(steps),
+      _stepCount(stepCount),
+      _values(values) {
+    applyStep();
+}
+ReplaySensor::~ReplaySensor() {}
+
+
+String ReplaySensor::getSensorLocation(void) {
+    String sensorLocation = F("Replay_Step");
+    sensorLocation += String(_step);
+    return sensorLocation;
+}
+
+
+void ReplaySensor::restartTrace(void) {
+    _step = 0;
+    applyStep();
+}
+
+
+uint16_t ReplaySensor::getStep(void) {
+    return _step;
+}
+
+
+void ReplaySensor::applyStep(void) {
+    if (_steps == nullptr || _stepCount == 0) { return; }
+    _warmUpTime_ms        = _steps[_step].warmUp_ms;
+    _stabilizationTime_ms = _steps[_step].stabilization_ms;
+    _measurementTime_ms   = _steps[_step].measurement_ms;
+#ifdef MS_SENSOR_LOCATION_CACHE
+    // The location is the step
+    clearSensorLocation();
+#endif
+}
+
+
+bool ReplaySensor::addSingleMeasurementResult(void) {
+    bool success = false;
+
+    // Check a measurement was *successfully* started (status bit 6 set)
+    // Only go on to get a result if it was
+    if (bitRead(_sensorStatus, 6) && _stepCount > 0) {
+        success = _steps[_step].success;
+        MS_DBG(getSensorNameAndLocation(), F("is replaying"),
+               success ? F("a result") : F("a failure"));
+        const float* stepValues = _values + _step * _numReturnedValues;
+        for (uint8_t i = 0; i < _numReturnedValues; i++) {
+            verifyAndAddMeasurementResult(i, success ? stepValues[i] : -9999);
+        }
+        // The last step is followed by the first
+        _step = (_step + 1) % _stepCount;
+        applyStep();
+    } else {
+        MS_DBG(getSensorNameAndLocation(), F("is not currently measuring!"));
+    }
+
+    // Unset the time stamp for the beginning of this measurement
+    _millisMeasurementRequested = 0;
+    // Unset the status bits for a measurement request (bits 5 & 6)
+    _sensorStatus &= 0b10011111;
+
+    return success;
+}
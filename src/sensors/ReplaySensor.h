@@ -0,0 +1,203 @@
+/**
+ * @file ReplaySensor.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the ReplaySensor sensor subclass and the ReplaySensor_Value
+ * variable subclass.
+ *
+ * These play back the timing and values recorded from a real sensor, for
+ * testing the update scheduling and the publishers without the sensors.
+ */
+/* clang-format off */
+/**
+ * @defgroup sensor_replay Replayed Sensor Traces
+ * Classes for playing back recorded sensor traces.
+ *
+ * @ingroup the_sensors
+ *
+ * @tableofcontents
+ * @m_footernavigation
+ *
+ * @section sensor_replay_intro Introduction
+ *
+ * A ReplaySensor stands in for a real sensor by playing back a trace: for each
+ * measurement, the warm-up, stabilization, and measurement times the real
+ * sensor took, whether the measurement succeeded, and the values it gave.
+ * The times go into the same fields every other sensor sets from its
+ * datasheet, so the variable array, the deadline scheduler, the staggered
+ * power ups, and the profiler all treat it just like the sensor it replaces.
+ * Nothing is talked to, so a board with only a clock and SD card can run the
+ * logging cycle of a whole station - like 14 SDI-12 and Modbus sensors - and
+ * the cycle times and charges from the LoggerProfiler can be compared from
+ * one build to the next.
+ *
+ * The trace is two tables: the timing of each step and, for each step, the
+ * values in the order of the sensor's variables.  After the last step the
+ * trace starts again from the first.  The times of a real sensor can be read
+ * from its debugging output (MS_SENSORBASE_DEBUG) and the values from its data
+ * file.
+ *
+ * @note The tables are read from RAM, so on AVR boards keep long traces on
+ * a board with more memory.
+ *
+ * @section sensor_replay_examples Example Code
+ *
+ * @code{.cpp}
+ * const replayStep ctdSteps[] = {
+ *     {500, 0, 1200, true},
+ *     {500, 0, 1350, true},
+ *     {500, 0, 3000, false},  // timed out
+ * };
+ * const float ctdValues[] = {
+ *     12.4, 0.312, 18.9,  // depth, temperature, conductivity
+ *     12.5, 0.311, 19.0,
+ *     -9999, -9999, -9999,
+ * };
+ * ReplaySensor ctd("CTD", 3, ctdSteps, 3, ctdValues, sensorPowerPin);
+ * Variable* ctdDepth = new ReplaySensor_Value(&ctd, 0, 1, "waterDepth",
+ *                                             "millimeter", "CTDdepth");
+ * @endcode
+ */
+/* clang-format on */
+
+// Header Guards
+#ifndef SRC_SENSORS_REPLAYSENSOR_H_
+#define SRC_SENSORS_REPLAYSENSOR_H_
+
+// Debugging Statement
+// #define MS_REPLAYSENSOR_DEBUG
+
+#ifdef MS_REPLAYSENSOR_DEBUG
+#define MS_DEBUGGING_STD "ReplaySensor"
+#endif
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include "VariableBase.h"
+#include "SensorBase.h"
+
+/**
+ * @brief The timing and outcome of one measurement in a sensor trace.
+ */
+typedef struct replayStep {
+    uint16_t warmUp_ms;         ///< The warm-up time before this measurement
+    uint16_t stabilization_ms;  ///< The stabilization time
+    uint16_t measurement_ms;    ///< The time the measurement took
+    bool     success;  ///< False if the measurement failed; values are -9999
+} replayStep;
+
+
+/* clang-format off */
+/**
+ * @brief The Sensor sub-class for
+ * [playing back recorded sensor traces](@ref sensor_replay).
+ *
+ * @ingroup sensor_replay
+ */
+/* clang-format on */
+class ReplaySensor : public Sensor {
+ public:
+    /**
+     * @brief Construct a new Replay Sensor object
+     *
+     * @param sensorName The name of the sensor being replayed
+     * @param numValues The number of values the sensor gives; at most
+     * #MAX_NUMBER_VARS
+     * @param steps The timing of each measurement of the trace
+     * @param stepCount The number of steps in the trace
+     * @param values The values of each step of the trace, numValues for each
+     * step one after another
+     * @param powerPin A pin to switch as if it powered the sensor, so the
+     * warm-up is replayed every cycle.  Use -1 to replay the warm-up only
+     * once, like a continuously powered sensor.
+     * @param measurementsToAverage The number of measurements to take and
+     * average before giving a "final" result from the sensor; optional with a
+     * default value of 1.
+     */
+    ReplaySensor(const char* sensorName, uint8_t numValues,
+                 const replayStep* steps, uint16_t stepCount,
+                 const float* values, int8_t powerPin = -1,
+                 uint8_t measurementsToAverage = 1);
+    /**
+     * @brief Destroy the Replay Sensor object
+     */
+    ~ReplaySensor();
+
+    /**
+     * @copydoc Sensor::getSensorLocation()
+     */
+    String getSensorLocation(void) override;
+
+    /**
+     * @copydoc Sensor::addSingleMeasurementResult()
+     *
+     * This gives the values of the current step of the trace and moves on to
+     * the next step.
+     */
+    bool addSingleMeasurementResult(void) override;
+
+    /**
+     * @brief Go back to the first step of the trace.
+     */
+    void restartTrace(void);
+    /**
+     * @brief Get the step of the trace that the next measurement replays.
+     *
+     * @return **uint16_t** The position of the step in the trace.
+     */
+    uint16_t getStep(void);
+
+ private:
+    /**
+     * @brief Set the sensor timing to that of the current step.
+     */
+    void applyStep(void);
+
+    const replayStep* _steps;
+    uint16_t          _stepCount;
+    const float*      _values;
+    uint16_t          _step = 0;
+};
+
+
+/* clang-format off */
+/**
+ * @brief The Variable sub-class used for any of the values of a
+ * [replayed sensor trace](@ref sensor_replay).
+ *
+ * @ingroup sensor_replay
+ */
+/* clang-format on */
+class ReplaySensor_Value : public Variable {
+ public:
+    /**
+     * @brief Construct a new ReplaySensor_Value object.
+     *
+     * @param parentSense The parent ReplaySensor providing the result
+     * values.
+     * @param sensorVarNum The position of this value in each step of the
+     * trace.
+     * @param decimalResolution The resolution to report the value with.
+     * @param varName The name of the variable, from the ODM2 controlled
+     * vocabulary.
+     * @param varUnit The unit of the variable, from the ODM2 controlled
+     * vocabulary.
+     * @param varCode A short code to help identify the variable in files.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable; optional with the default value of an empty string.
+     */
+    ReplaySensor_Value(ReplaySensor* parentSense, uint8_t sensorVarNum,
+                       uint8_t decimalResolution, const char* varName,
+                       const char* varUnit, const char* varCode,
+                       const char* uuid = "")
+        : Variable(parentSense, sensorVarNum, decimalResolution, varName,
+                   varUnit, varCode, uuid) {}
+    /**
+     * @brief Destroy the ReplaySensor_Value object - no action needed.
+     */
+    ~ReplaySensor_Value() {}
+};
+#endif  // SRC_SENSORS_REPLAYSENSOR_H_
@@ -18,6 +18,9 @@
 #include "ModSensorInterrupts.h"
 
 #include "SDI12Sensors.h"
+#ifdef MS_DISCOVERY_CACHE
+#include "DiscoveryCache.h"
+#endif
 
 
 // The constructor - need the number of measurements the sensor will return,
@@ -33,9 +36,15 @@ SDI12Sensors::SDI12Sensors(char SDI12address, int8_t powerPin, int8_t dataPin,
     : Sensor(sensorName, totalReturnedValues, warmUpTime_ms,
              stabilizationTime_ms, measurementTime_ms, powerPin, dataPin,
              measurementsToAverage, incCalcValues),
-      _SDI12Internal(dataPin),
+      _SDI12Internal(getSharedBus(dataPin)),
       _SDI12address(SDI12address),
-      _extraWakeTime(extraWakeTime) {}
+      _extraWakeTime(extraWakeTime),
+      _nominalMeasurementTime_ms(measurementTime_ms) {
+    setBus(SENSOR_BUS_SDI12, static_cast<uintptr_t>(dataPin));
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    registerOnBus();
+#endif
+}
 SDI12Sensors::SDI12Sensors(char* SDI12address, int8_t powerPin, int8_t dataPin,
                            uint8_t       measurementsToAverage,
                            const char*   sensorName,
@@ -47,9 +56,15 @@ SDI12Sensors::SDI12Sensors(char* SDI12address, int8_t powerPin, int8_t dataPin,
     : Sensor(sensorName, totalReturnedValues, warmUpTime_ms,
              stabilizationTime_ms, measurementTime_ms, powerPin, dataPin,
              measurementsToAverage, incCalcValues),
-      _SDI12Internal(dataPin),
+      _SDI12Internal(getSharedBus(dataPin)),
       _SDI12address(*SDI12address),
-      _extraWakeTime(extraWakeTime) {}
+      _extraWakeTime(extraWakeTime),
+      _nominalMeasurementTime_ms(measurementTime_ms) {
+    setBus(SENSOR_BUS_SDI12, static_cast<uintptr_t>(dataPin));
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    registerOnBus();
+#endif
+}
 SDI12Sensors::SDI12Sensors(int SDI12address, int8_t powerPin, int8_t dataPin,
                            uint8_t       measurementsToAverage,
                            const char*   sensorName,
@@ -61,11 +76,66 @@ SDI12Sensors::SDI12Sensors(int SDI12address, int8_t powerPin, int8_t dataPin,
     : Sensor(sensorName, totalReturnedValues, warmUpTime_ms,
              stabilizationTime_ms, measurementTime_ms, powerPin, dataPin,
              measurementsToAverage, incCalcValues),
-      _SDI12Internal(dataPin),
+      _SDI12Internal(getSharedBus(dataPin)),
       _SDI12address(static_cast<char>(SDI12address + '0')),
-      _extraWakeTime(extraWakeTime) {}
+      _extraWakeTime(extraWakeTime),
+      _nominalMeasurementTime_ms(measurementTime_ms) {
+    setBus(SENSOR_BUS_SDI12, static_cast<uintptr_t>(dataPin));
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    registerOnBus();
+#endif
+}
 // Destructor
-SDI12Sensors::~SDI12Sensors() {}
+SDI12Sensors::~SDI12Sensors() {
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    // Take this sensor out of the list of sensors on the bus
+    if (_firstOnBus == this) {
+        _firstOnBus = _nextOnBus;
+    } else {
+        for (SDI12Sensors* sib = _firstOnBus; sib != nullptr;
+             sib               = sib->_nextOnBus) {
+            if (sib->_nextOnBus == this) {
+                sib->_nextOnBus = _nextOnBus;
+                break;
+            }
+        }
+    }
+#endif
+}
+
+
+SDI12Sensors::sharedSDI12Bus* SDI12Sensors::_firstSharedBus = nullptr;
+
+// Find the SDI-12 object for the data pin, or make one if this is the first
+// sensor on the pin
+SDI12& SDI12Sensors::getSharedBus(int8_t dataPin) {
+    for (sharedSDI12Bus* shared = _firstSharedBus; shared != nullptr;
+         shared                 = shared->next) {
+        if (shared->bus.getDataPin() == dataPin) return shared->bus;
+    }
+    sharedSDI12Bus* shared = new sharedSDI12Bus(dataPin);
+    shared->next           = _firstSharedBus;
+    _firstSharedBus        = shared;
+    return shared->bus;
+}
+
+
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+SDI12Sensors* SDI12Sensors::_firstOnBus         = nullptr;
+bool          SDI12Sensors::_busStartInProgress = false;
+
+// Add this sensor to the front of the list of all SDI-12 sensors
+void SDI12Sensors::registerOnBus(void) {
+    _nextOnBus  = _firstOnBus;
+    _firstOnBus = this;
+}
+
+
+bool SDI12Sensors::wake(void) {
+    _startsLeft = getNumberMeasurementsToAverage();
+    return Sensor::wake();
+}
+#endif
 
 
 bool SDI12Sensors::setup(void) {
@@ -93,7 +163,34 @@ bool SDI12Sensors::setup(void) {
     enableInterrupt(_dataPin, SDI12::handleInterrupt, CHANGE);
 #endif
 
+#ifdef MS_DISCOVERY_CACHE
+    // Skip asking who the sensor is if it told us before
+    char    info[35];
+    uint8_t infoLength = DiscoveryCache::load(
+        DISCOVERY_SDI12_INFO, _dataPin, _SDI12address,
+        reinterpret_cast<uint8_t*>(info), sizeof(info) - 1);
+    if (infoLength > 0) {
+        info[infoLength] = '\0';
+        String cachedInfo(info);
+#ifdef MS_SDI12_HIGH_VOLUME
+        _sdi12Version =
+            static_cast<uint8_t>(cachedInfo.substring(0, 2).toInt());
+#endif
+        _sensorVendor = cachedInfo.substring(2, 10);
+        _sensorVendor.trim();
+        _sensorModel = cachedInfo.substring(10, 16);
+        _sensorModel.trim();
+        _sensorVersion = cachedInfo.substring(16, 19);
+        _sensorVersion.trim();
+        _sensorSerialNumber = cachedInfo.substring(19);
+        _sensorSerialNumber.trim();
+        MS_DBG(F("  Using the cached info of"), _sensorVendor, _sensorModel);
+    } else {
+        retVal &= getSensorInfo();
+    }
+#else
     retVal &= getSensorInfo();
+#endif
 
     // Empty the SDI-12 buffer
     _SDI12Internal.clearBuffer();
@@ -161,6 +258,36 @@ bool SDI12Sensors::requestSensorAcknowledgement(void) {
 }
 
 
+// A single acknowledgement attempt, used to check if the sensor is already
+// warmed up.  This doesn't retry like requestSensorAcknowledgement() does,
+// because it will be called again if the sensor isn't ready yet.
+bool SDI12Sensors::probeWarmedUp(void) {
+    // Check if this the currently active SDI-12 Object
+    bool wasActive = _SDI12Internal.isActive();
+    // If it wasn't active, activate it now.
+    if (!wasActive) _SDI12Internal.begin();
+    // Empty the buffer
+    _SDI12Internal.clearBuffer();
+
+    String myCommand = "";
+    myCommand += _SDI12address;
+    myCommand += "!";  // sends 'acknowledge active' command [address][!]
+    _SDI12Internal.sendCommand(myCommand, _extraWakeTime);
+    MS_DEEP_DBG(F("    >>>"), myCommand);
+    delay(30);
+
+    String sdiResponse = _SDI12Internal.readStringUntil('\n');
+    sdiResponse.trim();
+    MS_DEEP_DBG(F("    <<<"), sdiResponse);
+    _SDI12Internal.clearBuffer();
+
+    // De-activate the SDI-12 Object
+    if (!wasActive) _SDI12Internal.end();
+
+    return sdiResponse.startsWith(String(_SDI12address));
+}
+
+
 // A helper function to run the "sensor info" SDI12 command
 bool SDI12Sensors::getSensorInfo(void) {
     // Check if this the currently active SDI-12 Object
@@ -200,6 +327,9 @@ bool SDI12Sensors::getSensorInfo(void) {
         String sdi12Address = sdiResponse.substring(0, 1);
         MS_DBG(F("   SDI12 Address:"), sdi12Address);
         float sdi12Version = sdiResponse.substring(1, 3).toFloat();
+#ifdef MS_SDI12_HIGH_VOLUME
+        _sdi12Version = static_cast<uint8_t>(sdi12Version);
+#endif
         sdi12Version /= 10;
         MS_DBG(F("   SDI12 Version:"), sdi12Version);
         _sensorVendor = sdiResponse.substring(3, 11);
@@ -214,6 +344,13 @@ bool SDI12Sensors::getSensorInfo(void) {
         _sensorSerialNumber = sdiResponse.substring(20);
         _sensorSerialNumber.trim();
         MS_DBG(F("   Sensor Serial Number:"), _sensorSerialNumber);
+#ifdef MS_DISCOVERY_CACHE
+        // Keep everything after the address, starting with the SDI-12 version
+        String info = sdiResponse.substring(1);
+        DiscoveryCache::save(DISCOVERY_SDI12_INFO, _dataPin, _SDI12address,
+                             reinterpret_cast<const uint8_t*>(info.c_str()),
+                             info.length());
+#endif
         // Suppress the DDI serial start-up string on meter sensors.  This
         // shouldn't be sent if the SDI-12 address is non-zero, but we'll
         // explicitly suppress it just in case.
@@ -260,6 +397,28 @@ String SDI12Sensors::getSensorSerialNumber(void) {
 }
 
 
+// Continuous measurements are read with no measurement time at all
+void SDI12Sensors::setContinuousMeasurement(bool continuous) {
+    _continuousMeasurement = continuous;
+    _measurementTime_ms    = continuous ? 0 : _nominalMeasurementTime_ms;
+}
+bool SDI12Sensors::getContinuousMeasurement(void) {
+    return _continuousMeasurement;
+}
+
+
+#ifdef MS_SDI12_HIGH_VOLUME
+void SDI12Sensors::setHighVolume(sdi12HighVolume highVolume) {
+    _highVolume = highVolume;
+}
+sdi12HighVolume SDI12Sensors::getHighVolume(void) {
+    if (_highVolume != SDI12_HIGH_VOLUME_AUTO) return _highVolume;
+    return _sdi12Version >= 14 ? SDI12_HIGH_VOLUME_BINARY
+                               : SDI12_HIGH_VOLUME_OFF;
+}
+#endif
+
+
 // The sensor installation location on the Mayfly
 String SDI12Sensors::getSensorLocation(void) {
     String sensorLocation = F("SDI12-");
@@ -268,17 +427,27 @@ String SDI12Sensors::getSensorLocation(void) {
 }
 
 // Sending the command to start a measurement
-int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
+int16_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
     String startCommand;
     String sdiResponse;
 
     // Try up to 3 times to start a measurement
     uint8_t numVariables = 0;
     uint8_t ntries       = 0;
-    int8_t  wait         = -1;  // NOTE: The wait time can be 0!
+    int16_t wait         = -1;  // NOTE: The wait time can be 0!
+#ifdef MS_SDI12_HIGH_VOLUME
+    sdi12HighVolume highVolume = getHighVolume();
+#endif
     while (numVariables != (_numReturnedValues - _incCalcValues) &&
            ntries < 5) {
+#ifdef MS_SDI12_HIGH_VOLUME
+        if (highVolume != SDI12_HIGH_VOLUME_OFF) {
+            MS_DBG(F("  Beginning high volume measurement on"),
+                   getSensorNameAndLocation());
+        } else if (isConcurrent) {
+#else
         if (isConcurrent) {
+#endif
             MS_DBG(F("  Beginning concurrent measurement on"),
                    getSensorNameAndLocation());
         } else {
@@ -287,13 +456,31 @@ int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
         }
         startCommand = "";
         startCommand += _SDI12address;
+#ifdef MS_SDI12_HIGH_VOLUME
+        if (highVolume == SDI12_HIGH_VOLUME_BINARY) {
+            startCommand += "HB";  // Start high volume binary measurement -
+                                   // format [address]['HB'][!]
+        } else if (highVolume == SDI12_HIGH_VOLUME_ASCII) {
+            startCommand += "HA";  // Start high volume ASCII measurement -
+                                   // format [address]['HA'][!]
+        } else if (isConcurrent) {
+#else
         if (isConcurrent) {
-            startCommand += "C!";  // Start concurrent measurement - format
-                                   // [address]['C'][!]
+#endif
+            startCommand += "C";  // Start concurrent measurement - format
+                                  // [address]['C'][!]
         } else {
-            startCommand += "M!";  // Start standard measurement - format
+            startCommand += "M";  // Start standard measurement - format
             // [address]['M'][!]
         }
+#ifdef MS_SDI12_CRC
+#ifdef MS_SDI12_HIGH_VOLUME
+        // The high volume data always has a CRC
+        if (highVolume == SDI12_HIGH_VOLUME_OFF)
+#endif
+            startCommand += "C";  // Ask for a CRC on the data
+#endif
+        startCommand += "!";
         _SDI12Internal.clearBuffer();
         _SDI12Internal.sendCommand(startCommand, _extraWakeTime);
         delay(30);  // It just needs this little delay
@@ -301,7 +488,7 @@ int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
 
         // wait for acknowlegement with format
         // [address][ttt (3 char, seconds)][number of values to be returned,
-        // 0-9]<CR><LF>
+        // 0-9, or 000-999 for high volume]<CR><LF>
         sdiResponse = _SDI12Internal.readStringUntil('\n');
         sdiResponse.trim();
         _SDI12Internal.clearBuffer();
@@ -309,7 +496,7 @@ int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
 
         // find out how long we have to wait (in seconds).
         if (sdiResponse.length() > 3) {
-            wait = static_cast<uint8_t>(sdiResponse.substring(1, 4).toInt());
+            wait = static_cast<int16_t>(sdiResponse.substring(1, 4).toInt());
             numVariables =
                 static_cast<uint8_t>(sdiResponse.substring(4).toInt());
         }
@@ -326,9 +513,18 @@ int8_t SDI12Sensors::startSDI12Measurement(bool isConcurrent) {
                  (_numReturnedValues - _incCalcValues), F("measurements!!"));
     }
 
-    // Return how long we're expecting to wait for a measurement
+    // Wait the time the sensor asked for if that's shorter than usual
     // NOTE:  The sensor generally returns a value rounded up to the next
-    // second.
+    // second, so it's only ever used when it's shorter.
+    _measurementTime_ms = _nominalMeasurementTime_ms;
+    if (wait >= 0 &&
+        static_cast<uint32_t>(wait) * 1000 < _nominalMeasurementTime_ms) {
+        _measurementTime_ms = static_cast<uint32_t>(wait) * 1000;
+        MS_DBG(F("  Sensor expects to finish in"), _measurementTime_ms,
+               F("ms instead of"), _nominalMeasurementTime_ms, F("ms"));
+    }
+
+    // Return how long we're expecting to wait for a measurement
     return wait;
 }
 
@@ -341,6 +537,12 @@ bool SDI12Sensors::startSingleMeasurement(void) {
     // reason to go on.
     if (!Sensor::startSingleMeasurement()) return false;
 
+    // Continuous measurements are read right away, so there's nothing to start
+    if (_continuousMeasurement) {
+        MS_DBG(F("    Reading continuous measurement."));
+        return true;
+    }
+
     // Check if this the currently active SDI-12 Object
     bool wasActive = _SDI12Internal.isActive();
     // If it wasn't active, activate it now.
@@ -356,13 +558,21 @@ bool SDI12Sensors::startSingleMeasurement(void) {
         return false;
     }
 
+#ifdef MS_SDI12_SERVICE_REQUEST
+    // send the commands to start a standard measurement and, unless the data
+    // is ready right away, keep listening for the sensor's service request
+    int16_t wait         = startSDI12Measurement(false);
+    _listeningForService = wait > 0;
+    if (!wasActive && !_listeningForService) _SDI12Internal.end();
+#else
     // send the commands to start the measurement; true = concurrent
     // the returned wait time should always be non-zero
-    int8_t wait = startSDI12Measurement(true);
+    int16_t wait = startSDI12Measurement(true);
 
     // De-activate the SDI-12 Object
     // Use end() instead of just forceHold to un-set the timers
     if (!wasActive) _SDI12Internal.end();
+#endif
 
     // Set the times we've activated the sensor and asked for a measurement
     if (wait >= 0) {
@@ -371,6 +581,13 @@ bool SDI12Sensors::startSingleMeasurement(void) {
         _millisMeasurementRequested = millis();
         // Set the status bit for measurement start success (bit 6)
         _sensorStatus |= 0b01000000;
+#ifdef MS_SDI12_BUS_CONCURRENT
+        if (_startsLeft > 0) _startsLeft--;
+#endif
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_SERVICE_REQUEST)
+        // Start everything else on the bus that's ready to go
+        if (!_busStartInProgress) startConcurrentOnBus();
+#endif
         return true;
     } else {
         MS_DBG(getSensorNameAndLocation(),
@@ -380,101 +597,364 @@ bool SDI12Sensors::startSingleMeasurement(void) {
         return false;
     }
 }
+
+
+#ifdef MS_SDI12_SERVICE_REQUEST
+// Check for the service request before falling back to the measurement time
+bool SDI12Sensors::isMeasurementComplete(bool debug) {
+    // Step 0 is waiting for the service request; step 1 is collecting data
+    if (_listeningForService && _measurementStep == 0 &&
+        _SDI12Internal.isActive() && _SDI12Internal.available()) {
+        // The service request is just the address followed by <CR><LF>
+        String sdiResponse = _SDI12Internal.readStringUntil('\n');
+        sdiResponse.trim();
+        MS_DEEP_DBG(F("    <<<"), sdiResponse);
+        if (sdiResponse.length() > 0 && sdiResponse[0] == _SDI12address) {
+            MS_DBG(getSensorNameAndLocation(), F("sent a service request"),
+                   millis() - _millisMeasurementRequested,
+                   F("ms after starting its measurement"));
+            // The data can be collected right away
+            nextMeasurementStep(0);
+        }
+    }
+    return Sensor::isMeasurementComplete(debug);
+}
+
+
+bool SDI12Sensors::isHoldingBus(void) {
+    return _listeningForService && _measurementStep == 0;
+}
 #endif
 
-bool SDI12Sensors::getResults(void) {
+
+#ifdef MS_SDI12_BUS_CONCURRENT
+// Start concurrent measurements on all of the other sensors on this data pin
+// that are ready for one
+void SDI12Sensors::startConcurrentOnBus(void) {
+    _busStartInProgress = true;
+    for (SDI12Sensors* sib = _firstOnBus; sib != nullptr;
+         sib               = sib->_nextOnBus) {
+        if (sib == this || sib->_dataPin != _dataPin) continue;
+        // Skip sensors that aren't awake (bit 4), have already had a
+        // measurement requested (bit 5), or have started all of theirs
+        if (bitRead(sib->_sensorStatus, 4) == 0 ||
+            bitRead(sib->_sensorStatus, 5) == 1 || sib->_startsLeft == 0) {
+            continue;
+        }
+        if (!sib->isStable()) continue;
+        MS_DBG(F("  Also starting concurrent measurement on"),
+               sib->getSensorNameAndLocation(), F("sharing pin"), _dataPin);
+        sib->startSingleMeasurement();
+    }
+    _busStartInProgress = false;
+}
+#endif
+#endif
+
+#if defined(MS_SDI12_CRC) || defined(MS_SDI12_HIGH_VOLUME)
+// The CRC-16 of section 4.4.12 of the SDI-12 specification
+uint16_t SDI12Sensors::addToCRC(uint16_t crc, const uint8_t* data,
+                                uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+
+// An ASCII response has its CRC sent as three characters
+bool SDI12Sensors::checkAndRemoveCRC(String& response) {
+    if (response.length() < 4) return false;
+    uint16_t dataLength = response.length() - 3;
+    uint16_t crc        = addToCRC(
+        0, reinterpret_cast<const uint8_t*>(response.c_str()), dataLength);
+    bool match =
+        response[dataLength] == static_cast<char>(0x40 | (crc >> 12)) &&
+        response[dataLength + 1] ==
+            static_cast<char>(0x40 | ((crc >> 6) & 0x3F)) &&
+        response[dataLength + 2] == static_cast<char>(0x40 | (crc & 0x3F));
+    response.remove(dataLength);
+    return match;
+}
+#endif
+
+
+uint8_t SDI12Sensors::getDataValues(uint16_t cmdNumber, float* values,
+                                    uint8_t maxValues) {
     // Check if this the currently active SDI-12 Object
     bool wasActive = _SDI12Internal.isActive();
     // If it wasn't active, activate it now.
     // Use begin() instead of just setActive() to ensure timer is set
     // correctly.
     if (!wasActive) _SDI12Internal.begin();
-    // Empty the buffer
-    _SDI12Internal.clearBuffer();
 
-    MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
-    uint8_t resultsReceived = 0;
-    uint8_t cmd_number      = 0;
-
-    // When requesting data, the sensor sends back up to ~80 characters at a
-    // time to each data request.  If it needs to return more results than can
-    // fit in the first data request (D0), we need to make additional requests
-    // (D1-9).  Since this is a parent to all sensors, we're going to keep
-    // requesting data until we either get as many results as we expect or no
-    // more data is returned.
-    while (resultsReceived < (_numReturnedValues - _incCalcValues) &&
-           cmd_number <= 9) {
-        bool gotResults = false;
-        // Assemble the command based on how many commands we've already sent,
-        // starting with D0 and ending with D9
-        // SDI-12 command to get data [address][D][dataOption][!]
-        String getDataCommand = "";
-        getDataCommand += _SDI12address;
-        getDataCommand += "D";
-        getDataCommand += cmd_number;
-        getDataCommand += "!";
+    // SDI-12 command to get data [address][D][dataOption][!] or continuous
+    // measurements [address][R][dataOption][!]
+    String getDataCommand = "";
+    getDataCommand += _SDI12address;
+    getDataCommand += _continuousMeasurement ? "R" : "D";
+#ifdef MS_SDI12_CRC
+    if (_continuousMeasurement) getDataCommand += "C";
+#endif
+    getDataCommand += cmdNumber;
+    getDataCommand += "!";
+
+    String  sdiResponse;
+    uint8_t ntries = 0;
+#ifdef MS_SDI12_CRC
+    bool checkCRC = true;
+#elif defined(MS_SDI12_HIGH_VOLUME)
+    // The high volume ASCII data always has a CRC
+    bool checkCRC = !_continuousMeasurement &&
+        getHighVolume() == SDI12_HIGH_VOLUME_ASCII;
+#else
+    bool checkCRC = false;  // There's no CRC to check
+#endif
+    bool crcMatched = !checkCRC;
+    do {
+        // Empty the buffer
+        _SDI12Internal.clearBuffer();
         _SDI12Internal.sendCommand(getDataCommand, _extraWakeTime);
         delay(30);  // It just needs this little delay
         MS_DEEP_DBG(F("    >>>"), getDataCommand);
 
-        // Wait for the first few charaters to arrive.  The response from a data
-        // request should always have more than three characters
+        // Wait for the first few charaters to arrive.  The response from a
+        // data request should always have more than three characters
         uint32_t start = millis();
         while (_SDI12Internal.available() < 3 && (millis() - start) < 1500) {
             // wait
         }
-        // read the returned address to remove it from the buffer
-        auto returnedAddress = static_cast<char>(_SDI12Internal.read());
-        // print out a warning if the address doesn't match up
-        if (returnedAddress != _SDI12address) {
-            MS_DBG(F("Warning, expecting data from"), _SDI12address,
-                   F("but got data from"), returnedAddress);
+        sdiResponse = _SDI12Internal.readStringUntil('\n');
+        sdiResponse.trim();
+        MS_DEEP_DBG(F("    <<<"), sdiResponse);
+        ntries++;
+#if defined(MS_SDI12_CRC) || defined(MS_SDI12_HIGH_VOLUME)
+        if (checkCRC) {
+            crcMatched = checkAndRemoveCRC(sdiResponse);
+            if (!crcMatched) {
+                MS_DBG(F("  CRC of the"), getDataCommand,
+                       F("response doesn't match!"));
+            }
         }
-        // Start printing out the returned data
-        MS_DEEP_DBG(F("    <<<"), returnedAddress);
-
-        // While there is any data left in the buffer
-        while (_SDI12Internal.available() && (millis() - start) < 3000) {
-            // First peek to see if the next character in the buffer is a number
-            int c = _SDI12Internal.peek();
-            // if there's a number, a decimal, or a negative sign next in the
-            // buffer, start reading it as a float.
-            if (c == '-' || (c >= '0' && c <= '9') || c == '.') {
-                // Read the float without skipping any in-valid characters.
-                // We don't want to skip anything because we want to be able to
-                // debug and see exactly which characters the sensor sent over
-                // if they weren't numbers.
-                // Reading the numbers as a float will remove them from the
-                // buffer.
-                float result = _SDI12Internal.parseFloat(SKIP_NONE);
-                // The SDI-12 library should return -9999 on timeout
-                if (result == -9999 || isnan(result)) result = -9999;
-                // Print out what we got
-                MS_DBG(F("    <<<"), String(result, 10));
-                // Verify that the number is valid and add it to the result
-                // array. After each result is read, tick up the number of
-                // results received so that the next one goes in the next spot
-                // in the variable array.
-                verifyAndAddMeasurementResult(resultsReceived, result);
-                if (result != -9999) {
-                    gotResults = true;
-                    resultsReceived++;
-                }
-                // if the next spot in the buffer isn't a number, we don't want
-                // to try and parse it, but we do want to print it out to the
-                // debugging port
-            } else {
-// if we're debugging print out the non-numeric character
-#ifdef MS_SDI12SENSORS_DEBUG_DEEP
-                MS_DEEP_DBG(F("    <<<"),
-                            static_cast<char>(_SDI12Internal.read()));
+#endif
+    } while (!crcMatched && ntries <= MS_SDI12_CRC_RETRIES);
+
+    // Empty the buffer again
+    _SDI12Internal.clearBuffer();
+
+    // De-activate the SDI-12 Object
+    // Use end() instead of just forceHold to un-set the timers
+    if (!wasActive) _SDI12Internal.end();
+
+    // Don't use anything from a response that's still corrupted
+    if (!crcMatched) return 0;
+
+    // print out a warning if the address doesn't match up
+    if (sdiResponse.length() == 0) return 0;
+    if (sdiResponse[0] != _SDI12address) {
+        MS_DBG(F("Warning, expecting data from"), _SDI12address,
+               F("but got data from"), sdiResponse[0]);
+    }
+
+    // Each value starts with its sign, though some sensors leave out the +
+    uint8_t  nValues = 0;
+    uint16_t i       = 1;
+    while (i < sdiResponse.length() && nValues < maxValues) {
+        char c = sdiResponse[i];
+        if (c == '-' || c == '+' || (c >= '0' && c <= '9') || c == '.') {
+            uint16_t end = i + 1;
+            while (end < sdiResponse.length() &&
+                   ((sdiResponse[end] >= '0' && sdiResponse[end] <= '9') ||
+                    sdiResponse[end] == '.')) {
+                end++;
+            }
+            String number = sdiResponse.substring(c == '+' ? i + 1 : i, end);
+            // A lone sign or a decimal point isn't a value
+            float result = -9999;
+            if (number.length() > 0 && number != "-" && number != ".") {
+                result = number.toFloat();
+            }
+            if (isnan(result)) result = -9999;
+            MS_DBG(F("    <<<"), String(result, 10));
+            values[nValues++] = result;
+            i                 = end;
+        } else {
+            MS_DEEP_DBG(F("    <<<"), c);
+            i++;
+        }
+    }
+    return nValues;
+}
+
+
+#ifdef MS_SDI12_HIGH_VOLUME
+// The sizes of the SDI-12 binary data types, by their number
+static const uint8_t binaryTypeSizes[] = {0, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8};
+
+// A double may only be 4 bytes, so build the float from the bits of the
+// 8-byte double
+static float doubleBitsToFloat(uint64_t bits) {
+    uint32_t sign     = static_cast<uint32_t>(bits >> 63) << 31;
+    int16_t  exponent = static_cast<int16_t>((bits >> 52) & 0x7FF);
+    if (exponent == 0x7FF) return -9999;  // Not a number or infinite
+    if (exponent == 0) return 0;
+    exponent = exponent - 1023 + 127;
+    if (exponent >= 0xFF) return -9999;  // Too big for a float
+    if (exponent <= 0) return 0;         // Too small for a float
+    uint32_t floatBits = sign | static_cast<uint32_t>(exponent) << 23 |
+        static_cast<uint32_t>((bits >> 29) & 0x7FFFFF);
+    float result;
+    memcpy(&result, &floatBits, sizeof(result));
+    return result;
+}
+
+// A binary value is little-endian
+static float binaryToFloat(uint8_t type, const uint8_t* data) {
+    uint64_t bits = 0;
+    for (uint8_t i = binaryTypeSizes[type]; i > 0; i--) {
+        bits = bits << 8 | data[i - 1];
+    }
+    switch (type) {
+        case 1: return static_cast<int8_t>(bits);
+        case 2: return static_cast<uint8_t>(bits);
+        case 3: return static_cast<int16_t>(bits);
+        case 4: return static_cast<uint16_t>(bits);
+        case 5: return static_cast<int32_t>(bits);
+        case 6: return static_cast<uint32_t>(bits);
+        case 7: return static_cast<float>(static_cast<int64_t>(bits));
+        case 8: return static_cast<float>(bits);
+        case 9: {
+            uint32_t floatBits = static_cast<uint32_t>(bits);
+            float    result;
+            memcpy(&result, &floatBits, sizeof(result));
+            return isnan(result) ? -9999 : result;
+        }
+        default: return doubleBitsToFloat(bits);
+    }
+}
+
+
+uint8_t SDI12Sensors::getBinaryValues(uint16_t packetNumber, float* values,
+                                      uint8_t maxValues) {
+    // Check if this the currently active SDI-12 Object
+    bool wasActive = _SDI12Internal.isActive();
+    // If it wasn't active, activate it now.
+    if (!wasActive) _SDI12Internal.begin();
+
+    // SDI-12 command to get binary data [address][DB][packet][!]
+    String getDataCommand = "";
+    getDataCommand += _SDI12address;
+    getDataCommand += "DB";
+    getDataCommand += packetNumber;
+    getDataCommand += "!";
+
+    // The packet is the address, the 2-byte size of the values in bytes, the
+    // data type, the values, and the 2-byte CRC of everything before it, with
+    // no <CR><LF>
+    uint8_t nValues    = 0;
+    uint8_t ntries     = 0;
+    bool    crcMatched = false;
+    do {
+        nValues = 0;
+        _SDI12Internal.clearBuffer();
+        _SDI12Internal.sendCommand(getDataCommand, _extraWakeTime);
+        MS_DEEP_DBG(F("    >>>"), getDataCommand);
+        ntries++;
+
+        uint8_t header[4];
+        if (_SDI12Internal.readBytes(header, 4) != 4 ||
+            header[0] != static_cast<uint8_t>(_SDI12address)) {
+            MS_DBG(F("  No binary packet from"), getSensorNameAndLocation());
+            continue;
+        }
+        uint16_t size = header[1] | static_cast<uint16_t>(header[2]) << 8;
+        uint8_t  type = header[3];
+        uint8_t  valueSize =
+            type < sizeof(binaryTypeSizes) ? binaryTypeSizes[type] : 0;
+        if (size == 0 || valueSize == 0 || size % valueSize != 0) {
+            // An empty packet or type 0 means there's no more data
+            MS_DBG(F("  No more binary data in packet"), packetNumber);
+            crcMatched = true;
+            break;
+        }
+
+        uint16_t crc = addToCRC(0, header, 4);
+        for (uint16_t read = 0; read < size; read += valueSize) {
+            uint8_t value[8];
+            if (_SDI12Internal.readBytes(value, valueSize) != valueSize) break;
+            crc = addToCRC(crc, value, valueSize);
+            if (nValues < maxValues) {
+                values[nValues] = binaryToFloat(type, value);
+                MS_DBG(F("    <<<"), String(values[nValues], 10));
+                nValues++;
+            }
+        }
+        uint8_t check[2];
+        crcMatched = _SDI12Internal.readBytes(check, 2) == 2 &&
+            check[0] == (crc & 0xFF) && check[1] == (crc >> 8);
+        if (!crcMatched) {
+            MS_DBG(F("  CRC of the"), getDataCommand,
+                   F("packet doesn't match!"));
+        }
+    } while (!crcMatched && ntries <= MS_SDI12_CRC_RETRIES);
+
+    // Empty the buffer again
+    _SDI12Internal.clearBuffer();
+
+    // De-activate the SDI-12 Object
+    // Use end() instead of just forceHold to un-set the timers
+    if (!wasActive) _SDI12Internal.end();
+
+    // Don't use anything from a packet that's still corrupted
+    return crcMatched ? nValues : 0;
+}
+#endif
+
+
+bool SDI12Sensors::getResults(void) {
+    MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
+    uint8_t  resultsReceived = 0;
+    uint16_t cmd_number      = 0;
+    uint16_t lastCommand     = 9;
+#ifdef MS_SDI12_HIGH_VOLUME
+    sdi12HighVolume highVolume =
+        _continuousMeasurement ? SDI12_HIGH_VOLUME_OFF : getHighVolume();
+    if (highVolume != SDI12_HIGH_VOLUME_OFF) lastCommand = 999;
+#endif
+
+    // When requesting data, the sensor sends back up to ~80 characters at a
+    // time to each data request.  If it needs to return more results than can
+    // fit in the first data request (D0), we need to make additional requests
+    // (D1-9, or up to D999 or DB999 for high volume measurements).  Since
+    // this is a parent to all sensors, we're going to keep requesting data
+    // until we either get as many results as we expect or no more data is
+    // returned.
+    while (resultsReceived < (_numReturnedValues - _incCalcValues) &&
+           cmd_number <= lastCommand) {
+        bool    gotResults = false;
+        float   values[MAX_NUMBER_VARS];
+        uint8_t remaining = (_numReturnedValues - _incCalcValues) -
+            resultsReceived;
+#ifdef MS_SDI12_HIGH_VOLUME
+        uint8_t nValues = highVolume == SDI12_HIGH_VOLUME_BINARY
+            ? getBinaryValues(cmd_number, values, remaining)
+            : getDataValues(cmd_number, values, remaining);
 #else
-                // if we're not debugging, just read the character to make sure
-                // it's removed from the buffer
-                _SDI12Internal.read();
+        uint8_t nValues = getDataValues(cmd_number, values, remaining);
 #endif
+        for (uint8_t i = 0; i < nValues; i++) {
+            // Verify that the number is valid and add it to the result
+            // array. After each result is read, tick up the number of
+            // results received so that the next one goes in the next spot
+            // in the variable array.
+            verifyAndAddMeasurementResult(resultsReceived, values[i]);
+            if (values[i] != -9999) {
+                gotResults = true;
+                resultsReceived++;
             }
-            delay(10);  // 1 character ~ 7.5ms
         }
         if (!gotResults) {
             MS_DBG(F("  No results received, will not continue requests!"));
@@ -486,13 +966,6 @@ bool SDI12Sensors::getResults(void) {
         cmd_number++;
     }
 
-    // Empty the buffer again
-    _SDI12Internal.clearBuffer();
-
-    // De-activate the SDI-12 Object
-    // Use end() instead of just forceHold to un-set the timers
-    if (!wasActive) _SDI12Internal.end();
-
     return (_numReturnedValues - _incCalcValues) == resultsReceived;
 }
 
@@ -514,11 +987,26 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
         }
     }
 
+#ifdef MS_SDI12_SERVICE_REQUEST
+    // Stop listening for this sensor's service request
+    if (_listeningForService) {
+        _SDI12Internal.end();
+        _listeningForService = false;
+    }
+#endif
+
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
     // Unset the status bits for a measurement request (bits 5 & 6)
     _sensorStatus &= 0b10011111;
 
+#ifdef MS_DISCOVERY_CACHE
+    // Ask who the sensor is again at the next setup
+    if (!success) {
+        DiscoveryCache::forget(DISCOVERY_SDI12_INFO, _dataPin, _SDI12address);
+    }
+#endif
+
     return success;
 }
 #else
@@ -537,11 +1025,14 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
     // Empty the buffer
     _SDI12Internal.clearBuffer();
 
-    // Check that the sensor is there and responding
-    if (requestSensorAcknowledgement()) {
+    if (_continuousMeasurement) {
+        // Continuous measurements are read straight away
+        success = getResults();
+    } else if (requestSensorAcknowledgement()) {
+        // Check that the sensor is there and responding, then
         // send the commands to start the measurement; false = not concurrent
         // the returned wait time should always be non-zero
-        int8_t wait = startSDI12Measurement(false);
+        int16_t wait = startSDI12Measurement(false);
 
         // Set the times we've activated the sensor and asked for a measurement
         if (wait >= 0) {
@@ -610,6 +1101,13 @@ bool SDI12Sensors::addSingleMeasurementResult(void) {
     // Unset the status bits for a measurement request (bits 5 & 6)
     _sensorStatus &= 0b10011111;
 
+#ifdef MS_DISCOVERY_CACHE
+    // Ask who the sensor is again at the next setup
+    if (!success) {
+        DiscoveryCache::forget(DISCOVERY_SDI12_INFO, _dataPin, _SDI12address);
+    }
+#endif
+
     return success;
 }
 #endif  // #ifndef MS_SDI12_NON_CONCURRENT
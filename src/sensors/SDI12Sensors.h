@@ -49,6 +49,10 @@
  * SDI12 sensor, no interrupts (or tips) will be registered during SDI12
  * communication.
  *
+ * All of the SDI-12 sensors on the same data pin share a single SDI-12 object,
+ * so each extra sensor on a pin costs no more than its own settings and the
+ * SDI-12 interface isn't handed back and forth between sensors on one pin.
+ *
  * @section sdi12_group_flags Build flags
  * - `-D MS_SDI12_NON_CONCURRENT`
  *    - Instructs *all* SDI-12 sensors to take non-concurrent measurements
@@ -58,6 +62,48 @@
  *    - This may be necessary if your sensor uses a version of the SDI-12
  * protocol prior to 1.2 or if your sensor is not properly compliant with the
  * protocol.
+ * - `-D MS_SDI12_BUS_CONCURRENT`
+ *    - Treats all SDI-12 sensors sharing a data pin as a single bus
+ *    - When a concurrent measurement is started on any sensor on the bus,
+ * concurrent measurements are also started back-to-back on every other sensor
+ * on that pin that is already awake and stable.  Each sensor's results are
+ * then collected as its own measurement time elapses.
+ *    - This has no effect if `MS_SDI12_NON_CONCURRENT` is also defined.
+ * - `-D MS_SDI12_SERVICE_REQUEST`
+ *    - Starts standard (aM!) measurements without waiting for them and listens
+ * for the sensor's service request, so a measurement is finished as soon as
+ * the sensor says its data is ready
+ *    - The sensor keeps the other sensors on its data pin waiting until it
+ * sends its service request or its measurement time passes.  Only one SDI-12
+ * pin can be listened to at a time; if another pin is used in the meantime the
+ * measurement time is waited out instead.
+ *    - This has no effect if `MS_SDI12_NON_CONCURRENT` is also defined and
+ * replaces `MS_SDI12_BUS_CONCURRENT`.
+ *
+ * - `-D MS_SDI12_CRC`
+ *    - Starts measurements with the CRC variants of the measurement commands
+ * (aMC! and aCC!) and checks the CRC of every data response
+ *    - A data response with a bad CRC is requested again, up to
+ * `MS_SDI12_CRC_RETRIES` times (default 2), without starting a new
+ * measurement
+ *    - The sensor must support the CRC commands (SDI-12 version 1.2 or later)
+ *
+ * - `-D MS_SDI12_HIGH_VOLUME`
+ *    - Starts measurements on sensors that support SDI-12 version 1.4 with
+ * the high volume commands (aHA! or aHB!) instead of aM! or aC!
+ *    - The results are read with aD0! to aD999!, which hold up to 75
+ * characters each instead of 35, or, for the binary command, with aDB0! to
+ * aDB999!, which send each value as a few bytes instead of up to 9
+ * characters, so a sensor with many values takes far fewer, shorter data
+ * requests
+ *    - Each sensor uses binary if it reports version 1.4 or later in its aI!
+ * response; set it for a sensor with SDI12Sensors::setHighVolume()
+ *    - A high volume measurement doesn't send a service request, so with
+ * `MS_SDI12_SERVICE_REQUEST` its measurement time is waited out
+ *
+ * Whichever measurement is used, the time the sensor reports it will take to
+ * measure is used as the measurement time whenever it is shorter than the
+ * sensor's usual measurement time.
  *
  */
 /* clang-format on */
@@ -77,6 +123,14 @@
 #define MS_DEBUGGING_DEEP "SDI12Sensors"
 #endif
 
+#ifndef MS_SDI12_CRC_RETRIES
+/**
+ * @brief The number of times to ask again for a data response with a bad CRC;
+ * only used with #MS_SDI12_CRC
+ */
+#define MS_SDI12_CRC_RETRIES 2
+#endif
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
@@ -92,6 +146,22 @@
 // SDI12_EXTERNAL_PCINT Unfortunately, that is not compatible with the Arduino
 // IDE
 
+#ifdef MS_SDI12_HIGH_VOLUME
+/**
+ * @brief The high volume measurement commands of SDI-12 version 1.4.
+ */
+typedef enum sdi12HighVolume : uint8_t {
+    /// Standard or concurrent measurements
+    SDI12_HIGH_VOLUME_OFF = 0,
+    /// High volume ASCII measurements (aHA!)
+    SDI12_HIGH_VOLUME_ASCII,
+    /// High volume binary measurements (aHB!)
+    SDI12_HIGH_VOLUME_BINARY,
+    /// Binary if the sensor reports SDI-12 version 1.4 or later
+    SDI12_HIGH_VOLUME_AUTO,
+} sdi12HighVolume;
+#endif
+
 /**
  * @brief The main class for SDI-12 Sensors
  */
@@ -192,6 +262,49 @@ class SDI12Sensors : public Sensor {
      * itself.
      */
     String getSensorSerialNumber(void);
+
+    /**
+     * @brief Read the sensor's continuous measurements (aR0!) instead of
+     * starting a measurement for each reading.
+     *
+     * The values are read as soon as the measurement "starts", with no wait
+     * at all, so a sensor that is kept powered between readings can be read
+     * in tens of milliseconds.  Only use this for sensors that support
+     * continuous measurements, like the Meter Hydros 21, the Campbell
+     * ClariVUE10, and many In-Situ probes.
+     *
+     * @param continuous True to read continuous measurements; false to start
+     * a standard or concurrent measurement for each reading
+     */
+    void setContinuousMeasurement(bool continuous);
+    /**
+     * @brief Check if the sensor reads continuous measurements.
+     *
+     * @return **bool** True if the sensor reads continuous measurements.
+     */
+    bool getContinuousMeasurement(void);
+#ifdef MS_SDI12_HIGH_VOLUME
+    /**
+     * @brief Set which high volume measurement command the sensor is started
+     * with.
+     *
+     * With the default of #SDI12_HIGH_VOLUME_AUTO the binary command is used
+     * if the sensor reported SDI-12 version 1.4 or later when it was set up.
+     * With #MS_DISCOVERY_CACHE the version is kept in the cache with the rest
+     * of the sensor's identification.
+     *
+     * @param highVolume The sdi12HighVolume commands to use
+     */
+    void setHighVolume(sdi12HighVolume highVolume);
+    /**
+     * @brief Get the high volume measurement command the sensor is started
+     * with.
+     *
+     * @return **sdi12HighVolume** The commands used; never
+     * #SDI12_HIGH_VOLUME_AUTO.
+     */
+    sdi12HighVolume getHighVolume(void);
+#endif
     /**
      * @copydoc Sensor::getSensorLocation()
      *
@@ -215,6 +328,26 @@ class SDI12Sensors : public Sensor {
      */
     bool setup(void) override;
 
+    /**
+     * @brief Ask the sensor whether it is ready to receive commands by sending
+     * it a single SDI-12 'acknowledge active' command [address][!].
+     *
+     * This is only used with adaptive timing; see Sensor::setAdaptiveTiming().
+     *
+     * @return **bool** True if the sensor answered the acknowledgement.
+     */
+    bool probeWarmedUp(void) override;
+
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    /**
+     * @copydoc Sensor::wake()
+     *
+     * This also resets the count of measurements still to start in this
+     * update, so the other sensors on the bus don't start any extras.
+     */
+    bool wake(void) override;
+#endif
+
 // Only need this for concurrent measurements.
 // NOTE:  By default, concurrent measurements are used!
 #ifndef MS_SDI12_NON_CONCURRENT
@@ -230,6 +363,22 @@ class SDI12Sensors : public Sensor {
      * successfully.
      */
     bool startSingleMeasurement(void) override;
+#endif
+#if defined(MS_SDI12_SERVICE_REQUEST) && !defined(MS_SDI12_NON_CONCURRENT)
+    /**
+     * @copydoc Sensor::isMeasurementComplete(bool debug)
+     *
+     * The measurement is also complete as soon as the sensor sends its
+     * service request.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+    /**
+     * @copydoc Sensor::isHoldingBus()
+     *
+     * The sensor holds its data pin while it is waiting to send a service
+     * request; any other command on the pin would abort the measurement.
+     */
+    bool isHoldingBus(void) override;
 #endif
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
@@ -256,7 +405,9 @@ class SDI12Sensors : public Sensor {
     /**
      * @brief Tell the sensor to start a single measurement, if needed.
      *
-     * This also sets the #_millisMeasurementRequested timestamp.
+     * This also sets the #_millisMeasurementRequested timestamp and shortens
+     * the #_measurementTime_ms to the time the sensor reports it needs, if
+     * that's less than its usual measurement time.
      *
      * @note This function does NOT include any waiting for the sensor to be
      * warmed up or stable!
@@ -264,10 +415,46 @@ class SDI12Sensors : public Sensor {
      * @param isConcurrent Whether to start a concurrent or standard
      * measurement.  Defaults to 'true' for a concurrent measurement.
      *
-     * @return **int8_t** The length of time the measurement is expected to
-     * take.
+     * @return **int16_t** The length of time in seconds the measurement is
+     * expected to take, or -1 if the measurement didn't start.
+     */
+    int16_t startSDI12Measurement(bool isConcurrent = true);
+    /**
+     * @brief Send a data command [address][D][n][!], or a continuous
+     * measurement command [address][R][n][!], and read the values in the
+     * response.
+     *
+     * With #MS_SDI12_CRC, the CRC of the response is checked and the data
+     * command is sent again if it doesn't match.
+     *
+     * @param cmdNumber The number of the data or continuous command, 0-9, or
+     * up to 999 after a high volume ASCII measurement
+     * @param values The array for the values; values beyond the number read
+     * are left alone
+     * @param maxValues The length of the values array
+     * @return **uint8_t** The number of values read, including any that
+     * couldn't be parsed and are -9999.
+     */
+    uint8_t getDataValues(uint16_t cmdNumber, float* values,
+                          uint8_t maxValues);
+#ifdef MS_SDI12_HIGH_VOLUME
+    /**
+     * @brief Send a binary data command [address][DB][n][!] and read the
+     * values in the packet.
+     *
+     * The CRC of the packet is checked and the command is sent again, up to
+     * #MS_SDI12_CRC_RETRIES times, if it doesn't match.
+     *
+     * @param packetNumber The number of the packet, 0-999
+     * @param values The array for the values; values beyond the number read
+     * are left alone
+     * @param maxValues The length of the values array
+     * @return **uint8_t** The number of values read, or 0 if there were no
+     * more or the packet was bad.
      */
-    int8_t startSDI12Measurement(bool isConcurrent = true);
+    uint8_t getBinaryValues(uint16_t packetNumber, float* values,
+                            uint8_t maxValues);
+#endif
     /**
      * @brief Gets the results of either a standard or a concurrent measurement
      *
@@ -276,9 +463,10 @@ class SDI12Sensors : public Sensor {
      */
     virtual bool getResults(void);
     /**
-     * @brief Internal reference to the SDI-12 object.
+     * @brief Internal reference to the SDI-12 object shared by all of the
+     * sensors on this sensor's data pin.
      */
-    SDI12 _SDI12Internal;
+    SDI12& _SDI12Internal;
     /**
      * @brief Internal reference to the SDI-12 address.
      */
@@ -288,8 +476,123 @@ class SDI12Sensors : public Sensor {
      * and the time the command is sent.
      */
     int8_t _extraWakeTime;
+    /**
+     * @brief The usual measurement time of the sensor, given to the
+     * constructor
+     *
+     * The #_measurementTime_ms of each measurement is this or the time the
+     * sensor reports, whichever is shorter.
+     */
+    uint32_t _nominalMeasurementTime_ms;
+    /**
+     * @brief True if the sensor reads continuous measurements; see
+     * setContinuousMeasurement()
+     */
+    bool _continuousMeasurement = false;
+
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    /**
+     * @brief Start concurrent measurements on every other SDI-12 sensor on
+     * the same data pin that is awake, stable, and not already measuring.
+     *
+     * This is called after a concurrent measurement is successfully started
+     * on this sensor so that all of the measurement windows on the bus
+     * overlap.
+     */
+    void startConcurrentOnBus(void);
+#endif
 
  private:
+    /**
+     * @brief An SDI-12 object shared by all of the sensors on one data pin
+     */
+    struct sharedSDI12Bus {
+        explicit sharedSDI12Bus(int8_t dataPin) : bus(dataPin) {}
+        SDI12           bus;
+        sharedSDI12Bus* next = nullptr;
+    };
+    /**
+     * @brief The first of the shared SDI-12 objects, one for each data pin
+     * with an SDI-12 sensor on it.
+     */
+    static sharedSDI12Bus* _firstSharedBus;
+    /**
+     * @brief Get the SDI-12 object for a data pin, creating it for the first
+     * sensor on that pin.
+     *
+     * @param dataPin The data pin of the SDI-12 bus
+     * @return **SDI12&** The SDI-12 object shared by all sensors on the pin.
+     */
+    static SDI12& getSharedBus(int8_t dataPin);
+
+#if defined(MS_SDI12_BUS_CONCURRENT) && !defined(MS_SDI12_NON_CONCURRENT)
+    /**
+     * @brief The first SDI-12 sensor in the list of all constructed SDI-12
+     * sensors.
+     */
+    static SDI12Sensors* _firstOnBus;
+    /**
+     * @brief The next SDI-12 sensor in the list of all constructed SDI-12
+     * sensors.
+     */
+    SDI12Sensors* _nextOnBus;
+    /**
+     * @brief The number of measurements still to be started in this update.
+     *
+     * Neighbors on the bus only start a measurement on this sensor while this
+     * is non-zero; a sensor that has taken all of its measurements isn't sent
+     * any more commands.
+     */
+    measurementCount_t _startsLeft = 0;
+    /**
+     * @brief True while a bus-wide concurrent start is in progress, so the
+     * sensors being started don't try to start their neighbors again.
+     */
+    static bool _busStartInProgress;
+    /**
+     * @brief Add this sensor to the list of SDI-12 sensors.
+     */
+    void registerOnBus(void);
+#endif
+
+#if defined(MS_SDI12_CRC) || defined(MS_SDI12_HIGH_VOLUME)
+    /**
+     * @brief Add some bytes to the CRC-16 of the SDI-12 specification.
+     *
+     * @param crc The CRC of the bytes before; 0 to start
+     * @param data The bytes
+     * @param length The number of bytes
+     * @return **uint16_t** The CRC including the bytes.
+     */
+    static uint16_t addToCRC(uint16_t crc, const uint8_t* data,
+                             uint16_t length);
+    /**
+     * @brief Check the CRC at the end of a response and remove it.
+     *
+     * @param response The response, without the <CR><LF>
+     * @return **bool** True if the CRC matched.
+     */
+    static bool checkAndRemoveCRC(String& response);
+#endif
+#ifdef MS_SDI12_HIGH_VOLUME
+    /**
+     * @brief The high volume commands asked for with setHighVolume()
+     */
+    sdi12HighVolume _highVolume = SDI12_HIGH_VOLUME_AUTO;
+    /**
+     * @brief The SDI-12 version from the sensor's aI! response, times 10; 0
+     * if it hasn't been asked
+     */
+    uint8_t _sdi12Version = 0;
+#endif
+#if defined(MS_SDI12_SERVICE_REQUEST) && !defined(MS_SDI12_NON_CONCURRENT)
+    /**
+     * @brief True while the SDI-12 object was left listening for a service
+     * request from a measurement this sensor started
+     */
+    bool _listeningForService = false;
+#endif
+
     String _sensorVendor;
     String _sensorModel;
     String _sensorVersion;
@@ -67,13 +67,35 @@ bool SenseairK30::wake(void) {
 }
 
 
-bool SenseairK30::addSingleMeasurementResult(void) {
-    // Initialize values
-    bool    success = false;
-    int16_t result  = -9999;
+bool SenseairK30::startSingleMeasurement(void) {
+    // Sensor::startSingleMeasurement() checks that if it's awake/active and
+    // sets the timestamp and status bits.  If it returns false, there's no
+    // reason to go on.
+    if (!Sensor::startSingleMeasurement()) return false;
+
+    _result   = -9999;
+    _readDone = false;
+    requestReading();
+    return true;
+}
 
-    MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
+// Read the answer once the measurement time is up and, if it's missing or
+// bad, ask again and come back later instead of waiting for it
+bool SenseairK30::isMeasurementComplete(bool debug) {
+    if (!Sensor::isMeasurementComplete(debug)) return false;
+    // Nothing to read if the measurement didn't start or was already read
+    if (!bitRead(_sensorStatus, 6) || _readDone) return true;
+    if (readResponse() || _readDone) return true;
+    MS_DBG(F("  Bad or Suspicious Result, Retry Attempt #"),
+           _measurementStep + 1);
+    requestReading();
+    nextMeasurementStep(K30_RETRY_INTERVAL_MS);
+    return false;
+}
+
+
+void SenseairK30::requestReading(void) {
     // Clear anything out of the stream buffer
     auto junkChars = static_cast<uint8_t>(_stream->available());
     if (junkChars) {
@@ -90,62 +112,48 @@ bool SenseairK30::addSingleMeasurementResult(void) {
         DEBUGGING_SERIAL_OUTPUT.println();
 #endif
     }
+    MS_DBG(F("Starting read from K30..."));
+    _stream->write(read_CO2, responseLength);
+}
 
-    uint8_t co2Attempts = 0;
-    while (success == false && co2Attempts < 25) {
-        int timeout = 0;
-        MS_DBG(F("Starting read from K30..."));
-        int write_size;
-        while (!_stream->available()) {
-            write_size = _stream->write(read_CO2, responseLength);
-            //            MS_DBG(F("write size="), write_size);
-            timeout++;
-            //            MS_DBG(F("timeout="), timeout);
-            delay(50);
-            if (timeout > 50) { break; }
-        }
 
-        timeout = 0;
-        MS_DBG(F("Waiting for response..."));
-        while (_stream->available() < responseLength) {
-            MS_DBG(F("Stream is available."));
-            timeout++;
-            if (timeout > 10) {
-                while (_stream->available()) { _stream->read(); }
-
-                break;
-            }
-            delay(50);
-        }
+bool SenseairK30::readResponse(void) {
+    if (_stream->available() >= responseLength) {
+        uint8_t packet[responseLength];
+        MS_DBG(F("Reading packet..."));
+        _stream->readBytes(packet, responseLength);
+
+        // Calculate value
+        int high = packet[3];
+        int low  = packet[4];
+        _result  = (high * 256 + low) * _valMultiplier;
+        MS_DBG(F("  CO2: "), _result);
+    } else {
+        MS_DBG(F("Got response of wrong length!"));
+        _result = -9999;
+    }
 
-        if (_stream->available() >= responseLength) {
-            uint8_t packet[responseLength];
-            MS_DBG(F("Reading packet..."));
-            _stream->readBytes(packet, responseLength);
-
-            // Calculate value
-            int high = packet[3];
-            int low  = packet[4];
-            result   = (high * 256 + low) * _valMultiplier;
-            MS_DBG(F("  CO2: "), result);
-        } else {
-            MS_DBG(F("Got response of wrong length!"));
-            result = -9999;
-        }
-        co2Attempts++;
+    bool success = _result > 0;
+    if (success) {
+        MS_DBG(F("  Good result found"));
+    } else {
+        _result = -9999;
+    }
+    // NOTE:  Each retry is a measurement step, so the step is the number of
+    // reads that came before this one.
+    _readDone = success || _measurementStep + 1 >= K30_READ_ATTEMPTS;
+    return success;
+}
 
 
-        if (result <= 0) {
-            MS_DBG(F("  Bad or Suspicious Result, Retry Attempt #"),
-                   co2Attempts);
-            result = -9999;
-        } else {
-            MS_DBG(F("  Good result found"));
-            success = true;
-        }
-    }
+bool SenseairK30::addSingleMeasurementResult(void) {
+    MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
-    verifyAndAddMeasurementResult(K30_VAR_NUM, result);
+    // The answer is normally read as the measurement finishes, but read it
+    // now if that didn't happen
+    if (bitRead(_sensorStatus, 6) && !_readDone) readResponse();
+
+    verifyAndAddMeasurementResult(K30_VAR_NUM, _result);
 
     // Unset the time stamp for the beginning of this measurement
     _millisMeasurementRequested = 0;
@@ -153,5 +161,5 @@ bool SenseairK30::addSingleMeasurementResult(void) {
     //_sensorStatus &= 0b10011111;
 
     // Return values shows if we got a not-obviously-bad reading
-    return success;
+    return _result > 0;
 }
@@ -135,6 +135,12 @@
 /// @brief Sensor::_measurementTime_ms; the HRXL takes 166ms to complete a
 /// measurement.
 #define K30_MEASUREMENT_TIME_MS 500
+/// @brief The number of times to ask the K30 for a reading before giving up
+/// on a measurement.
+#define K30_READ_ATTEMPTS 25
+/// @brief The time in ms to wait for an answer after asking the K30 for a
+/// reading again.
+#define K30_RETRY_INTERVAL_MS 100
 /**@}*/
 
 /**
@@ -155,11 +161,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "carbonDioxide"
-#define K30_VAR_NAME "carbonDioxide"
+#define K30_VAR_NAME MS_VAR_TEXT("carbonDioxide")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "Part per Million"
-#define K30_UNIT_NAME "Part per Million"
+#define K30_UNIT_NAME MS_VAR_TEXT("Part per Million")
 /// @brief Default variable short code; "SonarRange"
 #define K30_DEFAULT_CODE "CO2"
 /**@}*/
@@ -238,15 +244,50 @@ class SenseairK30 : public Sensor {
      */
     bool wake(void) override;
 
+    /**
+     * @brief Tell the sensor to start a single measurement by asking it for
+     * its CO2 reading.
+     *
+     * This also sets the #_millisMeasurementRequested timestamp.
+     *
+     * @return **bool** True if the start measurement function completed
+     * successfully.
+     */
+    bool startSingleMeasurement(void) override;
+    /**
+     * @brief Check if the measurement is finished, reading the K30's answer
+     * once the measurement time is up.
+     *
+     * If there's no answer or it's a bad value, the K30 is asked again and
+     * the measurement is rescheduled for #K30_RETRY_INTERVAL_MS later, up to
+     * #K30_READ_ATTEMPTS times, instead of waiting for the answer.
+     *
+     * @param debug True to output the result to the debugging Serial
+     * @return **bool** True if the measurement is complete.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
     bool addSingleMeasurementResult(void) override;
 
  private:
+    /**
+     * @brief Empty the stream and ask the K30 for its CO2 reading.
+     */
+    void requestReading(void);
+    /**
+     * @brief Read the K30's answer, if it's all there.
+     *
+     * @return **bool** True if a good (positive) CO2 value was read.
+     */
+    bool readResponse(void);
+
     int8_t  _triggerPin;
     Stream* _stream;
     float   _valMultiplier;
+    int16_t _result   = -9999;
+    bool    _readDone = false;
 };
 
 
@@ -18,14 +18,20 @@ SensirionSHT4x::SensirionSHT4x(TwoWire* theI2C, int8_t powerPin, bool useHeater,
              SHT4X_STABILIZATION_TIME_MS, SHT4X_MEASUREMENT_TIME_MS, powerPin,
              -1, measurementsToAverage),
       _useHeater(useHeater),
-      _i2c(theI2C) {}
+      _heater(useHeater ? SHT4X_HIGH_HEATER_1S : SHT4X_NO_HEATER),
+      _i2c(theI2C) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 SensirionSHT4x::SensirionSHT4x(int8_t powerPin, bool useHeater,
                                uint8_t measurementsToAverage)
     : Sensor("SensirionSHT4x", SHT4X_NUM_VARIABLES, SHT4X_WARM_UP_TIME_MS,
              SHT4X_STABILIZATION_TIME_MS, SHT4X_MEASUREMENT_TIME_MS, powerPin,
              -1, measurementsToAverage, SHT4X_INC_CALC_VARIABLES),
       _useHeater(useHeater),
-      _i2c(&Wire) {}
+      _heater(useHeater ? SHT4X_HIGH_HEATER_1S : SHT4X_NO_HEATER),
+      _i2c(&Wire) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 // Destructor
 SensirionSHT4x::~SensirionSHT4x() {}
 
@@ -64,8 +70,8 @@ bool SensirionSHT4x::setup(void) {
         ntries++;
     }
 
-    // Set sensor for high precision
-    sht4x_internal.setPrecision(SHT4X_HIGH_PRECISION);
+    // Set sensor for the chosen precision (high by default)
+    sht4x_internal.setPrecision(_precision);
 
     // Initially, set the sensor up to *not* use the heater
     sht4x_internal.setHeater(SHT4X_NO_HEATER);
@@ -86,6 +92,46 @@ bool SensirionSHT4x::setup(void) {
 }
 
 
+void SensirionSHT4x::setPrecision(sht4x_precision_t precision) {
+    _precision = precision;
+    switch (precision) {
+        case SHT4X_LOW_PRECISION:
+            _measurementTime_ms = SHT4X_LOW_MEASUREMENT_TIME_MS;
+            break;
+        case SHT4X_MED_PRECISION:
+            _measurementTime_ms = SHT4X_MED_MEASUREMENT_TIME_MS;
+            break;
+        default: _measurementTime_ms = SHT4X_MEASUREMENT_TIME_MS; break;
+    }
+    // Pass it on now if the sensor is already set up
+    if (bitRead(_sensorStatus, 0)) { sht4x_internal.setPrecision(precision); }
+    MS_DBG(getSensorNameAndLocation(), F("measurement time set to"),
+           _measurementTime_ms, F("ms"));
+}
+
+
+void SensirionSHT4x::setHeater(sht4x_heater_t heater) {
+    _heater    = heater;
+    _useHeater = heater != SHT4X_NO_HEATER;
+}
+
+
+uint32_t SensirionSHT4x::getHeaterTime_ms(void) {
+    // The heater always finishes with a high precision measurement
+    switch (_heater) {
+        case SHT4X_HIGH_HEATER_1S:
+        case SHT4X_MED_HEATER_1S:
+        case SHT4X_LOW_HEATER_1S:
+            return 1000 + SHT4X_MEASUREMENT_TIME_MS;
+        case SHT4X_HIGH_HEATER_100MS:
+        case SHT4X_MED_HEATER_100MS:
+        case SHT4X_LOW_HEATER_100MS:
+            return 100 + SHT4X_MEASUREMENT_TIME_MS;
+        default: return 0;
+    }
+}
+
+
 bool SensirionSHT4x::addSingleMeasurementResult(void) {
     // Initialize float variables
     float temp_val  = -9999;
@@ -133,7 +179,7 @@ bool SensirionSHT4x::addSingleMeasurementResult(void) {
 
 // The function to run the internal heater before going to sleep
 bool SensirionSHT4x::sleep(void) {
-    if (_useHeater) { return Sensor::sleep(); }
+    if (!_useHeater) { return Sensor::sleep(); }
 
     if (!checkPowerOn()) { return true; }
     if (_millisSensorActivated == 0) {
@@ -141,16 +187,26 @@ bool SensirionSHT4x::sleep(void) {
         return true;
     }
 
+    // Keep the heater under its duty limit if we're logging very quickly
+    uint32_t heaterTime = getHeaterTime_ms();
+    uint32_t minOffTime = heaterTime * (100 - SHT4X_HEATER_MAX_DUTY_PCT) /
+        SHT4X_HEATER_MAX_DUTY_PCT;
+    if (_millisHeaterDone != 0 && millis() - _millisHeaterDone < minOffTime) {
+        MS_DBG(F("Skipping heater on"), getSensorNameAndLocation(),
+               F("to stay under its duty limit"));
+        return Sensor::sleep();
+    }
+
     bool success = true;
-    MS_DBG(F("Running heater on"), getSensorNameAndLocation(),
-           F("at maximum for 1s to remove condensation."));
+    MS_DBG(F("Running heater on"), getSensorNameAndLocation(), F("for"),
+           heaterTime, F("ms to remove condensation."));
 
 
-    // Set up to send a heat command at the highest and longest cycle.
-    // Because we're only doing this once per logging cycle (most commonly every
-    // 5 minutes, we want to blast the heater for the tiny bit of time it will
-    // be on.
-    sht4x_internal.setHeater(SHT4X_HIGH_HEATER_1S);
+    // Set up to send a heat command, by default at the highest and longest
+    // cycle.  Because we're only doing this once per logging cycle (most
+    // commonly every 5 minutes, we want to blast the heater for the tiny bit
+    // of time it will be on.
+    sht4x_internal.setHeater(_heater);
 
     // we need to create Adafruit "sensor events" to use the library
     // NOTE:  we're not going to use the temperatures and humidity returned
@@ -162,7 +218,8 @@ bool SensirionSHT4x::sleep(void) {
     // time like it supports a wake time.
     sensors_event_t temp_event;
     sensors_event_t humidity_event;
-    success = sht4x_internal.getEvent(&humidity_event, &temp_event);
+    success           = sht4x_internal.getEvent(&humidity_event, &temp_event);
+    _millisHeaterDone = millis();
 
     // Set the command back to no heat for the next measurement.
     sht4x_internal.setHeater(SHT4X_NO_HEATER);
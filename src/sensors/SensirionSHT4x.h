@@ -104,6 +104,17 @@
 /// measurement at the highest precision.  At medium precision measurement time
 /// is 4.5ms (max) and it is 1.7ms (max) at low precision.
 #define SHT4X_MEASUREMENT_TIME_MS 9
+/// @brief Sensor::_measurementTime_ms at medium precision; 4.5ms (max).
+#define SHT4X_MED_MEASUREMENT_TIME_MS 5
+/// @brief Sensor::_measurementTime_ms at low precision; 1.7ms (max).
+#define SHT4X_LOW_MEASUREMENT_TIME_MS 2
+/**
+ * @brief The highest percent of the time the heater is allowed to be on.
+ *
+ * The heater is skipped at sleep if running it would go over this, counting
+ * from the end of the last time it ran.
+ */
+#define SHT4X_HEATER_MAX_DUTY_PCT 5
 /**@}*/
 
 /**
@@ -128,11 +139,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "relativeHumidity"
-#define SHT4X_HUMIDITY_VAR_NAME "relativeHumidity"
+#define SHT4X_HUMIDITY_VAR_NAME MS_VAR_TEXT("relativeHumidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
 /// (percent relative humidity)
-#define SHT4X_HUMIDITY_UNIT_NAME "percent"
+#define SHT4X_HUMIDITY_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "SHT4xHumidity"
 #define SHT4X_HUMIDITY_DEFAULT_CODE "SHT4xHumidity"
 /**@}*/
@@ -159,11 +170,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define SHT4X_TEMP_VAR_NAME "temperature"
+#define SHT4X_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define SHT4X_TEMP_UNIT_NAME "degreeCelsius"
+#define SHT4X_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "SHT4xTemp"
 #define SHT4X_TEMP_DEFAULT_CODE "SHT4xTemp"
 /**@}*/
@@ -261,6 +272,39 @@ class SensirionSHT4x : public Sensor {
      */
     bool setup(void) override;
 
+    /**
+     * @brief Set the measurement precision (repeatability) of the SHT4x.
+     *
+     * The measurement time is set to match: #SHT4X_MEASUREMENT_TIME_MS at high
+     * precision, #SHT4X_MED_MEASUREMENT_TIME_MS at medium, and
+     * #SHT4X_LOW_MEASUREMENT_TIME_MS at low.  Low precision makes averaging
+     * many quick measurements practical.  The default is high precision.
+     *
+     * @param precision The precision; SHT4X_HIGH_PRECISION,
+     * SHT4X_MED_PRECISION, or SHT4X_LOW_PRECISION
+     */
+    void setPrecision(sht4x_precision_t precision);
+    /**
+     * @brief Set the heater setting run when the sensor goes to sleep.
+     *
+     * The default, if useHeater was true in the constructor, is
+     * SHT4X_HIGH_HEATER_1S.  A 100ms heater setting costs a tenth of the time
+     * in sleep().  The heater is skipped if running it would put it over
+     * #SHT4X_HEATER_MAX_DUTY_PCT.
+     *
+     * @param heater The heater setting; one of the Adafruit sht4x_heater_t
+     * values, or SHT4X_NO_HEATER to not run the heater
+     */
+    void setHeater(sht4x_heater_t heater);
+    /**
+     * @brief Get the time the heater setting keeps the sensor busy in
+     * sleep().
+     *
+     * @return **uint32_t** The time in ms the heater and the measurement at
+     * the end of it block for, or 0 if the heater isn't used.
+     */
+    uint32_t getHeaterTime_ms(void);
+
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
@@ -269,8 +313,8 @@ class SensirionSHT4x : public Sensor {
     /**
      * @copydoc Sensor::sleep()
      *
-     * If opted for, we run the SHT4x's internal heater for 1s before going to
-     * sleep.
+     * If opted for, we run the SHT4x's internal heater for 1s (or as set by
+     * setHeater()) before going to sleep.
      */
     bool sleep(void) override;
 
@@ -279,6 +323,19 @@ class SensirionSHT4x : public Sensor {
      * @brief Internal variable for the heating setting
      */
     bool _useHeater;
+    /**
+     * @brief The measurement precision
+     */
+    sht4x_precision_t _precision = SHT4X_HIGH_PRECISION;
+    /**
+     * @brief The heater setting run at sleep
+     */
+    sht4x_heater_t _heater = SHT4X_HIGH_HEATER_1S;
+    /**
+     * @brief The processor time the heater last finished running; 0 if it
+     * hasn't run.
+     */
+    uint32_t _millisHeaterDone = 0;
     /**
      * @brief Internal reference the the Adafruit BME object
      */
@@ -19,12 +19,13 @@
 // The constructor - need the power pin the data pin, and gain if non standard
 TIADS1x15::TIADS1x15(int8_t powerPin, uint8_t adsChannel, float gain,
                      uint8_t i2cAddress, uint8_t measurementsToAverage)
-    : Sensor("TIADS1x15", TIADS1X15_NUM_VARIABLES, TIADS1X15_WARM_UP_TIME_MS,
-             TIADS1X15_STABILIZATION_TIME_MS, TIADS1X15_MEASUREMENT_TIME_MS,
-             powerPin, -1, measurementsToAverage, TIADS1X15_INC_CALC_VARIABLES),
-      _adsChannel(adsChannel),
-      _gain(gain),
-      _i2cAddress(i2cAddress) {}
+    : TIADS1x15Parent("TIADS1x15", TIADS1X15_NUM_VARIABLES,
+                      TIADS1X15_WARM_UP_TIME_MS,
+                      TIADS1X15_STABILIZATION_TIME_MS,
+                      TIADS1X15_MEASUREMENT_TIME_MS, powerPin, adsChannel,
+                      i2cAddress, measurementsToAverage,
+                      TIADS1X15_INC_CALC_VARIABLES),
+      _gain(gain) {}
 // Destructor
 TIADS1x15::~TIADS1x15() {}
 
@@ -52,6 +53,10 @@ bool TIADS1x15::addSingleMeasurementResult(void) {
     if (bitRead(_sensorStatus, 6)) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
+#ifdef MS_TIADS1X15_SHARED
+        // Collect the conversion queued when the measurement started
+        adcVoltage = readQueuedVoltage();
+#else
 // Create an Auxillary ADD object
 // We create and set up the ADC object here so that each sensor using
 // the ADC may set the gain appropriately without effecting others.
@@ -83,6 +88,7 @@ bool TIADS1x15::addSingleMeasurementResult(void) {
             ads.readADC_SingleEnded_V(_adsChannel);  // Getting the reading
         MS_DBG(F("  ads.readADC_SingleEnded_V("), _adsChannel, F("):"),
                adcVoltage);
+#endif
 
         if (adcVoltage < 3.6 && adcVoltage > -0.3) {
             // Skip results out of range
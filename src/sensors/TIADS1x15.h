@@ -151,7 +151,7 @@
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "VariableBase.h"
-#include "SensorBase.h"
+#include "TIADS1x15Parent.h"
 
 /** @ingroup sensor_ads1x15 */
 /**@{*/
@@ -218,10 +218,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "voltage"
-#define TIADS1X15_VAR_NAME "voltage"
+#define TIADS1X15_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "volt"
-#define TIADS1X15_UNIT_NAME "volt"
+#define TIADS1X15_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "extVoltage"
 #define TIADS1X15_DEFAULT_CODE "extVoltage"
 
@@ -245,7 +245,7 @@
  * @ingroup sensor_ads1x15
  */
 /* clang-format on */
-class TIADS1x15 : public Sensor {
+class TIADS1x15 : public TIADS1x15Parent {
  public:
     /**
      * @brief Construct a new External Voltage object - need the power pin and
@@ -287,9 +287,7 @@ class TIADS1x15 : public Sensor {
     bool addSingleMeasurementResult(void) override;
 
  private:
-    uint8_t _adsChannel;
-    float   _gain;
-    uint8_t _i2cAddress;
+    float _gain;
 };
 
 /**
@@ -0,0 +1,258 @@
+/**
+ * @file TIADS1x15Manager.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the TIADS1x15Manager class.
+ */
+
+#include "TIADS1x15Manager.h"
+#include <Wire.h>
+
+
+// ADS1x15 register pointers
+#define ADS_REG_CONVERSION 0x00
+#define ADS_REG_CONFIG 0x01
+#define ADS_REG_LO_THRESH 0x02
+#define ADS_REG_HI_THRESH 0x03
+
+// Config register bits: start a single-shot conversion on a single-ended
+// channel; the comparator queue bits select the ALERT/RDY function
+#define ADS_CONFIG_OS_SINGLE 0x8000
+#define ADS_CONFIG_MUX_SINGLE_0 0x4000
+#define ADS_CONFIG_MODE_SINGLE 0x0100
+#define ADS_CONFIG_CQUE_1CONV 0x0000
+#define ADS_CONFIG_CQUE_NONE 0x0003
+
+// The data rates for each setting of the config register DR bits
+#ifndef MS_USE_ADS1015
+static const uint16_t adsDataRates[8] = {8, 16, 32, 64, 128, 250, 475, 860};
+#else
+static const uint16_t adsDataRates[8] = {128,  250,  490,  920,
+                                         1600, 2400, 3300, 3300};
+#endif
+
+
+TIADS1x15Manager TIADS1x15Manager::_managers[4];
+
+
+TIADS1x15Manager* TIADS1x15Manager::getManager(uint8_t i2cAddress) {
+    // The four addresses are 0x48 to 0x4B
+    TIADS1x15Manager* manager = &_managers[i2cAddress & 0x03];
+    manager->_i2cAddress      = i2cAddress;
+    return manager;
+}
+
+
+void TIADS1x15Manager::setDataRate(uint16_t samplesPerSecond) {
+    _dataRate = 7;
+    for (uint8_t i = 0; i < 8; i++) {
+        if (adsDataRates[i] >= samplesPerSecond) {
+            _dataRate = i;
+            break;
+        }
+    }
+    MS_DBG(F("ADS1x15 at 0x"), String(_i2cAddress, HEX),
+           F("set to"), adsDataRates[_dataRate], F("samples per second"));
+}
+
+
+void TIADS1x15Manager::setReadyPin(int8_t readyPin) {
+    _readyPin      = readyPin;
+    _thresholdsSet = false;
+    if (_readyPin >= 0) { pinMode(_readyPin, INPUT_PULLUP); }
+}
+
+
+uint32_t TIADS1x15Manager::getConversionTime(void) {
+    return 1100L / adsDataRates[_dataRate] + 1;
+}
+
+
+int8_t TIADS1x15Manager::requestConversion(uint8_t channel, adsGain_t gain) {
+    int8_t ticket = -1;
+    for (uint8_t i = 0; i < MS_TIADS1X15_QUEUE_SIZE; i++) {
+        if (_slots[i].state == ADS_SLOT_FREE) {
+            ticket = i;
+            break;
+        }
+    }
+    if (ticket < 0) {
+        MS_DBG(F("The conversion queue for the ADS1x15 at 0x"),
+               String(_i2cAddress, HEX), F("is full!"));
+        return -1;
+    }
+    if (!_begun) {
+        Wire.begin();
+        _begun = true;
+    }
+
+    _slots[ticket].state   = ADS_SLOT_QUEUED;
+    _slots[ticket].channel = channel & 0x03;
+    _slots[ticket].gain    = gain;
+    _pending[(_pendingHead + _pendingCount) % MS_TIADS1X15_QUEUE_SIZE] =
+        ticket;
+    _pendingCount++;
+
+    service();
+    return ticket;
+}
+
+
+bool TIADS1x15Manager::isConversionReady(int8_t ticket) {
+    if (ticket < 0 || ticket >= MS_TIADS1X15_QUEUE_SIZE ||
+        _slots[ticket].state == ADS_SLOT_FREE) {
+        return true;
+    }
+    service();
+    return _slots[ticket].state == ADS_SLOT_DONE ||
+        _slots[ticket].state == ADS_SLOT_FAILED;
+}
+
+
+float TIADS1x15Manager::readVoltage(int8_t ticket) {
+    if (ticket < 0 || ticket >= MS_TIADS1X15_QUEUE_SIZE ||
+        _slots[ticket].state == ADS_SLOT_FREE) {
+        return -9999;
+    }
+
+    uint32_t start = millis();
+    while (!isConversionReady(ticket) &&
+           millis() - start < TIADS1X15_CONVERSION_TIMEOUT_MS) {
+        // wait
+    }
+
+    float    voltage = -9999;
+    adsSlot& slot    = _slots[ticket];
+    if (slot.state == ADS_SLOT_DONE) {
+        // The full scale range of each gain setting
+        float fullScale;
+        switch (slot.gain) {
+            case GAIN_TWOTHIRDS: fullScale = 6.144; break;
+            case GAIN_TWO: fullScale = 2.048; break;
+            case GAIN_FOUR: fullScale = 1.024; break;
+            case GAIN_EIGHT: fullScale = 0.512; break;
+            case GAIN_SIXTEEN: fullScale = 0.256; break;
+            case GAIN_ONE:
+            default: fullScale = 4.096; break;
+        }
+#ifndef MS_USE_ADS1015
+        voltage = slot.result * fullScale / 32768.0;
+#else
+        // The 12-bit result is left justified in the conversion register
+        voltage = (slot.result >> 4) * fullScale / 2048.0;
+#endif
+    } else {
+        MS_DBG(F("Conversion on channel"), slot.channel,
+               F("of the ADS1x15 at 0x"), String(_i2cAddress, HEX),
+               F("failed!"));
+    }
+    releaseConversion(ticket);
+    return voltage;
+}
+
+
+void TIADS1x15Manager::releaseConversion(int8_t ticket) {
+    // A conversion already on the ADC is left to finish; service() won't
+    // keep the result of a freed ticket
+    if (ticket >= 0 && ticket < MS_TIADS1X15_QUEUE_SIZE) {
+        _slots[ticket].state = ADS_SLOT_FREE;
+    }
+}
+
+
+void TIADS1x15Manager::service(void) {
+    if (_converting >= 0) {
+        adsSlot& slot = _slots[_converting];
+        if (conversionFinished()) {
+            uint16_t raw;
+            if (slot.state == ADS_SLOT_CONVERTING) {
+                if (readRegister(ADS_REG_CONVERSION, raw)) {
+                    slot.result = static_cast<int16_t>(raw);
+                    slot.state  = ADS_SLOT_DONE;
+                } else {
+                    slot.state = ADS_SLOT_FAILED;
+                }
+            }
+            _converting = -1;
+        } else if (micros() - _conversionStarted >
+                   TIADS1X15_CONVERSION_TIMEOUT_MS * 1000L) {
+            if (slot.state == ADS_SLOT_CONVERTING) {
+                slot.state = ADS_SLOT_FAILED;
+            }
+            _converting = -1;
+        }
+    }
+    if (_converting < 0) { startNext(); }
+}
+
+
+void TIADS1x15Manager::startNext(void) {
+    while (_pendingCount > 0) {
+        int8_t ticket = _pending[_pendingHead];
+        _pendingHead  = (_pendingHead + 1) % MS_TIADS1X15_QUEUE_SIZE;
+        _pendingCount--;
+        adsSlot& slot = _slots[ticket];
+        // Skip conversions released while they waited
+        if (slot.state != ADS_SLOT_QUEUED) { continue; }
+
+        if (_readyPin >= 0 && !_thresholdsSet) {
+            // A high threshold with its top bit set and a low threshold
+            // without makes ALERT/RDY a conversion ready output
+            _thresholdsSet = writeRegister(ADS_REG_HI_THRESH, 0x8000) &&
+                writeRegister(ADS_REG_LO_THRESH, 0x0000);
+        }
+        uint16_t config = ADS_CONFIG_OS_SINGLE |
+            (ADS_CONFIG_MUX_SINGLE_0 + (slot.channel << 12)) | slot.gain |
+            ADS_CONFIG_MODE_SINGLE | (_dataRate << 5) |
+            (_thresholdsSet ? ADS_CONFIG_CQUE_1CONV : ADS_CONFIG_CQUE_NONE);
+        if (writeRegister(ADS_REG_CONFIG, config)) {
+            // Allow for the ADC's clock being up to 10% slow
+            _conversionTime_us = 1100000L / adsDataRates[_dataRate] + 50;
+            _conversionStarted = micros();
+            _converting        = ticket;
+            slot.state         = ADS_SLOT_CONVERTING;
+            return;
+        }
+        slot.state = ADS_SLOT_FAILED;
+    }
+}
+
+
+bool TIADS1x15Manager::conversionFinished(void) {
+    uint32_t elapsed = micros() - _conversionStarted;
+    // ALERT/RDY goes low at the end of the conversion; if it hasn't by twice
+    // the conversion time, fall back to the config register
+    if (_thresholdsSet && elapsed < 2 * _conversionTime_us) {
+        return digitalRead(_readyPin) == LOW;
+    }
+    if (elapsed < _conversionTime_us) { return false; }
+    // The OS bit reads as 1 once the ADC is no longer converting
+    uint16_t config;
+    if (!readRegister(ADS_REG_CONFIG, config)) { return false; }
+    return config & ADS_CONFIG_OS_SINGLE;
+}
+
+
+bool TIADS1x15Manager::writeRegister(uint8_t reg, uint16_t value) {
+    Wire.beginTransmission(_i2cAddress);
+    Wire.write(reg);
+    Wire.write(static_cast<uint8_t>(value >> 8));
+    Wire.write(static_cast<uint8_t>(value & 0xFF));
+    return Wire.endTransmission() == 0;
+}
+
+
+bool TIADS1x15Manager::readRegister(uint8_t reg, uint16_t& value) {
+    Wire.beginTransmission(_i2cAddress);
+    Wire.write(reg);
+    if (Wire.endTransmission() != 0) { return false; }
+    if (Wire.requestFrom(_i2cAddress, static_cast<uint8_t>(2)) != 2) {
+        return false;
+    }
+    uint8_t high = Wire.read();
+    uint8_t low  = Wire.read();
+    value        = (static_cast<uint16_t>(high) << 8) | low;
+    return true;
+}
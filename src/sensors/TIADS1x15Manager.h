@@ -0,0 +1,222 @@
+/**
+ * @file TIADS1x15Manager.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the TIADS1x15Manager class, which shares a single TI
+ * ADS1115 or ADS1015 between all of the sensors attached to it.
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_TIADS1X15MANAGER_H_
+#define SRC_SENSORS_TIADS1X15MANAGER_H_
+
+// Debugging Statement
+// #define MS_TIADS1X15MANAGER_DEBUG
+
+#ifdef MS_TIADS1X15MANAGER_DEBUG
+#define MS_DEBUGGING_STD "TIADS1x15Manager"
+#endif
+
+/**
+ * @def MS_TIADS1X15_SHARED
+ * @brief Have the TIADS1x15, TurnerCyclops, CampbellOBS3, and ApogeeSQ212
+ * queue their conversions on a shared TIADS1x15Manager instead of each
+ * setting up the ADC and waiting out its own conversion.
+ *
+ * Each sensor queues its conversion when its measurement starts and the
+ * conversions for every sensor on the ADC run back to back while the logger
+ * does other work.  With a faster data rate set through
+ * TIADS1x15Manager::setDataRate(), averaged readings take a fraction of the
+ * time.
+ *
+ * @ingroup sensor_ads1x15
+ */
+// #define MS_TIADS1X15_SHARED
+
+/**
+ * @def MS_TIADS1X15_QUEUE_SIZE
+ * @brief The number of conversions that can be waiting on each ADS1x15.
+ *
+ * @ingroup sensor_ads1x15
+ */
+#ifndef MS_TIADS1X15_QUEUE_SIZE
+#define MS_TIADS1X15_QUEUE_SIZE 8
+#endif
+
+/**
+ * @brief The longest time in ms to wait for a queued conversion before giving
+ * up on it.
+ *
+ * @ingroup sensor_ads1x15
+ */
+#define TIADS1X15_CONVERSION_TIMEOUT_MS 250L
+
+// Included Dependencies
+#include "ModSensorDebugger.h"
+#undef MS_DEBUGGING_STD
+#include <Adafruit_ADS1015.h>
+
+
+/**
+ * @brief A TIADS1x15Manager owns one ADS1x15 and runs the single-shot
+ * conversions requested by all of the sensors attached to it, one after
+ * another.
+ *
+ * There is one manager for each of the four addresses the ADS1x15 can have;
+ * get it with getManager().  A sensor asks for a conversion with
+ * requestConversion() and gets back a ticket.  The conversion is started as
+ * soon as the ADC is free and its result is kept until the sensor collects it
+ * with readVoltage().
+ *
+ * The end of a conversion is found by reading the ADC's config register once
+ * the conversion time has passed, or, if setReadyPin() is given the pin wired
+ * to ALERT/RDY, by reading that pin without using the I2C bus at all.
+ *
+ * The ADC registers are written directly over Wire here; the Adafruit library
+ * is only used for its gain settings.
+ *
+ * @ingroup sensor_ads1x15
+ */
+class TIADS1x15Manager {
+ public:
+    /**
+     * @brief Get the manager for the ADS1x15 at an address.
+     *
+     * @param i2cAddress The I2C address of the ADS1x15, 0x48 to 0x4B
+     * @return **TIADS1x15Manager*** The manager for that address.
+     */
+    static TIADS1x15Manager* getManager(uint8_t i2cAddress);
+
+    /**
+     * @brief Set the data rate for later conversions.
+     *
+     * The slowest rate at least as fast as the one asked for is used; the
+     * ADS1115 can run at 8 to 860 samples per second and the ADS1015 at 128
+     * to 3300.  The default is 128 (ADS1115) or 1600 (ADS1015), as in the
+     * Adafruit library.
+     *
+     * @param samplesPerSecond The data rate
+     */
+    void setDataRate(uint16_t samplesPerSecond);
+    /**
+     * @brief Use the ADC's ALERT/RDY pin to find the end of each conversion.
+     *
+     * @param readyPin The MCU pin connected to ALERT/RDY; -1 to read the
+     * config register instead
+     */
+    void setReadyPin(int8_t readyPin);
+    /**
+     * @brief Get the time one conversion takes at the current data rate.
+     *
+     * @return **uint32_t** The conversion time in ms, allowing for the ADC's
+     * clock being up to 10% slow.
+     */
+    uint32_t getConversionTime(void);
+
+    /**
+     * @brief Queue a single-ended conversion.
+     *
+     * @param channel The ADC channel, 0 to 3
+     * @param gain The programmable gain for the conversion
+     * @return **int8_t** A ticket for the conversion, or -1 if the queue is
+     * full.
+     */
+    int8_t requestConversion(uint8_t channel, adsGain_t gain = GAIN_ONE);
+    /**
+     * @brief Check if a queued conversion is finished, starting the next
+     * conversion on the ADC if the last one is.
+     *
+     * @param ticket The ticket from requestConversion()
+     * @return **bool** True if the result is ready or the ticket isn't valid.
+     */
+    bool isConversionReady(int8_t ticket);
+    /**
+     * @brief Collect the result of a queued conversion, waiting for it if it
+     * isn't finished, and free its ticket.
+     *
+     * @param ticket The ticket from requestConversion()
+     * @return **float** The voltage, or -9999 if the conversion failed.
+     */
+    float readVoltage(int8_t ticket);
+    /**
+     * @brief Drop a queued conversion without collecting its result.
+     *
+     * @param ticket The ticket from requestConversion()
+     */
+    void releaseConversion(int8_t ticket);
+
+ private:
+    /**
+     * @brief The states of a queued conversion
+     */
+    typedef enum {
+        ADS_SLOT_FREE = 0,    ///< The ticket isn't in use
+        ADS_SLOT_QUEUED,      ///< Waiting for the ADC
+        ADS_SLOT_CONVERTING,  ///< Being converted
+        ADS_SLOT_DONE,        ///< Finished, holding its result
+        ADS_SLOT_FAILED       ///< The ADC didn't answer
+    } adsSlotState;
+
+    /**
+     * @brief A queued conversion
+     */
+    typedef struct {
+        adsSlotState state;
+        uint8_t      channel;
+        adsGain_t    gain;
+        int16_t      result;
+    } adsSlot;
+
+    TIADS1x15Manager() {}
+
+    /**
+     * @brief Finish the conversion on the ADC if it's done and start the next
+     * queued one.
+     */
+    void service(void);
+    /**
+     * @brief Start the oldest queued conversion.
+     */
+    void startNext(void);
+    /**
+     * @brief Check if the conversion on the ADC is finished.
+     *
+     * @return **bool** True if the conversion is finished.
+     */
+    bool conversionFinished(void);
+    /**
+     * @brief Write a 16-bit ADC register.
+     *
+     * @param reg The register pointer
+     * @param value The value to write
+     * @return **bool** True if the ADC acknowledged the write.
+     */
+    bool writeRegister(uint8_t reg, uint16_t value);
+    /**
+     * @brief Read a 16-bit ADC register.
+     *
+     * @param reg The register pointer
+     * @param value The value read
+     * @return **bool** True if the register was read.
+     */
+    bool readRegister(uint8_t reg, uint16_t& value);
+
+    static TIADS1x15Manager _managers[4];
+
+    uint8_t  _i2cAddress        = 0x48;
+    bool     _begun             = false;
+    int8_t   _readyPin          = -1;
+    bool     _thresholdsSet     = false;
+    uint8_t  _dataRate          = 4;
+    uint32_t _conversionTime_us = 0;
+    uint32_t _conversionStarted = 0;
+    int8_t   _converting        = -1;
+    adsSlot  _slots[MS_TIADS1X15_QUEUE_SIZE] = {};
+    int8_t   _pending[MS_TIADS1X15_QUEUE_SIZE];
+    uint8_t  _pendingHead  = 0;
+    uint8_t  _pendingCount = 0;
+};
+
+#endif  // SRC_SENSORS_TIADS1X15MANAGER_H_
@@ -0,0 +1,74 @@
+/**
+ * @file TIADS1x15Parent.cpp
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Implements the TIADS1x15Parent class.
+ */
+
+#include "TIADS1x15Parent.h"
+
+
+// The constructor - need the sensor timing, the power pin, and where the
+// sensor is on the ADC
+TIADS1x15Parent::TIADS1x15Parent(const char* sensorName,
+                                 uint8_t     totalReturnedValues,
+                                 uint32_t    warmUpTime_ms,
+                                 uint32_t    stabilizationTime_ms,
+                                 uint32_t    measurementTime_ms,
+                                 int8_t powerPin, uint8_t adsChannel,
+                                 uint8_t i2cAddress,
+                                 uint8_t measurementsToAverage,
+                                 uint8_t incCalcValues)
+    : Sensor(sensorName, totalReturnedValues, warmUpTime_ms,
+             stabilizationTime_ms, measurementTime_ms, powerPin, -1,
+             measurementsToAverage, incCalcValues),
+      _adsChannel(adsChannel),
+      _i2cAddress(i2cAddress) {}
+// Destructor
+TIADS1x15Parent::~TIADS1x15Parent() {}
+
+
+#ifdef MS_TIADS1X15_SHARED
+bool TIADS1x15Parent::startSingleMeasurement(void) {
+    TIADS1x15Manager* ads = TIADS1x15Manager::getManager(_i2cAddress);
+    // Drop a conversion that was never collected
+    ads->releaseConversion(_adsTicket);
+    _adsTicket = -1;
+    if (!Sensor::startSingleMeasurement()) { return false; }
+
+    _adsTicket = ads->requestConversion(_adsChannel, GAIN_ONE);
+    if (_adsTicket < 0) {
+        _millisMeasurementRequested = 0;
+        _sensorStatus &= 0b10111111;
+        return false;
+    }
+    return true;
+}
+
+
+bool TIADS1x15Parent::isMeasurementComplete(bool debug) {
+    if (!bitRead(_sensorStatus, 6)) {
+        return Sensor::isMeasurementComplete(debug);
+    }
+    TIADS1x15Manager* ads = TIADS1x15Manager::getManager(_i2cAddress);
+    if (ads->isConversionReady(_adsTicket)) return true;
+    // Once the measurement time has passed, check back after another
+    // conversion instead of polling the ADC until it's done
+    if (Sensor::isMeasurementComplete(false)) {
+        nextMeasurementStep(ads->getConversionTime());
+    }
+    return false;
+}
+
+
+float TIADS1x15Parent::readQueuedVoltage(void) {
+    float adcVoltage =
+        TIADS1x15Manager::getManager(_i2cAddress)->readVoltage(_adsTicket);
+    _adsTicket = -1;
+    MS_DBG(F("  Queued conversion on channel"), _adsChannel, F(":"),
+           adcVoltage);
+    return adcVoltage;
+}
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file TIADS1x15Parent.h
+ * @copyright Stroud Water Research Center
+ * Part of the EnviroDIY ModularSensors library for Arduino.
+ * This library is published under the BSD-3 license.
+ *
+ * @brief Contains the TIADS1x15Parent sensor subclass, itself used as a parent
+ * class for the sensors read through a TI ADS1115 or ADS1015.
+ */
+
+// Header Guards
+#ifndef SRC_SENSORS_TIADS1X15PARENT_H_
+#define SRC_SENSORS_TIADS1X15PARENT_H_
+
+// Included Dependencies
+#include "SensorBase.h"
+#include "TIADS1x15Manager.h"
+
+
+/**
+ * @brief The Sensor sub-class that all sensors read through a TI ADS1x15
+ * inherit from.
+ *
+ * It keeps the channel and address of the ADC.  With #MS_TIADS1X15_SHARED it
+ * queues a conversion on the TIADS1x15Manager for the ADC when each
+ * measurement starts and reports the measurement complete once the
+ * conversion is done.
+ *
+ * @ingroup sensor_ads1x15
+ */
+class TIADS1x15Parent : public Sensor {
+ public:
+    /**
+     * @brief Construct a new TIADS1x15Parent object.  This is only intended
+     * to be used within this library.
+     *
+     * @param sensorName The name of the sensor
+     * @param totalReturnedValues The number of values the sensor returns
+     * @param warmUpTime_ms The time in ms between when the sensor is powered
+     * on and when it is ready to receive a wake command.
+     * @param stabilizationTime_ms The time in ms between when the sensor
+     * receives a wake command and when it is able to return stable values.
+     * @param measurementTime_ms The time in ms between when a measurement is
+     * started and when the result value is available.
+     * @param powerPin The pin on the mcu controlling power to the sensor.  Use
+     * -1 if it is continuously powered.
+     * @param adsChannel The analog data channel _on the TI ADS1x15_ that the
+     * sensor is connected to (0-3).
+     * @param i2cAddress The I2C address of the ADS 1x15
+     * @param measurementsToAverage The number of measurements to take and
+     * average before giving a "final" result from the sensor.
+     * @param incCalcValues The number of included calculated variables
+     */
+    TIADS1x15Parent(const char* sensorName, uint8_t totalReturnedValues,
+                    uint32_t warmUpTime_ms, uint32_t stabilizationTime_ms,
+                    uint32_t measurementTime_ms, int8_t powerPin,
+                    uint8_t adsChannel, uint8_t i2cAddress,
+                    uint8_t measurementsToAverage, uint8_t incCalcValues);
+    /**
+     * @brief Destroy the TIADS1x15Parent object
+     */
+    virtual ~TIADS1x15Parent();
+
+#ifdef MS_TIADS1X15_SHARED
+    /**
+     * @copydoc Sensor::startSingleMeasurement()
+     *
+     * This queues a conversion on the TIADS1x15Manager for the ADC.
+     */
+    bool startSingleMeasurement(void) override;
+    /**
+     * @copydoc Sensor::isMeasurementComplete(bool debug)
+     *
+     * The measurement is complete once the queued conversion is finished.
+     * If it isn't by the end of the measurement time, the sensor is next
+     * checked one conversion time later.
+     */
+    bool isMeasurementComplete(bool debug = false) override;
+#endif
+
+ protected:
+#ifdef MS_TIADS1X15_SHARED
+    /**
+     * @brief Collect the voltage of the conversion queued when the
+     * measurement started.
+     *
+     * @return **float** The voltage, or -9999 if there was no conversion.
+     */
+    float readQueuedVoltage(void);
+    /**
+     * @brief The ticket of the queued conversion, or -1 if there's none
+     */
+    int8_t _adsTicket = -1;
+#endif
+    /**
+     * @brief The channel of the ADC the sensor is connected to
+     */
+    uint8_t _adsChannel;
+    /**
+     * @brief The I2C address of the ADC
+     */
+    uint8_t _i2cAddress;
+};
+
+#endif  // SRC_SENSORS_TIADS1X15PARENT_H_
@@ -18,14 +18,18 @@ TIINA219::TIINA219(TwoWire* theI2C, int8_t powerPin, uint8_t i2cAddressHex,
              INA219_STABILIZATION_TIME_MS, INA219_MEASUREMENT_TIME_MS, powerPin,
              -1, measurementsToAverage),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(theI2C) {}
+      _i2c(theI2C) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 TIINA219::TIINA219(int8_t powerPin, uint8_t i2cAddressHex,
                    uint8_t measurementsToAverage)
     : Sensor("TIINA219", INA219_NUM_VARIABLES, INA219_WARM_UP_TIME_MS,
              INA219_STABILIZATION_TIME_MS, INA219_MEASUREMENT_TIME_MS, powerPin,
              -1, measurementsToAverage, INA219_INC_CALC_VARIABLES),
       _i2cAddressHex(i2cAddressHex),
-      _i2c(&Wire) {}
+      _i2c(&Wire) {
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(_i2c));
+}
 // Destructor
 TIINA219::~TIINA219() {}
 
@@ -70,6 +74,12 @@ bool TIINA219::wake(void) {
 }
 
 
+float TIINA219::readCurrent(void) {
+    if (!bitRead(_sensorStatus, 0)) return NAN;
+    return ina219_phy.getCurrent_mA();
+}
+
+
 bool TIINA219::addSingleMeasurementResult(void) {
     bool success = false;
 
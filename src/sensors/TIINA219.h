@@ -134,10 +134,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "electricCurrent"
-#define INA219_CURRENT_MA_VAR_NAME "electricCurrent"
+#define INA219_CURRENT_MA_VAR_NAME MS_VAR_TEXT("electricCurrent")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "milliamp"
-#define INA219_CURRENT_MA_UNIT_NAME "milliamp"
+#define INA219_CURRENT_MA_UNIT_NAME MS_VAR_TEXT("milliamp")
 /// @brief Default variable short code; "TIINA219Amp"
 #define INA219_CURRENT_MA_DEFAULT_CODE "TIINA219Amp"
 /**@}*/
@@ -160,10 +160,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "voltage"
-#define INA219_BUS_VOLTAGE_VAR_NAME "voltage"
+#define INA219_BUS_VOLTAGE_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "volt"
-#define INA219_BUS_VOLTAGE_UNIT_NAME "volt"
+#define INA219_BUS_VOLTAGE_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "TIINA219Volt"
 #define INA219_BUS_VOLTAGE_DEFAULT_CODE "TIINA219Volt"
 /**@}*/
@@ -184,10 +184,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "electricPower"
-#define INA219_POWER_MW_VAR_NAME "electricPower"
+#define INA219_POWER_MW_VAR_NAME MS_VAR_TEXT("electricPower")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "milliwatt"
-#define INA219_POWER_MW_UNIT_NAME "milliwatt"
+#define INA219_POWER_MW_UNIT_NAME MS_VAR_TEXT("milliwatt")
 /// @brief Default variable short code; "TIINA219Power"
 #define INA219_POWER_MW_DEFAULT_CODE "TIINA219Power"
 /**@}*/
@@ -281,6 +281,19 @@ class TIINA219 : public Sensor {
      */
     bool addSingleMeasurementResult(void) override;
 
+    /**
+     * @brief Read the current from the INA219 right away, outside of any
+     * measurement.
+     *
+     * The INA219 must be powered and set up.  Wrapped in a plain function,
+     * this can be given to LoggerProfiler::setCurrentSource() to account for
+     * the energy of each logging cycle (#MS_LOGGER_ENERGY).
+     *
+     * @return **float** The current in mA, or NaN if the INA219 was never set
+     * up.
+     */
+    float readCurrent(void);
+
  private:
     /**
      * @brief Private reference to the internal INA219 object.
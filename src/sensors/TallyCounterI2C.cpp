@@ -17,7 +17,10 @@ TallyCounterI2C::TallyCounterI2C(int8_t powerPin, uint8_t i2cAddressHex)
     : Sensor("TallyCounterI2C", TALLY_NUM_VARIABLES, TALLY_WARM_UP_TIME_MS,
              TALLY_STABILIZATION_TIME_MS, TALLY_MEASUREMENT_TIME_MS, powerPin,
              -1, 1, TALLY_INC_CALC_VARIABLES),
-      _i2cAddressHex(i2cAddressHex) {}
+      _i2cAddressHex(i2cAddressHex) {
+    // The Tally library only uses the default Wire instance
+    setBus(SENSOR_BUS_I2C, reinterpret_cast<uintptr_t>(&Wire));
+}
 // Destructor
 TallyCounterI2C::~TallyCounterI2C() {}
 
@@ -132,10 +132,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "counter"
-#define TALLY_EVENTS_VAR_NAME "counter"
+#define TALLY_EVENTS_VAR_NAME MS_VAR_TEXT("counter")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "event"
-#define TALLY_EVENTS_UNIT_NAME "event"
+#define TALLY_EVENTS_UNIT_NAME MS_VAR_TEXT("event")
 /// @brief Default variable short code; "TallyCounterI2CEvents"
 #define TALLY_EVENTS_DEFAULT_CODE "TallyCounterI2CEvents"
 /**@}*/
@@ -17,14 +17,15 @@
 TurnerCyclops::TurnerCyclops(int8_t powerPin, uint8_t adsChannel,
                              float conc_std, float volt_std, float volt_blank,
                              uint8_t i2cAddress, uint8_t measurementsToAverage)
-    : Sensor("TurnerCyclops", CYCLOPS_NUM_VARIABLES, CYCLOPS_WARM_UP_TIME_MS,
-             CYCLOPS_STABILIZATION_TIME_MS, CYCLOPS_MEASUREMENT_TIME_MS,
-             powerPin, -1, measurementsToAverage, CYCLOPS_INC_CALC_VARIABLES),
-      _adsChannel(adsChannel),
+    : TIADS1x15Parent("TurnerCyclops", CYCLOPS_NUM_VARIABLES,
+                      CYCLOPS_WARM_UP_TIME_MS, CYCLOPS_STABILIZATION_TIME_MS,
+                      CYCLOPS_MEASUREMENT_TIME_MS, powerPin, adsChannel,
+                      i2cAddress, measurementsToAverage,
+                      CYCLOPS_INC_CALC_VARIABLES),
       _conc_std(conc_std),
       _volt_std(volt_std),
       _volt_blank(volt_blank),
-      _i2cAddress(i2cAddress) {}
+      _slope(conc_std / (volt_std - volt_blank)) {}
 // Destructor
 TurnerCyclops::~TurnerCyclops() {}
 
@@ -52,6 +53,14 @@ bool TurnerCyclops::addSingleMeasurementResult(void) {
     if (bitRead(_sensorStatus, 6)) {
         MS_DBG(getSensorNameAndLocation(), F("is reporting:"));
 
+        // Print out the calibration curve
+        MS_DBG(F("  Input calibration Curve:"), _volt_std, F("V at"), _conc_std,
+               F(".  "), _volt_blank, F("V blank."));
+
+#ifdef MS_TIADS1X15_SHARED
+        // Collect the conversion queued when the measurement started
+        adcVoltage = readQueuedVoltage();
+#else
 // Create an Auxillary ADD object
 // We create and set up the ADC object here so that each sensor using
 // the ADC may set the gain appropriately without effecting others.
@@ -77,10 +86,6 @@ bool TurnerCyclops::addSingleMeasurementResult(void) {
         // Begin ADC
         ads.begin();
 
-        // Print out the calibration curve
-        MS_DBG(F("  Input calibration Curve:"), _volt_std, F("V at"), _conc_std,
-               F(".  "), _volt_blank, F("V blank."));
-
         // Read Analog to Digital Converter (ADC)
         // Taking this reading includes the 8ms conversion delay.
         // We're allowing the ADS1115 library to do the bit-to-volts conversion
@@ -89,12 +94,12 @@ bool TurnerCyclops::addSingleMeasurementResult(void) {
             ads.readADC_SingleEnded_V(_adsChannel);  // Getting the reading
         MS_DBG(F("  ads.readADC_SingleEnded_V("), _adsChannel, F("):"),
                adcVoltage);
+#endif
 
         if (adcVoltage < 3.6 && adcVoltage > -0.3) {
             // Skip results out of range
             // Apply the unique calibration curve for the given sensor
-            calibResult = (_conc_std / (_volt_std - _volt_blank)) *
-                (adcVoltage - _volt_blank);
+            calibResult = _slope * (adcVoltage - _volt_blank);
             MS_DBG(F("  calibResult:"), calibResult);
         } else {  // set invalid voltages back to -9999
             adcVoltage = -9999;
@@ -140,7 +140,7 @@
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #include "VariableBase.h"
-#include "SensorBase.h"
+#include "TIADS1x15Parent.h"
 
 // Sensor Specific Defines
 /** @ingroup sensor_cyclops */
@@ -226,10 +226,10 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "voltage"
-#define CYCLOPS_VOLTAGE_VAR_NAME "voltage"
+#define CYCLOPS_VOLTAGE_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "volt"
-#define CYCLOPS_VOLTAGE_UNIT_NAME "volt"
+#define CYCLOPS_VOLTAGE_UNIT_NAME MS_VAR_TEXT("volt")
 /// @brief Default variable short code; "CyclopsVoltage"
 #define CYCLOPS_VOLTAGE_DEFAULT_CODE "CyclopsVoltage"
 
@@ -257,7 +257,7 @@
  * @ingroup sensor_cyclops
  */
 /* clang-format on */
-class TurnerCyclops : public Sensor {
+class TurnerCyclops : public TIADS1x15Parent {
  public:
     // The constructor - need the power pin, the ADS1X15 data channel, and the
     // calibration info
@@ -329,9 +329,69 @@ class TurnerCyclops : public Sensor {
     bool addSingleMeasurementResult(void) override;
 
  private:
-    uint8_t _adsChannel;
-    float   _conc_std, _volt_std, _volt_blank;
-    uint8_t _i2cAddress;
+    float _conc_std, _volt_std, _volt_blank;
+    /**
+     * @brief The concentration per volt of the calibration, worked out once
+     * from the standard and the blank
+     */
+    float _slope;
+};
+
+
+/**
+ * @brief The shared base of the Variable sub-classes for the calibrated
+ * [output](@ref sensor_cyclops_output) of each variant of the
+ * [Turner Cyclops-7F](@ref sensor_cyclops).
+ *
+ * Every variant reports its concentration as the same result of the
+ * TurnerCyclops at the same resolution, so only the name, unit, and default
+ * code differ between them.  The sub-classes give their name and unit with
+ * MS_VAR_TEXT(), so with #MS_VARIABLE_METADATA_PROGMEM they're kept in flash
+ * instead of RAM.
+ *
+ * @ingroup sensor_cyclops
+ */
+class TurnerCyclops_Output : public Variable {
+ protected:
+    /**
+     * @brief Construct a new TurnerCyclops_Output object.
+     *
+     * @tparam TextType The type of the name and unit; text in RAM or in
+     * flash.
+     * @param parentSense The parent TurnerCyclops providing the result
+     * values.
+     * @param varName The variable name of the variant
+     * @param varUnit The unit of the variant
+     * @param varCode A short code to help identify the variable in files.
+     * @param uuid A universally unique identifier (UUID or GUID) for the
+     * variable.
+     */
+    template <typename TextType>
+    TurnerCyclops_Output(TurnerCyclops* parentSense, TextType varName,
+                         TextType varUnit, const char* varCode,
+                         const char* uuid)
+        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
+                   (uint8_t)CYCLOPS_RESOLUTION, varName, varUnit, varCode,
+                   uuid) {}
+    /**
+     * @brief Construct a new TurnerCyclops_Output object that must be tied
+     * with a parent TurnerCyclops before it can be used.
+     *
+     * @tparam TextType The type of the name and unit; text in RAM or in
+     * flash.
+     * @param varName The variable name of the variant
+     * @param varUnit The unit of the variant
+     * @param varCode A short code to help identify the variable in files.
+     */
+    template <typename TextType>
+    TurnerCyclops_Output(TextType varName, TextType varUnit,
+                         const char* varCode)
+        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
+                   varName, varUnit, varCode) {}
+    /**
+     * @brief Destroy the TurnerCyclops_Output object - no action needed.
+     */
+    ~TurnerCyclops_Output() {}
 };
 
 
@@ -407,7 +467,7 @@ class TurnerCyclops_Voltage : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Chlorophyll : public Variable {
+class TurnerCyclops_Chlorophyll : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Chlorophyll object.
@@ -422,9 +482,10 @@ class TurnerCyclops_Chlorophyll : public Variable {
     explicit TurnerCyclops_Chlorophyll(
         TurnerCyclops* parentSense, const char* uuid = "",
         const char* varCode = "CyclopsChlorophyll")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "chlorophyllFluorescence",
-                   "microgramPerLiter", varCode, uuid) {}
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("chlorophyllFluorescence"),
+                               MS_VAR_TEXT("microgramPerLiter"),
+                               varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Chlorophyll object.
      *
@@ -432,9 +493,9 @@ class TurnerCyclops_Chlorophyll : public Variable {
      * used.
      */
     TurnerCyclops_Chlorophyll()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "chlorophyllFluorescence", "microgramPerLiter",
-                   "CyclopsChlorophyll") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("chlorophyllFluorescence"),
+                               MS_VAR_TEXT("microgramPerLiter"),
+                               "CyclopsChlorophyll") {}
     ~TurnerCyclops_Chlorophyll() {}
 };
 
@@ -460,7 +521,7 @@ class TurnerCyclops_Chlorophyll : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Rhodamine : public Variable {
+class TurnerCyclops_Rhodamine : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Rhodamine object.
@@ -472,12 +533,12 @@ class TurnerCyclops_Rhodamine : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsRhodamine".
      */
-    explicit TurnerCyclops_Rhodamine(TurnerCyclops* parentSense,
-                                     const char*    uuid = "",
-                                     const char* varCode = "CyclopsRhodamine")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "RhodamineFluorescence",
-                   "partPerBillion", varCode, uuid) {}
+    explicit TurnerCyclops_Rhodamine(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsRhodamine")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("RhodamineFluorescence"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Rhodamine object.
      *
@@ -485,9 +546,9 @@ class TurnerCyclops_Rhodamine : public Variable {
      * used.
      */
     TurnerCyclops_Rhodamine()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "RhodamineFluorescence", "partPerBillion",
-                   "CyclopsRhodamine") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("RhodamineFluorescence"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsRhodamine") {}
     ~TurnerCyclops_Rhodamine() {}
 };
 
@@ -513,7 +574,7 @@ class TurnerCyclops_Rhodamine : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Fluorescein : public Variable {
+class TurnerCyclops_Fluorescein : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Fluorescein object.
@@ -528,9 +589,9 @@ class TurnerCyclops_Fluorescein : public Variable {
     explicit TurnerCyclops_Fluorescein(
         TurnerCyclops* parentSense, const char* uuid = "",
         const char* varCode = "CyclopsFluorescein")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "fluorescein", "partPerBillion",
-                   varCode, uuid) {}
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("fluorescein"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Fluorescein object.
      *
@@ -538,8 +599,9 @@ class TurnerCyclops_Fluorescein : public Variable {
      * used.
      */
     TurnerCyclops_Fluorescein()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "fluorescein", "partPerBillion", "CyclopsFluorescein") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("fluorescein"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsFluorescein") {}
     ~TurnerCyclops_Fluorescein() {}
 };
 
@@ -566,7 +628,7 @@ class TurnerCyclops_Fluorescein : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Phycocyanin : public Variable {
+class TurnerCyclops_Phycocyanin : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Phycocyanin object.
@@ -581,10 +643,10 @@ class TurnerCyclops_Phycocyanin : public Variable {
     explicit TurnerCyclops_Phycocyanin(
         TurnerCyclops* parentSense, const char* uuid = "",
         const char* varCode = "CyclopsPhycocyanin")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION,
-                   "blue_GreenAlgae_Cyanobacteria_Phycocyanin",
-                   "partPerBillion", varCode, uuid) {}
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT(
+                                   "blue_GreenAlgae_Cyanobacteria_Phycocyanin"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Phycocyanin object.
      *
@@ -592,9 +654,10 @@ class TurnerCyclops_Phycocyanin : public Variable {
      * used.
      */
     TurnerCyclops_Phycocyanin()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "blue_GreenAlgae_Cyanobacteria_Phycocyanin",
-                   "partPerBillion", "CyclopsPhycocyanin") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT(
+                                   "blue_GreenAlgae_Cyanobacteria_Phycocyanin"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsPhycocyanin") {}
     ~TurnerCyclops_Phycocyanin() {}
 };
 
@@ -621,7 +684,7 @@ class TurnerCyclops_Phycocyanin : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Phycoerythrin : public Variable {
+class TurnerCyclops_Phycoerythrin : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Phycoerythrin object.
@@ -636,9 +699,9 @@ class TurnerCyclops_Phycoerythrin : public Variable {
     explicit TurnerCyclops_Phycoerythrin(
         TurnerCyclops* parentSense, const char* uuid = "",
         const char* varCode = "CyclopsPhycoerythrin")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "phycoerythrin",
-                   "partPerBillion", varCode, uuid) {}
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("phycoerythrin"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Phycoerythrin object.
      *
@@ -646,8 +709,9 @@ class TurnerCyclops_Phycoerythrin : public Variable {
      * used.
      */
     TurnerCyclops_Phycoerythrin()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "phycoerythrin", "partPerBillion", "CyclopsPhycoerythrin") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("phycoerythrin"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsPhycoerythrin") {}
     ~TurnerCyclops_Phycoerythrin() {}
 };
 
@@ -677,7 +741,7 @@ class TurnerCyclops_Phycoerythrin : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_CDOM : public Variable {
+class TurnerCyclops_CDOM : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_CDOM object.
@@ -689,13 +753,13 @@ class TurnerCyclops_CDOM : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsCDOM".
      */
-    explicit TurnerCyclops_CDOM(TurnerCyclops* parentSense,
-                                const char*    uuid    = "",
-                                const char*    varCode = "CyclopsCDOM")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION,
-                   "fluorescenceDissolvedOrganicMatter", "partPerBillion",
-                   varCode, uuid) {}
+    explicit TurnerCyclops_CDOM(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsCDOM")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT(
+                                   "fluorescenceDissolvedOrganicMatter"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_CDOM object.
      *
@@ -703,9 +767,9 @@ class TurnerCyclops_CDOM : public Variable {
      * used.
      */
     TurnerCyclops_CDOM()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "fluorescenceDissolvedOrganicMatter", "partPerBillion",
-                   "CyclopsCDOM") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT(
+                                   "fluorescenceDissolvedOrganicMatter"),
+                               MS_VAR_TEXT("partPerBillion"), "CyclopsCDOM") {}
     ~TurnerCyclops_CDOM() {}
 };
 
@@ -733,7 +797,7 @@ class TurnerCyclops_CDOM : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_CrudeOil : public Variable {
+class TurnerCyclops_CrudeOil : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_CrudeOil object.
@@ -745,12 +809,12 @@ class TurnerCyclops_CrudeOil : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsCrudeOil".
      */
-    explicit TurnerCyclops_CrudeOil(TurnerCyclops* parentSense,
-                                    const char*    uuid    = "",
-                                    const char*    varCode = "CyclopsCrudeOil")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "petroleumHydrocarbonTotal",
-                   "partPerBillion", varCode, uuid) {}
+    explicit TurnerCyclops_CrudeOil(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsCrudeOil")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("petroleumHydrocarbonTotal"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_CrudeOil object.
      *
@@ -758,9 +822,9 @@ class TurnerCyclops_CrudeOil : public Variable {
      * used.
      */
     TurnerCyclops_CrudeOil()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "petroleumHydrocarbonTotal", "partPerBillion",
-                   "CyclopsCrudeOil") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("petroleumHydrocarbonTotal"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsCrudeOil") {}
     ~TurnerCyclops_CrudeOil() {}
 };
 
@@ -789,7 +853,7 @@ class TurnerCyclops_CrudeOil : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Brighteners : public Variable {
+class TurnerCyclops_Brighteners : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Brighteners object.
@@ -804,9 +868,9 @@ class TurnerCyclops_Brighteners : public Variable {
     explicit TurnerCyclops_Brighteners(
         TurnerCyclops* parentSense, const char* uuid = "",
         const char* varCode = "CyclopsOpticalBrighteners")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "opticalBrighteners",
-                   "partPerBillion", varCode, uuid) {}
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("opticalBrighteners"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Brighteners object.
      *
@@ -814,9 +878,9 @@ class TurnerCyclops_Brighteners : public Variable {
      * used.
      */
     TurnerCyclops_Brighteners()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "opticalBrighteners", "partPerBillion",
-                   "CyclopsOpticalBrighteners") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("opticalBrighteners"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsOpticalBrighteners") {}
     ~TurnerCyclops_Brighteners() {}
 };
 
@@ -842,7 +906,7 @@ class TurnerCyclops_Brighteners : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Turbidity : public Variable {
+class TurnerCyclops_Turbidity : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Turbidity object.
@@ -854,12 +918,13 @@ class TurnerCyclops_Turbidity : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsTurbidity".
      */
-    explicit TurnerCyclops_Turbidity(TurnerCyclops* parentSense,
-                                     const char*    uuid = "",
-                                     const char* varCode = "CyclopsTurbidity")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "Turbidity",
-                   "nephelometricTurbidityUnit", varCode, uuid) {}
+    explicit TurnerCyclops_Turbidity(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsTurbidity")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("Turbidity"),
+                               MS_VAR_TEXT("nephelometricTurbidityUnit"),
+                               varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Turbidity object.
      *
@@ -867,9 +932,9 @@ class TurnerCyclops_Turbidity : public Variable {
      * used.
      */
     TurnerCyclops_Turbidity()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "Turbidity", "nephelometricTurbidityUnit",
-                   "CyclopsTurbidity") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("Turbidity"),
+                               MS_VAR_TEXT("nephelometricTurbidityUnit"),
+                               "CyclopsTurbidity") {}
     ~TurnerCyclops_Turbidity() {}
 };
 
@@ -896,7 +961,7 @@ class TurnerCyclops_Turbidity : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_PTSA : public Variable {
+class TurnerCyclops_PTSA : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_PTSA object.
@@ -908,12 +973,12 @@ class TurnerCyclops_PTSA : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsPTSA".
      */
-    explicit TurnerCyclops_PTSA(TurnerCyclops* parentSense,
-                                const char*    uuid    = "",
-                                const char*    varCode = "CyclopsPTSA")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "ptsa", "partPerBillion",
-                   varCode, uuid) {}
+    explicit TurnerCyclops_PTSA(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsPTSA")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("ptsa"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_PTSA object.
      *
@@ -921,8 +986,8 @@ class TurnerCyclops_PTSA : public Variable {
      * used.
      */
     TurnerCyclops_PTSA()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "ptsa", "partPerBillion", "CyclopsPTSA") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("ptsa"),
+                               MS_VAR_TEXT("partPerBillion"), "CyclopsPTSA") {}
     ~TurnerCyclops_PTSA() {}
 };
 
@@ -949,7 +1014,7 @@ class TurnerCyclops_PTSA : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_BTEX : public Variable {
+class TurnerCyclops_BTEX : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_BTEX object.
@@ -961,12 +1026,12 @@ class TurnerCyclops_BTEX : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsBTEX".
      */
-    explicit TurnerCyclops_BTEX(TurnerCyclops* parentSense,
-                                const char*    uuid    = "",
-                                const char*    varCode = "CyclopsBTEX")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "btex", "partPerMillion",
-                   varCode, uuid) {}
+    explicit TurnerCyclops_BTEX(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsBTEX")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("btex"),
+                               MS_VAR_TEXT("partPerMillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_BTEX object.
      *
@@ -974,8 +1039,8 @@ class TurnerCyclops_BTEX : public Variable {
      * used.
      */
     TurnerCyclops_BTEX()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "btex", "partPerMillion", "CyclopsBTEX") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("btex"),
+                               MS_VAR_TEXT("partPerMillion"), "CyclopsBTEX") {}
     ~TurnerCyclops_BTEX() {}
 };
 
@@ -1001,7 +1066,7 @@ class TurnerCyclops_BTEX : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_Tryptophan : public Variable {
+class TurnerCyclops_Tryptophan : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_Tryptophan object.
@@ -1013,12 +1078,12 @@ class TurnerCyclops_Tryptophan : public Variable {
      * @param varCode A short code to help identify the variable in files;
      * optional with a default value of "CyclopsTryptophan".
      */
-    explicit TurnerCyclops_Tryptophan(TurnerCyclops* parentSense,
-                                      const char*    uuid = "",
-                                      const char* varCode = "CyclopsTryptophan")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "tryptophan", "partPerBillion",
-                   varCode, uuid) {}
+    explicit TurnerCyclops_Tryptophan(
+        TurnerCyclops* parentSense, const char* uuid = "",
+        const char* varCode = "CyclopsTryptophan")
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("tryptophan"),
+                               MS_VAR_TEXT("partPerBillion"), varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_Tryptophan object.
      *
@@ -1026,8 +1091,9 @@ class TurnerCyclops_Tryptophan : public Variable {
      * used.
      */
     TurnerCyclops_Tryptophan()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "tryptophan", "partPerBillion", "CyclopsTryptophan") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("tryptophan"),
+                               MS_VAR_TEXT("partPerBillion"),
+                               "CyclopsTryptophan") {}
     ~TurnerCyclops_Tryptophan() {}
 };
 
@@ -1054,7 +1120,7 @@ class TurnerCyclops_Tryptophan : public Variable {
  *
  * @ingroup sensor_cyclops
  */
-class TurnerCyclops_RedChlorophyll : public Variable {
+class TurnerCyclops_RedChlorophyll : public TurnerCyclops_Output {
  public:
     /**
      * @brief Construct a new TurnerCyclops_RedChlorophyll object.
@@ -1069,9 +1135,10 @@ class TurnerCyclops_RedChlorophyll : public Variable {
     explicit TurnerCyclops_RedChlorophyll(
         TurnerCyclops* parentSense, const char* uuid = "",
         const char* varCode = "CyclopsRedChlorophyll")
-        : Variable(parentSense, (const uint8_t)CYCLOPS_VAR_NUM,
-                   (uint8_t)CYCLOPS_RESOLUTION, "chlorophyllFluorescence",
-                   "microgramPerLiter", varCode, uuid) {}
+        : TurnerCyclops_Output(parentSense,
+                               MS_VAR_TEXT("chlorophyllFluorescence"),
+                               MS_VAR_TEXT("microgramPerLiter"),
+                               varCode, uuid) {}
     /**
      * @brief Construct a new TurnerCyclops_RedChlorophyll object.
      *
@@ -1079,9 +1146,9 @@ class TurnerCyclops_RedChlorophyll : public Variable {
      * used.
      */
     TurnerCyclops_RedChlorophyll()
-        : Variable((const uint8_t)CYCLOPS_VAR_NUM, (uint8_t)CYCLOPS_RESOLUTION,
-                   "chlorophyllFluorescence", "microgramPerLiter",
-                   "CyclopsRedChlorophyll") {}
+        : TurnerCyclops_Output(MS_VAR_TEXT("chlorophyllFluorescence"),
+                               MS_VAR_TEXT("microgramPerLiter"),
+                               "CyclopsRedChlorophyll") {}
     ~TurnerCyclops_RedChlorophyll() {}
 };
 /**@}*/
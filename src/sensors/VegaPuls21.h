@@ -115,11 +115,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "gageHeight"
-#define VEGAPULS21_STAGE_VAR_NAME "gageHeight"
+#define VEGAPULS21_STAGE_VAR_NAME MS_VAR_TEXT("gageHeight")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "meter" (m)
-#define VEGAPULS21_STAGE_UNIT_NAME "meter"
+#define VEGAPULS21_STAGE_UNIT_NAME MS_VAR_TEXT("meter")
 /// @brief Default variable short code; "VegaPulsStage"
 #define VEGAPULS21_STAGE_DEFAULT_CODE "VegaPulsStage"
 /**@}*/
@@ -141,11 +141,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "distance"
-#define VEGAPULS21_DISTANCE_VAR_NAME "distance"
+#define VEGAPULS21_DISTANCE_VAR_NAME MS_VAR_TEXT("distance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "meter" (m)
-#define VEGAPULS21_DISTANCE_UNIT_NAME "meter"
+#define VEGAPULS21_DISTANCE_UNIT_NAME MS_VAR_TEXT("meter")
 /// @brief Default variable short code; "VegaPulsDistance"
 #define VEGAPULS21_DISTANCE_DEFAULT_CODE "VegaPulsDistance"
 /**@}*/
@@ -166,11 +166,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define VEGAPULS21_TEMP_VAR_NAME "temperature"
+#define VEGAPULS21_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define VEGAPULS21_TEMP_UNIT_NAME "degreeCelsius"
+#define VEGAPULS21_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "VegaPulsTemp"
 #define VEGAPULS21_TEMP_DEFAULT_CODE "VegaPulsTemp"
 /**@}*/
@@ -191,11 +191,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "reliability"
-#define VEGAPULS21_RELIABILITY_VAR_NAME "reliability"
+#define VEGAPULS21_RELIABILITY_VAR_NAME MS_VAR_TEXT("reliability")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "decibel" (dB)
-#define VEGAPULS21_RELIABILITY_UNIT_NAME "decibel"
+#define VEGAPULS21_RELIABILITY_UNIT_NAME MS_VAR_TEXT("decibel")
 /// @brief Default variable short code; "VegaPulsReliability"
 #define VEGAPULS21_RELIABILITY_DEFAULT_CODE "VegaPulsReliability"
 /**@}*/
@@ -216,11 +216,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "instrumentStatusCode"
-#define VEGAPULS21_ERRORCODE_VAR_NAME "instrumentStatusCode"
+#define VEGAPULS21_ERRORCODE_VAR_NAME MS_VAR_TEXT("instrumentStatusCode")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "dimensionless"
-#define VEGAPULS21_ERRORCODE_UNIT_NAME "dimensionless"
+#define VEGAPULS21_ERRORCODE_UNIT_NAME MS_VAR_TEXT("dimensionless")
 /// @brief Default variable short code; "VegaPulsError"
 #define VEGAPULS21_ERRORCODE_DEFAULT_CODE "VegaPulsError"
 /**@}*/
@@ -25,7 +25,12 @@ YosemitechParent::YosemitechParent(
       _modbusAddress(modbusAddress),
       _stream(stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2) {
+    setBus(SENSOR_BUS_RS485, reinterpret_cast<uintptr_t>(_stream));
+#ifdef MS_MODBUS_SHARED
+    _modbusBus = ModbusBusManager::getManager(_stream);
+#endif
+}
 YosemitechParent::YosemitechParent(
     byte modbusAddress, Stream& stream, int8_t powerPin, int8_t powerPin2,
     int8_t enablePin, uint8_t measurementsToAverage, yosemitechModel model,
@@ -39,7 +44,12 @@ YosemitechParent::YosemitechParent(
       _modbusAddress(modbusAddress),
       _stream(&stream),
       _RS485EnablePin(enablePin),
-      _powerPin2(powerPin2) {}
+      _powerPin2(powerPin2) {
+    setBus(SENSOR_BUS_RS485, reinterpret_cast<uintptr_t>(_stream));
+#ifdef MS_MODBUS_SHARED
+    _modbusBus = ModbusBusManager::getManager(_stream);
+#endif
+}
 // Destructor
 YosemitechParent::~YosemitechParent() {}
 
@@ -56,7 +66,11 @@ String YosemitechParent::getSensorLocation(void) {
 bool YosemitechParent::setup(void) {
     bool retVal =
         Sensor::setup();  // this will set pin modes and the setup status bit
+#ifdef MS_MODBUS_SHARED
+    _modbusBus->setEnablePin(_RS485EnablePin);
+#else
     if (_RS485EnablePin >= 0) pinMode(_RS485EnablePin, OUTPUT);
+#endif
     if (_powerPin2 >= 0) pinMode(_powerPin2, OUTPUT);
 
 #ifdef MS_YOSEMITECHPARENT_DEBUG_DEEP
@@ -83,10 +97,21 @@ bool YosemitechParent::wake(void) {
     // Send the command to begin taking readings, trying up to 5 times
     bool    success = false;
     uint8_t ntries  = 0;
+#ifdef MS_MODBUS_SHARED
+    uint8_t maxTries = _modbusBus->getAttempts(_modbusAddress);
+#else
+    uint8_t maxTries = MODBUS_ATTEMPTS;
+#endif
     MS_DBG(F("Start Measurement on"), getSensorNameAndLocation());
-    while (!success && ntries < 5) {
+    while (!success && ntries < maxTries) {
         MS_DBG('(', ntries + 1, F("):"));
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->beginTransaction(_modbusAddress);
+#endif
         success = _ysensor.startMeasurement();
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->endTransaction(_modbusAddress, success);
+#endif
         ntries++;
     }
 
@@ -107,7 +132,14 @@ bool YosemitechParent::wake(void) {
     if (_model == Y511 || _model == Y514 || _model == Y551 || _model == Y560 ||
         _model == Y4000) {
         MS_DBG(F("Activate Brush on"), getSensorNameAndLocation());
-        if (_ysensor.activateBrush()) {
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->beginTransaction(_modbusAddress);
+#endif
+        bool brushed = _ysensor.activateBrush();
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->endTransaction(_modbusAddress, brushed);
+#endif
+        if (brushed) {
             MS_DBG(F("Brush activated."));
         } else {
             MS_DBG(F("Brush NOT activated!"));
@@ -127,13 +159,24 @@ bool YosemitechParent::sleep(void) {
         return true;
     }
 
-    // Send the command to begin taking readings, trying up to 5 times
+    // Send the command to stop taking readings, trying up to 5 times
     bool    success = false;
     uint8_t ntries  = 0;
+#ifdef MS_MODBUS_SHARED
+    uint8_t maxTries = _modbusBus->getAttempts(_modbusAddress);
+#else
+    uint8_t maxTries = MODBUS_ATTEMPTS;
+#endif
     MS_DBG(F("Stop Measurement on"), getSensorNameAndLocation());
-    while (!success && ntries < 5) {
+    while (!success && ntries < maxTries) {
         MS_DBG('(', ntries + 1, F("):"));
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->beginTransaction(_modbusAddress);
+#endif
         success = _ysensor.stopMeasurement();
+#ifdef MS_MODBUS_SHARED
+        _modbusBus->endTransaction(_modbusAddress, success);
+#endif
         ntries++;
     }
     if (success) {
@@ -206,6 +249,80 @@ void YosemitechParent::powerDown(void) {
 }
 
 
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+// Read the values and compare them to the last set read during this
+// activation
+bool YosemitechParent::probeStable(void) {
+    // Start over each time the sensor is activated
+    if (_stabilityCheckFor != _millisSensorActivated) {
+        _stabilityCheckFor       = _millisSensorActivated;
+        _millisLastStabilityRead = 0;
+        _stableChanges           = 0;
+        _haveStabilityValues     = false;
+    }
+    uint32_t sinceLastRead = millis() - _millisLastStabilityRead;
+    if (_millisLastStabilityRead != 0 &&
+        sinceLastRead < YOSEMITECH_STABILITY_INTERVAL_MS) {
+        return false;
+    }
+    _millisLastStabilityRead = millis();
+
+    // Only the parameters with no third value are compared on most sensors,
+    // but all eight values of the Y4000
+    float   values[8] = {-9999, -9999, -9999, -9999,
+                         -9999, -9999, -9999, -9999};
+    uint8_t nValues   = _model == Y4000 ? 8 : 2;
+    bool    success   = false;
+#ifdef MS_MODBUS_SHARED
+    _modbusBus->beginTransaction(_modbusAddress);
+#endif
+    if (_model == Y4000) {
+        success = _ysensor.getValues(values[0], values[1], values[2],
+                                     values[3], values[4], values[5],
+                                     values[6], values[7]);
+    } else {
+        success = _ysensor.getValues(values[0], values[1], values[2]);
+    }
+#ifdef MS_MODBUS_SHARED
+    _modbusBus->endTransaction(_modbusAddress, success);
+#endif
+    for (uint8_t i = 0; i < nValues; i++) {
+        if (isnan(values[i])) success = false;
+    }
+    if (!success) {
+        MS_DBG(getSensorNameAndLocation(), F("gave no values to compare"));
+        _stableChanges       = 0;
+        _haveStabilityValues = false;
+        return false;
+    }
+
+    bool settled = _haveStabilityValues;
+    for (uint8_t i = 0; i < nValues; i++) {
+        if (settled) {
+            float change = fabs(values[i] - _stabilityValues[i]);
+            float scale  = fabs(_stabilityValues[i]);
+            if (scale < 1) scale = 1;
+            if (change > _stabilityTolerance * scale) settled = false;
+        }
+        _stabilityValues[i] = values[i];
+    }
+    _haveStabilityValues = true;
+    _stableChanges       = settled ? _stableChanges + 1 : 0;
+    MS_DBG(getSensorNameAndLocation(), F("values"),
+           settled ? F("within") : F("outside"), F("tolerance;"),
+           _stableChanges, F("of"), YOSEMITECH_STABLE_READINGS,
+           F("changes in a row"));
+
+    return _stableChanges >= YOSEMITECH_STABLE_READINGS;
+}
+
+
+void YosemitechParent::setStabilityTolerance(float tolerance) {
+    _stabilityTolerance = tolerance;
+}
+#endif
+
+
 bool YosemitechParent::addSingleMeasurementResult(void) {
     bool success = false;
 
@@ -226,8 +343,14 @@ bool YosemitechParent::addSingleMeasurementResult(void) {
 
                 // Get Values
                 MS_DBG(F("Get Values from"), getSensorNameAndLocation());
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->beginTransaction(_modbusAddress);
+#endif
                 success = _ysensor.getValues(DOmgL, Turbidity, Cond, pH, Temp,
                                              ORP, Chlorophyll, BGA);
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->endTransaction(_modbusAddress, success);
+#endif
 
                 // Fix not-a-number values
                 if (!success || isnan(DOmgL)) DOmgL = -9999;
@@ -266,7 +389,13 @@ bool YosemitechParent::addSingleMeasurementResult(void) {
 
                 // Get Values
                 MS_DBG(F("Get Values from"), getSensorNameAndLocation());
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->beginTransaction(_modbusAddress);
+#endif
                 success = _ysensor.getValues(parmValue, tempValue, thirdValue);
+#ifdef MS_MODBUS_SHARED
+                _modbusBus->endTransaction(_modbusAddress, success);
+#endif
 
                 // Fix not-a-number values
                 if (!success || isnan(parmValue)) parmValue = -9999;
@@ -105,6 +105,10 @@
  * The library manually activates the brushes as part of the "wake" command.
  * There are currently no other ways to set the brushing interval in this library.
  *
+ * With `MS_ADAPTIVE_SENSOR_TIMING` and adaptive timing turned on for the sensor with Sensor::setAdaptiveTiming(), the stabilization time ends as soon as the readings settle.
+ * The sensor is read every `YOSEMITECH_STABILITY_INTERVAL_MS` once probing starts, and it is stable when `YOSEMITECH_STABLE_READINGS` changes in a row are all within the tolerance set by YosemitechParent::setStabilityTolerance().
+ * Give a stabilization floor (ie, 15000 ms) to setAdaptiveTiming() so that probing never starts before the sensor could possibly be stable.
+ *
  * The lower level details of the communication with the sensors is managed by the
  * [EnviroDIY Yosemitech library](https://github.com/EnviroDIY/YosemitechModbus)
  */
@@ -126,12 +130,28 @@
 #define MS_DEBUGGING_DEEP "YosemitechParent"
 #endif
 
+/**
+ * @brief The time in ms between the readings used to check that a Yosemitech
+ * sensor's values have settled.
+ */
+#ifndef YOSEMITECH_STABILITY_INTERVAL_MS
+#define YOSEMITECH_STABILITY_INTERVAL_MS 2000
+#endif
+/**
+ * @brief The number of changes in a row between readings that must be within
+ * the tolerance for a Yosemitech sensor to be stable.
+ */
+#ifndef YOSEMITECH_STABLE_READINGS
+#define YOSEMITECH_STABLE_READINGS 2
+#endif
+
 // Included Dependencies
 #include "ModSensorDebugger.h"
 #undef MS_DEBUGGING_STD
 #undef MS_DEBUGGING_DEEP
 #include "VariableBase.h"
 #include "SensorBase.h"
+#include "ModbusBusManager.h"
 #include "YosemitechModbus.h"
 
 /* clang-format off */
@@ -247,6 +267,30 @@ class YosemitechParent : public Sensor {
     void powerUp(void) override;
     void powerDown(void) override;
 
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    /**
+     * @brief Read the sensor's values and check whether they've settled.
+     *
+     * The values are only read every #YOSEMITECH_STABILITY_INTERVAL_MS.  The
+     * sensor is stable once #YOSEMITECH_STABLE_READINGS changes in a row are
+     * all within the tolerance.
+     *
+     * This is only used with adaptive timing; see Sensor::setAdaptiveTiming().
+     *
+     * @return **bool** True if the values have settled.
+     */
+    bool probeStable(void) override;
+    /**
+     * @brief Set how close readings must be to each other for the sensor to
+     * be stable.
+     *
+     * @param tolerance The largest change accepted between readings, as a
+     * fraction of the last reading, or of 1 for readings smaller than 1;
+     * optional with a default value of 0.02.
+     */
+    void setStabilityTolerance(float tolerance = 0.02);
+#endif
+
     /**
      * @copydoc Sensor::addSingleMeasurementResult()
      */
@@ -259,6 +303,17 @@ class YosemitechParent : public Sensor {
     Stream*         _stream;
     int8_t          _RS485EnablePin;
     int8_t          _powerPin2;
+#ifdef MS_ADAPTIVE_SENSOR_TIMING
+    float    _stabilityTolerance      = 0.02;
+    uint32_t _stabilityCheckFor       = 0;
+    uint32_t _millisLastStabilityRead = 0;
+    uint8_t  _stableChanges           = 0;
+    bool     _haveStabilityValues     = false;
+    float    _stabilityValues[8];
+#endif
+#ifdef MS_MODBUS_SHARED
+    ModbusBusManager* _modbusBus;
+#endif
 };
 
 #endif  // SRC_SENSORS_YOSEMITECHPARENT_H_
@@ -112,11 +112,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolved"
-#define Y4000_DOMGL_VAR_NAME "oxygenDissolved"
+#define Y4000_DOMGL_VAR_NAME MS_VAR_TEXT("oxygenDissolved")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define Y4000_DOMGL_UNIT_NAME "milligramPerLiter"
+#define Y4000_DOMGL_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "Y4000DOmgL"
 #define Y4000_DOMGL_DEFAULT_CODE "Y4000DOmgL"
 /**@}*/
@@ -139,11 +139,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "turbidity"
-#define Y4000_TURB_VAR_NAME "turbidity"
+#define Y4000_TURB_VAR_NAME MS_VAR_TEXT("turbidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "nephelometricTurbidityUnit" (NTU)
-#define Y4000_TURB_UNIT_NAME "nephelometricTurbidityUnit"
+#define Y4000_TURB_UNIT_NAME MS_VAR_TEXT("nephelometricTurbidityUnit")
 /// @brief Default variable short code; "Y4000Turbidity"
 #define Y4000_TURB_DEFAULT_CODE "Y4000Turbidity"
 /**@}*/
@@ -166,11 +166,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificConductance"
-#define Y4000_COND_VAR_NAME "specificConductance"
+#define Y4000_COND_VAR_NAME MS_VAR_TEXT("specificConductance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define Y4000_COND_UNIT_NAME "microsiemenPerCentimeter"
+#define Y4000_COND_UNIT_NAME MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "Y4000Cond"
 #define Y4000_COND_DEFAULT_CODE "Y4000Cond"
 /**@}*/
@@ -192,11 +192,11 @@
 #define Y4000_PH_VAR_NUM 3
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/); "pH"
-#define Y4000_PH_VAR_NAME "pH"
+#define Y4000_PH_VAR_NAME MS_VAR_TEXT("pH")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "pH"
 /// (dimensionless pH units)
-#define Y4000_PH_UNIT_NAME "pH"
+#define Y4000_PH_UNIT_NAME MS_VAR_TEXT("pH")
 /// @brief Default variable short code; "Y4000pH"
 #define Y4000_PH_DEFAULT_CODE "Y4000pH"
 /**@}*/
@@ -219,11 +219,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y4000_TEMP_VAR_NAME "temperature"
+#define Y4000_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y4000_TEMP_UNIT_NAME "degreeCelsius"
+#define Y4000_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y4000Temp"
 #define Y4000_TEMP_DEFAULT_CODE "Y4000Temp"
 /**@}*/
@@ -246,11 +246,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "ORP"
-#define Y4000_ORP_VAR_NAME "ORP"
+#define Y4000_ORP_VAR_NAME MS_VAR_TEXT("ORP")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millivolt"
 /// (mV)
-#define Y4000_ORP_UNIT_NAME "millivolt"
+#define Y4000_ORP_UNIT_NAME MS_VAR_TEXT("millivolt")
 /// @brief Default variable short code; "Y4000Potential"
 #define Y4000_ORP_DEFAULT_CODE "Y4000Potential"
 /**@}*/
@@ -275,11 +275,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "chlorophyll_a_b_c"
-#define Y4000_CHLORO_VAR_NAME "chlorophyll_a_b_c"
+#define Y4000_CHLORO_VAR_NAME MS_VAR_TEXT("chlorophyll_a_b_c")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microgramPerLiter" (µg/L)
-#define Y4000_CHLORO_UNIT_NAME "microgramPerLiter"
+#define Y4000_CHLORO_UNIT_NAME MS_VAR_TEXT("microgramPerLiter")
 /// @brief Default variable short code; "Y4000Chloro"
 #define Y4000_CHLORO_DEFAULT_CODE "Y4000Chloro"
 /**@}*/
@@ -302,11 +302,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "blueGreenAlgaeCyanobacteriaPhycocyanin"
-#define Y4000_BGA_VAR_NAME "blueGreenAlgaeCyanobacteriaPhycocyanin"
+#define Y4000_BGA_VAR_NAME MS_VAR_TEXT("blueGreenAlgaeCyanobacteriaPhycocyanin")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microgramPerLiter" (µg/L)
-#define Y4000_BGA_UNIT_NAME "microgramPerLiter"
+#define Y4000_BGA_UNIT_NAME MS_VAR_TEXT("microgramPerLiter")
 /// @brief Default variable short code; "Y4000BGA"
 #define Y4000_BGA_DEFAULT_CODE "Y4000BGA"
 /**@}*/
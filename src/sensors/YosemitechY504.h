@@ -103,11 +103,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolvedPercentOfSaturation"
-#define Y504_DOPCT_VAR_NAME "oxygenDissolvedPercentOfSaturation"
+#define Y504_DOPCT_VAR_NAME MS_VAR_TEXT("oxygenDissolvedPercentOfSaturation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define Y504_DOPCT_UNIT_NAME "percent"
+#define Y504_DOPCT_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "Y504DOmgL"
 #define Y504_DOPCT_DEFAULT_CODE "Y504DOpct"
 /**@}*/
@@ -130,11 +130,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y504_TEMP_VAR_NAME "temperature"
+#define Y504_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y504_TEMP_UNIT_NAME "degreeCelsius"
+#define Y504_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y504Temp"
 #define Y504_TEMP_DEFAULT_CODE "Y504Temp"
 /**@}*/
@@ -158,11 +158,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolved"
-#define Y504_DOMGL_VAR_NAME "oxygenDissolved"
+#define Y504_DOMGL_VAR_NAME MS_VAR_TEXT("oxygenDissolved")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define Y504_DOMGL_UNIT_NAME "milligramPerLiter"
+#define Y504_DOMGL_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "Y504DOmgL"
 #define Y504_DOMGL_DEFAULT_CODE "Y504DOmgL"
 /**@}*/
@@ -97,11 +97,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "turbidity"
-#define Y510_TURB_VAR_NAME "turbidity"
+#define Y510_TURB_VAR_NAME MS_VAR_TEXT("turbidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "nephelometricTurbidityUnit" (NTU)
-#define Y510_TURB_UNIT_NAME "nephelometricTurbidityUnit"
+#define Y510_TURB_UNIT_NAME MS_VAR_TEXT("nephelometricTurbidityUnit")
 /// @brief Default variable short code; "Y510Turbidity"
 #define Y510_TURB_DEFAULT_CODE "Y510Turbidity"
 /**@}*/
@@ -124,11 +124,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y510_TEMP_VAR_NAME "temperature"
+#define Y510_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y510_TEMP_UNIT_NAME "degreeCelsius"
+#define Y510_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y510Temp"
 #define Y510_TEMP_DEFAULT_CODE "Y510Temp"
 /**@}*/
@@ -111,11 +111,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "turbidity"
-#define Y511_TURB_VAR_NAME "turbidity"
+#define Y511_TURB_VAR_NAME MS_VAR_TEXT("turbidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "nephelometricTurbidityUnit" (NTU)
-#define Y511_TURB_UNIT_NAME "nephelometricTurbidityUnit"
+#define Y511_TURB_UNIT_NAME MS_VAR_TEXT("nephelometricTurbidityUnit")
 /// @brief Default variable short code; "Y511Turbidity"
 #define Y511_TURB_DEFAULT_CODE "Y511Turbidity"
 /**@}*/
@@ -138,11 +138,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y511_TEMP_VAR_NAME "temperature"
+#define Y511_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y511_TEMP_UNIT_NAME "degreeCelsius"
+#define Y511_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y511Temp"
 #define Y511_TEMP_DEFAULT_CODE "Y511Temp"
 /**@}*/
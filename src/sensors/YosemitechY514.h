@@ -100,11 +100,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "chlorophyllFluorescence"
-#define Y514_CHLORO_VAR_NAME "chlorophyllFluorescence"
+#define Y514_CHLORO_VAR_NAME MS_VAR_TEXT("chlorophyllFluorescence")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microgramPerLiter" (µg/L)
-#define Y514_CHLORO_UNIT_NAME "microgramPerLiter"
+#define Y514_CHLORO_UNIT_NAME MS_VAR_TEXT("microgramPerLiter")
 /// @brief Default variable short code; "Y514Chloro"
 #define Y514_CHLORO_DEFAULT_CODE "Y514Chloro"
 /**@}*/
@@ -127,11 +127,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y514_TEMP_VAR_NAME "temperature"
+#define Y514_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y514_TEMP_UNIT_NAME "degreeCelsius"
+#define Y514_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y514Temp"
 #define Y514_TEMP_DEFAULT_CODE "Y514Temp"
 /**@}*/
@@ -98,11 +98,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "specificConductance"
-#define Y520_COND_VAR_NAME "specificConductance"
+#define Y520_COND_VAR_NAME MS_VAR_TEXT("specificConductance")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "microsiemenPerCentimeter" (µS/cm)
-#define Y520_COND_UNIT_NAME "microsiemenPerCentimeter"
+#define Y520_COND_UNIT_NAME MS_VAR_TEXT("microsiemenPerCentimeter")
 /// @brief Default variable short code; "Y520Cond"
 #define Y520_COND_DEFAULT_CODE "Y520Cond"
 /**@}*/
@@ -125,11 +125,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y520_TEMP_VAR_NAME "temperature"
+#define Y520_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y520_TEMP_UNIT_NAME "degreeCelsius"
+#define Y520_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y520Temp"
 #define Y520_TEMP_DEFAULT_CODE "Y520Temp"
 /**@}*/
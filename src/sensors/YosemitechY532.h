@@ -97,11 +97,11 @@
 #define Y532_PH_VAR_NUM 0
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/); "pH"
-#define Y532_PH_VAR_NAME "pH"
+#define Y532_PH_VAR_NAME MS_VAR_TEXT("pH")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "pH"
 /// (dimensionless pH units)
-#define Y532_PH_UNIT_NAME "pH"
+#define Y532_PH_UNIT_NAME MS_VAR_TEXT("pH")
 /// @brief Default variable short code; "Y532pH"
 #define Y532_PH_DEFAULT_CODE "Y532pH"
 /**@}*/
@@ -124,11 +124,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y532_TEMP_VAR_NAME "temperature"
+#define Y532_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y532_TEMP_UNIT_NAME "degreeCelsius"
+#define Y532_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y532Temp"
 #define Y532_TEMP_DEFAULT_CODE "Y532Temp"
 /**@}*/
@@ -151,11 +151,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "voltage"
-#define Y532_VOLTAGE_VAR_NAME "voltage"
+#define Y532_VOLTAGE_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millivolt"
 /// (mV)
-#define Y532_VOLTAGE_UNIT_NAME "millivolt"
+#define Y532_VOLTAGE_UNIT_NAME MS_VAR_TEXT("millivolt")
 /// @brief Default variable short code; "Y532Potential"
 #define Y532_VOLTAGE_DEFAULT_CODE "Y532Potential"
 /**@}*/
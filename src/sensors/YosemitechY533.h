@@ -100,11 +100,11 @@
 /// "voltage"
 /// NOTE: ORP should be added to ODM2 CVs, as ORP refers to a specific measure
 ///  of electron potential relative to a silver chloride reference electrode.
-#define Y533_ORP_VAR_NAME "voltage"
+#define Y533_ORP_VAR_NAME MS_VAR_TEXT("voltage")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "millivolt"
 /// (mV)
-#define Y533_ORP_UNIT_NAME "millivolt"
+#define Y533_ORP_UNIT_NAME MS_VAR_TEXT("millivolt")
 /// @brief Default variable short code; "Y533ORP"
 #define Y533_ORP_DEFAULT_CODE "Y533ORP"
 /**@}*/
@@ -127,11 +127,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y533_TEMP_VAR_NAME "temperature"
+#define Y533_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y533_TEMP_UNIT_NAME "degreeCelsius"
+#define Y533_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y533Temp"
 #define Y533_TEMP_DEFAULT_CODE "Y533Temp"
 /**@}*/
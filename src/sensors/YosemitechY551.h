@@ -100,11 +100,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "COD"
-#define Y551_COD_VAR_NAME "COD"
+#define Y551_COD_VAR_NAME MS_VAR_TEXT("COD")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define Y551_COD_UNIT_NAME "milligramPerLiter"
+#define Y551_COD_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "Y551COD"
 #define Y551_COD_DEFAULT_CODE "Y551COD"
 /**@}*/
@@ -127,11 +127,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y551_TEMP_VAR_NAME "temperature"
+#define Y551_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y551_TEMP_UNIT_NAME "degreeCelsius"
+#define Y551_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y551Temp"
 #define Y551_TEMP_DEFAULT_CODE "Y551Temp"
 /**@}*/
@@ -154,11 +154,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "turbidity"
-#define Y551_TURB_VAR_NAME "turbidity"
+#define Y551_TURB_VAR_NAME MS_VAR_TEXT("turbidity")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "nephelometricTurbidityUnit" (NTU)
-#define Y551_TURB_UNIT_NAME "nephelometricTurbidityUnit"
+#define Y551_TURB_UNIT_NAME MS_VAR_TEXT("nephelometricTurbidityUnit")
 /// @brief Default variable short code; "Y551Turbidity"
 #define Y551_TURB_DEFAULT_CODE "Y551Turbidity"
 /**@}*/
@@ -99,11 +99,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "nitrogen_NH4"
-#define Y560_NH4_N_VAR_NAME "nitrogen_NH4"
+#define Y560_NH4_N_VAR_NAME MS_VAR_TEXT("nitrogen_NH4")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter"
-#define Y560_NH4_N_UNIT_NAME "milligramPerLiter"
+#define Y560_NH4_N_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "Y560NH4_N"
 #define Y560_NH4_N_DEFAULT_CODE "Y560NH4_N"
 /**@}*/
@@ -126,11 +126,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y560_TEMP_VAR_NAME "temperature"
+#define Y560_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y560_TEMP_UNIT_NAME "degreeCelsius"
+#define Y560_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y560Temp"
 #define Y560_TEMP_DEFAULT_CODE "Y560Temp"
 /**@}*/
@@ -152,11 +152,11 @@
 #define Y560_PH_VAR_NUM 2
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/); "pH"
-#define Y560_PH_VAR_NAME "pH"
+#define Y560_PH_VAR_NAME MS_VAR_TEXT("pH")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "pH"
 /// (dimensionless pH units)
-#define Y560_PH_UNIT_NAME "pH"
+#define Y560_PH_UNIT_NAME MS_VAR_TEXT("pH")
 /// @brief Default variable short code; "Y560pH"
 #define Y560_PH_DEFAULT_CODE "Y560pH"
 /**@}*/
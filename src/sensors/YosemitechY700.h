@@ -97,11 +97,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "pressureGauge"
-#define Y700_PRES_VAR_NAME "pressureGauge"
+#define Y700_PRES_VAR_NAME MS_VAR_TEXT("pressureGauge")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "millimeterOfWater" (mmH2O)
-#define Y700_PRES_UNIT_NAME "millimeterOfWater"
+#define Y700_PRES_UNIT_NAME MS_VAR_TEXT("millimeterOfWater")
 /// @brief Default variable short code; "Y700Pres"
 #define Y700_PRES_DEFAULT_CODE "Y700Pres"
 /**@}*/
@@ -124,11 +124,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define Y700_TEMP_VAR_NAME "temperature"
+#define Y700_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define Y700_TEMP_UNIT_NAME "degreeCelsius"
+#define Y700_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "Y700Temp"
 #define Y700_TEMP_DEFAULT_CODE "Y700Temp"
 /**@}*/
@@ -115,11 +115,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "temperature"
-#define DOPTO_TEMP_VAR_NAME "temperature"
+#define DOPTO_TEMP_VAR_NAME MS_VAR_TEXT("temperature")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "degreeCelsius" (°C)
-#define DOPTO_TEMP_UNIT_NAME "degreeCelsius"
+#define DOPTO_TEMP_UNIT_NAME MS_VAR_TEXT("degreeCelsius")
 /// @brief Default variable short code; "DOtempC"
 #define DOPTO_TEMP_DEFAULT_CODE "DOtempC"
 /**@}*/
@@ -143,11 +143,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolvedPercentOfSaturation"
-#define DOPTO_DOPCT_VAR_NAME "oxygenDissolvedPercentOfSaturation"
+#define DOPTO_DOPCT_VAR_NAME MS_VAR_TEXT("oxygenDissolvedPercentOfSaturation")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/); "percent"
 /// (% saturation)
-#define DOPTO_DOPCT_UNIT_NAME "percent"
+#define DOPTO_DOPCT_UNIT_NAME MS_VAR_TEXT("percent")
 /// @brief Default variable short code; "DOpercent"
 #define DOPTO_DOPCT_DEFAULT_CODE "DOpercent"
 /**@}*/
@@ -171,11 +171,11 @@
 /// @brief Variable name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/variablename/);
 /// "oxygenDissolved"
-#define DOPTO_DOMGL_VAR_NAME "oxygenDissolved"
+#define DOPTO_DOMGL_VAR_NAME MS_VAR_TEXT("oxygenDissolved")
 /// @brief Variable unit name in
 /// [ODM2 controlled vocabulary](http://vocabulary.odm2.org/units/);
 /// "milligramPerLiter" (mg/L)
-#define DOPTO_DOMGL_UNIT_NAME "milligramPerLiter"
+#define DOPTO_DOMGL_UNIT_NAME MS_VAR_TEXT("milligramPerLiter")
 /// @brief Default variable short code; "DOppm"
 #define DOPTO_DOMGL_DEFAULT_CODE "DOppm"
 /**@}*/